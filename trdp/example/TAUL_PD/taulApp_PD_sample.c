@@ -16,6 +16,8 @@
  *
  * $Id$
  *
+ *      AG 2026-10-18: Subscriber and publisher access the Traffic Store without the global lock
+ *
  */
 
 #ifdef TRDP_OPTION_LADDER
@@ -872,27 +874,18 @@ TAUL_APP_ERR_TYPE PublisherApplication (PUBLISHER_THREAD_PARAMETER_T *pPublisher
 			vos_printLog(VOS_LOG_ERROR, "Publisher Application Create Dataset Failed. createDataset() Error: %d\n", err);
 		}
 
-		/* Get access right to Traffic Store*/
-		err = tau_ldLockTrafficStore();
-		if (err == TRDP_NO_ERR)
-		{
-			/* Set PD Data in Traffic Store */
-			memcpy((void *)((int)pTrafficStoreAddr + pPublisherThreadParameter->pPublishTelegram->pPdParameter->offset),
+		/* Set PD Data in Traffic Store, only the blocks of this dataset are locked */
+		err = tau_writeTrafficStore((UINT16)pPublisherThreadParameter->pPublishTelegram->pPdParameter->offset,
 					pPublisherThreadParameter->pPublishTelegram->dataset.pDatasetStartAddr,
 					pPublisherThreadParameter->pPublishTelegram->dataset.size);
+		if (err == TRDP_NO_ERR)
+		{
 			/* put count up */
 			requestCounter++;
-
-			/* Release access right to Traffic Store*/
-			err = tau_ldUnlockTrafficStore();
-			if (err != TRDP_NO_ERR)
-			{
-				vos_printLog(VOS_LOG_ERROR, "Release Traffic Store accessibility Failed\n");
-			}
 		}
 		else
 		{
-			vos_printLog(VOS_LOG_ERROR, "Get Traffic Store accessibility Failed\n");
+			vos_printLog(VOS_LOG_ERROR, "Set PD Data in Traffic Store Failed\n");
 		}
 		/* Waits for a next creation cycle */
 		(void) vos_threadDelay(pPublisherThreadParameter->pPdAppParameter->pdAppCycleTime);
@@ -1028,25 +1021,14 @@ TAUL_APP_ERR_TYPE SubscriberApplication (SUBSCRIBER_THREAD_PARAMETER_T *pSubscri
 			}
 		}
 
-		/* Get access right to Traffic Store*/
-    	err = tau_ldLockTrafficStore();
-    	if (err == TRDP_NO_ERR)
-    	{
-			/* Get Receive PD DataSet from Traffic Store */
-    		memcpy(pSubscriberThreadParameter->pSubscribeTelegram->dataset.pDatasetStartAddr,
-    				(void *)((int)pTrafficStoreAddr + pSubscriberThreadParameter->pSubscribeTelegram->pPdParameter->offset),
-    				pSubscriberThreadParameter->pSubscribeTelegram->dataset.size);
-			/* Release access right to Traffic Store*/
-			err = tau_ldUnlockTrafficStore();
-			if (err != TRDP_NO_ERR)
-			{
-				vos_printLog(VOS_LOG_ERROR, "Release Traffic Store accessibility Failed\n");
-			}
-    	}
-    	else
-    	{
-    		vos_printLog(VOS_LOG_ERROR, "Get Traffic Store accessibility Failed\n");
-    	}
+		/* Get Receive PD DataSet from Traffic Store, concurrent writes are detected and the copy repeated */
+		err = tau_readTrafficStore((UINT16)pSubscriberThreadParameter->pSubscribeTelegram->pPdParameter->offset,
+					pSubscriberThreadParameter->pSubscribeTelegram->dataset.pDatasetStartAddr,
+					pSubscriberThreadParameter->pSubscribeTelegram->dataset.size);
+		if (err != TRDP_NO_ERR)
+		{
+			vos_printLog(VOS_LOG_ERROR, "Get Receive PD DataSet from Traffic Store Failed\n");
+		}
 
 		/* Waits for a next to Traffic Store put/get cycle */
 		(void) vos_threadDelay(pSubscriberThreadParameter->pPdAppParameter->pdAppCycleTime);
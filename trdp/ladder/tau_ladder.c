@@ -17,6 +17,8 @@
  *
  * $Id$
  *
+ *      AG 2026-10-18: Per block sequence locks, lock-free Traffic Store read and write
+ *
  */
 
 #ifdef TRDP_OPTION_LADDER
@@ -46,6 +48,9 @@
  * DEFINES
  */
 
+#define TRAFFIC_STORE_SEQ_BLOCKS    (TRAFFIC_STORE_SIZE / TRAFFIC_STORE_SEQ_BLOCK)
+#define TRAFFIC_STORE_SEQ_SPIN      64u     /* Retries before a reader or writer yields the CPU */
+
 /*******************************************************************************
  * TYPEDEFS
  */
@@ -54,6 +59,14 @@
  *   Locals
  */
 
+/* Sequence counter per block of the Traffic Store: odd while a writer owns the block */
+static volatile UINT32  trafficStoreSeq[TRAFFIC_STORE_SEQ_BLOCKS];
+
+/* Contention counters, only touched on the slow path */
+static volatile UINT32  trafficStoreReadRetries;
+static volatile UINT32  trafficStoreTornReads;
+static volatile UINT32  trafficStoreWriteWaits;
+
 /******************************************************************************
  *   Globals
  */
@@ -81,6 +94,120 @@ BOOL8   pdComLadderThreadStartFlag = FALSE;              /* PDComLadder Thread i
 /* Sub-net */
 UINT32  usingSubnetId;                                   /* Using SubnetId */
 
+/******************************************************************************/
+/** Count a contention event.
+ *
+ *  @param[in,out]  pCounter        counter to increment
+ */
+static void tau_countTrafficStore (
+    volatile UINT32 *pCounter)
+{
+    UINT32 count;
+
+    do
+    {
+        count = vos_atomicLoad32(pCounter);
+    }
+    while (vos_atomicCompareExchange32(pCounter, count, count + 1u) == FALSE);
+}
+
+/******************************************************************************/
+/** Let other threads run after a number of retries.
+ *
+ *  @param[in,out]  pRetry          retries so far
+ */
+static void tau_backOffTrafficStore (
+    UINT32 *pRetry)
+{
+    if (++*pRetry >= TRAFFIC_STORE_SEQ_SPIN)
+    {
+        *pRetry = 0u;
+        (void) vos_threadDelay(0u);
+    }
+}
+
+/******************************************************************************/
+/** Check the range of a Traffic Store access and get its sequence blocks.
+ *
+ *  @param[in]      offset          offset of the range in the Traffic Store
+ *  @param[in]      size            size of the range
+ *  @param[out]     pFirst          first block of the range
+ *  @param[out]     pLast           last block of the range
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  range exceeds the Traffic Store
+ *  @retval         TRDP_NOINIT_ERR Traffic Store not created
+ */
+static TRDP_ERR_T tau_rangeTrafficStore (
+    UINT16  offset,
+    UINT32  size,
+    UINT32  *pFirst,
+    UINT32  *pLast)
+{
+    if (pTrafficStoreAddr == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if ((size == 0u) || (((UINT32) offset + size) > TRAFFIC_STORE_SIZE))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *pFirst = (UINT32) offset / TRAFFIC_STORE_SEQ_BLOCK;
+    *pLast  = ((UINT32) offset + size - 1u) / TRAFFIC_STORE_SEQ_BLOCK;
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Take the sequence locks of a block range.
+ *  Blocks are taken in ascending order, so concurrent writers of overlapping ranges cannot deadlock.
+ *
+ *  @param[in]      first           first block
+ *  @param[in]      last            last block
+ */
+static void tau_seqLockTrafficStore (
+    UINT32  first,
+    UINT32  last)
+{
+    UINT32  block;
+    UINT32  seq;
+    UINT32  retry = 0u;
+
+    for (block = first; block <= last; block++)
+    {
+        for (;; )
+        {
+            seq = vos_atomicLoad32(&trafficStoreSeq[block]);
+            if (((seq & 1u) == 0u)
+                && (vos_atomicCompareExchange32(&trafficStoreSeq[block], seq, seq + 1u) == TRUE))
+            {
+                break;
+            }
+            tau_countTrafficStore(&trafficStoreWriteWaits);
+            tau_backOffTrafficStore(&retry);
+        }
+    }
+    /* Readers seeing the new data must see the odd counters as well */
+    vos_atomicFence();
+}
+
+/******************************************************************************/
+/** Release the sequence locks of a block range.
+ *
+ *  @param[in]      first           first block
+ *  @param[in]      last            last block
+ */
+static void tau_seqUnlockTrafficStore (
+    UINT32  first,
+    UINT32  last)
+{
+    UINT32 block;
+
+    for (block = first; block <= last; block++)
+    {
+        vos_atomicStore32(&trafficStoreSeq[block], trafficStoreSeq[block] + 1u);
+    }
+}
+
 /******************************************************************************/
 /** Initialize TRDP Ladder Support
  *  Create Traffic Store mutex, Traffic Store.
@@ -168,10 +295,6 @@ TRDP_ERR_T tau_ladder_init (void)
         ret = TRDP_MEM_ERR;
         return ret;
     }
-    else
-    {
-        pTrafficStoreHandle->sharedMemoryName = TRAFFIC_STORE;
-    }
 
     /* Traffic Store Mutex unlock */
     vos_mutexUnlock(pTrafficStoreMutex);
@@ -182,7 +305,7 @@ TRDP_ERR_T tau_ladder_init (void)
     }
 */
     /* Set Traffic Store Semaphore Value */
-    memcpy((void *)((int)pTrafficStoreAddr + TRAFFIC_STORE_MUTEX_VALUE_AREA),
+    memcpy((void *)(pTrafficStoreAddr + TRAFFIC_STORE_MUTEX_VALUE_AREA),
            &pTrafficStoreMutex->mutexId,
            sizeof(pTrafficStoreMutex->mutexId));
 
@@ -319,6 +442,8 @@ TRDP_ERR_T  tau_getNetworkContext (
 
 /**********************************************************************************************************************/
 /** Get Traffic Store accessibility.
+ *  The lock takes all sequence locks, so holders of the lock exclude tau_writeTrafficStore() and are seen as a
+ *  writer by tau_readTrafficStore().
  *
  *  @retval         TRDP_NO_ERR            no error
  *  @retval         TRDP_MUTEX_ERR        mutex error
@@ -336,6 +461,7 @@ TRDP_ERR_T  tau_lockTrafficStore (
         vos_printLog(VOS_LOG_ERROR, "TRDP Traffic Store Mutex Lock failed\n");
         return TRDP_MUTEX_ERR;
     }
+    tau_seqLockTrafficStore(0u, TRAFFIC_STORE_SEQ_BLOCKS - 1u);
     return TRDP_NO_ERR;
 }
 
@@ -351,7 +477,8 @@ TRDP_ERR_T  tau_unlockTrafficStore (
 {
     extern VOS_MUTEX_T pTrafficStoreMutex;                            /* pointer to Mutex for Traffic Store */
 
-    /* Lock Traffic Store by Mutex */
+    /* Unlock Traffic Store by Mutex */
+    tau_seqUnlockTrafficStore(0u, TRAFFIC_STORE_SEQ_BLOCKS - 1u);
     vos_mutexUnlock(pTrafficStoreMutex);
 /*    if (vos_mutexUnlock(pTrafficStoreMutex) != VOS_NO_ERR)
     {
@@ -362,6 +489,187 @@ TRDP_ERR_T  tau_unlockTrafficStore (
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Start writing a range of the Traffic Store in place.
+ *  Takes the sequence locks of all blocks of the range. Other writers of these blocks wait, readers retry until
+ *  tau_endWriteTrafficStore() is called with the same range.
+ *
+ *  @param[in]      offset          offset of the range in the Traffic Store
+ *  @param[in]      size            size of the range
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  range exceeds the Traffic Store
+ *  @retval         TRDP_NOINIT_ERR Traffic Store not created
+ */
+TRDP_ERR_T  tau_beginWriteTrafficStore (
+    UINT16  offset,
+    UINT32  size)
+{
+    UINT32      first;
+    UINT32      last;
+    TRDP_ERR_T  err = tau_rangeTrafficStore(offset, size, &first, &last);
+
+    if (err == TRDP_NO_ERR)
+    {
+        tau_seqLockTrafficStore(first, last);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Finish writing a range of the Traffic Store in place.
+ *
+ *  @param[in]      offset          offset of the range, as passed to tau_beginWriteTrafficStore()
+ *  @param[in]      size            size of the range, as passed to tau_beginWriteTrafficStore()
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  range exceeds the Traffic Store
+ *  @retval         TRDP_NOINIT_ERR Traffic Store not created
+ */
+TRDP_ERR_T  tau_endWriteTrafficStore (
+    UINT16  offset,
+    UINT32  size)
+{
+    UINT32      first;
+    UINT32      last;
+    TRDP_ERR_T  err = tau_rangeTrafficStore(offset, size, &first, &last);
+
+    if (err == TRDP_NO_ERR)
+    {
+        tau_seqUnlockTrafficStore(first, last);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Write data to the Traffic Store.
+ *  Only the blocks of the range are locked; writers and readers of other datasets are not blocked.
+ *
+ *  @param[in]      offset          offset of the dataset in the Traffic Store
+ *  @param[in]      pData           data to write, NULL clears the range
+ *  @param[in]      size            size of the data
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  range exceeds the Traffic Store
+ *  @retval         TRDP_NOINIT_ERR Traffic Store not created
+ */
+TRDP_ERR_T  tau_writeTrafficStore (
+    UINT16      offset,
+    const UINT8 *pData,
+    UINT32      size)
+{
+    UINT32      first;
+    UINT32      last;
+    TRDP_ERR_T  err = tau_rangeTrafficStore(offset, size, &first, &last);
+
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    tau_seqLockTrafficStore(first, last);
+    if (pData == NULL)
+    {
+        memset(pTrafficStoreAddr + offset, 0, size);
+    }
+    else
+    {
+        memcpy(pTrafficStoreAddr + offset, pData, size);
+    }
+    tau_seqUnlockTrafficStore(first, last);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Read a consistent copy of data from the Traffic Store without locking.
+ *  The copy is retried while a writer owns one of the blocks of the range or if a write happened during the copy
+ *  (torn read). Readers never block writers.
+ *
+ *  @param[in]      offset          offset of the dataset in the Traffic Store
+ *  @param[out]     pData           buffer for the data
+ *  @param[in]      size            size of the data
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error or range exceeds the Traffic Store
+ *  @retval         TRDP_NOINIT_ERR Traffic Store not created
+ */
+TRDP_ERR_T  tau_readTrafficStore (
+    UINT16  offset,
+    UINT8   *pData,
+    UINT32  size)
+{
+    UINT32      first;
+    UINT32      last;
+    UINT32      block;
+    UINT32      seq;
+    UINT32      before;
+    UINT32      after;
+    UINT32      retry = 0u;
+    BOOL8       busy;
+    TRDP_ERR_T  err = tau_rangeTrafficStore(offset, size, &first, &last);
+
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    if (pData == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    for (;; )
+    {
+        /* Counters only grow, so an unchanged sum means no block was written in between */
+        busy    = FALSE;
+        before  = 0u;
+        for (block = first; block <= last; block++)
+        {
+            seq     = vos_atomicLoad32(&trafficStoreSeq[block]);
+            busy    |= (BOOL8) (seq & 1u);
+            before  += seq;
+        }
+        if (busy == FALSE)
+        {
+            memcpy(pData, pTrafficStoreAddr + offset, size);
+            vos_atomicFence();
+            after = 0u;
+            for (block = first; block <= last; block++)
+            {
+                after += vos_atomicLoad32(&trafficStoreSeq[block]);
+            }
+            if (after == before)
+            {
+                return TRDP_NO_ERR;
+            }
+            tau_countTrafficStore(&trafficStoreTornReads);
+        }
+        else
+        {
+            tau_countTrafficStore(&trafficStoreReadRetries);
+        }
+        tau_backOffTrafficStore(&retry);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Get the contention counters of the Traffic Store.
+ *
+ *  @param[out]     pStatistics     pointer to the counters
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ */
+TRDP_ERR_T  tau_getTrafficStoreStatistics (
+    TAU_TRAFFIC_STORE_STATISTICS_T *pStatistics)
+{
+    if (pStatistics == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pStatistics->readRetries    = vos_atomicLoad32(&trafficStoreReadRetries);
+    pStatistics->tornReads      = vos_atomicLoad32(&trafficStoreTornReads);
+    pStatistics->writeWaits     = vos_atomicLoad32(&trafficStoreWriteWaits);
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Check Link up/down
  *
@@ -17,6 +17,8 @@
  *
  * $Id$
  *
+ *      AG 2026-10-18: tau_readTrafficStore()/tau_writeTrafficStore() with per block sequence locks
+ *
  */
 
 #ifndef TAU_LADDER_H_
@@ -37,6 +39,7 @@ extern "C" {
  * DEFINES
  */
 #define TRAFFIC_STORE_SIZE  65536           /* Traffic Store Size : 64KB */
+#define TRAFFIC_STORE_SEQ_BLOCK 64u         /* Bytes of the Traffic Store guarded by one sequence lock */
 #define SUBNET1             0x00000000      /* Sub-network Id1 */
 #define SUBNET2             0x00002000      /* Sub-network Id2 */
 #define NUM_ED_INTERFACES   10              /* number of End Device Interfaces */
@@ -45,6 +48,18 @@ extern "C" {
 #define SUBNETID_TYPE1      1                   /* SUBNETID Type1 */
 #define SUBNETID_TYPE2      2                   /* SUBNETID Type2 */
 
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Contention counters of the Traffic Store */
+typedef struct
+{
+    UINT32  readRetries;                    /**< reads repeated because a writer owned the range                */
+    UINT32  tornReads;                      /**< reads repeated because the range was written during the copy  */
+    UINT32  writeWaits;                     /**< write retries waiting for a writer of an overlapping range     */
+} TAU_TRAFFIC_STORE_STATISTICS_T;
+
 /***********************************************************************************************************************
  * GLOBAL VARIABLES
  */
@@ -155,6 +170,82 @@ TRDP_ERR_T tau_lockTrafficStore (
 TRDP_ERR_T tau_unlockTrafficStore (
     void);
 
+/**********************************************************************************************************************/
+/** Start writing a range of the Traffic Store in place.
+ *
+ *  @param[in]      offset              offset of the range in the Traffic Store
+ *  @param[in]      size                size of the range
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		range exceeds the Traffic Store
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+
+TRDP_ERR_T tau_beginWriteTrafficStore (
+    UINT16  offset,
+    UINT32  size);
+
+/**********************************************************************************************************************/
+/** Finish writing a range of the Traffic Store in place.
+ *
+ *  @param[in]      offset              offset of the range, as passed to tau_beginWriteTrafficStore()
+ *  @param[in]      size                size of the range, as passed to tau_beginWriteTrafficStore()
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		range exceeds the Traffic Store
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+
+TRDP_ERR_T tau_endWriteTrafficStore (
+    UINT16  offset,
+    UINT32  size);
+
+/**********************************************************************************************************************/
+/** Write data to the Traffic Store, locking only the blocks of the range.
+ *
+ *  @param[in]      offset              offset of the dataset in the Traffic Store
+ *  @param[in]      pData               data to write, NULL clears the range
+ *  @param[in]      size                size of the data
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		range exceeds the Traffic Store
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+
+TRDP_ERR_T tau_writeTrafficStore (
+    UINT16      offset,
+    const UINT8 *pData,
+    UINT32      size);
+
+/**********************************************************************************************************************/
+/** Read a consistent copy of data from the Traffic Store without locking, retrying torn reads.
+ *
+ *  @param[in]      offset              offset of the dataset in the Traffic Store
+ *  @param[out]     pData               buffer for the data
+ *  @param[in]      size                size of the data
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error or range exceeds the Traffic Store
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+
+TRDP_ERR_T tau_readTrafficStore (
+    UINT16  offset,
+    UINT8   *pData,
+    UINT32  size);
+
+/**********************************************************************************************************************/
+/** Get the contention counters of the Traffic Store.
+ *
+ *  @param[out]     pStatistics         pointer to the counters
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ */
+
+TRDP_ERR_T tau_getTrafficStoreStatistics (
+    TAU_TRAFFIC_STORE_STATISTICS_T *pStatistics);
+
 /**********************************************************************************************************************/
 /** Check Link up/down
  *
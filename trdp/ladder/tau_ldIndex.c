@@ -0,0 +1,323 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_ldIndex.c
+ *
+ * @brief           Index of the TAUL telegram lists
+ *
+ * @details         Open addressing with linear probing, the index grows at half load. A removed slot is
+ *                  refilled by shifting the following slots of its probe sequence back, so no tombstones
+ *                  are needed. The list order is kept by the insertion number of each slot.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This source code corresponds to TRDP_LADDER open source software.
+ *          This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifdef TRDP_OPTION_LADDER
+/*******************************************************************************
+ * INCLUDES
+ */
+#include <string.h>
+
+#include "vos_mem.h"
+#include "tau_ldIndex.h"
+
+/**********************************************************************************************************************/
+/** Home slot of a key
+ *
+ *  @param[in]      pIndex              pointer to index
+ *  @param[in]      comId               comId
+ *  @param[in]      srcIpAddr           source IP Address
+ *  @param[in]      dstIpAddr           destination IP Address
+ *
+ *  @retval         slot number
+ */
+static UINT32 homeSlot (
+    const TAU_LD_INDEX_T    *pIndex,
+    UINT32                  comId,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          dstIpAddr)
+{
+    UINT32 hash = comId * 2654435761u;
+
+    /* The addresses of one comId often differ in the host part only, mix every bit of them */
+    hash    = (hash ^ srcIpAddr) * 0x85EBCA6Bu;
+    hash    ^= hash >> 13;
+    hash    = (hash ^ dstIpAddr) * 0xC2B2AE35u;
+    hash    ^= hash >> 16;
+    return hash & pIndex->mask;
+}
+
+/**********************************************************************************************************************/
+/** Counter of the telegrams with a wildcard address like the key, NULL for exact addresses
+ *
+ *  @param[in]      pIndex              pointer to index
+ *  @param[in]      srcIpAddr           source IP Address
+ *  @param[in]      dstIpAddr           destination IP Address
+ *
+ *  @retval         pointer to the counter or NULL
+ */
+static UINT32 *wildcardCount (
+    TAU_LD_INDEX_T  *pIndex,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    TRDP_IP_ADDR_T  dstIpAddr)
+{
+    if (srcIpAddr == 0)
+    {
+        return (dstIpAddr == 0) ? &pIndex->anyBoth : &pIndex->anySrc;
+    }
+    return (dstIpAddr == 0) ? &pIndex->anyDst : NULL;
+}
+
+/**********************************************************************************************************************/
+/** Store a slot in the first free slot of its probe sequence
+ *
+ *  @param[in]      pIndex              pointer to index with a free slot
+ *  @param[in]      pEntry              slot to store
+ */
+static void placeSlot (
+    TAU_LD_INDEX_T              *pIndex,
+    const TAU_LD_INDEX_SLOT_T   *pEntry)
+{
+    UINT32 i;
+
+    for (i = homeSlot(pIndex, pEntry->comId, pEntry->srcIpAddr, pEntry->dstIpAddr);
+         pIndex->pSlot[i].comId != 0;
+         i = (i + 1u) & pIndex->mask)
+    {
+        ;
+    }
+    pIndex->pSlot[i] = *pEntry;
+}
+
+/**********************************************************************************************************************/
+/** Check the telegrams of one key, keep the first one in list order
+ *
+ *  @param[in]      pIndex              pointer to index
+ *  @param[in]      comId               comId
+ *  @param[in]      srcIpAddr           source IP Address of the telegrams
+ *  @param[in]      dstIpAddr           destination IP Address of the telegrams
+ *  @param[in]      pfFilter            additional check, NULL for none
+ *  @param[in]      pArg                argument of pfFilter
+ *  @param[in,out]  ppBest              first telegram found so far, NULL for none
+ */
+static void searchKey (
+    const TAU_LD_INDEX_T        *pIndex,
+    UINT32                      comId,
+    TRDP_IP_ADDR_T              srcIpAddr,
+    TRDP_IP_ADDR_T              dstIpAddr,
+    TAU_LD_INDEX_FILTER_T       pfFilter,
+    const void                  *pArg,
+    const TAU_LD_INDEX_SLOT_T   * *ppBest)
+{
+    const TAU_LD_INDEX_SLOT_T   *pSlot;
+    UINT32                      i;
+
+    for (i = homeSlot(pIndex, comId, srcIpAddr, dstIpAddr);
+         pIndex->pSlot[i].comId != 0;
+         i = (i + 1u) & pIndex->mask)
+    {
+        pSlot = &pIndex->pSlot[i];
+        if ((pSlot->comId == comId)
+            && (pSlot->srcIpAddr == srcIpAddr)
+            && (pSlot->dstIpAddr == dstIpAddr)
+            && ((*ppBest == NULL) || (pSlot->order < (*ppBest)->order))
+            && ((pfFilter == NULL) || pfFilter(pSlot->pTelegram, pArg)))
+        {
+            *ppBest = pSlot;
+        }
+    }
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Add a telegram to an index, behind all telegrams added before
+ *
+ *  @param[in]      pIndex              pointer to index
+ *  @param[in]      comId               comId of the telegram, 0 is not indexed
+ *  @param[in]      srcIpAddr           source IP Address of the telegram
+ *  @param[in]      dstIpAddr           destination IP Address of the telegram
+ *  @param[in]      pTelegram           pointer to the telegram
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+TRDP_ERR_T tau_ldIndexInsert (
+    TAU_LD_INDEX_T  *pIndex,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    TRDP_IP_ADDR_T  dstIpAddr,
+    void            *pTelegram)
+{
+    TAU_LD_INDEX_SLOT_T entry;
+    UINT32              *pAny;
+
+    /* comId 0 marks a free slot and is never searched */
+    if (comId == 0)
+    {
+        return TRDP_NO_ERR;
+    }
+    if ((pIndex->pSlot == NULL) || ((pIndex->count + 1u) * 2u > pIndex->mask + 1u))
+    {
+        TAU_LD_INDEX_T  grown = *pIndex;
+        UINT32          i;
+
+        grown.mask  = (pIndex->pSlot == NULL) ? (TAU_LD_INDEX_MIN_SLOTS - 1u) : (pIndex->mask * 2u + 1u);
+        grown.pSlot = (TAU_LD_INDEX_SLOT_T *) vos_memAlloc((grown.mask + 1u) * sizeof(TAU_LD_INDEX_SLOT_T));
+        if (grown.pSlot == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        if (pIndex->pSlot != NULL)
+        {
+            for (i = 0u; i <= pIndex->mask; i++)
+            {
+                if (pIndex->pSlot[i].comId != 0)
+                {
+                    placeSlot(&grown, &pIndex->pSlot[i]);
+                }
+            }
+            vos_memFree(pIndex->pSlot);
+        }
+        *pIndex = grown;
+    }
+    entry.comId     = comId;
+    entry.srcIpAddr = srcIpAddr;
+    entry.dstIpAddr = dstIpAddr;
+    /* 2^32 telegrams are not appended during the life time of a list */
+    entry.order     = pIndex->nextOrder++;
+    entry.pTelegram = pTelegram;
+    placeSlot(pIndex, &entry);
+    pIndex->count++;
+    pAny = wildcardCount(pIndex, srcIpAddr, dstIpAddr);
+    if (pAny != NULL)
+    {
+        (*pAny)++;
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Remove a telegram from an index
+ *
+ *  @param[in]      pIndex              pointer to index
+ *  @param[in]      comId               comId of the telegram
+ *  @param[in]      srcIpAddr           source IP Address of the telegram
+ *  @param[in]      dstIpAddr           destination IP Address of the telegram
+ *  @param[in]      pTelegram           pointer to the telegram
+ */
+void tau_ldIndexRemove (
+    TAU_LD_INDEX_T  *pIndex,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    TRDP_IP_ADDR_T  dstIpAddr,
+    const void      *pTelegram)
+{
+    const TAU_LD_INDEX_SLOT_T   *pSlot;
+    UINT32                      gap, i, home;
+    UINT32                      *pAny;
+
+    if ((pIndex->pSlot == NULL) || (comId == 0))
+    {
+        return;
+    }
+    for (gap = homeSlot(pIndex, comId, srcIpAddr, dstIpAddr);
+         pIndex->pSlot[gap].pTelegram != pTelegram;
+         gap = (gap + 1u) & pIndex->mask)
+    {
+        if (pIndex->pSlot[gap].comId == 0)
+        {
+            return;
+        }
+    }
+    for (i = (gap + 1u) & pIndex->mask; pIndex->pSlot[i].comId != 0; i = (i + 1u) & pIndex->mask)
+    {
+        pSlot   = &pIndex->pSlot[i];
+        home    = homeSlot(pIndex, pSlot->comId, pSlot->srcIpAddr, pSlot->dstIpAddr);
+        /* Move the slot if its home is not between the gap and the slot */
+        if (((i - home) & pIndex->mask) >= ((i - gap) & pIndex->mask))
+        {
+            pIndex->pSlot[gap]  = *pSlot;
+            gap                 = i;
+        }
+    }
+    memset(&pIndex->pSlot[gap], 0, sizeof(TAU_LD_INDEX_SLOT_T));
+    pIndex->count--;
+    pAny = wildcardCount(pIndex, srcIpAddr, dstIpAddr);
+    if (pAny != NULL)
+    {
+        (*pAny)--;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Return the first telegram of a comId whose addresses are 0 or match
+ *  Besides the exact key only the wildcard keys with indexed telegrams are probed.
+ *
+ *  @param[in]      pIndex              pointer to index
+ *  @param[in]      comId               comId
+ *  @param[in]      srcIpAddr           source IP Address
+ *  @param[in]      dstIpAddr           destination IP Address
+ *  @param[in]      pfFilter            additional check of a matching telegram, NULL for none
+ *  @param[in]      pArg                argument of pfFilter
+ *
+ *  @retval         != NULL             pointer to the telegram
+ *  @retval         NULL                no telegram found
+ */
+void *tau_ldIndexSearch (
+    const TAU_LD_INDEX_T    *pIndex,
+    UINT32                  comId,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          dstIpAddr,
+    TAU_LD_INDEX_FILTER_T   pfFilter,
+    const void              *pArg)
+{
+    const TAU_LD_INDEX_SLOT_T *pBest = NULL;
+
+    if ((pIndex->pSlot == NULL) || (comId == 0))
+    {
+        return NULL;
+    }
+    searchKey(pIndex, comId, srcIpAddr, dstIpAddr, pfFilter, pArg, &pBest);
+    if ((srcIpAddr != 0) && (((dstIpAddr != 0) ? pIndex->anySrc : pIndex->anyBoth) != 0))
+    {
+        searchKey(pIndex, comId, 0, dstIpAddr, pfFilter, pArg, &pBest);
+    }
+    if ((dstIpAddr != 0) && (((srcIpAddr != 0) ? pIndex->anyDst : pIndex->anyBoth) != 0))
+    {
+        searchKey(pIndex, comId, srcIpAddr, 0, pfFilter, pArg, &pBest);
+    }
+    if ((srcIpAddr != 0) && (dstIpAddr != 0) && (pIndex->anyBoth != 0))
+    {
+        searchKey(pIndex, comId, 0, 0, pfFilter, pArg, &pBest);
+    }
+    return (pBest != NULL) ? pBest->pTelegram : NULL;
+}
+
+/**********************************************************************************************************************/
+/** Release an index
+ *
+ *  @param[in]      pIndex              pointer to index
+ */
+void tau_ldIndexClear (
+    TAU_LD_INDEX_T *pIndex)
+{
+    if (pIndex->pSlot != NULL)
+    {
+        vos_memFree(pIndex->pSlot);
+    }
+    memset(pIndex, 0, sizeof(TAU_LD_INDEX_T));
+}
+
+#endif  /* TRDP_OPTION_LADDER */
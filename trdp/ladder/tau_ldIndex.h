@@ -0,0 +1,155 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_ldIndex.h
+ *
+ * @brief           Index of the TAUL telegram lists
+ *
+ * @details         Open addressing hash of the telegrams by comId, source and destination IP address.
+ *                  Telegrams with a source or destination address of 0 match any address. They are hashed with
+ *                  the 0 address, so a search probes the exact key and only those wildcard keys the index
+ *                  holds telegrams for. Of all matching telegrams the one indexed first is returned, which
+ *                  is the first one of the telegram list.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This source code corresponds to TRDP_LADDER open source software.
+ *          This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef TAU_LDINDEX_H_
+#define TAU_LDINDEX_H_
+
+#ifdef TRDP_OPTION_LADDER
+/*******************************************************************************
+ * INCLUDES
+ */
+#include "trdp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TAU_LD_INDEX_MIN_SLOTS  64u     /* initial slots of an index (power of two) */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Slot of a telegram index */
+typedef struct
+{
+    UINT32          comId;              /**< comId of the telegram, 0 for a free slot */
+    TRDP_IP_ADDR_T  srcIpAddr;          /**< source IP Address of the telegram, 0 for any */
+    TRDP_IP_ADDR_T  dstIpAddr;          /**< destination IP Address of the telegram, 0 for any */
+    UINT32          order;              /**< insertion number, the position in the telegram list */
+    void            *pTelegram;         /**< pointer to the telegram */
+} TAU_LD_INDEX_SLOT_T;
+
+/** Index of a telegram list, all zero when empty */
+typedef struct
+{
+    TAU_LD_INDEX_SLOT_T *pSlot;         /**< slot array, NULL if empty */
+    UINT32              mask;           /**< number of slots - 1 */
+    UINT32              count;          /**< used slots */
+    UINT32              nextOrder;      /**< insertion number of the next telegram */
+    UINT32              anySrc;         /**< telegrams with source address 0 only */
+    UINT32              anyDst;         /**< telegrams with destination address 0 only */
+    UINT32              anyBoth;        /**< telegrams with source and destination address 0 */
+} TAU_LD_INDEX_T;
+
+/** Additional check of a telegram matching the addresses of a search
+ *
+ *  @param[in]      pTelegram           pointer to the telegram
+ *  @param[in]      pArg                argument of tau_ldIndexSearch()
+ *
+ *  @retval         TRUE                the telegram is found
+ *  @retval         FALSE               the search goes on
+ */
+typedef BOOL8 (*TAU_LD_INDEX_FILTER_T)(
+    const void  *pTelegram,
+    const void  *pArg);
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/** Add a telegram to an index, behind all telegrams added before
+ *
+ *  @param[in]      pIndex              pointer to index
+ *  @param[in]      comId               comId of the telegram, 0 is not indexed
+ *  @param[in]      srcIpAddr           source IP Address of the telegram
+ *  @param[in]      dstIpAddr           destination IP Address of the telegram
+ *  @param[in]      pTelegram           pointer to the telegram
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+TRDP_ERR_T tau_ldIndexInsert (
+    TAU_LD_INDEX_T  *pIndex,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    TRDP_IP_ADDR_T  dstIpAddr,
+    void            *pTelegram);
+
+/**********************************************************************************************************************/
+/** Remove a telegram from an index
+ *
+ *  @param[in]      pIndex              pointer to index
+ *  @param[in]      comId               comId of the telegram
+ *  @param[in]      srcIpAddr           source IP Address of the telegram
+ *  @param[in]      dstIpAddr           destination IP Address of the telegram
+ *  @param[in]      pTelegram           pointer to the telegram
+ */
+void tau_ldIndexRemove (
+    TAU_LD_INDEX_T  *pIndex,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    TRDP_IP_ADDR_T  dstIpAddr,
+    const void      *pTelegram);
+
+/**********************************************************************************************************************/
+/** Return the first telegram of a comId whose addresses are 0 or match
+ *
+ *  @param[in]      pIndex              pointer to index
+ *  @param[in]      comId               comId
+ *  @param[in]      srcIpAddr           source IP Address
+ *  @param[in]      dstIpAddr           destination IP Address
+ *  @param[in]      pfFilter            additional check of a matching telegram, NULL for none
+ *  @param[in]      pArg                argument of pfFilter
+ *
+ *  @retval         != NULL             pointer to the telegram
+ *  @retval         NULL                no telegram found
+ */
+void *tau_ldIndexSearch (
+    const TAU_LD_INDEX_T    *pIndex,
+    UINT32                  comId,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          dstIpAddr,
+    TAU_LD_INDEX_FILTER_T   pfFilter,
+    const void              *pArg);
+
+/**********************************************************************************************************************/
+/** Release an index
+ *
+ *  @param[in]      pIndex              pointer to index
+ */
+void tau_ldIndexClear (
+    TAU_LD_INDEX_T *pIndex);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* TRDP_OPTION_LADDER */
+#endif  /* TAU_LDINDEX_H_ */
@@ -17,6 +17,9 @@
  *
  * $Id$*
  *
+ *      AG 2026-10-18: Marshalling context released by tau_ldTerminate() and before a repeated tau_ldInit()
+ *      AG 2026-10-18: Telegram lists indexed by comId and IP addresses (tau_ldIndex.c) for searchPublish/Subscribe/PdRequestTelegramList()
+ *      AG 2026-10-18: Received and published datasets use the lock-free Traffic Store access
  *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
  *
  */
@@ -46,6 +49,7 @@
 #include "tau_ladder.h"
 #include "tau_ldLadder.h"
 #include "tau_ldLadder_config.h"
+#include "tau_ldIndex.h"
 
 static void forceSocketClose (TRDP_APP_SESSION_T);
 /*******************************************************************************
@@ -56,6 +60,13 @@ static void forceSocketClose (TRDP_APP_SESSION_T);
  * TYPEDEFS
  */
 
+/* Reply searched for by searchPdRequestTelegramList() */
+typedef struct
+{
+    UINT32          replyComId;                     /* PD Reply comId */
+    TRDP_IP_ADDR_T  replyIpAddr;                    /* PD Reply IP Address */
+} PD_REQUEST_REPLY_T;
+
 /******************************************************************************
  * TRDP_OPTION_TRAFFIC_SHAPING  Locals
  */
@@ -94,6 +105,11 @@ TRDP_URI_HOST_T     IP_ADDRESS_ZERO = {"0.0.0.0"};      /* IP Address 0.0.0.0 */
 const TRDP_DEST_T   defaultDestination = {0};           /* Destination Parameter (id, SDT, URI) */
 static INT32        ts_buffer[2048 / sizeof(INT32)];
 
+/* Telegram List Index, guarded by the mutex of the list */
+static TAU_LD_INDEX_T publishTelegramIndex;
+static TAU_LD_INDEX_T subscribeTelegramIndex;
+static TAU_LD_INDEX_T pdRequestTelegramIndex;
+
 /**********************************************************************************************************************/
 /** TAUL Local Function */
 /**********************************************************************************************************************/
@@ -160,6 +176,18 @@ TRDP_ERR_T appendPublishTelegramList (
         }
     }
 
+    /* Index the telegram for the search */
+    if (tau_ldIndexInsert(&publishTelegramIndex,
+                          pNewPublishTelegram->comId,
+                          pNewPublishTelegram->srcIpAddr,
+                          pNewPublishTelegram->dstIpAddr,
+                          pNewPublishTelegram) != TRDP_NO_ERR)
+    {
+        vos_mutexUnlock(pPublishTelegramMutex);
+        vos_printLog(VOS_LOG_ERROR, "Publish Telegram Index vos_memAlloc() Err\n");
+        return TRDP_MEM_ERR;
+    }
+
     if (*ppHeadPublishTelegram == NULL)
     {
         *ppHeadPublishTelegram = pNewPublishTelegram;
@@ -220,6 +248,12 @@ TRDP_ERR_T deletePublishTelegramList (
         }
     }
 
+    tau_ldIndexRemove(&publishTelegramIndex,
+                      pDeletePublishTelegram->comId,
+                      pDeletePublishTelegram->srcIpAddr,
+                      pDeletePublishTelegram->dstIpAddr,
+                      pDeletePublishTelegram);
+
     /* handle removal of first element */
     if (pDeletePublishTelegram == *ppHeadPublishTelegram)
     {
@@ -294,28 +328,16 @@ PUBLISH_TELEGRAM_T *searchPublishTelegramList (
         }
     }
 
-    /* Check PublishTelegram List Loop */
-    for (iterPublishTelegram = pHeadPublishTelegram;
-         iterPublishTelegram != NULL;
-         iterPublishTelegram = iterPublishTelegram->pNextPublishTelegram)
-    {
-        /* Publish Telegram: We match if src/dst address is zero or matches, and comId */
-        if ((iterPublishTelegram->comId == comId)
-            && (iterPublishTelegram->srcIpAddr == 0 || iterPublishTelegram->srcIpAddr == srcIpAddr)
-            && (iterPublishTelegram->dstIpAddr == 0 || iterPublishTelegram->dstIpAddr == dstIpAddr))
-        {
-            /* UnLock Publish Telegram by Mutex */
-            vos_mutexUnlock(pPublishTelegramMutex);
-            return iterPublishTelegram;
-        }
-        else
-        {
-            continue;
-        }
-    }
+    /* Publish Telegram: We match if src/dst address is zero or matches, and comId */
+    iterPublishTelegram = (PUBLISH_TELEGRAM_T *) tau_ldIndexSearch(&publishTelegramIndex,
+                                                                   comId,
+                                                                   srcIpAddr,
+                                                                   dstIpAddr,
+                                                                   NULL,
+                                                                   NULL);
     /* UnLock Publish Telegram by Mutex */
     vos_mutexUnlock(pPublishTelegramMutex);
-    return NULL;
+    return iterPublishTelegram;
 }
 
 /**********************************************************************************************************************/
@@ -382,6 +404,18 @@ TRDP_ERR_T appendSubscribeTelegramList (
         }
     }
 
+    /* Index the telegram for the search */
+    if (tau_ldIndexInsert(&subscribeTelegramIndex,
+                          pNewSubscribeTelegram->comId,
+                          pNewSubscribeTelegram->srcIpAddr,
+                          pNewSubscribeTelegram->dstIpAddr,
+                          pNewSubscribeTelegram) != TRDP_NO_ERR)
+    {
+        vos_mutexUnlock(pSubscribeTelegramMutex);
+        vos_printLog(VOS_LOG_ERROR, "Subscribe Telegram Index vos_memAlloc() Err\n");
+        return TRDP_MEM_ERR;
+    }
+
     if (*ppHeadSubscribeTelegram == NULL)
     {
         *ppHeadSubscribeTelegram = pNewSubscribeTelegram;
@@ -442,6 +476,12 @@ TRDP_ERR_T deleteSubscribeTelegramList (
         }
     }
 
+    tau_ldIndexRemove(&subscribeTelegramIndex,
+                      pDeleteSubscribeTelegram->comId,
+                      pDeleteSubscribeTelegram->srcIpAddr,
+                      pDeleteSubscribeTelegram->dstIpAddr,
+                      pDeleteSubscribeTelegram);
+
     /* handle removal of first element */
     if (pDeleteSubscribeTelegram == *ppHeadSubscribeTelegram)
     {
@@ -514,28 +554,16 @@ SUBSCRIBE_TELEGRAM_T *searchSubscribeTelegramList (
             return NULL;
         }
     }
-    /* Check Subscribe Telegram List Loop */
-    for (iterSubscribeTelegram = pHeadSubscribeTelegram;
-         iterSubscribeTelegram != NULL;
-         iterSubscribeTelegram = iterSubscribeTelegram->pNextSubscribeTelegram)
-    {
-        /* Subscribe Telegram: We match if src/dst address is zero or matches, and comId */
-        if ((iterSubscribeTelegram->comId == comId)
-            && (iterSubscribeTelegram->srcIpAddr == 0 || iterSubscribeTelegram->srcIpAddr == srcIpAddr)
-            && (iterSubscribeTelegram->dstIpAddr == 0 || iterSubscribeTelegram->dstIpAddr == dstIpAddr))
-        {
-            /* UnLock Subscribe Telegram by Mutex */
-            vos_mutexUnlock(pSubscribeTelegramMutex);
-            return iterSubscribeTelegram;
-        }
-        else
-        {
-            continue;
-        }
-    }
+    /* Subscribe Telegram: We match if src/dst address is zero or matches, and comId */
+    iterSubscribeTelegram = (SUBSCRIBE_TELEGRAM_T *) tau_ldIndexSearch(&subscribeTelegramIndex,
+                                                                       comId,
+                                                                       srcIpAddr,
+                                                                       dstIpAddr,
+                                                                       NULL,
+                                                                       NULL);
     /* UnLock Subscribe Telegram by Mutex */
     vos_mutexUnlock(pSubscribeTelegramMutex);
-    return NULL;
+    return iterSubscribeTelegram;
 }
 
 /**********************************************************************************************************************/
@@ -647,6 +675,18 @@ TRDP_ERR_T appendPdRequestTelegramList (
         }
     }
 
+    /* Index the telegram for the search */
+    if (tau_ldIndexInsert(&pdRequestTelegramIndex,
+                          pNewPdRequestTelegram->comId,
+                          pNewPdRequestTelegram->srcIpAddr,
+                          pNewPdRequestTelegram->dstIpAddr,
+                          pNewPdRequestTelegram) != TRDP_NO_ERR)
+    {
+        vos_mutexUnlock(pPdRequestTelegramMutex);
+        vos_printLog(VOS_LOG_ERROR, "PD Request Telegram Index vos_memAlloc() Err\n");
+        return TRDP_MEM_ERR;
+    }
+
     if (*ppHeadPdRequestTelegram == NULL)
     {
         *ppHeadPdRequestTelegram = pNewPdRequestTelegram;
@@ -707,6 +747,12 @@ TRDP_ERR_T deletePdRequestTelegramList (
         }
     }
 
+    tau_ldIndexRemove(&pdRequestTelegramIndex,
+                      pDeletePdRequestTelegram->comId,
+                      pDeletePdRequestTelegram->srcIpAddr,
+                      pDeletePdRequestTelegram->dstIpAddr,
+                      pDeletePdRequestTelegram);
+
     /* handle removal of first element */
     if (pDeletePdRequestTelegram == *ppHeadPdRequestTelegram)
     {
@@ -735,6 +781,26 @@ TRDP_ERR_T deletePdRequestTelegramList (
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Check the reply of a PD Request Telegram, zero matches any
+ *
+ *  @param[in]      pTelegram                   pointer to PD Request Telegram
+ *  @param[in]      pArg                        pointer to the PD_REQUEST_REPLY_T searched for
+ *
+ *  @retval         TRUE                        reply comId and IP Address match
+ *  @retval         FALSE                       no match
+ */
+static BOOL8 matchPdRequestReply (
+    const void  *pTelegram,
+    const void  *pArg)
+{
+    const PD_REQUEST_TELEGRAM_T *pPdRequestTelegram = (const PD_REQUEST_TELEGRAM_T *) pTelegram;
+    const PD_REQUEST_REPLY_T    *pReply             = (const PD_REQUEST_REPLY_T *) pArg;
+
+    return (pPdRequestTelegram->replyComId == 0 || pPdRequestTelegram->replyComId == pReply->replyComId)
+           && (pPdRequestTelegram->replyIpAddr == 0 || pPdRequestTelegram->replyIpAddr == pReply->replyIpAddr);
+}
+
 /**********************************************************************************************************************/
 /** Return the PD Request with same comId and IP addresses
  *
@@ -757,6 +823,7 @@ PD_REQUEST_TELEGRAM_T *searchPdRequestTelegramList (
     TRDP_IP_ADDR_T          replyIpAddr)
 {
     PD_REQUEST_TELEGRAM_T   *iterPdRequestTelegram;
+    PD_REQUEST_REPLY_T      reply;
     extern VOS_MUTEX_T      pPdRequestTelegramMutex;
     VOS_ERR_T vosErr = VOS_NO_ERR;
 
@@ -783,30 +850,18 @@ PD_REQUEST_TELEGRAM_T *searchPdRequestTelegramList (
             return NULL;
         }
     }
-    /* Check PD Request Telegram List Loop */
-    for (iterPdRequestTelegram = pHeadPdRequestTelegram;
-         iterPdRequestTelegram != NULL;
-         iterPdRequestTelegram = iterPdRequestTelegram->pNextPdRequestTelegram)
-    {
-        /* PD Request Telegram: We match if src/dst address is zero or matches, and comId */
-        if ((iterPdRequestTelegram->comId == comId)
-            && (iterPdRequestTelegram->replyComId == 0 || iterPdRequestTelegram->replyComId == replyComId)
-            && (iterPdRequestTelegram->srcIpAddr == 0 || iterPdRequestTelegram->srcIpAddr == srcIpAddr)
-            && (iterPdRequestTelegram->dstIpAddr == 0 || iterPdRequestTelegram->dstIpAddr == dstIpAddr)
-            && (iterPdRequestTelegram->replyIpAddr == 0 || iterPdRequestTelegram->replyIpAddr == replyIpAddr))
-        {
-            /* UnLock PD Request Telegram by Mutex */
-            vos_mutexUnlock(pPdRequestTelegramMutex);
-            return iterPdRequestTelegram;
-        }
-        else
-        {
-            continue;
-        }
-    }
+    /* PD Request Telegram: We match if src/dst address is zero or matches, and comId, then the reply */
+    reply.replyComId    = replyComId;
+    reply.replyIpAddr   = replyIpAddr;
+    iterPdRequestTelegram = (PD_REQUEST_TELEGRAM_T *) tau_ldIndexSearch(&pdRequestTelegramIndex,
+                                                                        comId,
+                                                                        srcIpAddr,
+                                                                        dstIpAddr,
+                                                                        matchPdRequestReply,
+                                                                        &reply);
     /* UnLock PD Request Telegram by Mutex */
     vos_mutexUnlock(pPdRequestTelegramMutex);
-    return NULL;
+    return iterPdRequestTelegram;
 }
 
 #ifndef XML_CONFIG_ENABLE
@@ -2507,11 +2562,9 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
                     if (iterPD->addr.comId != TRDP_GLOBAL_STATISTICS_COMID)
                     {
                         /* Update Publish Dataset */
-                        tau_ldLockTrafficStore();
-                        memcpy((void *)ts_buffer,
-                               (UINT8 *)((INT32)pTrafficStoreAddr + *(UINT16 *)(iterPD->pUserRef)),
-                               2048);
-                        tau_ldUnlockTrafficStore();
+                        (void) tau_readTrafficStore(*(UINT16 *)(iterPD->pUserRef),
+                                                    (UINT8 *)ts_buffer,
+                                                    (iterPD->dataSize < sizeof(ts_buffer)) ? iterPD->dataSize : sizeof(ts_buffer));
                         err = tlp_put(
                                 appHandle,
                                 iterPD,
@@ -2625,11 +2678,9 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
                         if (iterPD->addr.comId != TRDP_GLOBAL_STATISTICS_COMID)
                         {
                             /* Update Publish Dataset */
-                            tau_ldLockTrafficStore();
-                            memcpy((void *)ts_buffer,
-                                   (UINT8 *)((INT32)pTrafficStoreAddr + *(UINT16 *)(iterPD->pUserRef)),
-                                   2048);
-                            tau_ldUnlockTrafficStore();
+                            (void) tau_readTrafficStore(*(UINT16 *)(iterPD->pUserRef),
+                                                        (UINT8 *)ts_buffer,
+                                                        (iterPD->dataSize < sizeof(ts_buffer)) ? iterPD->dataSize : sizeof(ts_buffer));
                             err = tlp_put(
                                     appHandle2,
                                     iterPD,
@@ -2752,6 +2803,9 @@ TRDP_ERR_T tau_ldInit (
     pHeadPublishTelegram    = NULL;
     pHeadSubscribeTelegram  = NULL;
     pHeadPdRequestTelegram  = NULL;
+    tau_ldIndexClear(&publishTelegramIndex);
+    tau_ldIndexClear(&subscribeTelegramIndex);
+    tau_ldIndexClear(&pdRequestTelegramIndex);
 
     /* Clear mutex pointers */
     pPublishTelegramMutex   = NULL;
@@ -2869,6 +2923,12 @@ TRDP_ERR_T tau_ldInit (
             /* Finishing tau_initMarshall() ? */
             if (marshallInitFirstTime == TRUE)
             {
+                /* Release the context of an earlier tau_ldInit() */
+                if (marshallConfig.pRefCon != NULL)
+                {
+                    (void) tau_deInitMarshall(marshallConfig.pRefCon);
+                    marshallConfig.pRefCon = NULL;
+                }
                 /* Set dataSet in marshall table */
                 err = tau_initMarshall(&marshallConfig.pRefCon, numComId, pComIdDsIdMap, numDataset, apDataset);
                 if (err != TRDP_NO_ERR)
@@ -3073,6 +3133,13 @@ TRDP_ERR_T tau_ldTerminate (
         vos_threadDelay(1000);
     }
 
+    /* Release the marshalling context, it refers to the datasets freed below */
+    if (marshallConfig.pRefCon != NULL)
+    {
+        (void) tau_deInitMarshall(marshallConfig.pRefCon);
+        marshallConfig.pRefCon = NULL;
+    }
+
 /* #ifdef XML_CONFIG_ENABLE */
     /*  Free allocated memory - parsed telegram configuration */
     for (i = 0; i < LADDER_IF_NUMBER; i++)
@@ -3240,6 +3307,10 @@ TRDP_ERR_T tau_ldTerminate (
     {
         /* Don't Delete PD Telegram */
     }
+    /* Release Telegram List Index */
+    tau_ldIndexClear(&publishTelegramIndex);
+    tau_ldIndexClear(&subscribeTelegramIndex);
+    tau_ldIndexClear(&pdRequestTelegramIndex);
 
     /* Ladder Terminate */
     err = tau_ladder_terminate();
@@ -3526,7 +3597,7 @@ void tau_ldRecvPdDs (
     UINT32          subnetId;                   /* Using Sub-network Id */
     UINT32          displaySubnetId;       /* Using Sub-network Id for Display log */
     UINT16          offset;                               /* Traffic Store Offset Address */
-    extern UINT8    *pTrafficStoreAddr;         /* pointer to pointer to Traffic Store Address */
+    UINT32          size;                                 /* Traffic Store dataset size */
 
     SUBSCRIBE_TELEGRAM_T *pSubscribeTelegram;
     TRDP_ERR_T      err;
@@ -3582,9 +3653,7 @@ void tau_ldRecvPdDs (
             /* Clear Traffic Store */
             /* Get offset Address */
             offset = (UINT16)pSubscribeTelegram->pPdParameter->offset;
-            tau_ldLockTrafficStore();
-            memset((void *)((INT32)pTrafficStoreAddr + offset), 0, pSubscribeTelegram->dataset.size);
-            tau_ldUnlockTrafficStore();
+            (void) tau_writeTrafficStore(offset, NULL, pSubscribeTelegram->dataset.size);
 
             /* Set sunbetId for display log */
             if ( subnetId == SUBNET1)
@@ -3610,8 +3679,13 @@ void tau_ldRecvPdDs (
         /* Check Marshalling Kind : Marshalling Enable */
         if ((pSubscribeTelegram->pPdParameter->flags & TRDP_FLAGS_MARSHALL) == TRDP_FLAGS_MARSHALL)
         {
-            /* unmarshalling */
-            tau_ldLockTrafficStore();
+            /* unmarshalling, only the blocks of this dataset are locked */
+            size = pSubscribeTelegram->dataset.size;
+            if (tau_beginWriteTrafficStore(offset, size) != TRDP_NO_ERR)
+            {
+                vos_printLog(VOS_LOG_ERROR, "comId:%d dataset exceeds Traffic Store\n", pPDInfo->comId);
+                return;
+            }
             err = tau_unmarshall(
                     &marshallConfig.pRefCon,                                            /* pointer to user context*/
                     pPDInfo->comId,                                                     /* comId */
@@ -3623,7 +3697,7 @@ void tau_ldRecvPdDs (
                     &pSubscribeTelegram->dataset.size,                                  /* destination Buffer Size */
                     &pSubscribeTelegram->pDatasetDescriptor);                           /* pointer to pointer of cached
                                                                                           dataset */
-            tau_ldUnlockTrafficStore();
+            (void) tau_endWriteTrafficStore(offset, size);
             if (err != TRDP_NO_ERR)
             {
                 vos_printLog(VOS_LOG_ERROR, "tau_unmarshall returns error %d\n", err);
@@ -3633,9 +3707,7 @@ void tau_ldRecvPdDs (
         else
         {
             /* Set received PD Data in Traffic Store */
-            tau_ldLockTrafficStore();
-            memcpy((void *)((INT32)pTrafficStoreAddr + offset), pData, dataSize);
-            tau_ldUnlockTrafficStore();
+            (void) tau_writeTrafficStore(offset, pData, dataSize);
         }
     }
 }
@@ -20,6 +20,10 @@
  * $Id$
  *
  *
+ *      AG 2026-10-18: Documented the pRefCon == NULL fallback as not thread-safe
+ *      AG 2026-10-18: tau_calcDatasetSize() returns the size of fixed size datasets memoized at init
+ *      AG 2026-10-18: Marshalling contexts per pRefCon, tau_deInitMarshall(), tau_enableMarshallPlans() per context
+ *      AG 2026-10-18: Compiled marshalling plans, tau_enableMarshallPlans()
  *      BL 2015-12-14: Ticket #33: source size check for marshalling
  */
 
@@ -47,6 +51,10 @@ extern "C" {
 
 #define TAU_MAX_DS_LEVEL  5
 
+#ifndef TAU_MAX_PLAN_OPS
+#define TAU_MAX_PLAN_OPS  2048u     /**< max. number of copy/swap steps of the plans of one context */
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -63,16 +71,24 @@ extern "C" {
 
 /**********************************************************************************************************************/
 /**    Function to initialise the marshalling/unmarshalling.
+ *    Both arrays are sorted in place, the datasets must exist as long as the returned context is used.
+ *    The context holds all lookups resolved, independent marshalling contexts may be used concurrently.
+ *    It is to be passed as pRefCon to the marshalling functions, typically via TRDP_MARSHALL_CONFIG_T,
+ *    and released by tau_deInitMarshall(). A context still held in *ppRefCon is released and replaced.
+ *    Calls with pRefCon == NULL use the context initialised last.
+ *    That fallback exists for applications written against the single global configuration: it is not
+ *    thread-safe, a tau_initMarshall() or tau_deInitMarshall() on one thread changes or frees the context
+ *    another thread marshalls with. Multithreaded applications pass the returned pRefCon.
  *
- *
- *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
+ *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling,
+ *                                   if NULL the context is kept internally
  *  @param[in]      numComId         Number of datasets found in the configuration
  *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
  *  @param[in]      numDataSet       Number of datasets found in the configuration
  *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
  *
  *  @retval         TRDP_NO_ERR      no error
- *  @retval         TRDP_MEM_ERR     provided buffer to small
+ *  @retval         TRDP_MEM_ERR     out of memory
  *  @retval         TRDP_PARAM_ERR   Parameter error
  *
  */
@@ -84,6 +100,35 @@ EXT_DECL TRDP_ERR_T tau_initMarshall(
     UINT32 numDataSet,
     TRDP_DATASET_T         * pDataset[]);
 
+/**********************************************************************************************************************/
+/**    Release a marshalling context.
+ *    Must be called before tlc_terminate() if the context was allocated from the TRDP memory pool.
+ *
+ *  @param[in]      pRefCon          Context returned by tau_initMarshall(), NULL for the one kept internally
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_PARAM_ERR   no such context
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_deInitMarshall(
+    void *pRefCon);
+
+/**********************************************************************************************************************/
+/**    Switch the use of the compiled marshalling plans on or off.
+ *    tau_initMarshall() compiles every dataset into a flat list of copy and byte swap steps, variable sized
+ *    parts are left to the interpreter. The plans are used by default, switching them off is meant for
+ *    verification and benchmarking.
+ *
+ *  @param[in]      pRefCon          Context returned by tau_initMarshall() or NULL
+ *  @param[in]      enable           TRUE to use the compiled plans, FALSE to always interpret the datasets
+ *
+ */
+
+EXT_DECL void tau_enableMarshallPlans(
+    void    *pRefCon,
+    BOOL8   enable);
+
 
 
 /**********************************************************************************************************************/
@@ -206,6 +251,8 @@ EXT_DECL TRDP_ERR_T tau_unmarshallDs (
 
 /**********************************************************************************************************************/
 /**    Calculate data set size by given data set id.
+ *    The size of datasets without variable sized elements is computed once by tau_initMarshall(),
+ *    the source is not walked for them.
  *
  *  @param[in]      pRefCon         Pointer to user context
  *  @param[in]      dsId            Dataset id to identify the structure out of a configuration
@@ -232,6 +279,7 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSize (
 
 /**********************************************************************************************************************/
 /**    Calculate data set size by given ComId.
+ *    See tau_calcDatasetSize().
  *
  *  @param[in]      pRefCon         Pointer to user context
  *  @param[in]      comId           ComId id to identify the structure out of a configuration
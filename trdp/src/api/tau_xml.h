@@ -19,6 +19,7 @@
  /*
  * $Id$
  *
+ *      AG 2026-10-18: Binary configuration cache, tau_prepareXmlCache and tau_writeXmlCache
  *      AR 2020-05-08: Added attribute 'name' to event, method, field and instance structures used for service oriented interface
  *      SB 2020-01-27: Added parsing for dummyService flag to Service definitions and MD option for events
  *     CKH 2019-10-11: Ticket #2: TRDPXML: Support of mapped devices missing (XLS #64)
@@ -239,6 +240,7 @@ typedef struct
 } TRDP_DBG_CONFIG_T;
 
 struct XML_HANDLE;
+struct TAU_XML_CACHE;
 
 
 /** Parsed XML document handle
@@ -246,6 +248,7 @@ struct XML_HANDLE;
 typedef struct
 {
     struct XML_HANDLE *pXmlDocument;           /**< XML document context */
+    struct TAU_XML_CACHE *pCache;              /**< Configuration cache, NULL if read from XML only */
 } TRDP_XML_DOC_HANDLE_T;
 
 
@@ -293,6 +296,46 @@ EXT_DECL TRDP_ERR_T tau_prepareXmlMem (
     TRDP_XML_DOC_HANDLE_T   *pDocHnd
     );
 
+/**********************************************************************************************************************/
+/**    Prepare a document from a binary configuration cache, fall back to the XML file.
+ *  The cache is used if it was written by tau_writeXmlCache for the current contents of the XML file and by a build
+ *  with the same structure layout, otherwise the XML file is opened as by tau_prepareXmlDoc.
+ *  The device, interface and dataset configuration is then copied from the cache without parsing, the XML file is
+ *  only read when other configuration is requested. All read functions and their free functions are used as usual.
+ *
+ *  @param[in]      pFileName         Path and filename of the xml configuration file
+ *  @param[in]      pCacheFileName    Path and filename of the cache file
+ *  @param[out]     pDocHnd           Handle of the document, pDocHnd->pCache is NULL if the cache was not used
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    File does not exist
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_prepareXmlCache (
+    const CHAR8             *pFileName,
+    const CHAR8             *pCacheFileName,
+    TRDP_XML_DOC_HANDLE_T   *pDocHnd
+    );
+
+/**********************************************************************************************************************/
+/**    Parse an XML configuration file and write its binary configuration cache.
+ *  The cache holds the device configuration, the configuration of all its bus interfaces and the datasets.
+ *  It is written to a temporary file first and renamed, a running reader never sees a partial cache.
+ *
+ *  @param[in]      pFileName         Path and filename of the xml configuration file
+ *  @param[in]      pCacheFileName    Path and filename of the cache file to write
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    XML file does not exist
+ *  @retval         TRDP_IO_ERR       cache could not be written
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_writeXmlCache (
+    const CHAR8             *pFileName,
+    const CHAR8             *pCacheFileName
+    );
+
 /**********************************************************************************************************************/
 /**    Free all the memory allocated by tau_prepareXmlDoc
  *
@@ -17,6 +17,17 @@
 /*
 * $Id$
 *
+*      AG 2026-10-18: tlp_putEncoded() added
+*      AG 2026-10-18: tlm_confirmReply() added
+*      AG 2026-10-18: tlc_run(), tlc_stopRun(), tlc_getRunStatistics() added
+*      AG 2026-10-18: tlc_getNextDeadline() added
+*      AG 2026-10-18: tlp_startSenders(), tlp_stopSenders()
+*      AG 2026-10-18: tlc_getIndexStatistics() added
+*      AG 2026-10-18: tlp_getDecoded() added
+*      AG 2026-10-18: tlm_startWorker(), tlm_stopWorker()
+*      AG 2026-10-18: Added tlm_requestAggregate
+*      AG 2026-10-18: Added tlm_requestAsync, tlm_getCompletionDesc, tlm_getCompletion, tlm_releaseCompletion
+*      AG 2026-10-18: Added tlm_replyNoCopy
 *      A 2023-01-13: Ticket #412 Added tlp_republishService
 *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced
 *      BL 2020-09-08: Ticket #343 userStatus parameter size in tlm_reply and tlm_replyQuery
@@ -101,6 +112,10 @@ EXT_DECL TRDP_ERR_T tlc_presetIndexSession (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_IDX_TABLE_T    *pIndexTableSizes);
 
+EXT_DECL TRDP_ERR_T tlc_getIndexStatistics (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_IDX_STATISTICS_T   *pStatistics);
+
 EXT_DECL TRDP_ERR_T tlc_closeSession (
     TRDP_APP_SESSION_T appHandle);
 
@@ -126,11 +141,26 @@ EXT_DECL TRDP_ERR_T tlc_getInterval (
     TRDP_FDS_T          *pFileDesc,
     TRDP_SOCK_T         *pNoDesc);
 
+EXT_DECL TRDP_ERR_T tlc_getNextDeadline (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TIME_T         *pDeadline);
+
 EXT_DECL TRDP_ERR_T tlc_process (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_FDS_T          *pRfds,
     INT32               *pCount);
 
+EXT_DECL TRDP_ERR_T tlc_run (
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_RUN_CONFIG_T *pConfig);
+
+EXT_DECL TRDP_ERR_T tlc_stopRun (
+    TRDP_APP_SESSION_T appHandle);
+
+EXT_DECL TRDP_ERR_T tlc_getRunStatistics (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_RUN_STATISTICS_T   *pStatistics);
+
 EXT_DECL TRDP_IP_ADDR_T tlc_getOwnIpAddress (
     TRDP_APP_SESSION_T appHandle);
 
@@ -143,6 +173,14 @@ EXT_DECL TRDP_ERR_T     tlp_getInterval (
 EXT_DECL TRDP_ERR_T tlp_processSend (
     TRDP_APP_SESSION_T appHandle);
 
+EXT_DECL TRDP_ERR_T tlp_startSenders (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              noOfSenders,
+    UINT8               priority);
+
+EXT_DECL TRDP_ERR_T tlp_stopSenders (
+    TRDP_APP_SESSION_T  appHandle);
+
 EXT_DECL TRDP_ERR_T tlp_processReceive (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_FDS_T          *pRfds,
@@ -196,6 +234,14 @@ EXT_DECL TRDP_ERR_T tlp_put (
     const UINT8         *pData,
     UINT32              dataSize);
 
+EXT_DECL TRDP_ERR_T tlp_putEncoded (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    TRDP_MARSHALL_T     pfEncode,
+    void                *pEncodeRef,
+    const UINT8         *pData,
+    UINT32              dataSize);
+
 EXT_DECL TRDP_ERR_T tlp_putImmediate (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_PUB_T          pubHandle,
@@ -272,6 +318,15 @@ EXT_DECL TRDP_ERR_T tlp_get (
     UINT8               *pData,
     UINT32              *pDataSize);
 
+EXT_DECL TRDP_ERR_T tlp_getDecoded (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_PD_INFO_T      *pPdInfo,
+    TRDP_UNMARSHALL_T   pfDecode,
+    void                *pDecodeRef,
+    UINT8               *pData,
+    UINT32              *pDataSize);
+
 #if MD_SUPPORT
 
 EXT_DECL TRDP_ERR_T tlm_process (
@@ -285,6 +340,13 @@ EXT_DECL TRDP_ERR_T tlm_getInterval (
     TRDP_FDS_T          *pFileDesc,
     TRDP_SOCK_T         *pNoDesc);
 
+EXT_DECL TRDP_ERR_T tlm_startWorker (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT8               priority);
+
+EXT_DECL TRDP_ERR_T tlm_stopWorker (
+    TRDP_APP_SESSION_T  appHandle);
+
 EXT_DECL TRDP_ERR_T tlm_notify (
     TRDP_APP_SESSION_T      appHandle,
     void                    *pUserRef,
@@ -321,6 +383,56 @@ EXT_DECL TRDP_ERR_T tlm_request (
     const TRDP_URI_USER_T   srcURI,
     const TRDP_URI_USER_T   destURI);
 
+EXT_DECL TRDP_ERR_T tlm_requestAggregate (
+    TRDP_APP_SESSION_T              appHandle,
+    void                            *pUserRef,
+    TRDP_MD_AGGREGATE_CALLBACK_T    pfCbFunction,
+    TRDP_UUID_T                     *pSessionId,
+    UINT32                          comId,
+    UINT32                          etbTopoCnt,
+    UINT32                          opTrnTopoCnt,
+    TRDP_IP_ADDR_T                  srcIpAddr,
+    TRDP_IP_ADDR_T                  destIpAddr,
+    TRDP_FLAGS_T                    pktFlags,
+    UINT32                          numReplies,
+    UINT32                          replyTimeout,
+    const TRDP_SEND_PARAM_T         *pSendParam,
+    const UINT8                     *pData,
+    UINT32                          dataSize,
+    const TRDP_URI_USER_T           srcURI,
+    const TRDP_URI_USER_T           destURI);
+
+EXT_DECL TRDP_ERR_T tlm_requestAsync (
+    TRDP_APP_SESSION_T      appHandle,
+    void                    *pUserRef,
+    TRDP_UUID_T             *pSessionId,
+    UINT32                  comId,
+    UINT32                  etbTopoCnt,
+    UINT32                  opTrnTopoCnt,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          destIpAddr,
+    TRDP_FLAGS_T            pktFlags,
+    UINT32                  numReplies,
+    UINT32                  replyTimeout,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    const UINT8             *pData,
+    UINT32                  dataSize,
+    const TRDP_URI_USER_T   srcURI,
+    const TRDP_URI_USER_T   destURI,
+    TRDP_MD_HANDLE_T        *pHandle);
+
+EXT_DECL TRDP_ERR_T tlm_getCompletionDesc (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SOCK_T         *pDesc);
+
+EXT_DECL TRDP_ERR_T tlm_getCompletion (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_MD_COMPLETION_T    *pCompletion);
+
+EXT_DECL TRDP_ERR_T tlm_releaseCompletion (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_MD_COMPLETION_T    *pCompletion);
+
 
 EXT_DECL TRDP_ERR_T tlm_confirm (
     TRDP_APP_SESSION_T      appHandle,
@@ -328,6 +440,13 @@ EXT_DECL TRDP_ERR_T tlm_confirm (
     UINT16                  userStatus,
     const TRDP_SEND_PARAM_T *pSendParam);
 
+EXT_DECL TRDP_ERR_T tlm_confirmReply (
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_UUID_T       *pSessionId,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    UINT16                  userStatus,
+    const TRDP_SEND_PARAM_T *pSendParam);
+
 
 EXT_DECL TRDP_ERR_T tlm_abortSession (
     TRDP_APP_SESSION_T  appHandle,
@@ -374,6 +493,18 @@ EXT_DECL TRDP_ERR_T tlm_reply (
     UINT32                  dataSize,
     const CHAR8             *srcURI);
 
+EXT_DECL TRDP_ERR_T tlm_replyNoCopy (
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_UUID_T       *pSessionId,
+    UINT32                  comId,
+    UINT32                  userStatus,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    const UINT8             *pData,
+    UINT32                  dataSize,
+    const CHAR8             *srcURI,
+    TRDP_MD_RELEASE_T       pfRelease,
+    void                    *pRefCon);
+
 EXT_DECL TRDP_ERR_T tlm_replyQuery (
     TRDP_APP_SESSION_T      appHandle,
     const TRDP_UUID_T       *pSessionId,
@@ -17,6 +17,12 @@
 /*
  * $Id$
  *
+ *      AG 2026-10-18: TRDP_RUN_CONFIG_T, TRDP_RUN_STATISTICS_T for the session reactor (tlc_run)
+ *      AG 2026-10-18: TRDP_OPTION_PD_SCHEDULE, TRDP_OPTION_T widened to 16 bits
+ *      AG 2026-10-18: TRDP_IDX_STATISTICS_T for index table diagnostics (tlc_getIndexStatistics)
+ *      AG 2026-10-18: TRDP_MD_REPLY_SET_T, TRDP_MD_AGGREGATE_CALLBACK_T for aggregated MD requests (tlm_requestAggregate)
+ *      AG 2026-10-18: TRDP_MD_HANDLE_T, TRDP_MD_COMPLETION_T for asynchronous MD requests (tlm_requestAsync)
+ *      AG 2026-10-18: TRDP_MD_RELEASE_T for application owned MD payloads (tlm_replyNoCopy)
  *     CWE 2023-02-14: Ticket #419 PDTestFastBase2 failed - Comments adapted for base 2 cycle time support
  *     AHW 2023-01-11: Lint warnigs
  *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
@@ -320,6 +326,23 @@ typedef struct
 } TRDP_MD_INFO_T;
 
 
+/**    Handle of an asynchronous MD request (see tlm_requestAsync()), 0 is never used.
+ */
+typedef UINT32 TRDP_MD_HANDLE_T;
+
+/**    Completion of an asynchronous MD request, fetched with tlm_getCompletion().
+ *     A request may complete more than once (one entry per reply), the last one carries final == TRUE.
+ */
+typedef struct
+{
+    TRDP_MD_HANDLE_T    handle;             /**< handle returned by tlm_requestAsync()      */
+    BOOL8               final;              /**< no more completions for this handle        */
+    TRDP_MD_INFO_T      info;               /**< as passed to a MD callback                 */
+    UINT8               *pData;             /**< copy of the received data or NULL          */
+    UINT32              dataSize;           /**< size of received data                      */
+} TRDP_MD_COMPLETION_T;
+
+
 /**    Quality/type of service, time to live , no. of retries, TSN flag and VLAN ID   */
 typedef struct
 {
@@ -681,6 +704,62 @@ typedef void (*TRDP_MD_CALLBACK_T)(
     UINT8                   *pData,
     UINT32                  dataSize);
 
+/**    One reply collected by an aggregated request (see tlm_requestAggregate()).
+ */
+typedef struct
+{
+    TRDP_IP_ADDR_T      srcIpAddr;          /**< replier                                    */
+    TRDP_MSG_T          msgType;            /**< TRDP_MSG_MP, TRDP_MSG_MQ or TRDP_MSG_ME    */
+    UINT16              userStatus;         /**< user status of the replier                 */
+    TRDP_REPLY_STATUS_T replyStatus;        /**< reply status                               */
+    UINT32              latency;            /**< us from sending the request to the reply   */
+    TRDP_URI_USER_T     srcUserURI;         /**< source URI user part from MD header        */
+    UINT8               *pData;             /**< reply data, valid during the callback      */
+    UINT32              dataSize;           /**< size of reply data                         */
+} TRDP_MD_REPLY_T;
+
+/**    Result set of an aggregated request, delivered once.
+ *
+ *  resultCode is TRDP_NO_ERR if the expected number of replies arrived before the timeout,
+ *  TRDP_REPLYTO_ERR if the timeout ended the collection (always the case for an unknown number of replies).
+ */
+typedef struct
+{
+    TRDP_UUID_T             sessionId;      /**< session of the request, needed to confirm Mq replies   */
+    UINT32                  comId;          /**< ComID of the request                                   */
+    void                    *pUserRef;      /**< User reference given with the request                  */
+    TRDP_ERR_T              resultCode;     /**< see above                                              */
+    UINT32                  numExpReplies;  /**< number of expected replies, 0 if unknown               */
+    UINT32                  numReplies;     /**< entries in pReplies, one per replier                   */
+    UINT32                  numDuplicates;  /**< replies dropped because their source had replied       */
+    const TRDP_MD_REPLY_T   *pReplies;      /**< replies in order of arrival                            */
+} TRDP_MD_REPLY_SET_T;
+
+/**********************************************************************************************************************/
+/**    Callback for the result set of an aggregated request (see tlm_requestAggregate()).
+ *
+ *  @param[in]    pRefCon       pointer to user context
+ *  @param[in]    appHandle     handle returned also by tlc_init
+ *  @param[in]    pReplySet     collected replies, valid until the callback returns
+ */
+typedef void (*TRDP_MD_AGGREGATE_CALLBACK_T)(
+    void                        *pRefCon,
+    TRDP_APP_SESSION_T          appHandle,
+    const TRDP_MD_REPLY_SET_T   *pReplySet);
+
+/**********************************************************************************************************************/
+/**    Callback handing back an application owned MD payload (see tlm_replyNoCopy()).
+ *     Called from within tlm_process() / tlc_process(), when the stack does not reference the buffer anymore.
+ *
+ *  @param[in]    pRefCon       pointer to user context given with tlm_replyNoCopy()
+ *  @param[in]    pData         the buffer passed to tlm_replyNoCopy()
+ *  @param[in]    dataSize      size of the buffer
+ */
+typedef void (*TRDP_MD_RELEASE_T)(
+    void                    *pRefCon,
+    const UINT8             *pData,
+    UINT32                  dataSize);
+
 
 /**********************************************************************************************************************/
 /** Default MD configuration
@@ -736,8 +815,12 @@ typedef struct
 #define TRDP_OPTION_NO_PD_STATS         0x40u   /**< Suppress PD statistics \
                                                   Default: Don't suppress                                   */
 #define TRDP_OPTION_DEFAULT_CONFIG      0x80u   /**< no XML process config, defaults were used              */
+#define TRDP_OPTION_PD_SCHEDULE         0x100u  /**< Hyperperiod scheduler: set the send phases of the cyclic PDs
+                                                  to minimize the bytes sent per process cycle. Replaces
+                                                  traffic shaping and, on high performance targets, the
+                                                  index tables for sending. Default: OFF                    */
 
-typedef UINT8 TRDP_OPTION_T;
+typedef UINT16 TRDP_OPTION_T;
 
 /**********************************************************************************************************************/
 /** Various flags/general TRDP options for library initialization
@@ -769,6 +852,85 @@ typedef struct
     UINT32  maxNoOfExtPublishers;               /**< Max. number of expected publishers with intervals    >  10000ms (base 2: >  8192ms) */
 } TRDP_IDX_TABLE_T;
 
+#define TRDP_IDX_MAX_SLOTS  128u                /**< Max. number of time slots of an index table (base 2: 128)         */
+#define TRDP_IDX_MAX_DEPTH  255u                /**< Max. depth of an index table                                       */
+
+/**********************************************************************************************************************/
+/** Occupation of the index table of one transmit-time category (HIGH_PERF_INDEXED)
+ */
+typedef struct
+{
+    UINT32  slotCycle;                          /**< time between two slots (us)                                        */
+    UINT32  noOfSlots;                          /**< number of time slots                                               */
+    UINT32  depth;                              /**< allocated entries per slot                                         */
+    UINT32  requiredDepth;                      /**< depth the current publishers need without additional jitter       */
+    UINT32  noOfPublishers;                     /**< number of publishers in this category                              */
+    UINT32  maxFill;                            /**< entries of the fullest slot                                        */
+    UINT32  maxSlotBytes;                       /**< bytes sent in the busiest slot                                     */
+    UINT8   slotFill[TRDP_IDX_MAX_SLOTS];       /**< entries per slot                                                   */
+    UINT32  slotBytes[TRDP_IDX_MAX_SLOTS];      /**< bytes (packet sizes) sent per slot                                 */
+    UINT8   depthHistogram[TRDP_IDX_MAX_DEPTH + 1u];    /**< number of slots holding 0, 1, 2 ... entries          */
+} TRDP_IDX_CAT_STATISTICS_T;
+
+/**********************************************************************************************************************/
+/** Occupation of the index tables of a session (HIGH_PERF_INDEXED), see tlc_getIndexStatistics
+ */
+typedef struct
+{
+    UINT32                      processCycle;   /**< cycle time (us) of the send loop, 0 if tables not yet created      */
+    TRDP_IDX_CAT_STATISTICS_T   lowCat;         /**< publishers with intervals <=   100ms (base 2: <=  128ms)           */
+    TRDP_IDX_CAT_STATISTICS_T   midCat;         /**< publishers with intervals <=  1000ms (base 2: <= 1024ms)           */
+    TRDP_IDX_CAT_STATISTICS_T   highCat;        /**< publishers with intervals <= 10000ms (base 2: <= 8192ms)           */
+    UINT32                      noOfExtPublishers; /**< publishers with intervals > 10000ms (base 2: > 8192ms)          */
+    UINT32                      noOfSubscriptions; /**< entries of the receiver tables                                  */
+    UINT32                      maxCycleBytes;  /**< bytes sent in the busiest 1ms cycle of all categories              */
+    TRDP_IDX_TABLE_T            requiredSizes;  /**< sizes the current publishers and subscribers need, e.g. as
+                                                     preset for tlc_presetIndexSession                                   */
+} TRDP_IDX_STATISTICS_T;
+
+/**********************************************************************************************************************/
+/** Work classes of the session reactor (tlc_run), in order of priority
+ */
+typedef enum
+{
+    TRDP_RUN_PD_SEND    = 0,                    /**< sending of process data, highest priority                          */
+    TRDP_RUN_PD_RECEIVE = 1,                    /**< reception and time-out supervision of process data                 */
+    TRDP_RUN_MD         = 2,                    /**< message data: sending, reception and time-outs                     */
+    TRDP_RUN_CLASSES    = 3                     /**< number of work classes                                             */
+} TRDP_RUN_CLASS_T;
+
+/**********************************************************************************************************************/
+/** Configuration of the session reactor (tlc_run)
+ */
+typedef struct
+{
+    UINT32  budget[TRDP_RUN_CLASSES];           /**< max. time (us) per cycle for each class, 0 = unlimited.
+                                                     PD receive and MD yield when their budget is spent or a PD
+                                                     telegram is due, PD sending is never interrupted                   */
+    UINT32  maxWait;                            /**< max. time (us) to wait for an event, 0 = 1s                        */
+} TRDP_RUN_CONFIG_T;
+
+/**********************************************************************************************************************/
+/** Statistics of one work class of the session reactor
+ */
+typedef struct
+{
+    UINT32  runs;                               /**< number of times the class was processed                            */
+    UINT32  maxTime;                            /**< longest processing time (us)                                       */
+    UINT32  overBudget;                         /**< runs which took longer than the budget                             */
+    UINT32  preempted;                          /**< runs which stopped early, the rest is done in the next cycle       */
+} TRDP_RUN_CLASS_STATISTICS_T;
+
+/**********************************************************************************************************************/
+/** Statistics of the session reactor, see tlc_getRunStatistics
+ */
+typedef struct
+{
+    UINT32                      cycles;         /**< number of reactor cycles                                           */
+    UINT32                      maxSendLatency; /**< max. delay (us) of PD sending behind its due time                  */
+    TRDP_RUN_CLASS_STATISTICS_T cls[TRDP_RUN_CLASSES];  /**< per work class, indexed by TRDP_RUN_CLASS_T            */
+} TRDP_RUN_STATISTICS_T;
+
 
 #ifdef __cplusplus
 }
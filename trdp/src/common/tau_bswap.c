@@ -0,0 +1,501 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_bswap.c
+ *
+ * @brief           Byte order conversion of contiguous arrays for marshalling
+ *
+ * @details         Vector kernels are built with function specific target options, so the library itself
+ *                  does not require more than the baseline instruction set. The kernel is chosen on first use
+ *                  by querying the CPU. Remaining items of an array are handled by the scalar loop.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+ /*
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <string.h>
+
+#include "tau_bswap.h"
+#include "vos_utils.h"
+
+#if !defined(B_ENDIAN) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TAU_BSWAP_X86   1
+#include <immintrin.h>
+#endif
+
+#if !defined(B_ENDIAN) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define TAU_BSWAP_ARM   1
+#include <arm_neon.h>
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+/** Arrays shorter than this are not worth the indirect call */
+#define TAU_BSWAP_MIN_BYTES 32u
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** One conversion kernel, noOfItems is the number of items */
+typedef void (*TAU_BSWAP_FUNC_T)(UINT8 *pDst, const UINT8 *pSrc, UINT32 noOfItems);
+
+/** Kernel set for the three item sizes */
+typedef struct
+{
+    TAU_BSWAP_KERNEL_T  kernel;
+    const CHAR8         *pName;
+    TAU_BSWAP_FUNC_T    pf16;
+    TAU_BSWAP_FUNC_T    pf32;
+    TAU_BSWAP_FUNC_T    pf64;
+} TAU_BSWAP_SET_T;
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Scalar kernels, also used for the remainder of the vector kernels
+ *
+ *  @param[out]     pDst            Pointer to destination
+ *  @param[in]      pSrc            Pointer to source
+ *  @param[in]      noOfItems       Number of items
+ */
+static void scalar16 (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems)
+{
+#ifdef B_ENDIAN
+    memcpy(pDst, pSrc, noOfItems * 2u);
+#else
+    while (noOfItems-- > 0u)
+    {
+        pDst[0] = pSrc[1];
+        pDst[1] = pSrc[0];
+        pDst    += 2u;
+        pSrc    += 2u;
+    }
+#endif
+}
+
+static void scalar32 (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems)
+{
+#ifdef B_ENDIAN
+    memcpy(pDst, pSrc, noOfItems * 4u);
+#else
+    while (noOfItems-- > 0u)
+    {
+        pDst[0] = pSrc[3];
+        pDst[1] = pSrc[2];
+        pDst[2] = pSrc[1];
+        pDst[3] = pSrc[0];
+        pDst    += 4u;
+        pSrc    += 4u;
+    }
+#endif
+}
+
+static void scalar64 (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems)
+{
+#ifdef B_ENDIAN
+    memcpy(pDst, pSrc, noOfItems * 8u);
+#else
+    while (noOfItems-- > 0u)
+    {
+        pDst[0] = pSrc[7];
+        pDst[1] = pSrc[6];
+        pDst[2] = pSrc[5];
+        pDst[3] = pSrc[4];
+        pDst[4] = pSrc[3];
+        pDst[5] = pSrc[2];
+        pDst[6] = pSrc[1];
+        pDst[7] = pSrc[0];
+        pDst    += 8u;
+        pSrc    += 8u;
+    }
+#endif
+}
+
+#ifdef TAU_BSWAP_X86
+/**********************************************************************************************************************/
+/**    SSSE3 kernels: one byte shuffle per 16 bytes
+ *
+ *  @param[out]     pDst            Pointer to destination
+ *  @param[in]      pSrc            Pointer to source
+ *  @param[in]      noOfItems       Number of items
+ *  @param[in]      itemSize        2, 4 or 8
+ */
+__attribute__((target("ssse3")))
+static void ssse3Swap (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems,
+    UINT32      itemSize)
+{
+    UINT32  bytes = noOfItems * itemSize;
+    __m128i mask;
+
+    if (itemSize == 2u)
+    {
+        mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    }
+    else if (itemSize == 4u)
+    {
+        mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    }
+    else
+    {
+        mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    }
+
+    while (bytes >= 16u)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *) pSrc);
+        _mm_storeu_si128((__m128i *) pDst, _mm_shuffle_epi8(v, mask));
+        pSrc    += 16u;
+        pDst    += 16u;
+        bytes   -= 16u;
+    }
+
+    switch (itemSize)
+    {
+       case 2u:
+           scalar16(pDst, pSrc, bytes / 2u);
+           break;
+       case 4u:
+           scalar32(pDst, pSrc, bytes / 4u);
+           break;
+       default:
+           scalar64(pDst, pSrc, bytes / 8u);
+           break;
+    }
+}
+
+static void ssse3Swap16 (UINT8 *pDst, const UINT8 *pSrc, UINT32 noOfItems)
+{
+    ssse3Swap(pDst, pSrc, noOfItems, 2u);
+}
+
+static void ssse3Swap32 (UINT8 *pDst, const UINT8 *pSrc, UINT32 noOfItems)
+{
+    ssse3Swap(pDst, pSrc, noOfItems, 4u);
+}
+
+static void ssse3Swap64 (UINT8 *pDst, const UINT8 *pSrc, UINT32 noOfItems)
+{
+    ssse3Swap(pDst, pSrc, noOfItems, 8u);
+}
+
+/**********************************************************************************************************************/
+/**    AVX2 kernels: one byte shuffle per 32 bytes, the shuffle works within each 128 bit lane
+ *
+ *  @param[out]     pDst            Pointer to destination
+ *  @param[in]      pSrc            Pointer to source
+ *  @param[in]      noOfItems       Number of items
+ *  @param[in]      itemSize        2, 4 or 8
+ */
+__attribute__((target("avx2")))
+static void avx2Swap (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems,
+    UINT32      itemSize)
+{
+    UINT32  bytes = noOfItems * itemSize;
+    __m256i mask;
+
+    if (itemSize == 2u)
+    {
+        mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    }
+    else if (itemSize == 4u)
+    {
+        mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    }
+    else
+    {
+        mask = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    }
+
+    while (bytes >= 32u)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *) pSrc);
+        _mm256_storeu_si256((__m256i *) pDst, _mm256_shuffle_epi8(v, mask));
+        pSrc    += 32u;
+        pDst    += 32u;
+        bytes   -= 32u;
+    }
+
+    /* Leave the upper register halves clean before running legacy SSE code, a pending
+       AVX/SSE transition costs more than the whole conversion of a short array */
+    _mm256_zeroupper();
+
+    /* at most one 16 byte block left */
+    ssse3Swap(pDst, pSrc, bytes / itemSize, itemSize);
+}
+
+static void avx2Swap16 (UINT8 *pDst, const UINT8 *pSrc, UINT32 noOfItems)
+{
+    avx2Swap(pDst, pSrc, noOfItems, 2u);
+}
+
+static void avx2Swap32 (UINT8 *pDst, const UINT8 *pSrc, UINT32 noOfItems)
+{
+    avx2Swap(pDst, pSrc, noOfItems, 4u);
+}
+
+static void avx2Swap64 (UINT8 *pDst, const UINT8 *pSrc, UINT32 noOfItems)
+{
+    avx2Swap(pDst, pSrc, noOfItems, 8u);
+}
+#endif /* TAU_BSWAP_X86 */
+
+#ifdef TAU_BSWAP_ARM
+/**********************************************************************************************************************/
+/**    NEON kernels: byte reversal within 16, 32 or 64 bit lanes, 16 bytes per step
+ *
+ *  @param[out]     pDst            Pointer to destination
+ *  @param[in]      pSrc            Pointer to source
+ *  @param[in]      noOfItems       Number of items
+ */
+static void neonSwap16 (UINT8 *pDst, const UINT8 *pSrc, UINT32 noOfItems)
+{
+    for (; noOfItems >= 8u; noOfItems -= 8u)
+    {
+        vst1q_u8(pDst, vrev16q_u8(vld1q_u8(pSrc)));
+        pSrc    += 16u;
+        pDst    += 16u;
+    }
+    scalar16(pDst, pSrc, noOfItems);
+}
+
+static void neonSwap32 (UINT8 *pDst, const UINT8 *pSrc, UINT32 noOfItems)
+{
+    for (; noOfItems >= 4u; noOfItems -= 4u)
+    {
+        vst1q_u8(pDst, vrev32q_u8(vld1q_u8(pSrc)));
+        pSrc    += 16u;
+        pDst    += 16u;
+    }
+    scalar32(pDst, pSrc, noOfItems);
+}
+
+static void neonSwap64 (UINT8 *pDst, const UINT8 *pSrc, UINT32 noOfItems)
+{
+    for (; noOfItems >= 2u; noOfItems -= 2u)
+    {
+        vst1q_u8(pDst, vrev64q_u8(vld1q_u8(pSrc)));
+        pSrc    += 16u;
+        pDst    += 16u;
+    }
+    scalar64(pDst, pSrc, noOfItems);
+}
+#endif /* TAU_BSWAP_ARM */
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static const TAU_BSWAP_SET_T cKernels[] =
+{
+    {TAU_BSWAP_SCALAR, "scalar", scalar16, scalar32, scalar64}
+#ifdef TAU_BSWAP_X86
+    , {TAU_BSWAP_SSSE3, "ssse3", ssse3Swap16, ssse3Swap32, ssse3Swap64}
+    , {TAU_BSWAP_AVX2, "avx2", avx2Swap16, avx2Swap32, avx2Swap64}
+#endif
+#ifdef TAU_BSWAP_ARM
+    , {TAU_BSWAP_NEON, "neon", neonSwap16, neonSwap32, neonSwap64}
+#endif
+};
+
+static const TAU_BSWAP_SET_T *sKernel = NULL;
+
+/**********************************************************************************************************************/
+/**    Check whether the CPU supports a kernel
+ *
+ *  @param[in]      kernel          kernel to check
+ *
+ *  @retval         TRUE            kernel can be used
+ *  @retval         FALSE           not supported
+ */
+static BOOL8 kernelSupported (
+    TAU_BSWAP_KERNEL_T kernel)
+{
+    switch (kernel)
+    {
+       case TAU_BSWAP_SCALAR:
+           return TRUE;
+#ifdef TAU_BSWAP_X86
+       case TAU_BSWAP_SSSE3:
+           return (__builtin_cpu_supports("ssse3")) ? TRUE : FALSE;
+       case TAU_BSWAP_AVX2:
+           return (__builtin_cpu_supports("avx2")) ? TRUE : FALSE;
+#endif
+#ifdef TAU_BSWAP_ARM
+       case TAU_BSWAP_NEON:
+           return TRUE;     /* the build targets NEON already */
+#endif
+       default:
+           return FALSE;
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Return the kernel in use, select the best one on first call
+ *
+ *  @retval         pointer to kernel set
+ */
+static const TAU_BSWAP_SET_T *activeKernel (void)
+{
+    if (sKernel == NULL)
+    {
+        UINT32 i;
+
+        /* the table is ordered by preference, the last supported entry wins */
+        for (i = 0u; i < sizeof(cKernels) / sizeof(cKernels[0]); i++)
+        {
+            if (kernelSupported(cKernels[i].kernel) == TRUE)
+            {
+                sKernel = &cKernels[i];
+            }
+        }
+    }
+    return sKernel;
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Copy 16 bit items converting between host and network byte order.
+ *
+ *  @param[out]     pDst            Pointer to destination
+ *  @param[in]      pSrc            Pointer to source
+ *  @param[in]      noOfItems       Number of items
+ *
+ */
+void tau_netCopy16 (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems)
+{
+    if ((noOfItems * 2u) < TAU_BSWAP_MIN_BYTES)
+    {
+        scalar16(pDst, pSrc, noOfItems);
+    }
+    else
+    {
+        activeKernel()->pf16(pDst, pSrc, noOfItems);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Copy 32 bit items converting between host and network byte order.
+ *
+ *  @param[out]     pDst            Pointer to destination
+ *  @param[in]      pSrc            Pointer to source
+ *  @param[in]      noOfItems       Number of items
+ *
+ */
+void tau_netCopy32 (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems)
+{
+    if ((noOfItems * 4u) < TAU_BSWAP_MIN_BYTES)
+    {
+        scalar32(pDst, pSrc, noOfItems);
+    }
+    else
+    {
+        activeKernel()->pf32(pDst, pSrc, noOfItems);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Copy 64 bit items converting between host and network byte order.
+ *
+ *  @param[out]     pDst            Pointer to destination
+ *  @param[in]      pSrc            Pointer to source
+ *  @param[in]      noOfItems       Number of items
+ *
+ */
+void tau_netCopy64 (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems)
+{
+    if ((noOfItems * 8u) < TAU_BSWAP_MIN_BYTES)
+    {
+        scalar64(pDst, pSrc, noOfItems);
+    }
+    else
+    {
+        activeKernel()->pf64(pDst, pSrc, noOfItems);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Select the byte swap kernel.
+ *
+ *  @param[in]      kernel          kernel to use, TAU_BSWAP_AUTO for the best one available
+ *
+ *  @retval         TRDP_NO_ERR     kernel selected
+ *  @retval         TRDP_PARAM_ERR  kernel not supported by this build or CPU, selection unchanged
+ */
+TRDP_ERR_T tau_bswapSelect (
+    TAU_BSWAP_KERNEL_T kernel)
+{
+    UINT32 i;
+
+    if (kernel == TAU_BSWAP_AUTO)
+    {
+        sKernel = NULL;
+        return TRDP_NO_ERR;
+    }
+
+    for (i = 0u; i < sizeof(cKernels) / sizeof(cKernels[0]); i++)
+    {
+        if ((cKernels[i].kernel == kernel) && (kernelSupported(kernel) == TRUE))
+        {
+            sKernel = &cKernels[i];
+            return TRDP_NO_ERR;
+        }
+    }
+    return TRDP_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Return the name of the byte swap kernel in use.
+ *
+ *  @retval         "scalar", "ssse3", "avx2" or "neon"
+ */
+const CHAR8 *tau_bswapKernelName (void)
+{
+    return activeKernel()->pName;
+}
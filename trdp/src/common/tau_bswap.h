@@ -0,0 +1,121 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_bswap.h
+ *
+ * @brief           Byte order conversion of contiguous arrays for marshalling
+ *
+ * @details         The conversion kernels are selected at run time: AVX2 or SSSE3 on x86, NEON on ARM,
+ *                  a scalar loop on all other targets. On big endian targets the functions just copy.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+ /*
+ * $Id$
+ *
+ */
+
+#ifndef TAU_BSWAP_H
+#define TAU_BSWAP_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Byte swap kernels */
+typedef enum
+{
+    TAU_BSWAP_AUTO      = 0,    /**< best kernel the CPU supports       */
+    TAU_BSWAP_SCALAR    = 1,    /**< portable scalar loop               */
+    TAU_BSWAP_SSSE3     = 2,    /**< x86 SSSE3, 16 bytes per step       */
+    TAU_BSWAP_AVX2      = 3,    /**< x86 AVX2, 32 bytes per step        */
+    TAU_BSWAP_NEON      = 4     /**< ARM NEON, 16 bytes per step        */
+} TAU_BSWAP_KERNEL_T;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/**    Copy 16 bit items converting between host and network byte order.
+ *    Source and destination must not overlap, neither needs to be aligned.
+ *
+ *  @param[out]     pDst            Pointer to destination
+ *  @param[in]      pSrc            Pointer to source
+ *  @param[in]      noOfItems       Number of items
+ *
+ */
+void tau_netCopy16 (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems);
+
+/**********************************************************************************************************************/
+/**    Copy 32 bit items converting between host and network byte order.
+ *
+ *  @param[out]     pDst            Pointer to destination
+ *  @param[in]      pSrc            Pointer to source
+ *  @param[in]      noOfItems       Number of items
+ *
+ */
+void tau_netCopy32 (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems);
+
+/**********************************************************************************************************************/
+/**    Copy 64 bit items converting between host and network byte order.
+ *
+ *  @param[out]     pDst            Pointer to destination
+ *  @param[in]      pSrc            Pointer to source
+ *  @param[in]      noOfItems       Number of items
+ *
+ */
+void tau_netCopy64 (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems);
+
+/**********************************************************************************************************************/
+/**    Select the byte swap kernel.
+ *    Without a call the best kernel is selected on first use.
+ *
+ *  @param[in]      kernel          kernel to use, TAU_BSWAP_AUTO for the best one available
+ *
+ *  @retval         TRDP_NO_ERR     kernel selected
+ *  @retval         TRDP_PARAM_ERR  kernel not supported by this build or CPU, selection unchanged
+ */
+TRDP_ERR_T tau_bswapSelect (
+    TAU_BSWAP_KERNEL_T kernel);
+
+/**********************************************************************************************************************/
+/**    Return the name of the byte swap kernel in use.
+ *
+ *  @retval         "scalar", "ssse3", "avx2" or "neon"
+ */
+const CHAR8 *tau_bswapKernelName (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAU_BSWAP_H */
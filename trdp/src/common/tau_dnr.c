@@ -17,6 +17,7 @@
  /*
  * $Id$
  *
+ *      AG 2026-10-18: Own-thread reply loop waits until the next time-out instead of polling every 100ms
  *     AHW 2023-01-11: Lint warnigs and Ticket #409 In updateTCNDNSentry(), the parameter noDesc of vos_select() is uninitialized if tlc_getInterval() fails
  *     AHW 2023-01-10: Ticket #409 In updateTCNDNSentry(), the parameter noDesc of vos_select() is uninitialized if tlc_getInterval() fails
  *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
@@ -970,14 +971,24 @@ static void updateTCNDNSentry (
             TRDP_FDS_T          rfds = {0};
             TRDP_SOCK_T         noDesc = TRDP_INVALID_SOCKET;        /* #409 */
             TRDP_TIME_T         tv = { 0, 0 };                       /* #409 */
-            const TRDP_TIME_T   max_tv  = { 0, 100000 };
+            TRDP_TIME_T         max_tv  = replyTimeOut;
             INT32               rv = 0;                              /* #409 */
             TRDP_TIME_T         timeNow = {0, 0};                    /* #409 */
 
             VOS_FD_ZERO(&rfds);
 
+            /* tlc_getInterval() includes the MD time-outs, do not wait beyond our own one */
             (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
 
+            vos_getTime(&timeNow);
+            if (vos_cmpTime(&max_tv, &timeNow) > 0)
+            {
+                vos_subTime(&max_tv, &timeNow);
+            }
+            else
+            {
+                vos_clearTime(&max_tv);
+            }
             if (vos_cmpTime(&tv, &max_tv) > 0)
             {
                 tv = max_tv;
@@ -986,10 +997,8 @@ static void updateTCNDNSentry (
             /* wait for the reply */
             rv = vos_select(noDesc, &rfds, NULL, NULL, &tv);
 
-            if (rv > 0) 
-            {
-                (void)tlc_process(appHandle, &rfds, &rv);
-            }
+            /* process time-outs, too */
+            (void)tlc_process(appHandle, (rv > 0) ? &rfds : NULL, (rv > 0) ? &rv : NULL);
 
             if (vos_semaTake(dnsSema, 0) == VOS_NO_ERR)
             {
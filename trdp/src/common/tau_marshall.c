@@ -17,6 +17,12 @@
  /*
  * $Id$
  *
+ *      AG 2026-10-18: The pRefCon == NULL fallback documented as not thread-safe
+ *      AG 2026-10-18: Warn when datasets do not fit into the plan step table
+ *      AG 2026-10-18: Sizes and alignment of fixed size datasets memoized at init, O(1) tau_calcDatasetSize()
+ *      AG 2026-10-18: Per session marshalling contexts with precomputed lookups instead of file static tables
+ *      AG 2026-10-18: Arrays converted by the byte swap kernels of tau_bswap.c
+ *      AG 2026-10-18: Datasets are compiled into flat copy/byte swap plans at init, interpreter only for variable parts
  *      SB 2021-08-09: Lint warnings
  *      BL 2020-08-12: Warning output moved (to before aligning source pointer on return from possible recursion)
  *      SB 2019-08-15: Compiler warning (pointer compared to integer)
@@ -50,6 +56,7 @@
 #include "vos_mem.h"
 
 #include "tau_marshall.h"
+#include "tau_bswap.h"
 
 /***********************************************************************************************************************
  * TYPEDEFS
@@ -82,16 +89,100 @@ typedef struct
     TIMEDATE64 a;
 } TIMEDATE64_STRUCT_T;
 
+/** Kind of a compiled marshalling step */
+typedef enum
+{
+    TAU_OP_COPY     = 0,        /**< plain copy, count in bytes             */
+    TAU_OP_SWAP16   = 1,        /**< byte swapping copy of 16 bit items     */
+    TAU_OP_SWAP32   = 2,        /**< byte swapping copy of 32 bit items     */
+    TAU_OP_SWAP64   = 3         /**< byte swapping copy of 64 bit items     */
+} TAU_OP_KIND_T;
+
+/** One step of a compiled marshalling plan, the offsets are relative to the start of the dataset */
+typedef struct
+{
+    UINT32  kind;               /**< TAU_OP_KIND_T                          */
+    UINT32  hostOff;            /**< offset in the host structure           */
+    UINT32  wireOff;            /**< offset in the marshalled data          */
+    UINT32  count;              /**< number of items                        */
+} TAU_MARSHALL_OP_T;
+
+/** Compiled marshalling plan of one dataset.
+    The plan covers the elements up to the first variable sized part, the interpreter carries on from there. */
+typedef struct
+{
+    UINT32                  firstOp;        /**< index of the first step in the step table of the context   */
+    UINT32                  numOps;         /**< number of steps                                            */
+    UINT32                  hostSize;       /**< host size covered, aligned to the dataset if complete      */
+    UINT32                  wireSize;       /**< wire size covered                                          */
+    UINT16                  resumeIdx;      /**< first element left to the interpreter                      */
+    UINT8                   align;          /**< alignment the host buffer must have                        */
+    UINT8                   varItemSize;    /**< item size of the last possible size element, 0 if none     */
+    UINT32                  varHostFirst;   /**< host offset of its first item                              */
+    UINT32                  varHostLast;    /**< host offset of its last item                               */
+    UINT32                  varWireFirst;   /**< wire offset of its first item                              */
+} TAU_MARSHALL_PLAN_T;
+
+/** Dataset as resolved by tau_initMarshall(), never changed afterwards */
+typedef struct TAU_DS_INFO
+{
+    TRDP_DATASET_T              *pDataset;  /**< the dataset                                                */
+    const struct TAU_DS_INFO    * *ppNested; /**< nested datasets, indexed like pElement, NULL if none      */
+    UINT32                      align;      /**< alignment of the largest member                            */
+    BOOL8                       fixedSize;  /**< no variable sized element, also not in nested datasets     */
+    UINT32                      hostSize;   /**< host size incl. trailing padding, valid if fixedSize       */
+    UINT32                      wireSize;   /**< marshalled size, valid if fixedSize                        */
+    TAU_MARSHALL_PLAN_T         plan;       /**< compiled plan, used if plan.resumeIdx > 0                  */
+} TAU_DS_INFO_T;
+
+/** ComId to dataset relation, resolved */
+typedef struct
+{
+    UINT32              comId;      /**< ComId                                  */
+    const TAU_DS_INFO_T *pDs;       /**< its dataset                            */
+} TAU_COMID_INFO_T;
+
+/** Marshalling context, handed out as pRefCon by tau_initMarshall().
+    Apart from usePlans all members are immutable after initialisation, so any number of threads may marshall
+    with the same or different contexts without locking. */
+typedef struct tau_marshall_ctx
+{
+    struct tau_marshall_ctx *pNext; /**< next context created, see sCtxList  */
+    UINT32              numDs;      /**< number of datasets                     */
+    TAU_DS_INFO_T       *pDs;       /**< datasets sorted by ID                  */
+    UINT32              numComId;   /**< number of resolved ComIds              */
+    TAU_COMID_INFO_T    *pComId;    /**< ComIds sorted                          */
+    UINT32              numOps;     /**< number of compiled steps               */
+    TAU_MARSHALL_OP_T   *pOps;      /**< steps of all plans                     */
+    BOOL8               usePlans;   /**< use the compiled plans                 */
+} TAU_MARSHALL_CTX_T;
+
+/** Plan compiler state */
+typedef struct
+{
+    TAU_MARSHALL_PLAN_T *pPlan;     /**< plan under construction                */
+    TAU_MARSHALL_OP_T   *pOps;      /**< step table, NULL to compute the layout only */
+    UINT32              hostOff;    /**< current host offset                    */
+    UINT32              wireOff;    /**< current wire offset                    */
+    BOOL8               full;       /**< step table ran out of room             */
+} TAU_PLAN_CTX_T;
+
 
 /***********************************************************************************************************************
  * LOCALS
  */
 
-static TRDP_COMID_DSID_MAP_T    *sComIdDsIdMap = NULL;
-static UINT32                   sNumComId = 0u;
+/* Context used if pRefCon is NULL, the one initialised last. Only for applications not passing pRefCon.
+   Written by tau_initMarshall()/tau_deInitMarshall() without locking: not thread-safe, see tau_marshall.h */
+static TAU_MARSHALL_CTX_T       *sDefaultCtx = NULL;
+
+/* Context created for a tau_initMarshall() call without ppRefCon */
+static TAU_MARSHALL_CTX_T       *sOwnedCtx = NULL;
+
+/* All contexts created and not yet released, to tell them from other pointers a caller hands in */
+static TAU_MARSHALL_CTX_T       *sCtxList = NULL;
 
-static TRDP_DATASET_T           * *sDataSets = NULL;
-static UINT32                   sNumEntries = 0u;
+static const UINT32             cOpItemSize[] = {1u, 2u, 4u, 8u};   /* indexed by TAU_OP_KIND_T */
 
 /***********************************************************************************************************************
  * LOCAL FUNCTIONS
@@ -134,35 +225,13 @@ static INLINE void unpackedCopy64 (
     const UINT8 * *ppSrc,
     UINT8   * *ppDst,
     UINT32  noOfItems)
-
-#ifdef B_ENDIAN
-{
-    UINT32  size    = noOfItems * sizeof(UINT64);
-    UINT8   *pDst8  = alignPtr(*ppDst, ALIGNOF(UINT64));
-    memcpy(pDst8, *ppSrc, size);
-    *ppSrc  = *ppSrc + size;
-    *ppDst  =  pDst8 + size;
-}
-#else
 {
-    UINT8       *pDst8  = alignPtr(*ppDst, ALIGNOF(UINT64));
-    const UINT8 *pSrc8  = *ppSrc;
-    while (noOfItems--)
-    {
-        *pDst8++    = *(pSrc8 + 7u);
-        *pDst8++    = *(pSrc8 + 6u);
-        *pDst8++    = *(pSrc8 + 5u);
-        *pDst8++    = *(pSrc8 + 4u);
-        *pDst8++    = *(pSrc8 + 3u);
-        *pDst8++    = *(pSrc8 + 2u);
-        *pDst8++    = *(pSrc8 + 1u);
-        *pDst8++    = *pSrc8;
-        pSrc8       += 8u;
-    }
-    *ppSrc  = pSrc8;
-    *ppDst  = pDst8;
+    UINT8 *pDst8 = alignPtr(*ppDst, ALIGNOF(UINT64));
+
+    tau_netCopy64(pDst8, *ppSrc, noOfItems);
+    *ppSrc  = *ppSrc + noOfItems * sizeof(UINT64);
+    *ppDst  = pDst8 + noOfItems * sizeof(UINT64);
 }
-#endif
 
 /**********************************************************************************************************************/
 /**    Copy a variable from its natural address.
@@ -180,20 +249,11 @@ static INLINE void packedCopy64 (
     UINT8   * *ppDst,
     UINT32  noOfItems)
 {
-    const UINT64 *pSrc64 = (const UINT64 *) alignConstPtr(*ppSrc, ALIGNOF(UINT64));
-    while (noOfItems--)
-    {
-        *(*ppDst)++ = (UINT8) (*pSrc64 >> 56u);
-        *(*ppDst)++ = (UINT8) (*pSrc64 >> 48u);
-        *(*ppDst)++ = (UINT8) (*pSrc64 >> 40u);
-        *(*ppDst)++ = (UINT8) (*pSrc64 >> 32u);
-        *(*ppDst)++ = (UINT8) (*pSrc64 >> 24u);
-        *(*ppDst)++ = (UINT8) (*pSrc64 >> 16u);
-        *(*ppDst)++ = (UINT8) (*pSrc64 >> 8u);
-        *(*ppDst)++ = (UINT8) (*pSrc64 & 0xFFu);
-        pSrc64++;
-    }
-    *ppSrc = (const UINT8 *) pSrc64;
+    const UINT8 *pSrc8 = alignConstPtr(*ppSrc, ALIGNOF(UINT64));
+
+    tau_netCopy64(*ppDst, pSrc8, noOfItems);
+    *ppSrc  = pSrc8 + noOfItems * sizeof(UINT64);
+    *ppDst  = *ppDst + noOfItems * sizeof(UINT64);
 }
 
 /**********************************************************************************************************************/
@@ -228,27 +288,27 @@ static int compareDataset (
 }
 
 /**********************************************************************************************************************/
-/**    Dataset compare function
+/**    Dataset info compare function
  *
- *  @param[in]      pArg1        Pointer to key
+ *  @param[in]      pArg1        Pointer to key (dataset ID)
  *  @param[in]      pArg2        Pointer to array element
  *
  *  @retval         -1 if arg1 < arg2
  *  @retval          0 if arg1 == arg2
  *  @retval          1 if arg1 > arg2
  */
-static int compareDatasetDeref (
+static int compareDsInfo (
     const void  *pArg1,
     const void  *pArg2)
 {
-    const TRDP_DATASET_T  *p1 = (const TRDP_DATASET_T *)pArg1;
-    const TRDP_DATASET_T  *p2 = *(TRDP_DATASET_T * const *)pArg2;
+    UINT32  id1 = *(const UINT32 *)pArg1;
+    UINT32  id2 = ((const TAU_DS_INFO_T *)pArg2)->pDataset->id;
 
-    if (p1->id < p2->id)
+    if (id1 < id2)
     {
         return -1;
     }
-    else if (p1->id > p2->id)
+    else if (id1 > id2)
     {
         return 1;
     }
@@ -286,100 +346,142 @@ static int compareComId (
     }
 }
 
+/**********************************************************************************************************************/
+/**    Resolved ComId compare function
+ *
+ *  @param[in]      pArg1        Pointer to key (ComId)
+ *  @param[in]      pArg2        Pointer to array element
+ *
+ *  @retval         -1 if arg1 < arg2
+ *  @retval          0 if arg1 == arg2
+ *  @retval          1 if arg1 > arg2
+ */
+static int compareComIdInfo (
+    const void  *pArg1,
+    const void  *pArg2)
+{
+    UINT32  comId1  = *(const UINT32 *)pArg1;
+    UINT32  comId2  = ((const TAU_COMID_INFO_T *)pArg2)->comId;
+
+    if (comId1 < comId2)
+    {
+        return -1;
+    }
+    else if (comId1 > comId2)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Return the context to use
+ *
+ *  @param[in]      pRefCon     Context handed out by tau_initMarshall() or NULL
+ *
+ *  @retval         NULL if marshalling is not initialised
+ *  @retval         pointer to context
+ */
+static const TAU_MARSHALL_CTX_T *getCtx (
+    void *pRefCon)
+{
+    return (pRefCon != NULL) ? (const TAU_MARSHALL_CTX_T *) pRefCon : sDefaultCtx;
+}
 
 /**********************************************************************************************************************/
 /**    Return the dataset for the comID
  *
  *
+ *  @param[in]      pCtx        Marshalling context
  *  @param[in]      comId       ComId to find
  *
  *  @retval         NULL if not found
- *  @retval         pointer to dataset
+ *  @retval         pointer to dataset info
  */
-static TRDP_DATASET_T *findDSFromComId (
-    UINT32 comId)
+static const TAU_DS_INFO_T *findDSFromComId (
+    const TAU_MARSHALL_CTX_T    *pCtx,
+    UINT32                      comId)
 {
-    TRDP_COMID_DSID_MAP_T   key1;
-    TRDP_DATASET_T          * *key3;
-    TRDP_COMID_DSID_MAP_T   *key2;
-
-    key1.comId      = comId;
-    key1.datasetId  = 0u;
-
-    key2 = (TRDP_COMID_DSID_MAP_T *) vos_bsearch(&key1,
-                                                 sComIdDsIdMap,
-                                                 sNumComId,
-                                                 sizeof(TRDP_COMID_DSID_MAP_T),
-                                                 compareComId);
-
-    if (key2 != NULL)
-    {
-        TRDP_DATASET_T key22 = {0u, 0u, 0u};
-
-        key22.id    = key2->datasetId;
-        key3        = (TRDP_DATASET_T * *) vos_bsearch(&key22,
-                                                       sDataSets,
-                                                       sNumEntries,
-                                                       sizeof(TRDP_DATASET_T *),
-                                                       compareDatasetDeref);
-        if (key3 != NULL)
-        {
-            return *key3;
-        }
-    }
+    const TAU_COMID_INFO_T *pEntry;
 
-    return NULL;
+    pEntry = (const TAU_COMID_INFO_T *) vos_bsearch(&comId,
+                                                    pCtx->pComId,
+                                                    pCtx->numComId,
+                                                    sizeof(TAU_COMID_INFO_T),
+                                                    compareComIdInfo);
+
+    return (pEntry != NULL) ? pEntry->pDs : NULL;
 }
 
 /**********************************************************************************************************************/
 /**    Return the dataset for the datasetID
  *
  *
+ *  @param[in]      pCtx                    Marshalling context
  *  @param[in]      datasetId               dataset ID to find
  *
  *  @retval         NULL if not found
- *  @retval         pointer to dataset
+ *  @retval         pointer to dataset info
+ */
+static const TAU_DS_INFO_T *findDs (
+    const TAU_MARSHALL_CTX_T    *pCtx,
+    UINT32                      datasetId)
+{
+    return (const TAU_DS_INFO_T *) vos_bsearch(&datasetId,
+                                               pCtx->pDs,
+                                               pCtx->numDs,
+                                               sizeof(TAU_DS_INFO_T),
+                                               compareDsInfo);
+}
+
+/**********************************************************************************************************************/
+/**    Check if a pointer is a context created by tau_initMarshall() and not yet released.
+ *    The pointer is compared only, it may be uninitialised.
+ *
+ *  @param[in]      pRefCon                 pointer to check
+ *
+ *  @retval         TRUE if it is a context
  */
-static TRDP_DATASET_T *findDs (
-    UINT32 datasetId)
+static BOOL8 isContext (
+    const void *pRefCon)
 {
-    if ((sDataSets != NULL) && (sNumEntries != 0u))
-    {
-        TRDP_DATASET_T  key2 = {0u, 0u, 0u};
-        TRDP_DATASET_T  * *key3;
-
-        key2.id = datasetId;
-        key3    = (TRDP_DATASET_T * *) vos_bsearch(&key2,
-                                                   sDataSets,
-                                                   sNumEntries,
-                                                   sizeof(TRDP_DATASET_T *),
-                                                   compareDatasetDeref);
-        if (key3 != NULL)
+    const TAU_MARSHALL_CTX_T *pCtx;
+
+    for (pCtx = sCtxList; pCtx != NULL; pCtx = pCtx->pNext)
+    {
+        if ((const void *) pCtx == pRefCon)
         {
-            return *key3;
+            return TRUE;
         }
     }
-
-    return NULL;
+    return FALSE;
 }
 
 /**********************************************************************************************************************/
 /**    Return the size of the largest member of this dataset.
+ *    Called once per dataset by tau_initMarshall(), the nested datasets must already be resolved.
  *
- *  @param[in]      pDataset        Pointer to one dataset
+ *  @param[in]      pDs             Pointer to one dataset
+ *  @param[in]      level           Recursion level, to stop on datasets containing themselves
  *
  *  @retval         1,2,4,8
  *
  */
 static UINT8 maxAlignOfDSMember (
-    TRDP_DATASET_T *pDataset)
+    const TAU_DS_INFO_T *pDs,
+    INT32               level)
 {
     UINT16  lIndex;
     UINT8   maxSize = 1;
     UINT8   elemSize = 1;
 
-    if (pDataset != NULL)
+    if ((pDs != NULL) && (level <= TAU_MAX_DS_LEVEL))
     {
+        const TRDP_DATASET_T *pDataset = pDs->pDataset;
+
         /*    Loop over all datasets in the array    */
         for (lIndex = 0u; lIndex < pDataset->numElement; ++lIndex)
         {
@@ -433,7 +535,7 @@ static UINT8 maxAlignOfDSMember (
             }
             else    /* recurse if nested dataset */
             {
-                elemSize = maxAlignOfDSMember(findDs(pDataset->pElement[lIndex].type));
+                elemSize = maxAlignOfDSMember(pDs->ppNested[lIndex], level + 1);
             }
             if (maxSize < elemSize)
             {
@@ -444,11 +546,392 @@ static UINT8 maxAlignOfDSMember (
     return maxSize;
 }
 
+/**********************************************************************************************************************/
+/**    Append a step to the plan under construction.
+ *    Steps continuing the previous one in host and wire memory are merged into it.
+ *    Without a step table just the offsets are advanced.
+ *
+ *  @param[in,out]  pCtx            Pointer to compiler state
+ *  @param[in]      kind            TAU_OP_KIND_T
+ *  @param[in]      noOfItems       Items to copy
+ *
+ *  @retval         TRUE            step added
+ *  @retval         FALSE           no more room for steps
+ */
+static BOOL8 planEmit (
+    TAU_PLAN_CTX_T  *pCtx,
+    UINT32          kind,
+    UINT32          noOfItems)
+{
+    TAU_MARSHALL_PLAN_T *pPlan  = pCtx->pPlan;
+    UINT32              size    = noOfItems * cOpItemSize[kind];
+    TAU_MARSHALL_OP_T   *pOp;
+
+#ifdef B_ENDIAN
+    /* Host and wire byte order are the same */
+    kind        = TAU_OP_COPY;
+    noOfItems   = size;
+#endif
+
+    if (NULL == pCtx->pOps)
+    {
+        pCtx->hostOff   += size;
+        pCtx->wireOff   += size;
+        return TRUE;
+    }
+
+    if (pPlan->numOps > 0u)
+    {
+        pOp = &pCtx->pOps[pPlan->firstOp + pPlan->numOps - 1u];
+        if ((pOp->kind == kind) &&
+            ((pOp->hostOff + pOp->count * cOpItemSize[kind]) == pCtx->hostOff) &&
+            ((pOp->wireOff + pOp->count * cOpItemSize[kind]) == pCtx->wireOff))
+        {
+            pOp->count      += noOfItems;
+            pCtx->hostOff   += size;
+            pCtx->wireOff   += size;
+            return TRUE;
+        }
+    }
+
+    if ((pPlan->firstOp + pPlan->numOps) >= TAU_MAX_PLAN_OPS)
+    {
+        pCtx->full = TRUE;
+        return FALSE;
+    }
+
+    pOp             = &pCtx->pOps[pPlan->firstOp + pPlan->numOps];
+    pOp->kind       = kind;
+    pOp->hostOff    = pCtx->hostOff;
+    pOp->wireOff    = pCtx->wireOff;
+    pOp->count      = noOfItems;
+    pPlan->numOps++;
+    pCtx->hostOff   += size;
+    pCtx->wireOff   += size;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/**    Compile the fixed part of one dataset.
+ *    Follows the pointer arithmetic of marshallDs()/unmarshallDs() exactly, nested datasets and arrays of them
+ *    are flattened. Compilation stops at the first variable sized element.
+ *
+ *  @param[in,out]  pCtx            Pointer to compiler state
+ *  @param[in]      pDs             Pointer to one dataset
+ *  @param[in]      level           Recursion level of the dataset, 1 for the top level
+ *
+ *  @retval         number of elements compiled, numElement if the dataset has a fixed size
+ */
+static UINT16 planCompileDs (
+    TAU_PLAN_CTX_T      *pCtx,
+    const TAU_DS_INFO_T *pDs,
+    INT32               level)
+{
+    const TRDP_DATASET_T    *pDataset   = pDs->pDataset;
+    TAU_MARSHALL_PLAN_T     *pPlan      = pCtx->pPlan;
+    UINT32                  maxAlign    = pDs->align;
+    BOOL8               alignStart  = TRUE;
+    UINT16              lIndex;
+
+    for (lIndex = 0u; lIndex < pDataset->numElement; ++lIndex)
+    {
+        UINT32  type        = pDataset->pElement[lIndex].type;
+        UINT32  noOfItems   = pDataset->pElement[lIndex].size;
+        UINT32  numOps      = pPlan->numOps;
+        UINT32  hostOff     = pCtx->hostOff;
+        UINT32  wireOff     = pCtx->wireOff;
+        BOOL8   ok          = TRUE;
+        UINT32  item;
+
+        if (TRDP_VAR_SIZE == noOfItems)
+        {
+            break;
+        }
+
+        if (type > (UINT32) TRDP_TYPE_MAX)
+        {
+            const TAU_DS_INFO_T *pNested = pDs->ppNested[lIndex];
+
+            if ((NULL == pNested) || (level >= TAU_MAX_DS_LEVEL))
+            {
+                break;
+            }
+            for (item = 0u; (item < noOfItems) && ok; item++)
+            {
+                ok = (planCompileDs(pCtx, pNested, level + 1) == pNested->pDataset->numElement) ? TRUE : FALSE;
+            }
+            /* The interpreter does not align the start of a dataset beginning with a nested one */
+            alignStart = FALSE;
+        }
+        else
+        {
+            UINT32 varItemSize = 0u;
+
+            if (alignStart == TRUE)
+            {
+                pCtx->hostOff   = (pCtx->hostOff + maxAlign - 1u) & ~(maxAlign - 1u);
+                alignStart      = FALSE;
+            }
+
+            switch (type)
+            {
+               case TRDP_BOOL8:
+               case TRDP_CHAR8:
+               case TRDP_INT8:
+               case TRDP_UINT8:
+                   varItemSize  = 1u;
+                   break;
+               case TRDP_UTF16:
+               case TRDP_INT16:
+               case TRDP_UINT16:
+                   varItemSize  = 2u;
+                   break;
+               case TRDP_INT32:
+               case TRDP_UINT32:
+               case TRDP_REAL32:
+               case TRDP_TIMEDATE32:
+                   varItemSize  = 4u;
+                   break;
+               case TRDP_TIMEDATE64:
+                   pCtx->hostOff    = (pCtx->hostOff + ALIGNOF(TIMEDATE64_STRUCT_T) - 1u) &
+                                        ~(ALIGNOF(TIMEDATE64_STRUCT_T) - 1u);
+                   ok = planEmit(pCtx, TAU_OP_SWAP32, noOfItems * 2u);
+                   break;
+               case TRDP_TIMEDATE48:
+                   for (item = 0u; (item < noOfItems) && ok; item++)
+                   {
+                       pCtx->hostOff    = (pCtx->hostOff + ALIGNOF(TIMEDATE48_STRUCT_T) - 1u) &
+                                            ~(ALIGNOF(TIMEDATE48_STRUCT_T) - 1u);
+                       ok = planEmit(pCtx, TAU_OP_SWAP32, 1u);
+                       pCtx->hostOff    = (pCtx->hostOff + ALIGNOF(UINT16) - 1u) & ~(ALIGNOF(UINT16) - 1u);
+                       ok = ok && planEmit(pCtx, TAU_OP_SWAP16, 1u);
+                       pCtx->hostOff    = (pCtx->hostOff + ALIGNOF(TIMEDATE48_STRUCT_T) - 1u) &
+                                            ~(ALIGNOF(TIMEDATE48_STRUCT_T) - 1u);
+                   }
+                   break;
+               case TRDP_INT64:
+               case TRDP_UINT64:
+               case TRDP_REAL64:
+                   pCtx->hostOff    = (pCtx->hostOff + ALIGNOF(UINT64) - 1u) & ~(ALIGNOF(UINT64) - 1u);
+                   ok = planEmit(pCtx, TAU_OP_SWAP64, noOfItems);
+                   break;
+               default:
+                   break;
+            }
+
+            /* The integer types may hold the size of a following variable element */
+            if (varItemSize != 0u)
+            {
+                pCtx->hostOff = (pCtx->hostOff + varItemSize - 1u) & ~(varItemSize - 1u);
+                if (level == 1)
+                {
+                    pPlan->varItemSize  = (UINT8) varItemSize;
+                    pPlan->varHostFirst = pCtx->hostOff;
+                    pPlan->varHostLast  = pCtx->hostOff + (noOfItems - 1u) * varItemSize;
+                    pPlan->varWireFirst = pCtx->wireOff;
+                }
+                ok = planEmit(pCtx,
+                              (varItemSize == 1u) ? TAU_OP_COPY : ((varItemSize == 2u) ? TAU_OP_SWAP16 : TAU_OP_SWAP32),
+                              noOfItems);
+            }
+        }
+
+        if (ok == FALSE)
+        {
+            /* Out of steps: roll back this element, the interpreter will handle it */
+            pPlan->numOps   = numOps;
+            pCtx->hostOff   = hostOff;
+            pCtx->wireOff   = wireOff;
+            break;
+        }
+    }
+
+    if (lIndex == pDataset->numElement)
+    {
+        pCtx->hostOff = (pCtx->hostOff + maxAlign - 1u) & ~(maxAlign - 1u);
+    }
+    return lIndex;
+}
+
+/**********************************************************************************************************************/
+/**    Compile the plan for one dataset.
+ *    The steps are appended to the step table of the compiler state.
+ *
+ *  @param[in,out]  pCtx            Pointer to compiler state
+ *  @param[in,out]  pDs             Pointer to one dataset, receives the plan
+ *  @param[in]      usedOps         Number of steps already used in the table
+ *
+ *  @retval         number of steps used in the table afterwards
+ */
+static UINT32 planCompile (
+    TAU_PLAN_CTX_T  *pCtx,
+    TAU_DS_INFO_T   *pDs,
+    UINT32          usedOps)
+{
+    TAU_MARSHALL_PLAN_T *pPlan = &pDs->plan;
+
+    memset(pPlan, 0, sizeof(TAU_MARSHALL_PLAN_T));
+    pPlan->firstOp  = usedOps;
+    pPlan->align    = (UINT8) pDs->align;
+
+    pCtx->pPlan     = pPlan;
+    pCtx->hostOff   = 0u;
+    pCtx->wireOff   = 0u;
+
+    pPlan->resumeIdx = planCompileDs(pCtx, pDs, 1);
+
+    /* Nothing to gain if the very first element needs the interpreter */
+    if (pPlan->resumeIdx > 0u)
+    {
+        pPlan->hostSize = pCtx->hostOff;
+        pPlan->wireSize = pCtx->wireOff;
+        usedOps         += pPlan->numOps;
+    }
+    else
+    {
+        pPlan->numOps = 0u;
+    }
+    return usedOps;
+}
+
+/**********************************************************************************************************************/
+/**    Determine whether a dataset has a fixed size and memoize its sizes.
+ *    Uses the layout rules of the plan compiler without emitting steps, so the result does not depend on
+ *    the step table having room for the plan.
+ *
+ *  @param[in,out]  pDs             Pointer to one dataset, receives fixedSize, hostSize and wireSize
+ *
+ */
+static void layoutDs (
+    TAU_DS_INFO_T *pDs)
+{
+    TAU_MARSHALL_PLAN_T scratch;
+    TAU_PLAN_CTX_T      layoutCtx;
+
+    memset(&scratch, 0, sizeof(scratch));
+    layoutCtx.pPlan     = &scratch;
+    layoutCtx.pOps      = NULL;
+    layoutCtx.hostOff   = 0u;
+    layoutCtx.wireOff   = 0u;
+    layoutCtx.full      = FALSE;
+
+    pDs->fixedSize  = (planCompileDs(&layoutCtx, pDs, 1) == pDs->pDataset->numElement) ? TRUE : FALSE;
+    pDs->hostSize   = (pDs->fixedSize == TRUE) ? layoutCtx.hostOff : 0u;
+    pDs->wireSize   = (pDs->fixedSize == TRUE) ? layoutCtx.wireOff : 0u;
+}
+
+/**********************************************************************************************************************/
+/**    Return the compiled plan of a dataset
+ *
+ *  @param[in]      pCtx            Marshalling context
+ *  @param[in]      pDs             Pointer to one dataset
+ *
+ *  @retval         NULL if there is none
+ *  @retval         pointer to plan
+ */
+static const TAU_MARSHALL_PLAN_T *findPlan (
+    const TAU_MARSHALL_CTX_T    *pCtx,
+    const TAU_DS_INFO_T         *pDs)
+{
+    if ((pCtx->usePlans == FALSE) || (pDs->plan.resumeIdx == 0u))
+    {
+        return NULL;
+    }
+    return &pDs->plan;
+}
+
+/**********************************************************************************************************************/
+/**    Execute a compiled plan.
+ *
+ *  @param[in]      pCtx            Marshalling context
+ *  @param[in]      pPlan           Pointer to the plan
+ *  @param[in]      pSrc            Pointer to the source, host structure if marshalling
+ *  @param[out]     pDst            Pointer to the destination, host structure if unmarshalling
+ *  @param[in]      toWire          TRUE if marshalling
+ *
+ *  @retval         none
+ */
+static void planRun (
+    const TAU_MARSHALL_CTX_T    *pCtx,
+    const TAU_MARSHALL_PLAN_T   *pPlan,
+    const UINT8                 *pSrc,
+    UINT8                       *pDst,
+    BOOL8                       toWire)
+{
+    const TAU_MARSHALL_OP_T *pOp    = &pCtx->pOps[pPlan->firstOp];
+    const TAU_MARSHALL_OP_T *pEnd   = pOp + pPlan->numOps;
+
+    for (; pOp < pEnd; pOp++)
+    {
+        const UINT8 *pFrom  = pSrc + ((toWire == TRUE) ? pOp->hostOff : pOp->wireOff);
+        UINT8       *pTo    = pDst + ((toWire == TRUE) ? pOp->wireOff : pOp->hostOff);
+
+        switch (pOp->kind)
+        {
+           case TAU_OP_SWAP16:
+               tau_netCopy16(pTo, pFrom, pOp->count);
+               break;
+           case TAU_OP_SWAP32:
+               tau_netCopy32(pTo, pFrom, pOp->count);
+               break;
+           case TAU_OP_SWAP64:
+               tau_netCopy64(pTo, pFrom, pOp->count);
+               break;
+           default:
+               memcpy(pTo, pFrom, pOp->count);
+               break;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Read the value of the last possible size element in host order.
+ *
+ *  @param[in]      p               Pointer to the item
+ *  @param[in]      size            Item size 1, 2 or 4
+ *  @param[in]      fromWire        TRUE if the item is in network byte order
+ *
+ *  @retval         value
+ */
+static UINT32 planVarSize (
+    const UINT8 *p,
+    UINT32      size,
+    BOOL8       fromWire)
+{
+    if (fromWire == TRUE)
+    {
+        switch (size)
+        {
+           case 1u:
+               return p[0];
+           case 2u:
+               return ((UINT32) p[0] << 8u) | p[1];
+           case 4u:
+               return ((UINT32) p[0] << 24u) | ((UINT32) p[1] << 16u) | ((UINT32) p[2] << 8u) | p[3];
+           default:
+               return 0u;
+        }
+    }
+    switch (size)
+    {
+       case 1u:
+           return *p;
+       case 2u:
+           return *(const UINT16 *) p;
+       case 4u:
+           return *(const UINT32 *) p;
+       default:
+           return 0u;
+    }
+}
+
 /**********************************************************************************************************************/
 /**    Marshall one dataset.
  *
  *  @param[in,out]  pInfo           Pointer with src & dest info
- *  @param[in]      pDataset        Pointer to one dataset
+ *  @param[in]      pDs             Pointer to one dataset
+ *  @param[in]      firstElement    Element to start with, > 0 if resuming after a compiled plan
+ *  @param[in]      var_size        Size for a leading variable sized element
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_MEM_ERR    provided buffer to small
@@ -459,13 +942,15 @@ static UINT8 maxAlignOfDSMember (
 
 static TRDP_ERR_T marshallDs (
     TAU_MARSHALL_INFO_T *pInfo,
-    TRDP_DATASET_T      *pDataset)
+    const TAU_DS_INFO_T *pDs,
+    UINT16              firstElement,
+    UINT32              var_size)
 {
-    TRDP_ERR_T  err;
-    UINT16      lIndex;
-    UINT32      var_size = 0u;
-    const UINT8 *pSrc;
-    UINT8       *pDst = pInfo->pDst;
+    const TRDP_DATASET_T    *pDataset = pDs->pDataset;
+    TRDP_ERR_T              err;
+    UINT16                  lIndex;
+    const UINT8             *pSrc;
+    UINT8                   *pDst = pInfo->pDst;
 
     /* Restrict recursion */
     pInfo->level++;
@@ -480,10 +965,10 @@ static TRDP_ERR_T marshallDs (
             "A struct is always aligned to the largest types alignment requirements"
         Only, at this point we do need to know the size of the largest member to follow! */
 
-    pSrc = alignConstPtr(pInfo->pSrc, maxAlignOfDSMember(pDataset));
+    pSrc = (firstElement == 0u) ? alignConstPtr(pInfo->pSrc, pDs->align) : pInfo->pSrc;
 
     /*    Loop over all datasets in the array    */
-    for (lIndex = 0u; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
+    for (lIndex = firstElement; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
     {
         UINT32 noOfItems = pDataset->pElement[lIndex].size;
 
@@ -499,20 +984,13 @@ static TRDP_ERR_T marshallDs (
             {
                 /* Dataset, call ourself recursively */
 
-                /* Never used before?  */
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)
-                {
-                    /* Look for it   */
-                    pDataset->pElement[lIndex].pCachedDS = findDs(pDataset->pElement[lIndex].type);
-                }
-
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)      /* Not in our DB    */
+                if (NULL == pDs->ppNested[lIndex])      /* Not in our DB    */
                 {
                     vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", pDataset->pElement[lIndex].type);
                     return TRDP_COMID_ERR;
                 }
 
-                err = marshallDs(pInfo, pDataset->pElement[lIndex].pCachedDS);
+                err = marshallDs(pInfo, pDs->ppNested[lIndex], 0u, 0u);
                 if (err != TRDP_NO_ERR)
                 {
                     return err;
@@ -558,13 +1036,9 @@ static TRDP_ERR_T marshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
-                   while (noOfItems-- > 0u)
-                   {
-                       *pDst++  = (UINT8) (*pSrc16 >> 8u);
-                       *pDst++  = (UINT8) (*pSrc16 & 0xFFu);
-                       pSrc16++;
-                   }
-                   pSrc = (const UINT8 *) pSrc16;
+                   tau_netCopy16(pDst, (const UINT8 *) pSrc16, noOfItems);
+                   pDst += noOfItems * 2u;
+                   pSrc = (const UINT8 *) (pSrc16 + noOfItems);
                    break;
                }
                case TRDP_INT32:
@@ -582,15 +1056,9 @@ static TRDP_ERR_T marshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
-                   while (noOfItems-- > 0u)
-                   {
-                       *pDst++  = (UINT8) (*pSrc32 >> 24u);
-                       *pDst++  = (UINT8) (*pSrc32 >> 16u);
-                       *pDst++  = (UINT8) (*pSrc32 >> 8u);
-                       *pDst++  = (UINT8) (*pSrc32 & 0xFFu);
-                       pSrc32++;
-                   }
-                   pSrc = (const UINT8 *) pSrc32;
+                   tau_netCopy32(pDst, (const UINT8 *) pSrc32, noOfItems);
+                   pDst += noOfItems * 4u;
+                   pSrc = (const UINT8 *) (pSrc32 + noOfItems);
                    break;
                }
                case TRDP_TIMEDATE64:
@@ -602,20 +1070,10 @@ static TRDP_ERR_T marshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
-                   while (noOfItems-- > 0u)
-                   {
-                       *pDst++  = (UINT8) (*pSrc32 >> 24u);
-                       *pDst++  = (UINT8) (*pSrc32 >> 16u);
-                       *pDst++  = (UINT8) (*pSrc32 >> 8u);
-                       *pDst++  = (UINT8) (*pSrc32 & 0xFFu);
-                       pSrc32++;
-                       *pDst++  = (UINT8) (*pSrc32 >> 24u);
-                       *pDst++  = (UINT8) (*pSrc32 >> 16u);
-                       *pDst++  = (UINT8) (*pSrc32 >> 8u);
-                       *pDst++  = (UINT8) (*pSrc32 & 0xFFu);
-                       pSrc32++;
-                   }
-                   pSrc = (const UINT8 *) pSrc32;
+                   /* seconds and microseconds are two consecutive 32 bit values */
+                   tau_netCopy32(pDst, (const UINT8 *) pSrc32, noOfItems * 2u);
+                   pDst += noOfItems * 8u;
+                   pSrc = (const UINT8 *) (pSrc32 + noOfItems * 2u);
                    break;
                }
                case TRDP_TIMEDATE48:
@@ -666,7 +1124,7 @@ static TRDP_ERR_T marshallDs (
         }
     }
 
-    pInfo->pSrc = alignConstPtr(pInfo->pSrc, maxAlignOfDSMember(pDataset));
+    pInfo->pSrc = alignConstPtr(pInfo->pSrc, pDs->align);
 
     if (pInfo->pSrc > pInfo->pSrcEnd ) /* Maybe one alignement bejond - do not erratically issue error! */
     {
@@ -683,7 +1141,9 @@ static TRDP_ERR_T marshallDs (
 /**    Unmarshall one dataset.
  *
  *  @param[in,out]  pInfo           Pointer with src & dest info
- *  @param[in]      pDataset        Pointer to one dataset
+ *  @param[in]      pDs             Pointer to one dataset
+ *  @param[in]      firstElement    Element to start with, > 0 if resuming after a compiled plan
+ *  @param[in]      var_size        Size for a leading variable sized element
  *
  *  @retval         TRDP_NO_ERR             no error
  *  @retval         TRDP_MEM_ERR            provided buffer to small
@@ -695,13 +1155,15 @@ static TRDP_ERR_T marshallDs (
 
 static TRDP_ERR_T unmarshallDs (
     TAU_MARSHALL_INFO_T *pInfo,
-    TRDP_DATASET_T      *pDataset)
+    const TAU_DS_INFO_T *pDs,
+    UINT16              firstElement,
+    UINT32              var_size)
 {
-    TRDP_ERR_T  err;
-    UINT16      lIndex;
-    UINT32      var_size    = 0u;
-    const UINT8 *pSrc       = pInfo->pSrc;
-    UINT8       *pDst       = pInfo->pDst;
+    const TRDP_DATASET_T    *pDataset   = pDs->pDataset;
+    TRDP_ERR_T              err;
+    UINT16                  lIndex;
+    const UINT8             *pSrc       = pInfo->pSrc;
+    UINT8                   *pDst       = pInfo->pDst;
 
     /* Restrict recursion */
     pInfo->level++;
@@ -710,10 +1172,10 @@ static TRDP_ERR_T unmarshallDs (
         return TRDP_STATE_ERR;
     }
 
-    pDst = alignPtr(pInfo->pDst, maxAlignOfDSMember(pDataset));
+    pDst = (firstElement == 0u) ? alignPtr(pInfo->pDst, pDs->align) : pInfo->pDst;
 
     /*    Loop over all datasets in the array    */
-    for (lIndex = 0u; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
+    for (lIndex = firstElement; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
     {
         UINT32 noOfItems = pDataset->pElement[lIndex].size;
 
@@ -727,20 +1189,13 @@ static TRDP_ERR_T unmarshallDs (
             while (noOfItems-- > 0u)
             {
                 /* Dataset, call ourself recursively */
-                /* Never used before?  */
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)
-                {
-                    /* Look for it   */
-                    pDataset->pElement[lIndex].pCachedDS = findDs(pDataset->pElement[lIndex].type);
-                }
-
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)      /* Not in our DB    */
+                if (NULL == pDs->ppNested[lIndex])      /* Not in our DB    */
                 {
                     vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", pDataset->pElement[lIndex].type);
                     return TRDP_COMID_ERR;
                 }
 
-                err = unmarshallDs(pInfo, pDataset->pElement[lIndex].pCachedDS);
+                err = unmarshallDs(pInfo, pDs->ppNested[lIndex], 0u, 0u);
                 if (err != TRDP_NO_ERR)
                 {
                     return err;
@@ -781,13 +1236,13 @@ static TRDP_ERR_T unmarshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
-                   while (noOfItems-- > 0u)
+                   if (noOfItems > 0u)
                    {
-                       *pDst16  = (UINT16) (*pSrc++ << 8u);
-                       *pDst16  += *pSrc++;
+                       tau_netCopy16((UINT8 *) pDst16, pSrc, noOfItems);
+                       pSrc    += noOfItems * 2u;
+                       pDst16  += noOfItems;
                        /*    possible variable source size    */
-                       var_size = *pDst16;
-                       pDst16++;
+                       var_size = *(pDst16 - 1);
                    }
                    pDst = (UINT8 *) pDst16;
                    break;
@@ -804,14 +1259,13 @@ static TRDP_ERR_T unmarshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
-                   while (noOfItems-- > 0)
+                   if (noOfItems > 0u)
                    {
-                       *pDst32  = ((UINT32)(*pSrc++)) << 24u;
-                       *pDst32  += ((UINT32)(*pSrc++)) << 16u;
-                       *pDst32  += ((UINT32)(*pSrc++)) << 8u;
-                       *pDst32  += *pSrc++;
-                       var_size = *pDst32;
-                       pDst32++;
+                       tau_netCopy32((UINT8 *) pDst32, pSrc, noOfItems);
+                       pSrc    += noOfItems * 4u;
+                       pDst32  += noOfItems;
+                       /*    possible variable source size    */
+                       var_size = *(pDst32 - 1);
                    }
                    pDst = (UINT8 *) pDst32;
                    break;
@@ -853,21 +1307,13 @@ static TRDP_ERR_T unmarshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
-                   while (noOfItems-- > 0u)
+                   /* seconds and microseconds are two consecutive 32 bit values */
+                   if (noOfItems > 0u)
                    {
                        pDst32   = (UINT32 *) alignPtr(pDst, ALIGNOF(TIMEDATE64_STRUCT_T));
-                       *pDst32  = ((UINT32)(*pSrc++)) << 24u;
-                       *pDst32  += ((UINT32)(*pSrc++)) << 16u;
-                       *pDst32  += ((UINT32)(*pSrc++)) << 8u;
-                       *pDst32  += *pSrc++;
-                       pDst32++;
-                       pDst32   = (UINT32 *) alignPtr((UINT8 *)pDst32, ALIGNOF(UINT32));
-                       *pDst32  = ((UINT32)(*pSrc++)) << 24u;
-                       *pDst32  += ((UINT32)(*pSrc++)) << 16u;
-                       *pDst32  += ((UINT32)(*pSrc++)) << 8u;
-                       *pDst32  += *pSrc++;
-                       pDst32++;
-                       pDst = (UINT8 *) pDst32;
+                       tau_netCopy32((UINT8 *) pDst32, pSrc, noOfItems * 2u);
+                       pSrc     += noOfItems * 8u;
+                       pDst     = (UINT8 *) (pDst32 + noOfItems * 2u);
                    }
                    break;
                }
@@ -891,7 +1337,7 @@ static TRDP_ERR_T unmarshallDs (
         }
     }
 
-    pInfo->pDst = alignPtr(pInfo->pDst, maxAlignOfDSMember(pDataset));
+    pInfo->pDst = alignPtr(pInfo->pDst, pDs->align);
 
     if (pInfo->pSrc > pInfo->pSrcEnd)
     {
@@ -908,7 +1354,9 @@ static TRDP_ERR_T unmarshallDs (
 /**    Compute unmarshalled size of one dataset.
  *
  *  @param[in,out]  pInfo           Pointer with src & dest info
- *  @param[in]      pDataset        Pointer to one dataset
+ *  @param[in]      pDs             Pointer to one dataset
+ *  @param[in]      firstElement    Element to start with, > 0 if resuming after a compiled plan
+ *  @param[in]      var_size        Size for a leading variable sized element
  *
  *  @retval         TRDP_NO_ERR             no error
  *  @retval         TRDP_MEM_ERR            provided buffer to small
@@ -920,13 +1368,15 @@ static TRDP_ERR_T unmarshallDs (
 
 static TRDP_ERR_T size_unmarshall (
     TAU_MARSHALL_INFO_T *pInfo,
-    TRDP_DATASET_T      *pDataset)
+    const TAU_DS_INFO_T *pDs,
+    UINT16              firstElement,
+    UINT32              var_size)
 {
-    TRDP_ERR_T  err;
-    UINT16      lIndex;
-    UINT32      var_size    = 0u;
-    const UINT8 *pSrc       = pInfo->pSrc;
-    UINT8       *pDst;
+    const TRDP_DATASET_T    *pDataset   = pDs->pDataset;
+    TRDP_ERR_T              err;
+    UINT16                  lIndex;
+    const UINT8             *pSrc       = pInfo->pSrc;
+    UINT8                   *pDst;
 
     /* Restrict recursion */
     pInfo->level++;
@@ -935,10 +1385,10 @@ static TRDP_ERR_T size_unmarshall (
         return TRDP_STATE_ERR;
     }
 
-    pDst = alignPtr(pInfo->pDst, maxAlignOfDSMember(pDataset));
+    pDst = (firstElement == 0u) ? alignPtr(pInfo->pDst, pDs->align) : pInfo->pDst;
 
     /*    Loop over all datasets in the array    */
-    for (lIndex = 0u; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
+    for (lIndex = firstElement; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
     {
         UINT32 noOfItems = pDataset->pElement[lIndex].size;
 
@@ -953,20 +1403,13 @@ static TRDP_ERR_T size_unmarshall (
             while (noOfItems-- > 0u)
             {
                 /* Dataset, call ourself recursively */
-                /* Never used before?  */
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)
-                {
-                    /* Look for it   */
-                    pDataset->pElement[lIndex].pCachedDS = findDs(pDataset->pElement[lIndex].type);
-                }
-
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)      /* Not in our DB    */
+                if (NULL == pDs->ppNested[lIndex])      /* Not in our DB    */
                 {
                     vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", pDataset->pElement[lIndex].type);
                     return TRDP_COMID_ERR;
                 }
 
-                err = size_unmarshall(pInfo, pDataset->pElement[lIndex].pCachedDS);
+                err = size_unmarshall(pInfo, pDs->ppNested[lIndex], 0u, 0u);
                 if (err != TRDP_NO_ERR)
                 {
                     return err;
@@ -1083,7 +1526,7 @@ static TRDP_ERR_T size_unmarshall (
         }
     }
 
-    pInfo->pDst = alignPtr(pDst, maxAlignOfDSMember(pDataset));
+    pInfo->pDst = alignPtr(pDst, pDs->align);
 
     if (pInfo->pSrc > pInfo->pSrcEnd)
     {
@@ -1096,14 +1539,173 @@ static TRDP_ERR_T size_unmarshall (
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/**    Marshall one dataset, using its compiled plan if possible.
+ *    The plan is used if the host structure is aligned and both buffers cover the compiled part.
+ *
+ *  @param[in,out]  pInfo           Pointer with src & dest info
+ *  @param[in]      pCtx            Marshalling context
+ *  @param[in]      pDs             Pointer to one dataset
+ *
+ *  @retval         see marshallDs()
+ */
+static TRDP_ERR_T marshallPlanned (
+    TAU_MARSHALL_INFO_T         *pInfo,
+    const TAU_MARSHALL_CTX_T    *pCtx,
+    const TAU_DS_INFO_T         *pDs)
+{
+    const TAU_MARSHALL_PLAN_T *pPlan = findPlan(pCtx, pDs);
+
+    if ((pPlan != NULL) &&
+        ((((uintptr_t) pInfo->pSrc) & (pPlan->align - 1u)) == 0u) &&
+        ((UINT32)(pInfo->pSrcEnd - pInfo->pSrc) >= pPlan->hostSize) &&
+        ((UINT32)(pInfo->pDstEnd - pInfo->pDst) >= pPlan->wireSize))
+    {
+        UINT32 var_size = planVarSize(pInfo->pSrc + pPlan->varHostFirst, pPlan->varItemSize, FALSE);
+
+        planRun(pCtx, pPlan, pInfo->pSrc, pInfo->pDst, TRUE);
+        pInfo->pSrc += pPlan->hostSize;
+        pInfo->pDst += pPlan->wireSize;
+
+        if (pPlan->resumeIdx == pDs->pDataset->numElement)
+        {
+            return TRDP_NO_ERR;
+        }
+        return marshallDs(pInfo, pDs, pPlan->resumeIdx, var_size);
+    }
+
+    return marshallDs(pInfo, pDs, 0u, 0u);
+}
+
+/**********************************************************************************************************************/
+/**    Unmarshall one dataset, using its compiled plan if possible.
+ *    The plan is used if the host structure is aligned and both buffers cover the compiled part.
+ *
+ *  @param[in,out]  pInfo           Pointer with src & dest info
+ *  @param[in]      pCtx            Marshalling context
+ *  @param[in]      pDs             Pointer to one dataset
+ *
+ *  @retval         see unmarshallDs()
+ */
+static TRDP_ERR_T unmarshallPlanned (
+    TAU_MARSHALL_INFO_T         *pInfo,
+    const TAU_MARSHALL_CTX_T    *pCtx,
+    const TAU_DS_INFO_T         *pDs)
+{
+    const TAU_MARSHALL_PLAN_T *pPlan = findPlan(pCtx, pDs);
+
+    if ((pPlan != NULL) &&
+        ((((uintptr_t) pInfo->pDst) & (pPlan->align - 1u)) == 0u) &&
+        ((UINT32)(pInfo->pSrcEnd - pInfo->pSrc) >= pPlan->wireSize) &&
+        ((UINT32)(pInfo->pDstEnd - pInfo->pDst) >= pPlan->hostSize))
+    {
+        UINT32 var_size;
+
+        planRun(pCtx, pPlan, pInfo->pSrc, pInfo->pDst, FALSE);
+        var_size    = planVarSize(pInfo->pDst + pPlan->varHostLast, pPlan->varItemSize, FALSE);
+        pInfo->pSrc += pPlan->wireSize;
+        pInfo->pDst += pPlan->hostSize;
+
+        if (pPlan->resumeIdx == pDs->pDataset->numElement)
+        {
+            return TRDP_NO_ERR;
+        }
+        return unmarshallDs(pInfo, pDs, pPlan->resumeIdx, var_size);
+    }
+
+    return unmarshallDs(pInfo, pDs, 0u, 0u);
+}
+
+/**********************************************************************************************************************/
+/**    Compute unmarshalled size of one dataset, using its memoized size or its compiled plan if possible.
+ *    The memoized size of a fixed size dataset is returned under the conditions the walk would succeed with
+ *    the same result: aligned start and the source covering the marshalled dataset.
+ *
+ *  @param[in,out]  pInfo           Pointer with src & dest info
+ *  @param[in]      pCtx            Marshalling context
+ *  @param[in]      pDs             Pointer to one dataset
+ *
+ *  @retval         see size_unmarshall()
+ */
+static TRDP_ERR_T sizePlanned (
+    TAU_MARSHALL_INFO_T         *pInfo,
+    const TAU_MARSHALL_CTX_T    *pCtx,
+    const TAU_DS_INFO_T         *pDs)
+{
+    const TAU_MARSHALL_PLAN_T *pPlan;
+
+    if ((pDs->fixedSize == TRUE) &&
+        ((((uintptr_t) pInfo->pDst) & (pDs->align - 1u)) == 0u) &&
+        ((UINT32)(pInfo->pSrcEnd - pInfo->pSrc) >= pDs->wireSize))
+    {
+        pInfo->pSrc += pDs->wireSize;
+        pInfo->pDst += pDs->hostSize;
+        return TRDP_NO_ERR;
+    }
+
+    pPlan = findPlan(pCtx, pDs);
+    if ((pPlan != NULL) &&
+        ((((uintptr_t) pInfo->pDst) & (pPlan->align - 1u)) == 0u) &&
+        ((UINT32)(pInfo->pSrcEnd - pInfo->pSrc) >= pPlan->wireSize))
+    {
+        UINT32 var_size = planVarSize(pInfo->pSrc + pPlan->varWireFirst, pPlan->varItemSize, TRUE);
+
+        pInfo->pSrc += pPlan->wireSize;
+        pInfo->pDst += pPlan->hostSize;
+
+        if (pPlan->resumeIdx == pDs->pDataset->numElement)
+        {
+            return TRDP_NO_ERR;
+        }
+        return size_unmarshall(pInfo, pDs, pPlan->resumeIdx, var_size);
+    }
+
+    return size_unmarshall(pInfo, pDs, 0u, 0u);
+}
+
+/**********************************************************************************************************************/
+/**    Find the dataset to marshall and fill the caller's dataset cache.
+ *    The lookup always uses the tables of the context, a cached pointer may belong to an earlier configuration.
+ *
+ *  @param[in]      pCtx            Marshalling context
+ *  @param[in]      id              ComId or dataset ID
+ *  @param[in]      byComId         TRUE if id is a ComId
+ *  @param[out]     ppDSPointer     Pointer to the cached dataset of the caller, may be NULL
+ *
+ *  @retval         NULL if not found
+ *  @retval         pointer to dataset info
+ */
+static const TAU_DS_INFO_T *lookupDs (
+    const TAU_MARSHALL_CTX_T    *pCtx,
+    UINT32                      id,
+    BOOL8                       byComId,
+    TRDP_DATASET_T              * *ppDSPointer)
+{
+    const TAU_DS_INFO_T *pDs = (byComId == TRUE) ? findDSFromComId(pCtx, id) : findDs(pCtx, id);
+
+    if ((pDs != NULL) && (ppDSPointer != NULL))
+    {
+        *ppDSPointer = pDs->pDataset;
+    }
+    return pDs;
+}
+
 /**********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
 
 /**********************************************************************************************************************/
 /**    Function to initialise the marshalling/unmarshalling.
- *    The supplied array must be sorted by ComIds. The array must exist during the use of the marshalling
- *    functions (until tlc_terminate()).
+ *    Both arrays are sorted in place, the datasets must exist as long as the context is used and are not
+ *    written to. All lookups are resolved here into a context of their own, so sessions with
+ *    different configurations may marshall concurrently without locking.
+ *    The context is released by tau_deInitMarshall(). Without ppRefCon the context is kept internally
+ *    and replaces the one of an earlier call without ppRefCon. If *ppRefCon still holds a context of an earlier
+ *    call, that one is released and replaced as well: applications re-initialising into the same variable without
+ *    tau_deInitMarshall() do not leak it. Any other value of *ppRefCon is overwritten without being dereferenced.
+ *    The context initialised last is used by the
+ *    marshalling functions if they are called with pRefCon == NULL. Switching that context is not
+ *    synchronised with other threads marshalling with pRefCon == NULL.
  *
  *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
  *  @param[in]      numComId         Number of datasets found in the configuration
@@ -1112,7 +1714,7 @@ static TRDP_ERR_T size_unmarshall (
  *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
  *
  *  @retval         TRDP_NO_ERR      no error
- *  @retval         TRDP_MEM_ERR     provided buffer to small
+ *  @retval         TRDP_MEM_ERR     out of memory
  *  @retval         TRDP_PARAM_ERR   Parameter error
  *
  */
@@ -1124,40 +1726,215 @@ EXT_DECL TRDP_ERR_T tau_initMarshall (
     UINT32                  numDataSet,
     TRDP_DATASET_T          *pDataset[])
 {
-    UINT32 i, j;
-
-    (void)ppRefCon;
+    TAU_MARSHALL_CTX_T  *pCtx;
+    const TAU_DS_INFO_T * *ppNested;
+    TAU_PLAN_CTX_T      planCtx;
+    UINT32              numElements = 0u;
+    UINT32              usedOps     = 0u;
+    UINT32              numCut      = 0u;
+    UINT32              firstCut    = 0u;
+    UINT32              i, j;
 
     if ((pDataset == NULL) || (numDataSet == 0u) || (numComId == 0u) || (pComIdDsIdMap == NULL))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /*    Save the pointer to the comId mapping table    */
-    sComIdDsIdMap   = pComIdDsIdMap;
-    sNumComId       = numComId;
-
-    /* sort the table    */
+    /* sort the tables    */
     vos_qsort(pComIdDsIdMap, numComId, sizeof(TRDP_COMID_DSID_MAP_T), compareComId);
+    vos_qsort(pDataset, numDataSet, sizeof(TRDP_DATASET_T *), compareDataset);
+
+    for (i = 0u; i < numDataSet; i++)
+    {
+        numElements += pDataset[i]->numElement;
+    }
+
+    /* The context, the datasets, the ComIds and the nested datasets in one block */
+    pCtx = (TAU_MARSHALL_CTX_T *) vos_memAlloc(sizeof(TAU_MARSHALL_CTX_T) +
+                                               numDataSet * sizeof(TAU_DS_INFO_T) +
+                                               numComId * sizeof(TAU_COMID_INFO_T) +
+                                               numElements * sizeof(TAU_DS_INFO_T *));
+    if (pCtx == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pCtx->numDs     = numDataSet;
+    pCtx->pDs       = (TAU_DS_INFO_T *) (pCtx + 1);
+    pCtx->pComId    = (TAU_COMID_INFO_T *) (pCtx->pDs + numDataSet);
+    pCtx->usePlans  = TRUE;
+    ppNested        = (const TAU_DS_INFO_T * *) (pCtx->pComId + numComId);
 
-    /*    Save the pointer to the table    */
-    sDataSets   = pDataset;
-    sNumEntries = numDataSet;
+    for (i = 0u; i < numDataSet; i++)
+    {
+        pCtx->pDs[i].pDataset   = pDataset[i];
+        pCtx->pDs[i].ppNested   = ppNested;
+        ppNested += pDataset[i]->numElement;
+    }
 
-    /* invalidate the cache */
+    /* resolve the nested datasets, unknown ones stay NULL and are reported when used */
     for (i = 0u; i < numDataSet; i++)
     {
         for (j = 0u; j < pDataset[i]->numElement; j++)
         {
-            pDataset[i]->pElement[j].pCachedDS = NULL;
+            if (pDataset[i]->pElement[j].type > (UINT32) TRDP_TYPE_MAX)
+            {
+                pCtx->pDs[i].ppNested[j] = findDs(pCtx, pDataset[i]->pElement[j].type);
+            }
         }
     }
-    /* sort the table    */
-    vos_qsort(pDataset, numDataSet, sizeof(TRDP_DATASET_T *), compareDataset);
+    for (i = 0u; i < numDataSet; i++)
+    {
+        pCtx->pDs[i].align = maxAlignOfDSMember(&pCtx->pDs[i], 1);
+    }
+    for (i = 0u; i < numDataSet; i++)
+    {
+        layoutDs(&pCtx->pDs[i]);
+    }
+
+    /* resolve the ComIds, the table stays sorted */
+    for (i = 0u; i < numComId; i++)
+    {
+        const TAU_DS_INFO_T *pDs = findDs(pCtx, pComIdDsIdMap[i].datasetId);
+
+        if (pDs != NULL)
+        {
+            pCtx->pComId[pCtx->numComId].comId  = pComIdDsIdMap[i].comId;
+            pCtx->pComId[pCtx->numComId].pDs    = pDs;
+            pCtx->numComId++;
+        }
+    }
+
+    /* compile the plans into a scratch table, keep the steps used only */
+    planCtx.pOps = (TAU_MARSHALL_OP_T *) vos_memAlloc(TAU_MAX_PLAN_OPS * sizeof(TAU_MARSHALL_OP_T));
+    if (planCtx.pOps != NULL)
+    {
+        for (i = 0u; i < numDataSet; i++)
+        {
+            planCtx.full    = FALSE;
+            usedOps         = planCompile(&planCtx, &pCtx->pDs[i], usedOps);
+            if (planCtx.full == TRUE)
+            {
+                if (numCut == 0u)
+                {
+                    firstCut = pDataset[i]->id;
+                }
+                numCut++;
+            }
+        }
+        if (numCut > 0u)
+        {
+            /* Still correct, but the interpreter takes over where the plan ends */
+            vos_printLog(VOS_LOG_WARNING,
+                         "%u dataset(s) not fully compiled, first is %u: TAU_MAX_PLAN_OPS (%u) too small\n",
+                         numCut, firstCut, TAU_MAX_PLAN_OPS);
+        }
+        if (usedOps > 0u)
+        {
+            pCtx->pOps = (TAU_MARSHALL_OP_T *) vos_memAlloc(usedOps * sizeof(TAU_MARSHALL_OP_T));
+        }
+        if (pCtx->pOps != NULL)
+        {
+            memcpy(pCtx->pOps, planCtx.pOps, usedOps * sizeof(TAU_MARSHALL_OP_T));
+            pCtx->numOps = usedOps;
+        }
+        else
+        {
+            for (i = 0u; i < numDataSet; i++)
+            {
+                pCtx->pDs[i].plan.resumeIdx = 0u;
+            }
+        }
+        vos_memFree(planCtx.pOps);
+    }
+
+    pCtx->pNext = sCtxList;
+    sCtxList    = pCtx;
+
+    if (ppRefCon != NULL)
+    {
+        if (isContext(*ppRefCon) == TRUE)
+        {
+            (void) tau_deInitMarshall(*ppRefCon);
+        }
+        *ppRefCon = pCtx;
+    }
+    else
+    {
+        if (sOwnedCtx != NULL)
+        {
+            (void) tau_deInitMarshall(sOwnedCtx);
+        }
+        sOwnedCtx = pCtx;
+    }
+    sDefaultCtx = pCtx;
 
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/**    Release a marshalling context.
+ *
+ *  @param[in]      pRefCon          Context returned by tau_initMarshall(),
+ *                                   NULL for the one kept internally
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_PARAM_ERR   no such context
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_deInitMarshall (
+    void *pRefCon)
+{
+    TAU_MARSHALL_CTX_T  *pCtx = (pRefCon != NULL) ? (TAU_MARSHALL_CTX_T *) pRefCon : sOwnedCtx;
+    TAU_MARSHALL_CTX_T  * *ppIter;
+
+    /* unlink the context, an unknown or already released one is refused */
+    for (ppIter = &sCtxList; (*ppIter != NULL) && (*ppIter != pCtx); ppIter = &(*ppIter)->pNext)
+    {
+        ;
+    }
+    if ((pCtx == NULL) || (*ppIter == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *ppIter = pCtx->pNext;
+
+    if (sDefaultCtx == pCtx)
+    {
+        sDefaultCtx = NULL;
+    }
+    if (sOwnedCtx == pCtx)
+    {
+        sOwnedCtx = NULL;
+    }
+    if (pCtx->pOps != NULL)
+    {
+        vos_memFree(pCtx->pOps);
+    }
+    vos_memFree(pCtx);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Switch the use of the compiled marshalling plans on or off.
+ *
+ *  @param[in]      pRefCon          Context returned by tau_initMarshall() or NULL
+ *  @param[in]      enable           TRUE to use the compiled plans, FALSE to always interpret the datasets
+ *
+ */
+
+EXT_DECL void tau_enableMarshallPlans (
+    void    *pRefCon,
+    BOOL8   enable)
+{
+    TAU_MARSHALL_CTX_T *pCtx = (pRefCon != NULL) ? (TAU_MARSHALL_CTX_T *) pRefCon : sDefaultCtx;
+
+    if (pCtx != NULL)
+    {
+        pCtx->usePlans = enable;
+    }
+}
+
 /**********************************************************************************************************************/
 /**    marshall function.
  *
@@ -1170,10 +1947,12 @@ EXT_DECL TRDP_ERR_T tau_initMarshall (
  *  @param[in,out]  ppDSPointer     pointer to pointer to cached dataset
  *                                  set NULL if not used, set content NULL if unknown
  *
+ *  @retval         TRDP_INIT_ERR           marshalling not initialised
  *  @retval         TRDP_NO_ERR             no error
  *  @retval         TRDP_MEM_ERR            provided buffer to small
  *  @retval         TRDP_PARAM_ERR          Parameter error
  *  @retval         TRDP_STATE_ERR          Too deep recursion
+ *  @retval         TRDP_COMID_ERR          comid not existing
  *  @retval         TRDP_MARSHALLING_ERR    dataset/source size mismatch
  *
  */
@@ -1187,32 +1966,23 @@ EXT_DECL TRDP_ERR_T tau_marshall (
     UINT32          *pDestSize,
     TRDP_DATASET_T  * *ppDSPointer)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
-
-    (void)pRefCon;
+    const TAU_MARSHALL_CTX_T    *pCtx = getCtx(pRefCon);
+    const TAU_DS_INFO_T         *pDs;
+    TRDP_ERR_T                  err;
+    TAU_MARSHALL_INFO_T         info;
 
     if ((0u == comId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
+    if (NULL == pCtx)
     {
-        if (NULL == *ppDSPointer)
-        {
-            *ppDSPointer = findDSFromComId(comId);
-        }
-        pDataset = *ppDSPointer;
-    }
-    else
-    {
-        pDataset = findDSFromComId(comId);
+        return TRDP_INIT_ERR;
     }
 
-    if (NULL == pDataset)   /* Not in our DB    */
+    pDs = lookupDs(pCtx, comId, TRUE, ppDSPointer);
+    if (NULL == pDs)   /* Not in our DB    */
     {
         vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", comId);
         return TRDP_COMID_ERR;
@@ -1224,7 +1994,7 @@ EXT_DECL TRDP_ERR_T tau_marshall (
     info.pDst       = pDest;
     info.pDstEnd    = pDest + *pDestSize;
 
-    err = marshallDs(&info, pDataset);
+    err = marshallPlanned(&info, pCtx, pDs);
 
     *pDestSize = (UINT32) (info.pDst - pDest);
 
@@ -1262,32 +2032,23 @@ EXT_DECL TRDP_ERR_T tau_unmarshall (
     UINT32          *pDestSize,
     TRDP_DATASET_T  * *ppDSPointer)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
-
-    (void)pRefCon;
+    const TAU_MARSHALL_CTX_T    *pCtx = getCtx(pRefCon);
+    const TAU_DS_INFO_T         *pDs;
+    TRDP_ERR_T                  err;
+    TAU_MARSHALL_INFO_T         info;
 
     if ((0u == comId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
+    if (NULL == pCtx)
     {
-        if (NULL == *ppDSPointer)
-        {
-            *ppDSPointer = findDSFromComId(comId);
-        }
-        pDataset = *ppDSPointer;
-    }
-    else
-    {
-        pDataset = findDSFromComId(comId);
+        return TRDP_INIT_ERR;
     }
 
-    if (NULL == pDataset)   /* Not in our DB    */
+    pDs = lookupDs(pCtx, comId, TRUE, ppDSPointer);
+    if (NULL == pDs)   /* Not in our DB    */
     {
         vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", comId);
         return TRDP_COMID_ERR;
@@ -1299,7 +2060,7 @@ EXT_DECL TRDP_ERR_T tau_unmarshall (
     info.pDst       = pDest;
     info.pDstEnd    = pDest + *pDestSize;
 
-    err = unmarshallDs(&info, pDataset);
+    err = unmarshallPlanned(&info, pCtx, pDs);
 
     *pDestSize = (UINT32) (info.pDst - pDest);
 
@@ -1338,32 +2099,23 @@ EXT_DECL TRDP_ERR_T tau_marshallDs (
     UINT32          *pDestSize,
     TRDP_DATASET_T  * *ppDSPointer)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
-
-    (void)pRefCon;
+    const TAU_MARSHALL_CTX_T    *pCtx = getCtx(pRefCon);
+    const TAU_DS_INFO_T         *pDs;
+    TRDP_ERR_T                  err;
+    TAU_MARSHALL_INFO_T         info;
 
     if ((0u == dsId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
+    if (NULL == pCtx)
     {
-        if (NULL == *ppDSPointer)
-        {
-            *ppDSPointer = findDs(dsId);
-        }
-        pDataset = *ppDSPointer;
-    }
-    else
-    {
-        pDataset = findDs(dsId);
+        return TRDP_INIT_ERR;
     }
 
-    if (NULL == pDataset)   /* Not in our DB    */
+    pDs = lookupDs(pCtx, dsId, FALSE, ppDSPointer);
+    if (NULL == pDs)   /* Not in our DB    */
     {
         vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", dsId);
         return TRDP_COMID_ERR;
@@ -1375,7 +2127,7 @@ EXT_DECL TRDP_ERR_T tau_marshallDs (
     info.pDst       = pDest;
     info.pDstEnd    = pDest + *pDestSize;
 
-    err = marshallDs(&info, pDataset);
+    err = marshallPlanned(&info, pCtx, pDs);
 
     *pDestSize = (UINT32) (info.pDst - pDest);
 
@@ -1413,32 +2165,23 @@ EXT_DECL TRDP_ERR_T tau_unmarshallDs (
     UINT32          *pDestSize,
     TRDP_DATASET_T  * *ppDSPointer)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
-
-    (void)pRefCon;
+    const TAU_MARSHALL_CTX_T    *pCtx = getCtx(pRefCon);
+    const TAU_DS_INFO_T         *pDs;
+    TRDP_ERR_T                  err;
+    TAU_MARSHALL_INFO_T         info;
 
     if ((0u == dsId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
+    if (NULL == pCtx)
     {
-        if (NULL == *ppDSPointer)
-        {
-            *ppDSPointer = findDs(dsId);
-        }
-        pDataset = *ppDSPointer;
-    }
-    else
-    {
-        pDataset = findDs(dsId);
+        return TRDP_INIT_ERR;
     }
 
-    if (NULL == pDataset)   /* Not in our DB    */
+    pDs = lookupDs(pCtx, dsId, FALSE, ppDSPointer);
+    if (NULL == pDs)   /* Not in our DB    */
     {
         vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", dsId);
         return TRDP_COMID_ERR;
@@ -1450,7 +2193,7 @@ EXT_DECL TRDP_ERR_T tau_unmarshallDs (
     info.pDst       = pDest;
     info.pDstEnd    = pDest + *pDestSize;
 
-    err = unmarshallDs(&info, pDataset);
+    err = unmarshallPlanned(&info, pCtx, pDs);
 
     *pDestSize = (UINT32) (info.pDst - pDest);
 
@@ -1487,32 +2230,23 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSize (
     UINT32          *pDestSize,
     TRDP_DATASET_T  * *ppDSPointer)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
-
-    (void)pRefCon;
+    const TAU_MARSHALL_CTX_T    *pCtx = getCtx(pRefCon);
+    const TAU_DS_INFO_T         *pDs;
+    TRDP_ERR_T                  err;
+    TAU_MARSHALL_INFO_T         info;
 
     if ((0u == dsId) || (NULL == pSrc) || (NULL == pDestSize))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
-    {
-        if (NULL == *ppDSPointer)
-        {
-            *ppDSPointer = findDs(dsId);
-        }
-        pDataset = *ppDSPointer;
-    }
-    else
+    if (NULL == pCtx)
     {
-        pDataset = findDs(dsId);
+        return TRDP_INIT_ERR;
     }
 
-    if (NULL == pDataset)   /* Not in our DB    */
+    pDs = lookupDs(pCtx, dsId, FALSE, ppDSPointer);
+    if (NULL == pDs)   /* Not in our DB    */
     {
         vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", dsId);
         return TRDP_COMID_ERR;
@@ -1523,7 +2257,7 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSize (
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = pSrc;
 
-    err = size_unmarshall(&info, pDataset);
+    err = sizePlanned(&info, pCtx, pDs);
 
     *pDestSize = (UINT32) (info.pDst-pSrc);
 
@@ -1559,32 +2293,23 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSizeByComId (
     UINT32          *pDestSize,
     TRDP_DATASET_T  * *ppDSPointer)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
-
-    (void)pRefCon;
+    const TAU_MARSHALL_CTX_T    *pCtx = getCtx(pRefCon);
+    const TAU_DS_INFO_T         *pDs;
+    TRDP_ERR_T                  err;
+    TAU_MARSHALL_INFO_T         info;
 
     if ((0u == comId) || (NULL == pSrc) || (NULL == pDestSize))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
-    {
-        if (NULL == *ppDSPointer)
-        {
-            *ppDSPointer = findDSFromComId(comId);
-        }
-        pDataset = *ppDSPointer;
-    }
-    else
+    if (NULL == pCtx)
     {
-        pDataset = findDSFromComId(comId);
+        return TRDP_INIT_ERR;
     }
 
-    if (NULL == pDataset)   /* Not in our DB    */
+    pDs = lookupDs(pCtx, comId, TRUE, ppDSPointer);
+    if (NULL == pDs)   /* Not in our DB    */
     {
         vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", comId);
         return TRDP_COMID_ERR;
@@ -1595,7 +2320,7 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSizeByComId (
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = pSrc;
 
-    err = size_unmarshall(&info, pDataset);
+    err = sizePlanned(&info, pCtx, pDs);
 
     *pDestSize = (UINT32) (info.pDst-pSrc);
 
@@ -31,6 +31,7 @@
 
 #include "trdp_if_light.h"
 #include "trdp_utils.h"
+#include "tau_bswap.h"
 
 #define MIN(a,b) (((a)>(b))?(b):(a))
 #define SIZE_DRYRUN ((UINT8 *)~0)
@@ -317,6 +318,18 @@ static TRDP_ERR_T marshallDs(TAU_MARSHALL_INFO_T *pInfo, TRDP_DATASET_T *pDatase
 				}
 			}
 
+			/* arrays of unmangled types are converted as a block */
+			if ((m == w) && (w > 1) && (t < TRDP_TIMEDATE48)) {
+				switch (w) {
+				case 2: tau_netCopy16(pDst, pSrc, noOfItems); break;
+				case 4: tau_netCopy32(pDst, pSrc, noOfItems); break;
+				case 8: tau_netCopy64(pDst, pSrc, noOfItems); break;
+				}
+				pDst += noOfItems * w;
+				pSrc += noOfItems * m;
+				noOfItems = 0;
+			}
+
 			while (noOfItems-- > 0u) {
 				UINT64 ui=0; /* temporaries */
 				INT64  si=0;
@@ -483,6 +496,19 @@ static TRDP_ERR_T unmarshallDs(TAU_MARSHALL_INFO_T *pInfo, TRDP_DATASET_T *pData
 
 			UINT64 u=0;
 			if (t < TRDP_TIMEDATE48) {
+				/* arrays of unmangled types are converted as a block, the last item is left to the loop
+				 * below for the sign extension of a possible size value */
+				if ((m == w) && (w > 1) && (noOfItems > 1)) {
+					UINT32 n = noOfItems - 1;
+					if (pInfo->pDstEnd != SIZE_DRYRUN) switch (w) {
+					case 2: tau_netCopy16(pDst, pSrc, n); break;
+					case 4: tau_netCopy32(pDst, pSrc, n); break;
+					case 8: tau_netCopy64(pDst, pSrc, n); break;
+					}
+					pSrc += n * w;
+					pDst += n * m;
+					noOfItems = 1;
+				}
 				while (noOfItems-- > 0u) {
 					u = *pSrc++;
 					/* sign extend */
@@ -17,6 +17,8 @@
  /*
  * $Id$
  *
+ *      AG 2026-10-18: traffic-shaping="hyperperiod" selects the hyperperiod PD scheduler
+ *      AG 2026-10-18: Device, interface and dataset configuration served from the binary configuration cache
  *     AHW 2023-01-11: Lint warnigs
  *     AHW 2021-04-30: Ticket #349 support for parsing "dataset name" and "device type"
  *      SB 2021-02-04: Ticket #359: fixed parsing of 'service-device' elements
@@ -65,6 +67,7 @@
 #include "trdp_utils.h"
 #include "tau_xml.h"
 #include "trdp_xml.h"
+#include "tau_xmlcache.h"
 
 /*******************************************************************************
  * DEFINES
@@ -1205,6 +1208,24 @@ static TRDP_ERR_T readXmlDatasets (
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/**    Make the XML document of a handle available, a handle prepared from a cache opens it on first use.
+ *
+ *  @param[in]      pDocHnd           Handle of the XML document
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_IO_ERR       XML file could not be read
+ */
+static TRDP_ERR_T openXmlDocument (
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd)
+{
+    if (pDocHnd->pCache == NULL)
+    {
+        return TRDP_NO_ERR;
+    }
+    return trdp_xmlCacheOpenXml(pDocHnd->pCache, pDocHnd->pXmlDocument);
+}
+
 /******************************************************************************
  *   Globals
  */
@@ -1319,6 +1340,10 @@ EXT_DECL void tau_freeXmlDoc (
     vos_memFree(pDocHnd->pXmlDocument);
 
     pDocHnd->pXmlDocument = NULL;
+
+    trdp_xmlCacheClose(pDocHnd->pCache);
+
+    pDocHnd->pCache = NULL;
 }
 
 /**********************************************************************************************************************/
@@ -1364,6 +1389,22 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
         return TRDP_PARAM_ERR;
     }
 
+    /*  Served from the cache if it holds the interface */
+    if (pDocHnd->pCache != NULL)
+    {
+        result = trdp_xmlCacheInterfaceConfig(pDocHnd->pCache, pIfName, pProcessConfig, pPdConfig, pMdConfig,
+                                              pNumExchgPar, ppExchgPar);
+        if (result != TRDP_NODATA_ERR)
+        {
+            return result;
+        }
+        if (openXmlDocument(pDocHnd) != TRDP_NO_ERR)
+        {
+            return TRDP_PARAM_ERR;
+        }
+        result = TRDP_NO_ERR;
+    }
+
     trdp_XMLRewind(pDocHnd->pXmlDocument);
 
     /* Set default values */
@@ -1595,6 +1636,10 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
                                     {
                                         pProcessConfig->options &= (TRDP_OPTION_T) ~TRDP_OPTION_TRAFFIC_SHAPING;
                                     }
+                                    else if (vos_strnicmp("hyperperiod", value, TRDP_MAX_LABEL_LEN) == 0)
+                                    {
+                                        pProcessConfig->options |= TRDP_OPTION_TRAFFIC_SHAPING | TRDP_OPTION_PD_SCHEDULE;
+                                    }
                                 }
                                 else if (vos_strnicmp(attribute, "priority", MAX_TOK_LEN) == 0)
                                 {
@@ -1760,6 +1805,12 @@ EXT_DECL TRDP_ERR_T tau_readXmlDeviceConfig (
     CHAR8   value[MAX_TOK_LEN];
     UINT32  valueInt;
 
+    if (pDocHnd->pCache != NULL)
+    {
+        return trdp_xmlCacheDeviceConfig(pDocHnd->pCache, pMemConfig, pDbgConfig, pNumComPar, ppComPar,
+                                         pNumIfConfig, ppIfConfig);
+    }
+
     trdp_XMLRewind(pDocHnd->pXmlDocument);
 
     /*  Default all parameters    */
@@ -2015,6 +2066,11 @@ EXT_DECL TRDP_ERR_T tau_readXmlMappedDevices(
         return TRDP_PARAM_ERR;
     }
 
+    if (openXmlDocument(pDocHnd) != TRDP_NO_ERR)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
     trdp_XMLRewind(pDocHnd->pXmlDocument);
 
     /* Set default values */
@@ -2102,6 +2158,11 @@ EXT_DECL TRDP_ERR_T tau_readXmlMappedDeviceConfig(
     *pNumIfConfig = 0;
     *ppIfConfig = NULL;
 
+    if (openXmlDocument(pDocHnd) != TRDP_NO_ERR)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
     trdp_XMLRewind(pDocHnd->pXmlDocument);
 
     trdp_XMLEnter(pDocHnd->pXmlDocument);
@@ -2214,6 +2275,11 @@ EXT_DECL TRDP_ERR_T tau_readXmlMappedInterfaceConfig(
         return TRDP_PARAM_ERR;
     }
 
+    if (openXmlDocument(pDocHnd) != TRDP_NO_ERR)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
     trdp_XMLRewind(pDocHnd->pXmlDocument);
 
     /* Set default values */
@@ -2347,7 +2413,14 @@ EXT_DECL TRDP_ERR_T tau_readXmlDatasetConfig (
     apTRDP_DATASET_T            *apDataset
     )
 {
-    TRDP_ERR_T err = readXmlDatasetMap(pDocHnd->pXmlDocument, pNumComId, ppComIdDsIdMap);
+    TRDP_ERR_T err;
+
+    if (pDocHnd->pCache != NULL)
+    {
+        return trdp_xmlCacheDatasetConfig(pDocHnd->pCache, pNumComId, ppComIdDsIdMap, pNumDataset, apDataset);
+    }
+
+    err = readXmlDatasetMap(pDocHnd->pXmlDocument, pNumComId, ppComIdDsIdMap);
     if (err == TRDP_NO_ERR)
     {
         err = readXmlDatasets(pDocHnd->pXmlDocument, pNumDataset, apDataset);
@@ -2446,6 +2519,11 @@ EXT_DECL TRDP_ERR_T tau_readXmlServiceConfig (
         return TRDP_PARAM_ERR;
     }
 
+    if (openXmlDocument(pDocHnd) != TRDP_NO_ERR)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
     trdp_XMLRewind(pDocHnd->pXmlDocument);
 
     /*  Default all parameters    */
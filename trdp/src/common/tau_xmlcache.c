@@ -0,0 +1,1270 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_xmlcache.c
+ *
+ * @brief           Binary cache of the parsed XML configuration
+ *
+ * @details         The cache file is written by tau_writeXmlCache from the results of the tau_readXml* functions and
+ *                  mapped read only at startup. All references inside the file are offsets from its start, it does not
+ *                  depend on the address it is mapped to. Records are stored in host byte order and host structure
+ *                  layout, a signature of the layout is part of the header together with the size and CRC of the
+ *                  XML file and a CRC over the cache itself. A cache not matching in any of these is not used.
+ *
+ *                  Reading from the cache copies the records into the same vos_memAlloc blocks tau_xml creates,
+ *                  tau_freeTelegrams and tau_freeXmlDatasetConfig release them as usual.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+ /*
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "trdp_types.h"
+#include "trdp_utils.h"
+#include "tau_xml.h"
+#include "trdp_xml.h"
+#include "tau_xmlcache.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TAU_XML_CACHE_MAGIC     0x43585254u     /**< "TRXC" on little endian hosts                      */
+#define TAU_XML_CACHE_VERSION   2u              /**< Incremented with every change of the record layout  */
+#define TAU_XML_CACHE_ALIGN     8u              /**< Alignment of all records within the file            */
+#define TAU_XML_CACHE_NIL       0u              /**< Reference to nothing, offset 0 is the header        */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Reference to a record: offset from the start of the cache */
+typedef UINT32 TAU_XML_REF_T;
+
+/** Cache file header */
+typedef struct
+{
+    UINT32          magic;          /**< TAU_XML_CACHE_MAGIC                                    */
+    UINT32          version;        /**< TAU_XML_CACHE_VERSION                                  */
+    UINT32          layout;         /**< Signature of byte order and structure sizes            */
+    UINT32          size;           /**< Size of the cache file                                 */
+    UINT32          crc;            /**< CRC of the cache file following the header             */
+    UINT32          xmlSize;        /**< Size of the XML file the cache was made from           */
+    UINT32          xmlCrc;         /**< CRC of the XML file the cache was made from            */
+    TAU_XML_REF_T   device;         /**< Device configuration                                   */
+    UINT32          numIf;          /**< Number of interface configurations                     */
+    TAU_XML_REF_T   ifList;         /**< Interface configurations                               */
+    UINT32          numComId;       /**< Number of ComId to dataset mappings                    */
+    TAU_XML_REF_T   comIdMap;       /**< ComId to dataset mappings                              */
+    UINT32          numDataset;     /**< Number of datasets                                     */
+    TAU_XML_REF_T   datasetList;    /**< References to the datasets                             */
+} TAU_XML_CACHE_HDR_T;
+
+/** Device configuration, as tau_readXmlDeviceConfig */
+typedef struct
+{
+    TRDP_MEM_CONFIG_T   memConfig;      /**< Memory configuration, no memory area           */
+    TRDP_DBG_CONFIG_T   dbgConfig;      /**< Debug configuration                            */
+    UINT32              numComPar;      /**< Number of com parameters                       */
+    TAU_XML_REF_T       comPar;         /**< Com parameters, TRDP_COM_PAR_T                 */
+    UINT32              numIfConfig;    /**< Number of interfaces                           */
+    TAU_XML_REF_T       ifConfig;       /**< Interfaces, TRDP_IF_CONFIG_T                   */
+} TAU_XML_CACHE_DEVICE_T;
+
+/** Interface configuration, as tau_readXmlInterfaceConfig */
+typedef struct
+{
+    TRDP_LABEL_T            ifName;         /**< Interface name the configuration was read for  */
+    TRDP_PROCESS_CONFIG_T   processConfig;  /**< Process configuration                          */
+    TRDP_PD_CONFIG_T        pdConfig;       /**< PD defaults, no callback                       */
+    TRDP_MD_CONFIG_T        mdConfig;       /**< MD defaults, no callback                       */
+    UINT32                  numExchgPar;    /**< Number of telegrams                            */
+    TAU_XML_REF_T           exchgPar;       /**< Telegrams, TAU_XML_CACHE_EXCHG_T               */
+} TAU_XML_CACHE_IF_T;
+
+/** Telegram, as TRDP_EXCHG_PAR_T */
+typedef struct
+{
+    UINT32          comId;
+    UINT32          datasetId;
+    UINT32          comParId;
+    TAU_XML_REF_T   mdPar;          /**< TRDP_MD_PAR_T                  */
+    TAU_XML_REF_T   pdPar;          /**< TRDP_PD_PAR_T                  */
+    UINT32          destCnt;
+    TAU_XML_REF_T   dest;           /**< TAU_XML_CACHE_DEST_T           */
+    UINT32          srcCnt;
+    TAU_XML_REF_T   src;            /**< TAU_XML_CACHE_SRC_T            */
+    UINT32          type;
+    UINT32          create;
+    UINT32          serviceId;
+} TAU_XML_CACHE_EXCHG_T;
+
+/** Destination, as TRDP_DEST_T */
+typedef struct
+{
+    UINT32          id;
+    TAU_XML_REF_T   sdtPar;         /**< TRDP_SDT_PAR_T                 */
+    TAU_XML_REF_T   uriUser;        /**< string                         */
+    TAU_XML_REF_T   uriHost;        /**< string                         */
+} TAU_XML_CACHE_DEST_T;
+
+/** Source, as TRDP_SRC_T */
+typedef struct
+{
+    UINT32          id;
+    TAU_XML_REF_T   sdtPar;         /**< TRDP_SDT_PAR_T                 */
+    TAU_XML_REF_T   uriUser;        /**< string                         */
+    TAU_XML_REF_T   uriHost1;       /**< string                         */
+    TAU_XML_REF_T   uriHost2;       /**< string                         */
+} TAU_XML_CACHE_SRC_T;
+
+/** Dataset element, as TRDP_DATASET_ELEMENT_T */
+typedef struct
+{
+    UINT32          type;
+    UINT32          size;
+    TAU_XML_REF_T   name;           /**< string                         */
+    TAU_XML_REF_T   unit;           /**< string                         */
+    REAL32          scale;
+    INT32           offset;
+} TAU_XML_CACHE_ELEMENT_T;
+
+/** Dataset, as TRDP_DATASET_T */
+typedef struct
+{
+    UINT32                  id;
+    UINT32                  numElement;
+    TRDP_EXTRA_LABEL_T      name;
+    TAU_XML_CACHE_ELEMENT_T element[1];     /**< numElement elements, at least one slot allocated   */
+} TAU_XML_CACHE_DATASET_T;
+
+/** Cache being written */
+typedef struct
+{
+    UINT8   *pBuf;                  /**< Cache contents                 */
+    UINT32  used;                   /**< Bytes used                     */
+    UINT32  size;                   /**< Bytes allocated                */
+} TAU_XML_CACHE_BUF_T;
+
+/** Open cache */
+struct TAU_XML_CACHE
+{
+    const UINT8 *pBlob;             /**< Mapped cache file              */
+    size_t      size;               /**< Size of the cache file         */
+    BOOL8       xmlOpen;            /**< XML document opened            */
+    CHAR8       *pXmlFile;          /**< Pathname of the XML file       */
+};
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+/**********************************************************************************************************************/
+/**    Signature of the structure layout and byte order of this build.
+ *
+ *  @retval         signature
+ */
+static UINT32 cacheLayout (void)
+{
+    const UINT32 layout[] =
+    {
+        0x01020304u,                            /* byte order, as it is stored */
+        (UINT32) sizeof(void *),
+        (UINT32) sizeof(TAU_XML_CACHE_HDR_T),
+        (UINT32) sizeof(TAU_XML_CACHE_DEVICE_T),
+        (UINT32) sizeof(TAU_XML_CACHE_IF_T),
+        (UINT32) sizeof(TRDP_MEM_CONFIG_T),
+        (UINT32) sizeof(TRDP_DBG_CONFIG_T),
+        (UINT32) sizeof(TRDP_COM_PAR_T),
+        (UINT32) sizeof(TRDP_IF_CONFIG_T),
+        (UINT32) sizeof(TRDP_PROCESS_CONFIG_T),
+        (UINT32) sizeof(TRDP_PD_CONFIG_T),
+        (UINT32) sizeof(TRDP_MD_CONFIG_T),
+        (UINT32) sizeof(TRDP_SDT_PAR_T),
+        (UINT32) sizeof(TRDP_PD_PAR_T),
+        (UINT32) sizeof(TRDP_MD_PAR_T),
+        (UINT32) sizeof(TRDP_COMID_DSID_MAP_T),
+        (UINT32) sizeof(TRDP_URI_USER_T),
+        (UINT32) sizeof(TRDP_URI_HOST_T)
+    };
+
+    return vos_crc32(INITFCS, (const UINT8 *) layout, (UINT32) sizeof(layout));
+}
+
+/**********************************************************************************************************************/
+/**    Append a zeroed record to the cache being written.
+ *
+ *  @param[in]      pOut            Cache being written
+ *  @param[in]      size            Size of the record
+ *
+ *  @retval         reference to the record, TAU_XML_CACHE_NIL if out of memory
+ */
+static TAU_XML_REF_T cacheAlloc (
+    TAU_XML_CACHE_BUF_T *pOut,
+    UINT32              size)
+{
+    UINT32  ref     = (pOut->used + TAU_XML_CACHE_ALIGN - 1u) & ~(TAU_XML_CACHE_ALIGN - 1u);
+    UINT32  used    = ref + size;
+
+    if (used < ref)
+    {
+        return TAU_XML_CACHE_NIL;
+    }
+    if (used > pOut->size)
+    {
+        UINT32  newSize = (pOut->size > 0u) ? pOut->size : 4096u;
+        UINT8   *pNew;
+
+        while (newSize < used)
+        {
+            newSize *= 2u;
+        }
+        pNew = (UINT8 *) realloc(pOut->pBuf, newSize);
+        if (pNew == NULL)
+        {
+            return TAU_XML_CACHE_NIL;
+        }
+        pOut->pBuf  = pNew;
+        pOut->size  = newSize;
+    }
+    memset(pOut->pBuf + pOut->used, 0, used - pOut->used);
+    pOut->used = used;
+    return ref;
+}
+
+/**********************************************************************************************************************/
+/**    Append a copy of a record.
+ *
+ *  @param[in]      pOut            Cache being written
+ *  @param[in]      pSrc            Record to copy, may be NULL
+ *  @param[in]      size            Size of the record
+ *  @param[out]     pRef            Reference to the copy, TAU_XML_CACHE_NIL for a NULL record
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T cachePut (
+    TAU_XML_CACHE_BUF_T *pOut,
+    const void          *pSrc,
+    UINT32              size,
+    TAU_XML_REF_T       *pRef)
+{
+    *pRef = TAU_XML_CACHE_NIL;
+    if ((pSrc == NULL) || (size == 0u))
+    {
+        return TRDP_NO_ERR;
+    }
+    *pRef = cacheAlloc(pOut, size);
+    if (*pRef == TAU_XML_CACHE_NIL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    memcpy(pOut->pBuf + *pRef, pSrc, size);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Append a string.
+ *
+ *  @param[in]      pOut            Cache being written
+ *  @param[in]      pStr            String, may be NULL
+ *  @param[out]     pRef            Reference to the copy, TAU_XML_CACHE_NIL for a NULL string
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T cachePutString (
+    TAU_XML_CACHE_BUF_T *pOut,
+    const CHAR8         *pStr,
+    TAU_XML_REF_T       *pRef)
+{
+    return cachePut(pOut, pStr, (pStr == NULL) ? 0u : (UINT32) strlen(pStr) + 1u, pRef);
+}
+
+/**********************************************************************************************************************/
+/**    Append the telegrams of an interface.
+ *
+ *  @param[in]      pOut            Cache being written
+ *  @param[in]      numExchgPar     Number of telegrams
+ *  @param[in]      pExchgPar       Telegrams
+ *  @param[out]     pRef            Reference to the telegram records
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T cachePutTelegrams (
+    TAU_XML_CACHE_BUF_T     *pOut,
+    UINT32                  numExchgPar,
+    const TRDP_EXCHG_PAR_T  *pExchgPar,
+    TAU_XML_REF_T           *pRef)
+{
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      i, j;
+
+    *pRef = TAU_XML_CACHE_NIL;
+    if (numExchgPar == 0u)
+    {
+        return TRDP_NO_ERR;
+    }
+    *pRef = cacheAlloc(pOut, numExchgPar * (UINT32) sizeof(TAU_XML_CACHE_EXCHG_T));
+    if (*pRef == TAU_XML_CACHE_NIL)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    /* The records are filled through references, every append may move the buffer */
+    for (i = 0u; (i < numExchgPar) && (err == TRDP_NO_ERR); i++)
+    {
+        const TRDP_EXCHG_PAR_T  *pEP    = &pExchgPar[i];
+        TAU_XML_REF_T           ref     = *pRef + i * (UINT32) sizeof(TAU_XML_CACHE_EXCHG_T);
+        TAU_XML_CACHE_EXCHG_T   rec;
+
+        memset(&rec, 0, sizeof(rec));
+        rec.comId       = pEP->comId;
+        rec.datasetId   = pEP->datasetId;
+        rec.comParId    = pEP->comParId;
+        rec.type        = (UINT32) pEP->type;
+        rec.create      = (UINT32) pEP->create;
+        rec.serviceId   = pEP->serviceId;
+
+        err = cachePut(pOut, pEP->pMdPar, (UINT32) sizeof(TRDP_MD_PAR_T), &rec.mdPar);
+        if (err == TRDP_NO_ERR)
+        {
+            err = cachePut(pOut, pEP->pPdPar, (UINT32) sizeof(TRDP_PD_PAR_T), &rec.pdPar);
+        }
+        if ((err == TRDP_NO_ERR) && (pEP->destCnt > 0u) && (pEP->pDest != NULL))
+        {
+            rec.destCnt = pEP->destCnt;
+            rec.dest    = cacheAlloc(pOut, pEP->destCnt * (UINT32) sizeof(TAU_XML_CACHE_DEST_T));
+            err         = (rec.dest == TAU_XML_CACHE_NIL) ? TRDP_MEM_ERR : TRDP_NO_ERR;
+            for (j = 0u; (j < pEP->destCnt) && (err == TRDP_NO_ERR); j++)
+            {
+                TAU_XML_CACHE_DEST_T dest;
+
+                memset(&dest, 0, sizeof(dest));
+                dest.id = pEP->pDest[j].id;
+                err     = cachePut(pOut, pEP->pDest[j].pSdtPar, (UINT32) sizeof(TRDP_SDT_PAR_T), &dest.sdtPar);
+                if (err == TRDP_NO_ERR)
+                {
+                    err = cachePutString(pOut, (const CHAR8 *) pEP->pDest[j].pUriUser, &dest.uriUser);
+                }
+                if (err == TRDP_NO_ERR)
+                {
+                    err = cachePutString(pOut, (const CHAR8 *) pEP->pDest[j].pUriHost, &dest.uriHost);
+                }
+                memcpy(pOut->pBuf + rec.dest + j * (UINT32) sizeof(TAU_XML_CACHE_DEST_T), &dest, sizeof(dest));
+            }
+        }
+        if ((err == TRDP_NO_ERR) && (pEP->srcCnt > 0u) && (pEP->pSrc != NULL))
+        {
+            rec.srcCnt  = pEP->srcCnt;
+            rec.src     = cacheAlloc(pOut, pEP->srcCnt * (UINT32) sizeof(TAU_XML_CACHE_SRC_T));
+            err         = (rec.src == TAU_XML_CACHE_NIL) ? TRDP_MEM_ERR : TRDP_NO_ERR;
+            for (j = 0u; (j < pEP->srcCnt) && (err == TRDP_NO_ERR); j++)
+            {
+                TAU_XML_CACHE_SRC_T src;
+
+                memset(&src, 0, sizeof(src));
+                src.id  = pEP->pSrc[j].id;
+                err     = cachePut(pOut, pEP->pSrc[j].pSdtPar, (UINT32) sizeof(TRDP_SDT_PAR_T), &src.sdtPar);
+                if (err == TRDP_NO_ERR)
+                {
+                    err = cachePutString(pOut, (const CHAR8 *) pEP->pSrc[j].pUriUser, &src.uriUser);
+                }
+                if (err == TRDP_NO_ERR)
+                {
+                    err = cachePutString(pOut, (const CHAR8 *) pEP->pSrc[j].pUriHost1, &src.uriHost1);
+                }
+                if (err == TRDP_NO_ERR)
+                {
+                    err = cachePutString(pOut, (const CHAR8 *) pEP->pSrc[j].pUriHost2, &src.uriHost2);
+                }
+                memcpy(pOut->pBuf + rec.src + j * (UINT32) sizeof(TAU_XML_CACHE_SRC_T), &src, sizeof(src));
+            }
+        }
+        memcpy(pOut->pBuf + ref, &rec, sizeof(rec));
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Append the datasets.
+ *
+ *  @param[in]      pOut            Cache being written
+ *  @param[in]      numDataset      Number of datasets
+ *  @param[in]      apDataset       Datasets
+ *  @param[out]     pRef            Reference to the list of dataset references
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T cachePutDatasets (
+    TAU_XML_CACHE_BUF_T     *pOut,
+    UINT32                  numDataset,
+    TRDP_DATASET_T          * *apDataset,
+    TAU_XML_REF_T           *pRef)
+{
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      i, j;
+
+    *pRef = TAU_XML_CACHE_NIL;
+    if ((numDataset == 0u) || (apDataset == NULL))
+    {
+        return TRDP_NO_ERR;
+    }
+    *pRef = cacheAlloc(pOut, numDataset * (UINT32) sizeof(TAU_XML_REF_T));
+    if (*pRef == TAU_XML_CACHE_NIL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    for (i = 0u; (i < numDataset) && (err == TRDP_NO_ERR); i++)
+    {
+        const TRDP_DATASET_T    *pDs = apDataset[i];
+        TAU_XML_REF_T           dsRef;
+
+        dsRef = cacheAlloc(pOut, (UINT32) sizeof(TAU_XML_CACHE_DATASET_T)
+                           + pDs->numElement * (UINT32) sizeof(TAU_XML_CACHE_ELEMENT_T));
+        if (dsRef == TAU_XML_CACHE_NIL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        memcpy(pOut->pBuf + *pRef + i * (UINT32) sizeof(TAU_XML_REF_T), &dsRef, sizeof(dsRef));
+        ((TAU_XML_CACHE_DATASET_T *) (pOut->pBuf + dsRef))->id          = pDs->id;
+        ((TAU_XML_CACHE_DATASET_T *) (pOut->pBuf + dsRef))->numElement  = pDs->numElement;
+        memcpy(((TAU_XML_CACHE_DATASET_T *) (pOut->pBuf + dsRef))->name, pDs->name, sizeof(TRDP_EXTRA_LABEL_T));
+
+        for (j = 0u; (j < pDs->numElement) && (err == TRDP_NO_ERR); j++)
+        {
+            TAU_XML_CACHE_ELEMENT_T el;
+
+            memset(&el, 0, sizeof(el));
+            el.type     = pDs->pElement[j].type;
+            el.size     = pDs->pElement[j].size;
+            el.scale    = pDs->pElement[j].scale;
+            el.offset   = pDs->pElement[j].offset;
+            err = cachePutString(pOut, pDs->pElement[j].name, &el.name);
+            if (err == TRDP_NO_ERR)
+            {
+                err = cachePutString(pOut, pDs->pElement[j].unit, &el.unit);
+            }
+            memcpy(&((TAU_XML_CACHE_DATASET_T *) (pOut->pBuf + dsRef))->element[j], &el, sizeof(el));
+        }
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Build the cache from a parsed XML document.
+ *
+ *  @param[in]      pDocHnd         Handle of the XML document
+ *  @param[in]      pOut            Cache being written, header allocated
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *  @retval         other           from the tau_readXml* functions
+ */
+static TRDP_ERR_T cacheBuild (
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    TAU_XML_CACHE_BUF_T         *pOut)
+{
+    TAU_XML_CACHE_DEVICE_T  device;
+    TAU_XML_CACHE_HDR_T     hdr;
+    TRDP_COM_PAR_T          *pComPar    = NULL;
+    TRDP_IF_CONFIG_T        *pIfConfig  = NULL;
+    TRDP_COMID_DSID_MAP_T   *pComIdMap  = NULL;
+    apTRDP_DATASET_T        apDataset   = NULL;
+    UINT32                  numDataset  = 0u;
+    UINT32                  i;
+    TRDP_ERR_T              err;
+
+    memset(&device, 0, sizeof(device));
+    memcpy(&hdr, pOut->pBuf, sizeof(hdr));
+
+    err = tau_readXmlDeviceConfig(pDocHnd, &device.memConfig, &device.dbgConfig,
+                                  &device.numComPar, &pComPar, &device.numIfConfig, &pIfConfig);
+    if (err == TRDP_NO_ERR)
+    {
+        device.memConfig.p = NULL;
+        err = cachePut(pOut, pComPar, device.numComPar * (UINT32) sizeof(TRDP_COM_PAR_T), &device.comPar);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        err = cachePut(pOut, pIfConfig, device.numIfConfig * (UINT32) sizeof(TRDP_IF_CONFIG_T), &device.ifConfig);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        err = cachePut(pOut, &device, (UINT32) sizeof(device), &hdr.device);
+    }
+
+    /* The configuration of every interface of the device */
+    if ((err == TRDP_NO_ERR) && (device.numIfConfig > 0u))
+    {
+        hdr.numIf   = device.numIfConfig;
+        hdr.ifList  = cacheAlloc(pOut, hdr.numIf * (UINT32) sizeof(TAU_XML_CACHE_IF_T));
+        err         = (hdr.ifList == TAU_XML_CACHE_NIL) ? TRDP_MEM_ERR : TRDP_NO_ERR;
+    }
+    for (i = 0u; (i < hdr.numIf) && (err == TRDP_NO_ERR); i++)
+    {
+        TAU_XML_CACHE_IF_T  ifRec;
+        TRDP_EXCHG_PAR_T    *pExchgPar = NULL;
+
+        memset(&ifRec, 0, sizeof(ifRec));
+        vos_strncpy(ifRec.ifName, pIfConfig[i].ifName, TRDP_MAX_LABEL_LEN);
+        err = tau_readXmlInterfaceConfig(pDocHnd, ifRec.ifName, &ifRec.processConfig, &ifRec.pdConfig,
+                                         &ifRec.mdConfig, &ifRec.numExchgPar, &pExchgPar);
+        if (err == TRDP_NO_ERR)
+        {
+            ifRec.pdConfig.pfCbFunction = NULL;
+            ifRec.pdConfig.pRefCon      = NULL;
+            ifRec.mdConfig.pfCbFunction = NULL;
+            ifRec.mdConfig.pRefCon      = NULL;
+            err = cachePutTelegrams(pOut, ifRec.numExchgPar, pExchgPar, &ifRec.exchgPar);
+        }
+        tau_freeTelegrams(ifRec.numExchgPar, pExchgPar);
+        memcpy(pOut->pBuf + hdr.ifList + i * (UINT32) sizeof(TAU_XML_CACHE_IF_T), &ifRec, sizeof(ifRec));
+    }
+
+    if (err == TRDP_NO_ERR)
+    {
+        err = tau_readXmlDatasetConfig(pDocHnd, &hdr.numComId, &pComIdMap, &numDataset, &apDataset);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        err = cachePut(pOut, pComIdMap, hdr.numComId * (UINT32) sizeof(TRDP_COMID_DSID_MAP_T), &hdr.comIdMap);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        hdr.numDataset = numDataset;
+        err = cachePutDatasets(pOut, numDataset, apDataset, &hdr.datasetList);
+    }
+    tau_freeXmlDatasetConfig(hdr.numComId, pComIdMap, numDataset, apDataset);
+    if (pComPar != NULL)
+    {
+        vos_memFree(pComPar);
+    }
+    if (pIfConfig != NULL)
+    {
+        vos_memFree(pIfConfig);
+    }
+    memcpy(pOut->pBuf, &hdr, sizeof(hdr));
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Resolve a reference of an open cache.
+ *
+ *  @param[in]      pCache          Open cache
+ *  @param[in]      ref             Reference
+ *  @param[in]      size            Size of the record
+ *
+ *  @retval         pointer to the record, NULL for a nil or invalid reference
+ */
+static const void *cacheAt (
+    const struct TAU_XML_CACHE  *pCache,
+    TAU_XML_REF_T               ref,
+    size_t                      size)
+{
+    if ((ref == TAU_XML_CACHE_NIL) || ((ref & (TAU_XML_CACHE_ALIGN - 1u)) != 0u) ||
+        (ref > pCache->size) || (size > pCache->size - ref))
+    {
+        return NULL;
+    }
+    return pCache->pBlob + ref;
+}
+
+/**********************************************************************************************************************/
+/**    Copy a string of an open cache into a vos_memAlloc block.
+ *
+ *  @param[in]      pCache          Open cache
+ *  @param[in]      ref             Reference to the string
+ *  @param[in]      minSize         Minimum size of the block
+ *  @param[out]     ppStr           Copy, NULL for a nil reference
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T cacheGetString (
+    const struct TAU_XML_CACHE  *pCache,
+    TAU_XML_REF_T               ref,
+    UINT32                      minSize,
+    CHAR8                       * *ppStr)
+{
+    const CHAR8 *pSrc = (const CHAR8 *) cacheAt(pCache, ref, 1u);
+    const CHAR8 *pEnd;
+    UINT32      len;
+
+    *ppStr = NULL;
+    if (pSrc == NULL)
+    {
+        return TRDP_NO_ERR;
+    }
+    pEnd = (const CHAR8 *) memchr(pSrc, 0, pCache->size - ref);
+    len = (pEnd == NULL) ? 0u : (UINT32) (pEnd - pSrc);
+    *ppStr = (CHAR8 *) vos_memAlloc((len + 1u > minSize) ? len + 1u : minSize);
+    if (*ppStr == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    memcpy(*ppStr, pSrc, len);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Copy a record of an open cache into a vos_memAlloc block.
+ *
+ *  @param[in]      pCache          Open cache
+ *  @param[in]      ref             Reference to the record
+ *  @param[in]      size            Size of the record
+ *  @param[out]     ppDst           Copy, NULL for a nil reference
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T cacheGet (
+    const struct TAU_XML_CACHE  *pCache,
+    TAU_XML_REF_T               ref,
+    UINT32                      size,
+    void                        * *ppDst)
+{
+    const void *pSrc = cacheAt(pCache, ref, size);
+
+    *ppDst = NULL;
+    if ((pSrc == NULL) || (size == 0u))
+    {
+        return TRDP_NO_ERR;
+    }
+    *ppDst = vos_memAlloc(size);
+    if (*ppDst == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    memcpy(*ppDst, pSrc, size);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Copy the telegrams of an interface out of an open cache.
+ *
+ *  @param[in]      pCache          Open cache
+ *  @param[in]      pIf             Interface record
+ *  @param[out]     ppExchgPar      Telegrams, allocated as by tau_readXmlInterfaceConfig
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory, nothing allocated
+ */
+static TRDP_ERR_T cacheGetTelegrams (
+    const struct TAU_XML_CACHE  *pCache,
+    const TAU_XML_CACHE_IF_T    *pIf,
+    TRDP_EXCHG_PAR_T            * *ppExchgPar)
+{
+    const TAU_XML_CACHE_EXCHG_T *pRec;
+    TRDP_EXCHG_PAR_T            *pExchgPar;
+    TRDP_ERR_T                  err = TRDP_NO_ERR;
+    UINT32                      i, j;
+
+    pRec = (const TAU_XML_CACHE_EXCHG_T *) cacheAt(pCache, pIf->exchgPar,
+                                                   pIf->numExchgPar * sizeof(TAU_XML_CACHE_EXCHG_T));
+    if (pRec == NULL)
+    {
+        return TRDP_NO_ERR;
+    }
+    pExchgPar = (TRDP_EXCHG_PAR_T *) vos_memAlloc(pIf->numExchgPar * (UINT32) sizeof(TRDP_EXCHG_PAR_T));
+    if (pExchgPar == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    /* Counts are set only after their arrays were allocated, tau_freeTelegrams can undo a partial copy */
+    for (i = 0u; (i < pIf->numExchgPar) && (err == TRDP_NO_ERR); i++, pRec++)
+    {
+        TRDP_EXCHG_PAR_T            *pEP = &pExchgPar[i];
+        const TAU_XML_CACHE_DEST_T  *pDest;
+        const TAU_XML_CACHE_SRC_T   *pSrc;
+
+        pEP->comId      = pRec->comId;
+        pEP->datasetId  = pRec->datasetId;
+        pEP->comParId   = pRec->comParId;
+        pEP->type       = (TRDP_EXCHG_OPTION_T) pRec->type;
+        pEP->create     = (BOOL8) pRec->create;
+        pEP->serviceId  = pRec->serviceId;
+
+        err = cacheGet(pCache, pRec->mdPar, (UINT32) sizeof(TRDP_MD_PAR_T), (void * *) &pEP->pMdPar);
+        if (err == TRDP_NO_ERR)
+        {
+            err = cacheGet(pCache, pRec->pdPar, (UINT32) sizeof(TRDP_PD_PAR_T), (void * *) &pEP->pPdPar);
+        }
+
+        pDest = (const TAU_XML_CACHE_DEST_T *) cacheAt(pCache, pRec->dest,
+                                                       pRec->destCnt * sizeof(TAU_XML_CACHE_DEST_T));
+        if ((err == TRDP_NO_ERR) && (pDest != NULL) && (pRec->destCnt > 0u))
+        {
+            pEP->pDest = (TRDP_DEST_T *) vos_memAlloc(pRec->destCnt * (UINT32) sizeof(TRDP_DEST_T));
+            if (pEP->pDest == NULL)
+            {
+                err = TRDP_MEM_ERR;
+            }
+            else
+            {
+                pEP->destCnt = pRec->destCnt;
+            }
+            for (j = 0u; (j < pEP->destCnt) && (err == TRDP_NO_ERR); j++)
+            {
+                pEP->pDest[j].id = pDest[j].id;
+                err = cacheGet(pCache, pDest[j].sdtPar, (UINT32) sizeof(TRDP_SDT_PAR_T),
+                               (void * *) &pEP->pDest[j].pSdtPar);
+                if (err == TRDP_NO_ERR)
+                {
+                    err = cacheGetString(pCache, pDest[j].uriUser, TRDP_MAX_URI_USER_LEN + 1u,
+                                         (CHAR8 * *) &pEP->pDest[j].pUriUser);
+                }
+                if (err == TRDP_NO_ERR)
+                {
+                    err = cacheGetString(pCache, pDest[j].uriHost, 0u, (CHAR8 * *) &pEP->pDest[j].pUriHost);
+                }
+            }
+        }
+
+        pSrc = (const TAU_XML_CACHE_SRC_T *) cacheAt(pCache, pRec->src, pRec->srcCnt * sizeof(TAU_XML_CACHE_SRC_T));
+        if ((err == TRDP_NO_ERR) && (pSrc != NULL) && (pRec->srcCnt > 0u))
+        {
+            pEP->pSrc = (TRDP_SRC_T *) vos_memAlloc(pRec->srcCnt * (UINT32) sizeof(TRDP_SRC_T));
+            if (pEP->pSrc == NULL)
+            {
+                err = TRDP_MEM_ERR;
+            }
+            else
+            {
+                pEP->srcCnt = pRec->srcCnt;
+            }
+            for (j = 0u; (j < pEP->srcCnt) && (err == TRDP_NO_ERR); j++)
+            {
+                pEP->pSrc[j].id = pSrc[j].id;
+                err = cacheGet(pCache, pSrc[j].sdtPar, (UINT32) sizeof(TRDP_SDT_PAR_T),
+                               (void * *) &pEP->pSrc[j].pSdtPar);
+                if (err == TRDP_NO_ERR)
+                {
+                    err = cacheGetString(pCache, pSrc[j].uriUser, TRDP_MAX_URI_USER_LEN + 1u,
+                                         (CHAR8 * *) &pEP->pSrc[j].pUriUser);
+                }
+                if (err == TRDP_NO_ERR)
+                {
+                    err = cacheGetString(pCache, pSrc[j].uriHost1, 0u, (CHAR8 * *) &pEP->pSrc[j].pUriHost1);
+                }
+                if (err == TRDP_NO_ERR)
+                {
+                    err = cacheGetString(pCache, pSrc[j].uriHost2, 0u, (CHAR8 * *) &pEP->pSrc[j].pUriHost2);
+                }
+            }
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        tau_freeTelegrams(pIf->numExchgPar, pExchgPar);
+        return err;
+    }
+    *ppExchgPar = pExchgPar;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Map a cache file and check it against the XML file.
+ *
+ *  @param[in]      pFileName       Pathname of the XML file
+ *  @param[in]      pCacheFileName  Pathname of the cache file
+ *  @param[out]     ppCache         Open cache
+ *
+ *  @retval         TRDP_NO_ERR     cache usable
+ *  @retval         TRDP_IO_ERR     a file could not be read
+ *  @retval         TRDP_CRC_ERR    cache damaged or stale
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T cacheOpen (
+    const CHAR8             *pFileName,
+    const CHAR8             *pCacheFileName,
+    struct TAU_XML_CACHE    * *ppCache)
+{
+    TAU_XML_CACHE_HDR_T     hdr;
+    struct TAU_XML_CACHE    *pCache;
+    const char              *pBlob;
+    const char              *pXmlText;
+    size_t                  size;
+    size_t                  xmlSize;
+    TRDP_ERR_T              err;
+
+    err = trdp_XMLMapFile(pCacheFileName, &pBlob, &size);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    if (size < sizeof(hdr))
+    {
+        trdp_XMLUnmapFile(pBlob, size);
+        return TRDP_CRC_ERR;
+    }
+    memcpy(&hdr, pBlob, sizeof(hdr));
+    if ((hdr.magic != TAU_XML_CACHE_MAGIC) || (hdr.version != TAU_XML_CACHE_VERSION) ||
+        (hdr.layout != cacheLayout()) || (hdr.size != size) ||
+        (hdr.crc != vos_crc32(INITFCS, (const UINT8 *) pBlob + sizeof(hdr), (UINT32) (size - sizeof(hdr)))))
+    {
+        trdp_XMLUnmapFile(pBlob, size);
+        return TRDP_CRC_ERR;
+    }
+
+    /* The cache is stale if the XML file changed since */
+    err = trdp_XMLMapFile(pFileName, &pXmlText, &xmlSize);
+    if (err != TRDP_NO_ERR)
+    {
+        trdp_XMLUnmapFile(pBlob, size);
+        return err;
+    }
+    if ((hdr.xmlSize != xmlSize) || (hdr.xmlCrc != vos_crc32(INITFCS, (const UINT8 *) pXmlText, (UINT32) xmlSize)))
+    {
+        err = TRDP_CRC_ERR;
+    }
+    trdp_XMLUnmapFile(pXmlText, xmlSize);
+    if (err != TRDP_NO_ERR)
+    {
+        trdp_XMLUnmapFile(pBlob, size);
+        return err;
+    }
+
+    pCache = (struct TAU_XML_CACHE *) malloc(sizeof(struct TAU_XML_CACHE) + strlen(pFileName) + 1u);
+    if (pCache == NULL)
+    {
+        trdp_XMLUnmapFile(pBlob, size);
+        return TRDP_MEM_ERR;
+    }
+    pCache->pBlob       = (const UINT8 *) pBlob;
+    pCache->size        = size;
+    pCache->xmlOpen     = FALSE;
+    pCache->pXmlFile    = (CHAR8 *) (pCache + 1);
+    strcpy(pCache->pXmlFile, pFileName);
+    *ppCache = pCache;
+    return TRDP_NO_ERR;
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Open the XML file behind a cache on first use.
+ *
+ *  @param[in]      pCache          Cache of the document
+ *  @param[in]      pXML            XML handle of the document, opened on the first call
+ *
+ *  @retval         TRDP_NO_ERR     XML document available
+ *  @retval         TRDP_IO_ERR     XML file could not be read
+ */
+TRDP_ERR_T trdp_xmlCacheOpenXml (
+    struct TAU_XML_CACHE    *pCache,
+    XML_HANDLE_T            *pXML)
+{
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
+    if (pCache->xmlOpen == FALSE)
+    {
+        err = trdp_XMLOpen(pXML, pCache->pXmlFile);
+        if (err == TRDP_NO_ERR)
+        {
+            pCache->xmlOpen = TRUE;
+        }
+        else
+        {
+            vos_printLog(VOS_LOG_ERROR, "XML cache: failed to open XML file %s\n", pCache->pXmlFile);
+        }
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Release a cache.
+ *
+ *  @param[in]      pCache          Cache to release, may be NULL
+ *
+ */
+void trdp_xmlCacheClose (
+    struct TAU_XML_CACHE *pCache)
+{
+    if (pCache != NULL)
+    {
+        trdp_XMLUnmapFile((const char *) pCache->pBlob, pCache->size);
+        free(pCache);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Read the device configuration from a cache, parameters as tau_readXmlDeviceConfig.
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+TRDP_ERR_T trdp_xmlCacheDeviceConfig (
+    const struct TAU_XML_CACHE  *pCache,
+    TRDP_MEM_CONFIG_T           *pMemConfig,
+    TRDP_DBG_CONFIG_T           *pDbgConfig,
+    UINT32                      *pNumComPar,
+    TRDP_COM_PAR_T              * *ppComPar,
+    UINT32                      *pNumIfConfig,
+    TRDP_IF_CONFIG_T            * *ppIfConfig)
+{
+    const TAU_XML_CACHE_HDR_T       *pHdr       = (const TAU_XML_CACHE_HDR_T *) pCache->pBlob;
+    const TAU_XML_CACHE_DEVICE_T    *pDevice    = (const TAU_XML_CACHE_DEVICE_T *) cacheAt(pCache, pHdr->device,
+                                                                                           sizeof(*pDevice));
+    TRDP_COM_PAR_T                  *pComPar    = NULL;
+    TRDP_IF_CONFIG_T                *pIfConfig  = NULL;
+    TRDP_ERR_T                      err;
+
+    if (pDevice == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    err = cacheGet(pCache, pDevice->comPar, pDevice->numComPar * (UINT32) sizeof(TRDP_COM_PAR_T),
+                   (void * *) &pComPar);
+    if (err == TRDP_NO_ERR)
+    {
+        err = cacheGet(pCache, pDevice->ifConfig, pDevice->numIfConfig * (UINT32) sizeof(TRDP_IF_CONFIG_T),
+                       (void * *) &pIfConfig);
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        if (pComPar != NULL)
+        {
+            vos_memFree(pComPar);
+        }
+        return err;
+    }
+    if (pMemConfig != NULL)
+    {
+        *pMemConfig = pDevice->memConfig;
+    }
+    if (pDbgConfig != NULL)
+    {
+        *pDbgConfig = pDevice->dbgConfig;
+    }
+    *pNumComPar     = (pComPar == NULL) ? 0u : pDevice->numComPar;
+    *ppComPar       = pComPar;
+    *pNumIfConfig   = (pIfConfig == NULL) ? 0u : pDevice->numIfConfig;
+    *ppIfConfig     = pIfConfig;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Read the configuration of an interface from a cache, parameters as tau_readXmlInterfaceConfig.
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_NODATA_ERR interface not in the cache, outputs untouched
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+TRDP_ERR_T trdp_xmlCacheInterfaceConfig (
+    const struct TAU_XML_CACHE  *pCache,
+    const CHAR8                 *pIfName,
+    TRDP_PROCESS_CONFIG_T       *pProcessConfig,
+    TRDP_PD_CONFIG_T            *pPdConfig,
+    TRDP_MD_CONFIG_T            *pMdConfig,
+    UINT32                      *pNumExchgPar,
+    TRDP_EXCHG_PAR_T            * *ppExchgPar)
+{
+    const TAU_XML_CACHE_HDR_T   *pHdr   = (const TAU_XML_CACHE_HDR_T *) pCache->pBlob;
+    const TAU_XML_CACHE_IF_T    *pIf    = (const TAU_XML_CACHE_IF_T *) cacheAt(pCache, pHdr->ifList,
+                                                                               pHdr->numIf * sizeof(*pIf));
+    TRDP_EXCHG_PAR_T            *pExchgPar = NULL;
+    UINT32                      i;
+    TRDP_ERR_T                  err;
+
+    /* An empty name selects by position in the XML file, this is left to tau_xml */
+    if ((pIf == NULL) || (pIfName == NULL) || (strlen(pIfName) == 0u))
+    {
+        return TRDP_NODATA_ERR;
+    }
+    for (i = 0u; i < pHdr->numIf; i++, pIf++)
+    {
+        if (vos_strnicmp(pIfName, pIf->ifName, TRDP_MAX_LABEL_LEN) == 0)
+        {
+            break;
+        }
+    }
+    if (i == pHdr->numIf)
+    {
+        return TRDP_NODATA_ERR;
+    }
+
+    err = cacheGetTelegrams(pCache, pIf, &pExchgPar);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    if (pProcessConfig != NULL)
+    {
+        *pProcessConfig = pIf->processConfig;
+    }
+    *pPdConfig      = pIf->pdConfig;
+    *pMdConfig      = pIf->mdConfig;
+    *pNumExchgPar   = (pExchgPar == NULL) ? 0u : pIf->numExchgPar;
+    *ppExchgPar     = pExchgPar;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Read the dataset configuration from a cache, parameters as tau_readXmlDatasetConfig.
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+TRDP_ERR_T trdp_xmlCacheDatasetConfig (
+    const struct TAU_XML_CACHE  *pCache,
+    UINT32                      *pNumComId,
+    TRDP_COMID_DSID_MAP_T       * *ppComIdDsIdMap,
+    UINT32                      *pNumDataset,
+    papTRDP_DATASET_T           papDataset)
+{
+    const TAU_XML_CACHE_HDR_T   *pHdr = (const TAU_XML_CACHE_HDR_T *) pCache->pBlob;
+    const TAU_XML_REF_T         *pDsRef;
+    TRDP_COMID_DSID_MAP_T       *pComIdMap  = NULL;
+    apTRDP_DATASET_T            apDataset   = NULL;
+    UINT32                      numDataset  = 0u;
+    TRDP_ERR_T                  err;
+    UINT32                      i, j;
+
+    err = cacheGet(pCache, pHdr->comIdMap, pHdr->numComId * (UINT32) sizeof(TRDP_COMID_DSID_MAP_T),
+                   (void * *) &pComIdMap);
+    pDsRef = (const TAU_XML_REF_T *) cacheAt(pCache, pHdr->datasetList, pHdr->numDataset * sizeof(TAU_XML_REF_T));
+    if ((err == TRDP_NO_ERR) && (pDsRef != NULL) && (pHdr->numDataset > 0u))
+    {
+        apDataset = (apTRDP_DATASET_T) vos_memAlloc(pHdr->numDataset * (UINT32) sizeof(pTRDP_DATASET_T));
+        err = (apDataset == NULL) ? TRDP_MEM_ERR : TRDP_NO_ERR;
+    }
+    for (i = 0u; (apDataset != NULL) && (i < pHdr->numDataset) && (err == TRDP_NO_ERR); i++)
+    {
+        const TAU_XML_CACHE_DATASET_T   *pRec = (const TAU_XML_CACHE_DATASET_T *) cacheAt(pCache, pDsRef[i],
+                                                                                          sizeof(*pRec));
+        TRDP_DATASET_T                  *pDs;
+
+        if ((pRec == NULL) || (pRec->numElement > 0xFFFFu) ||
+            (cacheAt(pCache, pDsRef[i], sizeof(*pRec) + pRec->numElement * sizeof(TAU_XML_CACHE_ELEMENT_T)) == NULL))
+        {
+            err = TRDP_PARAM_ERR;
+            break;
+        }
+        pDs = (TRDP_DATASET_T *) vos_memAlloc(pRec->numElement * (UINT32) sizeof(TRDP_DATASET_ELEMENT_T)
+                                              + (UINT32) sizeof(TRDP_DATASET_T));
+        if (pDs == NULL)
+        {
+            err = TRDP_MEM_ERR;
+            break;
+        }
+        apDataset[i]    = pDs;
+        numDataset      = i + 1u;
+        pDs->id         = pRec->id;
+        memcpy(pDs->name, pRec->name, sizeof(TRDP_EXTRA_LABEL_T));
+
+        /* numElement counts the elements with their strings allocated */
+        for (j = 0u; (j < pRec->numElement) && (err == TRDP_NO_ERR); j++)
+        {
+            pDs->pElement[j].type   = pRec->element[j].type;
+            pDs->pElement[j].size   = pRec->element[j].size;
+            pDs->pElement[j].scale  = pRec->element[j].scale;
+            pDs->pElement[j].offset = pRec->element[j].offset;
+            pDs->numElement         = (UINT16) (j + 1u);
+            err = cacheGetString(pCache, pRec->element[j].name, 0u, &pDs->pElement[j].name);
+            if (err == TRDP_NO_ERR)
+            {
+                err = cacheGetString(pCache, pRec->element[j].unit, 0u, &pDs->pElement[j].unit);
+            }
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        if (pComIdMap != NULL)
+        {
+            vos_memFree(pComIdMap);
+        }
+        if (numDataset > 0u)
+        {
+            tau_freeXmlDatasetConfig(0u, NULL, numDataset, apDataset);
+        }
+        else if (apDataset != NULL)
+        {
+            vos_memFree(apDataset);
+        }
+        return err;
+    }
+    *pNumComId      = (pComIdMap == NULL) ? 0u : pHdr->numComId;
+    *ppComIdDsIdMap = pComIdMap;
+    *pNumDataset    = (apDataset == NULL) ? 0u : pHdr->numDataset;
+    *papDataset     = apDataset;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Prepare a document from a binary configuration cache, fall back to the XML file.
+ *
+ *  @param[in]      pFileName         Path and filename of the xml configuration file
+ *  @param[in]      pCacheFileName    Path and filename of the cache file
+ *  @param[out]     pDocHnd           Handle of the document, pDocHnd->pCache is NULL if the cache was not used
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    File does not exist
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_prepareXmlCache (
+    const CHAR8             *pFileName,
+    const CHAR8             *pCacheFileName,
+    TRDP_XML_DOC_HANDLE_T   *pDocHnd)
+{
+    struct TAU_XML_CACHE    *pCache = NULL;
+    TRDP_ERR_T              err;
+
+    if ((pFileName == NULL) || (strlen(pFileName) == 0u) || (pDocHnd == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if ((pCacheFileName == NULL) || (strlen(pCacheFileName) == 0u))
+    {
+        return tau_prepareXmlDoc(pFileName, pDocHnd);
+    }
+
+    err = cacheOpen(pFileName, pCacheFileName, &pCache);
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_INFO, "XML cache %s not used (%d), reading %s\n", pCacheFileName, err, pFileName);
+        return tau_prepareXmlDoc(pFileName, pDocHnd);
+    }
+
+    /*  The XML handle stays closed until configuration is requested the cache does not hold */
+    memset(pDocHnd, 0, sizeof(TRDP_XML_DOC_HANDLE_T));
+    pDocHnd->pXmlDocument = (XML_HANDLE_T *) vos_memAlloc(sizeof(XML_HANDLE_T));
+    if (pDocHnd->pXmlDocument == NULL)
+    {
+        trdp_xmlCacheClose(pCache);
+        return TRDP_MEM_ERR;
+    }
+    pDocHnd->pCache = pCache;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Parse an XML configuration file and write its binary configuration cache.
+ *
+ *  @param[in]      pFileName         Path and filename of the xml configuration file
+ *  @param[in]      pCacheFileName    Path and filename of the cache file to write
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    XML file does not exist
+ *  @retval         TRDP_IO_ERR       cache could not be written
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_writeXmlCache (
+    const CHAR8             *pFileName,
+    const CHAR8             *pCacheFileName)
+{
+    TRDP_XML_DOC_HANDLE_T   docHnd;
+    TAU_XML_CACHE_BUF_T     out     = {NULL, 0u, 0u};
+    TAU_XML_CACHE_HDR_T     hdr;
+    const char              *pXmlText;
+    size_t                  xmlSize;
+    CHAR8                   *pTmpName;
+    FILE                    *fp;
+    TRDP_ERR_T              err;
+
+    if ((pCacheFileName == NULL) || (strlen(pCacheFileName) == 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    err = tau_prepareXmlDoc(pFileName, &docHnd);
+    if (err != TRDP_NO_ERR)
+    {
+        tau_freeXmlDoc(&docHnd);
+        return err;
+    }
+
+    /* Stamp the cache with the XML file as it was parsed */
+    memset(&hdr, 0, sizeof(hdr));
+    err = trdp_XMLMapFile(pFileName, &pXmlText, &xmlSize);
+    if (err == TRDP_NO_ERR)
+    {
+        hdr.xmlSize = (UINT32) xmlSize;
+        hdr.xmlCrc  = vos_crc32(INITFCS, (const UINT8 *) pXmlText, (UINT32) xmlSize);
+        trdp_XMLUnmapFile(pXmlText, xmlSize);
+        (void) cacheAlloc(&out, (UINT32) sizeof(hdr));     /* the header is the only record at offset 0 */
+        if (out.used != sizeof(hdr))
+        {
+            err = TRDP_MEM_ERR;
+        }
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        memcpy(out.pBuf, &hdr, sizeof(hdr));
+        err = cacheBuild(&docHnd, &out);
+    }
+    tau_freeXmlDoc(&docHnd);
+
+    if (err == TRDP_NO_ERR)
+    {
+        memcpy(&hdr, out.pBuf, sizeof(hdr));
+        hdr.magic   = TAU_XML_CACHE_MAGIC;
+        hdr.version = TAU_XML_CACHE_VERSION;
+        hdr.layout  = cacheLayout();
+        hdr.size    = out.used;
+        hdr.crc     = vos_crc32(INITFCS, out.pBuf + sizeof(hdr), out.used - (UINT32) sizeof(hdr));
+        memcpy(out.pBuf, &hdr, sizeof(hdr));
+
+        /* Write a temporary file and replace the cache by it */
+        pTmpName = (CHAR8 *) malloc(strlen(pCacheFileName) + 5u);
+        if (pTmpName == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+        else
+        {
+            strcpy(pTmpName, pCacheFileName);
+            strcat(pTmpName, ".tmp");
+            fp = fopen(pTmpName, "wb");
+            if (fp == NULL)
+            {
+                err = TRDP_IO_ERR;
+            }
+            else
+            {
+                if (fwrite(out.pBuf, 1u, out.used, fp) != out.used)
+                {
+                    err = TRDP_IO_ERR;
+                }
+                if (fclose(fp) != 0)
+                {
+                    err = TRDP_IO_ERR;
+                }
+#ifndef POSIX
+                if (err == TRDP_NO_ERR)
+                {
+                    (void) remove(pCacheFileName);
+                }
+#endif
+                if ((err != TRDP_NO_ERR) || (rename(pTmpName, pCacheFileName) != 0))
+                {
+                    (void) remove(pTmpName);
+                    err = TRDP_IO_ERR;
+                }
+            }
+            free(pTmpName);
+        }
+    }
+    free(out.pBuf);
+    return err;
+}
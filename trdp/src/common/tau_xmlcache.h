@@ -0,0 +1,113 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_xmlcache.h
+ *
+ * @brief           Binary cache of the parsed XML configuration, internal interface to tau_xml
+ *
+ * @details         A cache file holds the device, interface and dataset configuration as read by tau_xml, together
+ *                  with the size and CRC of the XML file it was made from. tau_xml serves its readers from the cache
+ *                  and opens the XML file only for configuration the cache does not hold.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+ /*
+ * $Id$
+ *
+ */
+
+#ifndef TAU_XMLCACHE_H
+#define TAU_XMLCACHE_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_types.h"
+#include "tau_xml.h"
+#include "trdp_xml.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/**    Open the XML file behind a cache on first use.
+ *
+ *  @param[in]      pCache          Cache of the document
+ *  @param[in]      pXML            XML handle of the document, opened on the first call
+ *
+ *  @retval         TRDP_NO_ERR     XML document available
+ *  @retval         TRDP_IO_ERR     XML file could not be read
+ */
+TRDP_ERR_T trdp_xmlCacheOpenXml (
+    struct TAU_XML_CACHE    *pCache,
+    XML_HANDLE_T            *pXML);
+
+/**********************************************************************************************************************/
+/**    Release a cache.
+ *
+ *  @param[in]      pCache          Cache to release, may be NULL
+ *
+ */
+void trdp_xmlCacheClose (
+    struct TAU_XML_CACHE *pCache);
+
+/**********************************************************************************************************************/
+/**    Read the device configuration from a cache, parameters as tau_readXmlDeviceConfig.
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+TRDP_ERR_T trdp_xmlCacheDeviceConfig (
+    const struct TAU_XML_CACHE  *pCache,
+    TRDP_MEM_CONFIG_T           *pMemConfig,
+    TRDP_DBG_CONFIG_T           *pDbgConfig,
+    UINT32                      *pNumComPar,
+    TRDP_COM_PAR_T              * *ppComPar,
+    UINT32                      *pNumIfConfig,
+    TRDP_IF_CONFIG_T            * *ppIfConfig);
+
+/**********************************************************************************************************************/
+/**    Read the configuration of an interface from a cache, parameters as tau_readXmlInterfaceConfig.
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_NODATA_ERR interface not in the cache, outputs untouched
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+TRDP_ERR_T trdp_xmlCacheInterfaceConfig (
+    const struct TAU_XML_CACHE  *pCache,
+    const CHAR8                 *pIfName,
+    TRDP_PROCESS_CONFIG_T       *pProcessConfig,
+    TRDP_PD_CONFIG_T            *pPdConfig,
+    TRDP_MD_CONFIG_T            *pMdConfig,
+    UINT32                      *pNumExchgPar,
+    TRDP_EXCHG_PAR_T            * *ppExchgPar);
+
+/**********************************************************************************************************************/
+/**    Read the dataset configuration from a cache, parameters as tau_readXmlDatasetConfig.
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+TRDP_ERR_T trdp_xmlCacheDatasetConfig (
+    const struct TAU_XML_CACHE  *pCache,
+    UINT32                      *pNumComId,
+    TRDP_COMID_DSID_MAP_T       * *ppComIdDsIdMap,
+    UINT32                      *pNumDataset,
+    papTRDP_DATASET_T           papDataset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAU_XMLCACHE_H */
@@ -31,8 +31,19 @@
 #include <string.h>
 #include <strings.h>
 #include <stdlib.h>
+#include <ctype.h>
 
 #include "tau_xmarshall.h"
+#include "tau_bswap.h"
+
+/* slot of the element name index */
+typedef struct {
+	UINT32 hash;      /* of dataset id and lower-case name, 0 for a free slot */
+	UINT16 dsIdx;     /* index into apDataset */
+	UINT16 elIdx;     /* index into pElement */
+} XVAR_IDX_T;
+
+#define XVAR_NAME_LEN   30u          /* names are compared up to this length, as always */
 
 /* static members */
 static struct xsession_common {
@@ -63,11 +74,19 @@ static struct xsession_common {
 	UINT32                 numDataset;
 	apTRDP_DATASET_T       apDataset;
 
+/*  Element index, built once the datasets are loaded */
+	UINT32                 varIdxMask;     /* number of name index slots - 1 */
+	XVAR_IDX_T            *pVarIdx;        /* name index, open addressing */
+	UINT32               **ppWireOffset;   /* per dataset: wire offset of each element and the end,
+	                                          TAU_XSESSION_VAR_OFFSET after a variable sized one */
+
 } _ = {-1, };
 
 /* protected */
 static TRDP_ERR_T initMarshalling(const TRDP_XML_DOC_HANDLE_T * pDocHnd, const UINT8 *pTypeMap);
 static TRDP_ERR_T findDataset(UINT32 datasetId, TRDP_DATASET_T **pDatasetDesc);
+static TRDP_ERR_T buildVarIndex(void);
+static void freeVarIndex(void);
 
 static TRDP_ERR_T publishTelegram(TAU_XSESSION_T *our, TRDP_EXCHG_PAR_T * pExchgPar, INT32 *pubTelID, UINT32 IDs, const UINT8 *data, UINT32 memLength, const TRDP_PD_INFO_T *info);
 static TRDP_ERR_T subscribeTelegram(TAU_XSESSION_T *our, TRDP_EXCHG_PAR_T * pExchgPar, INT32 *subTelID /*can be NULL*/, UINT32 IDs, TRDP_PD_CALLBACK_T cb);
@@ -203,11 +222,12 @@ static TRDP_ERR_T initMarshalling(const TRDP_XML_DOC_HANDLE_T * pDocHnd, const U
 		}
 	}
 	/* basically, take values, sort the arrays, but takes no copy! */
+	_.marshallCfg.pRefCon = NULL;
 	if (xmap_valid) {
 		result = tau_xinitMarshall(NULL /*cur. a nop*/, _.numComId, _.pComIdDsIdMap, _.numDataset, _.apDataset, pXTypeMap);
 		vos_printLogStr(VOS_LOG_INFO, "Using EXTENDED marshalling.");
 	} else {
-		result = tau_initMarshall( NULL /*cur. a nop*/, _.numComId, _.pComIdDsIdMap, _.numDataset, _.apDataset);
+		result = tau_initMarshall(&_.marshallCfg.pRefCon, _.numComId, _.pComIdDsIdMap, _.numDataset, _.apDataset);
 		vos_printLogStr(VOS_LOG_INFO, "Using default marshalling.");
 	}
 	if (result != TRDP_NO_ERR) {
@@ -223,10 +243,13 @@ static TRDP_ERR_T initMarshalling(const TRDP_XML_DOC_HANDLE_T * pDocHnd, const U
 	/*  Strore pointers to marshalling functions    */
 	_.marshallCfg.pfCbMarshall   = xmap_valid ? tau_xmarshall : tau_marshall;
 	_.marshallCfg.pfCbUnmarshall = xmap_valid ? tau_xunmarshall : tau_unmarshall;
-	_.marshallCfg.pRefCon = NULL; /* if we overwrite with own functions, pRefCon may be set to @our or something like it */
 
 	vos_printLog(VOS_LOG_INFO, "Initialized %cmarshalling for %u datasets, %u ComId to Dataset Id relations",
 			xmap_valid?'x':' ',	_.numDataset, _.numComId);
+
+	/*  Index the elements for the lookup functions  */
+	result = buildVarIndex();
+	if (result != TRDP_NO_ERR) vos_printLog(VOS_LOG_WARNING, "No element index: %s", tau_getResultString(result));
 	return TRDP_NO_ERR;
 }
 
@@ -245,6 +268,123 @@ static TRDP_ERR_T findDataset(UINT32 datasetId, TRDP_DATASET_T **pDatasetDesc) {
 	return TRDP_PARAM_ERR;
 }
 
+/*********************************************************************************************************************/
+/** Hash of a dataset id and an element name, names ignoring case as in the XML lookup
+ */
+static UINT32 varHash(UINT32 datasetId, const CHAR8 *name) {
+	UINT32 h = 2166136261u;
+	for (int i = 0; i < 4; i++, datasetId >>= 8) h = (h ^ (datasetId & 0xFFu)) * 16777619u;
+	for (UINT32 i = 0; name && name[i] && i < XVAR_NAME_LEN; i++) h = (h ^ (UINT8)tolower((UINT8)name[i])) * 16777619u;
+	return h ? h : 1u;
+}
+
+/*********************************************************************************************************************/
+/** Size of an element array on the wire, TAU_XSESSION_VAR_OFFSET if it is or contains variable sized elements
+ */
+static UINT32 wireSize(const TRDP_DATASET_ELEMENT_T *el, int level) {
+	static const UINT8 baseSize[] = { 0, 1, 1, 2, 1, 2, 4, 8, 1, 2, 4, 8, 4, 8, 4, 6, 8 };
+	UINT32 size = 0;
+
+	if (el->size == TRDP_VAR_SIZE) return TAU_XSESSION_VAR_OFFSET;
+	if (el->type <= TRDP_TIMEDATE64) {
+		size = baseSize[el->type];
+	} else {
+		TRDP_DATASET_T *ds;
+		if ((el->type <= TRDP_TYPE_MAX) || (level > TAU_MAX_DS_LEVEL) || findDataset(el->type, &ds)) return TAU_XSESSION_VAR_OFFSET;
+		for (UINT32 i = 0; i < ds->numElement; i++) {
+			UINT32 s = wireSize(&ds->pElement[i], level + 1);
+			if (s == TAU_XSESSION_VAR_OFFSET) return s;
+			size += s;
+		}
+	}
+	return (size && el->size <= 0xFFFFFFFEu / size) ? size * el->size : TAU_XSESSION_VAR_OFFSET;
+}
+
+/*********************************************************************************************************************/
+/** Build the element name index and the wire offsets of all datasets, after they are loaded and sorted
+ */
+static TRDP_ERR_T buildVarIndex(void) {
+	UINT32 numElement = 0;
+	UINT32 slots = 16u;
+
+	for (UINT32 d = 0; d < _.numDataset; d++) numElement += _.apDataset[d]->numElement;
+	while (slots < 2 * numElement) slots <<= 1;
+	if (_.numDataset > 0xFFFFu) return TRDP_PARAM_ERR;
+
+	UINT8 *p = (UINT8 *)vos_memAlloc(slots * sizeof(XVAR_IDX_T) + _.numDataset * sizeof(UINT32 *)
+			+ (numElement + _.numDataset) * sizeof(UINT32));
+	if (!p) return TRDP_MEM_ERR;
+	_.pVarIdx = (XVAR_IDX_T *)p;
+	_.varIdxMask = slots - 1;
+	_.ppWireOffset = (UINT32 **)(p + slots * sizeof(XVAR_IDX_T));
+	UINT32 *pOffset = (UINT32 *)(_.ppWireOffset + _.numDataset);
+
+	for (UINT32 d = 0; d < _.numDataset; d++) {
+		const TRDP_DATASET_T *ds = _.apDataset[d];
+		UINT32 offset = 0;
+
+		_.ppWireOffset[d] = pOffset;
+		for (UINT32 e = 0; e < ds->numElement; e++) {
+			pOffset[e] = offset;
+			if (offset != TAU_XSESSION_VAR_OFFSET) {
+				UINT32 s = wireSize(&ds->pElement[e], 1);
+				offset = (s == TAU_XSESSION_VAR_OFFSET || s > TAU_XSESSION_VAR_OFFSET - 1 - offset) ? TAU_XSESSION_VAR_OFFSET : offset + s;
+			}
+
+			if (ds->pElement[e].name && ds->pElement[e].name[0]) {
+				UINT32 h = varHash(ds->id, ds->pElement[e].name);
+				UINT32 i = h & _.varIdxMask;
+				while (_.pVarIdx[i].hash) i = (i + 1) & _.varIdxMask;
+				_.pVarIdx[i] = (XVAR_IDX_T){ .hash = h, .dsIdx = (UINT16)d, .elIdx = (UINT16)e };
+			}
+		}
+		pOffset[ds->numElement] = offset;
+		pOffset += ds->numElement + 1;
+	}
+	return TRDP_NO_ERR;
+}
+
+static void freeVarIndex(void) {
+	if (_.pVarIdx) vos_memFree(_.pVarIdx);
+	_.pVarIdx = NULL;
+	_.ppWireOffset = NULL;
+	_.varIdxMask = 0;
+}
+
+/*********************************************************************************************************************/
+/** Find an element by name or index (starting with 1), returning the index of its dataset and the element
+ */
+static TRDP_ERR_T findVariable(UINT32 datasetId, const CHAR8 *name, UINT32 index, UINT32 *dsIdx, UINT32 *elIdx) {
+	if (_.use < 0 || !_.pVarIdx) return TRDP_INIT_ERR;
+	if (!datasetId || (!name == !index)) return TRDP_PARAM_ERR;
+
+	if (name) {
+		UINT32 h = varHash(datasetId, name);
+		for (UINT32 i = h & _.varIdxMask; _.pVarIdx[i].hash; i = (i + 1) & _.varIdxMask) {
+			const TRDP_DATASET_T *ds = _.apDataset[_.pVarIdx[i].dsIdx];
+			if (_.pVarIdx[i].hash == h && ds->id == datasetId
+					&& !strncasecmp(name, ds->pElement[_.pVarIdx[i].elIdx].name, XVAR_NAME_LEN)) {
+				*dsIdx = _.pVarIdx[i].dsIdx;
+				*elIdx = _.pVarIdx[i].elIdx;
+				return TRDP_NO_ERR;
+			}
+		}
+	} else {
+		/* datasets are sorted by id for marshalling */
+		UINT32 lo = 0, hi = _.numDataset;
+		while (lo < hi) {
+			UINT32 mid = (lo + hi) / 2;
+			if (_.apDataset[mid]->id < datasetId) lo = mid + 1; else hi = mid;
+		}
+		if (lo < _.numDataset && _.apDataset[lo]->id == datasetId && index <= _.apDataset[lo]->numElement) {
+			*dsIdx = lo;
+			*elIdx = index - 1;
+			return TRDP_NO_ERR;
+		}
+	}
+	return TRDP_PARAM_ERR;
+}
+
 
 int tau_xsession_up(const TAU_XSESSION_T *our) {
 	return our && our->initialized;
@@ -886,12 +1026,14 @@ TRDP_ERR_T tau_xsession_cycle( TAU_XSESSION_T *our ) {
 	return err;
 }
 
-TRDP_ERR_T tau_xsession_setCom(TAU_XSESSION_T *our, INT32 pubTelID, const UINT8 *data, UINT32 cap) {
+static TRDP_ERR_T setComWith(TAU_XSESSION_T *our, INT32 pubTelID, TRDP_MARSHALL_T pfEncode, void *ref, const UINT8 *data, UINT32 cap) {
 	if (!tau_xsession_up(our)) return TRDP_INIT_ERR;
 	TRDP_ERR_T result;
 
 	if (pubTelID >= 0 && pubTelID < MAX_TELEGRAMS) {
-		result = tlp_put( our->sessionhandle, our->aTelegrams[pubTelID].handle, data, cap);
+		result = pfEncode
+			? tlp_putEncoded( our->sessionhandle, our->aTelegrams[pubTelID].handle, pfEncode, ref, data, cap)
+			: tlp_put( our->sessionhandle, our->aTelegrams[pubTelID].handle, data, cap);
 		if (result != our->aTelegrams[pubTelID].result) {
 			our->aTelegrams[pubTelID].result = result;
 			vos_printLog(VOS_LOG_WARNING, "%s comId=%u for dst=<%s>. %s\n",
@@ -906,13 +1048,24 @@ TRDP_ERR_T tau_xsession_setCom(TAU_XSESSION_T *our, INT32 pubTelID, const UINT8
 	return result;
 }
 
-TRDP_ERR_T tau_xsession_getCom(TAU_XSESSION_T *our, INT32 subTelID, UINT8 *data, UINT32 cap, UINT32 *length, TRDP_PD_INFO_T *info) {
+TRDP_ERR_T tau_xsession_setCom(TAU_XSESSION_T *our, INT32 pubTelID, const UINT8 *data, UINT32 cap) {
+	return setComWith(our, pubTelID, NULL, NULL, data, cap);
+}
+
+TRDP_ERR_T tau_xsession_setComEncoded(TAU_XSESSION_T *our, INT32 pubTelID, TRDP_MARSHALL_T pfEncode, void *ref, const UINT8 *data, UINT32 cap) {
+	if (!pfEncode) return TRDP_PARAM_ERR;
+	return setComWith(our, pubTelID, pfEncode, ref, data, cap);
+}
+
+static TRDP_ERR_T getComWith(TAU_XSESSION_T *our, INT32 subTelID, TRDP_UNMARSHALL_T pfDecode, void *ref, UINT8 *data, UINT32 cap, UINT32 *length, TRDP_PD_INFO_T *info) {
 	if (!tau_xsession_up(our)) return TRDP_INIT_ERR;
 	TRDP_ERR_T result;
 
 	if ((subTelID >= 0) && (subTelID < MAX_TELEGRAMS)) {
 		if (length) *length = cap;
-		result = tlp_get( our->sessionhandle, our->aTelegrams[subTelID].handle, info, data, length);
+		result = pfDecode
+			? tlp_getDecoded( our->sessionhandle, our->aTelegrams[subTelID].handle, info, pfDecode, ref, data, length)
+			: tlp_get( our->sessionhandle, our->aTelegrams[subTelID].handle, info, data, length);
 		if (result != our->aTelegrams[subTelID].result) {
 			our->aTelegrams[subTelID].result = result;
 			vos_printLog(VOS_LOG_WARNING, "%s comId=%u from src=<%s> (%s)\n",
@@ -929,6 +1082,15 @@ TRDP_ERR_T tau_xsession_getCom(TAU_XSESSION_T *our, INT32 subTelID, UINT8 *data,
 	return result;
 }
 
+TRDP_ERR_T tau_xsession_getCom(TAU_XSESSION_T *our, INT32 subTelID, UINT8 *data, UINT32 cap, UINT32 *length, TRDP_PD_INFO_T *info) {
+	return getComWith(our, subTelID, NULL, NULL, data, cap, length, info);
+}
+
+TRDP_ERR_T tau_xsession_getComDecoded(TAU_XSESSION_T *our, INT32 subTelID, TRDP_UNMARSHALL_T pfDecode, void *ref, UINT8 *data, UINT32 cap, UINT32 *length, TRDP_PD_INFO_T *info) {
+	if (!pfDecode) return TRDP_PARAM_ERR;
+	return getComWith(our, subTelID, pfDecode, ref, data, cap, length, info);
+}
+
 TRDP_ERR_T tau_xsession_request(TAU_XSESSION_T *our, INT32 subTelID) {
 	if (!tau_xsession_up(our)) return TRDP_INIT_ERR;
 	TRDP_ERR_T result;
@@ -983,6 +1145,11 @@ TRDP_ERR_T tau_xsession_delete(TAU_XSESSION_T *our) {
 	}
 
 	if (!_.use) {
+		if (_.marshallCfg.pfCbMarshall == tau_marshall) {
+			tau_deInitMarshall(_.marshallCfg.pRefCon);
+			_.marshallCfg.pRefCon = NULL;
+		}
+		freeVarIndex();
 		tau_freeXmlDatasetConfig(_.numComId, _.pComIdDsIdMap, _.numDataset, _.apDataset);
 		_.session = NULL;
 		_.numComId = 0;
@@ -1012,6 +1179,13 @@ TRDP_ERR_T tau_xsession_getRxTime(const TAU_XSESSION_T *our, INT32 subTelID, VOS
 	return result;
 }
 
+TRDP_ERR_T tau_xsession_getFlags(const TAU_XSESSION_T *our, INT32 telID, TRDP_FLAGS_T * const flags) {
+	if (!tau_xsession_up(our)) return TRDP_INIT_ERR;
+	if ((telID < 0) || ((UINT32)telID >= our->numTelegrams) || !flags) return TRDP_PARAM_ERR;
+	*flags = our->aTelegrams[telID].handle->pktFlags;
+	return TRDP_NO_ERR;
+}
+
 TRDP_ERR_T tau_xsession_ComId2DatasetId(const TAU_XSESSION_T *our, UINT32 ComID, UINT32 * const datasetId) {
 	if (!tau_xsession_up(our)) return TRDP_INIT_ERR;
 	if (!datasetId) return TRDP_PARAM_ERR;
@@ -1022,7 +1196,7 @@ TRDP_ERR_T tau_xsession_ComId2DatasetId(const TAU_XSESSION_T *our, UINT32 ComID,
 
 			*datasetId = our->pExchgPar[tlgIdx].datasetId;
 			/* take only first matching */
-			return TRDP_COMID_ERR;
+			return TRDP_NO_ERR;
 		}
 	}
 	return result;
@@ -1035,22 +1209,99 @@ TRDP_ERR_T tau_xsession_lookup_dataset(UINT32 datasetId, TRDP_DATASET_T **ds) {
 }
 
 TRDP_ERR_T tau_xsession_lookup_variable(UINT32 datasetId, const CHAR8 *name, UINT32 index, TRDP_DATASET_ELEMENT_T **el) {
-	if ( !name ^ !index ) {
-		TRDP_DATASET_T *ds;
-		TRDP_ERR_T err = tau_xsession_lookup_dataset(datasetId, &ds);
-		if (err) return err;
-
-		if (index <= ds->numElement) {
-			index--; /* adjust from element number to C-array-index */
-			for (UINT32 i=0; i<ds->numElement; i++ ) {
-				if (i==index || (name && !strncasecmp(name, ds->pElement[i].name,30))) {
-					*el = &ds->pElement[i];
-					return TRDP_NO_ERR;
-				}
-			}
+	UINT32 dsIdx, elIdx;
+	if (!el) return TRDP_PARAM_ERR;
+	TRDP_ERR_T err = findVariable(datasetId, name, index, &dsIdx, &elIdx);
+	if (!err) *el = &_.apDataset[dsIdx]->pElement[elIdx];
+	return err;
+}
+
+TRDP_ERR_T tau_xsession_lookup_offset(UINT32 datasetId, const CHAR8 *name, UINT32 index, TAU_XSESSION_VAR_T *var) {
+	UINT32 dsIdx, elIdx;
+	if (!var) return TRDP_PARAM_ERR;
+	TRDP_ERR_T err = findVariable(datasetId, name, index, &dsIdx, &elIdx);
+	if (err) return err;
+
+	const UINT32 *pOffset = _.ppWireOffset[dsIdx];
+	if (pOffset[elIdx + 1] == TAU_XSESSION_VAR_OFFSET) return TRDP_MARSHALLING_ERR;
+	var->pElement   = &_.apDataset[dsIdx]->pElement[elIdx];
+	var->datasetId  = datasetId;
+	var->wireOffset = pOffset[elIdx];
+	var->wireSize   = pOffset[elIdx + 1] - pOffset[elIdx];
+	return TRDP_NO_ERR;
+}
+
+/*********************************************************************************************************************/
+/** TRDP_UNMARSHALL_T converting one element from the received dataset, pRefCon is the TAU_XSESSION_VAR_T
+ */
+static TRDP_ERR_T unmarshallVariable(void *pRefCon, UINT32 comId, UINT8 *pSrc, UINT32 srcSize, UINT8 *pDst,
+		UINT32 *pDstSize, TRDP_DATASET_T **ppCachedDS) {
+	const TAU_XSESSION_VAR_T *var = (const TAU_XSESSION_VAR_T *)pRefCon;
+	const UINT32 type  = var->pElement->type;
+	const UINT32 items = var->pElement->size;
+	(void)comId;
+	(void)ppCachedDS;
+
+	if (srcSize < var->wireOffset || srcSize - var->wireOffset < var->wireSize) return TRDP_MARSHALLING_ERR;
+	if (!pDst || !pDstSize) return TRDP_PARAM_ERR;
+	pSrc += var->wireOffset;
+
+	if (type > TRDP_TYPE_MAX) {
+		UINT32 done = 0;
+		if (_.marshallCfg.pfCbUnmarshall != tau_unmarshall) return TRDP_PARAM_ERR; /* no x-variant by dataset */
+		for (UINT32 i = 0; i < items; i++, pSrc += var->wireSize / items) {
+			UINT32 size = *pDstSize - done;
+			TRDP_ERR_T err = tau_unmarshallDs(_.marshallCfg.pRefCon, type, pSrc, var->wireSize / items, pDst + done, &size, NULL);
+			if (err != TRDP_NO_ERR) return err;
+			done += size;
 		}
+		*pDstSize = done;
+		return TRDP_NO_ERR;
 	}
-	return TRDP_PARAM_ERR;
+
+	const UINT32 hostSize = (type == TRDP_TIMEDATE48) ? sizeof(TIMEDATE48) : (type == TRDP_TIMEDATE64)
+			? sizeof(TIMEDATE64) : var->wireSize / items;
+	if (*pDstSize / hostSize < items) return TRDP_PARAM_ERR;
+
+	switch (type) {
+	case TRDP_TIMEDATE48:
+		for (UINT32 i = 0; i < items; i++, pSrc += 6) {
+			TIMEDATE48 t;
+			tau_netCopy32((UINT8 *)&t.sec, pSrc, 1);
+			tau_netCopy16((UINT8 *)&t.ticks, pSrc + 4, 1);
+			memcpy(pDst + i * sizeof(t), &t, sizeof(t));
+		}
+		break;
+	case TRDP_TIMEDATE64: /* two 32bit values */
+		tau_netCopy32(pDst, pSrc, 2 * items);
+		break;
+	default:
+		switch (hostSize) {
+		case 1: memcpy(pDst, pSrc, items); break;
+		case 2: tau_netCopy16(pDst, pSrc, items); break;
+		case 4: tau_netCopy32(pDst, pSrc, items); break;
+		case 8: tau_netCopy64(pDst, pSrc, items); break;
+		default: return TRDP_PARAM_ERR;
+		}
+	}
+	*pDstSize = items * hostSize;
+	return TRDP_NO_ERR;
+}
+
+TRDP_ERR_T tau_xsession_getVariable(TAU_XSESSION_T *our, INT32 subTelID, const TAU_XSESSION_VAR_T *var, UINT8 *data, UINT32 cap, UINT32 *length, TRDP_PD_INFO_T *info) {
+	if (!tau_xsession_up(our)) return TRDP_INIT_ERR;
+	if ((subTelID < 0) || ((UINT32)subTelID >= our->numTelegrams) || !var || !var->pElement || !data) {
+		vos_printLog(VOS_LOG_ERROR, "Invalid TelID (%d) or variable to getVariable.", subTelID);
+		return TRDP_PARAM_ERR;
+	}
+	UINT32 datasetId = 0;
+	TRDP_SUB_T sub = our->aTelegrams[subTelID].handle;
+	if (tau_xsession_ComId2DatasetId(our, sub->addr.comId, &datasetId) || datasetId != var->datasetId) return TRDP_PARAM_ERR;
+
+	UINT32 size = cap;
+	TRDP_ERR_T result = tlp_getDecoded(our->sessionhandle, sub, info, unmarshallVariable, (void *)var, data, &size);
+	if (length) *length = (result == TRDP_NO_ERR) ? size : 0;
+	return result;
 }
 
 
@@ -39,6 +39,19 @@ extern "C" {
 
 typedef void (*TAU_XSESSION_PRINT)(const char* lead, const char* msg, int putNL);
 
+/** Wire offset of elements following a variable sized one, only known with the data */
+#define TAU_XSESSION_VAR_OFFSET  0xFFFFFFFFu
+
+/**
+ *   Location of a dataset element in the marshalled dataset, see @see tau_xsession_lookup_offset()
+ */
+typedef struct {
+	const TRDP_DATASET_ELEMENT_T *pElement; /**< the element's description */
+	UINT32      datasetId;  /**< the dataset it belongs to */
+	UINT32      wireOffset; /**< offset in the marshalled dataset */
+	UINT32      wireSize;   /**< size of all items in the marshalled dataset */
+} TAU_XSESSION_VAR_T;
+
 /**
  *   Helper for Sub/Published telegrams, only used internally.
  */
@@ -255,6 +268,38 @@ TRDP_ERR_T tau_xsession_setCom   (TAU_XSESSION_T *our,               INT32  pubT
  */
 TRDP_ERR_T tau_xsession_getCom   (TAU_XSESSION_T *our,               INT32  subTelID,       UINT8 *data, UINT32 cap, UINT32 *length, TRDP_PD_INFO_T *info);
 
+/**
+ *   Set the payload of the telegram, marshalled by pfEncode straight into the frame instead of by the session's
+ *   marshalling. See @see tlp_putEncoded().
+ *
+ *  @param[in,out] our    session state.
+ *  @param[in]  pubTelID  The ID returned by @see tau_xsession_publish()
+ *  @param[in]  pfEncode  Conversion function, it finds cap bytes of room and returns the marshalled size.
+ *  @param[in]  ref       Passed to pfEncode as pRefCon.
+ *  @param[in]  data      A buffer of the telegram payload, as pfEncode expects it.
+ *  @param[in]  cap       Capacity/Length of buffer data.
+ *
+ *  @return  TRDP_ERR as for @see tau_xsession_setCom(), or errors of pfEncode
+ */
+TRDP_ERR_T tau_xsession_setComEncoded(TAU_XSESSION_T *our, INT32 pubTelID, TRDP_MARSHALL_T pfEncode, void *ref, const UINT8 *data, UINT32 cap);
+
+/**
+ *   Get the most recent data of the subscribed telegram, converted by pfDecode straight from the received frame
+ *   instead of by the session's unmarshalling. See @see tlp_getDecoded().
+ *
+ *  @param[in,out] our    session state.
+ *  @param[in]  subTelID  The ID returned by @see tau_xsession_subscribe()
+ *  @param[in]  pfDecode  Conversion function, called with the marshalled dataset.
+ *  @param[in]  ref       Passed to pfDecode as pRefCon.
+ *  @param[out] data      A buffer for the converted payload.
+ *  @param[in]  cap       Capacity of buffer data.
+ *  @param[out] length    Length returned by pfDecode. Pointer must not be NULL.
+ *  @param[out] info      A buffer for detailed information on the last received telegram. May be NULL.
+ *
+ *  @return TRDP_ERR as for @see tau_xsession_getCom(), or errors of pfDecode
+ */
+TRDP_ERR_T tau_xsession_getComDecoded(TAU_XSESSION_T *our, INT32 subTelID, TRDP_UNMARSHALL_T pfDecode, void *ref, UINT8 *data, UINT32 cap, UINT32 *length, TRDP_PD_INFO_T *info);
+
 /**
  *   Send out a request for the previously subscribed telegram. Use the ID returned by
  *          @see tau_xsession_subscribe()
@@ -274,6 +319,15 @@ TRDP_ERR_T tau_xsession_request  (TAU_XSESSION_T *our,               INT32  subT
  */
 TRDP_ERR_T tau_xsession_getRxTime(const TAU_XSESSION_T *our,         INT32  subTelID, VOS_TIMEVAL_T * const tv);
 
+/**
+ *   Return the packet flags of a published or subscribed telegram, e.g., to see if the stack marshalls it.
+ *
+ *  @param[in]  our       session state.
+ *  @param[in]  telID     The ID returned by @see tau_xsession_publish() or @see tau_xsession_subscribe()
+ *  @param[out] flags     The flags in effect for the telegram. Must not be NULL.
+ */
+TRDP_ERR_T tau_xsession_getFlags  (const TAU_XSESSION_T *our,         INT32  telID,    TRDP_FLAGS_T * const flags);
+
 /**
  *  Lookup the corresponding datasetID for given ComID
  */
@@ -292,6 +346,8 @@ TRDP_ERR_T tau_xsession_lookup_dataset(UINT32 datasetId, TRDP_DATASET_T **ds);
 /**
  *  get information on a dataset variable
  *
+ *  Names are found through a hash index built by @see tau_xsession_load(), indices directly.
+ *
  *  @param dsId    the dataset ID to search for
  *  @param name    name of the element to lookup, or NULL if the index is used instead
  *  @param index   number of element in dataset, set to 0 if name is used, first element is == 1
@@ -301,6 +357,37 @@ TRDP_ERR_T tau_xsession_lookup_dataset(UINT32 datasetId, TRDP_DATASET_T **ds);
  */
 TRDP_ERR_T tau_xsession_lookup_variable(UINT32 dsId, const CHAR8 *name, UINT32 index, TRDP_DATASET_ELEMENT_T **el);
 
+/**
+ *  get the location of a dataset variable in the marshalled dataset, for @see tau_xsession_getVariable()
+ *
+ *  Offsets are precomputed at load time for all elements up to the first one of variable size.
+ *
+ *  @param dsId    the dataset ID to search for
+ *  @param name    name of the element to lookup, or NULL if the index is used instead
+ *  @param index   number of element in dataset, set to 0 if name is used, first element is == 1
+ *  @param[out] var returning the location, untouched in case of error
+ *
+ *  @return  error, TRDP_MARSHALLING_ERR if the element is or follows a variable sized element
+ */
+TRDP_ERR_T tau_xsession_lookup_offset(UINT32 dsId, const CHAR8 *name, UINT32 index, TAU_XSESSION_VAR_T *var);
+
+/**
+ *   Get a single variable from the most recent data of a subscribed telegram, converted straight from the received
+ *   frame. The rest of the dataset is neither unmarshalled nor copied.
+ *
+ *  @param[in]  our       session state.
+ *  @param[in]  subTelID  The ID returned by @see tau_xsession_subscribe()
+ *  @param[in]  var       Location returned by @see tau_xsession_lookup_offset() for the dataset of the telegram
+ *  @param[out] data      A buffer for the variable, all items in host format, arrays packed.
+ *                        Nested datasets are unmarshalled as by tau_unmarshallDs().
+ *  @param[in]  cap       Capacity of buffer data.
+ *  @param[out] length    Length of the variable in data. May be NULL.
+ *  @param[out] info      A buffer for detailed information on the last received telegram. May be NULL.
+ *
+ *  @return TRDP_ERR as for @see tau_xsession_getCom(), TRDP_MARSHALLING_ERR if the received dataset is too short.
+ */
+TRDP_ERR_T tau_xsession_getVariable(TAU_XSESSION_T *our, INT32 subTelID, const TAU_XSESSION_VAR_T *var, UINT8 *data, UINT32 cap, UINT32 *length, TRDP_PD_INFO_T *info);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,7 +8,10 @@
  *                  xsession uses the xml-config feature and provides "easy" abstraction accessing telegrams and
  *                  setting up a simple cycle.
  *
- *                  This wrapper does not use any C++ specific implementation, it is just a class wrapper.
+ *                  This wrapper does not use any C++ specific implementation, it is mostly a class wrapper.
+ *                  The exceptions are asynchronous MD requests: with C++20 coroutines available, requestAwait()
+ *                  returns an awaitable, resumed from dispatchCompletions(). With C++17, datasets can be described
+ *                  as structs (tau_ds::Layout) and exchanged with typed publish/subscribe/setCom/getCom.
  *
  * @note            Project: TCNOpen TRDP prototype stack
  *
@@ -26,6 +29,259 @@
 
 #include "tau_xsession.h"
 
+#if MD_SUPPORT && defined(__cpp_impl_coroutine) && (__cpp_impl_coroutine >= 201902L)
+#include <coroutine>
+#include <deque>
+#define TAU_XSESSION_COROUTINES 1
+#endif
+
+#if (__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L))
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include "vos_utils.h"
+#define TAU_XSESSION_TYPED 1
+#endif
+
+#ifdef TAU_XSESSION_TYPED
+/**
+ *  Typed datasets for C++17.
+ *
+ *  The application describes its dataset structs by specializing tau_ds::Dataset with a tau_ds::Layout, listing the
+ *  members in the order of the XML dataset:
+ *
+ *  @code
+ *  struct Status { UINT32 counter; INT16 values[4]; TIMEDATE64 stamp; Sub sub; };
+ *  template<> struct tau_ds::Dataset<Status> : tau_ds::Layout<Status, 1001,
+ *          tau_ds::Field<&Status::counter>, tau_ds::Field<&Status::values>,
+ *          tau_ds::Field<&Status::stamp>,   tau_ds::Field<&Status::sub> > {};
+ *  @endcode
+ *
+ *  The TRDP type of a member follows from its C++ type, nested datasets need their own specialization. Where the C++
+ *  type is ambiguous (BOOL8, UTF16, TIMEDATE32, ...) give the type: tau_ds::Field<&Status::flag, TRDP_BOOL8>.
+ *  Wire offsets and sizes are computed at compile time, the struct must have the natural layout tau_marshall() expects.
+ *  Layout::check() compares the description with the loaded XML configuration. Variable sized elements are not
+ *  supported.
+ */
+namespace tau_ds {
+
+/** Specialize for each dataset struct, deriving from Layout */
+template <class T> struct Dataset;
+
+namespace detail {
+
+template <class T, class = void> struct HasDataset : std::false_type {};
+template <class T> struct HasDataset<T, std::void_t<decltype(Dataset<T>::id)> > : std::true_type {};
+
+template <class M> struct MemberOf;
+template <class C, class M> struct MemberOf<M C::*> { using Class = C; using Type = M; };
+
+/* TRDP type for a host type, 0 if there is none */
+template <class E> constexpr UINT32 typeOf() {
+	if constexpr (HasDataset<E>::value)                return Dataset<E>::id;
+	else if constexpr (std::is_same_v<E, CHAR8>)       return TRDP_CHAR8;
+	else if constexpr (std::is_same_v<E, INT8>)        return TRDP_INT8;
+	else if constexpr (std::is_same_v<E, UINT8>)       return TRDP_UINT8;
+	else if constexpr (std::is_same_v<E, INT16>)       return TRDP_INT16;
+	else if constexpr (std::is_same_v<E, UINT16>)      return TRDP_UINT16;
+	else if constexpr (std::is_same_v<E, INT32>)       return TRDP_INT32;
+	else if constexpr (std::is_same_v<E, UINT32>)      return TRDP_UINT32;
+	else if constexpr (std::is_same_v<E, INT64>)       return TRDP_INT64;
+	else if constexpr (std::is_same_v<E, UINT64>)      return TRDP_UINT64;
+	else if constexpr (std::is_same_v<E, REAL32>)      return TRDP_REAL32;
+	else if constexpr (std::is_same_v<E, REAL64>)      return TRDP_REAL64;
+	else if constexpr (std::is_same_v<E, TIMEDATE48>)  return TRDP_TIMEDATE48;
+	else if constexpr (std::is_same_v<E, TIMEDATE64>)  return TRDP_TIMEDATE64;
+	else return 0u;
+}
+
+/* wire size of a base type */
+constexpr UINT32 wireSizeOf(UINT32 type) {
+	constexpr UINT8 size[] = { 0, 1, 1, 2, 1, 2, 4, 8, 1, 2, 4, 8, 4, 8, 4, 6, 8 };
+	return (type <= TRDP_TIMEDATE64) ? size[type] : 0u;
+}
+
+/* types with the same wire encoding, accepted for deduced types */
+constexpr UINT32 wireClass(UINT32 type) {
+	switch (type) {
+	case TRDP_BITSET8: case TRDP_CHAR8: case TRDP_INT8: case TRDP_UINT8: return 1u;
+	case TRDP_UTF16: case TRDP_INT16: case TRDP_UINT16:                  return 2u;
+	case TRDP_INT32: case TRDP_UINT32: case TRDP_TIMEDATE32:             return 4u;
+	case TRDP_INT64: case TRDP_UINT64:                                   return 8u;
+	default:                                                             return 100u + type;
+	}
+}
+
+inline void put16(UINT8 *p, UINT16 v) { p[0] = (UINT8)(v >> 8); p[1] = (UINT8)v; }
+inline void put32(UINT8 *p, UINT32 v) { put16( p, (UINT16)(v >> 16) ); put16( p + 2, (UINT16)v ); }
+inline void put64(UINT8 *p, UINT64 v) { put32( p, (UINT32)(v >> 32) ); put32( p + 4, (UINT32)v ); }
+inline UINT16 get16(const UINT8 *p) { return (UINT16)((p[0] << 8) | p[1]); }
+inline UINT32 get32(const UINT8 *p) { return ((UINT32)get16( p ) << 16) | get16( p + 2 ); }
+inline UINT64 get64(const UINT8 *p) { return ((UINT64)get32( p ) << 32) | get32( p + 4 ); }
+
+/* convert one item of a base type */
+template <UINT32 Type, class E> inline void itemToWire(const E &v, UINT8 *p) {
+	if constexpr (Type == TRDP_TIMEDATE48) { put32( p, v.sec ); put16( p + 4, v.ticks ); }
+	else if constexpr (Type == TRDP_TIMEDATE64) { put32( p, v.tv_sec ); put32( p + 4, (UINT32)v.tv_usec ); }
+	else if constexpr (sizeof(E) == 1) { *p = (UINT8)v; }
+	else if constexpr (sizeof(E) == 2) { UINT16 u; std::memcpy( &u, &v, 2 ); put16( p, u ); }
+	else if constexpr (sizeof(E) == 4) { UINT32 u; std::memcpy( &u, &v, 4 ); put32( p, u ); }
+	else                               { UINT64 u; std::memcpy( &u, &v, 8 ); put64( p, u ); }
+}
+
+template <UINT32 Type, class E> inline void itemFromWire(const UINT8 *p, E &v) {
+	if constexpr (Type == TRDP_TIMEDATE48) { v.sec = get32( p ); v.ticks = get16( p + 4 ); }
+	else if constexpr (Type == TRDP_TIMEDATE64) { v.tv_sec = get32( p ); v.tv_usec = (INT32)get32( p + 4 ); }
+	else if constexpr (sizeof(E) == 1) { v = (E)*p; }
+	else if constexpr (sizeof(E) == 2) { UINT16 u = get16( p ); std::memcpy( &v, &u, 2 ); }
+	else if constexpr (sizeof(E) == 4) { UINT32 u = get32( p ); std::memcpy( &v, &u, 4 ); }
+	else                               { UINT64 u = get64( p ); std::memcpy( &v, &u, 8 ); }
+}
+
+} /* namespace detail */
+
+/**
+ *  One dataset element, bound to a struct member. Arrays map to the element's array-size.
+ *
+ *  @tparam Member  pointer to the struct member
+ *  @tparam Type    TRDP_DATA_TYPE_T or dataset id, deduced from the member type if omitted
+ */
+template <auto Member, UINT32 Type = detail::typeOf<std::remove_all_extents_t<
+		typename detail::MemberOf<decltype(Member)>::Type> >()>
+struct Field {
+	using Class  = typename detail::MemberOf<decltype(Member)>::Class;
+	using Host   = typename detail::MemberOf<decltype(Member)>::Type;
+	using Item   = std::remove_all_extents_t<Host>;
+
+	static constexpr UINT32 type     = Type;
+	static constexpr UINT32 count    = std::is_array_v<Host> ? (UINT32)std::extent_v<Host> : 1u;
+	static constexpr bool   nested   = (Type > TRDP_TYPE_MAX);
+	static constexpr bool   deduced  = (Type == detail::typeOf<Item>());
+	static constexpr UINT32 itemSize = []() constexpr {
+		if constexpr (Type > TRDP_TYPE_MAX) return Dataset<Item>::wireSize;
+		else return detail::wireSizeOf( Type );
+	}();
+	static constexpr UINT32 wireSize = count * itemSize;
+
+	static_assert(std::rank_v<Host> <= 1, "only one-dimensional arrays map to a dataset element");
+	static_assert(Type != 0u, "no TRDP type for the member type, it must be given");
+	static_assert(nested || (itemSize > 0u), "not a TRDP base type");
+	static_assert(nested || (Type == TRDP_TIMEDATE48) || (sizeof(Item) == itemSize),
+			"member type does not fit the TRDP type");
+
+	static void toWire(const Class &v, UINT8 *pW) {
+		const Item *pH = first( v.*Member );
+		if constexpr (itemSize == 1) {
+			std::memcpy( pW, pH, count );
+		} else {
+			for (UINT32 i = 0; i < count; i++, pW += itemSize) {
+				if constexpr (nested) Dataset<Item>::toWire( pH[i], pW );
+				else detail::itemToWire<Type>( pH[i], pW );
+			}
+		}
+	}
+
+	static void fromWire(const UINT8 *pW, Class &v) {
+		Item *pH = first( v.*Member );
+		if constexpr (itemSize == 1) {
+			std::memcpy( pH, pW, count );
+		} else {
+			for (UINT32 i = 0; i < count; i++, pW += itemSize) {
+				if constexpr (nested) Dataset<Item>::fromWire( pW, pH[i] );
+				else detail::itemFromWire<Type>( pW, pH[i] );
+			}
+		}
+	}
+
+	/* compare with the XML element, hostOffset is the offset tau_marshall() expects */
+	static bool check(const TRDP_DATASET_ELEMENT_T &el, const Class &probe, size_t hostOffset) {
+		const char *pMember = reinterpret_cast<const char *>(&(probe.*Member));
+		const char *pProbe  = reinterpret_cast<const char *>(&probe);
+		if ((el.size != count) || ((size_t)(pMember - pProbe) != hostOffset)) return false;
+		if constexpr (nested) return (el.type == Type) && (Dataset<Item>::check() == TRDP_NO_ERR);
+		if (el.type == Type) return true;
+		return deduced && (detail::wireClass( el.type ) == detail::wireClass( Type ));
+	}
+
+private:
+	static const Item *first(const Host &m) { if constexpr (std::is_array_v<Host>) return m; else return &m; }
+	static Item *first(Host &m) { if constexpr (std::is_array_v<Host>) return m; else return &m; }
+};
+
+/**
+ *  Compile-time description of a dataset struct T with id Id. Derive Dataset<T> from it.
+ */
+template <class T, UINT32 Id, class... Fields>
+struct Layout {
+	static_assert(std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>, "dataset must be a plain struct");
+	static_assert((std::is_same_v<T, typename Fields::Class> && ...), "all fields must be members of the dataset");
+
+	static constexpr UINT32 id         = Id;
+	static constexpr UINT32 numElement = sizeof...(Fields);
+	/** size of the marshalled dataset */
+	static constexpr UINT32 wireSize   = (Fields::wireSize + ... + 0u);
+	/** offset of each element in the marshalled dataset */
+	static constexpr std::array<UINT32, sizeof...(Fields)> wireOffsets = []() constexpr {
+		std::array<UINT32, sizeof...(Fields)> o {};
+		UINT32 s[] = { Fields::wireSize..., 0u }, off = 0;
+		for (size_t i = 0; i < o.size(); i++) { o[i] = off; off += s[i]; }
+		return o;
+	}();
+	/** offset of each member in the natural (tau_marshall) host layout */
+	static constexpr std::array<size_t, sizeof...(Fields)> hostOffsets = []() constexpr {
+		std::array<size_t, sizeof...(Fields)> o {};
+		size_t a[] = { alignof(typename Fields::Item)..., 1 }, s[] = { sizeof(typename Fields::Host)..., 0 }, off = 0;
+		for (size_t i = 0; i < o.size(); i++) { off = (off + a[i] - 1) / a[i] * a[i]; o[i] = off; off += s[i]; }
+		return o;
+	}();
+	static constexpr size_t hostSize = []() constexpr {
+		size_t a[] = { alignof(typename Fields::Item)..., 1 }, s[] = { sizeof(typename Fields::Host)..., 0 }, off = 0, m = 1;
+		for (size_t i = 0; i < sizeof...(Fields); i++) {
+			off = (off + a[i] - 1) / a[i] * a[i] + s[i];
+			m = (a[i] > m) ? a[i] : m;
+		}
+		return (off + m - 1) / m * m;
+	}();
+	static_assert(sizeof(T) == hostSize, "dataset struct has members not described or not in natural layout");
+
+	/** marshall v into pW, which must hold wireSize bytes */
+	static void toWire(const T &v, UINT8 *pW) {
+		size_t i = 0;
+		(Fields::toWire( v, pW + wireOffsets[i++] ), ...);
+	}
+
+	/** unmarshall wireSize bytes from pW into v */
+	static void fromWire(const UINT8 *pW, T &v) {
+		size_t i = 0;
+		(Fields::fromWire( pW + wireOffsets[i++], v ), ...);
+	}
+
+	/**
+	 *  Compare the description with the dataset of the loaded XML configuration, recursing into nested datasets.
+	 *  @return TRDP_NO_ERR on match, TRDP_PARAM_ERR on a mismatch or errors from @see tau_xsession_lookup_dataset()
+	 */
+	static TRDP_ERR_T check() {
+		TRDP_DATASET_T *ds = NULL;
+		TRDP_ERR_T err = tau_xsession_lookup_dataset( Id, &ds );
+		if (err != TRDP_NO_ERR) return err;
+		if (ds->numElement != numElement) {
+			vos_printLog( VOS_LOG_ERROR, "Dataset %u has %u elements, %u described\n", Id, ds->numElement, numElement );
+			return TRDP_PARAM_ERR;
+		}
+		const T probe {};
+		size_t i = 0, bad = numElement;
+		((bad = ((bad == numElement) && !Fields::check( ds->pElement[i], probe, hostOffsets[i] )) ? i : bad, i++), ...);
+		if (bad != numElement) {
+			vos_printLog( VOS_LOG_ERROR, "Dataset %u element %u does not match its description\n", Id, (UINT32)bad + 1 );
+			return TRDP_PARAM_ERR;
+		}
+		return TRDP_NO_ERR;
+	}
+};
+
+} /* namespace tau_ds */
+#endif /* TAU_XSESSION_TYPED */
+
 /**
  *  A class to wrap access around @see tau_xsession.h functions.
  *
@@ -40,7 +296,7 @@ public:
 	 *  The default constructor.
 	 *  Use @see load() (one-time initialization) and @see init() for further setup of the object.
 	 */
-	TAU_XSession() { our = NULL; lastErr=TRDP_NO_ERR; }
+	TAU_XSession() { our = NULL; lastErr=TRDP_NO_ERR; mdRequests = NULL; }
 
 	/**
 	 *  Session destructor
@@ -231,9 +487,254 @@ public:
 		{ return tau_xsession_lookup_variable(dsId, name, 0, el); }
 	}
 
+#ifdef TAU_XSESSION_TYPED
+	/**
+	 *  Check the description of dataset struct T against the dataset configured for ComID.
+	 *  Called by the typed publish() and subscribe(), see tau_ds::Layout.
+	 *
+	 *  @return TRDP_NO_ERR if T matches, TRDP_PARAM_ERR if not, TRDP_COMID_ERR if ComID is not configured.
+	 */
+	template <class T> TRDP_ERR_T checkDataset(UINT32 ComID) {
+		UINT32 dsId = 0;
+		if ((lastErr = tau_xsession_ComId2DatasetId( our, ComID, &dsId )) != TRDP_NO_ERR) return lastErr;
+		if (dsId != tau_ds::Dataset<T>::id) {
+			vos_printLog( VOS_LOG_ERROR, "ComId %u uses dataset %u, not %u\n", ComID, dsId, tau_ds::Dataset<T>::id );
+			return lastErr = TRDP_PARAM_ERR;
+		}
+		return lastErr = tau_ds::Dataset<T>::check();
+	}
+
+	/**
+	 *  Publish telegram ComID carrying the dataset struct T, which is checked against the configuration first.
+	 *  Parameters as for the untyped @see publish(), data is set for all resulting publications.
+	 */
+	template <class T> TRDP_ERR_T publish(UINT32 ComID, INT32 *pubTelID, UINT32 IDs, const T &data,
+			const TRDP_PD_INFO_T *info = NULL) {
+		if (checkDataset<T>( ComID ) != TRDP_NO_ERR) return lastErr;
+		UINT32 first = our->numTelegrams;
+		if ((lastErr = tau_xsession_publish( our, ComID, pubTelID, IDs, NULL, 0, info )) != TRDP_NO_ERR) return lastErr;
+		for (UINT32 id = first; (id < our->numTelegrams) && (lastErr == TRDP_NO_ERR); id++) setCom( (INT32)id, data );
+		return lastErr;
+	}
+
+	/**
+	 *  Subscribe telegram ComID carrying the dataset struct T, which is checked against the configuration first.
+	 *  Parameters as for the untyped @see subscribe(), without a callback. Read it with @see getCom(INT32, T&, ...).
+	 */
+	template <class T> TRDP_ERR_T subscribe(UINT32 ComID, INT32 *subTelID, UINT32 IDs) {
+		if (checkDataset<T>( ComID ) != TRDP_NO_ERR) return lastErr;
+		return lastErr = tau_xsession_subscribe( our, ComID, subTelID, IDs, NULL );
+	}
+
+	/**
+	 *  Set the payload of a telegram published with publish<T>().
+	 *
+	 *  data is converted with the compile-time layout straight into the frame, whether the telegram is configured
+	 *  to be marshalled or not. There is no intermediate copy.
+	 */
+	template <class T> TRDP_ERR_T setCom(INT32 pubTelID, const T &data) {
+		return lastErr = tau_xsession_setComEncoded( our, pubTelID, &encode<T>, NULL,
+				reinterpret_cast<const UINT8 *>(&data), sizeof(T) );
+	}
+
+	/**
+	 *  Get the payload of a telegram subscribed with subscribe<T>(), converted with the compile-time layout straight
+	 *  from the received frame.
+	 *
+	 *  @return TRDP_ERR as for the untyped @see getCom(), TRDP_MARSHALLING_ERR if the received size does not match T.
+	 */
+	template <class T> TRDP_ERR_T getCom(INT32 subTelID, T &data, TRDP_PD_INFO_T *info = NULL) {
+		UINT32 length;
+		return lastErr = tau_xsession_getComDecoded( our, subTelID, &decode<T>, NULL,
+				reinterpret_cast<UINT8 *>(&data), sizeof(T), &length, info );
+	}
+#endif
+
+#if MD_SUPPORT
+	/**
+	 *  Send an MD request without callback, @see tlm_requestAsync().
+	 *  Replies and timeouts are queued, fetch them with @see dispatchCompletions().
+	 *
+	 *  @param[in]  comId        ComID of the request
+	 *  @param[in]  destIpAddr   where to send the request to
+	 *  @param[in]  data         request payload, already marshalled
+	 *  @param[in]  size         length of data
+	 *  @param[out] handle       identifies the completions of this request
+	 *  @param[in]  numReplies   number of expected replies, 0 if unknown (multicast)
+	 *  @param[in]  replyTimeout in micro seconds, 0 for the session default
+	 *  @param[in]  flags        TRDP_FLAGS_TCP to use TCP
+	 *  @param[in]  userRef      passed back in the completion's info
+	 *
+	 *  @return     TRDP_ERR
+	 */
+	TRDP_ERR_T requestAsync(UINT32 comId, TRDP_IP_ADDR_T destIpAddr, const UINT8 *data, UINT32 size,
+			TRDP_MD_HANDLE_T *handle, UINT32 numReplies = 1, UINT32 replyTimeout = 0,
+			TRDP_FLAGS_T flags = TRDP_FLAGS_DEFAULT, void *userRef = NULL) {
+		return lastErr = up() ? tlm_requestAsync( our->sessionhandle, userRef, NULL, comId, 0, 0, 0, destIpAddr, flags,
+				numReplies, replyTimeout, NULL, data, size, NULL, NULL, handle ) : TRDP_INIT_ERR;
+	}
+
+	/**
+	 *  Get the descriptor to watch (select/poll or a Qt socket notifier) for completed requests.
+	 *  Returns TRDP_SOCK_ERR on targets without events, where dispatchCompletions() must be called periodically.
+	 */
+	TRDP_ERR_T completionDesc(TRDP_SOCK_T *desc)
+		{ return lastErr = up() ? tlm_getCompletionDesc( our->sessionhandle, desc ) : TRDP_INIT_ERR; }
+
+	/**
+	 *  Handler for completions not awaited by a coroutine. The completion's data is released after return.
+	 */
+	typedef void (*CompletionHandler)(void *ref, const TRDP_MD_COMPLETION_T *completion);
+
+	/**
+	 *  Fetch all queued completions. Completions of an awaited request resume the waiting coroutine, all others are
+	 *  passed to handler. Call it from the thread owning the coroutines, whenever completionDesc() is readable.
+	 *
+	 *  @param[in]  handler  called for completions of requests sent by requestAsync(), may be NULL
+	 *  @param[in]  ref      passed to handler
+	 *
+	 *  @return     number of completions fetched
+	 */
+	unsigned dispatchCompletions(CompletionHandler handler = NULL, void *ref = NULL) {
+		unsigned n = 0;
+		TRDP_MD_COMPLETION_T c;
+		while (up() && (tlm_getCompletion( our->sessionhandle, &c ) == TRDP_NO_ERR)) {
+			n++;
+#ifdef TAU_XSESSION_COROUTINES
+			if (deliver( c )) continue;
+#endif
+			if (handler) handler( ref, &c );
+			tlm_releaseCompletion( our->sessionhandle, &c );
+		}
+		return n;
+	}
+
+#ifdef TAU_XSESSION_COROUTINES
+	/**
+	 *  Awaitable MD request, returned by @see requestAwait().
+	 *
+	 *  Each co_await yields the next completion of the request: one per reply, the last one has final set. The
+	 *  reference is valid until the next co_await or the destruction of the object, which also releases the data.
+	 *  The object must not outlive its session.
+	 */
+	class MDRequest {
+	public:
+		MDRequest(TAU_XSession *session, UINT32 comId, TRDP_IP_ADDR_T destIpAddr, const UINT8 *data, UINT32 size,
+				UINT32 numReplies, UINT32 replyTimeout, TRDP_FLAGS_T flags)
+			: s(session), handle(0), next(NULL), haveCurrent(false), finished(false) {
+			err = s->requestAsync( comId, destIpAddr, data, size, &handle, numReplies, replyTimeout, flags, this );
+			if (err == TRDP_NO_ERR) { next = s->mdRequests; s->mdRequests = this; }
+		}
+		MDRequest(const MDRequest &) = delete;
+		MDRequest &operator=(const MDRequest &) = delete;
+		~MDRequest() {
+			for (MDRequest **pp = &s->mdRequests; *pp; pp = &(*pp)->next) {
+				if (*pp == this) { *pp = next; break; }
+			}
+			release();
+			for (TRDP_MD_COMPLETION_T &c : pending) tlm_releaseCompletion( s->our->sessionhandle, &c );
+		}
+
+		/** TRUE, when the final completion was handed out */
+		bool done() const { return finished; }
+
+		bool await_ready() const noexcept { return (err != TRDP_NO_ERR) || finished || !pending.empty(); }
+		void await_suspend(std::coroutine_handle<> h) noexcept { waiter = h; }
+		const TRDP_MD_COMPLETION_T &await_resume() {
+			release();
+			if ((err != TRDP_NO_ERR) || (finished && pending.empty())) {
+				/* a failed submission or awaiting past the end */
+				current = TRDP_MD_COMPLETION_T();
+				current.handle = handle;
+				current.final = TRUE;
+				current.info.resultCode = (err != TRDP_NO_ERR) ? err : TRDP_NODATA_ERR;
+				finished = true;
+			} else {
+				current = pending.front();
+				pending.pop_front();
+				haveCurrent = true;
+				finished = (current.final != FALSE);
+			}
+			return current;
+		}
+
+	private:
+		friend class TAU_XSession;
+		void release() {
+			if (haveCurrent) { tlm_releaseCompletion( s->our->sessionhandle, &current ); haveCurrent = false; }
+		}
+
+		TAU_XSession *s;
+		TRDP_MD_HANDLE_T handle;
+		TRDP_ERR_T err;
+		MDRequest *next;
+		std::coroutine_handle<> waiter;
+		std::deque<TRDP_MD_COMPLETION_T> pending;
+		TRDP_MD_COMPLETION_T current;
+		bool haveCurrent;
+		bool finished;
+	};
+
+	/**
+	 *  Send an MD request to be co_await-ed by a coroutine. Parameters as for @see requestAsync().
+	 *
+	 *  @code
+	 *  auto rq = session.requestAwait(COMID, dest, buf, len);
+	 *  const TRDP_MD_COMPLETION_T &reply = co_await rq;
+	 *  @endcode
+	 */
+	MDRequest requestAwait(UINT32 comId, TRDP_IP_ADDR_T destIpAddr, const UINT8 *data, UINT32 size,
+			UINT32 numReplies = 1, UINT32 replyTimeout = 0, TRDP_FLAGS_T flags = TRDP_FLAGS_DEFAULT)
+		{ return MDRequest( this, comId, destIpAddr, data, size, numReplies, replyTimeout, flags ); }
+#endif
+#endif /* MD_SUPPORT */
+
 private:
+#ifdef TAU_XSESSION_TYPED
+	/* TRDP_MARSHALL_T for setCom<T>(), writes into the frame */
+	template <class T> static TRDP_ERR_T encode(void *, UINT32, const UINT8 *pSrc, UINT32 srcSize, UINT8 *pDst,
+			UINT32 *pDstSize, TRDP_DATASET_T **) {
+		if ((srcSize != sizeof(T)) || (*pDstSize < tau_ds::Dataset<T>::wireSize)) return TRDP_PARAM_ERR;
+		tau_ds::Dataset<T>::toWire( *reinterpret_cast<const T *>(pSrc), pDst );
+		*pDstSize = tau_ds::Dataset<T>::wireSize;
+		return TRDP_NO_ERR;
+	}
+
+	/* TRDP_UNMARSHALL_T for getCom<T>(), reads from the frame */
+	template <class T> static TRDP_ERR_T decode(void *, UINT32, UINT8 *pSrc, UINT32 srcSize, UINT8 *pDst,
+			UINT32 *pDstSize, TRDP_DATASET_T **) {
+		if (srcSize != tau_ds::Dataset<T>::wireSize) return TRDP_MARSHALLING_ERR;
+		if (*pDstSize < sizeof(T)) return TRDP_PARAM_ERR;
+		tau_ds::Dataset<T>::fromWire( pSrc, *reinterpret_cast<T *>(pDst) );
+		*pDstSize = sizeof(T);
+		return TRDP_NO_ERR;
+	}
+#endif
+
+#ifdef TAU_XSESSION_COROUTINES
+	/* hand a completion to its awaiting request, resume the coroutine if it is suspended */
+	bool deliver(const TRDP_MD_COMPLETION_T &c) {
+		for (MDRequest *r = mdRequests; r; r = r->next) {
+			if (r->handle == c.handle) {
+				r->pending.push_back( c );
+				if (r->waiter) {
+					std::coroutine_handle<> h = r->waiter;
+					r->waiter = nullptr;
+					h.resume();
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+#endif
+
+#ifndef TAU_XSESSION_COROUTINES
+	class MDRequest;
+#endif
 	TAU_XSESSION_T *our;
 	TRDP_ERR_T lastErr;
+	MDRequest *mdRequests;
 
 };
 
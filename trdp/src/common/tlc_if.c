@@ -17,6 +17,15 @@
 /*
 * $Id$
 *
+*      AG 2026-10-18: tlc_run(), tlc_stopRun(), tlc_getRunStatistics(): session reactor, stopped on close
+*      AG 2026-10-18: tlc_getNextDeadline(), tlc_getInterval() includes the MD time-outs
+*      AG 2026-10-18: PD sender threads stopped on close
+*      AG 2026-10-18: tlc_updateSession() computes the hyperperiod PD schedule if TRDP_OPTION_PD_SCHEDULE is set
+*      AG 2026-10-18: tlc_getIndexStatistics(), index table depths are computed from the publishers
+*      AG 2026-10-18: tlc_updateSession() creates the index tables once, later changes are applied incrementally
+*      AG 2026-10-18: MD left out of tlc_process()/tlc_getInterval() while an MD worker runs, stopped on close
+*      AG 2026-10-18: Release the asynchronous MD completion queue on close
+*      AG 2026-10-18: Default MD sending timeout was never set (0 = immediate timeout on incomplete TCP sends)
 *     CWE 2023-01-27: Log compile-options and vos-version upon tlc_init()
 *     AHW 2023-01-11: Lint warnigs
 *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
@@ -103,6 +112,9 @@
 #include "trdp_if_light.h"
 #include "trdp_utils.h"
 #include "trdp_pdcom.h"
+#include "trdp_pdsched.h"
+#include "trdp_pdshard.h"
+#include "trdp_reactor.h"
 #include "trdp_stats.h"
 #include "vos_sock.h"
 #include "vos_mem.h"
@@ -515,6 +527,7 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
     pSession->mdDefault.confirmTimeout  = TRDP_MD_DEFAULT_CONFIRM_TIMEOUT;
     pSession->mdDefault.connectTimeout  = TRDP_MD_DEFAULT_CONNECTION_TIMEOUT;
     pSession->mdDefault.replyTimeout    = TRDP_MD_DEFAULT_REPLY_TIMEOUT;
+    pSession->mdDefault.sendingTimeout  = TRDP_MD_DEFAULT_SENDING_TIMEOUT;
     pSession->mdDefault.flags               = TRDP_FLAGS_NONE;
     pSession->mdDefault.udpPort             = TRDP_MD_UDP_PORT;
     pSession->mdDefault.tcpPort             = TRDP_MD_TCP_PORT;
@@ -555,8 +568,6 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
 
 #if MD_SUPPORT
     trdp_initSockets(pSession->ifaceMD, TRDP_MAX_MD_SOCKET_CNT);
-    /* Initialize pointers to Null in the incomplete message structure */
-    trdp_initUncompletedTCP(pSession);
 #endif
 
     /*    Clear the statistics for this session */
@@ -883,31 +894,68 @@ EXT_DECL TRDP_ERR_T tlc_configSession (
  *
  *  tlc_updateSession signals the end of the set-up phase to the stack. It shall be called after the last publisher
  *  and subscriber was added and will create and compute the index tables to be used by the high-performance targets.
- *  This function is currently a no-op on standard targets.
+ *  Publishers and subscribers added or removed later are entered into or removed from these tables directly, further
+ *  calls are not needed and leave the tables unchanged.
+ *  With TRDP_OPTION_PD_SCHEDULE, the send phases of all cyclic publishers are computed anew over the hyperperiod of
+ *  their intervals (publishers added later are placed without moving the others); the index tables are then used
+ *  for receiving only. Otherwise this function is a no-op on standard targets.
  *
  *  @param[in]      appHandle           The handle returned by tlc_openSession
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_INIT_ERR       not yet inited
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
  *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        out of memory
  */
 EXT_DECL TRDP_ERR_T tlc_updateSession (
-    TRDP_APP_SESSION_T appHandle __unused)
+    TRDP_APP_SESSION_T appHandle)
 {
     TRDP_ERR_T ret = TRDP_NO_ERR;
 
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (appHandle->option & TRDP_OPTION_PD_SCHEDULE)
+    {
+        ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutexTxPD);
+        if (ret == TRDP_NO_ERR)
+        {
+            trdp_pdShardLockAll(appHandle);
+            ret = trdp_pdScheduleAll(appHandle);
+            trdp_pdShardUnlockAll(appHandle);
+            (void) vos_mutexUnlock(appHandle->mutexTxPD);
+        }
+    }
+
 #ifdef HIGH_PERF_INDEXED
 
     /*  Stop any ongoing communication by getting the mutexes */
 
-    ret = trdp_getAccess(appHandle, FALSE);
+    if (ret == TRDP_NO_ERR)
+    {
+        ret = trdp_getAccess(appHandle, FALSE);
+    }
 
     if (ret == TRDP_NO_ERR)
     {
-        ret = trdp_indexCreatePubTables(appHandle);
-        if (ret == TRDP_NO_ERR)
+        /* Once created, the tables are kept up to date by publish/subscribe, unpublish/unsubscribe */
+        if (appHandle->pSlot->tablesValid == FALSE)
         {
-            ret = trdp_indexCreateSubTables(appHandle);
+            if (!(appHandle->option & TRDP_OPTION_PD_SCHEDULE))
+            {
+                ret = trdp_indexCreatePubTables(appHandle);
+            }
+            if (ret == TRDP_NO_ERR)
+            {
+                ret = trdp_indexCreateSubTables(appHandle);
+            }
+            if (ret == TRDP_NO_ERR)
+            {
+                appHandle->pSlot->tablesValid = TRUE;
+            }
         }
         trdp_releaseAccess(appHandle);
     }
@@ -922,6 +970,8 @@ EXT_DECL TRDP_ERR_T tlc_updateSession (
  *
  *  tlc_presetIndexSession allows to preallocate the table sizes in HIGH_PERF_INDEXED mode.
  *  If no table sizes are provided, the default sizes are used. In normal mode, this is a no-op.
+ *  Presetting is optional: tlc_updateSession computes the depths the publishers need and enlarges smaller tables.
+ *  tlc_getIndexStatistics reports the sizes needed by a given configuration.
  *  This function should be called during initialisation stage, e.g. right after a session has been opened.
  *
  *  @param[in]      appHandle           The handle returned by tlc_openSession
@@ -973,6 +1023,51 @@ EXT_DECL TRDP_ERR_T tlc_presetIndexSession (
     return ret;
 } /* lint !w438 return value not used */
 
+/**********************************************************************************************************************/
+/** Get the occupation of the index tables of a session.
+ *
+ *  tlc_getIndexStatistics reports per time slot the number of telegrams and bytes sent, the depth histogram and the
+ *  worst case bytes per send cycle of the HIGH_PERF_INDEXED index tables. requiredSizes holds the table sizes the
+ *  current publishers and subscribers need and can be used for tlc_presetIndexSession.
+ *  Sending and receiving is blocked while the statistics are collected. In normal mode, the statistics are all zero.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the statistics to fill
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getIndexStatistics (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_IDX_STATISTICS_T   *pStatistics)
+{
+    TRDP_ERR_T ret = TRDP_NO_ERR;
+
+    if (pStatistics == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    memset(pStatistics, 0, sizeof(TRDP_IDX_STATISTICS_T));
+
+#ifdef HIGH_PERF_INDEXED
+    ret = trdp_getAccess(appHandle, FALSE);
+
+    if (ret == TRDP_NO_ERR)
+    {
+        trdp_indexStatistics(appHandle, pStatistics);
+        trdp_releaseAccess(appHandle);
+    }
+#endif
+
+    return ret;
+}
+
 /**********************************************************************************************************************/
 /** Close a session.
  *  Clean up and release all resources of that session
@@ -982,6 +1077,9 @@ EXT_DECL TRDP_ERR_T tlc_presetIndexSession (
  *  @retval         TRDP_NO_ERR           no error
  *  @retval         TRDP_NOINIT_ERR       handle invalid
  *  @retval         TRDP_PARAM_ERR        handle NULL
+ *  @retval         TRDP_MUTEX_ERR        mutex error while stopping the PD sender threads, see TRDP_THREAD_ERR
+ *  @retval         TRDP_THREAD_ERR       a PD sender thread did not stop: the handle is invalid, but the memory
+ *                                        of the session is not released, the sender might still use it
  */
 
 EXT_DECL TRDP_ERR_T tlc_closeSession (
@@ -1037,6 +1135,21 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
         {
             pSession = (TRDP_SESSION_PT) appHandle;
 
+            /*    The reactor, the PD senders and the MD worker must leave before we lock the session    */
+            trdp_runDeInit(pSession);
+            ret = trdp_pdStopSenders(pSession);
+#if MD_SUPPORT
+            trdp_mdStopWorker(pSession);
+#endif
+
+            if (ret != TRDP_NO_ERR)
+            {
+                /*    A sender still uses the publishers and the session: leave them allocated    */
+                vos_printLog(VOS_LOG_ERROR, "PD senders did not stop, session memory not released (%s)\n",
+                             vos_getErrorString((VOS_ERR_T)ret));
+                return ret;
+            }
+
             /*    Take the session mutex to prevent someone sitting on the branch while we cut it,
                     in case we can force leaving... */
             ret = trdp_getAccess(pSession, TRUE);
@@ -1051,6 +1164,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
 #ifdef HIGH_PERF_INDEXED
                 trdp_indexDeInit(pSession);
 #endif
+                trdp_pdScheduleDeInit(pSession);
                 /*    Release all allocated sockets and memory    */
                 vos_memFree(pSession->pNewFrame);
 
@@ -1104,6 +1218,12 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     pSession->pMDRcvEle = NULL;
                 }
 
+                /*    Hand back payloads and buffers still queued on TCP sockets    */
+                trdp_mdReleaseSocketQueues(pSession);
+
+                /*    Drop completions of asynchronous requests not fetched    */
+                trdp_mdCloseCompletions(pSession);
+
                 /*    Release all allocated sockets and memory    */
                 while (pSession->pMDSndQueue != NULL)
                 {
@@ -1346,7 +1466,11 @@ EXT_DECL TRDP_ERR_T tlc_getInterval (
                 trdp_pdCheckPending(appHandle, pFileDesc, pNoDesc, TRUE);
 
 #if MD_SUPPORT
-                trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc);
+                if (appHandle->pMDWorker == NULL)
+                {
+                    trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc);
+                    trdp_mdNextJob(appHandle, &now, &appHandle->nextJob);
+                }
 #endif
 
                 /*    if next job time is known, return the time-out value to the caller   */
@@ -1378,6 +1502,80 @@ EXT_DECL TRDP_ERR_T tlc_getInterval (
 }
 #endif
 
+/**********************************************************************************************************************/
+/** Get the time of the next event of a session.
+ *  Returns the absolute time (vos_getTime() clock) at which the earliest PD receive time-out expires, the next
+ *  PD telegram has to be sent or the next MD time-out expires, whichever comes first. Until then, the session
+ *  needs no processing unless a packet arrives. Telegrams sent from the index tables (HIGH_PERF_INDEXED) are due
+ *  with the next process cycle, or with their scheduled send time if TRDP_OPTION_PD_SCHEDULE is set. Telegrams of
+ *  PD sender threads and MD handled by the MD worker thread are not included.
+ *  Together with a timer (see vos_sockSetTimer()), this allows to wait without a fixed cycle.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[out]     pDeadline          pointer to the time of the next event, cleared if there is none
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_PARAM_ERR     parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getNextDeadline (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TIME_T         *pDeadline)
+{
+    TRDP_TIME_T now;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (pDeadline == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    vos_getTime(&now);
+    vos_clearTime(pDeadline);
+
+    if (vos_mutexLock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    trdp_pdNextTimeout(appHandle, pDeadline);
+    (void) vos_mutexUnlock(appHandle->mutexRxPD);
+
+    if (vos_mutexLock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+#ifdef HIGH_PERF_INDEXED
+    /* as tlp_processSend() decides: the schedule, the index tables or the send queue */
+    if (!(appHandle->option & TRDP_OPTION_PD_SCHEDULE) &&
+        (appHandle->pSlot != NULL) && (appHandle->pSlot->processCycle != 0u))
+    {
+        trdp_indexNextSend(appHandle, pDeadline);
+    }
+    else
+#endif
+    {
+        trdp_pdNextSend(appHandle, &now, pDeadline);
+    }
+    (void) vos_mutexUnlock(appHandle->mutexTxPD);
+
+#if MD_SUPPORT
+    if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (appHandle->pMDWorker == NULL)
+    {
+        trdp_mdNextJob(appHandle, &now, pDeadline);
+    }
+    (void) vos_mutexUnlock(appHandle->mutexMD);
+#endif
+
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Work loop of the TRDP handler.
  *    Search the queue for pending PDs and MDs to be sent
@@ -1477,7 +1675,8 @@ EXT_DECL TRDP_ERR_T tlc_process (
 
 #if MD_SUPPORT
 
-        if (vos_mutexLock(appHandle->mutexMD) == VOS_NO_ERR)
+        /*  MD is left to the worker thread, if there is one   */
+        if ((appHandle->pMDWorker == NULL) && (vos_mutexLock(appHandle->mutexMD) == VOS_NO_ERR))
         {
             err = trdp_mdSend(appHandle);
             if (err != TRDP_NO_ERR)
@@ -1515,6 +1714,84 @@ EXT_DECL TRDP_ERR_T tlc_process (
 }
 #endif
 
+/**********************************************************************************************************************/
+/** Process a session in the calling thread until tlc_stopRun() is called.
+ *  Replaces the application loop of tlc_getInterval(), vos_select() and tlc_process() (or tlp_processSend(),
+ *  tlp_processReceive() and tlm_process()), do not use those for this session at the same time.
+ *  The reactor waits until a packet arrives or the next telegram or time-out is due and then processes, by priority:
+ *  PD sending, PD reception and MD. PD reception and MD stop between two packets when their budget is spent or a
+ *  PD telegram has to be sent, the rest follows in the next cycle. PD sending is never interrupted. Time-outs are
+ *  always checked. MD queued by other threads wakes the reactor up. MD is left out while an MD worker is running.
+ *  All callbacks are called in the context of the calling thread.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[in]      pConfig            Time budgets per class and max. wait time, NULL: no budgets, wait max. 1s
+ *
+ *  @retval         TRDP_NO_ERR        stopped by tlc_stopRun() or tlc_closeSession()
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_STATE_ERR     the session is already run by another thread
+ *  @retval         TRDP_MEM_ERR       out of memory
+ *  @retval         TRDP_MUTEX_ERR     session mutex failed
+ */
+EXT_DECL TRDP_ERR_T tlc_run (
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_RUN_CONFIG_T *pConfig)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    return trdp_run(appHandle, pConfig);
+}
+
+/**********************************************************************************************************************/
+/** Ask tlc_run() to return.
+ *  May be called from any thread, also from a callback. Does not wait until tlc_run() returned.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_stopRun (
+    TRDP_APP_SESSION_T appHandle)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    trdp_runStop(appHandle);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the statistics of the current or last tlc_run() of a session.
+ *  Cycles, max. delay of PD sending behind its due time and per class the number of runs, the longest run,
+ *  the runs over budget and the runs stopped at a preemption point.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[out]     pStatistics        Pointer to the statistics, cleared if the session was never run
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_PARAM_ERR     parameter error
+ *  @retval         TRDP_MUTEX_ERR     session mutex failed
+ */
+EXT_DECL TRDP_ERR_T tlc_getRunStatistics (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_RUN_STATISTICS_T   *pStatistics)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (pStatistics == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    return trdp_runGetStatistics(appHandle, pStatistics);
+}
+
 /**********************************************************************************************************************/
 /** Return a human readable version representation.
  *    Return string in the form 'v.r.u.b'
@@ -17,6 +17,12 @@
 /*
 * $Id$
 *
+*      AG 2026-10-18: tlm_confirmReply(), Mq replies of aggregated requests confirmed per source
+*      AG 2026-10-18: tlm_replyTimeout() shared by the request functions
+*      AG 2026-10-18: tlm_startWorker(), tlm_stopWorker(): optional MD worker thread
+*      AG 2026-10-18: tlm_requestAggregate()
+*      AG 2026-10-18: tlm_requestAsync(), tlm_getCompletionDesc(), tlm_getCompletion(), tlm_releaseCompletion()
+*      AG 2026-10-18: tlm_getInterval() returns the time to the next MD time-out, up to TRDP_MD_MAN_CYCLE_TIME
 *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
 *     AHW 2021-05-26: Ticket #370 Number of Listeners in MD statistics not counted correctly
 *      BL 2020-09-08: Ticket #343 userStatus parameter size in tlm_reply and tlm_replyQuery
@@ -66,6 +72,29 @@ extern "C" {
  * LOCAL FUNCTIONS
  */
 
+/**********************************************************************************************************************/
+/** Reply timeout of a request as handed to trdp_mdCall()
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      replyTimeout        timeout given by the application
+ *
+ *  @retval         session default for 0, 0 for TRDP_INFINITE_TIMEOUT, replyTimeout otherwise
+ */
+static UINT32 tlm_replyTimeout (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              replyTimeout)
+{
+    if ( replyTimeout == 0U )
+    {
+        return appHandle->mdDefault.replyTimeout;
+    }
+    if ( replyTimeout == TRDP_INFINITE_TIMEOUT)
+    {
+        return 0U;
+    }
+    return replyTimeout;
+}
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -74,6 +103,9 @@ extern "C" {
 /** Get the lowest time interval for MDs.
  *  Return the maximum time interval suitable for 'select()' so that we
  *    can report time outs to the higher layer.
+ *    The interval ends at the next MD time-out, but is never longer than TRDP_MD_MAN_CYCLE_TIME, as messages
+ *    queued by other threads do not wake the application loop up.
+ *    If the MD worker thread is running, MD needs no cycle at all.
  *
  *  @param[in]      appHandle          The handle returned by tlc_openSession
  *  @param[out]     pInterval          pointer to needed interval
@@ -89,7 +121,9 @@ EXT_DECL TRDP_ERR_T tlm_getInterval (
     TRDP_FDS_T          *pFileDesc,
     TRDP_SOCK_T         *pNoDesc)
 {
-    TRDP_ERR_T ret = TRDP_NOINIT_ERR;
+    TRDP_ERR_T  ret = TRDP_NOINIT_ERR;
+    TRDP_TIME_T now;
+    TRDP_TIME_T nextJob;
 
     if (trdp_isValidSession(appHandle))
     {
@@ -109,12 +143,32 @@ EXT_DECL TRDP_ERR_T tlm_getInterval (
             }
             else
             {
-                trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc);
-
                 /*  Return a time-out value to the caller   */
                 pInterval->tv_sec   = 0u;                       /* if no timeout is set             */
                 pInterval->tv_usec  = TRDP_MD_MAN_CYCLE_TIME;   /* Application should limit this    */
 
+                /*  The worker thread waits for the MD sockets itself   */
+                if (appHandle->pMDWorker == NULL)
+                {
+                    trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc);
+
+                    vos_getTime(&now);
+                    vos_clearTime(&nextJob);
+                    trdp_mdNextJob(appHandle, &now, &nextJob);
+                    if (timerisset(&nextJob) && (vos_cmpTime(&nextJob, &now) > 0))
+                    {
+                        vos_subTime(&nextJob, &now);
+                        if (vos_cmpTime(&nextJob, pInterval) < 0)
+                        {
+                            *pInterval = nextJob;
+                        }
+                    }
+                    else if (timerisset(&nextJob))
+                    {
+                        pInterval->tv_usec = 0;                 /* time-out is over                 */
+                    }
+                }
+
                 if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
                 {
                     vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -155,6 +209,14 @@ EXT_DECL TRDP_ERR_T tlm_process (
     {
         return TRDP_NOINIT_ERR;
     }
+    else if (appHandle->pMDWorker != NULL)
+    {
+        /*  MD is processed by the worker thread    */
+        if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
     else
     {
         /******************************************************
@@ -194,6 +256,55 @@ EXT_DECL TRDP_ERR_T tlm_process (
     return result;
 }
 
+/**********************************************************************************************************************/
+/** Start a dedicated MD worker thread for the session.
+ *  From now on the worker sends, receives and supervises all MD of the session: tlm_process() returns at once,
+ *  tlm_getInterval() and tlc_getInterval() leave out the MD sockets and tlc_process() handles PD only.
+ *  Messages queued by tlm_request(), tlm_notify(), tlm_reply() or tlm_confirm() wake the worker up at once,
+ *  their latency no longer depends on the cycle of the application loop.
+ *  All MD callbacks are called in the context of the worker thread.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[in]      priority           Thread priority (0 = default, 1...255 (highest))
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_STATE_ERR     worker already running
+ *  @retval         TRDP_MEM_ERR       out of memory
+ *  @retval         TRDP_THREAD_ERR    thread could not be created
+ */
+EXT_DECL TRDP_ERR_T tlm_startWorker (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT8               priority)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    return trdp_mdStartWorker(appHandle, priority);
+}
+
+/**********************************************************************************************************************/
+/** Stop the MD worker thread of the session.
+ *  MD has to be processed by tlm_process() or tlc_process() again. tlc_closeSession() stops the worker as well.
+ *  Must not be called from an MD callback.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlm_stopWorker (
+    TRDP_APP_SESSION_T  appHandle)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    trdp_mdStopWorker(appHandle);
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Initiate sending MD notification message.
  *  Send a MD notification message
@@ -270,7 +381,9 @@ EXT_DECL TRDP_ERR_T tlm_notify (
                pData,
                dataSize,
                srcURI,
-               destURI
+               destURI,
+               NULL,                                           /* callback mode */
+               NULL                                            /* no aggregation */
                );
 }
 
@@ -321,8 +434,6 @@ EXT_DECL TRDP_ERR_T tlm_request (
     const TRDP_URI_USER_T   srcURI,
     const TRDP_URI_USER_T   destURI)
 {
-    UINT32 mdTimeOut;
-
     if ( !trdp_isValidSession(appHandle))
     {
         return TRDP_NOINIT_ERR;
@@ -333,19 +444,6 @@ EXT_DECL TRDP_ERR_T tlm_request (
         return TRDP_PARAM_ERR;
     }
 
-    if ( replyTimeout == 0U )
-    {
-        mdTimeOut = appHandle->mdDefault.replyTimeout;
-    }
-    else if ( replyTimeout == TRDP_INFINITE_TIMEOUT)
-    {
-        mdTimeOut = 0;
-    }
-    else
-    {
-        mdTimeOut = replyTimeout;
-    }
-
     if ( !trdp_validTopoCounters( appHandle->etbTopoCnt,
                                   appHandle->opTrnTopoCnt,
                                   etbTopoCnt,
@@ -368,18 +466,317 @@ EXT_DECL TRDP_ERR_T tlm_request (
                    destIpAddr,
                    pktFlags,
                    numReplies,
-                   mdTimeOut,
+                   tlm_replyTimeout(appHandle, replyTimeout),
                    TRDP_REPLY_OK,                                         /* reply state */
                    pSendParam,
                    pData,
                    dataSize,
                    srcURI,
-                   destURI
+                   destURI,
+                   NULL,                                                  /* callback mode */
+                   NULL                                                   /* no aggregation */
                    );
     }
 }
 
 
+/**********************************************************************************************************************/
+/** Initiate sending MD request message, replies collected into one result set.
+ *  Intended for multicast requests to many repliers: instead of one callback per reply, pfCbFunction is called
+ *  once, when numReplies distinct repliers have answered or the reply timeout expired.
+ *  Repeated replies from the same source are dropped and counted. Each reply carries its latency.
+ *  Replies requesting confirmation (Mq) are collected, too; confirm them from within the callback, all at once by
+ *  tlm_confirm() or each one by tlm_confirmReply() with the source of the reply.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pUserRef            user supplied value returned with the result set
+ *  @param[in]      pfCbFunction        callback receiving the result set
+ *  @param[out]     pSessionId          return session ID, NULL if not needed
+ *  @param[in]      comId               comId of packet to be sent
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
+ *  @param[in]      destIpAddr          where to send the packet to
+ *  @param[in]      pktFlags            OPTION:
+ *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL
+ *  @param[in]      numReplies          number of expected replies, 0 if unknown
+ *  @param[in]      replyTimeout        timeout for reply
+ *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
+ *  @param[in]      pData               pointer to packet data / dataset
+ *  @param[in]      dataSize            size of packet data
+ *  @param[in]      srcURI              only functional group of source URI
+ *  @param[in]      destURI             only functional group of destination URI
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlm_requestAggregate (
+    TRDP_APP_SESSION_T              appHandle,
+    void                            *pUserRef,
+    TRDP_MD_AGGREGATE_CALLBACK_T    pfCbFunction,
+    TRDP_UUID_T                     *pSessionId,
+    UINT32                          comId,
+    UINT32                          etbTopoCnt,
+    UINT32                          opTrnTopoCnt,
+    TRDP_IP_ADDR_T                  srcIpAddr,
+    TRDP_IP_ADDR_T                  destIpAddr,
+    TRDP_FLAGS_T                    pktFlags,
+    UINT32                          numReplies,
+    UINT32                          replyTimeout,
+    const TRDP_SEND_PARAM_T         *pSendParam,
+    const UINT8                     *pData,
+    UINT32                          dataSize,
+    const TRDP_URI_USER_T           srcURI,
+    const TRDP_URI_USER_T           destURI)
+{
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (((pData == NULL) && (dataSize != 0u))
+        || (dataSize > TRDP_MAX_MD_DATA_SIZE)
+        || (pfCbFunction == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if ( !trdp_validTopoCounters( appHandle->etbTopoCnt,
+                                  appHandle->opTrnTopoCnt,
+                                  etbTopoCnt,
+                                  opTrnTopoCnt))
+    {
+        return TRDP_TOPO_ERR;
+    }
+    return trdp_mdCall(
+               TRDP_MSG_MR,                                           /* request with reply */
+               appHandle,
+               pUserRef,
+               NULL,                                                  /* result set instead of callback */
+               pSessionId,
+               comId,
+               etbTopoCnt,
+               opTrnTopoCnt,
+               srcIpAddr,
+               destIpAddr,
+               pktFlags,
+               numReplies,
+               tlm_replyTimeout(appHandle, replyTimeout),
+               TRDP_REPLY_OK,                                         /* reply state */
+               pSendParam,
+               pData,
+               dataSize,
+               srcURI,
+               destURI,
+               NULL,                                                  /* not queued */
+               pfCbFunction
+               );
+}
+
+
+/**********************************************************************************************************************/
+/** Initiate sending MD request message without callback.
+ *  Like tlm_request(), but the outcome is not reported by a callback: every reply and the final
+ *  timeout or error are queued as TRDP_MD_COMPLETION_T and fetched with tlm_getCompletion().
+ *  Any number of requests may be outstanding.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pUserRef            user supplied value returned with the completion
+ *  @param[out]     pSessionId          return session ID, NULL if not needed
+ *  @param[in]      comId               comId of packet to be sent
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
+ *  @param[in]      destIpAddr          where to send the packet to
+ *  @param[in]      pktFlags            OPTION:
+ *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL
+ *  @param[in]      numReplies          number of expected replies, 0 if unknown
+ *  @param[in]      replyTimeout        timeout for reply
+ *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
+ *  @param[in]      pData               pointer to packet data / dataset
+ *  @param[in]      dataSize            size of packet data
+ *  @param[in]      srcURI              only functional group of source URI
+ *  @param[in]      destURI             only functional group of destination URI
+ *  @param[out]     pHandle             handle identifying the completions of this request
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlm_requestAsync (
+    TRDP_APP_SESSION_T      appHandle,
+    void                    *pUserRef,
+    TRDP_UUID_T             *pSessionId,
+    UINT32                  comId,
+    UINT32                  etbTopoCnt,
+    UINT32                  opTrnTopoCnt,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          destIpAddr,
+    TRDP_FLAGS_T            pktFlags,
+    UINT32                  numReplies,
+    UINT32                  replyTimeout,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    const UINT8             *pData,
+    UINT32                  dataSize,
+    const TRDP_URI_USER_T   srcURI,
+    const TRDP_URI_USER_T   destURI,
+    TRDP_MD_HANDLE_T        *pHandle)
+{
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (((pData == NULL) && (dataSize != 0u))
+        || (dataSize > TRDP_MAX_MD_DATA_SIZE)
+        || (pHandle == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if ( !trdp_validTopoCounters( appHandle->etbTopoCnt,
+                                  appHandle->opTrnTopoCnt,
+                                  etbTopoCnt,
+                                  opTrnTopoCnt))
+    {
+        return TRDP_TOPO_ERR;
+    }
+    return trdp_mdCall(
+               TRDP_MSG_MR,                                           /* request with reply */
+               appHandle,
+               pUserRef,
+               NULL,                                                  /* completions instead of callback */
+               pSessionId,
+               comId,
+               etbTopoCnt,
+               opTrnTopoCnt,
+               srcIpAddr,
+               destIpAddr,
+               pktFlags,
+               numReplies,
+               tlm_replyTimeout(appHandle, replyTimeout),
+               TRDP_REPLY_OK,                                         /* reply state */
+               pSendParam,
+               pData,
+               dataSize,
+               srcURI,
+               destURI,
+               pHandle,
+               NULL                                                   /* no aggregation */
+               );
+}
+
+/**********************************************************************************************************************/
+/** Get the descriptor signalling completions of asynchronous requests.
+ *  The descriptor becomes readable when a completion is queued; add it to the select/poll set
+ *  and call tlm_getCompletion() until it returns TRDP_NODATA_ERR.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pDesc               readable descriptor
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_SOCK_ERR       the target has no events, tlm_getCompletion() must be polled
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlm_getCompletionDesc (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SOCK_T         *pDesc)
+{
+    TRDP_ERR_T err;
+
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (pDesc == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+
+    err = trdp_mdOpenCompletions(appHandle);
+    if (err == TRDP_NO_ERR)
+    {
+        if (appHandle->pMDCompletions->hasEvent == TRUE)
+        {
+            *pDesc = appHandle->pMDCompletions->event.rdSock;
+        }
+        else
+        {
+            err = TRDP_SOCK_ERR;
+        }
+    }
+
+    if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Fetch the next completion of an asynchronous request.
+ *  Lock-free, but only one thread may fetch completions of a session. It must not be called from an MD callback.
+ *  The completion's data must be handed back with tlm_releaseCompletion().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pCompletion         the completion
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NODATA_ERR     no completion pending
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlm_getCompletion (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_MD_COMPLETION_T    *pCompletion)
+{
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (pCompletion == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    return trdp_mdGetCompletion(appHandle, pCompletion);
+}
+
+/**********************************************************************************************************************/
+/** Release the data of a completion fetched by tlm_getCompletion().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pCompletion         the completion, its data pointer is cleared
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlm_releaseCompletion (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_MD_COMPLETION_T    *pCompletion)
+{
+    (void) appHandle;
+
+    if (pCompletion == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (pCompletion->pData != NULL)
+    {
+        vos_memFree(pCompletion->pData);
+        pCompletion->pData = NULL;
+    }
+    pCompletion->dataSize = 0u;
+    return TRDP_NO_ERR;
+}
+
+
 /**********************************************************************************************************************/
 /** Subscribe to MD messages.
  *  Add a listener to TRDP to get notified when messages are received
@@ -549,6 +946,9 @@ EXT_DECL TRDP_ERR_T  tlm_addListener (
         pNewElement = NULL;
     }
 
+    /* A worker thread has to watch the new socket */
+    trdp_mdWakeWorker(appHandle);
+
     /* Release mutex */
     if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
     {
@@ -659,6 +1059,9 @@ EXT_DECL TRDP_ERR_T tlm_delListener (
 
             /* free memory space for element */
             vos_memFree(pDelete);
+
+            /* A worker thread must stop watching the socket */
+            trdp_mdWakeWorker(appHandle);
         }
     }
 
@@ -825,7 +1228,78 @@ EXT_DECL TRDP_ERR_T tlm_reply (
                         pSendParam,
                         pData,
                         dataSize,
-                        srcURI);
+                        srcURI,
+                        NULL);
+}
+
+
+/**********************************************************************************************************************/
+/** Send a MD reply message without copying the payload.
+ *  Like tlm_reply(), but the payload stays in the application's buffer until it was handed to the network.
+ *  Over TCP the buffer is sent behind the header by a single gather write; payloads of at least
+ *  TRDP_MD_ZEROCOPY_MIN_SIZE bytes are transmitted zero-copy where the target supports it.
+ *  pfRelease is called from within tlm_process() once the buffer is not referenced anymore, or immediately
+ *  if the payload had to be copied (UDP, marshalling). The buffer must not be changed until then.
+ *  On error the buffer is not taken over and pfRelease is not called.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pSessionId          Session ID returned by indication
+ *  @param[in]      comId               comId of packet to be sent
+ *  @param[in]      userStatus          Info for requester about application errors
+ *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
+ *  @param[in]      pData               pointer to packet data / dataset
+ *  @param[in]      dataSize            size of packet data
+ *  @param[in]      srcURI              only functional group of source URI, set to NULL if not used
+ *  @param[in]      pfRelease           called when the buffer is not used anymore, may be NULL
+ *  @param[in]      pRefCon             user context passed to pfRelease
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        Out of memory
+ *  @retval         TRDP_NO_SESSION_ERR no such session
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlm_replyNoCopy (
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_UUID_T       *pSessionId,
+    UINT32                  comId,
+    UINT32                  userStatus,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    const UINT8             *pData,
+    UINT32                  dataSize,
+    const CHAR8             *srcURI,
+    TRDP_MD_RELEASE_T       pfRelease,
+    void                    *pRefCon)
+{
+    TRDP_MD_EXT_DATA_T extData;
+
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (((pData == NULL) && (dataSize != 0u)) ||
+        (dataSize > TRDP_MAX_MD_DATA_SIZE) ||
+        (userStatus > 0x7FFFFFFF))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    memset(&extData, 0, sizeof(extData));
+    extData.pData       = pData;
+    extData.dataSize    = dataSize;
+    extData.pfRelease   = pfRelease;
+    extData.pRefCon     = pRefCon;
+
+    return trdp_mdReply(TRDP_MSG_MP,
+                        appHandle,
+                        (UINT8 *)pSessionId,
+                        comId,
+                        0u,
+                        (INT32)userStatus,
+                        pSendParam,
+                        pData,
+                        dataSize,
+                        srcURI,
+                        &extData);
 }
 
 
@@ -895,7 +1369,8 @@ EXT_DECL TRDP_ERR_T tlm_replyQuery (
                         pSendParam,
                         pData,
                         dataSize,
-                        srcURI);
+                        srcURI,
+                        NULL);
 }
 
 
@@ -903,6 +1378,7 @@ EXT_DECL TRDP_ERR_T tlm_replyQuery (
 /** Initiate sending MD confirm message.
  *  Send a MD confirmation message
  *  User reference, source and destination IP addresses as well as topo counts and packet flags are taken from the session
+ *  For an aggregated request, every Mq reply of the result set not yet confirmed is confirmed.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
  *  @param[in]      pSessionId          Session ID returned by request
@@ -925,7 +1401,42 @@ EXT_DECL TRDP_ERR_T tlm_confirm (
     {
         return TRDP_NOINIT_ERR;
     }
-    return trdp_mdConfirm(appHandle, pSessionId, userStatus, pSendParam);
+    return trdp_mdConfirm(appHandle, pSessionId, 0u, userStatus, pSendParam);
+}
+
+/**********************************************************************************************************************/
+/** Initiate sending MD confirm message to one replier.
+ *  Like tlm_confirm(), but for the reply from srcIpAddr only. Meant for aggregated requests, where each Mq reply
+ *  of the result set (TRDP_MD_REPLY_T.srcIpAddr) needs a confirmation of its own.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pSessionId          Session ID returned by request
+ *  @param[in]      srcIpAddr           source of the reply to be confirmed
+ *  @param[in]      userStatus          Info for requester about application errors
+ *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOSESSION_ERR  no such session or no reply query from srcIpAddr to confirm
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlm_confirmReply (
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_UUID_T       *pSessionId,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    UINT16                  userStatus,
+    const TRDP_SEND_PARAM_T *pSendParam)
+{
+    if ( !trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (srcIpAddr == 0u)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    return trdp_mdConfirm(appHandle, pSessionId, srcIpAddr, userStatus, pSendParam);
 }
 
 /**********************************************************************************************************************/
@@ -17,6 +17,11 @@
 /*
 * $Id$*
 *
+*      AG 2026-10-18: tlp_putEncoded() marshalls a PD with a given function straight into the frame
+*      AG 2026-10-18: tlp_startSenders(), tlp_stopSenders(): cyclic publishers sent by sender threads
+*      AG 2026-10-18: TRDP_OPTION_PD_SCHEDULE: publishers are placed into the hyperperiod schedule instead of traffic shaping
+*      AG 2026-10-18: HIGH_PERF_INDEXED: publishers and subscribers are entered into existing index tables incrementally
+*      AG 2026-10-18: tlp_getDecoded() converts a received PD with a given function, e.g. single dataset elements
 *      A 2023-01-13: Ticket #412 Added tlp_republishService
 *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
 *     AHW 2022-03-24: Ticket #391 Allow PD request without reply
@@ -52,10 +57,12 @@
 #include "tlc_if.h"
 #include "trdp_utils.h"
 #include "trdp_pdcom.h"
+#include "trdp_pdshard.h"
 #include "trdp_stats.h"
 #include "vos_sock.h"
 #include "vos_mem.h"
 #include "vos_utils.h"
+#include "trdp_pdsched.h"
 
 #ifdef HIGH_PERF_INDEXED
 #include "trdp_pdindex.h"
@@ -269,8 +276,13 @@ EXT_DECL TRDP_ERR_T tlp_processSend (
          ******************************************************/
 
 #ifdef HIGH_PERF_INDEXED
-        if ((appHandle->pSlot == NULL) ||
-            (appHandle->pSlot->processCycle == 0u))
+        if (appHandle->option & TRDP_OPTION_PD_SCHEDULE)
+        {
+            /* The schedule replaces the index tables: send times are kept per telegram */
+            err = trdp_pdSendQueued(appHandle);
+        }
+        else if ((appHandle->pSlot == NULL) ||
+                 (appHandle->pSlot->processCycle == 0u))
         {
             static int count = 5000;
             err = trdp_pdSendQueued(appHandle);
@@ -303,6 +315,60 @@ EXT_DECL TRDP_ERR_T tlp_processSend (
     return result;
 }
 
+/**********************************************************************************************************************/
+/** Start sender threads for the cyclic publishers of the session.
+ *  The cyclic publishers are partitioned into noOfSenders shares of about equal byte rate, publishers published later
+ *  are added to the share with the least load. Each share is sent by its own thread on its own sockets every process
+ *  cycle (cycleTime of the process configuration, 1ms if not set). The intervals of the telegrams are kept.
+ *  tlp_processSend() and tlc_process() go on sending PD requests, PULL replies and telegrams without interval.
+ *  Send callbacks (TRDP_FLAGS_CALLBACK) of sharded publishers are called in the context of their sender thread.
+ *  The packets sent by the threads are counted in the session statistics.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[in]      noOfSenders        Number of sender threads (1...TRDP_MAX_PD_SENDERS)
+ *  @param[in]      priority           Thread priority (0 = default, 1...255 (highest))
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_PARAM_ERR     number of senders out of range
+ *  @retval         TRDP_STATE_ERR     senders already running
+ *  @retval         TRDP_MEM_ERR       out of memory
+ *  @retval         TRDP_THREAD_ERR    thread could not be created
+ */
+EXT_DECL TRDP_ERR_T tlp_startSenders (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              noOfSenders,
+    UINT8               priority)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    return trdp_pdStartSenders(appHandle, noOfSenders, priority);
+}
+
+/**********************************************************************************************************************/
+/** Stop the sender threads of the session.
+ *  All publishers are sent by tlp_processSend() again. tlc_closeSession() stops the senders as well.
+ *  Must not be called from a PD callback.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_MUTEX_ERR     mutex error
+ *  @retval         TRDP_THREAD_ERR    a sender did not stop in time, the call may be repeated
+ */
+EXT_DECL TRDP_ERR_T tlp_stopSenders (
+    TRDP_APP_SESSION_T  appHandle)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    return trdp_pdStopSenders(appHandle);
+}
+
 /**********************************************************************************************************************/
 /** Do not send non-redundant PDs when we are follower.
  *
@@ -336,6 +402,7 @@ EXT_DECL TRDP_ERR_T tlp_setRedundant (
                     ((0u == redId) || (iterPD->redId == redId)))    /* all set redundant ID are targeted if redId == 0
                                                                      or packet redundant ID matches       */
                 {
+                    trdp_pdShardLock(iterPD);
                     if (TRUE == leader)
                     {
                         iterPD->privFlags = (TRDP_PRIV_FLAGS_T) (iterPD->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_REDUNDANT);
@@ -345,6 +412,7 @@ EXT_DECL TRDP_ERR_T tlp_setRedundant (
                     {
                         iterPD->privFlags |= TRDP_REDUNDANT;
                     }
+                    trdp_pdShardUnlock(iterPD);
                     found = TRUE;
                 }
             }
@@ -701,12 +769,32 @@ EXT_DECL TRDP_ERR_T tlp_publish (
                 {
                     ret = tlp_put(appHandle, *pPubHandle, pData, dataSize);
                 }
+                /* The send times of sharded publishers may change */
+                trdp_pdShardLockAll(appHandle);
+                if ((ret == TRDP_NO_ERR) && (appHandle->option & TRDP_OPTION_PD_SCHEDULE))
+                {
+                    /* Place it into the schedule, the phases of the others are kept */
+                    ret = trdp_pdSchedulePub(appHandle, pNewElement);
+                }
 #ifndef HIGH_PERF_INDEXED
-                if ((ret == TRDP_NO_ERR) && (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING))
+                else if ((ret == TRDP_NO_ERR) && (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING))
                 {
                     ret = trdp_pdDistribute(appHandle->pSndQueue);
                 }
+#else
+                else if (ret == TRDP_NO_ERR)
+                {
+                    /* Enter it into the index tables, if they already exist */
+                    ret = trdp_indexAddPub(appHandle, pNewElement);
+                }
 #endif
+                trdp_pdShardUnlockAll(appHandle);
+
+                if (ret == TRDP_NO_ERR)
+                {
+                    /* Hand it to a sender thread, if they are running */
+                    trdp_pdShardAddPub(appHandle, pNewElement);
+                }
             }
         }
 
@@ -767,6 +855,8 @@ EXT_DECL TRDP_ERR_T tlp_republishService(
         return TRDP_NOINIT_ERR;
     }
 
+    trdp_pdShardLock(pubHandle);
+
     /*  Change the addressing item   */
     pubHandle->addr.srcIpAddr = srcIpAddr;
     pubHandle->addr.destIpAddr = destIpAddr;
@@ -787,6 +877,8 @@ EXT_DECL TRDP_ERR_T tlp_republishService(
     /*    Compute the header fields */
     trdp_pdInit(pubHandle, TRDP_MSG_PD, etbTopoCnt, opTrnTopoCnt, 0u, 0u, pubHandle->addr.serviceId);
 
+    trdp_pdShardUnlock(pubHandle);
+
     if (vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR)
     {
         vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -838,6 +930,8 @@ EXT_DECL TRDP_ERR_T tlp_republish (
         return TRDP_NOINIT_ERR;
     }
 
+    trdp_pdShardLock(pubHandle);
+
     /*  Change the addressing item   */
     pubHandle->addr.srcIpAddr   = srcIpAddr;
     pubHandle->addr.destIpAddr  = destIpAddr;
@@ -857,6 +951,8 @@ EXT_DECL TRDP_ERR_T tlp_republish (
     /*    Compute the header fields */
     trdp_pdInit(pubHandle, TRDP_MSG_PD, etbTopoCnt, opTrnTopoCnt, 0u, 0u, pubHandle->addr.serviceId);
 
+    trdp_pdShardUnlock(pubHandle);
+
     if (vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR)
     {
         vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -903,6 +999,12 @@ EXT_DECL TRDP_ERR_T  tlp_unpublish (
     ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutexTxPD);
     if (ret == TRDP_NO_ERR)
     {
+        trdp_pdShardRemovePub(appHandle, pElement);
+        trdp_pdScheduleRemovePub(appHandle, pElement);
+#ifdef HIGH_PERF_INDEXED
+        /* We must check if this publisher is listed in our indexed arrays */
+        trdp_indexRemovePub(appHandle, pElement);
+#endif
         /*    Remove from queue?    */
         trdp_queueDelElement(&appHandle->pSndQueue, pElement);
         trdp_releaseSocket(appHandle->ifacePD, pElement->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
@@ -916,13 +1018,13 @@ EXT_DECL TRDP_ERR_T  tlp_unpublish (
 
 #ifndef HIGH_PERF_INDEXED
         /* Re-compute distribution times */
-        if (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING)
+        if ((appHandle->option & (TRDP_OPTION_TRAFFIC_SHAPING | TRDP_OPTION_PD_SCHEDULE)) ==
+            TRDP_OPTION_TRAFFIC_SHAPING)
         {
+            trdp_pdShardLockAll(appHandle);
             ret = trdp_pdDistribute(appHandle->pSndQueue);
+            trdp_pdShardUnlockAll(appHandle);
         }
-#else
-        /* We must check if this publisher is listed in our indexed arrays */
-        trdp_indexRemovePub(appHandle, pElement);
 #endif
 
         if (vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR)
@@ -935,23 +1037,22 @@ EXT_DECL TRDP_ERR_T  tlp_unpublish (
 }
 
 /**********************************************************************************************************************/
-/** Update the process data to send.
- *  Update previously published data. The new telegram will be sent earliest when tlc_process is called.
+/** Update the process data to send, common part of tlp_put() and tlp_putEncoded().
  *
  *  @param[in]      appHandle          the handle returned by tlc_openSession
  *  @param[in]      pubHandle          the handle returned by publish
- *  @param[in,out]  pData              pointer to application's data buffer
- *  @param[in,out]  dataSize           size of data
+ *  @param[in]      pfEncode           conversion function, NULL for the session's marshalling
+ *  @param[in]      pEncodeRef         passed to pfEncode
+ *  @param[in]      pData              pointer to application's data buffer
+ *  @param[in]      dataSize           size of data
  *
- *  @retval         TRDP_NO_ERR        no error
- *  @retval         TRDP_PARAM_ERR     parameter error on uninitialized parameter or changed dataSize compared to published one
- *  @retval         TRDP_NOPUB_ERR     not published
- *  @retval         TRDP_NOINIT_ERR    handle invalid
- *  @retval         TRDP_COMID_ERR     ComID not found when marshalling
+ *  @retval         see tlp_put()
  */
-EXT_DECL TRDP_ERR_T tlp_put (
+static TRDP_ERR_T putPd (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_PUB_T          pubHandle,
+    TRDP_MARSHALL_T     pfEncode,
+    void                *pEncodeRef,
     const UINT8         *pData,
     UINT32              dataSize)
 {
@@ -984,16 +1085,20 @@ EXT_DECL TRDP_ERR_T tlp_put (
     }
 #endif
 
+    if (pfEncode == NULL)
+    {
+        pfEncode    = ((pElement->pktFlags & TRDP_FLAGS_MARSHALL) != 0) ? appHandle->marshall.pfCbMarshall : NULL;
+        pEncodeRef  = appHandle->marshall.pRefCon;
+    }
+
     /*    Reserve mutual access    */
     ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutexTxPD);
     if ( ret == TRDP_NO_ERR )
     {
         /*    Find the published queue entry    */
-        ret = trdp_pdPut(pElement,
-                         appHandle->marshall.pfCbMarshall,
-                         appHandle->marshall.pRefCon,
-                         pData,
-                         dataSize);
+        trdp_pdShardLock(pElement);
+        ret = trdp_pdPut(pElement, pfEncode, pEncodeRef, pData, dataSize);
+        trdp_pdShardUnlock(pElement);
 
         if ( vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR )
         {
@@ -1004,6 +1109,63 @@ EXT_DECL TRDP_ERR_T tlp_put (
     return ret;
 }
 
+/**********************************************************************************************************************/
+/** Update the process data to send.
+ *  Update previously published data. The new telegram will be sent earliest when tlc_process is called.
+ *
+ *  @param[in]      appHandle          the handle returned by tlc_openSession
+ *  @param[in]      pubHandle          the handle returned by publish
+ *  @param[in,out]  pData              pointer to application's data buffer
+ *  @param[in,out]  dataSize           size of data
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_PARAM_ERR     parameter error on uninitialized parameter or changed dataSize compared to published one
+ *  @retval         TRDP_NOPUB_ERR     not published
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_COMID_ERR     ComID not found when marshalling
+ */
+EXT_DECL TRDP_ERR_T tlp_put (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    const UINT8         *pData,
+    UINT32              dataSize)
+{
+    return putPd(appHandle, pubHandle, NULL, NULL, pData, dataSize);
+}
+
+/**********************************************************************************************************************/
+/** Update the process data to send, converted by the given function instead of the session's marshalling.
+ *  pfEncode writes the marshalled dataset straight into the frame, whether the publication marshalls or not.
+ *  It finds dataSize bytes of room in pDstSize and returns the marshalled size there.
+ *
+ *  @param[in]      appHandle          the handle returned by tlc_openSession
+ *  @param[in]      pubHandle          the handle returned by publish
+ *  @param[in]      pfEncode           conversion function, called with the session locked
+ *  @param[in]      pEncodeRef         passed to pfEncode as pRefCon
+ *  @param[in]      pData              pointer to application's data buffer
+ *  @param[in]      dataSize           size of data
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_PARAM_ERR     parameter error
+ *  @retval         TRDP_NOPUB_ERR     not published
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         other              errors of pfEncode
+ */
+EXT_DECL TRDP_ERR_T tlp_putEncoded (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    TRDP_MARSHALL_T     pfEncode,
+    void                *pEncodeRef,
+    const UINT8         *pData,
+    UINT32              dataSize)
+{
+    if (pfEncode == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    return putPd(appHandle, pubHandle, pfEncode, pEncodeRef, pData, dataSize);
+}
+
 /**********************************************************************************************************************/
 /** Update and send process data.
  *  Update previously published data. The new telegram will be sent immediatly or at txTime, if txTime != 0 and TSN == 1
@@ -1061,8 +1223,10 @@ EXT_DECL TRDP_ERR_T tlp_putImmediate (
         {
             PD_PACKET_T *pPacket = (PD_PACKET_T *)(pElement->pFrame);
             pTxTime = pTxTime;  /* Unused parameter */
+            trdp_pdShardLock(pElement);
             memcpy(pPacket->data, pData, dataSize);
             err = trdp_pdSendImmediate(appHandle, pElement);
+            trdp_pdShardUnlock(pElement);
             if ( vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR )
             {
                 vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -1299,6 +1463,9 @@ EXT_DECL TRDP_ERR_T tlp_request (
                     vos_getTime(&pSubPD->timeToGo);
                     vos_addTime(&pSubPD->timeToGo, &pSubPD->interval);
                     pSubPD->privFlags &= (unsigned)~TRDP_TIMED_OUT;   /* Reset time out flag (#151) */
+#ifdef HIGH_PERF_INDEXED
+                    trdp_indexSubArmed(appHandle, pSubPD);
+#endif
                 }
             }
         }
@@ -1510,7 +1677,29 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
                     /*  append this subscription to our receive queue */
                     trdp_queueAppLast(&appHandle->pRcvQueue, newPD);
 
-                    *pSubHandle = (TRDP_SUB_T) newPD;
+#ifdef HIGH_PERF_INDEXED
+                    /*  and to the index tables, if they already exist */
+                    ret = trdp_indexAddSub(appHandle, newPD);
+                    if (ret != TRDP_NO_ERR)
+                    {
+                        /*  out of memory: undo the subscription */
+                        TRDP_IP_ADDR_T mcGroup = newPD->addr.mcGroup;
+
+                        trdp_queueDelElement(&appHandle->pRcvQueue, newPD);
+                        if (mcGroup != VOS_INADDR_ANY)
+                        {
+                            mcGroup = trdp_findMCjoins(appHandle, mcGroup);
+                        }
+                        trdp_releaseSocket(appHandle->ifacePD, lIndex, 0u, FALSE, mcGroup);
+                        vos_memFree(newPD->pFrame);
+                        vos_memFree(newPD);
+                        newPD = NULL;
+                    }
+                    else
+#endif
+                    {
+                        *pSubHandle = (TRDP_SUB_T) newPD;
+                    }
                 }
             }
         } /*lint !e438 unused newPD */
@@ -1563,8 +1752,14 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
     if (ret == TRDP_NO_ERR)
     {
         TRDP_IP_ADDR_T mcGroup = pElement->addr.mcGroup;
+
         /*    Remove from queue?    */
         trdp_queueDelElement(&appHandle->pRcvQueue, pElement);
+#ifdef HIGH_PERF_INDEXED
+        /* We must check if this subscriber is listed in our indexed arrays,
+           a rebuild of the tables must not see it in the receive queue anymore */
+        trdp_indexRemoveSub(appHandle, pElement);
+#endif
         /*    if we subscribed to an MC-group, check if anyone else did too: */
         if (mcGroup != VOS_INADDR_ANY)
         {
@@ -1582,11 +1777,6 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
         }
         vos_memFree(pElement);
 
-#ifdef HIGH_PERF_INDEXED
-        /* We must check if this publisher is listed in our indexed arrays */
-        trdp_indexRemoveSub(appHandle, pElement);
-#endif
-
         ret = TRDP_NO_ERR;
         if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
         {
@@ -1703,26 +1893,24 @@ EXT_DECL TRDP_ERR_T tlp_resubscribe (
 
 
 /**********************************************************************************************************************/
-/** Get the last valid PD message.
- *  This allows polling of PDs instead of event driven handling by callbacks
+/** Get the last valid PD message, converted by the session's or the given unmarshalling function.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
  *  @param[in]      subHandle           the handle returned by subscription
  *  @param[in,out]  pPdInfo             pointer to application's info buffer
+ *  @param[in]      pfDecode            conversion function, NULL for the session's marshalling
+ *  @param[in]      pDecodeRef          passed to pfDecode
  *  @param[in,out]  pData               pointer to application's data buffer
  *  @param[in,out]  pDataSize           in: size of buffer, out: size of data
  *
- *  @retval         TRDP_NO_ERR         no error
- *  @retval         TRDP_PARAM_ERR      parameter error
- *  @retval         TRDP_SUB_ERR        not subscribed
- *  @retval         TRDP_TIMEOUT_ERR    packet timed out
- *  @retval         TRDP_NOINIT_ERR     handle invalid
- *  @retval         TRDP_COMID_ERR      ComID not found when marshalling
+ *  @retval         see tlp_get()
  */
-EXT_DECL TRDP_ERR_T tlp_get (
+static TRDP_ERR_T getPd (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_SUB_T          subHandle,
     TRDP_PD_INFO_T      *pPdInfo,
+    TRDP_UNMARSHALL_T   pfDecode,
+    void                *pDecodeRef,
     UINT8               *pData,
     UINT32              *pDataSize)
 {
@@ -1801,10 +1989,21 @@ EXT_DECL TRDP_ERR_T tlp_get (
         else
         {
             ret = trdp_pdGet(pElement,
-                             appHandle->marshall.pfCbUnmarshall,
+                             (pfDecode != NULL) ? NULL : appHandle->marshall.pfCbUnmarshall,
                              appHandle->marshall.pRefCon,
-                             pData,
+                             (pfDecode != NULL) ? NULL : pData,
                              pDataSize);
+            if ((ret == TRDP_NO_ERR) && (pfDecode != NULL))
+            {
+                /* convert straight from the received frame */
+                ret = pfDecode(pDecodeRef,
+                               pElement->addr.comId,
+                               pElement->pFrame->data,
+                               vos_ntohl(pElement->pFrame->frameHead.datasetLength),
+                               pData,
+                               pDataSize,
+                               NULL);
+            }
         }
 
         if (pPdInfo != NULL)
@@ -1832,6 +2031,69 @@ EXT_DECL TRDP_ERR_T tlp_get (
     return ret;
 }
 
+/**********************************************************************************************************************/
+/** Get the last valid PD message.
+ *  This allows polling of PDs instead of event driven handling by callbacks
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[in,out]  pPdInfo             pointer to application's info buffer
+ *  @param[in,out]  pData               pointer to application's data buffer
+ *  @param[in,out]  pDataSize           in: size of buffer, out: size of data
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_SUB_ERR        not subscribed
+ *  @retval         TRDP_TIMEOUT_ERR    packet timed out
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_COMID_ERR      ComID not found when marshalling
+ */
+EXT_DECL TRDP_ERR_T tlp_get (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_PD_INFO_T      *pPdInfo,
+    UINT8               *pData,
+    UINT32              *pDataSize)
+{
+    return getPd(appHandle, subHandle, pPdInfo, NULL, NULL, pData, pDataSize);
+}
+
+/**********************************************************************************************************************/
+/** Get the last valid PD message, converted by the given function instead of the session's unmarshalling.
+ *  pfDecode is called with the marshalled dataset of the received frame, whether the subscription marshalls or
+ *  not. It allows reading parts of a dataset without unmarshalling or copying all of it.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[in,out]  pPdInfo             pointer to application's info buffer
+ *  @param[in]      pfDecode            conversion function, called with the session locked
+ *  @param[in]      pDecodeRef          passed to pfDecode as pRefCon
+ *  @param[in,out]  pData               pointer to application's data buffer
+ *  @param[in,out]  pDataSize           in: size of buffer, out: size of data
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_SUB_ERR        not subscribed
+ *  @retval         TRDP_TIMEOUT_ERR    packet timed out
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               errors of pfDecode
+ */
+EXT_DECL TRDP_ERR_T tlp_getDecoded (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_PD_INFO_T      *pPdInfo,
+    TRDP_UNMARSHALL_T   pfDecode,
+    void                *pDecodeRef,
+    UINT8               *pData,
+    UINT32              *pDataSize)
+{
+    if (pfDecode == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    return getPd(appHandle, subHandle, pPdInfo, pfDecode, pDecodeRef, pData, pDataSize);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,16 @@
  /*
  * $Id$
  *
+ *      AG 2026-10-18: Aggregated requests: repliers found by hash, Mq replies confirmed per source
+ *      AG 2026-10-18: Zero-copy payloads are kept until their completion is reaped, TCP sockets drain them before closing
+ *      AG 2026-10-18: Completion queue published to trdp_mdGetCompletion() by an atomic flag
+ *      AG 2026-10-18: Preemption points of the session reactor in trdp_mdSend() and trdp_mdCheckListenSocks()
+ *      AG 2026-10-18: Optional MD worker thread per session, woken when MD is queued
+ *      AG 2026-10-18: Aggregated requests: replies deduplicated by source and delivered as one result set
+ *      AG 2026-10-18: Asynchronous requests: outcome queued in a lock-free completion ring instead of calling back
+ *      AG 2026-10-18: TCP MD reassembled per socket, two reads per message; trdp_mdReply() no longer copies from the freed request
+ *      AG 2026-10-18: TCP MD sent from a per-socket outbound queue with scatter/gather, optional MSG_ZEROCOPY
+ *      AG 2026-10-18: trdp_mdNextJob(), the MD worker sleeps until the next MD time-out
  *     AHW 2023-01-11: Lint warnigs and Ticket #409 In updateTCNDNSentry(), the parameter noDesc of vos_select() is uninitialized if tlc_getInterval() fails
  *     CWE 2023-01-09: Ticket #393 Incorrect behaviour if MD timeout occurs
  *     CWE 2022-12-21: Ticket #404 Fix compile error - Test does not need to run, it is only used to verify bugfixes. It requires a special network-setup to run
@@ -84,6 +94,7 @@
 #include "tlc_if.h"
 #include "trdp_utils.h"
 #include "trdp_mdcom.h"
+#include "trdp_reactor.h"
 
 
 /***********************************************************************************************************************
@@ -104,6 +115,7 @@
 static const UINT32 cMinimumMDSize = 1480u;                            /**< Initial size for message data received */
 static const UINT8  cEmptySession[TRDP_SESS_ID_SIZE];                  /**< Empty sessionID to compare             */
 static const TRDP_MD_INFO_T cTrdp_md_info_default;
+static const UINT8  cPadding[4];                                       /**< Zero padding behind external payload   */
 
 /***********************************************************************************************************************
  *   Local Functions
@@ -144,17 +156,62 @@ static TRDP_ERR_T   trdp_mdCheck (TRDP_SESSION_PT   appHandle,
                                   MD_HEADER_T       *pPacket,
                                   UINT32            packetSize,
                                   BOOL8             checkHeaderOnly);
-static TRDP_ERR_T   trdp_mdSendPacket (VOS_SOCK_T mdSock,
-                                       UINT16     port,
-                                       MD_ELE_T *pElement);
+static TRDP_ERR_T   trdp_mdSendPacket (TRDP_SOCKETS_T   *pSocket,
+                                       UINT16           port,
+                                       MD_ELE_T         *pElement);
+static void         trdp_mdReleaseExtData (TRDP_MD_EXT_DATA_T *pExtData);
+static void         trdp_mdTxEnqueue (TRDP_SOCKETS_T    *pSocket,
+                                      MD_ELE_T          *pElement);
+static void         trdp_mdTxDequeue (TRDP_SESSION_PT   appHandle,
+                                      MD_ELE_T          *pElement);
+static void         trdp_mdDropSocketQueues (TRDP_SOCKETS_T *pSocket);
+static BOOL8        trdp_mdZeroCopyCompleted (TRDP_MD_EXT_DATA_T    *pExtData,
+                                              UINT32                firstId,
+                                              UINT32                lastId);
+static void         trdp_mdReapZeroCopy (TRDP_SOCKETS_T *pSocket);
+static void         trdp_mdParkExtData (TRDP_SOCKET_TCP_T *pTcp, TRDP_MD_EXT_DATA_T *pExtData);
+static BOOL8        trdp_mdPushCompletion (MD_COMPLETION_QUEUE_T        *pQueue,
+                                           const TRDP_MD_COMPLETION_T   *pCompletion);
+static BOOL8        trdp_mdFlushCompletions (MD_COMPLETION_QUEUE_T *pQueue);
+static void         trdp_mdPostCompletion (TRDP_SESSION_PT      appHandle,
+                                           const MD_ELE_T       *pMdItem,
+                                           const TRDP_MD_INFO_T *pMsg,
+                                           const UINT8          *pData,
+                                           UINT32               dataSize);
+static BOOL8        trdp_mdWantsResult (const MD_ELE_T *pElement);
+static UINT32       trdp_mdAggregateSlot (const MD_AGGREGATE_T *pAggregate, TRDP_IP_ADDR_T srcIpAddr);
+static BOOL8        trdp_mdAggregateHasSource (const MD_AGGREGATE_T *pAggregate,
+                                               TRDP_IP_ADDR_T       srcIpAddr);
+static void         trdp_mdAggregateDone (TRDP_SESSION_PT   appHandle,
+                                          const MD_ELE_T    *pMdItem,
+                                          TRDP_ERR_T        resultCode);
+static void         trdp_mdAggregateReply (TRDP_SESSION_PT  appHandle,
+                                           MD_ELE_T         *pMdItem);
+static void         trdp_mdFreeAggregate (MD_AGGREGATE_T *pAggregate);
+static TRDP_ERR_T   trdp_mdConfirmAggregate (TRDP_SESSION_PT            appHandle,
+                                             MD_ELE_T                   *pCaller,
+                                             TRDP_IP_ADDR_T             srcIpAddr,
+                                             UINT16                     userStatus,
+                                             const TRDP_SEND_PARAM_T    *pSendParam);
+static void         *trdp_mdWorkerThread (void *pArg);
+static void         trdp_mdMergeJob (const TRDP_TIME_T  *pDue,
+                                     const TRDP_TIME_T  *pNow,
+                                     const TRDP_TIME_T  *pPoll,
+                                     TRDP_TIME_T        *pNextJob);
+static void         trdp_mdSendDone (TRDP_SESSION_PT    appHandle,
+                                     MD_ELE_T           *pElement);
+static void         trdp_mdSendFailed (TRDP_SESSION_PT  appHandle,
+                                       INT32            socketIdx);
+static void         trdp_mdStartSendingTimeout (TRDP_SESSION_PT appHandle,
+                                                INT32           socketIdx);
 static TRDP_ERR_T   trdp_mdRecvTCPPacket (TRDP_SESSION_PT   appHandle,
-                                          VOS_SOCK_T        mdSock,
+                                          TRDP_SOCKETS_T    *pSocket,
                                           MD_ELE_T          *pElement);
 static TRDP_ERR_T   trdp_mdRecvUDPPacket (TRDP_SESSION_PT   appHandle,
                                           VOS_SOCK_T        mdSock,
                                           MD_ELE_T          *pElement);
 static TRDP_ERR_T   trdp_mdRecvPacket (TRDP_SESSION_PT  appHandle,
-                                       VOS_SOCK_T       mdSock,
+                                       UINT32           sockIndex,
                                        MD_ELE_T         *pElement);
 static TRDP_ERR_T   trdp_mdRecv (TRDP_SESSION_PT    appHandle,
                                  UINT32             sockIndex);
@@ -330,6 +387,13 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
         return;
     }
 
+    /* Timeout or failure of an aggregated request ends the collection */
+    if (pMdItem->pAggregate != NULL)
+    {
+        trdp_mdAggregateDone(appHandle, pMdItem, resultCode);
+        return;
+    }
+
     if (pMdItem->pPacket != NULL)
     {
         replyStatus = (INT32) vos_ntohl((UINT32)pMdItem->pPacket->frameHead.replyStatus);
@@ -383,6 +447,13 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
         theMessage.etbTopoCnt   = vos_ntohl(pMdItem->pPacket->frameHead.etbTopoCnt);
         theMessage.opTrnTopoCnt = vos_ntohl(pMdItem->pPacket->frameHead.opTrnTopoCnt);
         theMessage.srcIpAddr    = pMdItem->addr.srcIpAddr;
+        if (pMdItem->asyncHandle != 0u)
+        {
+            trdp_mdPostCompletion(appHandle, pMdItem, &theMessage,
+                                  (UINT8 *)(pMdItem->pPacket->data),
+                                  vos_ntohl(pMdItem->pPacket->frameHead.datasetLength));
+            return;
+        }
         pMdItem->pfCbFunction(
             appHandle->mdDefault.pRefCon,
             appHandle,
@@ -396,6 +467,11 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
         theMessage.etbTopoCnt   = pMdItem->addr.etbTopoCnt;
         theMessage.opTrnTopoCnt = pMdItem->addr.opTrnTopoCnt;
         theMessage.srcIpAddr    = 0u;
+        if (pMdItem->asyncHandle != 0u)
+        {
+            trdp_mdPostCompletion(appHandle, pMdItem, &theMessage, NULL, 0u);
+            return;
+        }
         /*in case of any detected turbulence return a zero buffer*/
         pMdItem->pfCbFunction(
             appHandle->mdDefault.pRefCon,
@@ -621,6 +697,17 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
         /* try to get a session match - topo counts must have matched at this point, if applicable */
         if (0 == memcmp(iterMD->pPacket->frameHead.sessionID, pMdItemHeader->sessionID, TRDP_SESS_ID_SIZE))
         {
+            /* aggregated requests count each replier once */
+            if ((iterMD->pAggregate != NULL)
+                && ((iterMD->pAggregate->delivered == TRUE)
+                    || (trdp_mdAggregateHasSource(iterMD->pAggregate, appHandle->pMDRcvEle->addr.srcIpAddr) == TRUE)))
+            {
+                iterMD->pAggregate->numDuplicates++;
+                vos_printLog(VOS_LOG_INFO, "Dropped duplicate reply from %s\n",
+                             vos_ipDotted(appHandle->pMDRcvEle->addr.srcIpAddr));
+                iterMD = NULL;
+                break;
+            }
             /* throw away old packet data  */
             if (NULL != iterMD->pPacket)
             {
@@ -667,6 +754,12 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
                     /* Increment number of ReplyQuery received, used to count number of expected Confirms sent */
                     iterMD->numRepliesQuery++;
 
+                    /* an aggregated request keeps collecting, each Mq is confirmed by a message of its own */
+                    if (iterMD->pAggregate != NULL)
+                    {
+                        break; /* exit for loop */
+                    }
+
                     iterMD->stateEle = TRDP_ST_TX_REQ_W4AP_CONFIRM;
 
                     /* receive time */
@@ -733,6 +826,17 @@ static void trdp_mdCloseSessions (
     /* Check all the sockets */
     if (checkAllSockets == TRUE)
     {
+        INT32 lIndex;
+
+        /* Sockets about to be closed lose their outbound queue */
+        for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); lIndex++)
+        {
+            if ((appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_TCP)
+                && (appHandle->ifaceMD[lIndex].tcpParams.morituri == TRUE))
+            {
+                trdp_mdDropSocketQueues(&appHandle->ifaceMD[lIndex]);
+            }
+        }
         trdp_releaseSocket(appHandle->ifaceMD, TRDP_INVALID_SOCKET_INDEX, 0, checkAllSockets, VOS_INADDR_ANY);
     }
 
@@ -744,6 +848,7 @@ static void trdp_mdCloseSessions (
         {
             trdp_releaseSocket(appHandle->ifaceMD, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
                                FALSE, VOS_INADDR_ANY);
+            trdp_mdTxDequeue(appHandle, iterMD);
             trdp_MDqueueDelElement(&appHandle->pMDSndQueue, iterMD);
             vos_printLog(VOS_LOG_INFO, "Freeing %s MD caller session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
                          iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
@@ -770,6 +875,7 @@ static void trdp_mdCloseSessions (
                 trdp_releaseSocket(appHandle->ifaceMD, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
                                    FALSE, VOS_INADDR_ANY);
             }
+            trdp_mdTxDequeue(appHandle, iterMD);
             trdp_MDqueueDelElement(&appHandle->pMDRcvQueue, iterMD);
             vos_printLog(VOS_LOG_INFO, "Freeing MD %s replier session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
                          iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
@@ -792,9 +898,18 @@ static void trdp_mdCloseSessions (
                      "Replacing the old socket by the new one (New Socket: %d, Index: %d)\n",
                      vos_sockId(newSocket), (int) socketIndex);
 
+        trdp_mdDropSocketQueues(&appHandle->ifaceMD[socketIndex]);
+        if (appHandle->ifaceMD[socketIndex].sock != VOS_INVALID_SOCKET)
+        {
+            /* The old connection still lingered for zero-copy completions, it is replaced now */
+            trdp_mdReleaseZeroCopy(&appHandle->ifaceMD[socketIndex]);
+            (void) vos_sockClose(appHandle->ifaceMD[socketIndex].sock);
+        }
         appHandle->ifaceMD[socketIndex].sock = newSocket;
         appHandle->ifaceMD[socketIndex].rcvMostly = TRUE;
-        appHandle->ifaceMD[socketIndex].tcpParams.notSend     = FALSE;
+        appHandle->ifaceMD[socketIndex].tcpParams.morituri    = FALSE;
+        appHandle->ifaceMD[socketIndex].tcpParams.zeroCopy    = 0;
+        appHandle->ifaceMD[socketIndex].tcpParams.zcNextId    = 0u;
         appHandle->ifaceMD[socketIndex].type                  = TRDP_SOCK_MD_TCP;
         appHandle->ifaceMD[socketIndex].usage                 = 0;
         appHandle->ifaceMD[socketIndex].tcpParams.sendNotOk   = FALSE;
@@ -981,29 +1096,314 @@ static void    trdp_mdUpdatePacket (MD_ELE_T *pElement)
     pElement->pPacket->frameHead.frameCheckSum = MAKE_LE(myCRC);
 }
 
+/**********************************************************************************************************************/
+/** Hand an application owned payload back to its owner
+ *
+ *  @param[in]      pExtData        pointer to the external payload descriptor
+ */
+static void trdp_mdReleaseExtData (TRDP_MD_EXT_DATA_T *pExtData)
+{
+    if ((pExtData->pData != NULL) && (pExtData->pfRelease != NULL))
+    {
+        pExtData->pfRelease(pExtData->pRefCon, pExtData->pData, pExtData->dataSize);
+    }
+    memset(pExtData, 0, sizeof(TRDP_MD_EXT_DATA_T));
+}
+
+/**********************************************************************************************************************/
+/** Append an element to the outbound queue of its TCP socket
+ *
+ *  @param[in]      pSocket         the socket the element is sent on
+ *  @param[in]      pElement        pointer to element to be sent
+ */
+static void trdp_mdTxEnqueue (TRDP_SOCKETS_T *pSocket, MD_ELE_T *pElement)
+{
+    pElement->pTxNext   = NULL;
+    pElement->txQueued  = TRUE;
+    if (pSocket->tcpParams.pTxTail == NULL)
+    {
+        pSocket->tcpParams.pTxHead = pElement;
+    }
+    else
+    {
+        pSocket->tcpParams.pTxTail->pTxNext = pElement;
+    }
+    pSocket->tcpParams.pTxTail = pElement;
+}
+
+/**********************************************************************************************************************/
+/** Remove an element from the outbound queue of its TCP socket
+ *  A partially sent element leaves the stream out of sync, the connection is closed in that case.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        pointer to element to be removed
+ */
+static void trdp_mdTxDequeue (TRDP_SESSION_PT appHandle, MD_ELE_T *pElement)
+{
+    TRDP_SOCKET_TCP_T   *pTcp;
+    MD_ELE_T            *pPrev = NULL;
+    MD_ELE_T            *iterMD;
+
+    if ((pElement->txQueued == FALSE) || (pElement->socketIdx == TRDP_INVALID_SOCKET_INDEX))
+    {
+        return;
+    }
+
+    pTcp = &appHandle->ifaceMD[pElement->socketIdx].tcpParams;
+
+    for (iterMD = pTcp->pTxHead; iterMD != NULL; iterMD = iterMD->pTxNext)
+    {
+        if (iterMD == pElement)
+        {
+            if (pPrev == NULL)
+            {
+                pTcp->pTxHead = pElement->pTxNext;
+                if ((pElement->sendSize > 0u) && (pElement->sendSize < pElement->grossSize))
+                {
+                    pTcp->morituri = TRUE;
+                }
+                /* The kernel may still reference the payload of an element in transit */
+                trdp_mdParkExtData(pTcp, &pElement->extData);
+            }
+            else
+            {
+                pPrev->pTxNext = pElement->pTxNext;
+            }
+            if (pTcp->pTxTail == pElement)
+            {
+                pTcp->pTxTail = pPrev;
+            }
+            break;
+        }
+        pPrev = iterMD;
+    }
+    pElement->pTxNext   = NULL;
+    pElement->txQueued  = FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Count a range of completed zero-copy sends against the sends of a payload
+ *
+ *  @param[in]      pExtData        the payload reference
+ *  @param[in]      firstId         first id of the range
+ *  @param[in]      lastId          last id of the range, ids wrap around
+ *
+ *  @retval         TRUE            all zero-copy sends of the payload are completed
+ *  @retval         FALSE           the kernel still references the payload
+ */
+static BOOL8 trdp_mdZeroCopyCompleted (TRDP_MD_EXT_DATA_T *pExtData, UINT32 firstId, UINT32 lastId)
+{
+    /* the part of the range within [zcId...zcId + zcSends - 1], relative to zcId */
+    INT32 from  = (INT32) (firstId - pExtData->zcId);
+    INT32 to    = (INT32) (lastId - pExtData->zcId);
+
+    if (from < 0)
+    {
+        from = 0;
+    }
+    if (to >= (INT32) pExtData->zcSends)
+    {
+        to = (INT32) pExtData->zcSends - 1;
+    }
+    if ((to >= from) && (pExtData->zcCnt > 0u))
+    {
+        pExtData->zcCnt -= (UINT32) (to - from + 1);
+    }
+    return (pExtData->zcCnt == 0u) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Release completed zero-copy transmissions of a TCP socket
+ *  Each range the kernel reports is counted against the parked payloads and the payload in transit at the head
+ *  of the outbound queue. The ranges may be reported in any order.
+ *
+ *  @param[in]      pSocket         the socket to check
+ */
+static void trdp_mdReapZeroCopy (TRDP_SOCKETS_T *pSocket)
+{
+    TRDP_SOCKET_TCP_T   *pTcp = &pSocket->tcpParams;
+    UINT32              firstId;
+    UINT32              lastId;
+    UINT32              lIndex;
+    UINT32              kept;
+
+    if (pTcp->zeroCopy <= 0)
+    {
+        return;
+    }
+
+    while (vos_sockZeroCopyDone(pSocket->sock, &firstId, &lastId) == VOS_NO_ERR)
+    {
+        if ((pTcp->pTxHead != NULL) && (pTcp->pTxHead->extData.zeroCopy == TRUE))
+        {
+            (void) trdp_mdZeroCopyCompleted(&pTcp->pTxHead->extData, firstId, lastId);
+        }
+
+        kept = 0u;
+        for (lIndex = 0u; lIndex < pTcp->zcPendCnt; lIndex++)
+        {
+            if (trdp_mdZeroCopyCompleted(&pTcp->zcPending[lIndex], firstId, lastId) == TRUE)
+            {
+                trdp_mdReleaseExtData(&pTcp->zcPending[lIndex]);
+            }
+            else
+            {
+                pTcp->zcPending[kept++] = pTcp->zcPending[lIndex];
+            }
+        }
+        pTcp->zcPendCnt = kept;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Hand back the payload of a sent element, or keep it until the kernel reports its zero-copy completion
+ *  trdp_mdSendPacket() pins a payload only while a pending slot is free and only the queue head is in transit,
+ *  hence a pinned payload always finds its slot.
+ *
+ *  @param[in]      pTcp            TCP state of the socket the payload was sent on
+ *  @param[in]      pExtData        the payload reference, cleared on return
+ */
+static void trdp_mdParkExtData (TRDP_SOCKET_TCP_T *pTcp, TRDP_MD_EXT_DATA_T *pExtData)
+{
+    if ((pExtData->zeroCopy == TRUE) && (pExtData->zcCnt > 0u) && (pTcp->zcPendCnt < TRDP_MD_ZEROCOPY_PENDING_CNT))
+    {
+        pTcp->zcPending[pTcp->zcPendCnt++] = *pExtData;
+        memset(pExtData, 0, sizeof(TRDP_MD_EXT_DATA_T));
+    }
+    else
+    {
+        trdp_mdReleaseExtData(pExtData);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Empty the queues of a TCP socket which is closed or replaced
+ *  Payloads waiting for a zero-copy completion stay pending, see trdp_mdZeroCopyPending().
+ *  A partially received message is discarded.
+ *
+ *  @param[in]      pSocket         the socket
+ */
+static void trdp_mdDropSocketQueues (TRDP_SOCKETS_T *pSocket)
+{
+    TRDP_SOCKET_TCP_T   *pTcp = &pSocket->tcpParams;
+    MD_ELE_T            *iterMD;
+
+    while (pTcp->pTxHead != NULL)
+    {
+        iterMD          = pTcp->pTxHead;
+        pTcp->pTxHead   = iterMD->pTxNext;
+        iterMD->pTxNext     = NULL;
+        iterMD->txQueued    = FALSE;
+        trdp_mdParkExtData(pTcp, &iterMD->extData);
+    }
+    pTcp->pTxTail = NULL;
+
+    trdp_mdReapZeroCopy(pSocket);
+
+    if (pTcp->pRxPacket != NULL)
+    {
+        vos_memFree(pTcp->pRxPacket);
+        pTcp->pRxPacket = NULL;
+    }
+    pTcp->rxSize = 0u;
+}
+
 /**********************************************************************************************************************/
 /** Send MD packet
+ *  TCP packets are handed to the socket as one gather list: header and data or
+ *  header, application owned payload and padding. A payload sent with MSG_ZEROCOPY is pinned by the kernel until
+ *  its completion, the header is copied (see vos_sockSendTCPv). A partial send is resumed on the next call.
  *
- *  @param[in]      mdSock          socket descriptor
+ *  @param[in]      pSocket         the socket to send on
  *  @param[in]      port            port on which to send
  *  @param[in]      pElement        pointer to element to be sent
- *  @retval         != NULL         error
+ *  @retval         TRDP_NO_ERR     packet sent completely
+ *  @retval         TRDP_IO_ERR     packet sent incompletely, try again later
+ *  @retval         != TRDP_NO_ERR  error
  */
-static TRDP_ERR_T  trdp_mdSendPacket (VOS_SOCK_T mdSock,
-                                      UINT16     port,
-                                      MD_ELE_T   *pElement)
+static TRDP_ERR_T  trdp_mdSendPacket (TRDP_SOCKETS_T   *pSocket,
+                                      UINT16           port,
+                                      MD_ELE_T         *pElement)
 {
     VOS_ERR_T   err         = VOS_NO_ERR;
-    UINT32      tmpSndSize  = 0u;
+    VOS_SOCK_T  mdSock      = pSocket->sock;
 
     if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0)
     {
-        tmpSndSize = pElement->sendSize;
+        VOS_IOVEC_T         iov[3];
+        UINT32              iovCnt      = 0u;
+        UINT32              skip        = pElement->sendSize;
+        UINT32              sentSize    = 0u;
+        UINT32              lIndex;
+        UINT32              *pZeroCopyId = NULL;
+        TRDP_MD_EXT_DATA_T  *pExt       = &pElement->extData;
+
+        if (pExt->pData == NULL)
+        {
+            iov[0].pBuffer  = (const UINT8 *)&pElement->pPacket->frameHead;
+            iov[0].size     = pElement->grossSize;
+            iovCnt          = 1u;
+        }
+        else
+        {
+            iov[0].pBuffer  = (const UINT8 *)&pElement->pPacket->frameHead;
+            iov[0].size     = sizeof(MD_HEADER_T);
+            iov[1].pBuffer  = pExt->pData;
+            iov[1].size     = pExt->dataSize;
+            iov[2].pBuffer  = cPadding;
+            iov[2].size     = pElement->grossSize - sizeof(MD_HEADER_T) - pExt->dataSize;
+            iovCnt          = (iov[2].size > 0u) ? 3u : 2u;
+
+            /* Big payloads are pinned instead of copied, if the target supports it */
+            if ((pExt->dataSize >= TRDP_MD_ZEROCOPY_MIN_SIZE)
+                && (pSocket->tcpParams.morituri == FALSE)
+                && (pSocket->tcpParams.zcPendCnt < TRDP_MD_ZEROCOPY_PENDING_CNT))
+            {
+                if (pSocket->tcpParams.zeroCopy == 0)
+                {
+                    pSocket->tcpParams.zeroCopy = (vos_sockSetZeroCopy(mdSock) == VOS_NO_ERR) ? 1 : -1;
+                }
+                if (pSocket->tcpParams.zeroCopy > 0)
+                {
+                    pZeroCopyId = &pSocket->tcpParams.zcNextId;
+                }
+            }
+        }
+
+        /* skip what has been sent before, the header keeps its place in front (it is never pinned) */
+        for (lIndex = 0u; lIndex < iovCnt; lIndex++)
+        {
+            UINT32 done = (skip < iov[lIndex].size) ? skip : iov[lIndex].size;
 
-        pElement->sendSize = pElement->grossSize - tmpSndSize;
+            iov[lIndex].pBuffer += done;
+            iov[lIndex].size    -= done;
+            skip                -= done;
+        }
+        if (pElement->sendSize < pElement->grossSize)
+        {
+            UINT32 zcId = pSocket->tcpParams.zcNextId;
+
+            err = vos_sockSendTCPv(mdSock, iov, iovCnt, &sentSize, pZeroCopyId);
+            if (zcId != pSocket->tcpParams.zcNextId)
+            {
+                if (pExt->zeroCopy == FALSE)
+                {
+                    pExt->zeroCopy  = TRUE;
+                    pExt->zcId      = zcId;
+                    pExt->zcSends   = 0u;
+                    pExt->zcCnt     = 0u;
+                }
+                pExt->zcSends   += pSocket->tcpParams.zcNextId - zcId;
+                pExt->zcCnt     += pSocket->tcpParams.zcNextId - zcId;
+            }
+        }
+        pElement->sendSize += sentSize;
 
-        err = vos_sockSendTCP(mdSock, ((UINT8 *)&pElement->pPacket->frameHead) + tmpSndSize, &pElement->sendSize);
-        pElement->sendSize = tmpSndSize + pElement->sendSize;
+        /* A full socket buffer is no failure, the rest is sent later */
+        if (err == VOS_BLOCK_ERR)
+        {
+            err = VOS_NO_ERR;
+        }
     }
     else
     {
@@ -1048,26 +1448,25 @@ static TRDP_ERR_T  trdp_mdSendPacket (VOS_SOCK_T mdSock,
 
 /**********************************************************************************************************************/
 /** Receive MD packet transmitted via TCP
+ *  A message arriving in pieces is kept with its socket (pRxPacket/rxSize) and continued on the next call.
+ *  Header and body are read directly into the buffer which is handed to the application.
  *
  *  @param[in]      appHandle       session pointer
- *  @param[in]      mdSock          socket descriptor
+ *  @param[in]      pSocket         socket entry to read from
  *  @param[out]     pElement        pointer to received packet
+ *  @retval         TRDP_NO_ERR     complete message received
+ *  @retval         TRDP_PACKET_ERR message incomplete, continued later
  *  @retval         != TRDP_NO_ERR  error
  */
-static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, VOS_SOCK_T mdSock, MD_ELE_T *pElement)
+static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, TRDP_SOCKETS_T *pSocket, MD_ELE_T *pElement)
 {
     /* TCP receiver */
-    TRDP_ERR_T  err = TRDP_NO_ERR;
-    UINT32      size = 0u;                       /* Size of the all data read until now */
-    UINT32      dataSize        = 0u;            /* The pending data to read */
-    UINT32      socketIndex     = 0u;
-    UINT32      readSize        = 0u;            /* All the data read in this cycle (Header + Data) */
-    UINT32      readDataSize    = 0u;            /* All the data part read in this cycle (Data) */
-    BOOL8       noDataToRead    = FALSE;
-    UINT32      storedDataSize  = 0u;
-
-    /* Initialize to 0 the stored header size*/
-    UINT32      storedHeader = 0;
+    TRDP_SOCKET_TCP_T   *pTcp       = &pSocket->tcpParams;
+    VOS_ERR_T           err         = VOS_NO_ERR;
+    UINT32              rxSize;                     /* Size of the message read until now */
+    UINT32              readSize;                   /* Size requested / read by one call */
+    UINT32              readTotal   = 0u;           /* All the data read in this cycle (Header + Data) */
+    UINT32              grossSize   = 0u;           /* Size of the complete message, known with the header */
 
     /* Initialize to 0 the pElement->dataSize
      * Once it is known, the message complete data size will be saved*/
@@ -1076,302 +1475,124 @@ static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, VOS_SOCK_T md
     /* Fill destination address */
     pElement->addr.destIpAddr = appHandle->realIP;
 
-    /* Find the socket index */
-    for ( socketIndex = 0u; socketIndex < (UINT32)trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); socketIndex++ )
-    {
-        if ( appHandle->ifaceMD[socketIndex].sock == mdSock )
-        {
-            break;
-        }
-    }
-
-    if ( socketIndex >= (UINT32)trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP) )
+    /* Continue a partially received message in its own buffer */
+    if (pTcp->pRxPacket != NULL)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "trdp_mdRecvPacket - Socket index out of range\n");
-        return TRDP_UNKNOWN_ERR;
+        vos_memFree(pElement->pPacket);
+        pElement->pPacket   = pTcp->pRxPacket;
+        pTcp->pRxPacket     = NULL;
     }
+    rxSize          = pTcp->rxSize;
+    pTcp->rxSize    = 0u;
 
     /* Read Header */
-    if ((appHandle->uncompletedTCP[socketIndex] == NULL)
-        || ((appHandle->uncompletedTCP[socketIndex] != NULL)
-            && (appHandle->uncompletedTCP[socketIndex]->grossSize < sizeof(MD_HEADER_T))))
+    if (rxSize < sizeof(MD_HEADER_T))
     {
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL )
-        {
-            readSize = sizeof(MD_HEADER_T);
-        }
-        else
-        {
-            /* If we have read some data before, read the rest */
-            readSize        = sizeof(MD_HEADER_T) - appHandle->uncompletedTCP[socketIndex]->grossSize;
-            storedHeader    = appHandle->uncompletedTCP[socketIndex]->grossSize;
-        }
-
-        if ( readSize > 0u )
+        readSize    = sizeof(MD_HEADER_T) - rxSize;
+        err         = vos_sockReceiveTCP(pSocket->sock,
+                                         ((UINT8 *)&pElement->pPacket->frameHead) + rxSize,
+                                         &readSize);
+        rxSize      += readSize;
+        readTotal   += readSize;
+
+        if ((err == VOS_NO_ERR) && (rxSize >= sizeof(MD_HEADER_T)))
         {
-            err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
-                                                  ((UINT8 *)&pElement->pPacket->frameHead) + storedHeader,
-                                                  &readSize);
-
-            /* Add the read data size to the size read before */
-            size = storedHeader + readSize;
+            TRDP_ERR_T result = trdp_mdCheck(appHandle, &pElement->pPacket->frameHead, rxSize, CHECK_HEADER_ONLY);
 
-            if ( err == TRDP_NO_ERR
-                 && (appHandle->uncompletedTCP[socketIndex] != NULL)
-                 && (size >= sizeof(MD_HEADER_T))
-                 && appHandle->uncompletedTCP[socketIndex]->pPacket != NULL )     /* BL: Prevent NULL pointer access */
+            if (result != TRDP_NO_ERR)
             {
-                if ( trdp_mdCheck(appHandle, &pElement->pPacket->frameHead, size, CHECK_HEADER_ONLY) == TRDP_NO_ERR )
-                {
-                    /* Uncompleted Header, completed. Save some parameters in the uncompletedTCP structure */
-                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.datasetLength =
-                        pElement->pPacket->frameHead.datasetLength;
-                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.frameCheckSum =
-                        pElement->pPacket->frameHead.frameCheckSum;
-                }
-                else
-                {
-                    vos_printLogStr(VOS_LOG_INFO, "TCP MD header check failed\n");
-                    return TRDP_NODATA_ERR;
-                }
+                vos_printLogStr(VOS_LOG_INFO, "TCP MD header check failed\n");
+                return result;
             }
-        }
-    }
-
-    /* Read Data */
-    if ((size >= sizeof(MD_HEADER_T))
-        || ((appHandle->uncompletedTCP[socketIndex] != NULL)
-            && (appHandle->uncompletedTCP[socketIndex]->grossSize >= sizeof(MD_HEADER_T))))
-    {
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL || appHandle->uncompletedTCP[socketIndex]->pPacket == NULL )
-        {
-            /* Get the rest of the message length */
-            dataSize = vos_ntohl(pElement->pPacket->frameHead.datasetLength);
 
-            readDataSize        = trdp_packetSizeMD(dataSize - sizeof(MD_HEADER_T));
-            pElement->grossSize = trdp_packetSizeMD(dataSize);
-            pElement->dataSize  = dataSize;
-            dataSize = pElement->grossSize - sizeof(MD_HEADER_T);
-        }
-        else
-        {
-            /* Calculate the data size that is pending to read */
-            dataSize = vos_ntohl(appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.datasetLength);
-
-            pElement->dataSize  = dataSize;
-            pElement->grossSize = trdp_packetSizeMD(dataSize);
+            grossSize = trdp_packetSizeMD(vos_ntohl(pElement->pPacket->frameHead.datasetLength));
 
-            size = appHandle->uncompletedTCP[socketIndex]->grossSize + readSize;
-            dataSize        = dataSize - (size - sizeof(MD_HEADER_T));
-            readDataSize    = dataSize; /* trdp_packetSizeMD(dataSize); */
-        }
-
-        /* If all the Header is read, check if more memory is needed */
-        if ( size >= sizeof(MD_HEADER_T))
-        {
-            if ( trdp_packetSizeMD(pElement->dataSize) > cMinimumMDSize )
+            if (grossSize > cMinimumMDSize)
             {
-                /* we have to allocate a bigger buffer */
-                MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-                if ( pBigData == NULL )
+                /* we have to allocate a bigger buffer, only the header needs to be moved */
+                MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(grossSize);
+                if (pBigData == NULL)
                 {
                     return TRDP_MEM_ERR;
                 }
-                /*  Swap the pointers ...  */
-                memcpy(((UINT8 *)&pBigData->frameHead) + storedHeader,
-                       ((UINT8 *)&pElement->pPacket->frameHead) + storedHeader,
-                       readSize);
-
+                memcpy(&pBigData->frameHead, &pElement->pPacket->frameHead, sizeof(MD_HEADER_T));
                 vos_memFree(pElement->pPacket);
                 pElement->pPacket = pBigData;
             }
         }
+    }
+    else
+    {
+        grossSize = trdp_packetSizeMD(vos_ntohl(pElement->pPacket->frameHead.datasetLength));
+    }
 
-        if ( readDataSize > 0u )
-        {
-            err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
-                                                  ((UINT8 *)&pElement->pPacket->frameHead) + size,
-                                                  &readDataSize);
-
-            /* Add the read data size */
-            size = size + readDataSize;
-
-            /* Add the read Data size to the size read during this cycle */
-            readSize = readSize + readDataSize;
-        }
+    /* Read Data - straight into its final place */
+    if ((err == VOS_NO_ERR) && (grossSize > 0u) && (rxSize < grossSize))
+    {
+        readSize    = grossSize - rxSize;
+        err         = vos_sockReceiveTCP(pSocket->sock,
+                                         ((UINT8 *)&pElement->pPacket->frameHead) + rxSize,
+                                         &readSize);
+        rxSize      += readSize;
+        readTotal   += readSize;
     }
-    pElement->grossSize = size;
 
-    /* If the Header is incomplete, the data size will be "0". Otherwise it will be calculated. */
-    switch ( err )
+    switch (err)
     {
-       case TRDP_NODATA_ERR:
-           vos_printLog(VOS_LOG_INFO, "vos_sockReceiveTCP - No data at socket %d\n", vos_sockId(mdSock));
-           return TRDP_NODATA_ERR;
-       case TRDP_BLOCK_ERR:
-           if (((pElement->pktFlags & TRDP_FLAGS_TCP) != 0) && (readSize == 0u))
-           {
-               return TRDP_BLOCK_ERR;
-           }
-           break;
-       case TRDP_NO_ERR:
+       case VOS_NO_ERR:
+       case VOS_BLOCK_ERR:
            break;
+       case VOS_NODATA_ERR:
+           vos_printLog(VOS_LOG_INFO, "vos_sockReceiveTCP - No data at socket %d\n", vos_sockId(pSocket->sock));
+           return TRDP_NODATA_ERR;
        default:
-           vos_printLog(VOS_LOG_ERROR, "vos_sockReceiveTCP failed (Err: %d, Socket: %d)\n", err, vos_sockId(mdSock));
-           return err;
+           vos_printLog(VOS_LOG_ERROR, "vos_sockReceiveTCP failed (Err: %d, Socket: %d)\n",
+                        err, vos_sockId(pSocket->sock));
+           return (TRDP_ERR_T) err;
     }
-    /* All the data (Header + Data) stored in the uncompletedTCP[] array */
-    /* Check if it's necessary to read some data */
-    if ( pElement->grossSize == sizeof(MD_HEADER_T))
+
+    if ((grossSize == 0u) || (rxSize < grossSize))
     {
-        if ( dataSize == 0u )
+        /* Uncompleted message received, the socket keeps the buffer until the rest arrives */
+        if (rxSize > 0u)
+        {
+            pTcp->pRxPacket     = pElement->pPacket;
+            pTcp->rxSize        = rxSize;
+            pElement->pPacket   = NULL;
+        }
+        if (readTotal == 0u)
         {
-            noDataToRead = TRUE;
+            return TRDP_BLOCK_ERR;
         }
+        return TRDP_PACKET_ERR;
     }
 
-    /* Compare if all the data has been read */
-    if (((pElement->grossSize < sizeof(MD_HEADER_T)) && (readDataSize == 0u))
-        ||
-        ((noDataToRead == FALSE) && (readDataSize != dataSize)))
-    {
-        /* Uncompleted message received */
+    /* Complete message */
+    pElement->grossSize = grossSize;
+    pElement->dataSize  = vos_ntohl(pElement->pPacket->frameHead.datasetLength);
+    return TRDP_NO_ERR;
+}
 
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL )
-        {
-            /* It is the first loop, no data stored yet. Allocate memory for the message */
-            appHandle->uncompletedTCP[socketIndex] = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
 
-            if ( appHandle->uncompletedTCP[socketIndex] == NULL )
-            {
-                /* vos_memDelete(NULL); */
-                vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc() failed\n");
-                return TRDP_MEM_ERR;
-            }
 
-            /* Check the memory that is needed */
-            if ( trdp_packetSizeMD(pElement->dataSize) < cMinimumMDSize )
-            {
-                /* Allocate the cMinimumMDSize memory at least for now*/
-                appHandle->uncompletedTCP[socketIndex]->pPacket = (MD_PACKET_T *) vos_memAlloc(cMinimumMDSize);
-            }
-            else
-            {
-                /* Allocate the dataSize memory */
-                /* we have to allocate a bigger buffer */
-                appHandle->uncompletedTCP[socketIndex]->pPacket =
-                    (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-            }
+/**********************************************************************************************************************/
+/** Receive MD packet transmitted via UDP
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      mdSock          socket descriptor
+ *  @param[out]     pElement        pointer to received packet
+ *  @retval         != TRDP_NO_ERR  error
+ */
+static TRDP_ERR_T trdp_mdRecvUDPPacket (TRDP_SESSION_PT appHandle, VOS_SOCK_T mdSock, MD_ELE_T *pElement)
+{
+    /* UDP receiver */
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      size; /* Size of the all data read until now */
 
-            if ( appHandle->uncompletedTCP[socketIndex]->pPacket == NULL )
-            {
-                return TRDP_MEM_ERR;
-            }
-
-            storedDataSize = 0;
-        }
-        else
-        {
-            /* Get the size that have been already stored in the uncompletedTCP[] */
-            storedDataSize = appHandle->uncompletedTCP[socketIndex]->grossSize;
-
-            if ((storedDataSize < sizeof(MD_HEADER_T))
-                && (pElement->grossSize > sizeof(MD_HEADER_T)))
-            {
-                if ( trdp_packetSizeMD(pElement->dataSize) > cMinimumMDSize )
-                {
-                    /* we have to allocate a bigger buffer */
-                    MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-                    if ( pBigData == NULL )
-                    {
-                        return TRDP_MEM_ERR;
-                    }
-
-                    /* Copy the data to the pBigData->frameHead */
-                    memcpy(((UINT8 *)&pBigData->frameHead),
-                           ((UINT8 *)&pElement->pPacket->frameHead),
-                           storedDataSize);
-
-                    /*  Swap the pointers ...  */
-                    vos_memFree(appHandle->uncompletedTCP[socketIndex]->pPacket);
-                    appHandle->uncompletedTCP[socketIndex]->pPacket = pBigData;
-                }
-            }
-        }
-
-        if ( (readSize > 0u)  && (appHandle->uncompletedTCP[socketIndex]->pPacket !=NULL))
-        {
-            /* Copy the read data in the uncompletedTCP[] */
-            memcpy(((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead) + storedDataSize,
-                   ((UINT8 *)&pElement->pPacket->frameHead) + storedDataSize, readSize);
-            appHandle->uncompletedTCP[socketIndex]->grossSize   = pElement->grossSize;
-            appHandle->uncompletedTCP[socketIndex]->dataSize    = readDataSize;
-        }
-        else
-        {
-            vos_printLog(VOS_LOG_DBG, "Received TCP - readSize = 0 (Socket: %d)\n", vos_sockId(mdSock));
-            return TRDP_PARAM_ERR;
-        }
-
-        return TRDP_PACKET_ERR;
-    }
-    else
-    {
-        /* Complete message */
-        /* All data is read. Save all the data and copy to the pElement to continue */
-        if ( appHandle->uncompletedTCP[socketIndex] != NULL )
-        {
-            /* Add the received information and copy all the data to the pElement */
-            storedDataSize = appHandle->uncompletedTCP[socketIndex]->grossSize;
-
-            if ((readSize > 0u) &&
-                appHandle->uncompletedTCP[socketIndex]->pPacket != NULL )
-            {
-                /* Copy the read data in the uncompletedTCP[] */
-                memcpy(((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead) + storedDataSize,
-                       ((UINT8 *)&pElement->pPacket->frameHead) + storedDataSize, readSize);
-
-                /* Copy all the uncompletedTCP data to the pElement */
-                memcpy(((UINT8 *)&pElement->pPacket->frameHead),
-                       ((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead), pElement->grossSize);
-
-                /* Disallocate the memory */
-                /* 1st free data buffer - independant pointer */
-                vos_memFree(appHandle->uncompletedTCP[socketIndex]->pPacket);
-                /* 2nd free socket element */
-                vos_memFree(appHandle->uncompletedTCP[socketIndex]);
-                appHandle->uncompletedTCP[socketIndex] = NULL;
-            }
-            else
-            {
-                vos_printLog(VOS_LOG_DBG, "vos_sockReceiveTCP - readSize = 0 (Socket: %d)\n", vos_sockId(mdSock));
-                return TRDP_PARAM_ERR;
-            }
-        }
-    }
-    return TRDP_NO_ERR;
-}
-
-
-
-/**********************************************************************************************************************/
-/** Receive MD packet transmitted via UDP
- *
- *  @param[in]      appHandle       session pointer
- *  @param[in]      mdSock          socket descriptor
- *  @param[out]     pElement        pointer to received packet
- *  @retval         != TRDP_NO_ERR  error
- */
-static TRDP_ERR_T trdp_mdRecvUDPPacket (TRDP_SESSION_PT appHandle, VOS_SOCK_T mdSock, MD_ELE_T *pElement)
-{
-    /* UDP receiver */
-    TRDP_ERR_T  err = TRDP_NO_ERR;
-    UINT32      size; /* Size of the all data read until now */
-
-    /* We read the header first */
-    size = sizeof(MD_HEADER_T);
-    pElement->addr.srcIpAddr    = 0u;
-    pElement->addr.destIpAddr   = appHandle->realIP;    /* Preset destination IP  */
+    /* We read the header first */
+    size = sizeof(MD_HEADER_T);
+    pElement->addr.srcIpAddr    = 0u;
+    pElement->addr.destIpAddr   = appHandle->realIP;    /* Preset destination IP  */
 
     err = (TRDP_ERR_T) vos_sockReceiveUDP(mdSock,
                                           (UINT8 *)pElement->pPacket,
@@ -1471,14 +1692,14 @@ static TRDP_ERR_T trdp_mdRecvUDPPacket (TRDP_SESSION_PT appHandle, VOS_SOCK_T md
 /** Receive MD packet
  *
  *  @param[in]      appHandle       session pointer
- *  @param[in]      mdSock          socket descriptor
+ *  @param[in]      sockIndex       index of the socket to read from
  *  @param[in]      pElement        pointer to received packet
  *
  *  @retval         != TRDP_NO_ERR  error
  */
 static TRDP_ERR_T  trdp_mdRecvPacket (
     TRDP_SESSION_PT appHandle,
-    VOS_SOCK_T      mdSock,
+    UINT32          sockIndex,
     MD_ELE_T        *pElement)
 {
     TRDP_MD_STATISTICS_T *pElementStatistics;
@@ -1488,7 +1709,7 @@ static TRDP_ERR_T  trdp_mdRecvPacket (
     if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0)
     {
         /* Call TCP receiver function */
-        err = trdp_mdRecvTCPPacket(appHandle, mdSock, pElement);
+        err = trdp_mdRecvTCPPacket(appHandle, &appHandle->ifaceMD[sockIndex], pElement);
         if (err != TRDP_NO_ERR)
         {
             /* fatal communication issue, exit function, but collect error stats (Ticket #267)  */
@@ -1501,7 +1722,7 @@ static TRDP_ERR_T  trdp_mdRecvPacket (
     else
     {
         /* Call UDP receiver function */
-        err = trdp_mdRecvUDPPacket(appHandle, mdSock, pElement);
+        err = trdp_mdRecvUDPPacket(appHandle, appHandle->ifaceMD[sockIndex].sock, pElement);
         if (err != TRDP_NO_ERR)
         {
             /* fatal communication issue, exit function, but collect error stats (Ticket #267) */
@@ -1537,7 +1758,10 @@ static TRDP_ERR_T  trdp_mdRecvPacket (
            ;
     }
 
-    if (err != TRDP_NO_ERR)
+    /* A socket also turns readable for zero-copy completions, nothing to read then.
+       A TCP message arriving in pieces is continued on the next call. */
+    if ((err != TRDP_NO_ERR) && (err != TRDP_BLOCK_ERR)
+        && !((err == TRDP_PACKET_ERR) && ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0)))
     {
         vos_printLog(VOS_LOG_ERROR, "trdp_mdCheck %s failed (Err: %d)\n",
                      (pElement->pktFlags & TRDP_FLAGS_TCP) ? "TCP" : "UDP", err);
@@ -2027,7 +2251,7 @@ static TRDP_ERR_T  trdp_mdRecv (
     }
 
     /* get packet: */
-    result = trdp_mdRecvPacket(appHandle, appHandle->ifaceMD[sockIndex].sock, appHandle->pMDRcvEle);
+    result = trdp_mdRecvPacket(appHandle, sockIndex, appHandle->pMDRcvEle);
 
     if (result != TRDP_NO_ERR)
     {
@@ -2105,7 +2329,12 @@ static TRDP_ERR_T  trdp_mdRecv (
     }
 
     /* Inform user  */
-    if (NULL != iterMD && iterMD->pfCbFunction != NULL)
+    if ((NULL != iterMD) && (iterMD->pAggregate != NULL))
+    {
+        /* collected, replier errors (Me) included */
+        trdp_mdAggregateReply(appHandle, iterMD);
+    }
+    else if ((NULL != iterMD) && (trdp_mdWantsResult(iterMD) == TRUE))
     {
         if (vos_ntohs(pH->msgType) == TRDP_MSG_ME)
         {
@@ -2197,6 +2426,11 @@ void trdp_mdFreeSession (
 {
     if (NULL != pMDSession)
     {
+        trdp_mdReleaseExtData(&pMDSession->extData);
+        if (NULL != pMDSession->pAggregate)
+        {
+            trdp_mdFreeAggregate(pMDSession->pAggregate);
+        }
         if (NULL != pMDSession->pPacket)
         {
             vos_memFree(pMDSession->pPacket);
@@ -2205,10 +2439,836 @@ void trdp_mdFreeSession (
     }
 }
 
+/**********************************************************************************************************************/
+/** Hand back all payloads still referenced by the TCP socket queues of a session
+ *  Called before the session's MD elements and sockets are released.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_mdReleaseSocketQueues (
+    TRDP_SESSION_PT appHandle)
+{
+    INT32 lIndex;
+
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); lIndex++)
+    {
+        if (appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_TCP)
+        {
+            trdp_mdDropSocketQueues(&appHandle->ifaceMD[lIndex]);
+            trdp_mdReleaseZeroCopy(&appHandle->ifaceMD[lIndex]);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Check whether a TCP socket about to be closed still waits for zero-copy completions
+ *  Once closed, the socket cannot report completions anymore. It lingers, without being read, for up to
+ *  TRDP_MD_ZEROCOPY_DRAIN_TIME; completions are collected without blocking on each call. Payloads still
+ *  unconfirmed then are handed back by trdp_mdReleaseZeroCopy().
+ *
+ *  @param[in]      pSocket             the socket
+ *
+ *  @retval         TRUE                the socket must not be closed yet
+ *  @retval         FALSE               the socket can be closed
+ */
+BOOL8 trdp_mdZeroCopyPending (
+    TRDP_SOCKETS_T *pSocket)
+{
+    TRDP_SOCKET_TCP_T   *pTcp = &pSocket->tcpParams;
+    TRDP_TIME_T         now;
+
+    if (pSocket->sock != VOS_INVALID_SOCKET)
+    {
+        trdp_mdReapZeroCopy(pSocket);
+    }
+    if ((pTcp->zcPendCnt == 0u) || (pSocket->sock == VOS_INVALID_SOCKET))
+    {
+        trdp_mdReleaseZeroCopy(pSocket);
+        return FALSE;
+    }
+
+    vos_getTime(&now);
+    if (!timerisset(&pTcp->zcLingerEnd))
+    {
+        TRDP_TIME_T linger = {0, TRDP_MD_ZEROCOPY_DRAIN_TIME};
+
+        pTcp->zcLingerEnd   = now;
+        vos_addTime(&pTcp->zcLingerEnd, &linger);
+        pTcp->addFileDesc   = FALSE;
+        return TRUE;
+    }
+    if (vos_cmpTime(&now, &pTcp->zcLingerEnd) < 0)
+    {
+        return TRUE;
+    }
+    trdp_mdReleaseZeroCopy(pSocket);
+    return FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Hand back all payloads of a TCP socket waiting for zero-copy completions
+ *  Called when the socket is finally closed, does not wait. Payloads still unconfirmed are handed back with a warning.
+ *
+ *  @param[in]      pSocket             the socket
+ */
+void trdp_mdReleaseZeroCopy (
+    TRDP_SOCKETS_T *pSocket)
+{
+    TRDP_SOCKET_TCP_T   *pTcp = &pSocket->tcpParams;
+    UINT32              lIndex;
+
+    if ((pSocket->sock != VOS_INVALID_SOCKET) && (pTcp->zcPendCnt > 0u))
+    {
+        trdp_mdReapZeroCopy(pSocket);
+    }
+    if (pTcp->zcPendCnt > 0u)
+    {
+        vos_printLog(VOS_LOG_WARNING, "%u zero-copy payload(s) not confirmed before closing socket %d\n",
+                     (unsigned int) pTcp->zcPendCnt, vos_sockId(pSocket->sock));
+    }
+    for (lIndex = 0u; lIndex < pTcp->zcPendCnt; lIndex++)
+    {
+        trdp_mdReleaseExtData(&pTcp->zcPending[lIndex]);
+    }
+    pTcp->zcPendCnt = 0u;
+    vos_clearTime(&pTcp->zcLingerEnd);
+}
+
+/**********************************************************************************************************************/
+/** Put a completion into the ring (producer side, mutexMD held)
+ *
+ *  @param[in]      pQueue          the completion queue
+ *  @param[in]      pCompletion     the completion to copy
+ *
+ *  @retval         TRUE            queued
+ *  @retval         FALSE           ring is full
+ */
+static BOOL8 trdp_mdPushCompletion (MD_COMPLETION_QUEUE_T *pQueue, const TRDP_MD_COMPLETION_T *pCompletion)
+{
+    UINT32 tail = pQueue->tail;
+
+    if ((tail - vos_atomicLoad32(&pQueue->head)) >= TRDP_MD_COMPLETION_QUEUE_SIZE)
+    {
+        return FALSE;
+    }
+    pQueue->entry[tail & (TRDP_MD_COMPLETION_QUEUE_SIZE - 1u)] = *pCompletion;
+    vos_atomicStore32(&pQueue->tail, tail + 1u);
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Move waiting completions into the ring, as far as there is room (producer side, mutexMD held)
+ *
+ *  @param[in]      pQueue          the completion queue
+ *
+ *  @retval         TRUE            at least one completion was moved
+ */
+static BOOL8 trdp_mdFlushCompletions (MD_COMPLETION_QUEUE_T *pQueue)
+{
+    BOOL8 moved = FALSE;
+
+    while ((pQueue->pOverflowHead != NULL)
+           && (trdp_mdPushCompletion(pQueue, &pQueue->pOverflowHead->completion) == TRUE))
+    {
+        MD_COMPLETION_ELE_T *pNext = pQueue->pOverflowHead->pNext;
+
+        vos_memFree(pQueue->pOverflowHead);
+        pQueue->pOverflowHead = pNext;
+        moved = TRUE;
+    }
+    if (pQueue->pOverflowHead == NULL)
+    {
+        pQueue->pOverflowTail = NULL;
+    }
+    return moved;
+}
+
+/**********************************************************************************************************************/
+/** Queue the outcome of an asynchronous request instead of calling back (producer side, mutexMD held)
+ *  The data is copied, the application releases it with tlm_releaseCompletion().
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pMdItem         the caller's MD element
+ *  @param[in]      pMsg            message info as it would be passed to the callback
+ *  @param[in]      pData           received data or NULL
+ *  @param[in]      dataSize        size of received data
+ */
+static void trdp_mdPostCompletion (TRDP_SESSION_PT      appHandle,
+                                   const MD_ELE_T       *pMdItem,
+                                   const TRDP_MD_INFO_T *pMsg,
+                                   const UINT8          *pData,
+                                   UINT32               dataSize)
+{
+    MD_COMPLETION_QUEUE_T   *pQueue = appHandle->pMDCompletions;
+    TRDP_MD_COMPLETION_T    completion;
+
+    if (pQueue == NULL)
+    {
+        return;
+    }
+
+    completion.handle   = pMdItem->asyncHandle;
+    completion.info     = *pMsg;
+    completion.pData    = NULL;
+    completion.dataSize = 0u;
+    completion.final    = (pMsg->resultCode != TRDP_NO_ERR)
+        || ((pMdItem->numExpReplies != 0u)
+            && ((pMdItem->numReplies + pMdItem->numRepliesQuery) >= pMdItem->numExpReplies));
+
+    if ((pData != NULL) && (dataSize > 0u))
+    {
+        completion.pData = (UINT8 *) vos_memAlloc(dataSize);
+        if (completion.pData == NULL)
+        {
+            completion.info.resultCode = TRDP_MEM_ERR;
+        }
+        else
+        {
+            memcpy(completion.pData, pData, dataSize);
+            completion.dataSize = dataSize;
+        }
+    }
+
+    (void) trdp_mdFlushCompletions(pQueue);
+
+    if ((pQueue->pOverflowHead != NULL)
+        || (trdp_mdPushCompletion(pQueue, &completion) == FALSE))
+    {
+        MD_COMPLETION_ELE_T *pEle = (MD_COMPLETION_ELE_T *) vos_memAlloc(sizeof(MD_COMPLETION_ELE_T));
+
+        if (pEle == NULL)
+        {
+            vos_printLog(VOS_LOG_ERROR, "Completion of MD request %u lost, out of memory\n",
+                         (unsigned int) completion.handle);
+            if (completion.pData != NULL)
+            {
+                vos_memFree(completion.pData);
+            }
+            return;
+        }
+        pEle->pNext         = NULL;
+        pEle->completion    = completion;
+        if (pQueue->pOverflowTail == NULL)
+        {
+            pQueue->pOverflowHead = pEle;
+        }
+        else
+        {
+            pQueue->pOverflowTail->pNext = pEle;
+        }
+        pQueue->pOverflowTail = pEle;
+    }
+
+    if (pQueue->hasEvent == TRUE)
+    {
+        (void) vos_sockSignalEvent(&pQueue->event);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Create the completion queue of a session, if not yet done (mutexMD held)
+ *  The consumer reads the queue without lock, it only looks at it after mdCompletionsOpen was set.
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+TRDP_ERR_T trdp_mdOpenCompletions (
+    TRDP_SESSION_PT appHandle)
+{
+    MD_COMPLETION_QUEUE_T *pQueue;
+
+    if (appHandle->pMDCompletions != NULL)
+    {
+        return TRDP_NO_ERR;
+    }
+
+    pQueue = (MD_COMPLETION_QUEUE_T *) vos_memAlloc(sizeof(MD_COMPLETION_QUEUE_T));
+    if (pQueue == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    memset(pQueue, 0, sizeof(MD_COMPLETION_QUEUE_T));
+
+    /* Without events the application has to poll */
+    pQueue->hasEvent = (vos_sockOpenEvent(&pQueue->event) == VOS_NO_ERR) ? TRUE : FALSE;
+    if (pQueue->hasEvent == FALSE)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "No completion event available, tlm_getCompletion() must be polled\n");
+    }
+    appHandle->pMDCompletions = pQueue;
+
+    /* trdp_mdGetCompletion() takes no lock, the queue is published with release semantics */
+    vos_atomicStore32(&appHandle->mdCompletionsOpen, 1u);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Fetch the next completion (consumer side, no lock taken)
+ *  The event is cleared only after the ring was found empty and checked once more,
+ *  a completion queued in between signals it again.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[out]     pCompletion         the completion
+ *
+ *  @retval         TRDP_NO_ERR         a completion was fetched
+ *  @retval         TRDP_NODATA_ERR     nothing completed
+ */
+TRDP_ERR_T trdp_mdGetCompletion (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_MD_COMPLETION_T    *pCompletion)
+{
+    MD_COMPLETION_QUEUE_T   *pQueue;
+    UINT32                  head;
+    UINT32                  tail;
+
+    if (vos_atomicLoad32(&appHandle->mdCompletionsOpen) == 0u)
+    {
+        return TRDP_NODATA_ERR;
+    }
+    pQueue = appHandle->pMDCompletions;
+
+    head    = pQueue->head;
+    tail    = vos_atomicLoad32(&pQueue->tail);
+    if ((head == tail) && (pQueue->hasEvent == TRUE))
+    {
+        (void) vos_sockClearEvent(&pQueue->event);
+        tail = vos_atomicLoad32(&pQueue->tail);
+    }
+    if (head == tail)
+    {
+        return TRDP_NODATA_ERR;
+    }
+
+    *pCompletion = pQueue->entry[head & (TRDP_MD_COMPLETION_QUEUE_SIZE - 1u)];
+    vos_atomicStore32(&pQueue->head, head + 1u);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Release the completion queue of a session and all completions not fetched
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_mdCloseCompletions (
+    TRDP_SESSION_PT appHandle)
+{
+    MD_COMPLETION_QUEUE_T   *pQueue = appHandle->pMDCompletions;
+    UINT32                  head;
+
+    if (pQueue == NULL)
+    {
+        return;
+    }
+    vos_atomicStore32(&appHandle->mdCompletionsOpen, 0u);
+
+    for (head = pQueue->head; head != pQueue->tail; head++)
+    {
+        if (pQueue->entry[head & (TRDP_MD_COMPLETION_QUEUE_SIZE - 1u)].pData != NULL)
+        {
+            vos_memFree(pQueue->entry[head & (TRDP_MD_COMPLETION_QUEUE_SIZE - 1u)].pData);
+        }
+    }
+    while (pQueue->pOverflowHead != NULL)
+    {
+        MD_COMPLETION_ELE_T *pNext = pQueue->pOverflowHead->pNext;
+
+        if (pQueue->pOverflowHead->completion.pData != NULL)
+        {
+            vos_memFree(pQueue->pOverflowHead->completion.pData);
+        }
+        vos_memFree(pQueue->pOverflowHead);
+        pQueue->pOverflowHead = pNext;
+    }
+    if (pQueue->hasEvent == TRUE)
+    {
+        vos_sockCloseEvent(&pQueue->event);
+    }
+    vos_memFree(pQueue);
+    appHandle->pMDCompletions = NULL;
+}
+
+/**********************************************************************************************************************/
+/** Check if a request wants to be informed about replies and failures
+ *
+ *  @param[in]      pElement        the caller's MD element
+ *
+ *  @retval         TRUE            callback, completion queue or result set
+ */
+static BOOL8 trdp_mdWantsResult (const MD_ELE_T *pElement)
+{
+    return ((pElement->pfCbFunction != NULL)
+            || (pElement->asyncHandle != 0u)
+            || (pElement->pAggregate != NULL)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Find the hash slot of a replier of an aggregated request
+ *  Open addressing with linear probing, the table has twice the capacity of the reply set.
+ *
+ *  @param[in]      pAggregate      the collected replies
+ *  @param[in]      srcIpAddr       the replier
+ *
+ *  @retval         slot holding srcIpAddr or the empty slot to insert it
+ */
+static UINT32 trdp_mdAggregateSlot (const MD_AGGREGATE_T *pAggregate, TRDP_IP_ADDR_T srcIpAddr)
+{
+    UINT32  mask    = 2u * pAggregate->capacity - 1u;
+    UINT32  slot    = srcIpAddr * 2654435761u;
+
+    for (slot = (slot ^ (slot >> 16)) & mask;
+         (pAggregate->pSlots[slot] != 0u)
+         && (pAggregate->pReplies[pAggregate->pSlots[slot] - 1u].srcIpAddr != srcIpAddr);
+         slot = (slot + 1u) & mask)
+    {
+        ;
+    }
+    return slot;
+}
+
+/**********************************************************************************************************************/
+/** Check if a replier did already answer an aggregated request
+ *
+ *  @param[in]      pAggregate      the collected replies
+ *  @param[in]      srcIpAddr       the replier
+ *
+ *  @retval         TRUE            a reply from srcIpAddr is in the set
+ */
+static BOOL8 trdp_mdAggregateHasSource (const MD_AGGREGATE_T *pAggregate, TRDP_IP_ADDR_T srcIpAddr)
+{
+    if (pAggregate->numReplies == 0u)
+    {
+        return FALSE;
+    }
+    return (pAggregate->pSlots[trdp_mdAggregateSlot(pAggregate, srcIpAddr)] != 0u) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Pass the result set of an aggregated request to the application, once
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pMdItem         the caller's MD element
+ *  @param[in]      resultCode      TRDP_NO_ERR if all expected replies arrived
+ */
+static void trdp_mdAggregateDone (TRDP_SESSION_PT   appHandle,
+                                  const MD_ELE_T    *pMdItem,
+                                  TRDP_ERR_T        resultCode)
+{
+    MD_AGGREGATE_T      *pAggregate = pMdItem->pAggregate;
+    TRDP_MD_REPLY_SET_T replySet;
+
+    if (pAggregate->delivered == TRUE)
+    {
+        return;
+    }
+    pAggregate->delivered = TRUE;
+
+    memset(&replySet, 0, sizeof(replySet));
+    memcpy(replySet.sessionId, pMdItem->sessionID, TRDP_SESS_ID_SIZE);
+    replySet.comId          = pAggregate->comId;
+    replySet.pUserRef       = pMdItem->pUserRef;
+    replySet.resultCode     = resultCode;
+    replySet.numExpReplies  = pMdItem->numExpReplies;
+    replySet.numReplies     = pAggregate->numReplies;
+    replySet.numDuplicates  = pAggregate->numDuplicates;
+    replySet.pReplies       = pAggregate->pReplies;
+
+    pAggregate->pfCbFunction(appHandle->mdDefault.pRefCon, appHandle, &replySet);
+}
+
+/**********************************************************************************************************************/
+/** Add the reply just received to the result set of an aggregated request
+ *  The set is delivered as soon as the expected number of repliers answered.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in,out]  pMdItem         the caller's MD element, holding the reply in pPacket
+ */
+static void trdp_mdAggregateReply (TRDP_SESSION_PT appHandle, MD_ELE_T *pMdItem)
+{
+    MD_AGGREGATE_T  *pAggregate = pMdItem->pAggregate;
+    TRDP_MD_REPLY_T *pReply;
+    TRDP_TIME_T     now;
+    INT32           replyStatus;
+
+    if ((pAggregate->delivered == TRUE) || (pMdItem->pPacket == NULL))
+    {
+        return;
+    }
+
+    if (pAggregate->numReplies == pAggregate->capacity)
+    {
+        UINT32          capacity    = (pAggregate->capacity == 0u) ? 8u : (2u * pAggregate->capacity);
+        TRDP_MD_REPLY_T *pReplies   = (TRDP_MD_REPLY_T *) vos_memAlloc(capacity * sizeof(TRDP_MD_REPLY_T));
+        BOOL8           *pConfirmed = (BOOL8 *) vos_memAlloc(capacity * sizeof(BOOL8));
+        UINT32          *pSlots     = (UINT32 *) vos_memAlloc(2u * capacity * sizeof(UINT32));
+        UINT32          lIndex;
+
+        if ((pReplies == NULL) || (pConfirmed == NULL) || (pSlots == NULL))
+        {
+            if (pReplies != NULL)
+            {
+                vos_memFree(pReplies);
+            }
+            if (pConfirmed != NULL)
+            {
+                vos_memFree(pConfirmed);
+            }
+            if (pSlots != NULL)
+            {
+                vos_memFree(pSlots);
+            }
+            vos_printLogStr(VOS_LOG_ERROR, "Reply dropped from result set, out of memory\n");
+            return;
+        }
+        if (pAggregate->pReplies != NULL)
+        {
+            memcpy(pReplies, pAggregate->pReplies, pAggregate->numReplies * sizeof(TRDP_MD_REPLY_T));
+            memcpy(pConfirmed, pAggregate->pConfirmed, pAggregate->numReplies * sizeof(BOOL8));
+            vos_memFree(pAggregate->pReplies);
+            vos_memFree(pAggregate->pConfirmed);
+            vos_memFree(pAggregate->pSlots);
+        }
+        pAggregate->pReplies    = pReplies;
+        pAggregate->pConfirmed  = pConfirmed;
+        pAggregate->pSlots      = pSlots;
+        pAggregate->capacity    = capacity;
+
+        /* rehash, vos_memAlloc() returns cleared memory */
+        for (lIndex = 0u; lIndex < pAggregate->numReplies; lIndex++)
+        {
+            pSlots[trdp_mdAggregateSlot(pAggregate, pReplies[lIndex].srcIpAddr)] = lIndex + 1u;
+        }
+    }
+
+    pReply = &pAggregate->pReplies[pAggregate->numReplies];
+    memset(pReply, 0, sizeof(TRDP_MD_REPLY_T));
+    pAggregate->pConfirmed[pAggregate->numReplies] = FALSE;
+    pAggregate->pSlots[trdp_mdAggregateSlot(pAggregate, pMdItem->addr.srcIpAddr)] = pAggregate->numReplies + 1u;
+
+    vos_getTime(&now);
+    vos_subTime(&now, &pAggregate->sendTime);
+    pReply->latency     = (UINT32) now.tv_sec * 1000000u + (UINT32) now.tv_usec;
+    pReply->srcIpAddr   = pMdItem->addr.srcIpAddr;
+    pReply->msgType     = (TRDP_MSG_T) vos_ntohs(pMdItem->pPacket->frameHead.msgType);
+    replyStatus         = (INT32) vos_ntohl((UINT32)pMdItem->pPacket->frameHead.replyStatus);
+    if (replyStatus >= 0)
+    {
+        pReply->userStatus  = (UINT16) replyStatus;
+        pReply->replyStatus = TRDP_REPLY_OK;
+    }
+    else
+    {
+        pReply->replyStatus = (TRDP_REPLY_STATUS_T) replyStatus;
+    }
+    vos_strncpy(pReply->srcUserURI, (CHAR8 *) pMdItem->pPacket->frameHead.sourceURI, TRDP_MAX_URI_USER_LEN);
+
+    pReply->dataSize = vos_ntohl(pMdItem->pPacket->frameHead.datasetLength);
+    if (pReply->dataSize > 0u)
+    {
+        pReply->pData = (UINT8 *) vos_memAlloc(pReply->dataSize);
+        if (pReply->pData == NULL)
+        {
+            pReply->dataSize = 0u;
+        }
+        else
+        {
+            memcpy(pReply->pData, pMdItem->pPacket->data, pReply->dataSize);
+        }
+    }
+    pAggregate->numReplies++;
+
+    /* early completion, no need to wait for the timeout;
+       the session itself ends as usual, after pending confirmations were sent */
+    if ((pMdItem->numExpReplies != 0u) && (pAggregate->numReplies >= pMdItem->numExpReplies))
+    {
+        trdp_mdAggregateDone(appHandle, pMdItem, TRDP_NO_ERR);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Free the result set of an aggregated request
+ *
+ *  @param[in]      pAggregate      the collected replies
+ */
+static void trdp_mdFreeAggregate (MD_AGGREGATE_T *pAggregate)
+{
+    UINT32 lIndex;
+
+    for (lIndex = 0u; lIndex < pAggregate->numReplies; lIndex++)
+    {
+        if (pAggregate->pReplies[lIndex].pData != NULL)
+        {
+            vos_memFree(pAggregate->pReplies[lIndex].pData);
+        }
+    }
+    if (pAggregate->pReplies != NULL)
+    {
+        vos_memFree(pAggregate->pReplies);
+        vos_memFree(pAggregate->pConfirmed);
+        vos_memFree(pAggregate->pSlots);
+    }
+    vos_memFree(pAggregate);
+}
+
+/**********************************************************************************************************************/
+/** Confirm Mq replies of an aggregated request
+ *  The caller's session keeps collecting, every confirmation is sent by an MD element of its own to the replier
+ *  as recorded in the result set. The element ends once the confirmation has been sent.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pCaller             the caller's MD element
+ *  @param[in]      srcIpAddr           replier to confirm, 0 for all Mq replies not yet confirmed
+ *  @param[in]      userStatus          Info for requester about application errors
+ *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOSESSION_ERR  no Mq reply (left) to confirm
+ */
+static TRDP_ERR_T trdp_mdConfirmAggregate (TRDP_SESSION_PT          appHandle,
+                                           MD_ELE_T                 *pCaller,
+                                           TRDP_IP_ADDR_T           srcIpAddr,
+                                           UINT16                   userStatus,
+                                           const TRDP_SEND_PARAM_T  *pSendParam)
+{
+    MD_AGGREGATE_T  *pAggregate = pCaller->pAggregate;
+    TRDP_ERR_T      errv        = TRDP_NOSESSION_ERR;
+    UINT32          lIndex      = 0u;
+    UINT32          lEnd        = pAggregate->numReplies;
+
+    if ((srcIpAddr != 0u) && (pAggregate->numReplies > 0u))
+    {
+        UINT32 slot = pAggregate->pSlots[trdp_mdAggregateSlot(pAggregate, srcIpAddr)];
+
+        lIndex  = (slot == 0u) ? lEnd : (slot - 1u);
+        lEnd    = (slot == 0u) ? lEnd : slot;
+    }
+
+    for (; lIndex < lEnd; lIndex++)
+    {
+        const TRDP_MD_REPLY_T   *pReply = &pAggregate->pReplies[lIndex];
+        MD_ELE_T                *pElement;
+
+        if ((pReply->msgType != TRDP_MSG_MQ) || (pAggregate->pConfirmed[lIndex] == TRUE))
+        {
+            continue;
+        }
+
+        pElement = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+        if (pElement == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        memset(pElement, 0, sizeof(MD_ELE_T));
+        memcpy(pElement->sessionID, pCaller->sessionID, TRDP_SESS_ID_SIZE);
+        pElement->socketIdx         = TRDP_INVALID_SOCKET_INDEX;
+        pElement->pktFlags          = pCaller->pktFlags;
+        pElement->addr.srcIpAddr    = pAggregate->srcIpAddr;
+        pElement->addr.destIpAddr   = pReply->srcIpAddr;
+        pElement->addr.etbTopoCnt   = pCaller->addr.etbTopoCnt;
+        pElement->addr.opTrnTopoCnt = pCaller->addr.opTrnTopoCnt;
+        pElement->privFlags         = TRDP_PRIV_NONE;
+        pElement->grossSize         = trdp_packetSizeMD(0u);
+        /* one reply, one confirmation: the element is done once sent */
+        pElement->numExpReplies     = 1u;
+        pElement->numReplies        = 1u;
+
+        errv = trdp_mdConnectSocket(appHandle, pSendParam, pElement->addr.srcIpAddr, pElement->addr.destIpAddr,
+                                    TRUE, pElement);
+        if (errv == TRDP_NO_ERR)
+        {
+            pElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pElement->grossSize);
+            if (pElement->pPacket == NULL)
+            {
+                trdp_releaseSocket(appHandle->ifaceMD, pElement->socketIdx, appHandle->mdDefault.connectTimeout,
+                                   FALSE, VOS_INADDR_ANY);
+                errv = TRDP_MEM_ERR;
+            }
+        }
+        if (errv != TRDP_NO_ERR)
+        {
+            trdp_mdFreeSession(pElement);
+            return errv;
+        }
+
+        trdp_mdFillStateElement(TRDP_MSG_MC, pElement);
+        trdp_mdDetailSenderPacket(TRDP_MSG_MC, userStatus, 0u, 0u, NULL, 0u, TRUE, appHandle,
+                                  pCaller->destURI, pReply->srcUserURI, pElement);
+
+        pAggregate->pConfirmed[lIndex] = TRUE;
+        pCaller->numConfirmSent++;
+    }
+    return errv;
+}
+
+/**********************************************************************************************************************/
+/** Start the sending timeout of a TCP socket, if not yet running
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      socketIdx           index into ifaceMD[]
+ */
+static void trdp_mdStartSendingTimeout (
+    TRDP_SESSION_PT appHandle,
+    INT32           socketIdx)
+{
+    if (appHandle->ifaceMD[socketIdx].tcpParams.sendNotOk == FALSE)
+    {
+        /*  Start the Sending Timeout */
+        TRDP_TIME_T tmpt_interval, tmpt_now;
+
+        tmpt_interval.tv_sec    = appHandle->mdDefault.sendingTimeout / 1000000u;
+        tmpt_interval.tv_usec   = appHandle->mdDefault.sendingTimeout % 1000000;
+
+        vos_getTime(&tmpt_now);
+        vos_addTime(&tmpt_now, &tmpt_interval);
+
+        memcpy(&appHandle->ifaceMD[socketIdx].tcpParams.sendingTimeout,
+               &tmpt_now,
+               sizeof(TRDP_TIME_T));
+
+        appHandle->ifaceMD[socketIdx].tcpParams.sendNotOk = TRUE;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Advance the state of a completely sent MD element
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            the element sent
+ */
+static void trdp_mdSendDone (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement)
+{
+    TRDP_MD_ELE_ST_T nextstate = TRDP_ST_NONE;
+
+    switch (pElement->stateEle)
+    {
+       case TRDP_ST_TX_REQUEST_ARM:
+           nextstate = TRDP_ST_TX_REQUEST_W4REPLY;
+           break;
+       case TRDP_ST_TX_REPLYQUERY_ARM:
+           nextstate = TRDP_ST_RX_REPLYQUERY_W4C;
+           break;
+       default:
+           break;
+    }
+
+    if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0)
+    {
+        TRDP_SOCKET_TCP_T *pTcp = &appHandle->ifaceMD[pElement->socketIdx].tcpParams;
+
+        pTcp->sendNotOk = FALSE;
+
+        /* Add the socket in the file descriptor*/
+        pTcp->addFileDesc = TRUE;
+        /* increment transmission counter for TCP */
+        appHandle->stats.tcpMd.numSend++;
+
+        /* The payload is not needed anymore - unless the kernel still references it */
+        trdp_mdParkExtData(pTcp, &pElement->extData);
+    }
+    else
+    {
+        /* increment transmission counter for UDP */
+        appHandle->stats.udpMd.numSend++;
+    }
+
+    if ((nextstate == TRDP_ST_TX_REQUEST_W4REPLY) && (pElement->pAggregate != NULL))
+    {
+        /* reference for the replies' latency */
+        vos_getTime(&pElement->pAggregate->sendTime);
+    }
+
+    if (nextstate == TRDP_ST_RX_REPLYQUERY_W4C)
+    {
+        /* Update timeout */
+        if (((pElement->interval.tv_sec != TRDP_MD_INFINITE_TIME) ||
+             (pElement->interval.tv_usec != TRDP_MD_INFINITE_USEC_TIME)))
+        {
+            vos_getTime(&pElement->timeToGo);
+            vos_addTime(&pElement->timeToGo, &pElement->interval);
+            vos_printLogStr(VOS_LOG_INFO, "Setting timeout for confirmation!\n");
+        }
+    }
+
+    switch (pElement->stateEle)
+    {
+       case TRDP_ST_TX_CONFIRM_ARM:
+       {
+           pElement->numConfirmSent++;
+           if (
+               (pElement->numExpReplies != 0u)
+               && ((pElement->numRepliesQuery + pElement->numReplies) >= pElement->numExpReplies)
+               && (pElement->numConfirmSent >= pElement->numRepliesQuery))
+           {
+               pElement->morituri = TRUE;
+           }
+           else
+           {
+               /* not yet all replies received OR not yet all confirmations sent */
+               if (pElement->numConfirmSent < pElement->numRepliesQuery)
+               {
+                   nextstate = TRDP_ST_TX_REQ_W4AP_CONFIRM;
+               }
+               else
+               {
+                   nextstate = TRDP_ST_TX_REQUEST_W4REPLY;
+               }
+           }
+       }
+       break;
+       case TRDP_ST_TX_NOTIFY_ARM:
+       case TRDP_ST_TX_REPLY_ARM:
+       {
+           pElement->morituri = TRUE;
+       }
+       break;
+       default:
+           ;
+    }
+    pElement->stateEle = nextstate;
+}
+
+/**********************************************************************************************************************/
+/** Abort all caller sessions using a socket which failed to send
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      socketIdx           index into ifaceMD[]
+ */
+static void trdp_mdSendFailed (
+    TRDP_SESSION_PT appHandle,
+    INT32           socketIdx)
+{
+    MD_ELE_T *iterMD_find = NULL;
+
+    /* search for existing session */
+    for (iterMD_find = appHandle->pMDSndQueue;
+         iterMD_find != NULL;
+         iterMD_find = iterMD_find->pNext)
+    {
+        if (iterMD_find->socketIdx == socketIdx)
+        {
+            iterMD_find->morituri = TRUE;
+
+            /* Execute callback for each session */
+            if (trdp_mdWantsResult(iterMD_find) == TRUE)
+            {
+                trdp_mdInvokeCallback(iterMD_find, appHandle, TRDP_TIMEOUT_ERR);
+            }
+            /* Close the socket */
+            appHandle->ifaceMD[socketIdx].tcpParams.morituri = TRUE;
+        }
+    }
+}
+
 /**********************************************************************************************************************/
 /** Sending MD messages
  *  Send the messages stored in the sendQueue
  *  Call user's callback if needed
+ *  UDP messages are sent immediately, TCP messages are appended to the outbound queue of their socket,
+ *  which is drained in order until the socket would block.
  *
  *  @param[in]      appHandle           session pointer
  */
@@ -2218,13 +3278,13 @@ TRDP_ERR_T  trdp_mdSend (
     TRDP_ERR_T  result      = TRDP_NO_ERR;
     MD_ELE_T    *iterMD     = appHandle->pMDSndQueue;
     BOOL8       firstLoop   = TRUE;
+    INT32       lIndex;
 
     /*  Find the packet which has to be sent next:
      Note: We must also check the receive queue for pending replies! */
     do
     {
         int dotx = 0;
-        TRDP_MD_ELE_ST_T nextstate = TRDP_ST_NONE;
 
         /*  Switch to receive queue */
         if (NULL == iterMD && TRUE == firstLoop)
@@ -2241,26 +3301,21 @@ TRDP_ERR_T  trdp_mdSend (
         switch (iterMD->stateEle)
         {
            case TRDP_ST_TX_NOTIFY_ARM:
-               dotx = 1;
-               break;
            case TRDP_ST_TX_REQUEST_ARM:
-               dotx         = 1;
-               nextstate    = TRDP_ST_TX_REQUEST_W4REPLY;
-               break;
            case TRDP_ST_TX_REPLY_ARM:
-               dotx = 1;
-               break;
            case TRDP_ST_TX_REPLYQUERY_ARM:
-               dotx         = 1;
-               nextstate    = TRDP_ST_RX_REPLYQUERY_W4C;
-               break;
            case TRDP_ST_TX_CONFIRM_ARM:
                dotx = 1;
                break;
            default:
                break;
         }
-        if (dotx)
+        if (dotx && (trdp_yield(&appHandle->yieldMD) == TRUE))
+        {
+            /* the reactor has more urgent work, the rest is sent in its next cycle */
+            break;
+        }
+        if (dotx && (iterMD->txQueued == FALSE))
         {
             /*    In case we're sending on an uninitialized publisher; should never happen. */
             if (iterMD->socketIdx == TRDP_INVALID_SOCKET_INDEX)
@@ -2309,179 +3364,94 @@ TRDP_ERR_T  trdp_mdSend (
                                          vos_sockId(appHandle->ifaceMD[iterMD->socketIdx].sock),
                                          (unsigned int) appHandle->mdDefault.tcpPort);
 
-                            if (appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendNotOk == FALSE)
-                            {
-                                /*  Start the Sending Timeout */
-                                TRDP_TIME_T tmpt_interval, tmpt_now;
-
-                                tmpt_interval.tv_sec    = appHandle->mdDefault.sendingTimeout / 1000000u;
-                                tmpt_interval.tv_usec   = appHandle->mdDefault.sendingTimeout % 1000000;
-
-                                vos_getTime(&tmpt_now);
-                                vos_addTime(&tmpt_now, &tmpt_interval);
-
-                                memcpy(&appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendingTimeout,
-                                       &tmpt_now,
-                                       sizeof(TRDP_TIME_T));
-
-                                appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendNotOk = TRUE;
-                            }
+                            trdp_mdStartSendingTimeout(appHandle, iterMD->socketIdx);
 
                             iterMD->morituri = TRUE;
                             iterMD = iterMD->pNext;
                             continue;
                         }
                     }
-                }
 
-                if (((iterMD->pktFlags & TRDP_FLAGS_TCP) == 0)
-                    || (((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
-                        && ((appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend == FALSE)
-                            || (iterMD->tcpParameters.msgUncomplete == TRUE))))
+                    /* Sent below, in order of arrival per connection */
+                    trdp_mdTxEnqueue(&appHandle->ifaceMD[iterMD->socketIdx], iterMD);
+                }
+                else
                 {
-
                     if (0u != iterMD->replyPort &&
                         (iterMD->pPacket->frameHead.msgType == vos_ntohs(TRDP_MSG_MP) ||
                          iterMD->pPacket->frameHead.msgType == vos_ntohs(TRDP_MSG_MQ)))
                     {
-                        result = trdp_mdSendPacket(appHandle->ifaceMD[iterMD->socketIdx].sock,
+                        result = trdp_mdSendPacket(&appHandle->ifaceMD[iterMD->socketIdx],
                                                    iterMD->replyPort,
                                                    iterMD);
                     }
                     else
                     {
-                        result = trdp_mdSendPacket(appHandle->ifaceMD[iterMD->socketIdx].sock,
+                        result = trdp_mdSendPacket(&appHandle->ifaceMD[iterMD->socketIdx],
                                                    appHandle->mdDefault.udpPort,
                                                    iterMD);
                     }
 
                     if (result == TRDP_NO_ERR)
                     {
-                        if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
-                        {
-                            appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend = FALSE;
-                            iterMD->tcpParameters.msgUncomplete = FALSE;
-                            appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendNotOk = FALSE;
-
-                            /* Add the socket in the file descriptor*/
-                            appHandle->ifaceMD[iterMD->socketIdx].tcpParams.addFileDesc = TRUE;
-                            /* increment transmission counter for TCP */
-                            appHandle->stats.tcpMd.numSend++;
-                        }
-                        else
-                        {
-                            /* increment transmission counter for UDP */
-                            appHandle->stats.udpMd.numSend++;
-                        }
-
-                        if (nextstate == TRDP_ST_RX_REPLYQUERY_W4C)
-                        {
-                            /* Update timeout */
-                            if (((iterMD->interval.tv_sec != TRDP_MD_INFINITE_TIME) ||
-                                 (iterMD->interval.tv_usec != TRDP_MD_INFINITE_USEC_TIME)))
-                            {
-                                vos_getTime(&iterMD->timeToGo);
-                                vos_addTime(&iterMD->timeToGo, &iterMD->interval);
-                                vos_printLogStr(VOS_LOG_INFO, "Setting timeout for confirmation!\n");
-                            }
-                        }
-
-                        switch (iterMD->stateEle)
-                        {
-                           case TRDP_ST_TX_CONFIRM_ARM:
-                           {
-                               iterMD->numConfirmSent++;
-                               if (
-                                   (iterMD->numExpReplies != 0u)
-                                   && ((iterMD->numRepliesQuery + iterMD->numReplies) >= iterMD->numExpReplies)
-                                   && (iterMD->numConfirmSent >= iterMD->numRepliesQuery))
-                               {
-                                   iterMD->morituri = TRUE;
-                               }
-                               else
-                               {
-                                   /* not yet all replies received OR not yet all confirmations sent */
-                                   if (iterMD->numConfirmSent < iterMD->numRepliesQuery)
-                                   {
-                                       nextstate = TRDP_ST_TX_REQ_W4AP_CONFIRM;
-                                   }
-                                   else
-                                   {
-                                       nextstate = TRDP_ST_TX_REQUEST_W4REPLY;
-                                   }
-                               }
-                           }
-                           break;
-                           case TRDP_ST_TX_NOTIFY_ARM:
-                           case TRDP_ST_TX_REPLY_ARM:
-                           {
-                               iterMD->morituri = TRUE;
-                           }
-                           break;
-                           default:
-                               ;
-                        }
-                        iterMD->stateEle = nextstate;
+                        trdp_mdSendDone(appHandle, iterMD);
                     }
-                    else
+                    else if (result != TRDP_IO_ERR)
                     {
-                        if (result == TRDP_IO_ERR)
-                        {
-                            /* Send uncompleted */
-                            if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
-                            {
-                                appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend = TRUE;
-                                iterMD->tcpParameters.msgUncomplete = TRUE;
+                        trdp_mdSendFailed(appHandle, iterMD->socketIdx);
+                    }
+                }
+            }
+        }
+        iterMD = iterMD->pNext;
+    }
+    while (TRUE); /*lint !e506 */
 
-                                if (appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendNotOk == FALSE)
-                                {
-                                    /*  Start the Sending Timeout */
-                                    TRDP_TIME_T tmpt_interval, tmpt_now;
+    /*  Drain the outbound TCP queues: one gather write per message, stop at the first incomplete one */
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); lIndex++)
+    {
+        TRDP_SOCKETS_T *pSocket = &appHandle->ifaceMD[lIndex];
 
-                                    tmpt_interval.tv_sec    = appHandle->mdDefault.sendingTimeout / 1000000u;
-                                    tmpt_interval.tv_usec   = appHandle->mdDefault.sendingTimeout % 1000000;
+        if ((pSocket->sock == VOS_INVALID_SOCKET) || (pSocket->type != TRDP_SOCK_MD_TCP))
+        {
+            continue;
+        }
 
-                                    vos_getTime(&tmpt_now);
-                                    vos_addTime(&tmpt_now, &tmpt_interval);
+        trdp_mdReapZeroCopy(pSocket);
 
-                                    memcpy(&appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendingTimeout,
-                                           &tmpt_now,
-                                           sizeof(TRDP_TIME_T));
+        while ((pSocket->tcpParams.pTxHead != NULL) && (pSocket->tcpParams.morituri == FALSE)
+               && (trdp_yield(&appHandle->yieldMD) == FALSE))
+        {
+            iterMD = pSocket->tcpParams.pTxHead;
 
-                                    appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendNotOk = TRUE;
-                                }
-                            }
-                        }
-                        else
-                        {
-                            MD_ELE_T *iterMD_find = NULL;
+            result = trdp_mdSendPacket(pSocket, appHandle->mdDefault.tcpPort, iterMD);
 
-                            /* search for existing session */
-                            for (iterMD_find = appHandle->pMDSndQueue;
-                                 iterMD_find != NULL;
-                                 iterMD_find = iterMD_find->pNext)
-                            {
-                                if (iterMD_find->socketIdx == iterMD->socketIdx)
-                                {
-                                    iterMD_find->morituri = TRUE;
-
-                                    /* Execute callback for each session */
-                                    if (iterMD_find->pfCbFunction != NULL)
-                                    {
-                                        trdp_mdInvokeCallback(iterMD_find, appHandle, TRDP_TIMEOUT_ERR);
-                                    }
-                                    /* Close the socket */
-                                    appHandle->ifaceMD[iterMD->socketIdx].tcpParams.morituri = TRUE;
-                                }
-                            }
-                        }
-                    }
+            if (result == TRDP_NO_ERR)
+            {
+                pSocket->tcpParams.pTxHead = iterMD->pTxNext;
+                if (pSocket->tcpParams.pTxHead == NULL)
+                {
+                    pSocket->tcpParams.pTxTail = NULL;
+                }
+                iterMD->pTxNext     = NULL;
+                iterMD->txQueued    = FALSE;
+                trdp_mdSendDone(appHandle, iterMD);
+            }
+            else
+            {
+                if (result == TRDP_IO_ERR)
+                {
+                    /* Send uncompleted */
+                    trdp_mdStartSendingTimeout(appHandle, lIndex);
                 }
+                else
+                {
+                    trdp_mdSendFailed(appHandle, lIndex);
+                }
+                break;
             }
         }
-        iterMD = iterMD->pNext;
     }
-    while (TRUE); /*lint !e506 */
 
     trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, TRUE);
 
@@ -2626,6 +3596,132 @@ void trdp_mdCheckPending (
     }
 }
 
+/**********************************************************************************************************************/
+/** Take over a deadline if it is earlier than the one found so far
+ *  A deadline which has already passed is not necessarily handled by the next processing (e.g. in states without
+ *  time-out handling), it is polled to avoid busy waiting.
+ *
+ *  @param[in]      pDue                deadline to merge
+ *  @param[in]      pNow                current time
+ *  @param[in]      pPoll               poll time for passed deadlines
+ *  @param[in,out]  pNextJob            earliest deadline so far (cleared: none)
+ */
+static void trdp_mdMergeJob (
+    const TRDP_TIME_T   *pDue,
+    const TRDP_TIME_T   *pNow,
+    const TRDP_TIME_T   *pPoll,
+    TRDP_TIME_T         *pNextJob)
+{
+    if (!timercmp(pDue, pNow, >))
+    {
+        pDue = pPoll;
+    }
+    if (!timerisset(pNextJob) || timercmp(pDue, pNextJob, <))
+    {
+        *pNextJob = *pDue;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Find the earliest MD event of a session
+ *  Covers the time-outs of all sessions, the connection and sending time-outs of the TCP sockets and
+ *  messages waiting to be sent. Messages trdp_mdSend() could not send, a TCP socket which could not take all of
+ *  its outbound queue, closing TCP sockets waiting for zero-copy completions and completions which did not fit into
+ *  the completion ring are polled with TRDP_MD_MAN_CYCLE_TIME.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pNow                current time
+ *  @param[in,out]  pNextJob            earliest event so far (cleared: none), updated if an earlier one is found
+ */
+void trdp_mdNextJob (
+    const TRDP_SESSION_T    *appHandle,
+    const TRDP_TIME_T       *pNow,
+    TRDP_TIME_T             *pNextJob)
+{
+    const MD_ELE_T  *iterMD;
+    TRDP_TIME_T     poll    = {0, TRDP_MD_MAN_CYCLE_TIME};
+    BOOL8           retry   = FALSE;
+    INT32           lIndex;
+    int             loop;
+
+    vos_addTime(&poll, pNow);
+
+    for (loop = 0; loop < 2; loop++)
+    {
+        for (iterMD = (loop == 0) ? appHandle->pMDSndQueue : appHandle->pMDRcvQueue;
+             iterMD != NULL;
+             iterMD = iterMD->pNext)
+        {
+            if (iterMD->morituri == TRUE)
+            {
+                continue;   /* removed by the next trdp_mdCheckTimeouts() */
+            }
+            switch (iterMD->stateEle)
+            {
+               case TRDP_ST_TX_NOTIFY_ARM:
+               case TRDP_ST_TX_REQUEST_ARM:
+               case TRDP_ST_TX_REPLY_ARM:
+               case TRDP_ST_TX_REPLYQUERY_ARM:
+               case TRDP_ST_TX_CONFIRM_ARM:
+                   if ((iterMD->txQueued == FALSE) && !(iterMD->privFlags & TRDP_REDUNDANT))
+                   {
+                       retry = TRUE;                        /* left over by trdp_mdSend()       */
+                   }
+                   break;
+               default:
+                   break;
+            }
+            if ((iterMD->interval.tv_sec != TRDP_MD_INFINITE_TIME) ||
+                (iterMD->interval.tv_usec != TRDP_MD_INFINITE_USEC_TIME))
+            {
+                trdp_mdMergeJob(&iterMD->timeToGo, pNow, &poll, pNextJob);
+            }
+        }
+    }
+
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_UDP); lIndex++)
+    {
+        const TRDP_SOCKETS_T *pSocket = &appHandle->ifaceMD[lIndex];
+
+        if ((pSocket->sock == VOS_INVALID_SOCKET)
+            || (pSocket->type != TRDP_SOCK_MD_TCP))
+        {
+            continue;
+        }
+        if (timerisset(&pSocket->tcpParams.zcLingerEnd))
+        {
+            retry = TRUE;                                   /* closed when the kernel released the payloads */
+        }
+        if (pSocket->rcvMostly == TRUE)
+        {
+            continue;
+        }
+        if ((pSocket->usage == 0)
+            && timerisset(&pSocket->tcpParams.connectionTimeout))
+        {
+            trdp_mdMergeJob(&pSocket->tcpParams.connectionTimeout, pNow, &poll, pNextJob);
+        }
+        if (pSocket->tcpParams.sendNotOk == TRUE)
+        {
+            trdp_mdMergeJob(&pSocket->tcpParams.sendingTimeout, pNow, &poll, pNextJob);
+        }
+        if (pSocket->tcpParams.pTxHead != NULL)
+        {
+            retry = TRUE;
+        }
+    }
+
+    if ((appHandle->pMDCompletions != NULL)
+        && (appHandle->pMDCompletions->pOverflowHead != NULL))
+    {
+        retry = TRUE;
+    }
+    if (retry == TRUE)
+    {
+        trdp_mdMergeJob(&poll, pNow, &poll, pNextJob);
+    }
+}
+
 
 /**********************************************************************************************************************/
 /** Checking receive connection requests and data
@@ -2892,6 +3988,11 @@ void  trdp_mdCheckListenSocks (
             VOS_FD_ISSET(appHandle->ifaceMD[lIndex].sock, (VOS_FDS_T *)pRfds) != 0) /*lint !e573 signed/unsigned division in
                                                                              macro */
         {
+            if (trdp_yield(&appHandle->yieldMD) == TRUE)
+            {
+                /* the reactor has more urgent work, the sockets left stay ready */
+                break;
+            }
             if (pCount != NULL)
             {
                 (*pCount)--;
@@ -2967,6 +4068,14 @@ void  trdp_mdCheckTimeouts (
         return;
     }
 
+    /*  Completions which did not fit into the ring before    */
+    if ((appHandle->pMDCompletions != NULL)
+        && (trdp_mdFlushCompletions(appHandle->pMDCompletions) == TRUE)
+        && (appHandle->pMDCompletions->hasEvent == TRUE))
+    {
+        (void) vos_sockSignalEvent(&appHandle->pMDCompletions->event);
+    }
+
     /*  Find the sessions which needs action
      Note: We must also check the receive queue for pending replies! */
     do
@@ -3004,7 +4113,7 @@ void  trdp_mdCheckTimeouts (
             if (TRUE == timeOut)    /* Notify user  */
             {
                 /* Execute callback */
-                if (iterMD->pfCbFunction != NULL)
+                if (trdp_mdWantsResult(iterMD) == TRUE)
                 {
                     trdp_mdInvokeCallback(iterMD, appHandle, resultCode);
                 }
@@ -3065,7 +4174,7 @@ void  trdp_mdCheckTimeouts (
                             iterMD_find->morituri = TRUE;
 
                             /* Execute callback for each session */
-                            if (iterMD_find->pfCbFunction != NULL)
+                            if (trdp_mdWantsResult(iterMD_find) == TRUE)
                             {
                                 trdp_mdInvokeCallback(iterMD_find, appHandle, TRDP_TIMEOUT_ERR);
                             }
@@ -3270,6 +4379,7 @@ static void trdp_mdDetailSenderPacket (const TRDP_MSG_T         msgType,
  *  @param[in]      pData               pointer to packet data / dataset
  *  @param[in]      dataSize            size of packet data
  *  @param[in]      pSrcURI          pointer to source URI, can be set by user
+ *  @param[in]      pExtData            application owned payload (tlm_replyNoCopy), NULL to copy pData
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
@@ -3285,7 +4395,8 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                          const TRDP_SEND_PARAM_T    *pSendParam,
                          const UINT8                *pData,
                          UINT32                     dataSize,
-                         const TRDP_URI_USER_T      srcURI)
+                         const TRDP_URI_USER_T      srcURI,
+                         const TRDP_MD_EXT_DATA_T   *pExtData)
 {
     TRDP_IP_ADDR_T  srcIpAddr;
     TRDP_IP_ADDR_T  destIpAddr;
@@ -3365,15 +4476,24 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                                             pSenderElement);
                 if ( errv == TRDP_NO_ERR )
                 {
-                    if ( NULL != pSenderElement->pPacket )
-                    {
-                        vos_memFree(pSenderElement->pPacket);
-                        pSenderElement->pPacket = NULL;
-                    }
-                    /* allocate a buffer for the data   */
-                    pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
+                    /* An application owned payload is referenced over TCP, only - otherwise it is copied */
+                    BOOL8 useExtData = (pExtData != NULL) && (pExtData->pData != NULL) &&
+                        ((pSenderElement->pktFlags & TRDP_FLAGS_TCP) != 0) &&
+                        !((pSenderElement->pktFlags & TRDP_FLAGS_MARSHALL) && (appHandle->marshall.pfCbMarshall != NULL));
+
+                    /* The request packet is kept until the reply is built, pData may point into it */
+                    MD_PACKET_T *pOldPacket = pSenderElement->pPacket;
+
+                    /* allocate a buffer for the data (or the header only)   */
+                    pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc((useExtData == TRUE) ?
+                                                                           (UINT32) sizeof(MD_HEADER_T) :
+                                                                           pSenderElement->grossSize);
                     if ( NULL == pSenderElement->pPacket )
                     {
+                        if ( NULL != pOldPacket )
+                        {
+                            vos_memFree(pOldPacket);
+                        }
                         vos_memFree(pSenderElement);
                         pSenderElement = NULL;
                         errv = TRDP_MEM_ERR;
@@ -3384,7 +4504,7 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                                                   replyStatus,
                                                   timeout,
                                                   sequenceCounter,
-                                                  pData,
+                                                  (useExtData == TRUE) ? NULL : pData,
                                                   dataSize,
                                                   newSession,
                                                   appHandle,
@@ -3393,6 +4513,20 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                                                         srcURI,
                                                   destURI,
                                                   pSenderElement);
+                        if (useExtData == TRUE)
+                        {
+                            pSenderElement->extData = *pExtData;
+                        }
+                        else if (pExtData != NULL)
+                        {
+                            /* already copied, hand it back at once */
+                            TRDP_MD_EXT_DATA_T extData = *pExtData;
+                            trdp_mdReleaseExtData(&extData);
+                        }
+                        if ( NULL != pOldPacket )
+                        {
+                            vos_memFree(pOldPacket);
+                        }
                         errv = TRDP_NO_ERR;
                     }
                 }
@@ -3405,6 +4539,11 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
         errv = TRDP_PARAM_ERR;
     }
 
+    if (errv == TRDP_NO_ERR)
+    {
+        trdp_mdWakeWorker(appHandle);
+    }
+
     /* Release mutex */
     if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
     {
@@ -3442,6 +4581,9 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
  *  @param[in]      dataSize            size of packet data
  *  @param[in]      srcURI              only functional group of source URI
  *  @param[in]      destURI             only functional group of destination URI
+ *  @param[out]     pHandle             NULL: report to pfCbFunction, else handle of the asynchronous request,
+ *                                      its outcome is queued for tlm_getCompletion()
+ *  @param[in]      pfAggregate         NULL: report each reply, else collect the replies into one result set
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
@@ -3466,7 +4608,9 @@ TRDP_ERR_T trdp_mdCall (
     const UINT8             *pData,
     UINT32                  dataSize,
     const TRDP_URI_USER_T   srcURI,
-    const TRDP_URI_USER_T   destURI)
+    const TRDP_URI_USER_T   destURI,
+    TRDP_MD_HANDLE_T        *pHandle,
+    TRDP_MD_AGGREGATE_CALLBACK_T pfAggregate)
 {
     TRDP_ERR_T  errv = TRDP_NO_ERR;
     MD_ELE_T    *pSenderElement = NULL;
@@ -3486,6 +4630,15 @@ TRDP_ERR_T trdp_mdCall (
         return TRDP_MUTEX_ERR;
     }
 
+    if ((pHandle != NULL) && (trdp_mdOpenCompletions(appHandle) != TRDP_NO_ERR))
+    {
+        if ( vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR )
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "vos_mutexUnlock() failed\n");
+        }
+        return TRDP_MEM_ERR;
+    }
+
     /* set correct source IP address */
     if ( srcIpAddr == 0u )
     {
@@ -3505,6 +4658,26 @@ TRDP_ERR_T trdp_mdCall (
         pSenderElement->pfCbFunction =
             (pfCbFunction == NULL) ? appHandle->mdDefault.pfCbFunction : pfCbFunction;
 
+        if (pfAggregate != NULL)
+        {
+            pSenderElement->pfCbFunction    = NULL;
+            pSenderElement->pAggregate      = (MD_AGGREGATE_T *) vos_memAlloc(sizeof(MD_AGGREGATE_T));
+            if (pSenderElement->pAggregate == NULL)
+            {
+                vos_memFree(pSenderElement);
+                pSenderElement = NULL;
+                if ( vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR )
+                {
+                    vos_printLogStr(VOS_LOG_ERROR, "vos_mutexUnlock() failed\n");
+                }
+                return TRDP_MEM_ERR;
+            }
+            pSenderElement->pAggregate->pfCbFunction    = pfAggregate;
+            pSenderElement->pAggregate->comId           = comId;
+            pSenderElement->pAggregate->srcIpAddr       = srcIpAddr;
+            vos_getTime(&pSenderElement->pAggregate->sendTime);
+        }
+
         /* add userRef, if supplied */
         if ( pUserRef != NULL )
         {
@@ -3614,6 +4787,17 @@ TRDP_ERR_T trdp_mdCall (
                                           destURI,
                                           pSenderElement);
                 errv = TRDP_NO_ERR;
+
+                if (pHandle != NULL)
+                {
+                    /* 0 marks callback mode, skip it on wrap-around */
+                    if (++appHandle->lastMDHandle == 0u)
+                    {
+                        ++appHandle->lastMDHandle;
+                    }
+                    pSenderElement->asyncHandle = appHandle->lastMDHandle;
+                    *pHandle = appHandle->lastMDHandle;
+                }
             }
         }
     }
@@ -3629,6 +4813,11 @@ TRDP_ERR_T trdp_mdCall (
         pSenderElement = NULL;
     }
 
+    if (errv == TRDP_NO_ERR)
+    {
+        trdp_mdWakeWorker(appHandle);
+    }
+
     /* Release mutex */
     if ( vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR )
     {
@@ -3646,6 +4835,8 @@ TRDP_ERR_T trdp_mdCall (
  *
  *  @param[in]      appHandle           the handle returned by tlc_init
  *  @param[in]      pSessionId          Session ID returned by request
+ *  @param[in]      replierIpAddr       replier to confirm, 0: the replier of the session or all repliers of an
+ *                                      aggregated request
  *  @param[in]      userStatus          Info for requester about application errors
  *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
  *
@@ -3657,6 +4848,7 @@ TRDP_ERR_T trdp_mdCall (
 TRDP_ERR_T trdp_mdConfirm (
     TRDP_APP_SESSION_T      appHandle,
     const TRDP_UUID_T       *pSessionId,
+    TRDP_IP_ADDR_T          replierIpAddr,
     UINT16                  userStatus,
     const TRDP_SEND_PARAM_T *pSendParam)
 {
@@ -3682,13 +4874,35 @@ TRDP_ERR_T trdp_mdConfirm (
 
     vos_printLogStr(VOS_LOG_INFO, "MD TRDP_MSG_MC\n");
 
-    if ( pSessionId )
+    /* Replies collected by an aggregated request are confirmed per source */
+    for (pSenderElement = (pSessionId != NULL) ? appHandle->pMDSndQueue : NULL;
+         pSenderElement != NULL;
+         pSenderElement = pSenderElement->pNext)
+    {
+        if ((pSenderElement->pAggregate != NULL)
+            && (memcmp(pSenderElement->sessionID, pSessionId, TRDP_SESS_ID_SIZE) == 0))
+        {
+            break;
+        }
+    }
+
+    if (pSenderElement != NULL)
+    {
+        errv = trdp_mdConfirmAggregate(appHandle, pSenderElement, replierIpAddr, userStatus, pSendParam);
+    }
+    else if ( pSessionId )
     {
         errv = trdp_mdLookupElement((MD_ELE_T *)appHandle->pMDSndQueue,
                                     TRDP_ST_TX_REQ_W4AP_CONFIRM,
                                     (const UINT8 *)pSessionId,
                                     &pSenderElement);
 
+        if ((TRDP_NO_ERR == errv) && (NULL != pSenderElement)
+            && (replierIpAddr != 0u) && (replierIpAddr != pSenderElement->addr.srcIpAddr))
+        {
+            errv = TRDP_PARAM_ERR;
+        }
+
         if ( TRDP_NO_ERR == errv && NULL != pSenderElement )
         {
 
@@ -3764,6 +4978,11 @@ TRDP_ERR_T trdp_mdConfirm (
     {
         errv = TRDP_PARAM_ERR;
     }
+    if (errv == TRDP_NO_ERR)
+    {
+        trdp_mdWakeWorker(appHandle);
+    }
+
     /* Release mutex */
     if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
     {
@@ -3775,3 +4994,247 @@ TRDP_ERR_T trdp_mdConfirm (
     }
     return errv;    /*lint !e438 unused pSenderElement */
 }
+
+/**********************************************************************************************************************/
+/** MD worker thread of a session
+ *  Waits for MD sockets and for the wake-up event, then does what tlm_process() would do.
+ *
+ *  @param[in]      pArg            session pointer
+ *
+ *  @retval         NULL
+ */
+static void *trdp_mdWorkerThread (void *pArg)
+{
+    TRDP_SESSION_PT appHandle   = (TRDP_SESSION_PT) pArg;
+    MD_WORKER_T     *pWorker    = appHandle->pMDWorker;
+    TRDP_FDS_T      rfds;
+    TRDP_SOCK_T     noDesc;
+    TRDP_TIME_T     timeOut;
+    TRDP_TIME_T     now;
+    TRDP_TIME_T     nextJob;
+    INT32           rv;
+    TRDP_ERR_T      err;
+
+    while (vos_atomicLoad32(&pWorker->stop) == 0u)
+    {
+        VOS_FD_ZERO((VOS_FDS_T *)&rfds);
+        noDesc = VOS_INVALID_SOCKET;
+        vos_clearTime(&nextJob);
+
+        if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
+        {
+            break;
+        }
+        trdp_mdCheckPending(appHandle, &rfds, &noDesc);
+        vos_getTime(&now);
+        trdp_mdNextJob(appHandle, &now, &nextJob);
+        (void) vos_mutexUnlock(appHandle->mutexMD);
+
+        if (pWorker->hasEvent == TRUE)
+        {
+            VOS_FD_SET(pWorker->event.rdSock, (VOS_FDS_T *)&rfds); /*lint !e573 !e505
+                                                                signed/unsigned division in macro /
+                                                                Redundant left argument to comma */
+            if ((vos_sockCmp(pWorker->event.rdSock, noDesc) == 1) || (noDesc == VOS_INVALID_SOCKET))
+            {
+                noDesc = pWorker->event.rdSock;
+            }
+        }
+
+        /* Sleep until the next time-out, new messages signal the event. Without event, poll as tlm_process() would */
+        timeOut.tv_sec  = 0;
+        timeOut.tv_usec = TRDP_MD_MAN_CYCLE_TIME;
+        if (pWorker->hasEvent == TRUE)
+        {
+            timeOut.tv_sec  = 1;
+            timeOut.tv_usec = 0;
+            if (timerisset(&nextJob))
+            {
+                if (vos_cmpTime(&nextJob, &now) <= 0)
+                {
+                    vos_clearTime(&timeOut);
+                }
+                else
+                {
+                    vos_subTime(&nextJob, &now);
+                    if (vos_cmpTime(&nextJob, &timeOut) < 0)
+                    {
+                        timeOut = nextJob;
+                    }
+                }
+            }
+        }
+        rv = vos_select(noDesc, (VOS_FDS_T *)&rfds, NULL, NULL, &timeOut);
+
+        if (vos_atomicLoad32(&pWorker->stop) != 0u)
+        {
+            break;
+        }
+        if ((rv > 0) && (pWorker->hasEvent == TRUE)
+            && VOS_FD_ISSET(pWorker->event.rdSock, (VOS_FDS_T *)&rfds)) /*lint !e573 !e505
+                                                                    signed/unsigned division in macro /
+                                                                    Redundant left argument to comma */
+        {
+            (void) vos_sockClearEvent(&pWorker->event);
+            rv--;
+        }
+
+        if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
+        {
+            break;
+        }
+
+        err = trdp_mdSend(appHandle);
+        if ((err != TRDP_NO_ERR) && (err != TRDP_IO_ERR))
+        {
+            vos_printLog(VOS_LOG_ERROR, "trdp_mdSend() failed (Err: %d)\n", err);
+        }
+
+        if (rv > 0)
+        {
+            trdp_mdCheckListenSocks(appHandle, &rfds, &rv);
+        }
+        else if (rv < 0)
+        {
+            /* a socket was closed while we were waiting, let the stack poll once */
+            trdp_mdCheckListenSocks(appHandle, NULL, NULL);
+        }
+
+        trdp_mdCheckTimeouts(appHandle);
+
+        (void) vos_mutexUnlock(appHandle->mutexMD);
+    }
+
+    vos_semaGive(pWorker->stopped);
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Start the MD worker thread of a session
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      priority            thread priority (0 = default, 1...255 (highest))
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_STATE_ERR      worker already running
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_THREAD_ERR     thread could not be created
+ */
+TRDP_ERR_T trdp_mdStartWorker (
+    TRDP_SESSION_PT appHandle,
+    UINT8           priority)
+{
+    MD_WORKER_T *pWorker;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+
+    if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+
+    if (appHandle->pMDWorker != NULL)
+    {
+        err = TRDP_STATE_ERR;
+    }
+    else if ((pWorker = (MD_WORKER_T *) vos_memAlloc(sizeof(MD_WORKER_T))) == NULL)
+    {
+        err = TRDP_MEM_ERR;
+    }
+    else if (vos_semaCreate(&pWorker->stopped, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+    {
+        vos_memFree(pWorker);
+        err = TRDP_THREAD_ERR;
+    }
+    else
+    {
+        /* Without events queued MD waits for the next poll of the worker */
+        pWorker->hasEvent = (vos_sockOpenEvent(&pWorker->event) == VOS_NO_ERR) ? TRUE : FALSE;
+        if (pWorker->hasEvent == FALSE)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "No wake-up event available, MD worker is polling\n");
+        }
+
+        /* The worker blocks on mutexMD until we are done */
+        appHandle->pMDWorker = pWorker;
+        if (vos_threadCreate(&pWorker->thread,
+                             "trdpMDWorker",
+                             (priority == 0u) ? VOS_THREAD_POLICY_OTHER : VOS_THREAD_POLICY_FIFO,
+                             (VOS_THREAD_PRIORITY_T) priority,
+                             0u,
+                             0u,
+                             trdp_mdWorkerThread,
+                             appHandle) != VOS_NO_ERR)
+        {
+            appHandle->pMDWorker = NULL;
+            if (pWorker->hasEvent == TRUE)
+            {
+                vos_sockCloseEvent(&pWorker->event);
+            }
+            vos_semaDelete(pWorker->stopped);
+            vos_memFree(pWorker);
+            err = TRDP_THREAD_ERR;
+        }
+    }
+
+    (void) vos_mutexUnlock(appHandle->mutexMD);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Stop the MD worker thread of a session and wait until it left
+ *  Must not be called from within a callback, those run in the worker thread.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_mdStopWorker (
+    TRDP_SESSION_PT appHandle)
+{
+    MD_WORKER_T *pWorker = appHandle->pMDWorker;
+
+    if (pWorker == NULL)
+    {
+        return;
+    }
+
+    vos_atomicStore32(&pWorker->stop, 1u);
+    if (pWorker->hasEvent == TRUE)
+    {
+        (void) vos_sockSignalEvent(&pWorker->event);
+    }
+    if (vos_semaTake(pWorker->stopped, TRDP_MD_WORKER_STOP_TIMEOUT) != VOS_NO_ERR)
+    {
+        /* keep the resources, the worker might still touch them */
+        vos_printLogStr(VOS_LOG_ERROR, "MD worker did not stop\n");
+        return;
+    }
+
+    if (vos_mutexLock(appHandle->mutexMD) == VOS_NO_ERR)
+    {
+        appHandle->pMDWorker = NULL;
+        (void) vos_mutexUnlock(appHandle->mutexMD);
+    }
+    if (pWorker->hasEvent == TRUE)
+    {
+        vos_sockCloseEvent(&pWorker->event);
+    }
+    vos_semaDelete(pWorker->stopped);
+    vos_memFree(pWorker);
+}
+
+/**********************************************************************************************************************/
+/** Wake up the MD worker or the reactor, if any, because MD was queued or a socket changed (mutexMD held)
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_mdWakeWorker (
+    TRDP_SESSION_PT appHandle)
+{
+    if ((appHandle->pMDWorker != NULL) && (appHandle->pMDWorker->hasEvent == TRUE))
+    {
+        (void) vos_sockSignalEvent(&appHandle->pMDWorker->event);
+    }
+    else
+    {
+        trdp_runWake(appHandle);
+    }
+}
@@ -17,6 +17,9 @@
  /*
  * $Id$
  *
+ *      AG 2026-10-18: trdp_mdStartWorker(), trdp_mdStopWorker(), trdp_mdWakeWorker()
+ *      AG 2026-10-18: trdp_mdCall() optionally aggregating replies
+ *      AG 2026-10-18: trdp_mdCall() optionally asynchronous, completion queue functions
  *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
  *      BL 2020-07-29: Ticket #286 tlm_reply() is missing a sourceURI parameter as defined in the standard
  *     AHW 2017-11-08: Ticket #179 Max. number of retries (part of sendParam) of a MD request needs to be checked
@@ -53,6 +56,15 @@ TRDP_ERR_T  trdp_mdGetTCPSocket (
 void        trdp_mdFreeSession (
     MD_ELE_T *pMDSession);
 
+void        trdp_mdReleaseSocketQueues (
+    TRDP_SESSION_PT appHandle);
+
+BOOL8       trdp_mdZeroCopyPending (
+    TRDP_SOCKETS_T *pSocket);
+
+void        trdp_mdReleaseZeroCopy (
+    TRDP_SOCKETS_T *pSocket);
+
 TRDP_ERR_T  trdp_mdSend (
     TRDP_SESSION_PT appHandle);
 
@@ -61,6 +73,11 @@ void        trdp_mdCheckPending (
     TRDP_FDS_T          *pFileDesc,
     TRDP_SOCK_T         *pNoDesc);
 
+void        trdp_mdNextJob (
+    const TRDP_SESSION_T    *appHandle,
+    const TRDP_TIME_T       *pNow,
+    TRDP_TIME_T             *pNextJob);
+
 void trdp_mdCheckListenSocks (
     const TRDP_SESSION_PT appHandle,
     TRDP_FDS_T      *pRfds,
@@ -94,6 +111,7 @@ TRDP_ERR_T  trdp_mdCommonSend (
 
 TRDP_ERR_T trdp_mdConfirm (TRDP_APP_SESSION_T      appHandle,
                             const TRDP_UUID_T       *pSessionId,
+                            TRDP_IP_ADDR_T          replierIpAddr,
                             UINT16                  userStatus,
                             const TRDP_SEND_PARAM_T *pSendParam);
 
@@ -106,7 +124,8 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T        msgType,
                          const TRDP_SEND_PARAM_T *pSendParam,
                          const UINT8             *pData,
                          UINT32                  dataSize,
-                         const TRDP_URI_USER_T   srcURI);
+                         const TRDP_URI_USER_T   srcURI,
+                         const TRDP_MD_EXT_DATA_T *pExtData);
 
 TRDP_ERR_T trdp_mdCall (const TRDP_MSG_T        msgType,
                         TRDP_APP_SESSION_T      appHandle,
@@ -126,5 +145,27 @@ TRDP_ERR_T trdp_mdCall (const TRDP_MSG_T        msgType,
                         const UINT8             *pData,
                         UINT32                  dataSize,
                         const TRDP_URI_USER_T   srcURI,
-                        const TRDP_URI_USER_T   destURI);
+                        const TRDP_URI_USER_T   destURI,
+                        TRDP_MD_HANDLE_T        *pHandle,
+                        TRDP_MD_AGGREGATE_CALLBACK_T pfAggregate);
+
+TRDP_ERR_T  trdp_mdOpenCompletions (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T  trdp_mdGetCompletion (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_MD_COMPLETION_T    *pCompletion);
+
+void        trdp_mdCloseCompletions (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T  trdp_mdStartWorker (
+    TRDP_SESSION_PT appHandle,
+    UINT8           priority);
+
+void        trdp_mdStopWorker (
+    TRDP_SESSION_PT appHandle);
+
+void        trdp_mdWakeWorker (
+    TRDP_SESSION_PT appHandle);
 #endif
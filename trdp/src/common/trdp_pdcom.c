@@ -17,6 +17,11 @@
 /*
 * $Id$
 *
+*      AG 2026-10-18: trdp_pdPut() marshalls whenever a marshalling function is passed
+*      AG 2026-10-18: Preemption points of the session reactor in trdp_pdCheckListenSocks()
+*      AG 2026-10-18: trdp_pdTransmit() shared by tlp_processSend() and the PD sender threads
+*      AG 2026-10-18: Scheduled publishers delayed by more than one interval return to their phase
+*      AG 2026-10-18: trdp_pdNextTimeout(), trdp_pdNextSend(): TSN and sender thread telegrams left out of the interval
 *     CWE 2023-02-14: Ticket #419 PDTestFastBase2 failed - prepared debug code for logging pdReceive and pdSend packets
 *     AHW 2023-01-11: Lint warnigs and Ticket #409 In updateTCNDNSentry(), the parameter noDesc of vos_select() is uninitialized if tlc_getInterval() fails
 *     CWE 2023-01-09: Ticket #395 PD subscriber statistics when publisher start earlier
@@ -92,6 +97,8 @@
 #include "trdp_types.h"
 #include "trdp_utils.h"
 #include "trdp_pdcom.h"
+#include "trdp_pdsched.h"
+#include "trdp_pdshard.h"
 #include "tlc_if.h"
 #include "trdp_stats.h"
 #include "vos_sock.h"
@@ -175,7 +182,7 @@ void    trdp_pdInit (
  *  Update the data to be sent
  *
  *  @param[in]      pPacket         pointer to the packet element to send
- *  @param[in]      marshall        pointer to marshalling function
+ *  @param[in]      marshall        pointer to marshalling function, NULL to copy the data as is
  *  @param[in]      refCon          reference for marshalling function
  *  @param[in]      pData           pointer to data
  *  @param[in]      dataSize        size of data
@@ -233,7 +240,7 @@ TRDP_ERR_T trdp_pdPut (
             pPacket->pFrame = pTemp;
         }
 
-        if (!(pPacket->pktFlags & TRDP_FLAGS_MARSHALL) || (marshall == NULL))
+        if (marshall == NULL)
         {
             memcpy(pPacket->pFrame->data, pData, dataSize);
             pPacket->dataSize   = dataSize;
@@ -424,20 +431,24 @@ TRDP_ERR_T trdp_pdGet (
 }
 
 /******************************************************************************/
-/** Send a due PD message
+/** Transmit a PD message
+ *  Update sequence counter and CRC, check the topocounts and send the packet unless it is redundant or has no valid
+ *  data yet. The caller takes care of the timing.
  *
  *  @param[in]      appHandle           session pointer
- *  @param[in]      ppElement           pointer to pointer of the element to send
+ *  @param[in]      iterPD              pointer to the element to send
+ *  @param[in]      pShard              sender thread to send and count with, NULL for the session sockets
  *
  *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_TOPO_ERR       topocount out of date, not sent
  *  @retval         TRDP_IO_ERR         socket I/O error
  */
-TRDP_ERR_T  trdp_pdSendElement (
+TRDP_ERR_T  trdp_pdTransmit (
     TRDP_SESSION_PT appHandle,
-    PD_ELE_T        * *ppElement)
+    PD_ELE_T        *iterPD,
+    PD_SHARD_T      *pShard)
 {
-    TRDP_ERR_T  err     = TRDP_NO_ERR;
-    PD_ELE_T    *iterPD = *ppElement;
+    TRDP_ERR_T err = TRDP_NO_ERR;
 
     /* send only if there is valid data */
     if (!(iterPD->privFlags & TRDP_INVALID_DATA))
@@ -469,7 +480,9 @@ TRDP_ERR_T  trdp_pdSendElement (
         /*    Send the packet if it is not redundant    */
         else if (!(iterPD->privFlags & TRDP_REDUNDANT))
         {
-            TRDP_ERR_T result;
+            VOS_SOCK_T sock = (pShard == NULL) ? appHandle->ifacePD[iterPD->socketIdx].sock :
+                                                 pShard->sock[iterPD->socketIdx];
+
             if (iterPD->pfCbFunction != NULL)
             {
                 TRDP_PD_INFO_T theMessage;
@@ -493,18 +506,39 @@ TRDP_ERR_T  trdp_pdSendElement (
                                      vos_ntohl(iterPD->pFrame->frameHead.datasetLength));
             }
             /* We pass the error to the application, but we keep on going    */
-            result = trdp_pdSend(appHandle->ifacePD[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port);
-            if (result == TRDP_NO_ERR)
+            err = trdp_pdSend(sock, iterPD, appHandle->pdDefault.port);
+            if (err == TRDP_NO_ERR)
             {
-                appHandle->stats.pd.numSend++;
+                if (pShard == NULL)
+                {
+                    appHandle->stats.pd.numSend++;
+                }
+                else
+                {
+                    pShard->numSend++;
+                }
                 iterPD->numRxTx++;
             }
-            else
-            {
-                err = result;   /* pass last error to application  */
-            }
         }
     }
+    return err;
+}
+
+/******************************************************************************/
+/** Send a due PD message
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      ppElement           pointer to pointer of the element to send
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_IO_ERR         socket I/O error
+ */
+TRDP_ERR_T  trdp_pdSendElement (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        * *ppElement)
+{
+    PD_ELE_T    *iterPD = *ppElement;
+    TRDP_ERR_T  err     = trdp_pdTransmit(appHandle, iterPD, NULL);
 
     if ((iterPD->privFlags & TRDP_REQ_2B_SENT) &&
         (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PP)))       /*  PULL packet?  */
@@ -589,7 +623,8 @@ TRDP_ERR_T  trdp_pdSendQueued (
         /*    Get the current time    */
         vos_getTime(&now);
 
-        if (iterPD->privFlags & TRDP_IS_TSN)
+        /*  TSN packets are sent immediately, sharded ones by their sender thread  */
+        if ((iterPD->privFlags & TRDP_IS_TSN) || (iterPD->pShard != NULL))
         {
             iterPD = iterPD->pNext;
             continue;
@@ -603,71 +638,10 @@ TRDP_ERR_T  trdp_pdSendQueued (
              !timercmp(&iterPD->timeToGo, &now, >)) ||
             (iterPD->privFlags & TRDP_REQ_2B_SENT))
         {
-            /* send only if there is valid data */
-            if (!(iterPD->privFlags & TRDP_INVALID_DATA))
+            TRDP_ERR_T result = trdp_pdTransmit(appHandle, iterPD, NULL);
+            if (result != TRDP_NO_ERR)
             {
-                if ((iterPD->privFlags & TRDP_REQ_2B_SENT) &&
-                    (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PD)))       /*  PULL packet?  */
-                {
-                    iterPD->pFrame->frameHead.msgType = vos_htons(TRDP_MSG_PP);
-                }
-                /*  Update the sequence counter and re-compute CRC    */
-                trdp_pdUpdate(iterPD);
-
-                /* Publisher check from Table A.5:
-                   Actual topography counter values <-> Locally stored with publish */
-                if ( !trdp_validTopoCounters( appHandle->etbTopoCnt,
-                                              appHandle->opTrnTopoCnt,
-                                              vos_ntohl(iterPD->pFrame->frameHead.etbTopoCnt),
-                                              vos_ntohl(iterPD->pFrame->frameHead.opTrnTopoCnt)))
-                {
-                    err = TRDP_TOPO_ERR;
-                    vos_printLogStr(VOS_LOG_INFO, "Sending PD: TopoCount is out of date!\n");
-                }
-                /*    In case we're sending on an uninitialized publisher; should never happen. */
-                else if (iterPD->socketIdx == TRDP_INVALID_SOCKET_INDEX)
-                {
-                    vos_printLogStr(VOS_LOG_ERROR, "Sending PD: Socket invalid!\n");
-                    /* Try to send the other packets */
-                }
-                /*    Send the packet if it is not redundant    */
-                else if (!(iterPD->privFlags & TRDP_REDUNDANT))
-                {
-                    TRDP_ERR_T result;
-                    if (iterPD->pfCbFunction != NULL)
-                    {
-                        TRDP_PD_INFO_T theMessage;
-                        theMessage.comId        = iterPD->addr.comId;
-                        theMessage.srcIpAddr    = iterPD->addr.srcIpAddr;
-                        theMessage.destIpAddr   = iterPD->addr.destIpAddr;
-                        theMessage.etbTopoCnt   = vos_ntohl(iterPD->pFrame->frameHead.etbTopoCnt);
-                        theMessage.opTrnTopoCnt = vos_ntohl(iterPD->pFrame->frameHead.opTrnTopoCnt);
-                        theMessage.msgType      = (TRDP_MSG_T) vos_ntohs(iterPD->pFrame->frameHead.msgType);
-                        theMessage.seqCount     = iterPD->curSeqCnt;
-                        theMessage.protVersion  = vos_ntohs(iterPD->pFrame->frameHead.protocolVersion);
-                        theMessage.replyComId   = vos_ntohl(iterPD->pFrame->frameHead.replyComId);
-                        theMessage.replyIpAddr  = vos_ntohl(iterPD->pFrame->frameHead.replyIpAddress);
-                        theMessage.pUserRef     = iterPD->pUserRef; /* User reference given with the local subscribe? */
-                        theMessage.resultCode   = err;
-
-                        iterPD->pfCbFunction(appHandle->pdDefault.pRefCon,
-                                             appHandle,
-                                             &theMessage,
-                                             iterPD->pFrame->data,
-                                             vos_ntohl(iterPD->pFrame->frameHead.datasetLength));
-                    }
-                    /* We pass the error to the application, but we keep on going    */
-                    result = trdp_pdSend(appHandle->ifacePD[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port);
-                    if (result == TRDP_NO_ERR)
-                    {
-                        appHandle->stats.pd.numSend++;
-                        iterPD->numRxTx++;
-                    }
-                    else
-                    {
-                        err = result;   /* pass last error to application  */
-                    }
-                }
+                err = result;   /* pass last error to application  */
             }
 
             if ((iterPD->privFlags & TRDP_REQ_2B_SENT) &&
@@ -685,9 +659,9 @@ TRDP_ERR_T  trdp_pdSendQueued (
 
                 if (vos_cmpTime(&iterPD->timeToGo, &now) <= 0)
                 {
-                    /* in case of a delay of more than one interval - avoid sending it in the next cycle again */
-                    iterPD->timeToGo = now;
-                    vos_addTime(&iterPD->timeToGo, &iterPD->interval);
+                    /* in case of a delay of more than one interval - avoid sending it in the next cycle again,
+                       a scheduled packet returns to its phase */
+                    trdp_pdScheduleNext(appHandle, iterPD, &now);
                 }
             }
 
@@ -956,6 +930,9 @@ TRDP_ERR_T  trdp_pdReceive (
             pExistingElement->lastErr   = TRDP_NO_ERR;
             pExistingElement->privFlags =
                 (TRDP_PRIV_FLAGS_T) (pExistingElement->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_TIMED_OUT);
+#ifdef HIGH_PERF_INDEXED
+            trdp_indexSubArmed(appHandle, pExistingElement);
+#endif
 
             /* mark the data as valid */
             pExistingElement->privFlags =
@@ -1023,6 +1000,7 @@ TRDP_ERR_T  trdp_pdReceive (
                     /*  Set the destination address of the requested telegram either to the replyIp or the source Ip of the
                      requester   */
 
+                    trdp_pdShardLock(pPulledElement);
                     if (pNewFrameHead->replyIpAddress != 0u)
                     {
                         pPulledElement->pullIpAddress = vos_ntohl(pNewFrameHead->replyIpAddress);
@@ -1040,6 +1018,7 @@ TRDP_ERR_T  trdp_pdReceive (
                         /*  We do not break here, only report error */
                         vos_printLogStr(VOS_LOG_WARNING, "Error sending one or more PD packets\n");
                     }
+                    trdp_pdShardUnlock(pPulledElement);
 
                     informUser = TRUE;
                 }
@@ -1124,23 +1103,21 @@ void trdp_pdCheckPending (
     TRDP_SOCK_T         *pNoDesc,
     int                 checkSend)
 {
-    PD_ELE_T *iterPD;
+    PD_ELE_T    *iterPD;
+    TRDP_TIME_T now;
 
     /*    Walk over the registered PDs, find pending packets */
 
+    vos_getTime(&now);
     vos_clearTime(&appHandle->nextJob);
+    trdp_pdNextTimeout(appHandle, &appHandle->nextJob);
+    if (checkSend)
+    {
+        trdp_pdNextSend(appHandle, &now, &appHandle->nextJob);
+    }
 
-    /*    Find the packet which has to be received next:    */
     for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        if ((!(iterPD->privFlags & TRDP_TIMED_OUT)) &&              /* Exempt already timed-out packet */
-            timerisset(&iterPD->interval) &&                        /* not PD PULL?                    */
-            (timercmp(&iterPD->timeToGo, &appHandle->nextJob, <) || /* earlier than current time-out?  */
-             !timerisset(&appHandle->nextJob)))                     /* or not set at all?              */
-        {
-            appHandle->nextJob = iterPD->timeToGo;                  /* set new next time value from queue element */
-        }
-
         /*    Check and set the socket file descriptor, if not already done    */
         if (iterPD->socketIdx != -1 &&
             appHandle->ifacePD[iterPD->socketIdx].sock != VOS_INVALID_SOCKET &&
@@ -1160,18 +1137,72 @@ void trdp_pdCheckPending (
             }
         }
     }
+}
 
-    if (checkSend)
+/******************************************************************************/
+/** Find the earliest receive time-out of a session
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in,out]  pNextJob            earliest event so far (cleared: none), updated if an earlier one is found
+ */
+void trdp_pdNextTimeout (
+    const TRDP_SESSION_T    *appHandle,
+    TRDP_TIME_T             *pNextJob)
+{
+    const PD_ELE_T *iterPD;
+
+    /*    Find the packet which has to be received next:    */
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        /*    Find packet in send queue which evntually has to be sent earlier:    */
-        for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+        if ((!(iterPD->privFlags & TRDP_TIMED_OUT)) &&              /* Exempt already timed-out packet */
+            timerisset(&iterPD->interval) &&                        /* not PD PULL?                    */
+            timerisset(&iterPD->timeToGo) &&                        /* not waiting for a pull reply    */
+            (timercmp(&iterPD->timeToGo, pNextJob, <) ||            /* earlier than current time-out?  */
+             !timerisset(pNextJob)))                                /* or not set at all?              */
         {
-            if (timerisset(&iterPD->interval) &&                        /* has a time out value?    */
-                (timercmp(&iterPD->timeToGo, &appHandle->nextJob, <) ||  /* earlier than current time-out? */
-                 !timerisset(&appHandle->nextJob)))
-            {
-                appHandle->nextJob = iterPD->timeToGo;                  /* set new next time value from queue element */
-            }
+            *pNextJob = iterPD->timeToGo;                           /* set new next time value from queue element */
+        }
+    }
+}
+
+/******************************************************************************/
+/** Find the earliest send time of a session
+ *  Covers the telegrams sent by tlp_processSend(), pending requests are due at once.
+ *  TSN telegrams and telegrams of a sender thread are sent elsewhere and are left out.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pNow                current time, returned for telegrams to be sent at once
+ *  @param[in,out]  pNextJob            earliest event so far (cleared: none), updated if an earlier one is found
+ */
+void trdp_pdNextSend (
+    const TRDP_SESSION_T    *appHandle,
+    const TRDP_TIME_T       *pNow,
+    TRDP_TIME_T             *pNextJob)
+{
+    const PD_ELE_T *iterPD;
+
+    /*    Find packet in send queue which eventually has to be sent earlier:    */
+    for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        const TRDP_TIME_T *pDue = &iterPD->timeToGo;
+
+        /*  TSN packets are sent immediately, sharded ones by their sender thread  */
+        if ((iterPD->privFlags & TRDP_IS_TSN) || (iterPD->pShard != NULL))
+        {
+            continue;
+        }
+        if (iterPD->privFlags & TRDP_REQ_2B_SENT)                   /* request for immediate sending  */
+        {
+            pDue = pNow;
+        }
+        else if (!timerisset(&iterPD->interval))                    /* no time out value?       */
+        {
+            continue;
+        }
+        if (timercmp(pDue, pNextJob, <) ||                          /* earlier than current time-out? */
+            !timerisset(pNextJob))
+        {
+            *pNextJob = *pDue;                                      /* set new next time value from queue element */
         }
     }
 }
@@ -1307,6 +1338,11 @@ TRDP_ERR_T   trdp_pdCheckListenSocks (
         /*    Check and set the socket file descriptor by going thru the socket list    */
         for (idx = 0; idx < (UINT32) trdp_getCurrentMaxSocketCnt(TRDP_SOCK_PD); idx++)
         {
+            if (trdp_yield(&appHandle->yieldPdRx) == TRUE)
+            {
+                /* the reactor has more urgent work, the sockets left stay ready */
+                break;
+            }
             if ((appHandle->ifacePD[idx].sock != VOS_INVALID_SOCKET) &&
                 (VOS_FD_ISSET(appHandle->ifacePD[idx].sock, (VOS_FDS_T *) pRfds)))  /*lint !e573 signed/unsigned division in
                                                                                macro */
@@ -1323,7 +1359,8 @@ TRDP_ERR_T   trdp_pdCheckListenSocks (
                     err = trdp_pdReceive(appHandle, appHandle->ifacePD[idx].sock);
 
                 }
-                while ((err == TRDP_NO_ERR) && (nonBlocking == TRUE));
+                while ((err == TRDP_NO_ERR) && (nonBlocking == TRUE)
+                       && (trdp_yield(&appHandle->yieldPdRx) == FALSE));
 
                 switch (err)
                 {
@@ -17,6 +17,7 @@
 /*
 * $Id$
 *
+*      AG 2026-10-18: trdp_pdTransmit()
 *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
 *      BL 2019-06-17: Ticket #264 Provide service oriented interface
 *      BL 2019-06-17: Ticket #162 Independent handling of PD and MD to reduce jitter
@@ -89,6 +90,11 @@ TRDP_ERR_T trdp_pdGet (
     UINT8               *pData,
     UINT32              *pDataSize);
 
+TRDP_ERR_T  trdp_pdTransmit (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *iterPD,
+    PD_SHARD_T      *pShard);
+
 TRDP_ERR_T  trdp_pdSendElement (
     TRDP_SESSION_PT appHandle,
     PD_ELE_T        * *ppElement);
@@ -117,6 +123,15 @@ void        trdp_pdCheckPending (
     TRDP_SOCK_T         *pNoDesc,
     int                 checkSending);
 
+void        trdp_pdNextTimeout (
+    const TRDP_SESSION_T    *appHandle,
+    TRDP_TIME_T             *pNextJob);
+
+void        trdp_pdNextSend (
+    const TRDP_SESSION_T    *appHandle,
+    const TRDP_TIME_T       *pNow,
+    TRDP_TIME_T             *pNextJob);
+
 void        trdp_handleTimeout (
     TRDP_SESSION_PT appHandle,
     PD_ELE_T        *pIterPD);
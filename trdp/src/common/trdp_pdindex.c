@@ -17,6 +17,10 @@
 /*
  * $Id$
  *
+ *      AG 2026-10-18: trdp_indexCheckPending() returns the time to the earliest receive time-out
+ *      AG 2026-10-18: Publishers sent by a PD sender thread are skipped
+ *      AG 2026-10-18: Automatic sizing of the index tables from the publishers, trdp_indexStatistics()
+ *      AG 2026-10-18: Publishers and subscribers are added to and removed from existing index tables incrementally
  *     CWE 2023-02-14: Ticket #419 PDTestFastBase2 failed when send-cycles were set to 256ms
  *     CWE 2023-02-02: Ticket #380 Added base 2 cycle time support for high performance PD: set HIGH_PERF_BASE2=1 in make config file (see LINUX_HP2_config)
  *     AHW 2023-01-05: Ticket #407 Interval not updated in trdp_indexCheckPending if Hight performance index with no subscriptions
@@ -206,6 +210,7 @@ static void   print_table (
 
 /******************************************************************************/
 /** Remove publisher from one index table
+ *  The remaining entries of a slot are moved up, the sender stops at the first empty entry of a slot.
  *
  *  @param[in]      pSlot               pointer to table entry
  *  @param[in]      pElement            pointer of the publisher element to be removed
@@ -220,22 +225,76 @@ static int removePub (
     UINT32  idx;
     int     found = 0;
 
+    if (pSlot->ppIdxCat == NULL)
+    {
+        return 0;
+    }
+
     /* Find the packet in the short list */
     for (idx = 0u; idx < pSlot->noOfTxEntries; idx++)
     {
+        UINT32 fill = 0u;
+
         for (depth = 0u; depth < pSlot->depthOfTxEntries; depth++)
         {
-            if (getElement(pSlot, idx, depth) == pElement)    /* hit? */
+            PD_ELE_T *pCur = getElement(pSlot, idx, depth);
+
+            if (pCur == pElement)    /* hit? */
             {
-                /* remove it */
-                setElement(pSlot, idx, depth, NULL);
                 found++;
+                continue;
+            }
+            if (pCur == NULL)
+            {
+                continue;
             }
+            if (fill != depth)
+            {
+                setElement(pSlot, idx, fill, pCur);     /* close the gap */
+            }
+            fill++;
+        }
+        /* clear the entries which have been moved up or removed */
+        for (; fill < depth; fill++)
+        {
+            setElement(pSlot, idx, fill, NULL);
         }
     }
     return found;
 }
 
+/**********************************************************************************************************************/
+/** Return the number of occupied entries of a slot
+ *  The entries of a slot are kept without gaps, the first empty entry is searched binary.
+ *
+ *  @param[in]      pCat                pointer to the category
+ *  @param[in]      slot                first dimension index
+ *
+ *  @retval         number of telegrams in the slot
+ */
+static UINT32 slotFill (
+    TRDP_HP_CAT_SLOT_T  *pCat,
+    UINT32              slot)
+{
+    UINT32  low     = 0u;
+    UINT32  high    = pCat->depthOfTxEntries;
+
+    while (low < high)
+    {
+        UINT32 mid = (low + high) / 2u;
+
+        if (getElement(pCat, slot, mid) != NULL)
+        {
+            low = mid + 1u;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
 /**********************************************************************************************************************/
 /** Return the category for the transmitter index tables
  *
@@ -399,12 +458,241 @@ static TRDP_ERR_T distribute (
     return err;
 }
 
+/**********************************************************************************************************************/
+/** Find the least loaded start slot for a PD
+ *  The load of a start slot is the fill of its fullest slot (every interval). On a tie, the later start slot is taken.
+ *
+ *  @param[in]      pFill           number of entries per slot
+ *  @param[in]      step            interval in slots
+ *  @param[in]      count           number of entries of the PD
+ *  @param[out]     pLoad           load of the returned start slot
+ *
+ *  @retval         start slot (0 ... step - 1)
+ */
+static UINT32 leastLoadedStart (
+    const UINT8 *pFill,
+    UINT32      step,
+    UINT32      count,
+    UINT32      *pLoad)
+{
+    UINT32  startIdx;
+    UINT32  idx;
+    UINT32  bestIdx     = 0u;
+    UINT32  bestLoad    = 0xFFFFFFFFu;
+
+    /* Search backwards (as distribute() does) for the start slot with the least loaded slots */
+    for (startIdx = step; startIdx-- > 0u; )
+    {
+        UINT32 load = 0u;
+
+        for (idx = startIdx; (idx < step * count) && (load < bestLoad); idx += step)
+        {
+            if (pFill[idx] > load)
+            {
+                load = pFill[idx];
+            }
+        }
+        if (load < bestLoad)
+        {
+            bestLoad    = load;
+            bestIdx     = startIdx;
+        }
+    }
+    *pLoad = bestLoad;
+    return bestIdx;
+}
+
+/**********************************************************************************************************************/
+/** Enter a PD into an existing index table
+ *  In contrast to distribute(), the start slot is the least loaded one of all compatible start slots, i.e. the
+ *  start slot whose fullest slot (every interval) has the most room. Other telegrams are not moved.
+ *
+ *  @param[in,out]  pCat            pointer to the array to fill
+ *  @param[in]      pElement        pointer to the packet element to be handled
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *                  TRDP_PARAM_ERR      incompatible table size
+ *                  TRDP_MEM_ERR        no room without additional jitter (depth)
+ */
+static TRDP_ERR_T insertPub (
+    TRDP_HP_CAT_SLOT_T  *pCat,
+    PD_ELE_T            *pElement)
+{
+    UINT8   fill[TRDP_IDX_MAX_SLOTS];
+    UINT32  bestIdx;
+    UINT32  bestLoad;
+    UINT32  maxStartIdx;
+    UINT32  count;
+    UINT32  idx;
+
+    /* This is the interval we need to distribute */
+    UINT32  pdInterval = (UINT32) pElement->interval.tv_usec + (UINT32) pElement->interval.tv_sec * 1000000u;
+
+    if ((pdInterval == 0u) || (pCat->slotCycle == 0u) || (pCat->ppIdxCat == NULL) ||
+        (pCat->noOfTxEntries > TRDP_IDX_MAX_SLOTS))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /* Every maxStartIdx slots the PD must be entered, count times */
+    maxStartIdx = pdInterval / pCat->slotCycle;
+    count       = pCat->noOfTxEntries * pCat->slotCycle / pdInterval;
+
+    if ((maxStartIdx == 0u) || (count == 0u) || ((maxStartIdx * count) > pCat->noOfTxEntries))
+    {
+        vos_printLog(VOS_LOG_ERROR, "Config problem: PD references for interval %ums (startIdx %u, count %u)",
+                     (unsigned int) (pdInterval / 1000u), (unsigned int) maxStartIdx, (unsigned int) count);
+        return TRDP_PARAM_ERR;
+    }
+
+    for (idx = 0u; idx < pCat->noOfTxEntries; idx++)
+    {
+        fill[idx] = (UINT8) slotFill(pCat, idx);
+    }
+    bestIdx = leastLoadedStart(fill, maxStartIdx, count, &bestLoad);
+
+    if (bestLoad >= pCat->depthOfTxEntries)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    for (idx = bestIdx; idx < maxStartIdx * count; idx += maxStartIdx)
+    {
+        setElement(pCat, idx, fill[idx], pElement);
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Compute the depth an index table needs to hold all PDs of a category without additional jitter
+ *  The PDs are entered into a table of fill counters as insertPub() would enter them, starting with the lowest possible
+ *  depth. Each time a PD finds no room, the depth is incremented and the entering is restarted.
+ *
+ *  @param[in]      pSndQueue       send queue
+ *  @param[in]      category        category of the table
+ *  @param[in]      slotCycle       cycle time (µs) of the table's slots
+ *  @param[in]      slots           number of slots of the table
+ *
+ *  @retval         required depth (0 if no PD of this category), > TRDP_IDX_MAX_DEPTH if not possible
+ */
+static UINT32 requiredDepth (
+    PD_ELE_T            *pSndQueue,
+    PERF_TABLE_TYPE_T   category,
+    UINT32              slotCycle,
+    UINT32              slots)
+{
+    UINT8       fill[TRDP_IDX_MAX_SLOTS];
+    PD_ELE_T    *pIter;
+    UINT32      entries = 0u;
+    UINT32      depth;
+
+    if ((slotCycle == 0u) || (slots == 0u) || (slots > TRDP_IDX_MAX_SLOTS))
+    {
+        return 0u;
+    }
+
+    /* The lowest possible depth: all entries evenly spread */
+    for (pIter = pSndQueue; pIter != NULL; pIter = pIter->pNext)
+    {
+        if (perf_table_category(pIter) == category)
+        {
+            entries += slots * slotCycle /
+                ((UINT32) pIter->interval.tv_usec + (UINT32) pIter->interval.tv_sec * 1000000u);
+        }
+    }
+    if (entries == 0u)
+    {
+        return 0u;
+    }
+
+    for (depth = (entries + slots - 1u) / slots; depth <= TRDP_IDX_MAX_DEPTH; depth++)
+    {
+        BOOL8 fits = TRUE;
+
+        memset(fill, 0, sizeof(fill));
+        for (pIter = pSndQueue; (pIter != NULL) && (fits == TRUE); pIter = pIter->pNext)
+        {
+            UINT32  pdInterval;
+            UINT32  step, count, load, idx;
+
+            if (perf_table_category(pIter) != category)
+            {
+                continue;
+            }
+            pdInterval  = (UINT32) pIter->interval.tv_usec + (UINT32) pIter->interval.tv_sec * 1000000u;
+            step        = pdInterval / slotCycle;
+            count       = slots * slotCycle / pdInterval;
+            if ((step == 0u) || (count == 0u) || ((step * count) > slots))
+            {
+                continue;   /* reported when the tables are filled */
+            }
+            idx = leastLoadedStart(fill, step, count, &load);
+            if (load >= depth)
+            {
+                fits = FALSE;
+                break;
+            }
+            for (; idx < step * count; idx += step)
+            {
+                fill[idx]++;
+            }
+        }
+        if (fits == TRUE)
+        {
+            return depth;
+        }
+    }
+    return depth;
+}
+
+/**********************************************************************************************************************/
+/** Automatic sizing of an index table
+ *  The depth the publishers of a category need, plus a reserve for publishers added later. The table never shrinks
+ *  below its preset or previous depth.
+ *
+ *  @param[in]      pSndQueue       send queue
+ *  @param[in]      category        category of the table
+ *  @param[in]      rangeMax        time range of the table
+ *  @param[in]      pCat            pointer to entry holding the index table
+ *
+ *  @retval         depth to allocate
+ */
+static UINT32 autoDepth (
+    PD_ELE_T                    *pSndQueue,
+    PERF_TABLE_TYPE_T           category,
+    UINT32                      rangeMax,
+    const TRDP_HP_CAT_SLOT_T    *pCat)
+{
+    UINT32 depth = requiredDepth(pSndQueue, category, pCat->slotCycle, rangeMax / pCat->slotCycle);
+
+    if (depth > TRDP_IDX_MAX_DEPTH)
+    {
+        vos_printLog(VOS_LOG_WARNING,
+                     "PDs with intervals <= %ums need more than %u entries per slot, some will have additional jitter\n",
+                     (unsigned int) rangeMax / 1000u, (unsigned int) TRDP_IDX_MAX_DEPTH);
+        depth = TRDP_IDX_MAX_DEPTH;
+    }
+    else
+    {
+        depth += depth * TRDP_IDX_DEPTH_RESERVE / 100u + 1u;
+        if (depth > TRDP_IDX_MAX_DEPTH)
+        {
+            depth = TRDP_IDX_MAX_DEPTH;
+        }
+    }
+    if (depth < pCat->depthOfTxEntries)
+    {
+        depth = pCat->depthOfTxEntries;
+    }
+    return depth;
+}
+
 /**********************************************************************************************************************/
 /** Create an index table for a transmit-time category (low, mid, high)
  *
  *  @param[in]      rangeMax            time range this index table shall support (e.g. 100000µs for low table upon base 10, or 128000µs upon base 2)
  *  @param[in]      cat_noOfTxEntries   number of transmitters in this category
- *  @param[in]      cat_Depth           preset depth, used if proposed value is smaller
+ *  @param[in]      cat_Depth           depth of the table (preset or computed by autoDepth())
  *  @param[out]     pCat                pointer to entry holding the resulting index table
  */
 static TRDP_ERR_T indexCreatePubTable (
@@ -417,16 +705,12 @@ static TRDP_ERR_T indexCreatePubTable (
     UINT32 slots = rangeMax / pCat->slotCycle;
 
 
-    /* we allocate an array with dimensions [slots][appHandle->pSlot->noOfTxEntriesLow/slots]
-     This is a quite rough estimate with lots of head room. If memory is tight, the estimatation could be
-     optimised by determining the exact max. depth needed for any category, either by pre-computation or by
-     iterating (e.g. using a trial & error scheme, starting with lower depth values) */
-
     /* Second array dimension == number of elements per time slot */
-    UINT32 depth = cat_noOfTxEntries * 10u / slots + 5u;
-    if (depth < cat_Depth)
+    UINT32 depth = cat_Depth;
+
+    if (depth == 0u)
     {
-        depth = cat_Depth;
+        depth = 1u;
     }
 
     if ((rangeMax % pCat->slotCycle) > 0)
@@ -438,8 +722,7 @@ static TRDP_ERR_T indexCreatePubTable (
                         "Current cycle time will introduce larger jitter, optimal values are e.g.: 1, 2, 4, 5, 10ms\n");
     }
 
-    /* depth must be at least 1 ! */
-    if (depth > 255u)
+    if ((depth > TRDP_IDX_MAX_DEPTH) || (slots > TRDP_IDX_MAX_SLOTS))
     {
         vos_printLogStr(VOS_LOG_ERROR,
                         "Depth computation failed, may not be larger than 255! Check your configuration\n");
@@ -531,6 +814,121 @@ static int compareTimeouts (const void *pPDElement1, const void *pPDElement2)
     return vos_cmpTime(&p1->interval, &p2->interval);
 }
 
+/**********************************************************************************************************************/
+/** Find the position behind the last element sorting before or equal to a key in a receiver index table
+ *
+ *  @param[in]      pTable              pointer to the sorted array
+ *  @param[in]      noOfEntries         no of entries in the array
+ *  @param[in]      pKey                element to compare with
+ *  @param[in]      compare             sort order of the array
+ *  @param[in]      orEqual             TRUE: position behind equal elements, FALSE: position of the first equal element
+ *
+ *  @retval         index into the array (0 ... noOfEntries)
+ */
+static UINT32 rcvTablePos (
+    PD_ELE_T    * *pTable,
+    UINT32      noOfEntries,
+    PD_ELE_T    *pKey,
+    int         (*compare)(const void *, const void *),
+    BOOL8       orEqual)
+{
+    UINT32  low     = 0u;
+    UINT32  high    = noOfEntries;
+
+    while (low < high)
+    {
+        UINT32  mid = (low + high) / 2u;
+        int     res = compare(&pTable[mid], &pKey);
+
+        if ((res < 0) || ((res == 0) && orEqual))
+        {
+            low = mid + 1u;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**********************************************************************************************************************/
+/** Remove an element from a receiver index table
+ *
+ *  @param[in,out]  pTable              pointer to the sorted array
+ *  @param[in]      noOfEntries         no of entries in the array
+ *  @param[in]      pElement            element to remove
+ *  @param[in]      compare             sort order of the array
+ *
+ *  @retval         TRUE                element found and removed
+ */
+static BOOL8 rcvTableRemove (
+    PD_ELE_T    * *pTable,
+    UINT32      noOfEntries,
+    PD_ELE_T    *pElement,
+    int         (*compare)(const void *, const void *))
+{
+    UINT32 idx = rcvTablePos(pTable, noOfEntries, pElement, compare, FALSE);
+
+    /* Elements sorting equal are searched one by one */
+    for (; (idx < noOfEntries) && (compare(&pTable[idx], &pElement) == 0); idx++)
+    {
+        if (pTable[idx] == pElement)
+        {
+            memmove(&pTable[idx], &pTable[idx + 1u], (noOfEntries - idx - 1u) * sizeof(PD_ELE_T *));
+            pTable[noOfEntries - 1u] = NULL;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Let the earliest receive time-out include the time-out of a subscriber
+ *  A later time-out leaves nextRxTimeout unchanged: it may end up earlier than the real earliest time-out, which is
+ *  recomputed by trdp_pdHandleTimeOutsIndexed() once it has passed.
+ *
+ *  @param[in,out]  pSlot               pointer to the index tables
+ *  @param[in]      pElement            the subscriber
+ */
+static void rcvTimeoutMerge (
+    TRDP_HP_CAT_SLOTS_T *pSlot,
+    const PD_ELE_T      *pElement)
+{
+    if (timerisset(&pElement->interval) &&
+        timerisset(&pElement->timeToGo) &&
+        !(pElement->privFlags & TRDP_TIMED_OUT) &&
+        (!timerisset(&pSlot->nextRxTimeout) || timercmp(&pElement->timeToGo, &pSlot->nextRxTimeout, <)))
+    {
+        pSlot->nextRxTimeout = pElement->timeToGo;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Recompute the earliest receive time-out of all subscribers
+ *  Time-outs already passed are left out, they have been handled.
+ *
+ *  @param[in,out]  pSlot               pointer to the index tables
+ *  @param[in]      pNow                current time
+ */
+static void rcvTimeoutRecompute (
+    TRDP_HP_CAT_SLOTS_T *pSlot,
+    const TRDP_TIME_T   *pNow)
+{
+    UINT32 idx;
+
+    timerclear(&pSlot->nextRxTimeout);
+
+    /* The table is sorted by interval, not by the time the packets are due */
+    for (idx = 0u; idx < pSlot->noOfRxEntries; idx++)
+    {
+        if (timercmp(&pSlot->pRcvTableTimeOut[idx]->timeToGo, pNow, >))
+        {
+            rcvTimeoutMerge(pSlot, pSlot->pRcvTableTimeOut[idx]);
+        }
+    }
+}
+
 
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
@@ -908,18 +1306,22 @@ TRDP_ERR_T trdp_indexCreatePubTables (TRDP_SESSION_PT appHandle)
         extCat_noOfTxEntries    = 0;
     }
 
-    /* These are now checks to prevent a possible table overflow in case the pre-allocated tables are too small! */
+    /* The depths are computed from the publishers, the tables are re-allocated if the pre-allocated ones are too small */
     err = indexCreatePubTable(TRDP_LOW_CYCLE_LIMIT, lowCat_noOfTxEntries,
-                              pSlot->lowCat.depthOfTxEntries, &pSlot->lowCat);
+                              autoDepth(appHandle->pSndQueue, PERF_LOW_TABLE, TRDP_LOW_CYCLE_LIMIT, &pSlot->lowCat),
+                              &pSlot->lowCat);
     if (err == TRDP_NO_ERR)
     {
         err = indexCreatePubTable(TRDP_MID_CYCLE_LIMIT, midCat_noOfTxEntries,
-                                  pSlot->midCat.depthOfTxEntries, &pSlot->midCat);
+                                  autoDepth(appHandle->pSndQueue, PERF_MID_TABLE, TRDP_MID_CYCLE_LIMIT, &pSlot->midCat),
+                                  &pSlot->midCat);
     }
     if (err == TRDP_NO_ERR)
     {
         err = indexCreatePubTable(TRDP_HIGH_CYCLE_LIMIT, highCat_noOfTxEntries,
-                                  pSlot->highCat.depthOfTxEntries, &pSlot->highCat);
+                                  autoDepth(appHandle->pSndQueue, PERF_HIGH_TABLE, TRDP_HIGH_CYCLE_LIMIT,
+                                            &pSlot->highCat),
+                                  &pSlot->highCat);
     }
 
     /* Empty the low-cat slots */
@@ -961,17 +1363,19 @@ TRDP_ERR_T trdp_indexCreatePubTables (TRDP_SESSION_PT appHandle)
         while ((pPDsend != NULL) &&
                (err == TRDP_NO_ERR))
         {
+            TRDP_HP_CAT_SLOT_T *pCat = NULL;
+
             /* Decide which array to fill */
             switch (perf_table_category(pPDsend))
             {
                 case PERF_LOW_TABLE:
-                    err = distribute(&pSlot->lowCat, pPDsend);
+                    pCat = &pSlot->lowCat;
                     break;
                 case PERF_MID_TABLE:
-                    err = distribute(&pSlot->midCat, pPDsend);
+                    pCat = &pSlot->midCat;
                     break;
                 case PERF_HIGH_TABLE:
-                    err = distribute(&pSlot->highCat, pPDsend);
+                    pCat = &pSlot->highCat;
                     break;
                 case PERF_EXT_TABLE:
                     pSlot->pExtTxTable[extCat_noOfTxEntries] = pPDsend;
@@ -986,6 +1390,15 @@ TRDP_ERR_T trdp_indexCreatePubTables (TRDP_SESSION_PT appHandle)
                 case PERF_IGNORE:
                     break;
             }
+            if (pCat != NULL)
+            {
+                /* Enter it into the least loaded slots, if there is no room: distribute with additional jitter */
+                err = insertPub(pCat, pPDsend);
+                if (err == TRDP_MEM_ERR)
+                {
+                    err = distribute(pCat, pPDsend);
+                }
+            }
             pPDsend = pPDsend->pNext;
         }
 #ifdef DEBUG
@@ -1010,6 +1423,7 @@ void  trdp_pdHandleTimeOutsIndexed (TRDP_SESSION_PT appHandle)
     UINT32 idx, idxMax;
     TRDP_TIME_T now, interval;
     PD_ELE_T * *pElement;
+    BOOL8 checkAll;
     static TRDP_TIME_T  lastCall = {0, 0};
     static TRDP_TIME_T  cumulatedCallTime = {0, 0};
 
@@ -1030,6 +1444,12 @@ void  trdp_pdHandleTimeOutsIndexed (TRDP_SESSION_PT appHandle)
         pElement    = (PD_ELE_T * *) appHandle->pSlot->pRcvTableTimeOut;
         idxMax      = appHandle->pSlot->noOfRxEntries;
 
+        /* every TRDP_TO_CHECK_CYCLE (default 100ms) check for other timeouts,
+           also if the earliest time-out tlp_getInterval() woke us up for is due */
+        checkAll = ((cumulatedCallTime.tv_usec > TRDP_TO_CHECK_CYCLE) || (cumulatedCallTime.tv_sec != 0) ||
+                    (timerisset(&appHandle->pSlot->nextRxTimeout) &&
+                     !timercmp(&now, &appHandle->pSlot->nextRxTimeout, <))) ? TRUE : FALSE;
+
         /* we need to check the first, fastest intervals each time we are called */
         for (idx = 0;
              (idx < idxMax) &&
@@ -1042,8 +1462,7 @@ void  trdp_pdHandleTimeOutsIndexed (TRDP_SESSION_PT appHandle)
             }
         }
 
-        /* every TRDP_TO_CHECK_CYCLE (default 100ms) check for other timeouts */
-        if ((cumulatedCallTime.tv_usec > TRDP_TO_CHECK_CYCLE) || (cumulatedCallTime.tv_sec != 0))
+        if (checkAll == TRUE)
         {
             for (;
                  idx < idxMax;
@@ -1057,11 +1476,42 @@ void  trdp_pdHandleTimeOutsIndexed (TRDP_SESSION_PT appHandle)
             }
             /* Reset the cumulated time */
             timerclear(&cumulatedCallTime);
+            /* All time-outs are handled, the earliest pending one is the next to wake up for */
+            rcvTimeoutRecompute(appHandle->pSlot, &now);
         }
     }
     lastCall = now;
 }
 
+/**********************************************************************************************************************/
+/** Find the next send time of the index tables
+ *  The tables are processed on a grid of the process cycle, counted from the latest start of the table loop.
+ *  A grid point already passed is returned as well, the sending is late then.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in,out]  pNextJob            earliest event so far (cleared: none), updated if an earlier one is found
+ */
+void trdp_indexNextSend (
+    const TRDP_SESSION_T    *appHandle,
+    TRDP_TIME_T             *pNextJob)
+{
+    const TRDP_HP_SLOTS_T   *pSlot = appHandle->pSlot;
+    TRDP_TIME_T             due;
+
+    if ((pSlot == NULL) || (pSlot->processCycle == 0u))
+    {
+        return;
+    }
+    due.tv_sec  = (INT32) (pSlot->currentCycle / 1000000u);
+    due.tv_usec = (INT32) (pSlot->currentCycle % 1000000u);
+    vos_addTime(&due, &pSlot->latestCycleStartTimeStamp);
+
+    if (!timerisset(pNextJob) || timercmp(&due, pNextJob, <))
+    {
+        *pNextJob = due;
+    }
+}
+
 /**********************************************************************************************************************/
 /** Access the transmitter index tables
  *  Assume to be called with the process cycle defined from openSession configuration!
@@ -1116,6 +1566,10 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
             {
                 break;
             }
+            if (pCurElement->pShard != NULL)
+            {
+                continue;   /* sent by its sender thread */
+            }
             err = trdp_pdSendElement(appHandle, &pCurElement);
             if (err != TRDP_NO_ERR)
             {
@@ -1136,6 +1590,10 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
                 {
                     break;
                 }
+                if (pCurElement->pShard != NULL)
+                {
+                    continue;   /* sent by its sender thread */
+                }
                 err = trdp_pdSendElement(appHandle, &pCurElement);
                 if (err != TRDP_NO_ERR)
                 {
@@ -1174,6 +1632,10 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
                 {
                     break;
                 }
+                if (pCurElement->pShard != NULL)
+                {
+                    continue;   /* sent by its sender thread */
+                }
                 err = trdp_pdSendElement(appHandle, &pCurElement);
                 if (err != TRDP_NO_ERR)
                 {
@@ -1190,7 +1652,8 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
 
                 for (depth = 0; (depth < pSlot->noOfExtTxEntries) && (pSlot->pExtTxTable[depth] != NULL); depth++)
                 {
-                    if (!timercmp(&pSlot->pExtTxTable[depth]->timeToGo, &now, >))
+                    if ((pSlot->pExtTxTable[depth]->pShard == NULL) &&
+                        !timercmp(&pSlot->pExtTxTable[depth]->timeToGo, &now, >))
                     {
                         /*  Set timer if interval was set.                     */
                         vos_addTime(&pSlot->pExtTxTable[depth]->timeToGo,
@@ -1271,6 +1734,7 @@ TRDP_ERR_T trdp_indexCreateSubTables (TRDP_SESSION_PT appHandle)
         }
         if (noOfSubs == 0)
         {
+            pSlot->noOfRxEntries = 0u;
             return err;
         }
 
@@ -1333,6 +1797,13 @@ TRDP_ERR_T trdp_indexCreateSubTables (TRDP_SESSION_PT appHandle)
         /* sort the table on interval (aka timeout) */
         vos_qsort(pSlot->pRcvTableTimeOut, noOfSubs, sizeof(PD_ELE_T *), compareTimeouts);
 
+        {
+            TRDP_TIME_T now;
+
+            vos_getTime(&now);
+            rcvTimeoutRecompute(pSlot, &now);
+        }
+
 #ifdef DEBUG
         print_rcv_tables(pSlot->pRcvTableComId, pSlot->noOfRxEntries, "ComId");
         print_rcv_tables(pSlot->pRcvTableTimeOut, pSlot->noOfRxEntries, "Timeout");
@@ -1391,8 +1862,12 @@ PD_ELE_T *trdp_indexedFindSubAddr (
 
 /******************************************************************************/
 /** Check for pending packets, set FD if non blocking
+ *  The interval returned ends with the earliest time-out of the subscriptions, or after 1s if none is supervised.
+ *  The earliest time-out is kept by the index tables, it is not searched for here.
+ *  Sending is not included, the indexed send tables are processed with the process cycle time.
  *
  *  @param[in]      appHandle           session pointer
+ *  @param[out]     pInterval           pointer to needed interval
  *  @param[in,out]  pFileDesc           pointer to set of ready descriptors
  *  @param[in,out]  pNoDesc             pointer to number of ready descriptors
  */
@@ -1402,31 +1877,30 @@ void trdp_indexCheckPending (
     TRDP_FDS_T          *pFileDesc,
     TRDP_SOCK_T         *pNoDesc)    /* #399 */
 {
-    PD_ELE_T    * *iterPD;
     UINT32      idx;
-    TRDP_TIME_T delay = {0u, TRDP_HIGH_CYCLE_LIMIT / 1000};      /* #380: This determines the max. delay to report a timeout. 10000ms upon base 10 or 8192ms upon base 2  */
+    TRDP_TIME_T now;
+    TRDP_TIME_T delay = {1u, 0u};                   /* #407: no supervised subscription */
+
+    vos_getTime(&now);
+    vos_clearTime(&appHandle->nextJob);
 
-    if ((appHandle->pSlot == NULL) || (appHandle->pSlot->pRcvTableTimeOut == NULL))
+    if (appHandle->pSlot != NULL)
     {
-        *pInterval = delay;   /* #407 */
-        return;
+        appHandle->nextJob = appHandle->pSlot->nextRxTimeout;
     }
 
-    iterPD = appHandle->pSlot->pRcvTableTimeOut;
-
-    /*    Find the first packet with a non-zero timeout value; we search the ordered list and
-     stop at the first non-zero PD Element (usually the first) */
-    for (idx = 0; idx < appHandle->pSlot->noOfRxEntries; idx++)
+    if (timerisset(&appHandle->nextJob))
     {
-        if (timerisset(&iterPD[idx]->interval))
+        delay = appHandle->nextJob;
+        if (timercmp(&delay, &now, >))
         {
-            delay = iterPD[idx]->interval;
-            break;
+            vos_subTime(&delay, &now);
+        }
+        else
+        {
+            vos_clearTime(&delay);                  /* 0ms if time is over (were we delayed?) */
         }
     }
-    /*    Get the current time and add the found interval to nextjob  */
-    vos_getTime(&appHandle->nextJob);
-    vos_addTime(&appHandle->nextJob, &delay);
 
     /* Return the interval for select() directly */
     *pInterval = delay;
@@ -1448,6 +1922,186 @@ void trdp_indexCheckPending (
     }
 }
 
+/******************************************************************************/
+/** Add a publisher to the index tables
+ *  Once created by tlc_updateSession, the tables are not rebuilt for a new publisher: it is entered into the least
+ *  loaded slots of its category, the other telegrams keep their slots. Only if there is no room left, the tables are
+ *  rebuilt completely.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            pointer of the publisher element to be added (already in the send queue)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *                  TRDP_MEM_ERR        not enough memory
+ *                  TRDP_PARAM_ERR      unsupported configuration
+ */
+TRDP_ERR_T  trdp_indexAddPub (TRDP_SESSION_PT appHandle, PD_ELE_T *pElement)
+{
+    TRDP_ERR_T          err     = TRDP_NO_ERR;
+    TRDP_HP_CAT_SLOTS_T *pSlot  = appHandle->pSlot;
+
+    if ((pSlot == NULL) || (pSlot->tablesValid == FALSE))
+    {
+        return TRDP_NO_ERR;     /* tables will be created by tlc_updateSession */
+    }
+
+    switch (perf_table_category(pElement))
+    {
+        case PERF_LOW_TABLE:
+            err = insertPub(&pSlot->lowCat, pElement);
+            break;
+        case PERF_MID_TABLE:
+            err = insertPub(&pSlot->midCat, pElement);
+            break;
+        case PERF_HIGH_TABLE:
+            err = insertPub(&pSlot->highCat, pElement);
+            break;
+        case PERF_EXT_TABLE:
+        {
+            UINT32 idx;
+
+            /* Take a free entry first */
+            for (idx = 0u; idx < pSlot->noOfExtTxEntries; idx++)
+            {
+                if (pSlot->pExtTxTable[idx] == NULL)
+                {
+                    pSlot->pExtTxTable[idx] = pElement;
+                    return TRDP_NO_ERR;
+                }
+            }
+            if (pSlot->noOfExtTxEntries == 255u)
+            {
+                vos_printLog(VOS_LOG_ERROR, "More than 255 PDs with interval > %ums are not supported!\n",
+                             TRDP_HIGH_CYCLE_LIMIT / 1000u);
+                return TRDP_PARAM_ERR;
+            }
+            if (pSlot->allocatedExtTxTableSize < (idx + 1u) * sizeof(PD_ELE_T *))
+            {
+                UINT32      newSize     = (2u * idx + 1u < 255u) ? (2u * idx + 1u) : 255u;
+                PD_ELE_T    * *pNewTable = (PD_ELE_T * *) vos_memAlloc(newSize * sizeof(PD_ELE_T *));
+                if (pNewTable == NULL)
+                {
+                    return TRDP_MEM_ERR;
+                }
+                if (pSlot->pExtTxTable != NULL)
+                {
+                    memcpy(pNewTable, pSlot->pExtTxTable, idx * sizeof(PD_ELE_T *));
+                    vos_memFree(pSlot->pExtTxTable);
+                }
+                vos_printLog(VOS_LOG_WARNING,
+                             "Pre-allocated extended table size was not sufficent, enlarge size! (%u < %u)\n",
+                             (unsigned int) (pSlot->allocatedExtTxTableSize / sizeof(PD_ELE_T *)),
+                             (unsigned int) (idx + 1u));
+                pSlot->pExtTxTable              = pNewTable;
+                pSlot->allocatedExtTxTableSize  = newSize * sizeof(PD_ELE_T *);
+            }
+            pSlot->pExtTxTable[idx] = pElement;
+            pSlot->noOfExtTxEntries++;
+            break;
+        }
+        case PERF_IGNORE:
+            break;
+    }
+
+    if (err == TRDP_MEM_ERR)
+    {
+        /* No room left without additional jitter: rebuild (and enlarge) the tables */
+        vos_printLog(VOS_LOG_WARNING, "No room for comId %u in index table, rebuilding the tables\n",
+                     (unsigned int) pElement->addr.comId);
+        err = trdp_indexCreatePubTables(appHandle);
+    }
+    return err;
+}
+
+/******************************************************************************/
+/** Add a subscriber to the index tables
+ *  Once created by tlc_updateSession, the subscriber is inserted into both sorted tables directly.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            pointer of the subscriber element to be added (already in the receive queue)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *                  TRDP_MEM_ERR        not enough memory
+ */
+TRDP_ERR_T  trdp_indexAddSub (TRDP_SESSION_PT appHandle, PD_ELE_T *pElement)
+{
+    TRDP_HP_CAT_SLOTS_T *pSlot = appHandle->pSlot;
+    UINT32              idx;
+
+    if ((pSlot == NULL) || (pSlot->tablesValid == FALSE))
+    {
+        return TRDP_NO_ERR;     /* tables will be created by tlc_updateSession */
+    }
+
+    /* Check the index tables if they still fit: */
+    if ((pSlot->allocatedRcvTableSize / sizeof(PD_ELE_T * *)) <= pSlot->noOfRxEntries)
+    {
+        UINT32      noOfSubs        = 2u * pSlot->noOfRxEntries + 1u;
+        PD_ELE_T    * *pNewComId    = (PD_ELE_T * *) vos_memAlloc(noOfSubs * sizeof(PD_ELE_T * *));
+        PD_ELE_T    * *pNewTimeOut  = (PD_ELE_T * *) vos_memAlloc(noOfSubs * sizeof(PD_ELE_T * *));
+
+        if ((pNewComId == NULL) || (pNewTimeOut == NULL))
+        {
+            if (pNewComId != NULL)
+            {
+                vos_memFree(pNewComId);
+            }
+            if (pNewTimeOut != NULL)
+            {
+                vos_memFree(pNewTimeOut);
+            }
+            return TRDP_MEM_ERR;
+        }
+        if (pSlot->pRcvTableComId != NULL)
+        {
+            memcpy(pNewComId, pSlot->pRcvTableComId, pSlot->noOfRxEntries * sizeof(PD_ELE_T *));
+            vos_memFree(pSlot->pRcvTableComId);
+        }
+        if (pSlot->pRcvTableTimeOut != NULL)
+        {
+            memcpy(pNewTimeOut, pSlot->pRcvTableTimeOut, pSlot->noOfRxEntries * sizeof(PD_ELE_T *));
+            vos_memFree(pSlot->pRcvTableTimeOut);
+        }
+        vos_printLog(VOS_LOG_WARNING,
+                     "Pre-allocated receiver table size was not sufficent, enlarge no of subs! (%u < %u)\n",
+                     (unsigned int) (pSlot->allocatedRcvTableSize / sizeof(PD_ELE_T * *)),
+                     (unsigned int) (pSlot->noOfRxEntries + 1u));
+        pSlot->pRcvTableComId           = pNewComId;
+        pSlot->pRcvTableTimeOut         = pNewTimeOut;
+        pSlot->allocatedRcvTableSize    = noOfSubs * sizeof(PD_ELE_T * *);
+    }
+
+    /* Insert behind the equal ones, as if the tables were sorted again */
+    idx = rcvTablePos(pSlot->pRcvTableComId, pSlot->noOfRxEntries, pElement, compareComIds, TRUE);
+    memmove(&pSlot->pRcvTableComId[idx + 1u], &pSlot->pRcvTableComId[idx],
+            (pSlot->noOfRxEntries - idx) * sizeof(PD_ELE_T *));
+    pSlot->pRcvTableComId[idx] = pElement;
+
+    idx = rcvTablePos(pSlot->pRcvTableTimeOut, pSlot->noOfRxEntries, pElement, compareTimeouts, TRUE);
+    memmove(&pSlot->pRcvTableTimeOut[idx + 1u], &pSlot->pRcvTableTimeOut[idx],
+            (pSlot->noOfRxEntries - idx) * sizeof(PD_ELE_T *));
+    pSlot->pRcvTableTimeOut[idx] = pElement;
+
+    pSlot->noOfRxEntries++;
+    rcvTimeoutMerge(pSlot, pElement);
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Let the earliest receive time-out include the re-armed time-out of a subscriber
+ *  To be called whenever the timeToGo of a subscriber is set anew.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            pointer of the subscriber
+ */
+void    trdp_indexSubArmed (TRDP_SESSION_PT appHandle, const PD_ELE_T *pElement)
+{
+    if (appHandle->pSlot != NULL)
+    {
+        rcvTimeoutMerge(appHandle->pSlot, pElement);
+    }
+}
+
 /******************************************************************************/
 /** Remove publisher from the index tables
  *
@@ -1484,14 +2138,17 @@ void    trdp_indexRemovePub (TRDP_SESSION_PT appHandle, PD_ELE_T *pElement)
         return;
     }
 
-    /* Must be an extended interval entry */
+    /* Must be an extended interval entry, close the gap as the sender stops at the first empty entry */
     if (pSlot->noOfExtTxEntries != 0)
     {
         for (idx = 0; idx < pSlot->noOfExtTxEntries; idx++)
         {
             if (pSlot->pExtTxTable[idx] == pElement)
             {
-                pSlot->pExtTxTable[idx] = NULL;
+                memmove(&pSlot->pExtTxTable[idx], &pSlot->pExtTxTable[idx + 1u],
+                        (pSlot->noOfExtTxEntries - idx - 1u) * sizeof(PD_ELE_T *));
+                pSlot->pExtTxTable[pSlot->noOfExtTxEntries - 1u] = NULL;
+                break;
             }
         }
     }
@@ -1499,6 +2156,7 @@ void    trdp_indexRemovePub (TRDP_SESSION_PT appHandle, PD_ELE_T *pElement)
 
 /******************************************************************************/
 /** Remove subscriber from the index tables
+ *  Must be called after the subscriber element was removed from the receive queue and before it is freed.
  *
  *  @param[in]      appHandle           session pointer
  *  @param[in]      pElement            pointer of the subscriber to be removed
@@ -1506,21 +2164,184 @@ void    trdp_indexRemovePub (TRDP_SESSION_PT appHandle, PD_ELE_T *pElement)
  */
 void    trdp_indexRemoveSub (TRDP_SESSION_PT appHandle, PD_ELE_T *pElement)
 {
-    TRDP_ERR_T err = TRDP_NO_ERR;
+    TRDP_HP_CAT_SLOTS_T *pSlot = appHandle->pSlot;
 
-    if (appHandle->pSlot == NULL)
+    if ((pSlot == NULL) || (pSlot->noOfRxEntries == 0u))
+    {
+        return;
+    }
+
+    if ((rcvTableRemove(pSlot->pRcvTableComId, pSlot->noOfRxEntries, pElement, compareComIds) == TRUE) &&
+        (rcvTableRemove(pSlot->pRcvTableTimeOut, pSlot->noOfRxEntries, pElement, compareTimeouts) == TRUE))
+    {
+        pSlot->noOfRxEntries--;
+    }
+    else
+    {
+        /* Not found in both tables, this should never happen: we must (re-)create these index tables! */
+        TRDP_ERR_T err = trdp_indexCreateSubTables(appHandle);
+
+        if (err != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR,
+                         "Critical error while unsubscribing comId %u in High Performance Mode! (%d)\n",
+                         (unsigned int) pElement->addr.comId, err);
+        }
+    }
+}
+
+/******************************************************************************/
+/** Report the occupation of the index tables of one category
+ *
+ *  @param[in]      pSndQueue           send queue
+ *  @param[in]      category            category of the table
+ *  @param[in]      pCat                pointer to entry holding the index table
+ *  @param[out]     pStatistics         occupation of the table
+ *
+ */
+static void catStatistics (
+    PD_ELE_T                    *pSndQueue,
+    PERF_TABLE_TYPE_T           category,
+    TRDP_HP_CAT_SLOT_T          *pCat,
+    TRDP_IDX_CAT_STATISTICS_T   *pStatistics)
+{
+    UINT32      slot, depth;
+    PD_ELE_T    *pIter;
+
+    pStatistics->slotCycle  = pCat->slotCycle;
+    pStatistics->depth      = pCat->depthOfTxEntries;
+
+    for (pIter = pSndQueue; pIter != NULL; pIter = pIter->pNext)
+    {
+        if (perf_table_category(pIter) == category)
+        {
+            pStatistics->noOfPublishers++;
+        }
+    }
+
+    if ((pCat->ppIdxCat == NULL) || (pCat->slotCycle == 0u))
+    {
+        return;
+    }
+    pStatistics->noOfSlots      = (pCat->noOfTxEntries < TRDP_IDX_MAX_SLOTS) ? pCat->noOfTxEntries : TRDP_IDX_MAX_SLOTS;
+    pStatistics->requiredDepth  = requiredDepth(pSndQueue, category, pCat->slotCycle, pCat->noOfTxEntries);
+
+    for (slot = 0u; slot < pStatistics->noOfSlots; slot++)
+    {
+        UINT32 fill = 0u;
+
+        for (depth = 0u; depth < pCat->depthOfTxEntries; depth++)
+        {
+            PD_ELE_T *pElement = getElement(pCat, slot, depth);
+
+            if (pElement != NULL)
+            {
+                pStatistics->slotBytes[slot] += pElement->grossSize;
+                fill++;
+            }
+        }
+        pStatistics->slotFill[slot] = (UINT8) fill;
+        pStatistics->depthHistogram[fill]++;
+        if (fill > pStatistics->maxFill)
+        {
+            pStatistics->maxFill = fill;
+        }
+        if (pStatistics->slotBytes[slot] > pStatistics->maxSlotBytes)
+        {
+            pStatistics->maxSlotBytes = pStatistics->slotBytes[slot];
+        }
+    }
+}
+
+/******************************************************************************/
+/** Report the occupation of the index tables
+ *  Per-slot fill and bytes of each category, the worst case bytes per send cycle and the table sizes the current
+ *  publishers and subscribers need.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[out]     pStatistics         occupation of the tables
+ *
+ */
+void    trdp_indexStatistics (TRDP_SESSION_PT appHandle, TRDP_IDX_STATISTICS_T *pStatistics)
+{
+    TRDP_HP_CAT_SLOTS_T *pSlot = appHandle->pSlot;
+    PD_ELE_T            *pIter;
+
+    memset(pStatistics, 0, sizeof(TRDP_IDX_STATISTICS_T));
+
+    if (pSlot == NULL)
     {
         return;
     }
 
-    /* we must (re-)create these index tables! */
+    pStatistics->processCycle = pSlot->processCycle;
+    catStatistics(appHandle->pSndQueue, PERF_LOW_TABLE, &pSlot->lowCat, &pStatistics->lowCat);
+    catStatistics(appHandle->pSndQueue, PERF_MID_TABLE, &pSlot->midCat, &pStatistics->midCat);
+    catStatistics(appHandle->pSndQueue, PERF_HIGH_TABLE, &pSlot->highCat, &pStatistics->highCat);
+
+    for (pIter = appHandle->pSndQueue; pIter != NULL; pIter = pIter->pNext)
+    {
+        if (perf_table_category(pIter) == PERF_EXT_TABLE)
+        {
+            pStatistics->noOfExtPublishers++;
+        }
+    }
+    pStatistics->noOfSubscriptions = pSlot->noOfRxEntries;
+
+    /* Walk through the slots as trdp_pdSendIndexed() does, over one full period of the high table */
+    if ((pStatistics->lowCat.noOfSlots != 0u) &&
+        (pStatistics->midCat.noOfSlots != 0u) &&
+        (pStatistics->highCat.noOfSlots != 0u))
+    {
+        UINT32 cycleN;
 
-    err = trdp_indexCreateSubTables(appHandle);
+        for (cycleN = 0u; cycleN < pStatistics->highCat.noOfSlots * pSlot->highCat.slotCycle; cycleN += TRDP_MIN_CYCLE)
+        {
+            UINT32  idxLow  = (cycleN / pSlot->lowCat.slotCycle) % pStatistics->lowCat.noOfSlots;
+            UINT32  bytes   = pStatistics->lowCat.slotBytes[idxLow];
 
-    if (err != TRDP_NO_ERR)
+            if ((idxLow % (TRDP_MID_CYCLE / TRDP_LOW_CYCLE)) == (TRDP_MID_CYCLE / TRDP_LOW_CYCLE / 2))
+            {
+                bytes += pStatistics->midCat.slotBytes[(cycleN / pSlot->midCat.slotCycle) %
+                                                       pStatistics->midCat.noOfSlots];
+            }
+            if (idxLow == 0u)
+            {
+                bytes += pStatistics->highCat.slotBytes[(cycleN / pSlot->highCat.slotCycle) %
+                                                        pStatistics->highCat.noOfSlots];
+            }
+            if (bytes > pStatistics->maxCycleBytes)
+            {
+                pStatistics->maxCycleBytes = bytes;
+            }
+        }
+    }
+
+    /* The sizes to preset for the current publishers and subscribers */
+    pStatistics->requiredSizes.maxNoOfLowCatPublishers      = pStatistics->lowCat.noOfPublishers;
+    pStatistics->requiredSizes.maxDepthOfLowCatPublishers   = pStatistics->lowCat.requiredDepth;
+    pStatistics->requiredSizes.maxNoOfMidCatPublishers      = pStatistics->midCat.noOfPublishers;
+    pStatistics->requiredSizes.maxDepthOfMidCatPublishers   = pStatistics->midCat.requiredDepth;
+    pStatistics->requiredSizes.maxNoOfHighCatPublishers     = pStatistics->highCat.noOfPublishers;
+    pStatistics->requiredSizes.maxDepthOfHighCatPublishers  = pStatistics->highCat.requiredDepth;
+    pStatistics->requiredSizes.maxNoOfExtPublishers         = pStatistics->noOfExtPublishers;
+
+    for (pIter = appHandle->pRcvQueue; pIter != NULL; pIter = pIter->pNext)
     {
-        vos_printLog(VOS_LOG_ERROR, "Critical error while unsubscribing comId %u in High Performance Mode! (%d)\n",
-                     (unsigned int) pElement->addr.comId, err);
+        UINT32 timeout = (UINT32) pIter->interval.tv_usec + (UINT32) pIter->interval.tv_sec * 1000000u;
+
+        if (timeout <= TRDP_LOW_CYCLE_LIMIT)
+        {
+            pStatistics->requiredSizes.maxNoOfLowCatSubscriptions++;
+        }
+        else if (timeout <= TRDP_MID_CYCLE_LIMIT)
+        {
+            pStatistics->requiredSizes.maxNoOfMidCatSubscriptions++;
+        }
+        else
+        {
+            pStatistics->requiredSizes.maxNoOfHighCatSubscriptions++;
+        }
     }
 }
 
@@ -17,6 +17,8 @@
 /*
  * $Id$
  *
+ *      AG 2026-10-18: TRDP_IDX_DEPTH_RESERVE for the automatic sizing, trdp_indexStatistics()
+ *      AG 2026-10-18: Publishers and subscribers are added to and removed from existing index tables incrementally
  *     CWE 2023-02-14: Ticket #419 PDTestFastBase2 failed - clarified comments
  *     CWE 2023-02-02: Ticket #380 Added base 2 cycle time support for high performance PD: set HIGH_PERF_BASE2=1 in make config file (see LINUX_HP2_config)
  *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
@@ -51,6 +53,10 @@
 #define TRDP_MIN_CYCLE              1000u               /**<  1ms cycle      */
 #define TRDP_MAX_CYCLE             10000u               /**< 10ms cycle      */
 
+#ifndef TRDP_IDX_DEPTH_RESERVE
+#define TRDP_IDX_DEPTH_RESERVE        25u               /**< automatic sizing: depth reserve (%) for later publishers */
+#endif
+
 #define CLOCK_PERCENT_ERROR_LIMIT   125.0               /**< more than 25% overtime: ERROR, consider to improve setup     */
 #define CLOCK_PERCENT_WARNING_LIMIT 110.0               /**< more than 10% overtime: WARNING, might be critical           */
 #define CLOCK_PERCENT_INFO_LIMIT    102.0               /**< more than  2% overtime: INFO, should be acceptable           */
@@ -154,10 +160,13 @@ typedef struct hp_slots
     PD_ELE_T            * *pRcvTableComId;              /**< subscribed PD receivers: Pointer to ComId-sorted array               */
     PD_ELE_T            * *pRcvTableTimeOut;            /**< subscribed PD receivers: Pointer to timeout-sorted array             */
     UINT32              allocatedRcvTableSize;          /**< subscribed PD receivers: real allocated size (in bytes)              */
+    TRDP_TIME_T         nextRxTimeout;                  /**< subscribed PD receivers: earliest time-out (or earlier), kept up to date */
 
     UINT8               noOfExtTxEntries;               /**< very long cycle-time PD transmitters: number of entries              */
     PD_ELE_T            * *pExtTxTable;                 /**< very long cycle-time PD transmitters: Pointer to array               */
     UINT32              allocatedExtTxTableSize;        /**< very long cycle-time PD transmitters: real allocated size (in bytes) */
+
+    BOOL8               tablesValid;                    /**< tables created by tlc_updateSession, maintained incrementally since  */
 } TRDP_HP_CAT_SLOTS_T;
 
 /***********************************************************************************************************************
@@ -182,6 +191,8 @@ void        trdp_queueInsThroughputAccending (PD_ELE_T  * *ppHead,
                                               PD_ELE_T  *pNew);
 
 TRDP_ERR_T  trdp_pdSendIndexed (TRDP_SESSION_PT appHandle);
+void        trdp_indexNextSend (const TRDP_SESSION_T    *appHandle,
+                                TRDP_TIME_T             *pNextJob);
 void        trdp_pdHandleTimeOutsIndexed (TRDP_SESSION_PT appHandle);
 
 PD_ELE_T    *trdp_indexedFindSubAddr (TRDP_SESSION_PT   appHandle,
@@ -193,9 +204,17 @@ void        trdp_indexCheckPending (TRDP_APP_SESSION_T  appHandle,
                                     TRDP_TIME_T         *pInterval,
                                     TRDP_FDS_T          *pFileDesc,
                                     TRDP_SOCK_T         *pNoDesc);  /* #399 */
+TRDP_ERR_T  trdp_indexAddPub (TRDP_SESSION_PT  appHandle,
+                              PD_ELE_T         *pElement);
+TRDP_ERR_T  trdp_indexAddSub (TRDP_SESSION_PT  appHandle,
+                              PD_ELE_T         *pElement);
 void        trdp_indexRemovePub (TRDP_SESSION_PT    appHandle,
                                  PD_ELE_T           *pElement);
 void        trdp_indexRemoveSub (TRDP_SESSION_PT    appHandle,
                                  PD_ELE_T           *pElement);
+void        trdp_indexSubArmed (TRDP_SESSION_PT     appHandle,
+                                const PD_ELE_T      *pElement);
+void        trdp_indexStatistics (TRDP_SESSION_PT       appHandle,
+                                  TRDP_IDX_STATISTICS_T *pStatistics);
 
 #endif /* TRDP_PDINDEX_H */
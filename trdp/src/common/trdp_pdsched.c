@@ -0,0 +1,685 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_pdsched.c
+ *
+ * @brief           Hyperperiod scheduler for cyclic process data
+ *
+ * @details         The schedule divides time into slots of one process cycle, starting at an epoch. A publisher with
+ *                  a period of p slots and the phase f is sent in the slots f, f + p, f + 2p, ... The load profile
+ *                  holds the bytes sent in each slot of the hyperperiod, the least common multiple of all periods.
+ *                  The phases are chosen greedily: publishers are placed in the order of their byte rate, each into
+ *                  the phase where the largest slot it is sent in is smallest. Publishers added later are placed into
+ *                  the existing profile without moving the others.
+ *                  The sender keeps adding the interval to the send time, a telegram's interval is not altered by
+ *                  the schedule. A telegram is never moved to an earlier time: when a running publisher gets a new
+ *                  phase, one interval is stretched up to the new phase.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <string.h>
+
+#include "trdp_pdsched.h"
+#include "trdp_utils.h"
+#include "vos_mem.h"
+#include "vos_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Check if a publisher is subject to scheduling
+ *
+ *  @param[in]      pElement            publisher
+ *
+ *  @retval         TRUE                cyclic, not sent on request or on put only
+ */
+static BOOL8 isCyclic (
+    const PD_ELE_T *pElement)
+{
+    return (timerisset(&pElement->interval) && !(pElement->privFlags & TRDP_IS_TSN)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Interval of a publisher in microseconds
+ *
+ *  @param[in]      pElement            publisher
+ *
+ *  @retval         interval (us)
+ */
+static UINT64 intervalUs (
+    const PD_ELE_T *pElement)
+{
+    return (UINT64) pElement->interval.tv_sec * 1000000u + (UINT64) pElement->interval.tv_usec;
+}
+
+/**********************************************************************************************************************/
+/** Period of a publisher in slots, rounded to the nearest slot
+ *
+ *  @param[in]      pSched              schedule
+ *  @param[in]      pElement            publisher
+ *
+ *  @retval         period (>= 1)
+ */
+static UINT32 periodOf (
+    const TRDP_PD_SCHED_T   *pSched,
+    const PD_ELE_T          *pElement)
+{
+    UINT64 period = (intervalUs(pElement) + pSched->tick / 2u) / pSched->tick;
+
+    if (period == 0u)
+    {
+        period = 1u;
+    }
+    else if (period > 0xFFFFFFFFu)
+    {
+        period = 0xFFFFFFFFu;
+    }
+    return (UINT32) period;
+}
+
+/**********************************************************************************************************************/
+/** Least common multiple
+ *
+ *  @param[in]      a                   first value (> 0)
+ *  @param[in]      b                   second value (> 0)
+ *
+ *  @retval         lcm(a, b)
+ */
+static UINT64 lcm (
+    UINT64  a,
+    UINT64  b)
+{
+    UINT64  x = a;
+    UINT64  y = b;
+
+    while (y != 0u)
+    {
+        UINT64 r = x % y;
+        x = y;
+        y = r;
+    }
+    return (a / x) * b;
+}
+
+/**********************************************************************************************************************/
+/** Add a publisher to the load profile or take it out
+ *
+ *  @param[in]      pSched              schedule
+ *  @param[in]      phase               first slot of the publisher
+ *  @param[in]      period              period in slots
+ *  @param[in]      bytes               bytes sent per slot
+ *  @param[in]      add                 TRUE: add, FALSE: remove
+ */
+static void addLoad (
+    TRDP_PD_SCHED_T *pSched,
+    UINT32          phase,
+    UINT32          period,
+    UINT32          bytes,
+    BOOL8           add)
+{
+    UINT64 slot;
+
+    for (slot = phase; slot < pSched->hyperperiod; slot += period)
+    {
+        if (add == TRUE)
+        {
+            pSched->pLoad[slot] += bytes;
+        }
+        else
+        {
+            pSched->pLoad[slot] = (pSched->pLoad[slot] > bytes) ? pSched->pLoad[slot] - bytes : 0u;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Find the phase for a publisher with the smallest peak load
+ *
+ *  Ties are decided by the total load of the slots used, then by the earlier phase.
+ *
+ *  @param[in]      pSched              schedule
+ *  @param[in]      period              period in slots
+ *
+ *  @retval         phase
+ */
+static UINT32 bestPhase (
+    const TRDP_PD_SCHED_T   *pSched,
+    UINT32                  period)
+{
+    UINT32  span        = (period < pSched->hyperperiod) ? period : pSched->hyperperiod;
+    UINT32  best        = 0u;
+    UINT32  bestPeak    = 0xFFFFFFFFu;
+    UINT64  bestSum     = 0u;
+    UINT32  phase;
+
+    for (phase = 0u; phase < span; phase++)
+    {
+        UINT32  peak    = 0u;
+        UINT64  sum     = 0u;
+        UINT64  slot;
+
+        for (slot = phase; slot < pSched->hyperperiod; slot += period)
+        {
+            if (pSched->pLoad[slot] > peak)
+            {
+                peak = pSched->pLoad[slot];
+                if (peak > bestPeak)
+                {
+                    break;
+                }
+            }
+            sum += pSched->pLoad[slot];
+        }
+        if ((peak < bestPeak) ||
+            ((peak == bestPeak) && (sum < bestSum)))
+        {
+            best        = phase;
+            bestPeak    = peak;
+            bestSum     = sum;
+            if (peak == 0u)
+            {
+                break;          /* cannot get better */
+            }
+        }
+    }
+    return best;
+}
+
+/**********************************************************************************************************************/
+/** Compute the first send time of a publisher after a given time
+ *
+ *  @param[in]      pSched              schedule
+ *  @param[in]      phase               phase of the publisher
+ *  @param[in]      period              period in slots
+ *  @param[in]      pAfter              the send time must be later than this
+ *  @param[out]     pTime               send time
+ */
+static void nextSlotTime (
+    const TRDP_PD_SCHED_T   *pSched,
+    UINT32                  phase,
+    UINT32                  period,
+    const TRDP_TIME_T       *pAfter,
+    TRDP_TIME_T             *pTime)
+{
+    UINT64      slot    = phase;
+    UINT64      offset  = 0u;
+    TRDP_TIME_T delta;
+
+    if (vos_cmpTime(pAfter, &pSched->epoch) >= 0)
+    {
+        UINT64 current;
+
+        delta = *pAfter;
+        vos_subTime(&delta, &pSched->epoch);
+        current = ((UINT64) delta.tv_sec * 1000000u + (UINT64) delta.tv_usec) / pSched->tick;
+        if (slot <= current)
+        {
+            slot += ((current - slot) / period + 1u) * period;
+        }
+    }
+    offset = slot * pSched->tick;
+
+    delta.tv_sec    = (UINT32) (offset / 1000000u);
+    delta.tv_usec   = (UINT32) (offset % 1000000u);
+    *pTime = pSched->epoch;
+    vos_addTime(pTime, &delta);
+}
+
+/**********************************************************************************************************************/
+/** Enter a publisher into the load profile at its best phase
+ *
+ *  @param[in]      pSched              schedule
+ *  @param[in]      pElement            publisher
+ */
+static void placePub (
+    TRDP_PD_SCHED_T *pSched,
+    PD_ELE_T        *pElement)
+{
+    UINT32 period = periodOf(pSched, pElement);
+
+    pElement->schedPhase = bestPhase(pSched, period);
+    addLoad(pSched, pElement->schedPhase, period, pElement->grossSize, TRUE);
+    pElement->privFlags |= TRDP_SCHEDULED;
+    pSched->noOfTelegrams++;
+}
+
+/**********************************************************************************************************************/
+/** Move a publisher to its best phase given all other publishers
+ *
+ *  The old phase is one of the candidates, the largest load of the slots used can only decrease.
+ *
+ *  @param[in]      pSched              schedule
+ *  @param[in]      pElement            publisher, entered into the profile
+ *
+ *  @retval         TRUE                the phase was changed
+ */
+static BOOL8 replacePub (
+    TRDP_PD_SCHED_T *pSched,
+    PD_ELE_T        *pElement)
+{
+    UINT32  period  = periodOf(pSched, pElement);
+    UINT32  phase   = pElement->schedPhase;
+
+    addLoad(pSched, phase, period, pElement->grossSize, FALSE);
+    pElement->schedPhase = bestPhase(pSched, period);
+    addLoad(pSched, pElement->schedPhase, period, pElement->grossSize, TRUE);
+    return (pElement->schedPhase != phase) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Set the next send time of a scheduled publisher
+ *
+ *  The publisher is never sent earlier than planned, this would shorten its current interval.
+ *
+ *  @param[in]      pSched              schedule
+ *  @param[in]      pElement            publisher, entered into the profile
+ *  @param[in]      pNow                current time
+ */
+static void startPub (
+    const TRDP_PD_SCHED_T   *pSched,
+    PD_ELE_T                *pElement,
+    const TRDP_TIME_T       *pNow)
+{
+    TRDP_TIME_T after = (vos_cmpTime(&pElement->timeToGo, pNow) > 0) ? pElement->timeToGo : *pNow;
+
+    nextSlotTime(pSched, pElement->schedPhase, periodOf(pSched, pElement), &after, &pElement->timeToGo);
+}
+
+/**********************************************************************************************************************/
+/** Set the length of the load profile and recompute it from the scheduled publishers
+ *
+ *  @param[in]      appHandle           session
+ *  @param[in]      hyperperiod         new length in slots
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory, the profile is unchanged
+ */
+static TRDP_ERR_T resizeProfile (
+    TRDP_SESSION_PT appHandle,
+    UINT32          hyperperiod)
+{
+    TRDP_PD_SCHED_T *pSched = appHandle->pSched;
+    UINT32          *pLoad  = (UINT32 *) vos_memAlloc(hyperperiod * sizeof(UINT32));   /* cleared */
+    PD_ELE_T        *iterPD;
+
+    if (pLoad == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    if (pSched->pLoad != NULL)
+    {
+        vos_memFree(pSched->pLoad);
+    }
+    pSched->pLoad       = pLoad;
+    pSched->hyperperiod = hyperperiod;
+
+    for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if (iterPD->privFlags & TRDP_SCHEDULED)
+        {
+            addLoad(pSched, iterPD->schedPhase, periodOf(pSched, iterPD), iterPD->grossSize, TRUE);
+        }
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Create the schedule of a session, if not yet done
+ *
+ *  @param[in]      appHandle           session
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+static TRDP_ERR_T initSchedule (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_PD_SCHED_T *pSched;
+
+    if (appHandle->pSched != NULL)
+    {
+        return TRDP_NO_ERR;
+    }
+    pSched = (TRDP_PD_SCHED_T *) vos_memAlloc(sizeof(TRDP_PD_SCHED_T));
+    if (pSched == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pSched->tick = (appHandle->stats.processCycle != 0u) ? appHandle->stats.processCycle : TRDP_SCHED_DEFAULT_TICK;
+    vos_getTime(&pSched->epoch);
+    appHandle->pSched = pSched;
+
+    if (resizeProfile(appHandle, 1u) != TRDP_NO_ERR)
+    {
+        vos_memFree(pSched);
+        appHandle->pSched = NULL;
+        return TRDP_MEM_ERR;
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Order publishers by byte rate, highest first; shorter interval first on equal rates
+ *
+ *  @param[in]      pArg1               pointer to first publisher pointer
+ *  @param[in]      pArg2               pointer to second publisher pointer
+ *
+ *  @retval         -1, 0, 1
+ */
+static int compareRate (
+    const void  *pArg1,
+    const void  *pArg2)
+{
+    const PD_ELE_T  *p1     = *(const PD_ELE_T * const *) pArg1;
+    const PD_ELE_T  *p2     = *(const PD_ELE_T * const *) pArg2;
+    UINT64          rate1   = (UINT64) p1->grossSize * intervalUs(p2);
+    UINT64          rate2   = (UINT64) p2->grossSize * intervalUs(p1);
+
+    if (rate1 != rate2)
+    {
+        return (rate1 > rate2) ? -1 : 1;
+    }
+    if (intervalUs(p1) != intervalUs(p2))
+    {
+        return (intervalUs(p1) < intervalUs(p2)) ? -1 : 1;
+    }
+    return 0;
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Compute the schedule of all cyclic publishers of a session
+ *
+ *  The hyperperiod is the LCM of all periods, as far as it does not exceed TRDP_SCHED_MAX_HYPERPERIOD slots. The
+ *  publishers with the highest byte rates are taken into account first; the load of a publisher whose period would
+ *  exceed the limit is entered only within the profile length (approximation).
+ *  After the greedy placement, each publisher is moved to its best phase given all others, until no publisher moves
+ *  or TRDP_SCHED_REFINE_PASSES passes are done.
+ *
+ *  @param[in]      appHandle           session
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+TRDP_ERR_T trdp_pdScheduleAll (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_ERR_T  err;
+    PD_ELE_T    *iterPD;
+    PD_ELE_T    * *ppList;
+    UINT32      noOfPubs    = 0u;
+    UINT32      approximate = 0u;
+    UINT64      hyperperiod = 1u;
+    UINT32      idx;
+    UINT32      pass;
+    TRDP_TIME_T now;
+
+    err = initSchedule(appHandle);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        iterPD->privFlags = (TRDP_PRIV_FLAGS_T) (iterPD->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_SCHEDULED);
+        if (isCyclic(iterPD) == TRUE)
+        {
+            noOfPubs++;
+        }
+    }
+    appHandle->pSched->noOfTelegrams = 0u;
+
+    if (noOfPubs == 0u)
+    {
+        return resizeProfile(appHandle, 1u);
+    }
+
+    ppList = (PD_ELE_T * *) vos_memAlloc(noOfPubs * sizeof(PD_ELE_T *));
+    if (ppList == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    idx = 0u;
+    for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if (isCyclic(iterPD) == TRUE)
+        {
+            ppList[idx++] = iterPD;
+        }
+    }
+    vos_qsort(ppList, noOfPubs, sizeof(PD_ELE_T *), compareRate);
+
+    /* Hyperperiod of the publishers, the highest rates first */
+    for (idx = 0u; idx < noOfPubs; idx++)
+    {
+        UINT64 next = lcm(hyperperiod, periodOf(appHandle->pSched, ppList[idx]));
+
+        if (next <= TRDP_SCHED_MAX_HYPERPERIOD)
+        {
+            hyperperiod = next;
+        }
+        else
+        {
+            approximate++;
+        }
+    }
+
+    err = resizeProfile(appHandle, (UINT32) hyperperiod);
+    if (err == TRDP_NO_ERR)
+    {
+        /* A new epoch: the phases refer to the start of the current slot */
+        vos_getTime(&now);
+        appHandle->pSched->epoch = now;
+
+        for (idx = 0u; idx < noOfPubs; idx++)
+        {
+            placePub(appHandle->pSched, ppList[idx]);
+        }
+
+        /* Improve the greedy result: move single publishers as long as this helps */
+        for (pass = 0u; pass < TRDP_SCHED_REFINE_PASSES; pass++)
+        {
+            BOOL8 moved = FALSE;
+
+            for (idx = 0u; idx < noOfPubs; idx++)
+            {
+                if (replacePub(appHandle->pSched, ppList[idx]) == TRUE)
+                {
+                    moved = TRUE;
+                }
+            }
+            if (moved == FALSE)
+            {
+                break;
+            }
+        }
+
+        for (idx = 0u; idx < noOfPubs; idx++)
+        {
+            startPub(appHandle->pSched, ppList[idx], &now);
+        }
+
+        vos_printLog(VOS_LOG_INFO,
+                     "PD schedule: %u publishers, hyperperiod %u x %uus, peak %u bytes per cycle\n",
+                     (unsigned int) noOfPubs, (unsigned int) hyperperiod, (unsigned int) appHandle->pSched->tick,
+                     (unsigned int) trdp_pdSchedulePeak(appHandle));
+        if (approximate != 0u)
+        {
+            vos_printLog(VOS_LOG_WARNING,
+                         "PD schedule: hyperperiod limited to %u cycles, %u publishers scheduled approximately\n",
+                         (unsigned int) TRDP_SCHED_MAX_HYPERPERIOD, (unsigned int) approximate);
+        }
+    }
+    vos_memFree(ppList);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Enter a new publisher into the schedule
+ *
+ *  The publishers already scheduled keep their phases. The profile is extended to the new hyperperiod if needed.
+ *
+ *  @param[in]      appHandle           session
+ *  @param[in]      pElement            new publisher, member of the send queue
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+TRDP_ERR_T trdp_pdSchedulePub (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    TRDP_ERR_T  err;
+    UINT64      hyperperiod;
+    TRDP_TIME_T now;
+
+    if (isCyclic(pElement) == FALSE)
+    {
+        return TRDP_NO_ERR;
+    }
+    err = initSchedule(appHandle);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    hyperperiod = lcm(appHandle->pSched->hyperperiod, periodOf(appHandle->pSched, pElement));
+    if (hyperperiod > TRDP_SCHED_MAX_HYPERPERIOD)
+    {
+        vos_printLog(VOS_LOG_WARNING,
+                     "PD schedule: ComId %u exceeds the hyperperiod limit, scheduled approximately\n",
+                     (unsigned int) pElement->addr.comId);
+    }
+    else if (hyperperiod != appHandle->pSched->hyperperiod)
+    {
+        err = resizeProfile(appHandle, (UINT32) hyperperiod);
+        if (err != TRDP_NO_ERR)
+        {
+            return err;
+        }
+    }
+
+    vos_getTime(&now);
+    placePub(appHandle->pSched, pElement);
+    startPub(appHandle->pSched, pElement, &now);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Take a publisher out of the schedule
+ *
+ *  @param[in]      appHandle           session
+ *  @param[in]      pElement            publisher to be removed
+ */
+void trdp_pdScheduleRemovePub (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    if ((appHandle->pSched == NULL) ||
+        !(pElement->privFlags & TRDP_SCHEDULED))
+    {
+        return;
+    }
+    addLoad(appHandle->pSched, pElement->schedPhase, periodOf(appHandle->pSched, pElement), pElement->grossSize,
+            FALSE);
+    pElement->privFlags = (TRDP_PRIV_FLAGS_T) (pElement->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_SCHEDULED);
+    appHandle->pSched->noOfTelegrams--;
+}
+
+/**********************************************************************************************************************/
+/** Set the send time of a publisher which missed its slot
+ *
+ *  Scheduled publishers are set to their next slot after the current time, others one interval from now.
+ *
+ *  @param[in]      appHandle           session
+ *  @param[in]      pElement            publisher
+ *  @param[in]      pNow                current time
+ */
+void trdp_pdScheduleNext (
+    const TRDP_SESSION_T    *appHandle,
+    PD_ELE_T                *pElement,
+    const TRDP_TIME_T       *pNow)
+{
+    if ((appHandle->pSched == NULL) ||
+        !(pElement->privFlags & TRDP_SCHEDULED))
+    {
+        pElement->timeToGo = *pNow;
+        vos_addTime(&pElement->timeToGo, &pElement->interval);
+        return;
+    }
+    nextSlotTime(appHandle->pSched, pElement->schedPhase, periodOf(appHandle->pSched, pElement), pNow,
+                 &pElement->timeToGo);
+}
+
+/**********************************************************************************************************************/
+/** Largest number of bytes scheduled for one process cycle
+ *
+ *  @param[in]      appHandle           session
+ *
+ *  @retval         peak load (bytes), 0 if nothing is scheduled
+ */
+UINT32 trdp_pdSchedulePeak (
+    const TRDP_SESSION_T *appHandle)
+{
+    UINT32  peak = 0u;
+    UINT32  slot;
+
+    if (appHandle->pSched != NULL)
+    {
+        for (slot = 0u; slot < appHandle->pSched->hyperperiod; slot++)
+        {
+            if (appHandle->pSched->pLoad[slot] > peak)
+            {
+                peak = appHandle->pSched->pLoad[slot];
+            }
+        }
+    }
+    return peak;
+}
+
+/**********************************************************************************************************************/
+/** Release the schedule of a session
+ *
+ *  @param[in]      appHandle           session
+ */
+void trdp_pdScheduleDeInit (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->pSched != NULL)
+    {
+        if (appHandle->pSched->pLoad != NULL)
+        {
+            vos_memFree(appHandle->pSched->pLoad);
+        }
+        vos_memFree(appHandle->pSched);
+        appHandle->pSched = NULL;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
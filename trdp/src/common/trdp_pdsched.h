@@ -0,0 +1,97 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_pdsched.h
+ *
+ * @brief           Hyperperiod scheduler for cyclic process data
+ *
+ * @details         The scheduler assigns each cyclic publisher a send phase within the hyperperiod of all intervals,
+ *                  so that the bytes sent per process cycle are spread as evenly as possible. Telegrams keep their
+ *                  exact interval; the scheduler only chooses when, relative to the others, a telegram is sent.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+#ifndef TRDP_PDSCHED_H
+#define TRDP_PDSCHED_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_private.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#ifndef TRDP_SCHED_DEFAULT_TICK
+#define TRDP_SCHED_DEFAULT_TICK     1000u       /**< slot length (us) if no process cycle time was configured        */
+#endif
+
+#ifndef TRDP_SCHED_REFINE_PASSES
+#define TRDP_SCHED_REFINE_PASSES    4u          /**< max. improvement passes over all publishers after placement     */
+#endif
+
+#ifndef TRDP_SCHED_MAX_HYPERPERIOD
+#define TRDP_SCHED_MAX_HYPERPERIOD  60000u      /**< max. length of the load profile in slots (60s at 1ms cycle)     */
+#endif
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Load profile of the cyclic publishers of a session, one entry per process cycle of the hyperperiod */
+typedef struct TRDP_PD_SCHED
+{
+    TRDP_TIME_T epoch;                  /**< start of the first hyperperiod, phase 0 of all telegrams           */
+    UINT32      tick;                   /**< length of a slot (us), the process cycle time                      */
+    UINT32      hyperperiod;            /**< number of slots of the profile, the LCM of all periods if possible */
+    UINT32      noOfTelegrams;          /**< number of publishers entered into the profile                      */
+    UINT32      *pLoad;                 /**< bytes sent in each slot of the hyperperiod                         */
+} TRDP_PD_SCHED_T;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+TRDP_ERR_T  trdp_pdScheduleAll (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T  trdp_pdSchedulePub (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement);
+
+void        trdp_pdScheduleRemovePub (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement);
+
+void        trdp_pdScheduleNext (
+    const TRDP_SESSION_T    *appHandle,
+    PD_ELE_T                *pElement,
+    const TRDP_TIME_T       *pNow);
+
+UINT32      trdp_pdSchedulePeak (
+    const TRDP_SESSION_T *appHandle);
+
+void        trdp_pdScheduleDeInit (
+    TRDP_SESSION_PT appHandle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRDP_PDSCHED_H */
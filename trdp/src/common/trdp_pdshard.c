@@ -0,0 +1,780 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_pdshard.c
+ *
+ * @brief           Sender threads for cyclic process data
+ *
+ * @details         tlp_startSenders() partitions the cyclic publishers of a session into K shares of about equal byte
+ *                  rate (longest processing time first: the publishers are taken in the order of their byte rate,
+ *                  each into the share with the least load so far). Every share is sent by its own thread, which
+ *                  wakes up at absolute times every process cycle and sends the due telegrams of its share on its
+ *                  own sockets. The send times are kept exactly as tlp_processSend() would: the interval is added to
+ *                  the send time of each telegram, so the interval of a telegram does not depend on the thread.
+ *
+ *                  Locking: the share and the frames of its publishers are protected by the mutex of the share.
+ *                  The API functions changing a sharded publisher take mutexTxPD first and the share's mutex second
+ *                  (trdp_pdShardLock()); a sender thread only takes the mutex of its own share. Publishers are added
+ *                  to and removed from a share under mutexTxPD, only.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <string.h>
+
+#include "trdp_pdshard.h"
+#include "trdp_pdcom.h"
+#include "trdp_pdsched.h"
+#include "trdp_utils.h"
+#include "vos_mem.h"
+#include "vos_sock.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#ifndef TRDP_PD_SENDER_CYCLE
+#define TRDP_PD_SENDER_CYCLE    1000u       /**< send cycle (us) of the sender threads if no process cycle was set  */
+#endif
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Check if a publisher can be sent by a sender thread
+ *
+ *  @param[in]      pElement            publisher
+ *
+ *  @retval         TRUE                cyclic, not TSN
+ */
+static BOOL8 isShardable (
+    const PD_ELE_T *pElement)
+{
+    return (timerisset(&pElement->interval) && !(pElement->privFlags & TRDP_IS_TSN) &&
+            (pElement->socketIdx != TRDP_INVALID_SOCKET_INDEX)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Byte rate of a publisher
+ *
+ *  @param[in]      pElement            cyclic publisher
+ *
+ *  @retval         bytes per second
+ */
+static UINT64 rateOf (
+    const PD_ELE_T *pElement)
+{
+    UINT64 interval = (UINT64) pElement->interval.tv_sec * 1000000u + (UINT64) pElement->interval.tv_usec;
+
+    return (interval == 0u) ? 0u : ((UINT64) pElement->grossSize * 1000000u) / interval;
+}
+
+/**********************************************************************************************************************/
+/** Sort publishers by their byte rate, highest first
+ *
+ *  @param[in]      pArg1               pointer to first publisher pointer
+ *  @param[in]      pArg2               pointer to second publisher pointer
+ *
+ *  @retval         -1, 0, 1
+ */
+static int compareRate (
+    const void  *pArg1,
+    const void  *pArg2)
+{
+    UINT64  rate1   = rateOf(*(const PD_ELE_T * const *) pArg1);
+    UINT64  rate2   = rateOf(*(const PD_ELE_T * const *) pArg2);
+
+    if (rate1 != rate2)
+    {
+        return (rate1 > rate2) ? -1 : 1;
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Open the socket of a share matching a socket of the session
+ *  The socket gets the QoS, TTL and interface of the session's socket, it is used for sending only.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pShard              share
+ *  @param[in]      sockIdx             index into ifacePD[]
+ *
+ *  @retval         TRDP_NO_ERR         socket open
+ *  @retval         TRDP_SOCK_ERR       socket could not be opened
+ */
+static TRDP_ERR_T openSocket (
+    const TRDP_SESSION_T    *appHandle,
+    PD_SHARD_T              *pShard,
+    INT32                   sockIdx)
+{
+    const TRDP_SOCKETS_T    *pIface = &appHandle->ifacePD[sockIdx];
+    VOS_SOCK_OPT_T          sockOptions;
+
+    if (pShard->sock[sockIdx] != VOS_INVALID_SOCKET)
+    {
+        return TRDP_NO_ERR;
+    }
+
+    memset(&sockOptions, 0, sizeof(sockOptions));
+    sockOptions.qos             = pIface->sendParam.qos;
+    sockOptions.ttl             = pIface->sendParam.ttl;
+    sockOptions.ttl_multicast   = pIface->sendParam.ttl;
+    sockOptions.reuseAddrPort   = (appHandle->option & TRDP_OPTION_NO_REUSE_ADDR) ? FALSE : TRUE;
+    sockOptions.nonBlocking     = (appHandle->option & TRDP_OPTION_BLOCK) ? FALSE : TRUE;
+    sockOptions.no_mc_loop      = (appHandle->option & TRDP_OPTION_NO_MC_LOOP_BACK) ? 1 : 0;
+    sockOptions.no_udp_crc      = (appHandle->option & TRDP_OPTION_NO_UDP_CHK) ? 1 : 0;
+    sockOptions.vlanId          = pIface->sendParam.vlan;
+
+    if (vos_sockOpenUDP(&pShard->sock[sockIdx], &sockOptions) != VOS_NO_ERR)
+    {
+        pShard->sock[sockIdx] = VOS_INVALID_SOCKET;
+        return TRDP_SOCK_ERR;
+    }
+
+    if (pIface->bindAddr != 0u)
+    {
+        (void) vos_sockBind(pShard->sock[sockIdx], pIface->bindAddr, 0u);
+
+        /*    Multicast sender shall be bound to an interface    */
+        if (!vos_isMulticast(pIface->bindAddr) &&
+            (vos_sockSetMulticastIf(pShard->sock[sockIdx], pIface->bindAddr) != VOS_NO_ERR))
+        {
+            (void) vos_sockClose(pShard->sock[sockIdx]);
+            pShard->sock[sockIdx] = VOS_INVALID_SOCKET;
+            return TRDP_SOCK_ERR;
+        }
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Enter a publisher into a share (mutexTxPD held)
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pShard              share
+ *  @param[in]      pElement            cyclic publisher
+ *
+ *  @retval         TRDP_NO_ERR         entered
+ *  @retval         TRDP_MEM_ERR        out of memory, not entered
+ *  @retval         TRDP_SOCK_ERR       no socket, not entered
+ */
+static TRDP_ERR_T addToShard (
+    const TRDP_SESSION_T    *appHandle,
+    PD_SHARD_T              *pShard,
+    PD_ELE_T                *pElement)
+{
+    TRDP_ERR_T err = openSocket(appHandle, pShard, pElement->socketIdx);
+
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    if (vos_mutexLock(pShard->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+
+    if (pShard->noOfPubs == pShard->maxNoOfPubs)
+    {
+        UINT32      maxNoOfPubs = (pShard->maxNoOfPubs == 0u) ? 16u : 2u * pShard->maxNoOfPubs;
+        PD_ELE_T    * *ppPub    = (PD_ELE_T * *) vos_memAlloc(maxNoOfPubs * sizeof(PD_ELE_T *));
+
+        if (ppPub == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+        else
+        {
+            if (pShard->ppPub != NULL)
+            {
+                memcpy(ppPub, pShard->ppPub, pShard->noOfPubs * sizeof(PD_ELE_T *));
+                vos_memFree(pShard->ppPub);
+            }
+            pShard->ppPub       = ppPub;
+            pShard->maxNoOfPubs = maxNoOfPubs;
+        }
+    }
+
+    if (err == TRDP_NO_ERR)
+    {
+        pShard->ppPub[pShard->noOfPubs++]   = pElement;
+        pShard->load        += rateOf(pElement);
+        pElement->pShard    = pShard;
+    }
+
+    (void) vos_mutexUnlock(pShard->mutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Find the share with the least byte rate
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         share
+ */
+static PD_SHARD_T *leastLoaded (
+    const TRDP_SESSION_T *appHandle)
+{
+    PD_SHARD_T  *pBest = &appHandle->pPDShards[0];
+    UINT32      idx;
+
+    for (idx = 1u; idx < appHandle->noOfPDShards; idx++)
+    {
+        if (appHandle->pPDShards[idx].load < pBest->load)
+        {
+            pBest = &appHandle->pPDShards[idx];
+        }
+    }
+    return pBest;
+}
+
+/**********************************************************************************************************************/
+/** Sender thread of a share
+ *  Sends the due telegrams of the share every cycle. The cycles start at absolute times, the time needed for
+ *  sending does not add to the cycle.
+ *
+ *  @param[in]      pArg            share
+ *
+ *  @retval         NULL
+ */
+static void *trdp_pdSenderThread (void *pArg)
+{
+    PD_SHARD_T      *pShard     = (PD_SHARD_T *) pArg;
+    TRDP_SESSION_PT appHandle   = pShard->appHandle;
+    TRDP_TIME_T     cycle;
+    TRDP_TIME_T     deadline;
+    TRDP_TIME_T     now;
+    UINT32          idx;
+
+    cycle.tv_sec    = (long) (pShard->cycle / 1000000u);
+    cycle.tv_usec   = (long) (pShard->cycle % 1000000u);
+    vos_getTime(&deadline);
+
+    while (vos_atomicLoad32(&pShard->stop) == 0u)
+    {
+        if (vos_mutexLock(pShard->mutex) != VOS_NO_ERR)
+        {
+            break;
+        }
+
+        vos_getTime(&now);
+        for (idx = 0u; idx < pShard->noOfPubs; idx++)
+        {
+            PD_ELE_T *pElement = pShard->ppPub[idx];
+
+            if (timercmp(&pElement->timeToGo, &now, >))
+            {
+                continue;
+            }
+
+            /* There is nobody to report a send error to, the telegram is sent again after its interval */
+            (void) trdp_pdTransmit(appHandle, pElement, pShard);
+
+            vos_addTime(&pElement->timeToGo, &pElement->interval);
+            if (vos_cmpTime(&pElement->timeToGo, &now) <= 0)
+            {
+                /* more than one interval late, a scheduled packet returns to its phase */
+                trdp_pdScheduleNext(appHandle, pElement, &now);
+            }
+        }
+
+        vos_addTime(&deadline, &cycle);
+        vos_getTime(&now);
+        if (vos_cmpTime(&deadline, &now) <= 0)
+        {
+            /* Overrun: start the next cycle at once, do not try to catch up */
+            pShard->numOverrun++;
+            deadline = now;
+        }
+
+        (void) vos_mutexUnlock(pShard->mutex);
+
+        if (vos_cmpTime(&deadline, &now) > 0)
+        {
+            TRDP_TIME_T delay = deadline;
+
+            vos_subTime(&delay, &now);
+            (void) vos_threadDelay((UINT32) delay.tv_sec * 1000000u + (UINT32) delay.tv_usec);
+        }
+    }
+
+    vos_semaGive(pShard->stopped);
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Free the resources of the shares, the threads must have left (mutexTxPD held)
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      noOfShards          number of shares to release
+ */
+static void freeShards (
+    TRDP_SESSION_PT appHandle,
+    UINT32          noOfShards)
+{
+    UINT32 idx, sockIdx;
+
+    for (idx = 0u; idx < noOfShards; idx++)
+    {
+        PD_SHARD_T *pShard = &appHandle->pPDShards[idx];
+
+        while (pShard->noOfPubs > 0u)
+        {
+            pShard->ppPub[--pShard->noOfPubs]->pShard = NULL;
+        }
+        for (sockIdx = 0u; sockIdx < TRDP_MAX_PD_SOCKET_CNT; sockIdx++)
+        {
+            if (pShard->sock[sockIdx] != VOS_INVALID_SOCKET)
+            {
+                (void) vos_sockClose(pShard->sock[sockIdx]);
+            }
+        }
+        /* Keep the packets sent by this thread in the session statistics */
+        appHandle->stats.pd.numSend += pShard->numSend;
+
+        if (pShard->ppPub != NULL)
+        {
+            vos_memFree(pShard->ppPub);
+        }
+        vos_semaDelete(pShard->stopped);
+        vos_mutexDelete(pShard->mutex);
+    }
+    vos_memFree(appHandle->pPDShards);
+    appHandle->pPDShards    = NULL;
+    appHandle->noOfPDShards = 0u;
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Start the sender threads of a session and partition the cyclic publishers among them
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      noOfSenders         number of threads (1...TRDP_MAX_PD_SENDERS)
+ *  @param[in]      priority            thread priority (0 = default, 1...255 (highest))
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      number of threads out of range
+ *  @retval         TRDP_STATE_ERR      senders already running
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_THREAD_ERR     thread could not be created
+ */
+TRDP_ERR_T trdp_pdStartSenders (
+    TRDP_SESSION_PT appHandle,
+    UINT32          noOfSenders,
+    UINT8           priority)
+{
+    PD_ELE_T    * *ppList   = NULL;
+    PD_ELE_T    *iterPD;
+    UINT32      noOfPubs    = 0u;
+    UINT32      idx, sockIdx;
+    UINT32      noOfShards  = 0u;
+    BOOL8       stuck       = FALSE;
+    TRDP_ERR_T  err         = TRDP_NO_ERR;
+
+    if ((noOfSenders == 0u) || (noOfSenders > TRDP_MAX_PD_SENDERS))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+
+    if (appHandle->pPDShards != NULL)
+    {
+        (void) vos_mutexUnlock(appHandle->mutexTxPD);
+        return TRDP_STATE_ERR;
+    }
+
+    appHandle->pPDShards = (PD_SHARD_T *) vos_memAlloc(noOfSenders * sizeof(PD_SHARD_T));
+    if (appHandle->pPDShards == NULL)
+    {
+        (void) vos_mutexUnlock(appHandle->mutexTxPD);
+        return TRDP_MEM_ERR;
+    }
+
+    for (noOfShards = 0u; noOfShards < noOfSenders; noOfShards++)
+    {
+        PD_SHARD_T *pShard = &appHandle->pPDShards[noOfShards];
+
+        pShard->appHandle   = appHandle;
+        pShard->cycle       = (appHandle->stats.processCycle != 0u) ? appHandle->stats.processCycle :
+                                                                      TRDP_PD_SENDER_CYCLE;
+        for (sockIdx = 0u; sockIdx < TRDP_MAX_PD_SOCKET_CNT; sockIdx++)
+        {
+            pShard->sock[sockIdx] = VOS_INVALID_SOCKET;
+        }
+        if (vos_mutexCreate(&pShard->mutex) != VOS_NO_ERR)
+        {
+            err = TRDP_MUTEX_ERR;
+            break;
+        }
+        if (vos_semaCreate(&pShard->stopped, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+        {
+            vos_mutexDelete(pShard->mutex);
+            err = TRDP_THREAD_ERR;
+            break;
+        }
+    }
+    appHandle->noOfPDShards = noOfShards;
+
+    /* Partition the cyclic publishers, the highest byte rates first */
+    if (err == TRDP_NO_ERR)
+    {
+        for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+        {
+            noOfPubs += (isShardable(iterPD) == TRUE) ? 1u : 0u;
+        }
+        if (noOfPubs > 0u)
+        {
+            ppList = (PD_ELE_T * *) vos_memAlloc(noOfPubs * sizeof(PD_ELE_T *));
+            if (ppList == NULL)
+            {
+                err = TRDP_MEM_ERR;
+            }
+        }
+    }
+
+    if ((err == TRDP_NO_ERR) && (ppList != NULL))
+    {
+        noOfPubs = 0u;
+        for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+        {
+            if (isShardable(iterPD) == TRUE)
+            {
+                ppList[noOfPubs++] = iterPD;
+            }
+        }
+        vos_qsort(ppList, noOfPubs, sizeof(PD_ELE_T *), compareRate);
+
+        for (idx = 0u; idx < noOfPubs; idx++)
+        {
+            /* A publisher which cannot be entered stays with tlp_processSend() */
+            (void) addToShard(appHandle, leastLoaded(appHandle), ppList[idx]);
+        }
+        vos_memFree(ppList);
+    }
+
+    /* The senders block on their mutex until a share is complete, it is complete by now */
+    for (idx = 0u; (err == TRDP_NO_ERR) && (idx < noOfShards); idx++)
+    {
+        PD_SHARD_T *pShard = &appHandle->pPDShards[idx];
+
+        if (vos_threadCreate(&pShard->thread,
+                             "trdpPDSender",
+                             (priority == 0u) ? VOS_THREAD_POLICY_OTHER : VOS_THREAD_POLICY_FIFO,
+                             (VOS_THREAD_PRIORITY_T) priority,
+                             0u,
+                             0u,
+                             trdp_pdSenderThread,
+                             pShard) != VOS_NO_ERR)
+        {
+            UINT32 running;
+
+            /* stop the ones already started, the others have nothing to wait for */
+            for (running = 0u; running < noOfShards; running++)
+            {
+                vos_atomicStore32(&appHandle->pPDShards[running].stop, 2u);
+                if ((running < idx) &&
+                    (vos_semaTake(appHandle->pPDShards[running].stopped, TRDP_PD_SENDER_STOP_TIMEOUT) != VOS_NO_ERR))
+                {
+                    vos_atomicStore32(&appHandle->pPDShards[running].stop, 1u);
+                    stuck = TRUE;
+                }
+            }
+            err = TRDP_THREAD_ERR;
+        }
+    }
+
+    if (stuck == TRUE)
+    {
+        /* keep the resources, trdp_pdStopSenders() waits for the sender again */
+        vos_printLogStr(VOS_LOG_ERROR, "PD sender did not stop\n");
+    }
+    else if (err != TRDP_NO_ERR)
+    {
+        freeShards(appHandle, noOfShards);
+    }
+    else
+    {
+        vos_printLog(VOS_LOG_INFO, "PD sending started: %u threads, cycle %u us\n",
+                     (unsigned int) noOfShards, (unsigned int) appHandle->pPDShards[0].cycle);
+    }
+
+    (void) vos_mutexUnlock(appHandle->mutexTxPD);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Stop the sender threads of a session and wait until they left
+ *  The publishers are sent by tlp_processSend() again, at their current send times.
+ *  If a sender does not leave in time, the shares are kept and the senders still running are waited for again
+ *  by the next call. The publishers and the session must not be released then, the sender might still use them.
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error, no senders running
+ *  @retval         TRDP_MUTEX_ERR      mutexTxPD failed
+ *  @retval         TRDP_THREAD_ERR     a sender did not stop
+ */
+TRDP_ERR_T trdp_pdStopSenders (
+    TRDP_SESSION_PT appHandle)
+{
+    PD_SHARD_T  *pShards;
+    UINT32      noOfShards;
+    UINT32      idx;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+
+    /* The shares are created and released under mutexTxPD */
+    if (vos_mutexLock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    pShards     = appHandle->pPDShards;
+    noOfShards  = appHandle->noOfPDShards;
+    for (idx = 0u; (pShards != NULL) && (idx < noOfShards); idx++)
+    {
+        if (vos_atomicLoad32(&pShards[idx].stop) == 0u)
+        {
+            vos_atomicStore32(&pShards[idx].stop, 1u);
+        }
+    }
+    (void) vos_mutexUnlock(appHandle->mutexTxPD);
+
+    if (pShards == NULL)
+    {
+        return TRDP_NO_ERR;
+    }
+
+    /* Wait without mutexTxPD, the API calls are not blocked for the timeout */
+    for (idx = 0u; idx < noOfShards; idx++)
+    {
+        if (vos_atomicLoad32(&pShards[idx].stop) == 2u)
+        {
+            continue;   /* joined by an earlier call */
+        }
+        if (vos_semaTake(pShards[idx].stopped, TRDP_PD_SENDER_STOP_TIMEOUT) == VOS_NO_ERR)
+        {
+            vos_atomicStore32(&pShards[idx].stop, 2u);
+        }
+        else
+        {
+            err = TRDP_THREAD_ERR;
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        /* keep the resources, a sender might still touch them */
+        vos_printLogStr(VOS_LOG_ERROR, "PD sender did not stop\n");
+        return err;
+    }
+
+    for (idx = 0u; idx < noOfShards; idx++)
+    {
+        vos_printLog(VOS_LOG_INFO, "PD sender %u: %u telegrams, %u packets sent, %u cycle overruns\n",
+                     (unsigned int) idx,
+                     (unsigned int) pShards[idx].noOfPubs,
+                     (unsigned int) pShards[idx].numSend,
+                     (unsigned int) pShards[idx].numOverrun);
+    }
+
+    if (vos_mutexLock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    freeShards(appHandle, noOfShards);
+    (void) vos_mutexUnlock(appHandle->mutexTxPD);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Hand a new publisher to the sender with the least load, if senders are running (mutexTxPD held)
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            publisher
+ */
+void trdp_pdShardAddPub (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    if ((appHandle->pPDShards != NULL) && (pElement->pShard == NULL) && (isShardable(pElement) == TRUE))
+    {
+        /* A publisher which cannot be entered stays with tlp_processSend() */
+        (void) addToShard(appHandle, leastLoaded(appHandle), pElement);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Take a publisher from its sender (mutexTxPD held)
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            publisher
+ */
+void trdp_pdShardRemovePub (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    PD_SHARD_T  *pShard = pElement->pShard;
+    UINT32      idx;
+
+    (void) appHandle;
+
+    if (pShard == NULL)
+    {
+        return;
+    }
+
+    (void) vos_mutexLock(pShard->mutex);
+    for (idx = 0u; idx < pShard->noOfPubs; idx++)
+    {
+        if (pShard->ppPub[idx] == pElement)
+        {
+            pShard->ppPub[idx] = pShard->ppPub[--pShard->noOfPubs];
+            pShard->load -= rateOf(pElement);
+            break;
+        }
+    }
+    pElement->pShard = NULL;
+    (void) vos_mutexUnlock(pShard->mutex);
+}
+
+/**********************************************************************************************************************/
+/** Lock the share of a publisher before changing its frame or send state (mutexTxPD held)
+ *
+ *  @param[in]      pElement            publisher, nothing is done if it is not sent by a sender thread
+ */
+void trdp_pdShardLock (
+    const PD_ELE_T *pElement)
+{
+    if (pElement->pShard != NULL)
+    {
+        (void) vos_mutexLock(pElement->pShard->mutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Release the share of a publisher locked by trdp_pdShardLock() (mutexTxPD held)
+ *
+ *  @param[in]      pElement            publisher
+ */
+void trdp_pdShardUnlock (
+    const PD_ELE_T *pElement)
+{
+    if (pElement->pShard != NULL)
+    {
+        (void) vos_mutexUnlock(pElement->pShard->mutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Lock all shares, before the send times of several publishers are changed (mutexTxPD held)
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_pdShardLockAll (
+    const TRDP_SESSION_T *appHandle)
+{
+    UINT32 idx;
+
+    for (idx = 0u; idx < appHandle->noOfPDShards; idx++)
+    {
+        (void) vos_mutexLock(appHandle->pPDShards[idx].mutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Release all shares locked by trdp_pdShardLockAll() (mutexTxPD held)
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_pdShardUnlockAll (
+    const TRDP_SESSION_T *appHandle)
+{
+    UINT32 idx = appHandle->noOfPDShards;
+
+    while (idx > 0u)
+    {
+        (void) vos_mutexUnlock(appHandle->pPDShards[--idx].mutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Packets sent by the running sender threads, to be added to the session statistics
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         number of packets
+ */
+UINT32 trdp_pdShardNumSend (
+    const TRDP_SESSION_T *appHandle)
+{
+    UINT32  numSend = 0u;
+    UINT32  idx;
+
+    if (vos_mutexLock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        return 0u;
+    }
+    for (idx = 0u; idx < appHandle->noOfPDShards; idx++)
+    {
+        (void) vos_mutexLock(appHandle->pPDShards[idx].mutex);
+        numSend += appHandle->pPDShards[idx].numSend;
+        (void) vos_mutexUnlock(appHandle->pPDShards[idx].mutex);
+    }
+    (void) vos_mutexUnlock(appHandle->mutexTxPD);
+    return numSend;
+}
+
+/**********************************************************************************************************************/
+/** Reset the statistics of the running sender threads
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_pdShardResetStatistics (
+    TRDP_SESSION_PT appHandle)
+{
+    UINT32 idx;
+
+    if (vos_mutexLock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        return;
+    }
+    for (idx = 0u; idx < appHandle->noOfPDShards; idx++)
+    {
+        (void) vos_mutexLock(appHandle->pPDShards[idx].mutex);
+        appHandle->pPDShards[idx].numSend       = 0u;
+        appHandle->pPDShards[idx].numOverrun    = 0u;
+        (void) vos_mutexUnlock(appHandle->pPDShards[idx].mutex);
+    }
+    (void) vos_mutexUnlock(appHandle->mutexTxPD);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,79 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_pdshard.h
+ *
+ * @brief           Sender threads for cyclic process data
+ *
+ * @details         The cyclic publishers of a session can be partitioned into shares, each sent by its own thread
+ *                  on its own sockets. tlp_processSend() then sends the remaining telegrams only (PULL replies,
+ *                  requests, TSN and telegrams without interval).
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+#ifndef TRDP_PDSHARD_H
+#define TRDP_PDSHARD_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_private.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+TRDP_ERR_T  trdp_pdStartSenders (
+    TRDP_SESSION_PT appHandle,
+    UINT32          noOfSenders,
+    UINT8           priority);
+
+TRDP_ERR_T  trdp_pdStopSenders (
+    TRDP_SESSION_PT appHandle);
+
+void        trdp_pdShardAddPub (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement);
+
+void        trdp_pdShardRemovePub (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement);
+
+void        trdp_pdShardLock (
+    const PD_ELE_T *pElement);
+
+void        trdp_pdShardUnlock (
+    const PD_ELE_T *pElement);
+
+void        trdp_pdShardLockAll (
+    const TRDP_SESSION_T *appHandle);
+
+void        trdp_pdShardUnlockAll (
+    const TRDP_SESSION_T *appHandle);
+
+UINT32      trdp_pdShardNumSend (
+    const TRDP_SESSION_T *appHandle);
+
+void        trdp_pdShardResetStatistics (
+    TRDP_SESSION_PT appHandle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRDP_PDSHARD_H */
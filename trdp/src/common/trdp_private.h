@@ -17,6 +17,16 @@
 /*
  * $Id$
  *
+ *      AG 2026-10-18: MD_AGGREGATE_T hashes the repliers and tracks their confirmations
+ *      AG 2026-10-18: mdCompletionsOpen publishes the completion queue to the lock-free consumer
+ *      AG 2026-10-18: TRDP_REACTOR_T, TRDP_YIELD_T for the session reactor and its preemption points
+ *      AG 2026-10-18: PD_SHARD_T, sender threads sharing the cyclic publishers of a session
+ *      AG 2026-10-18: TRDP_SCHEDULED, PD schedule of a session and the send phase of a publisher
+ *      AG 2026-10-18: MD_WORKER_T, optional MD worker thread of a session
+ *      AG 2026-10-18: Reply aggregation state for fan-out MD requests
+ *      AG 2026-10-18: Completion queue for asynchronous MD requests
+ *      AG 2026-10-18: TCP reassembly state per socket, uncompletedTCP[] removed
+ *      AG 2026-10-18: Per-socket TCP transmit queue, application owned MD payloads and zero-copy bookkeeping
  *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
  *      BL 2020-07-10: Ticket #321 Move TRDP_TIMER_GRANULARITY to public API
  *      CK 2020-04-06: Ticket #318 Added pointer to list of seqCnt used per comId for PD Requests in TRDP_SESSION_T
@@ -96,6 +106,22 @@
 #endif
 
 #define TRDP_MD_MAN_CYCLE_TIME          5000u                       /**< cycle time [us} = delay for outgoing MD      */
+#define TRDP_MD_WORKER_STOP_TIMEOUT     1000000u                    /**< max. time [us] to wait for the MD worker     */
+#define TRDP_PD_SENDER_STOP_TIMEOUT     1000000u                    /**< max. time [us] to wait for a PD sender       */
+
+#ifndef TRDP_MAX_PD_SENDERS                                         /**< Allow overwrite of the max. sender threads   */
+#define TRDP_MAX_PD_SENDERS             16u                         /**< max. sender threads of a session             */
+#endif
+
+#ifndef TRDP_MD_ZEROCOPY_MIN_SIZE                                   /**< Allow overwrite of the zero-copy threshold   */
+#define TRDP_MD_ZEROCOPY_MIN_SIZE       16384u                      /**< min. payload [bytes] to try MSG_ZEROCOPY     */
+#endif
+#define TRDP_MD_ZEROCOPY_PENDING_CNT    4u                          /**< max. unacknowledged zero-copy sends/socket   */
+#define TRDP_MD_ZEROCOPY_DRAIN_TIME     100000u                     /**< max. time [us] a closing socket lingers      */
+
+#ifndef TRDP_MD_COMPLETION_QUEUE_SIZE                               /**< Allow overwrite of the completion ring size  */
+#define TRDP_MD_COMPLETION_QUEUE_SIZE   256u                        /**< entries of the async MD ring, power of 2     */
+#endif
 
 #define TRDP_DEBUG_DEFAULT_FILE_SIZE    65536u                      /**< Default maximum size of log file             */
 
@@ -147,7 +173,7 @@ typedef enum
 #define TRDP_TIMED_OUT      0x2u            /**< if set, inform the user                                */
 #define TRDP_INVALID_DATA   0x4u            /**< if set, inform the user                                */
 #define TRDP_REQ_2B_SENT    0x8u            /**< if set, the request needs to be sent                   */
-                                            /* TRDP_PULL_SUB removed, was unused */
+#define TRDP_SCHEDULED      0x10u           /**< if set, the publisher is entered into the PD schedule  */
 #define TRDP_REDUNDANT      0x20u           /**< if set, packet should not be sent (redundant)          */
 #define TRDP_CHECK_COMID    0x40u           /**< if set, do filter comId (addListener)                  */
 #define TRDP_IS_TSN         0x80u           /**< if set, PD will be sent on trdp_put() only             */
@@ -200,16 +226,40 @@ typedef struct TRDP_PR_SEQ_CNT_ELE
     UINT32                       lastSeqCnt;             /**< Sequence counter value for comId           */
 } TRDP_PR_SEQ_CNT_LIST_T;
 
+/** Application owned MD payload, sent without copying (tlm_replyNoCopy)  */
+typedef struct
+{
+    const UINT8         *pData;                         /**< payload owned by the application or NULL     */
+    UINT32              dataSize;                       /**< size of payload                              */
+    TRDP_MD_RELEASE_T   pfRelease;                      /**< hands the payload back to the application    */
+    void                *pRefCon;                       /**< context for pfRelease                        */
+    BOOL8               zeroCopy;                       /**< sent with MSG_ZEROCOPY, wait for completion  */
+    UINT32              zcId;                           /**< id of the first zero-copy send of payload    */
+    UINT32              zcSends;                        /**< no. of zero-copy sends of payload            */
+    UINT32              zcCnt;                          /**< zero-copy sends not yet completed            */
+} TRDP_MD_EXT_DATA_T;
+
+struct MD_ELE;
+struct MD_PACKET;
+
 /** TCP parameters    */
 typedef struct TRDP_SOCKET_TCP
 {
-    TRDP_IP_ADDR_T  cornerIp;                           /**< The other TCP corner Ip                      */
-    BOOL8           notSend;                            /**< If the message has been sent uncompleted     */
-    TRDP_TIME_T     connectionTimeout;                  /**< TCP socket connection Timeout                */
-    BOOL8           sendNotOk;                          /**< The sending timeout will be start            */
-    TRDP_TIME_T     sendingTimeout;                     /**< The timeout sending the message              */
-    BOOL8           addFileDesc;                        /**< Ready to add the socket in the fd            */
-    BOOL8           morituri;                           /**< about to die                                 */
+    TRDP_IP_ADDR_T      cornerIp;                       /**< The other TCP corner Ip                      */
+    TRDP_TIME_T         connectionTimeout;              /**< TCP socket connection Timeout                */
+    BOOL8               sendNotOk;                      /**< The sending timeout will be start            */
+    TRDP_TIME_T         sendingTimeout;                 /**< The timeout sending the message              */
+    BOOL8               addFileDesc;                    /**< Ready to add the socket in the fd            */
+    BOOL8               morituri;                       /**< about to die                                 */
+    struct MD_ELE       *pTxHead;                       /**< outbound queue, head may be partially sent   */
+    struct MD_ELE       *pTxTail;                       /**< last element of the outbound queue           */
+    INT8                zeroCopy;                       /**< 0: not tried, 1: enabled, -1: not supported  */
+    UINT32              zcNextId;                       /**< id of the next zero-copy send operation      */
+    TRDP_TIME_T         zcLingerEnd;                    /**< closing socket waits for completions until   */
+    UINT32              zcPendCnt;                      /**< no. of payloads waiting for completion       */
+    TRDP_MD_EXT_DATA_T  zcPending[TRDP_MD_ZEROCOPY_PENDING_CNT]; /**< payloads still referenced by the kernel */
+    struct MD_PACKET    *pRxPacket;                     /**< partially received message or NULL           */
+    UINT32              rxSize;                         /**< bytes of pRxPacket received so far           */
 } TRDP_SOCKET_TCP_T;
 
 
@@ -296,7 +346,7 @@ typedef struct
 
 #if MD_SUPPORT
 /** TRDP MD packet    */
-typedef struct
+typedef struct MD_PACKET
 {
     MD_HEADER_T frameHead;                      /**< Packet    header in network byte order                 */
     UINT8       data[TRDP_MAX_MD_DATA_SIZE];    /**< data ready to be sent or received                      */
@@ -311,6 +361,8 @@ typedef struct hp_slots TRDP_HP_SLOTS_T;        /**< forward declaration
 #pragma pack(pop)
 #endif
 
+struct PD_SHARD;
+
 /** Queue element for PD packets to send or receive    */
 typedef struct PD_ELE
 {
@@ -333,6 +385,8 @@ typedef struct PD_ELE
     TRDP_TIME_T         interval;               /**< time out value for received packets or
                                                      interval for packets to send (set from ms)             */
     TRDP_TIME_T         timeToGo;               /**< next time this packet must be sent/rcv                 */
+    UINT32              schedPhase;             /**< send phase (cycles) assigned by the PD scheduler       */
+    struct PD_SHARD     *pShard;                /**< != NULL: sent by this sender thread, not by tlc_process*/
     TRDP_TO_BEHAVIOR_T  toBehavior;             /**< timeout behavior for packets                           */
     UINT32              dataSize;               /**< net data size                                          */
     UINT32              grossSize;              /**< complete packet size (header, data)                    */
@@ -364,9 +418,24 @@ typedef struct MD_LIS_ELE
 typedef struct TRDP_MD_TCP
 {
     BOOL8   doConnect;                          /**< TCP connection state                                   */
-    BOOL8   msgUncomplete;                      /**< The receive message is uncomplete                      */
 } TRDP_MD_TCP_T;
 
+/** Replies collected for an aggregated request  */
+typedef struct MD_AGGREGATE
+{
+    TRDP_MD_AGGREGATE_CALLBACK_T    pfCbFunction;   /**< called once with the result set                    */
+    UINT32                          comId;          /**< ComID of the request                               */
+    TRDP_IP_ADDR_T                  srcIpAddr;      /**< own address the request was sent from              */
+    TRDP_TIME_T                     sendTime;       /**< last transmission of the request                   */
+    UINT32                          numReplies;     /**< used entries of pReplies                           */
+    UINT32                          capacity;       /**< allocated entries of pReplies                      */
+    UINT32                          numDuplicates;  /**< replies dropped, source had replied before         */
+    TRDP_MD_REPLY_T                 *pReplies;      /**< replies with copied data                           */
+    BOOL8                           *pConfirmed;    /**< Mq reply has been confirmed, parallel to pReplies  */
+    UINT32                          *pSlots;        /**< source hash, index + 1 into pReplies, 2 * capacity */
+    BOOL8                           delivered;      /**< result set has been passed to the application      */
+} MD_AGGREGATE_T;
+
 /** Session queue element for MD (UDP and TCP)  */
 typedef struct MD_ELE
 {
@@ -403,8 +472,45 @@ typedef struct MD_ELE
     MD_PACKET_T         *pPacket;               /**< Packet header in network byte order                    */
                                                 /**< data ready to be sent (with CRCs)                      */
     MD_LIS_ELE_T        *pListener;             /**< Pointer to the Session's associated Listener           */
+    struct MD_ELE       *pTxNext;               /**< next element in the socket's outbound queue            */
+    BOOL8               txQueued;               /**< element is linked into the socket's outbound queue     */
+    TRDP_MD_EXT_DATA_T  extData;                /**< application owned payload, sent behind pPacket header  */
+    TRDP_MD_HANDLE_T    asyncHandle;            /**< != 0: completions go to the session's completion queue */
+    MD_AGGREGATE_T      *pAggregate;            /**< != NULL: replies are collected into one result set     */
 } MD_ELE_T;
 
+/** Completion not fitting into the ring, kept until the consumer made room  */
+typedef struct MD_COMPLETION_ELE
+{
+    struct MD_COMPLETION_ELE    *pNext;         /**< pointer to next element or NULL                        */
+    TRDP_MD_COMPLETION_T        completion;     /**< the completion                                         */
+} MD_COMPLETION_ELE_T;
+
+/** Completion queue for asynchronous MD requests.
+ *  Single producer (the MD processing, serialised by mutexMD) and single consumer (the application),
+ *  the ring itself is lock-free.
+ */
+typedef struct MD_COMPLETION_QUEUE
+{
+    volatile UINT32         head;               /**< next entry to fetch, written by the consumer only      */
+    volatile UINT32         tail;               /**< next entry to fill, written by the producer only       */
+    TRDP_MD_COMPLETION_T    entry[TRDP_MD_COMPLETION_QUEUE_SIZE];   /**< the ring                           */
+    MD_COMPLETION_ELE_T     *pOverflowHead;     /**< completions waiting for room, protected by mutexMD     */
+    MD_COMPLETION_ELE_T     *pOverflowTail;     /**< last waiting completion                                */
+    VOS_SOCK_EVENT_T        event;              /**< signalled when a completion is queued                  */
+    BOOL8                   hasEvent;           /**< the target supports events                             */
+} MD_COMPLETION_QUEUE_T;
+
+/** Dedicated MD worker of a session, processing MD instead of tlm_process()/tlc_process()  */
+typedef struct MD_WORKER
+{
+    VOS_THREAD_T            thread;             /**< the worker thread                                      */
+    VOS_SEMA_T              stopped;            /**< given by the worker when it leaves                     */
+    VOS_SOCK_EVENT_T        event;              /**< signalled when the application queued MD               */
+    BOOL8                   hasEvent;           /**< the target supports events, else the worker polls      */
+    volatile UINT32         stop;               /**< != 0: the worker shall leave                           */
+} MD_WORKER_T;
+
 /**    TCP file descriptor parameters   */
 typedef struct
 {
@@ -414,7 +520,46 @@ typedef struct
 } TRDP_TCP_FD_T;
 #endif
 
+/** Sender thread of a session, sending its share of the cyclic publishers instead of tlp_processSend()  */
+typedef struct PD_SHARD
+{
+    struct TRDP_SESSION     *appHandle;         /**< the session the publishers belong to                   */
+    VOS_THREAD_T            thread;             /**< the sender thread                                      */
+    VOS_MUTEX_T             mutex;              /**< protects the share and the frames of its publishers    */
+    VOS_SEMA_T              stopped;            /**< given by the sender when it leaves                     */
+    volatile UINT32         stop;               /**< != 0: the sender shall leave, 2: it has left           */
+    UINT32                  cycle;              /**< send cycle [us]                                        */
+    PD_ELE_T                * *ppPub;           /**< the publishers of this share                           */
+    UINT32                  noOfPubs;           /**< number of entries in ppPub                             */
+    UINT32                  maxNoOfPubs;        /**< allocated entries of ppPub                             */
+    UINT64                  load;               /**< bytes per second sent by this share                    */
+    VOS_SOCK_T              sock[TRDP_MAX_PD_SOCKET_CNT];   /**< own sockets, opened like ifacePD[] on demand */
+    UINT32                  numSend;            /**< packets sent by this sender                            */
+    UINT32                  numOverrun;         /**< send cycles which took longer than the cycle time      */
+} PD_SHARD_T;
+
+/** Preemption point of the session reactor: lower priority work stops when the time has come */
+typedef struct
+{
+    TRDP_TIME_T             at;                 /**< stop processing at this time, cleared: never           */
+    BOOL8                   hit;                /**< processing stopped early                               */
+} TRDP_YIELD_T;
+
+/** Session reactor, processing PD sending, PD reception and MD by priority within tlc_run()  */
+typedef struct TRDP_REACTOR
+{
+    TRDP_RUN_CONFIG_T       config;             /**< time budgets of the current run                        */
+    TRDP_RUN_STATISTICS_T   stats;              /**< statistics since the run started                       */
+    VOS_SEMA_T              stopped;            /**< given by tlc_run() when it leaves                      */
+    VOS_SOCK_EVENT_T        event;              /**< signalled to wake the reactor up                       */
+    BOOL8                   hasEvent;           /**< the target supports events, else the reactor polls     */
+    volatile UINT32         running;            /**< != 0: tlc_run() is active, protected by mutex          */
+    volatile UINT32         stop;               /**< != 0: tlc_run() shall return                           */
+    TRDP_TIME_T             nextCycle;          /**< next send cycle of the index tables (HIGH_PERF_INDEXED)*/
+} TRDP_REACTOR_T;
+
 struct TAU_TTDB;
+struct TRDP_PD_SCHED;
 
 /** Session/application variables store */
 typedef struct TRDP_SESSION
@@ -440,6 +585,11 @@ typedef struct TRDP_SESSION
     TRDP_PR_SEQ_CNT_LIST_T  *pSeqCntList4PDReq; /**< pointer to list of sequence counters for PR per comId  */
     TRDP_TIME_T             initTime;           /**< initialization time of session                         */
     TRDP_STATISTICS_T       stats;              /**< statistics of this session                             */
+    struct TRDP_PD_SCHED    *pSched;            /**< PD schedule, if TRDP_OPTION_PD_SCHEDULE is set         */
+    PD_SHARD_T              *pPDShards;         /**< != NULL: cyclic PD is sent by these sender threads     */
+    UINT32                  noOfPDShards;       /**< number of sender threads in pPDShards                  */
+    TRDP_REACTOR_T          *pReactor;          /**< reactor of tlc_run(), created by its first call        */
+    TRDP_YIELD_T            yieldPdRx;          /**< preemption point of the PD reception (mutexRxPD)       */
 #ifdef HIGH_PERF_INDEXED
     TRDP_HP_SLOTS_T         *pSlot;             /**< pointer to a struct holding a list of slots for
                                                                         high speed access to PD telegrams   */
@@ -455,7 +605,11 @@ typedef struct TRDP_SESSION
     MD_ELE_T                *pMDSndQueue;       /**< pointer to first element of send MD queue (caller)     */
     MD_ELE_T                *pMDRcvQueue;       /**< pointer to first element of recv MD queue (replier)    */
     MD_ELE_T                *pMDRcvEle;         /**< pointer to received MD element                         */
-    MD_ELE_T                *uncompletedTCP[VOS_MAX_SOCKET_CNT];     /**< uncompleted TCP messages buffer   */
+    MD_COMPLETION_QUEUE_T   *pMDCompletions;    /**< completions of asynchronous requests, created on demand*/
+    volatile UINT32         mdCompletionsOpen;  /**< != 0 once pMDCompletions may be read without mutexMD   */
+    TRDP_MD_HANDLE_T        lastMDHandle;       /**< last handle given out by tlm_requestAsync()            */
+    MD_WORKER_T             *pMDWorker;         /**< != NULL: MD is processed by this worker thread         */
+    TRDP_YIELD_T            yieldMD;            /**< preemption point of the MD processing (mutexMD)        */
 #endif
 } TRDP_SESSION_T, *TRDP_SESSION_PT;
 
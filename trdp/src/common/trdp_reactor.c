@@ -0,0 +1,745 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_reactor.c
+ *
+ * @brief           Session reactor, processing PD and MD of a session by priority
+ *
+ * @details         tlc_run() replaces the application loop of tlc_getInterval(), vos_select() and tlc_process().
+ *                  Each cycle it computes the next due time of every work class, waits for packets until the
+ *                  earliest of them and then processes the classes in the order of their priority:
+ *
+ *                  1. PD sending: the due telegrams are sent, this is never interrupted.
+ *                  2. PD reception: received telegrams and time-outs of the subscribers.
+ *                  3. MD: queued messages are sent, received messages and time-outs are handled.
+ *
+ *                  PD reception and MD stop at their preemption points (trdp_yield(), between two packets) when
+ *                  their budget is spent or the next PD telegram is due. PD sending runs then, the rest is processed
+ *                  in the next cycle: sockets not read stay readable, messages not sent stay queued.
+ *
+ *                  Locking: each class is processed under its own mutex (mutexTxPD, mutexRxPD, mutexMD), the
+ *                  reactor never holds two of them. The session mutex protects the start and the end of a run.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <string.h>
+
+#include "trdp_reactor.h"
+#include "trdp_pdcom.h"
+#include "trdp_utils.h"
+#include "vos_mem.h"
+#include "vos_sock.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+#if MD_SUPPORT
+#include "trdp_mdcom.h"
+#endif
+
+#ifdef HIGH_PERF_INDEXED
+#include "trdp_pdindex.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Take the earlier of two due times
+ *
+ *  @param[in,out]  pDue                due time, cleared: none
+ *  @param[in]      pOther              other due time, cleared: none
+ */
+static void runMerge (
+    TRDP_TIME_T         *pDue,
+    const TRDP_TIME_T   *pOther)
+{
+    if (timerisset(pOther) && (!timerisset(pDue) || timercmp(pOther, pDue, <)))
+    {
+        *pDue = *pOther;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Check if a due time has come
+ *
+ *  @param[in]      pDue                due time, cleared: none
+ *  @param[in]      pNow                current time
+ *
+ *  @retval         TRUE                due time is set and has come
+ */
+static BOOL8 runIsDue (
+    const TRDP_TIME_T   *pDue,
+    const TRDP_TIME_T   *pNow)
+{
+    return (timerisset(pDue) && !timercmp(pNow, pDue, <)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Time from one point in time to another in us
+ *
+ *  @param[in]      pFrom               earlier time
+ *  @param[in]      pTo                 later time
+ *
+ *  @retval         difference (us), 0 if pTo is not later
+ */
+static UINT32 runElapsed (
+    const TRDP_TIME_T   *pFrom,
+    const TRDP_TIME_T   *pTo)
+{
+    TRDP_TIME_T diff = *pTo;
+
+    if (!timercmp(pFrom, pTo, <))
+    {
+        return 0u;
+    }
+    vos_subTime(&diff, pFrom);
+    return (UINT32) diff.tv_sec * 1000000u + (UINT32) diff.tv_usec;
+}
+
+/**********************************************************************************************************************/
+/** Set a preemption point: stop at the end of the budget or when PD sending is due, whichever comes first
+ *
+ *  @param[out]     pYield              preemption point
+ *  @param[in]      pStart              start of the processing
+ *  @param[in]      budget              time budget (us), 0 = unlimited
+ *  @param[in]      pSendDue            next PD send time, cleared: none
+ */
+static void runSetYield (
+    TRDP_YIELD_T        *pYield,
+    const TRDP_TIME_T   *pStart,
+    UINT32              budget,
+    const TRDP_TIME_T   *pSendDue)
+{
+    vos_clearTime(&pYield->at);
+    pYield->hit = FALSE;
+    if (budget != 0u)
+    {
+        TRDP_TIME_T budgetTime;
+
+        budgetTime.tv_sec   = (long) (budget / 1000000u);
+        budgetTime.tv_usec  = (long) (budget % 1000000u);
+        pYield->at = *pStart;
+        vos_addTime(&pYield->at, &budgetTime);
+    }
+    runMerge(&pYield->at, pSendDue);
+}
+
+/**********************************************************************************************************************/
+/** Account one run of a work class
+ *
+ *  @param[in]      pReactor            the reactor
+ *  @param[in]      cls                 work class
+ *  @param[in]      pStart              start of the run
+ *  @param[in]      preempted           the run stopped at a preemption point
+ */
+static void runAccount (
+    TRDP_REACTOR_T      *pReactor,
+    TRDP_RUN_CLASS_T    cls,
+    const TRDP_TIME_T   *pStart,
+    BOOL8               preempted)
+{
+    TRDP_RUN_CLASS_STATISTICS_T *pStats = &pReactor->stats.cls[cls];
+    TRDP_TIME_T now;
+    UINT32      elapsed;
+
+    vos_getTime(&now);
+    elapsed = runElapsed(pStart, &now);
+
+    pStats->runs++;
+    if (elapsed > pStats->maxTime)
+    {
+        pStats->maxTime = elapsed;
+    }
+    if ((pReactor->config.budget[cls] != 0u) && (elapsed > pReactor->config.budget[cls]))
+    {
+        pStats->overBudget++;
+    }
+    if (preempted == TRUE)
+    {
+        pStats->preempted++;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Check if PD is sent from the index tables (HIGH_PERF_INDEXED) in a fixed cycle
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRUE                trdp_pdSendIndexed() is to be called every process cycle
+ */
+static BOOL8 runIndexed (
+    const TRDP_SESSION_T *appHandle)
+{
+#ifdef HIGH_PERF_INDEXED
+    return ((appHandle->pSlot != NULL) && (appHandle->pSlot->processCycle != 0u)
+            && !(appHandle->option & TRDP_OPTION_PD_SCHEDULE)) ? TRUE : FALSE;
+#else
+    (void) appHandle;
+    return FALSE;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Get the time the next PD telegram has to be sent
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pNow                current time
+ *  @param[out]     pSendDue            next send time, cleared if nothing is to be sent
+ */
+static void runSendDue (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pNow,
+    TRDP_TIME_T         *pSendDue)
+{
+    vos_clearTime(pSendDue);
+    if (vos_mutexLock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        return;
+    }
+    if (runIndexed(appHandle) == TRUE)
+    {
+        *pSendDue = appHandle->pReactor->nextCycle;
+    }
+    else
+    {
+        trdp_pdNextSend(appHandle, pNow, pSendDue);
+    }
+    (void) vos_mutexUnlock(appHandle->mutexTxPD);
+}
+
+/**********************************************************************************************************************/
+/** Work class PD sending: send the due telegrams, not interrupted
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSendDue            time the telegrams were due
+ */
+static void runPdSend (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pSendDue)
+{
+    TRDP_REACTOR_T  *pReactor = appHandle->pReactor;
+    TRDP_TIME_T     start;
+    TRDP_ERR_T      err;
+    UINT32          latency;
+
+    vos_getTime(&start);
+    latency = runElapsed(pSendDue, &start);
+    if (latency > pReactor->stats.maxSendLatency)
+    {
+        pReactor->stats.maxSendLatency = latency;
+    }
+
+    if (vos_mutexLock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        return;
+    }
+#ifdef HIGH_PERF_INDEXED
+    if (runIndexed(appHandle) == TRUE)
+    {
+        TRDP_TIME_T cycle;
+
+        err = trdp_pdSendIndexed(appHandle);
+
+        /* Next cycle on the grid of the process cycle, cycles missed are not caught up */
+        cycle.tv_sec    = (long) (appHandle->pSlot->processCycle / 1000000u);
+        cycle.tv_usec   = (long) (appHandle->pSlot->processCycle % 1000000u);
+        do
+        {
+            vos_addTime(&pReactor->nextCycle, &cycle);
+        }
+        while (!timercmp(&start, &pReactor->nextCycle, <));
+    }
+    else
+#endif
+    {
+        err = trdp_pdSendQueued(appHandle);
+    }
+    (void) vos_mutexUnlock(appHandle->mutexTxPD);
+
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_INFO, "PD sending failed (Err: %d)\n", err);
+    }
+    runAccount(pReactor, TRDP_RUN_PD_SEND, &start, FALSE);
+}
+
+/**********************************************************************************************************************/
+/** Work class PD reception: read the ready PD sockets and supervise the subscriptions
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in,out]  pRfds               ready descriptors, NULL if none
+ *  @param[in,out]  pCount              number of ready descriptors
+ *  @param[in]      pSendDue            next PD send time, reception yields then
+ */
+static void runPdReceive (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_FDS_T          *pRfds,
+    INT32               *pCount,
+    const TRDP_TIME_T   *pSendDue)
+{
+    TRDP_REACTOR_T  *pReactor = appHandle->pReactor;
+    TRDP_TIME_T     start;
+    TRDP_ERR_T      err;
+    BOOL8           preempted;
+
+    vos_getTime(&start);
+    if (vos_mutexLock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        return;
+    }
+    runSetYield(&appHandle->yieldPdRx, &start, pReactor->config.budget[TRDP_RUN_PD_RECEIVE], pSendDue);
+
+    err = trdp_pdCheckListenSocks(appHandle, pRfds, pCount);
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_INFO, "PD reception failed (Err: %d)\n", err);
+    }
+
+#ifdef HIGH_PERF_INDEXED
+    if ((appHandle->pSlot != NULL) && (appHandle->pSlot->pRcvTableTimeOut != NULL))
+    {
+        trdp_pdHandleTimeOutsIndexed(appHandle);
+    }
+    else
+#endif
+    {
+        trdp_pdHandleTimeOuts(appHandle);
+    }
+
+    preempted = appHandle->yieldPdRx.hit;
+    vos_clearTime(&appHandle->yieldPdRx.at);
+    appHandle->yieldPdRx.hit = FALSE;
+    (void) vos_mutexUnlock(appHandle->mutexRxPD);
+
+    runAccount(pReactor, TRDP_RUN_PD_RECEIVE, &start, preempted);
+}
+
+#if MD_SUPPORT
+/**********************************************************************************************************************/
+/** Work class MD: send queued messages, read the ready MD sockets and supervise the sessions.
+ *  Left out while an MD worker thread is running.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in,out]  pRfds               ready descriptors, NULL if none
+ *  @param[in,out]  pCount              number of ready descriptors
+ *  @param[in]      pSendDue            next PD send time, MD yields then
+ *
+ *  @retval         TRUE                MD stopped at a preemption point, work is left
+ */
+static BOOL8 runMd (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_FDS_T          *pRfds,
+    INT32               *pCount,
+    const TRDP_TIME_T   *pSendDue)
+{
+    TRDP_REACTOR_T  *pReactor = appHandle->pReactor;
+    TRDP_TIME_T     start;
+    TRDP_ERR_T      err;
+    BOOL8           preempted;
+
+    vos_getTime(&start);
+    if (vos_mutexLock(appHandle->mutexMD) != VOS_NO_ERR)
+    {
+        return FALSE;
+    }
+    if (appHandle->pMDWorker != NULL)
+    {
+        (void) vos_mutexUnlock(appHandle->mutexMD);
+        return FALSE;
+    }
+    runSetYield(&appHandle->yieldMD, &start, pReactor->config.budget[TRDP_RUN_MD], pSendDue);
+
+    err = trdp_mdSend(appHandle);
+    if ((err != TRDP_NO_ERR) && (err != TRDP_IO_ERR))
+    {
+        vos_printLog(VOS_LOG_ERROR, "trdp_mdSend() failed (Err: %d)\n", err);
+    }
+    if ((pRfds != NULL) && (appHandle->yieldMD.hit == FALSE))
+    {
+        trdp_mdCheckListenSocks(appHandle, pRfds, pCount);
+    }
+    /* Time-outs are never deferred */
+    trdp_mdCheckTimeouts(appHandle);
+
+    preempted = appHandle->yieldMD.hit;
+    vos_clearTime(&appHandle->yieldMD.at);
+    appHandle->yieldMD.hit = FALSE;
+    (void) vos_mutexUnlock(appHandle->mutexMD);
+
+    runAccount(pReactor, TRDP_RUN_MD, &start, preempted);
+    return preempted;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Add a descriptor to the set to wait for
+ *
+ *  @param[in]      sock                descriptor
+ *  @param[in,out]  pRfds               descriptor set
+ *  @param[in,out]  pNoDesc             highest descriptor
+ */
+static void runAddDesc (
+    VOS_SOCK_T  sock,
+    TRDP_FDS_T  *pRfds,
+    TRDP_SOCK_T *pNoDesc)
+{
+    VOS_FD_SET(sock, (VOS_FDS_T *)pRfds);   /*lint !e573 !e505 signed/unsigned division in macro /
+                                                Redundant left argument to comma */
+    if ((vos_sockCmp(sock, *pNoDesc) == 1) || (*pNoDesc == VOS_INVALID_SOCKET))
+    {
+        *pNoDesc = sock;
+    }
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Process a session until trdp_runStop() is called
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pConfig             time budgets, NULL: unlimited
+ *
+ *  @retval         TRDP_NO_ERR         stopped
+ *  @retval         TRDP_STATE_ERR      the session is already run
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_MUTEX_ERR      session mutex failed
+ */
+TRDP_ERR_T trdp_run (
+    TRDP_SESSION_PT         appHandle,
+    const TRDP_RUN_CONFIG_T *pConfig)
+{
+    TRDP_REACTOR_T  *pReactor;
+    TRDP_FDS_T      rfds;
+    TRDP_SOCK_T     noDesc;
+    TRDP_TIME_T     now;
+    TRDP_TIME_T     due;
+    TRDP_TIME_T     sendDue;
+    TRDP_TIME_T     rxDue;
+    TRDP_TIME_T     mdDue;
+    TRDP_TIME_T     maxWait;
+    INT32           rv;
+    BOOL8           woken;
+    BOOL8           mdLeft = FALSE;
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    pReactor = appHandle->pReactor;
+    if (pReactor == NULL)
+    {
+        pReactor = (TRDP_REACTOR_T *) vos_memAlloc(sizeof(TRDP_REACTOR_T));
+        if (pReactor == NULL)
+        {
+            (void) vos_mutexUnlock(appHandle->mutex);
+            return TRDP_MEM_ERR;
+        }
+        if (vos_semaCreate(&pReactor->stopped, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+        {
+            vos_memFree(pReactor);
+            (void) vos_mutexUnlock(appHandle->mutex);
+            return TRDP_MEM_ERR;
+        }
+        /* Without events, queued MD waits for the next poll of the reactor */
+        pReactor->hasEvent = (vos_sockOpenEvent(&pReactor->event) == VOS_NO_ERR) ? TRUE : FALSE;
+        appHandle->pReactor = pReactor;
+    }
+    else if (vos_atomicLoad32(&pReactor->running) != 0u)
+    {
+        (void) vos_mutexUnlock(appHandle->mutex);
+        return TRDP_STATE_ERR;
+    }
+    else
+    {
+        /* a previous run returned by itself, nobody took its signal */
+        (void) vos_semaTake(pReactor->stopped, 0u);
+    }
+
+    if (pConfig != NULL)
+    {
+        pReactor->config = *pConfig;
+    }
+    else
+    {
+        memset(&pReactor->config, 0, sizeof(pReactor->config));
+    }
+    if (pReactor->config.maxWait == 0u)
+    {
+        pReactor->config.maxWait = TRDP_RUN_MAX_WAIT;
+    }
+    maxWait.tv_sec  = (long) (pReactor->config.maxWait / 1000000u);
+    maxWait.tv_usec = (long) (pReactor->config.maxWait % 1000000u);
+    memset(&pReactor->stats, 0, sizeof(pReactor->stats));
+    vos_getTime(&pReactor->nextCycle);
+    vos_atomicStore32(&pReactor->stop, 0u);
+    vos_atomicStore32(&pReactor->running, 1u);
+    (void) vos_mutexUnlock(appHandle->mutex);
+
+    while (vos_atomicLoad32(&pReactor->stop) == 0u)
+    {
+        VOS_FD_ZERO((VOS_FDS_T *)&rfds);
+        noDesc = VOS_INVALID_SOCKET;
+        vos_getTime(&now);
+        due = now;
+        vos_addTime(&due, &maxWait);
+
+        /*  Due times and descriptors of all classes    */
+        vos_clearTime(&rxDue);
+        if (vos_mutexLock(appHandle->mutexRxPD) == VOS_NO_ERR)
+        {
+#ifdef HIGH_PERF_INDEXED
+            if (appHandle->pSlot != NULL)
+            {
+                TRDP_TIME_T interval;
+
+                trdp_indexCheckPending(appHandle, &interval, &rfds, &noDesc);
+                rxDue = appHandle->nextJob;
+                if (appHandle->pSlot->pRcvTableTimeOut == NULL)
+                {
+                    trdp_pdNextTimeout(appHandle, &rxDue);
+                }
+            }
+            else
+#endif
+            {
+                trdp_pdCheckPending(appHandle, &rfds, &noDesc, FALSE);
+                rxDue = appHandle->nextJob;
+            }
+            (void) vos_mutexUnlock(appHandle->mutexRxPD);
+        }
+        runMerge(&due, &rxDue);
+
+        runSendDue(appHandle, &now, &sendDue);
+        runMerge(&due, &sendDue);
+
+        vos_clearTime(&mdDue);
+#if MD_SUPPORT
+        if (vos_mutexLock(appHandle->mutexMD) == VOS_NO_ERR)
+        {
+            if (appHandle->pMDWorker == NULL)
+            {
+                trdp_mdCheckPending(appHandle, &rfds, &noDesc);
+                trdp_mdNextJob(appHandle, &now, &mdDue);
+                if (mdLeft == TRUE)
+                {
+                    mdDue = now;        /* continue after the PD work */
+                }
+                else if (pReactor->hasEvent == FALSE)
+                {
+                    TRDP_TIME_T poll = {0, TRDP_MD_MAN_CYCLE_TIME};
+
+                    vos_addTime(&poll, &now);
+                    runMerge(&mdDue, &poll);
+                }
+            }
+            (void) vos_mutexUnlock(appHandle->mutexMD);
+        }
+        runMerge(&due, &mdDue);
+#endif
+
+        if (pReactor->hasEvent == TRUE)
+        {
+            runAddDesc(pReactor->event.rdSock, &rfds, &noDesc);
+        }
+
+        /*  Wait until the earliest due time or a packet arrives    */
+        if (timercmp(&now, &due, <))
+        {
+            vos_subTime(&due, &now);
+        }
+        else
+        {
+            vos_clearTime(&due);
+        }
+        rv = vos_select(noDesc, (VOS_FDS_T *)&rfds, NULL, NULL, &due);
+
+        if (vos_atomicLoad32(&pReactor->stop) != 0u)
+        {
+            break;
+        }
+        pReactor->stats.cycles++;
+
+        woken = FALSE;
+        if ((rv > 0) && (pReactor->hasEvent == TRUE)
+            && VOS_FD_ISSET(pReactor->event.rdSock, (VOS_FDS_T *)&rfds)) /*lint !e573 !e505
+                                                                    signed/unsigned division in macro /
+                                                                    Redundant left argument to comma */
+        {
+            (void) vos_sockClearEvent(&pReactor->event);
+            woken = TRUE;
+            rv--;
+        }
+
+        /*  1. PD sending   */
+        vos_getTime(&now);
+        if (runIsDue(&sendDue, &now) == TRUE)
+        {
+            runPdSend(appHandle, &sendDue);
+            vos_getTime(&now);
+            runSendDue(appHandle, &now, &sendDue);
+        }
+
+        /*  2. PD reception, yields to PD sending  */
+        if ((rv > 0) || (runIsDue(&rxDue, &now) == TRUE))
+        {
+            runPdReceive(appHandle, (rv > 0) ? &rfds : NULL, &rv, &sendDue);
+            vos_getTime(&now);
+            if (runIsDue(&sendDue, &now) == TRUE)
+            {
+                runPdSend(appHandle, &sendDue);
+                runSendDue(appHandle, &now, &sendDue);
+            }
+        }
+
+        /*  3. MD, yields to PD sending */
+#if MD_SUPPORT
+        if ((rv > 0) || (woken == TRUE) || (runIsDue(&mdDue, &now) == TRUE))
+        {
+            mdLeft = runMd(appHandle, (rv > 0) ? &rfds : NULL, &rv, &sendDue);
+        }
+#else
+        (void) woken;
+        (void) mdLeft;
+#endif
+    }
+
+    /* trdp_runDeInit() may free the reactor as soon as running is reset */
+    if (vos_mutexLock(appHandle->mutex) == VOS_NO_ERR)
+    {
+        vos_atomicStore32(&pReactor->running, 0u);
+        vos_semaGive(pReactor->stopped);
+        (void) vos_mutexUnlock(appHandle->mutex);
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Ask trdp_run() to return, does not wait
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_runStop (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_REACTOR_T *pReactor = appHandle->pReactor;
+
+    if ((pReactor != NULL) && (vos_atomicLoad32(&pReactor->running) != 0u))
+    {
+        vos_atomicStore32(&pReactor->stop, 1u);
+        if (pReactor->hasEvent == TRUE)
+        {
+            (void) vos_sockSignalEvent(&pReactor->event);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Stop trdp_run(), wait until it returned and free the reactor.
+ *  Must not be called from within a callback, those run in the context of trdp_run().
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_runDeInit (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_REACTOR_T  *pReactor = appHandle->pReactor;
+    BOOL8           running;
+
+    if (pReactor == NULL)
+    {
+        return;
+    }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return;
+    }
+    running = (vos_atomicLoad32(&pReactor->running) != 0u) ? TRUE : FALSE;
+    trdp_runStop(appHandle);
+    (void) vos_mutexUnlock(appHandle->mutex);
+
+    if ((running == TRUE) && (vos_semaTake(pReactor->stopped, TRDP_RUN_STOP_TIMEOUT) != VOS_NO_ERR))
+    {
+        /* keep the resources, tlc_run() might still touch them */
+        vos_printLogStr(VOS_LOG_ERROR, "tlc_run() did not return\n");
+        return;
+    }
+
+    appHandle->pReactor = NULL;
+    if (pReactor->hasEvent == TRUE)
+    {
+        vos_sockCloseEvent(&pReactor->event);
+    }
+    vos_semaDelete(pReactor->stopped);
+    vos_memFree(pReactor);
+}
+
+/**********************************************************************************************************************/
+/** Wake up trdp_run(), if running, because MD was queued or a socket changed
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_runWake (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_REACTOR_T *pReactor = appHandle->pReactor;
+
+    if ((pReactor != NULL) && (pReactor->hasEvent == TRUE) && (vos_atomicLoad32(&pReactor->running) != 0u))
+    {
+        (void) vos_sockSignalEvent(&pReactor->event);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Get the statistics of the current or last run
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[out]     pStatistics         statistics, cleared if the session was never run
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MUTEX_ERR      session mutex failed
+ */
+TRDP_ERR_T trdp_runGetStatistics (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_RUN_STATISTICS_T   *pStatistics)
+{
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    if (appHandle->pReactor != NULL)
+    {
+        /* updated by the reactor without lock, the values of a running reactor may be one cycle apart */
+        *pStatistics = appHandle->pReactor->stats;
+    }
+    else
+    {
+        memset(pStatistics, 0, sizeof(TRDP_RUN_STATISTICS_T));
+    }
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return TRDP_NO_ERR;
+}
+
+#ifdef __cplusplus
+}
+#endif
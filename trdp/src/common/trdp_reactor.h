@@ -0,0 +1,74 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_reactor.h
+ *
+ * @brief           Session reactor, processing PD and MD of a session by priority
+ *
+ * @details         tlc_run() waits for packets and due telegrams of a session and processes them in the order PD
+ *                  sending, PD reception and MD. PD reception and MD yield at their preemption points as soon as
+ *                  their time budget is spent or a PD telegram has to be sent.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+#ifndef TRDP_REACTOR_H
+#define TRDP_REACTOR_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_private.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#ifndef TRDP_RUN_MAX_WAIT
+#define TRDP_RUN_MAX_WAIT       1000000u    /**< default max. time [us] the reactor waits for an event              */
+#endif
+
+#ifndef TRDP_RUN_STOP_TIMEOUT
+#define TRDP_RUN_STOP_TIMEOUT   1000000u    /**< max. time [us] to wait for tlc_run() to return on close            */
+#endif
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+TRDP_ERR_T  trdp_run (
+    TRDP_SESSION_PT         appHandle,
+    const TRDP_RUN_CONFIG_T *pConfig);
+
+void        trdp_runStop (
+    TRDP_SESSION_PT appHandle);
+
+void        trdp_runDeInit (
+    TRDP_SESSION_PT appHandle);
+
+void        trdp_runWake (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T  trdp_runGetStatistics (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_RUN_STATISTICS_T   *pStatistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRDP_REACTOR_H */
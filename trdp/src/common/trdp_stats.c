@@ -17,6 +17,7 @@
  /*
  * $Id$
  *
+ *      AG 2026-10-18: Packets sent by PD sender threads are added to pd.numSend
  *      SB 2021-08.09: Ticket #375 Replaced parameters of vos_memCount to prevent alignment issues
  *      BL 2019-02-01: Ticket #234 Correcting Statistics ComIds & defines
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
@@ -37,6 +38,7 @@
 #include <string.h>
 
 #include "trdp_stats.h"
+#include "trdp_pdshard.h"
 #include "trdp_if_light.h"
 #include "tlc_if.h"
 #include "trdp_private.h"
@@ -117,6 +119,7 @@ EXT_DECL TRDP_ERR_T tlc_resetStatistics (
     tempTime = appHandle->stats.upTime;
     memset(&appHandle->stats, 0, sizeof(TRDP_STATISTICS_T));
     appHandle->stats.upTime = tempTime;
+    trdp_pdShardResetStatistics(appHandle);
 
     return TRDP_NO_ERR;
 }
@@ -147,6 +150,7 @@ EXT_DECL TRDP_ERR_T tlc_getStatistics (
     trdp_UpdateStats(appHandle);
 
     *pStatistics = appHandle->stats;
+    pStatistics->pd.numSend += trdp_pdShardNumSend(appHandle);
 
     return TRDP_NO_ERR;
 }
@@ -599,7 +603,7 @@ void    trdp_pdPrepareStats (
     pData->pd.numNoSubs     = vos_htonl(appHandle->stats.pd.numNoSubs);
     pData->pd.numNoPub      = vos_htonl(appHandle->stats.pd.numNoPub);
     pData->pd.numTimeout    = vos_htonl(appHandle->stats.pd.numTimeout);
-    pData->pd.numSend       = vos_htonl(appHandle->stats.pd.numSend);
+    pData->pd.numSend       = vos_htonl(appHandle->stats.pd.numSend + trdp_pdShardNumSend(appHandle));
     pData->pd.numMissed     = vos_htonl(appHandle->stats.pd.numMissed);
 
     /* Message data */
@@ -17,6 +17,10 @@
 /*
 * $Id$
 *
+*      AG 2026-10-18: Closing TCP sockets wait for their zero-copy completions
+*      AG 2026-10-18: trdp_yield(), preemption points of the session reactor
+*      AG 2026-10-18: Outstanding TCP MD requests to the same peer share one connection
+*      AG 2026-10-18: trdp_initUncompletedTCP() removed, TCP reassembly state is kept per socket; TCP senders bound to the session IP
 *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
 *      BL 2020-08-07: Ticket #317 Bug in trdp_indexedFindSubAddr() (HIGH_PERFORMANCE)
 *      AÖ 2020-05-04: Ticket #331: Add VLAN support for Sim
@@ -69,6 +73,10 @@
 #include "trdp_serviceRegistry.h"
 #endif
 
+#if MD_SUPPORT
+#include "trdp_mdcom.h"
+#endif
+
 /***********************************************************************************************************************
  * DEFINES
  */
@@ -875,21 +883,6 @@ void    trdp_MDqueueInsFirst (
     pNew->pNext = *ppHead;
     *ppHead     = pNew;
 }
-
-/**********************************************************************************************************************/
-/** Initialize the UncompletedTCP pointers to null
- *
- *  @param[in]      appHandle           the handle returned by tlc_openSession
- */
-void trdp_initUncompletedTCP (TRDP_APP_SESSION_T appHandle)
-{
-    int lIndex;
-    /* Initialize the pointers to Null */
-    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
-    {
-        appHandle->uncompletedTCP[lIndex] = NULL;
-    }
-}
 #endif
 
 /**********************************************************************************************************************/
@@ -1044,9 +1037,9 @@ TRDP_ERR_T  trdp_requestSocket (
                  && (iface[lIndex].sendParam.tsn == params->tsn)
                  && (iface[lIndex].sendParam.vlan == params->vlan)
                  && (iface[lIndex].rcvMostly == rcvMostly)
-                 && ((type != TRDP_SOCK_MD_TCP)
+                 && ((type != TRDP_SOCK_MD_TCP)     /* TCP: one connection per peer, shared by all its requests */
                      || ((type == TRDP_SOCK_MD_TCP) && (iface[lIndex].tcpParams.cornerIp == cornerIp) &&
-                         (iface[lIndex].usage == 0))))
+                         (iface[lIndex].tcpParams.morituri == FALSE))))
         {
             /*  Did this socket join the required multicast group?  */
             if (mcGroup != 0 && trdp_SockIsJoined(iface[lIndex].mcGroups, mcGroup) == FALSE)
@@ -1183,8 +1176,16 @@ TRDP_ERR_T  trdp_requestSocket (
         iface[lIndex].tcpParams.cornerIp    = cornerIp;
         iface[lIndex].tcpParams.sendNotOk   = FALSE;
         iface[lIndex].usage = 0;
-        iface[lIndex].tcpParams.notSend     = FALSE;
         iface[lIndex].tcpParams.morituri    = FALSE;
+        iface[lIndex].tcpParams.pTxHead     = NULL;
+        iface[lIndex].tcpParams.pTxTail     = NULL;
+        iface[lIndex].tcpParams.zeroCopy    = 0;
+        iface[lIndex].tcpParams.zcNextId    = 0u;
+        iface[lIndex].tcpParams.zcLingerEnd.tv_sec  = 0;
+        iface[lIndex].tcpParams.zcLingerEnd.tv_usec = 0;
+        iface[lIndex].tcpParams.zcPendCnt   = 0u;
+        iface[lIndex].tcpParams.pRxPacket   = NULL;
+        iface[lIndex].tcpParams.rxSize      = 0u;
         iface[lIndex].tcpParams.sendingTimeout.tv_sec   = 0;
         iface[lIndex].tcpParams.sendingTimeout.tv_usec  = 0;
 
@@ -1429,6 +1430,11 @@ TRDP_ERR_T  trdp_requestSocket (
                 }
                 else
                 {
+                    /* Connect from the session's interface, the replier tells its peers apart by their address */
+                    if (iface[lIndex].bindAddr != 0)
+                    {
+                        (void) vos_sockBind(iface[lIndex].sock, iface[lIndex].bindAddr, 0);
+                    }
                     iface[lIndex].usage = 1;
                     *pIndex = lIndex;
                 }
@@ -1493,6 +1499,11 @@ void  trdp_releaseSocket (
             {
                 INT32 sock_id = vos_sockId(iface[lIndex].sock);
 
+                if (trdp_mdZeroCopyPending(&iface[lIndex]) == TRUE)
+                {
+                    continue;   /* closed on a later call, once the kernel released the payloads */
+                }
+
                 vos_printLog(VOS_LOG_INFO, "The socket (Num = %d) will be closed\n", sock_id);
 
                 err = (TRDP_ERR_T) vos_sockClose(iface[lIndex].sock);
@@ -1792,3 +1803,34 @@ BOOL8 trdp_isInIPrange (TRDP_IP_ADDR_T  receivedSrcIP,
     }
     return (receivedSrcIP >= listenedSourceIPlow) && (receivedSrcIP <= listenedSourceIPhigh);
 }
+
+/**********************************************************************************************************************/
+/** Check a preemption point of the session reactor.
+ *  Work of lower priority calls this between packets, it stops when TRUE is returned and leaves the rest for the
+ *  next cycle.
+ *
+ *  @param[in,out]  pYield          preemption point, hit is set if the time has come
+ *
+ *  @retval         FALSE - go on
+ *  @retval         TRUE  - stop processing
+ */
+BOOL8 trdp_yield (TRDP_YIELD_T *pYield)
+{
+    TRDP_TIME_T now;
+
+    if (pYield->hit == TRUE)
+    {
+        return TRUE;
+    }
+    if (!timerisset(&pYield->at))
+    {
+        return FALSE;
+    }
+    vos_getTime(&now);
+    if (timercmp(&now, &pYield->at, <))
+    {
+        return FALSE;
+    }
+    pYield->hit = TRUE;
+    return TRUE;
+}
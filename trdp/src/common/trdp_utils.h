@@ -17,6 +17,7 @@
 /*
 * $Id$
 *
+*      AG 2026-10-18: trdp_yield()
 *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
 *      BL 2020-08-07: Ticket #317 Bug in trdp_indeedFindSubAddr() (HIGH_PERFORMANCE)
 *      SB 2020-03-30: Ticket #311: removed trdp_getSeqCnt() because redundant publisher should not run on the same interface
@@ -150,9 +151,6 @@ void trdp_initSockets (
     TRDP_SOCKETS_T  iface[],
     UINT8           noOfEntries);
 
-void    trdp_initUncompletedTCP (
-    TRDP_APP_SESSION_T appHandle);
-
 void    trdp_resetSequenceCounter (
     PD_ELE_T        *pElement,
     TRDP_IP_ADDR_T  srcIP,
@@ -214,4 +212,7 @@ BOOL8 trdp_isInIPrange (
     TRDP_IP_ADDR_T  listenedSourceIPlow,
     TRDP_IP_ADDR_T  listenedSourceIPhigh);
 
+BOOL8 trdp_yield (
+    TRDP_YIELD_T *pYield);
+
 #endif
@@ -6,6 +6,9 @@
  *
  * @details         Hint: Missing optional elements must be handled using the count-function, otherwise following
  *                           elements will be following ignored!
+ *                  The document is tokenized once when it is opened, on POSIX targets the file is mapped into
+ *                  memory for that. Seeking, counting and rewinding then work on the token table, elements deeper
+ *                  than the level searched are skipped as a whole.
  *
  * @note            Project: TCNOpen TRDP prototype stack
  *
@@ -17,6 +20,8 @@
 /*
 * $Id$
 *
+*      AG 2026-10-18: File mapping shared with the configuration cache
+*      AG 2026-10-18: Document tokenized once (mmap on POSIX) into a token table, element skipping when seeking
 *     AHW 2023-01-20: Ticket #415: trdp_XMLGet Attribute: ULONG_MAX should be an allowed value
 *      BL 2020-01-07: Ticket #284: Parsing Unsigned Values from Config XML
 *      BL 2019-01-29: Ticket #232: Write access to XML file
@@ -38,54 +43,114 @@
 
 #include <sys/types.h>
 
+#ifdef POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include "trdp_xml.h"
 
 /***********************************************************************************************************************
  * DEFINES
  */
 
+#define XML_NO_VALUE        0xFFFFFFFFu     /* token without identifier */
+#define XML_MIN_ITEMS       256u            /* initial size of the token table */
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
 
+/** One token of the document, as trdp_XMLNextTokenHl() returned it when reading the document in sequence */
+typedef struct XML_ITEM
+{
+    XML_TOKEN_T token;          /* high level token                                             */
+    int         depth;          /* tag depth after the token                                    */
+    UINT32      value;          /* offset of the identifier in the string pool or XML_NO_VALUE  */
+    UINT32      skip;           /* start tags only: index of the token closing the element      */
+} XML_ITEM_T;
+
+/** Tokenizer state */
+typedef struct
+{
+    const char  *pText;         /* document                                 */
+    size_t      size;           /* its size                                 */
+    size_t      pos;            /* read position                            */
+    int         eof;            /* set by reading beyond the end            */
+    const char  *pValue;        /* identifier of the last TOK_ID            */
+    UINT32      valueLen;       /* its length, truncated to MAX_TOK_LEN - 1 */
+} XML_LEXER_T;
+
 /***********************************************************************************************************************
 *  LOCAL FUNCTIONS
 */
 
-/***********************************************************************************************************************
-NAME:       trdp_XMLNextToken
-ABSTRACT:   Returns next XML token.
-            Skips occurences of whitespace and <!...> and <?...>
-RETURNS:    TOK_OPEN ("<"), TOK_CLOSE (">"), TOK_OPEN_END = ("</"),
-            TOK_CLOSE_EMPTY = ("/>"), TOK_EQUAL = ("="), TOK_ID, TOK_EOF
-*/
+/**********************************************************************************************************************/
+/** Read next character, stdio like.
+ *
+ *  @param[in]      pLex        Pointer to tokenizer state
+ *
+ *  @retval         character or EOF
+ */
+static int xmlGetc (
+    XML_LEXER_T *pLex)
+{
+    if (pLex->pos < pLex->size)
+    {
+        return (unsigned char) pLex->pText[pLex->pos++];
+    }
+    pLex->eof = 1;
+    return EOF;
+}
+
+/**********************************************************************************************************************/
+/** Push back the last character read.
+ *
+ *  @param[in]      pLex        Pointer to tokenizer state
+ *  @param[in]      ch          Character read last
+ *
+ */
+static void xmlUngetc (
+    XML_LEXER_T *pLex,
+    int         ch)
+{
+    if (ch != EOF)
+    {
+        pLex->pos--;
+    }
+}
+
 /**********************************************************************************************************************/
 /** Return next XML token.
  *    Skips occurences of whitespace and <!...> and <?...>
+ *    Identifiers are returned by pointer into the document.
  *
- *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      pLex        Pointer to tokenizer state
+ *  @param[in]      pXML        Pointer to local data, for error reporting
  *
  *  @retval         TOK_OPEN ("<"), TOK_CLOSE (">"), TOK_OPEN_END = ("</"),
  *                  TOK_CLOSE_EMPTY = ("/>"), TOK_EQUAL = ("="), TOK_ID, TOK_EOF
  *
  */
 static XML_TOKEN_T trdp_XMLNextToken (
-    XML_HANDLE_T *pXML)
+    XML_LEXER_T     *pLex,
+    XML_HANDLE_T    *pXML)
 {
     int     ch = 0;
-    char    *p;
+    size_t  start;
 
     for (;; )
     {
         /* Skip whitespace */
-        while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) <= ' ') /*lint !e160 Lint objects a GNU warning
-                                                                           suppression macro - OK */
+        while (!pLex->eof && (ch = xmlGetc(pLex)) <= ' ')
         {
             ;
         }
 
         /* Check for EOF */
-        if (feof(pXML->infile)) /*lint !e611 Lint for VxWorks gets lost in macro defintions*/
+        if (pLex->eof)
         {
             return TOK_EOF;
         }
@@ -93,38 +158,37 @@ static XML_TOKEN_T trdp_XMLNextToken (
         /* Handle quoted identifiers */
         if (ch == '"')
         {
-            p = pXML->tokenValue;
-            while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) != '"') /*lint !e160 Lint objects a GNU warning
-                                                                               suppression macro - OK */
+            start = pLex->pos;
+            while (!pLex->eof && (ch = xmlGetc(pLex)) != '"')
             {
-                if (p < (pXML->tokenValue + MAX_TOK_LEN - 1))
-                {
-                    *(p++) = (char) ch;
-                }
+                ;
+            }
+            pLex->pValue    = pLex->pText + start;
+            pLex->valueLen  = (UINT32) (pLex->pos - start - ((ch == '"') ? 1u : 0u));
+            if (pLex->valueLen > (MAX_TOK_LEN - 1u))
+            {
+                pLex->valueLen = MAX_TOK_LEN - 1u;
             }
-
-            *(p++) = 0;
             return TOK_ID;
         }
         else if (ch == '<')
         {
             /* Tag start character */
-            ch = fgetc(pXML->infile);    /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            ch = xmlGetc(pLex);
 
             if (ch == '?') /* Skip processing instruction */
             {
-                while (!feof(pXML->infile) && (ch = fgetc(pXML->infile))) /*lint !e160 Lint objects a GNU warning
-                                                                            suppression macro - OK */
+                while (!pLex->eof && (ch = xmlGetc(pLex)))
                 {
                     if (ch == '?')
                     {
-                        if ((ch = fgetc(pXML->infile)) == '>')
+                        if ((ch = xmlGetc(pLex)) == '>')
                         {
                             break;
                         }
                         else
                         {
-                            (void) ungetc(ch, pXML->infile);
+                            xmlUngetc(pLex, ch);
                         }
                     }
                 }
@@ -132,16 +196,14 @@ static XML_TOKEN_T trdp_XMLNextToken (
             else if (ch == '!')
             {
                 /* Is it a comment? */
-                if (!feof(pXML->infile) && (ch = fgetc(pXML->infile)))
+                if (!pLex->eof && (ch = xmlGetc(pLex)))
                 {
                     if (ch == '-')
                     {
-                        if ((ch = fgetc(pXML->infile) == '-'))
+                        if ((ch = (xmlGetc(pLex) == '-')))
                         {
                             int endTagCnt = 0;
-                            while (!feof(pXML->infile) && (ch = fgetc(pXML->infile))) /*lint !e160 Lint objects a GNU
-                                                                                        warning suppression macro - OK
-                                                                                        */
+                            while (!pLex->eof && (ch = xmlGetc(pLex)))
                             {
                                 if (ch == '-')
                                 {
@@ -158,7 +220,7 @@ static XML_TOKEN_T trdp_XMLNextToken (
                                 }
                             }
                             /* Exit on unexpected end-of-file */
-                            if (endTagCnt != 2 && feof(pXML->infile))
+                            if (endTagCnt != 2 && pLex->eof)
                             {
                                 pXML->error = TRDP_XML_PARSER_ERR;
                                 return TOK_EOF;
@@ -167,14 +229,14 @@ static XML_TOKEN_T trdp_XMLNextToken (
                     }
                     else
                     {
-                        while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) != '>')
+                        while (!pLex->eof && (ch = xmlGetc(pLex)) != '>')
                         {
                             ;
                         }
                     }
                 }
                 /* Exit on unexpected end-of-file */
-                if (feof(pXML->infile))
+                if (pLex->eof)
                 {
                     pXML->error = TRDP_XML_PARSER_ERR;
                     return TOK_EOF;
@@ -186,20 +248,20 @@ static XML_TOKEN_T trdp_XMLNextToken (
             }
             else
             {
-                (void) ungetc(ch, pXML->infile);
+                xmlUngetc(pLex, ch);
                 return TOK_OPEN;
             }
         }
         else if (ch == '/')
         {
-            ch = fgetc(pXML->infile); /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            ch = xmlGetc(pLex);
             if (ch == '>')
             {
                 return TOK_CLOSE_EMPTY;
             }
             else
             {
-                (void) ungetc(ch, pXML->infile);
+                xmlUngetc(pLex, ch);
             }
         }
         else if (ch == '>')
@@ -213,26 +275,27 @@ static XML_TOKEN_T trdp_XMLNextToken (
         else
         {
             /* Unquoted identifier */
-            p       = pXML->tokenValue;
-            *(p++)  = (char) ch;
-            while ((!feof(pXML->infile)) &&
-                   ((ch = fgetc(pXML->infile)) != '<') /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            start = pLex->pos - 1u;
+            while ((!pLex->eof) &&
+                   ((ch = xmlGetc(pLex)) != '<')
                    && (ch != '>')
                    && (ch != '=')
                    && (ch != '/')
                    && (ch > ' '))
             {
-                if (p < (pXML->tokenValue + MAX_TOK_LEN - 1u))
-                {
-                    *(p++) = (char) ch;
-                }
+                ;
             }
 
-            *(p++) = 0;
-
             if ((ch == '<') || (ch == '>') || (ch == '=') || (ch == '/'))
             {
-                (void) ungetc(ch, pXML->infile);
+                xmlUngetc(pLex, ch);
+            }
+            pLex->pValue    = pLex->pText + start;
+            /* a terminating whitespace is consumed, special characters are pushed back */
+            pLex->valueLen  = (UINT32) (pLex->pos - start - (((ch != EOF) && (ch <= ' ')) ? 1u : 0u));
+            if (pLex->valueLen > (MAX_TOK_LEN - 1u))
+            {
+                pLex->valueLen = MAX_TOK_LEN - 1u;
             }
 
             return TOK_ID;
@@ -241,136 +304,389 @@ static XML_TOKEN_T trdp_XMLNextToken (
 }
 
 /**********************************************************************************************************************/
-/** Return next high level XML token.
- *    Any Id is stored in pXML->tokenValue
- *    Other tokens are returned as is
+/** Append a token to the token table, growing it if needed.
  *
  *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      pLex        Pointer to tokenizer state, identifier for tokens with value
+ *  @param[in]      token       High level token
+ *  @param[in]      hasValue    Token carries the last identifier
  *
- *  @retval         TOK_START_TAG = TOK_OPEN + TOK_ID
- *                  TOK_END_TAG = TOK_OPEN_END + TOK_ID + TOK_CLOSE
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+static TRDP_ERR_T xmlAddItem (
+    XML_HANDLE_T        *pXML,
+    const XML_LEXER_T   *pLex,
+    XML_TOKEN_T         token,
+    int                 hasValue)
+{
+    XML_ITEM_T *pItem;
+
+    if (pXML->numItems == pXML->maxItems)
+    {
+        UINT32      newMax  = (pXML->maxItems == 0u) ? XML_MIN_ITEMS : 2u * pXML->maxItems;
+        XML_ITEM_T  *pNew   = (XML_ITEM_T *) realloc(pXML->pItems, newMax * sizeof(XML_ITEM_T));
+
+        if (pNew == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        pXML->pItems    = pNew;
+        pXML->maxItems  = newMax;
+    }
+
+    pItem           = &pXML->pItems[pXML->numItems];
+    pItem->token    = token;
+    pItem->depth    = pXML->tagDepth;
+    pItem->value    = XML_NO_VALUE;
+    pItem->skip     = 0u;
+
+    if (hasValue)
+    {
+        /* The identifiers are at most as long as the document, the pool is sized on opening */
+        pItem->value = pXML->poolUsed;
+        memcpy(pXML->pPool + pXML->poolUsed, pLex->pValue, pLex->valueLen);
+        pXML->pPool[pXML->poolUsed + pLex->valueLen] = '\0';
+        pXML->poolUsed += pLex->valueLen + 1u;
+    }
+    pXML->numItems++;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Tokenize the whole document.
+ *    Records the sequence trdp_XMLNextTokenHl() returned when reading the document from the start, together
+ *    with the tag depth after every token. Start tags get the index of the token ending their element, so
+ *    deeper elements can be skipped when seeking.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      pText       Document
+ *  @param[in]      size        Size of the document
  *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
  */
-static XML_TOKEN_T trdp_XMLNextTokenHl (
-    XML_HANDLE_T *pXML)
+static TRDP_ERR_T trdp_XMLTokenize (
+    XML_HANDLE_T    *pXML,
+    const char      *pText,
+    size_t          size)
 {
+    XML_LEXER_T lex;
     XML_TOKEN_T token;
+    TRDP_ERR_T  err     = TRDP_NO_ERR;
+    UINT32      *pOpen  = NULL;     /* start tags of the elements not closed yet */
+    UINT32      numOpen = 0u;
+    UINT32      maxOpen = 0u;
+    UINT32      i;
+
+    memset(&lex, 0, sizeof(lex));
+    lex.pText   = pText;
+    lex.size    = size;
+
+    pXML->pPool = (char *) malloc(size + 1u);
+    if (pXML->pPool == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pXML->tagDepth = 0;
 
-    token = trdp_XMLNextToken(pXML);
-
-    if (token == TOK_OPEN)
+    while (err == TRDP_NO_ERR)
     {
-        pXML->tagDepth++;
-        token = trdp_XMLNextToken(pXML);
+        int hasValue = 0;
+
+        token = trdp_XMLNextToken(&lex, pXML);
 
-        if (token == TOK_ID)
+        if (token == TOK_OPEN)
         {
-            vos_strncpy(pXML->tokenTag, pXML->tokenValue, MAX_TAG_LEN);
-            token = TOK_START_TAG;  /* TOK_OPEN + TOK_ID */
+            pXML->tagDepth++;
+            token = trdp_XMLNextToken(&lex, pXML);
+            /* Something wrong otherwise, < should always be followed by a tag id */
+            hasValue    = (token == TOK_ID);
+            token       = hasValue ? TOK_START_TAG : TOK_EOF;
         }
-        else
+        else if (token == TOK_OPEN_END)
         {
-            token = TOK_EOF;  /* Something wrong, < should always be followed by a tag id */
+            pXML->tagDepth--;
+            token = trdp_XMLNextToken(&lex, pXML);
+            /* Something wrong otherwise, </ should always be followed by a tag id + ">"*/
+            hasValue    = (token == TOK_ID);
+            token       = hasValue ? TOK_END_TAG : TOK_EOF;
+        }
+        else if (token == TOK_CLOSE_EMPTY)
+        {
+            pXML->tagDepth--;
+        }
+        else if (token == TOK_ID)
+        {
+            hasValue = 1;
         }
-    }
-    else if (token == TOK_OPEN_END)
-    {
-        pXML->tagDepth--;
-        token = trdp_XMLNextToken(pXML);
 
-        if (token == TOK_ID)
+        /* Elements ended by this token. A malformed tag ends the search like the end of file, so it
+           must not be skipped */
+        while ((numOpen > 0u) &&
+               ((pXML->pItems[pOpen[numOpen - 1u]].depth > pXML->tagDepth) || (token == TOK_EOF)))
         {
-            vos_strncpy(pXML->tokenTag, pXML->tokenValue, MAX_TAG_LEN);
-            token = TOK_END_TAG; /* TOK_OPEN_END + TOK_ID + TOK_CLOSE */
+            pXML->pItems[pOpen[--numOpen]].skip = pXML->numItems;
         }
-        else
+
+        err = xmlAddItem(pXML, &lex, token, hasValue);
+
+        if ((err == TRDP_NO_ERR) && (token == TOK_START_TAG))
+        {
+            if (numOpen == maxOpen)
+            {
+                UINT32 *pNew;
+
+                maxOpen = (maxOpen == 0u) ? 32u : 2u * maxOpen;
+                pNew    = (UINT32 *) realloc(pOpen, maxOpen * sizeof(UINT32));
+                if (pNew == NULL)
+                {
+                    err = TRDP_MEM_ERR;
+                    break;
+                }
+                pOpen = pNew;
+            }
+            pOpen[numOpen++] = pXML->numItems - 1u;
+        }
+
+        if ((err == TRDP_NO_ERR) && lex.eof && (token != TOK_EOF))
+        {
+            /* A token at the very end, the table always ends with the end of file */
+            token   = TOK_EOF;
+            err     = xmlAddItem(pXML, &lex, token, 0);
+        }
+        if (lex.eof && (token == TOK_EOF))
         {
-            token = TOK_EOF;  /* Something wrong, </ should always be followed by a tag id + ">"*/
+            break;
         }
     }
-    else if (token == TOK_CLOSE_EMPTY)
+
+    /* Unterminated elements end with the document */
+    for (i = 0u; i < numOpen; i++)
     {
-        pXML->tagDepth--;
+        pXML->pItems[pOpen[i]].skip = pXML->numItems - 1u;
     }
-    else if (token == TOK_ID)
+    free(pOpen);
+
+    pXML->tagDepth  = 0;
+    pXML->pos       = 0u;
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Load a document into the handle.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      pText       Document
+ *  @param[in]      size        Size of the document
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+static TRDP_ERR_T trdp_XMLLoad (
+    XML_HANDLE_T    *pXML,
+    const char      *pText,
+    size_t          size)
+{
+    TRDP_ERR_T err;
+
+    memset(pXML, 0, sizeof(XML_HANDLE_T));
+    err = trdp_XMLTokenize(pXML, pText, size);
+    pXML->error = TRDP_NO_ERR;
+    if (err != TRDP_NO_ERR)
+    {
+        trdp_XMLClose(pXML);
+        vos_printLogStr(VOS_LOG_ERROR, "Out of memory tokenizing XML document\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Return next high level XML token.
+ *    Any Id is stored in pXML->tokenValue
+ *    Other tokens are returned as is
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *
+ *  @retval         TOK_START_TAG = TOK_OPEN + TOK_ID
+ *                  TOK_END_TAG = TOK_OPEN_END + TOK_ID + TOK_CLOSE
+ *
+ */
+static XML_TOKEN_T trdp_XMLNextTokenHl (
+    XML_HANDLE_T *pXML)
+{
+    const XML_ITEM_T *pItem;
+
+    if (pXML->numItems == 0u)
+    {
+        return TOK_EOF;
+    }
+
+    pItem = &pXML->pItems[pXML->pos];
+    if (pXML->pos < (pXML->numItems - 1u))
+    {
+        pXML->pos++;
+    }
+
+    pXML->tagDepth = pItem->depth;
+    if (pItem->value != XML_NO_VALUE)
     {
+        vos_strncpy(pXML->tokenValue, pXML->pPool + pItem->value, MAX_TOK_LEN);
         vos_strncpy(pXML->tokenTag, pXML->tokenValue, MAX_TAG_LEN);
-        token = TOK_ID;
     }
 
-    return token;
+    return pItem->token;
 }
 
 /*******************************************************************************
 *  GLOBAL FUNCTIONS
 */
 
+/**********************************************************************************************************************/
+/** Map a file read only into memory (read into a heap buffer on targets without mmap).
+ *
+ *  @param[in]      file        Pathname of the file
+ *  @param[out]     ppText      Pointer to the file contents, a valid pointer for an empty file
+ *  @param[out]     pSize       Size of the file
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_IO_ERR     file could not be read
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+TRDP_ERR_T trdp_XMLMapFile (
+    const char  *file,
+    const char  **ppText,
+    size_t      *pSize)
+{
+#ifdef POSIX
+    struct stat fileStat;
+    void        *pMap;
+    int         fd = open(file, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return TRDP_IO_ERR;
+    }
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size < 0))
+    {
+        (void) close(fd);
+        return TRDP_IO_ERR;
+    }
+    if (fileStat.st_size == 0)
+    {
+        (void) close(fd);
+        *ppText = "";
+        *pSize  = 0u;
+        return TRDP_NO_ERR;
+    }
+    pMap = mmap(NULL, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void) close(fd);
+    if (pMap == MAP_FAILED)
+    {
+        return TRDP_IO_ERR;
+    }
+    *ppText = (const char *) pMap;
+    *pSize  = (size_t) fileStat.st_size;
+#else
+    FILE    *infile;
+    char    *pText;
+    long    size;
+
+    if ((infile = fopen(file, "rb")) == NULL)
+    {
+        return TRDP_IO_ERR;
+    }
+    if ((fseek(infile, 0, SEEK_END) != 0) || ((size = ftell(infile)) < 0) || (fseek(infile, 0, SEEK_SET) != 0))
+    {
+        fclose(infile);
+        return TRDP_IO_ERR;
+    }
+    pText = (char *) malloc((size_t) size + 1u);
+    if (pText == NULL)
+    {
+        fclose(infile);
+        return TRDP_MEM_ERR;
+    }
+    if (fread(pText, 1u, (size_t) size, infile) != (size_t) size)
+    {
+        free(pText);
+        fclose(infile);
+        return TRDP_IO_ERR;
+    }
+    fclose(infile);
+    *ppText = pText;
+    *pSize  = (size_t) size;
+#endif
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Release a file mapped by trdp_XMLMapFile.
+ *
+ *  @param[in]      pText       Pointer to the file contents
+ *  @param[in]      size        Size of the file
+ *
+ *  @retval         none
+ */
+void trdp_XMLUnmapFile (
+    const char  *pText,
+    size_t      size)
+{
+#ifdef POSIX
+    if (size > 0u)
+    {
+        (void) munmap((void *) pText, size);
+    }
+#else
+    (void) size;
+    free((void *) pText);
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Opens the XML parsing.
+ *    The file is read and tokenized completely, it is not accessed afterwards.
  *
  *  @param[in]      pXML        Pointer to local data
  *  @param[in]      file        Pathname of XML file
  *
- *  @retval         none
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_IO_ERR     file could not be read
+ *  @retval         TRDP_MEM_ERR    out of memory
  */
 TRDP_ERR_T trdp_XMLOpen (
     XML_HANDLE_T    *pXML,
     const char      *file)
 {
-    if ((pXML->infile = fopen(file, "rb")) == NULL)
+    const char  *pText;
+    size_t      size;
+    TRDP_ERR_T  err = trdp_XMLMapFile(file, &pText, &size);
+
+    if (err == TRDP_NO_ERR)
     {
-        return TRDP_IO_ERR;
+        err = trdp_XMLLoad(pXML, pText, size);
+        trdp_XMLUnmapFile(pText, size);
     }
-
-    pXML->tagDepth      = 0;
-    pXML->tagDepthSeek  = 0;
-    pXML->error         = TRDP_NO_ERR;
-    return TRDP_NO_ERR;
+    return err;
 }
 
 /**********************************************************************************************************************/
 /** Opens the XML parsing from a buffer (string stream).
+ *    The buffer is tokenized completely, it may be released afterwards.
  *
  *  @param[in]      pXML        Pointer to local data
  *  @param[in]      pBuffer     Pointer to XML stream buffer
  *  @param[in]      bufSize     Size of XML stream buffer
  *
- *  @retval         TRDP_IO_ERR
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR    out of memory
  */
 TRDP_ERR_T trdp_XMLMemOpen (
     XML_HANDLE_T    *pXML,
     const char      *pBuffer,
     size_t          bufSize)
 {
-#ifdef HAS_FMEMOPEN
-#ifdef __APPLE__
-    if (__builtin_available(macOS 10.13, *))
-#endif
-    if ((pXML->infile = fmemopen((void *)pBuffer, bufSize, "rb")) == NULL)
-    {
-        vos_printLogStr(VOS_LOG_ERROR, "XML stream could not be opened for reading\n");
-        return TRDP_IO_ERR;
-    }
-
-    pXML->tagDepth      = 0;
-    pXML->tagDepthSeek  = 0;
-    pXML->error         = TRDP_NO_ERR;
-    return TRDP_NO_ERR;
-#else
-    /* Create and open a temporary file */
-    pXML->infile = tmpfile();               /* Note: Needs admin rights under VISTA!    */
-    if (pXML->infile != NULL)
-    {
-        /* Write to temp file */
-    	if (fwrite(pBuffer, 1, bufSize, pXML->infile) == bufSize) {
-    		/* prepare for reading */
-    		trdp_XMLRewind (pXML);
-    		return TRDP_NO_ERR;
-    	}
-    }
-    vos_printLogStr(VOS_LOG_ERROR, "Temporary XML file could not be opened to write\n");
-    return TRDP_IO_ERR;
-#endif
+    return trdp_XMLLoad(pXML, pBuffer, bufSize);
 }
 
 /**********************************************************************************************************************/
@@ -383,16 +699,13 @@ TRDP_ERR_T trdp_XMLMemOpen (
 void trdp_XMLRewind (
     XML_HANDLE_T *pXML)
 {
-    if (pXML->infile == NULL)
+    if (pXML->pItems == NULL)
     {
         pXML->error = TRDP_XML_PARSER_ERR;
     }
-    else if (fseek(pXML->infile, 0, SEEK_SET) == -1)
-    {
-        pXML->error = TRDP_IO_ERR;
-    }
     else
     {
+        pXML->pos           = 0u;
         pXML->tagDepth      = 0;
         pXML->tagDepthSeek  = 0;
         pXML->error         = TRDP_NO_ERR;
@@ -409,12 +722,18 @@ void trdp_XMLRewind (
 void trdp_XMLClose (
     XML_HANDLE_T *pXML)
 {
-    fclose(pXML->infile);
+    free(pXML->pItems);
+    free(pXML->pPool);
+    pXML->pItems    = NULL;
+    pXML->pPool     = NULL;
+    pXML->numItems  = 0u;
+    pXML->maxItems  = 0u;
+    pXML->pos       = 0u;
 }
 
 /**********************************************************************************************************************/
 /** Seek next tag on starting depth and return it in provided buffer.
- *  Start tags on deeper depths are ignored.
+ *  Start tags on deeper depths are ignored, their elements are skipped as a whole.
  *
  *  @param[in]      pXML        Pointer to local data
  *  @param[in,out]  tag         Buffer for found tag
@@ -449,6 +768,11 @@ int trdp_XMLSeekStartTagAny (
             vos_strncpy(tag, pXML->tokenTag, (UINT32) maxlen);
             ret = 0;
         }
+        else if ((pXML->tagDepth > pXML->tagDepthSeek) && (token == TOK_START_TAG))
+        {
+            /* Nothing of interest inside, continue with the token ending the element */
+            pXML->pos = pXML->pItems[pXML->pos - 1u].skip;
+        }
         /* else ignore */
     }
 
@@ -496,8 +820,7 @@ int trdp_XMLCountStartTag (
     char            buf[MAX_TAG_LEN + 1u];
     int             count = 0;
 
-    XML_HANDLE_T    safe        = *pXML;
-    off_t           last_read   = ftell(pXML->infile);
+    XML_HANDLE_T    safe = *pXML;
 
     do
     {
@@ -510,7 +833,6 @@ int trdp_XMLCountStartTag (
     while (ret == 0);
 
     *pXML = safe;
-    fseek(pXML->infile, (long) last_read, SEEK_SET);
     return count;
 }
 
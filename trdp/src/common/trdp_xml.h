@@ -17,6 +17,8 @@
  /*
  * $Id$
  *
+ *      AG 2026-10-18: File mapping shared with the configuration cache
+ *      AG 2026-10-18: Token table instead of the input file, filled when opening
  *      BL 2019-01-23: Ticket #231: XML config from stream buffer
  *      BL 2016-02-11: Ticket #102: Replacing libxml2
  *
@@ -67,9 +69,16 @@ typedef enum
     TOK_ATTRIBUTE       /* "<" character    */
 } XML_TOKEN_T;
 
+struct XML_ITEM;
+
 typedef struct XML_HANDLE
 {
-    FILE    *infile;
+    struct XML_ITEM *pItems;    /* tokens of the document, ending with TOK_EOF  */
+    UINT32  numItems;           /* tokens used                                  */
+    UINT32  maxItems;           /* tokens allocated                             */
+    UINT32  pos;                /* next token                                   */
+    char    *pPool;             /* identifiers of the tokens                    */
+    UINT32  poolUsed;           /* bytes used in the pool                       */
     char    tokenValue[MAX_TOK_LEN];
     int     tagDepth;
     int     tagDepthSeek;
@@ -81,6 +90,12 @@ typedef struct XML_HANDLE
  * GLOBAL FUNCTIONS
  */
 
+TRDP_ERR_T  trdp_XMLMapFile (const char  *file,
+                             const char  **ppText,
+                             size_t      *pSize);
+void        trdp_XMLUnmapFile (const char  *pText,
+                               size_t      size);
+
 TRDP_ERR_T  trdp_XMLOpen (XML_HANDLE_T  *pXML,
                           const char    *file);
 
@@ -17,6 +17,9 @@
 /*
  * $Id$
  *
+ *      AG 2026-10-18: Pollable deadline timers (vos_sockOpenTimer etc.)
+ *      AG 2026-10-18: Pollable wake-up events (vos_sockOpenEvent etc.)
+ *      AG 2026-10-18: Scatter/gather TCP send (vos_sockSendTCPv) and MSG_ZEROCOPY support
  *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1', it is provided with the highest socket, and VOS implementation of the function will add the '+1' (if needed)
  *     AHW 2021-05-06: Ticket #322 Subscriber multicast message routing in multi-home device
  *      Tz 2019-11-24: added headers for PikeOS-Posix
@@ -111,6 +114,9 @@ extern "C" {
 #ifndef VOS_MAX_NUM_IF              /**< The maximum number of IP interface adapters that can be handled by VOS */
 #define VOS_MAX_NUM_IF  8
 #endif
+#ifndef VOS_MAX_IOVEC_CNT           /**< The maximum number of buffers for one scatter/gather send */
+#define VOS_MAX_IOVEC_CNT  4
+#endif
 #ifndef VOS_MAX_NUM_UNICAST         /**< The maximum number of unicast addresses that can be handled by VOS    */
 #define VOS_MAX_NUM_UNICAST  10
 #endif
@@ -191,6 +197,26 @@ typedef struct
 
 typedef fd_set VOS_FDS_T;
 
+/** Buffer descriptor for scatter/gather I/O  */
+typedef struct
+{
+    const UINT8 *pBuffer;   /**< pointer to the data                                */
+    UINT32      size;       /**< number of bytes                                    */
+} VOS_IOVEC_T;
+
+/** Wake-up event, which can be watched by vos_select()  */
+typedef struct
+{
+    VOS_SOCK_T  rdSock;     /**< descriptor to watch for reading                    */
+    VOS_SOCK_T  wrSock;     /**< descriptor to signal, may be the same as rdSock    */
+} VOS_SOCK_EVENT_T;
+
+/** Deadline timer, which can be watched by vos_select()  */
+typedef struct
+{
+    VOS_SOCK_T  sock;       /**< descriptor to watch for reading                    */
+} VOS_SOCK_TIMER_T;
+
 typedef struct
 {
     CHAR8           name[VOS_MAX_IF_NAME_SIZE]; /**< interface adapter name         */
@@ -668,6 +694,171 @@ EXT_DECL VOS_ERR_T vos_sockReceiveTCP (
     UINT8       *pBuffer,
     UINT32      *pSize);
 
+/**********************************************************************************************************************/
+/** Send TCP data from several buffers (gather write).
+ *  The buffers are sent in the given order as one contiguous byte stream, without copying them into an intermediate
+ *  buffer. If pZeroCopyId is supplied, the kernel is asked to transmit the buffers without copying them at all
+ *  (MSG_ZEROCOPY), except the first one: it is copied, so a header may be released right after the call. The caller
+ *  must not modify or release the other buffers, until vos_sockZeroCopyDone() reports the completion of the
+ *  corresponding send operation(s).
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pIov            array of buffer descriptors
+ *  @param[in]      iovCnt          number of buffer descriptors (max. VOS_MAX_IOVEC_CNT)
+ *  @param[in,out]  pSize           In: ignored, Out: no of bytes sent
+ *  @param[in,out]  pZeroCopyId     NULL for a standard send, else counter of zero-copy send operations on this socket,
+ *                                  incremented for each zero-copy send operation issued
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   call would have blocked in blocking mode, data partially sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    VOS_SOCK_T          sock,
+    const VOS_IOVEC_T   *pIov,
+    UINT32              iovCnt,
+    UINT32              *pSize,
+    UINT32              *pZeroCopyId);
+
+/**********************************************************************************************************************/
+/** Enable zero-copy transmission on a TCP socket.
+ *
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown
+ *  @retval         VOS_SOCK_ERR    zero-copy is not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetZeroCopy (
+    VOS_SOCK_T sock);
+
+/**********************************************************************************************************************/
+/** Collect zero-copy completions of a TCP socket.
+ *  Reads the next completion notification from the socket's error queue. A notification covers a range of
+ *  zero-copy send operations (see vos_sockSendTCPv), ranges may be reported in any order. Call repeatedly until
+ *  VOS_NODATA_ERR is returned.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pFirstId        id of the first completed zero-copy send operation
+ *  @param[out]     pLastId         id of the last completed zero-copy send operation (ids wrap around)
+ *
+ *  @retval         VOS_NO_ERR      a range of completions was read
+ *  @retval         VOS_NODATA_ERR  no new completions
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      the error queue could not be read
+ *  @retval         VOS_SOCK_ERR    zero-copy is not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockZeroCopyDone (
+    VOS_SOCK_T  sock,
+    UINT32      *pFirstId,
+    UINT32      *pLastId);
+
+/**********************************************************************************************************************/
+/** Create a wake-up event.
+ *  The event's rdSock becomes readable for vos_select() as soon as the event is signalled and stays readable until
+ *  the event is cleared. Signalling is safe from any thread.
+ *
+ *  @param[out]     pEvent          pointer to the event to initialise
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    events are not supported by the target or no descriptor available
+ */
+
+EXT_DECL VOS_ERR_T vos_sockOpenEvent (
+    VOS_SOCK_EVENT_T *pEvent);
+
+/**********************************************************************************************************************/
+/** Release a wake-up event.
+ *
+ *  @param[in,out]  pEvent          pointer to the event, its descriptors are invalid afterwards
+ */
+
+EXT_DECL void vos_sockCloseEvent (
+    VOS_SOCK_EVENT_T *pEvent);
+
+/**********************************************************************************************************************/
+/** Signal a wake-up event.
+ *
+ *  @param[in]      pEvent          pointer to the event
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSignalEvent (
+    const VOS_SOCK_EVENT_T *pEvent);
+
+/**********************************************************************************************************************/
+/** Reset a wake-up event to non-signalled.
+ *
+ *  @param[in]      pEvent          pointer to the event
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_sockClearEvent (
+    const VOS_SOCK_EVENT_T *pEvent);
+
+/**********************************************************************************************************************/
+/** Create a deadline timer.
+ *  The timer's sock becomes readable for vos_select() when the deadline set by vos_sockSetTimer() is reached and
+ *  stays readable until the timer is cleared or set again. Waiting for the timer and the sockets of a session in one
+ *  vos_select() call allows to sleep until the next event without a fixed cycle.
+ *
+ *  @param[out]     pTimer          pointer to the timer to initialise, disarmed
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    timers are not supported by the target or no descriptor available
+ */
+
+EXT_DECL VOS_ERR_T vos_sockOpenTimer (
+    VOS_SOCK_TIMER_T *pTimer);
+
+/**********************************************************************************************************************/
+/** Release a deadline timer.
+ *
+ *  @param[in,out]  pTimer          pointer to the timer, its descriptor is invalid afterwards
+ */
+
+EXT_DECL void vos_sockCloseTimer (
+    VOS_SOCK_TIMER_T *pTimer);
+
+/**********************************************************************************************************************/
+/** Arm a deadline timer.
+ *  A deadline which has already passed makes the timer readable at once.
+ *
+ *  @param[in]      pTimer          pointer to the timer
+ *  @param[in]      pDeadline       absolute time (vos_getTime() clock), NULL or zero to disarm the timer
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    timer could not be set
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetTimer (
+    const VOS_SOCK_TIMER_T  *pTimer,
+    const VOS_TIMEVAL_T     *pDeadline);
+
+/**********************************************************************************************************************/
+/** Reset an expired deadline timer to non-readable.
+ *
+ *  @param[in]      pTimer          pointer to the timer
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_sockClearTimer (
+    const VOS_SOCK_TIMER_T *pTimer);
+
 /**********************************************************************************************************************/
 /** Set Using Multicast I/F
  *
@@ -17,6 +17,9 @@
 /*
 * $Id$
 *
+*      AG 2026-10-18: vos_atomicCompareExchange32()/vos_atomicFence() for sequence locks
+*      AG 2026-10-18: Cyclic threads: overrun policy and timing statistics
+*      AG 2026-10-18: vos_atomicLoad32()/vos_atomicStore32() for lock-free data exchange between threads
 *      A 2022-03-02: Ticket #389: Add vos Sim function vos_threadRegisterExisting
 *      TS 2020-08-28: Adjusting thread function type: pthreads MUST return a pointer on exit (in Win a DWORD though)
 *      A 2019-12-17: Ticket #308: Add vos Sim function to API 
@@ -61,6 +64,9 @@ extern "C" {
 /** Timeout value to wait forever for a semaphore */
 #define VOS_SEMA_WAIT_FOREVER  0xFFFFFFFFU
 
+/** Number of buckets of the timing histograms of cyclic threads */
+#define VOS_THREAD_HIST_BUCKETS  16u
+
 #if defined(SIM)
 #include "SimSocket.h"
 #elif (defined(WIN32) || defined(WIN64))
@@ -128,6 +134,31 @@ typedef UINT8 VOS_THREAD_PRIORITY_T;
 /** Thread function definition    */
 typedef void *(__cdecl * VOS_THREAD_FUNC_T)(void *pArg);
 
+/** Handling of a cyclic thread whose function returned after one or more of its next release times    */
+typedef enum
+{
+    VOS_THREAD_OVERRUN_SKIP     = 0,    /**< drop the missed releases, continue on the original time grid (default) */
+    VOS_THREAD_OVERRUN_CATCHUP  = 1,    /**< call the function for the missed releases without delay            */
+    VOS_THREAD_OVERRUN_RESYNC   = 2     /**< drop the missed releases, restart the grid at the end of the call  */
+} VOS_THREAD_OVERRUN_T;
+
+/** Timing statistics of a cyclic thread, all times in us.
+ *  Bucket 0 of a histogram counts values below 1us, bucket n values from 2^(n-1) to 2^n - 1 us and the last bucket
+ *  all larger values.  */
+typedef struct
+{
+    UINT32  interval;                               /**< cycle time of the thread                               */
+    UINT32  cycles;                                 /**< number of calls of the thread function                 */
+    UINT32  overruns;                               /**< calls which returned after the next release time       */
+    UINT32  skipped;                                /**< releases dropped because of overruns                   */
+    UINT32  latencyMin;                             /**< shortest delay between release time and call           */
+    UINT32  latencyMax;                             /**< longest delay between release time and call            */
+    UINT32  execMin;                                /**< shortest execution time of the thread function         */
+    UINT32  execMax;                                /**< longest execution time of the thread function          */
+    UINT32  latencyHist[VOS_THREAD_HIST_BUCKETS];   /**< histogram of the wakeup latencies                      */
+    UINT32  execHist[VOS_THREAD_HIST_BUCKETS];      /**< histogram of the execution times                       */
+} VOS_THREAD_CYC_STATS_T;
+
 /** State of the semaphore    */
 typedef enum
 {
@@ -268,6 +299,42 @@ EXT_DECL VOS_ERR_T vos_threadTerminate (
 EXT_DECL VOS_ERR_T vos_threadIsActive (
     VOS_THREAD_T thread);
 
+/**********************************************************************************************************************/
+/** Set the overrun policy of a cyclic thread.
+ *  The policy decides what happens to the releases a thread missed because its function ran longer than the
+ *  interval. It takes effect with the next overrun.
+ *
+ *  @param[in]      thread            Handle of a thread created with an interval
+ *  @param[in]      policy            Skip, catch up or resynchronise
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_NOINIT_ERR    not a cyclic thread
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_UNKNOWN_ERR   not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetOverrunPolicy (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_OVERRUN_T    policy);
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread.
+ *
+ *  @param[in]      thread            Handle of a thread created with an interval
+ *  @param[out]     pStats            Pointer to the statistics to fill
+ *  @param[in]      reset             Clear the statistics after reading them
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_NOINIT_ERR    not a cyclic thread
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_UNKNOWN_ERR   not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetCyclicStats (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_CYC_STATS_T  *pStats,
+    BOOL8                   reset);
+
 #ifdef SIM
 /**********************************************************************************************************************/
 /** Register a existing TimeSync thread.
@@ -584,6 +651,56 @@ EXT_DECL VOS_ERR_T vos_semaTake (
 EXT_DECL void vos_semaGive (
     VOS_SEMA_T sema);
 
+/**********************************************************************************************************************/
+/** Read a value shared between threads.
+ *  The read has acquire semantics: all writes of the thread, which stored the value with vos_atomicStore32(), are
+ *  visible after the call.
+ *
+ *  @param[in]      pValue          pointer to the shared value
+ *
+ *  @retval         the value read
+ */
+
+EXT_DECL UINT32 vos_atomicLoad32 (
+    const volatile UINT32 *pValue);
+
+/**********************************************************************************************************************/
+/** Write a value shared between threads.
+ *  The write has release semantics: all preceding writes of the calling thread become visible to a thread reading
+ *  the value with vos_atomicLoad32().
+ *
+ *  @param[in]      pValue          pointer to the shared value
+ *  @param[in]      value           the value to write
+ */
+
+EXT_DECL void vos_atomicStore32 (
+    volatile UINT32 *pValue,
+    UINT32          value);
+
+/**********************************************************************************************************************/
+/** Compare and exchange a value shared between threads.
+ *  Writes desired to the value if it still holds expected. A successful exchange has acquire and release semantics.
+ *
+ *  @param[in,out]  pValue          pointer to the shared value
+ *  @param[in]      expected        the value expected
+ *  @param[in]      desired         the value to write
+ *
+ *  @retval         TRUE            value was exchanged
+ *  @retval         FALSE           value did not hold expected, nothing written
+ */
+
+EXT_DECL BOOL8 vos_atomicCompareExchange32 (
+    volatile UINT32 *pValue,
+    UINT32          expected,
+    UINT32          desired);
+
+/**********************************************************************************************************************/
+/** Full memory barrier.
+ *  No read or write of the calling thread is reordered across the call.
+ */
+
+EXT_DECL void vos_atomicFence (void);
+
 
 #ifdef __cplusplus
 }
@@ -17,6 +17,9 @@
  /*
  * $Id$
  *
+ *      AG 2026-10-18: vos_atomicCompareExchange32()/vos_atomicFence()
+ *      AG 2026-10-18: vos_threadSetOverrunPolicy()/vos_threadGetCyclicStats() stubs
+ *      AG 2026-10-18: vos_atomicLoad32()/vos_atomicStore32()
  *     CEW 2023-01-09: Ticket #408: thread-safe localtime - but be aware of static pTimeString
  *      BL 2018-06-25: Ticket #202: vos_mutexTrylock return value
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
@@ -397,6 +400,45 @@ EXT_DECL VOS_ERR_T vos_threadIsActive (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Set the overrun policy of a cyclic thread.
+ *  Not supported by this target, cyclic threads always continue with the next release.
+ *
+ *  @param[in]      thread          Thread handle
+ *  @param[in]      policy          Skip, catch up or resynchronise
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetOverrunPolicy (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_OVERRUN_T    policy)
+{
+    (void) thread;
+    (void) policy;
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread.
+ *  Not supported by this target.
+ *
+ *  @param[in]      thread          Thread handle
+ *  @param[out]     pStats          Pointer to the statistics to fill
+ *  @param[in]      reset           Clear the statistics after reading them
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetCyclicStats (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_CYC_STATS_T  *pStats,
+    BOOL8                   reset)
+{
+    (void) thread;
+    (void) pStats;
+    (void) reset;
+    return VOS_UNKNOWN_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Return thread handle of calling task
  *
@@ -1164,3 +1206,66 @@ EXT_DECL void vos_semaGive (
     }
     return;
 }
+
+/**********************************************************************************************************************/
+/** Read a value shared between threads.
+ *  The read has acquire semantics: all writes of the thread, which stored the value with vos_atomicStore32(), are
+ *  visible after the call.
+ *
+ *  @param[in]      pValue          pointer to the shared value
+ *
+ *  @retval         the value read
+ */
+
+EXT_DECL UINT32 vos_atomicLoad32 (
+    const volatile UINT32 *pValue)
+{
+    return __atomic_load_n(pValue, __ATOMIC_ACQUIRE);
+}
+
+/**********************************************************************************************************************/
+/** Write a value shared between threads.
+ *  The write has release semantics: all preceding writes of the calling thread become visible to a thread reading
+ *  the value with vos_atomicLoad32().
+ *
+ *  @param[in]      pValue          pointer to the shared value
+ *  @param[in]      value           the value to write
+ */
+
+EXT_DECL void vos_atomicStore32 (
+    volatile UINT32 *pValue,
+    UINT32          value)
+{
+    __atomic_store_n(pValue, value, __ATOMIC_RELEASE);
+}
+
+/**********************************************************************************************************************/
+/** Compare and exchange a value shared between threads.
+ *  Writes desired to the value if it still holds expected. A successful exchange has acquire and release semantics.
+ *
+ *  @param[in,out]  pValue          pointer to the shared value
+ *  @param[in]      expected        the value expected
+ *  @param[in]      desired         the value to write
+ *
+ *  @retval         TRUE            value was exchanged
+ *  @retval         FALSE           value did not hold expected, nothing written
+ */
+
+EXT_DECL BOOL8 vos_atomicCompareExchange32 (
+    volatile UINT32 *pValue,
+    UINT32          expected,
+    UINT32          desired)
+{
+    return (__atomic_compare_exchange_n(pValue, &expected, desired, FALSE, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE) ? TRUE : FALSE);
+}
+
+/**********************************************************************************************************************/
+/** Full memory barrier.
+ *  No read or write of the calling thread is reordered across the call.
+ */
+
+EXT_DECL void vos_atomicFence (void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
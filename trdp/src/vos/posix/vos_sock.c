@@ -17,6 +17,9 @@
 /*
 * $Id$
 *
+*      AG 2026-10-18: vos_sockOpenTimer() etc. using timerfd (Linux only)
+*      AG 2026-10-18: vos_sockOpenEvent() etc. using eventfd or a pipe
+*      AG 2026-10-18: vos_sockSendTCPv() using sendmsg(), optional MSG_ZEROCOPY with completion tracking
 *     AHW 2023-01-10: Ticket #406 Socket handling: check for EAGAIN missing for Linux/Posix
 *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
 *      SB 2021-08-09: Lint warnings
@@ -62,13 +65,14 @@
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 
-#ifdef INTEGRITY
-#   include <sys/uio.h>
-#endif
+#include <sys/uio.h>
 
 #ifdef __linux
 #   include <net/if.h>
 #   include <byteswap.h>
+#   include <linux/errqueue.h>
+#   include <sys/eventfd.h>
+#   include <sys/timerfd.h>
 #   include <linux/if_vlan.h>
 #   include <linux/sockios.h>
 #else
@@ -1786,6 +1790,488 @@ EXT_DECL VOS_ERR_T vos_sockReceiveTCP (
     }
 }
 
+/**********************************************************************************************************************/
+/** Send TCP data from several buffers (gather write).
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pIov            array of buffer descriptors
+ *  @param[in]      iovCnt          number of buffer descriptors (max. VOS_MAX_IOVEC_CNT)
+ *  @param[in,out]  pSize           In: ignored, Out: no of bytes sent
+ *  @param[in,out]  pZeroCopyId     NULL for a standard send, else counter of zero-copy send operations,
+ *                                  the first buffer is copied nevertheless
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    VOS_SOCK_T          sock,
+    const VOS_IOVEC_T   *pIov,
+    UINT32              iovCnt,
+    UINT32              *pSize,
+    UINT32              *pZeroCopyId)
+{
+    struct iovec    iov[VOS_MAX_IOVEC_CNT];
+    struct msghdr   msg;
+    ssize_t         sendSize    = 0;
+    size_t          bufferSize  = 0;
+    UINT32          first       = 0u;
+    UINT32          i;
+    int             flags       = 0;
+    int             zcFlags     = 0;
+
+    if (sock == -1 || pIov == NULL || pSize == NULL || iovCnt == 0u || iovCnt > VOS_MAX_IOVEC_CNT)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+#if defined(MSG_ZEROCOPY) && defined(MSG_MORE)
+    if (pZeroCopyId != NULL)
+    {
+        zcFlags = MSG_ZEROCOPY;
+    }
+#endif
+
+    for (i = 0u; i < iovCnt; i++)
+    {
+        iov[i].iov_base = (void *) pIov[i].pBuffer;
+        iov[i].iov_len  = (size_t) pIov[i].size;
+        bufferSize     += (size_t) pIov[i].size;
+    }
+    *pSize = 0;
+
+    /* Keep on sending until we got rid of all data or we received an unrecoverable error */
+    do
+    {
+        /* skip buffers already sent completely */
+        while ((first < iovCnt) && (iov[first].iov_len == 0u))
+        {
+            first++;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov     = &iov[first];
+        msg.msg_iovlen  = iovCnt - first;
+        flags           = zcFlags;
+
+#if defined(MSG_ZEROCOPY) && defined(MSG_MORE)
+        if ((zcFlags != 0) && (first == 0u) && (iovCnt > 1u))
+        {
+            /* MSG_ZEROCOPY pins all buffers of a send: the first one (a header) is copied, more data follows */
+            msg.msg_iovlen  = 1u;
+            flags           = MSG_MORE;
+        }
+#endif
+
+        sendSize = sendmsg(sock, &msg, flags);
+        if (sendSize > 0)
+        {
+            size_t done = (size_t) sendSize;
+
+            bufferSize  -= done;
+            *pSize      += (UINT32) sendSize;
+
+            if ((zcFlags != 0) && (flags == zcFlags))
+            {
+                (*pZeroCopyId)++;
+            }
+
+            /* advance the vector behind the data sent */
+            while ((first < iovCnt) && (done >= iov[first].iov_len))
+            {
+                done -= iov[first].iov_len;
+                iov[first].iov_len = 0u;
+                first++;
+            }
+            if (first < iovCnt)
+            {
+                iov[first].iov_base = (UINT8 *) iov[first].iov_base + done;
+                iov[first].iov_len -= done;
+            }
+        }
+        else if ((sendSize == -1) && ((errno == EWOULDBLOCK) || (errno == EAGAIN)))
+        {
+            return VOS_BLOCK_ERR;
+        }
+        else if ((sendSize == -1) && (errno == ENOBUFS) && (zcFlags != 0) && (flags == zcFlags))
+        {
+            /* out of option memory for pinned pages - fall back to a copying send */
+            zcFlags     = 0;
+            sendSize    = 0;
+        }
+    }
+    while (bufferSize && !(sendSize == -1 && errno != EINTR));
+
+    if (sendSize == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_WARNING, "sendmsg() failed (Err: %s)\n", buff);
+
+        if ((errno == ENOTCONN)
+            || (errno == ECONNREFUSED)
+            || (errno == EHOSTUNREACH))
+        {
+            return VOS_NOCONN_ERR;
+        }
+        else
+        {
+            return VOS_IO_ERR;
+        }
+    }
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Enable zero-copy transmission on a TCP socket.
+ *
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown
+ *  @retval         VOS_SOCK_ERR    zero-copy is not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetZeroCopy (
+    VOS_SOCK_T sock)
+{
+    if (sock == -1)
+    {
+        return VOS_PARAM_ERR;
+    }
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    {
+        int one = 1;
+
+        if (setsockopt(sock, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == -1)
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_INFO, "setsockopt() SO_ZEROCOPY failed (Err: %s)\n", buff);
+            return VOS_SOCK_ERR;
+        }
+    }
+    return VOS_NO_ERR;
+#else
+    return VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Collect zero-copy completions of a TCP socket.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pFirstId        id of the first completed zero-copy send operation
+ *  @param[out]     pLastId         id of the last completed zero-copy send operation
+ *
+ *  @retval         VOS_NO_ERR      a range of completions was read
+ *  @retval         VOS_NODATA_ERR  no new completions
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      the error queue could not be read
+ *  @retval         VOS_SOCK_ERR    zero-copy is not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockZeroCopyDone (
+    VOS_SOCK_T  sock,
+    UINT32      *pFirstId,
+    UINT32      *pLastId)
+{
+    if (sock == -1 || pFirstId == NULL || pLastId == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+#if defined(SO_EE_ORIGIN_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    {
+        UINT8 control[CMSG_SPACE(sizeof(struct sock_extended_err)) + 64u];
+
+        for (;; )
+        {
+            struct msghdr   msg;
+            struct cmsghdr  *pCmsg;
+
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_control     = control;
+            msg.msg_controllen  = sizeof(control);
+
+            if (recvmsg(sock, &msg, MSG_ERRQUEUE) == -1)
+            {
+                if ((errno == EWOULDBLOCK) || (errno == EAGAIN) || (errno == EINTR))
+                {
+                    return VOS_NODATA_ERR;
+                }
+                return VOS_IO_ERR;
+            }
+
+            for (pCmsg = CMSG_FIRSTHDR(&msg); pCmsg != NULL; pCmsg = CMSG_NXTHDR(&msg, pCmsg))
+            {
+                const struct sock_extended_err *pErr = (const struct sock_extended_err *) CMSG_DATA(pCmsg);
+
+                /* Each notification carries one range [ee_info...ee_data] of completed sends */
+                if ((pErr->ee_errno == 0) && (pErr->ee_origin == SO_EE_ORIGIN_ZEROCOPY))
+                {
+                    *pFirstId   = pErr->ee_info;
+                    *pLastId    = pErr->ee_data;
+                    return VOS_NO_ERR;
+                }
+            }
+            /* not a zero-copy notification, read the next one */
+        }
+    }
+#else
+    return VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Create a wake-up event.
+ *  Linux uses an eventfd, other targets a non-blocking pipe.
+ *
+ *  @param[out]     pEvent          pointer to the event to initialise
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    no descriptor available
+ */
+
+EXT_DECL VOS_ERR_T vos_sockOpenEvent (
+    VOS_SOCK_EVENT_T *pEvent)
+{
+    if (pEvent == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+#ifdef __linux
+    pEvent->rdSock = eventfd(0u, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (pEvent->rdSock == VOS_INVALID_SOCKET)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "eventfd() failed (Err: %s)\n", buff);
+        pEvent->wrSock = VOS_INVALID_SOCKET;
+        return VOS_SOCK_ERR;
+    }
+    pEvent->wrSock = pEvent->rdSock;
+#else
+    {
+        int fds[2];
+
+        if (pipe(fds) == -1)
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_ERROR, "pipe() failed (Err: %s)\n", buff);
+            pEvent->rdSock = VOS_INVALID_SOCKET;
+            pEvent->wrSock = VOS_INVALID_SOCKET;
+            return VOS_SOCK_ERR;
+        }
+        (void) fcntl(fds[0], F_SETFL, O_NONBLOCK);
+        (void) fcntl(fds[1], F_SETFL, O_NONBLOCK);
+        pEvent->rdSock  = fds[0];
+        pEvent->wrSock  = fds[1];
+    }
+#endif
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Release a wake-up event.
+ *
+ *  @param[in,out]  pEvent          pointer to the event, its descriptors are invalid afterwards
+ */
+
+EXT_DECL void vos_sockCloseEvent (
+    VOS_SOCK_EVENT_T *pEvent)
+{
+    if (pEvent == NULL)
+    {
+        return;
+    }
+    if ((pEvent->wrSock != VOS_INVALID_SOCKET) && (pEvent->wrSock != pEvent->rdSock))
+    {
+        (void) close(pEvent->wrSock);
+    }
+    if (pEvent->rdSock != VOS_INVALID_SOCKET)
+    {
+        (void) close(pEvent->rdSock);
+    }
+    pEvent->rdSock  = VOS_INVALID_SOCKET;
+    pEvent->wrSock  = VOS_INVALID_SOCKET;
+}
+
+/**********************************************************************************************************************/
+/** Signal a wake-up event.
+ *
+ *  @param[in]      pEvent          pointer to the event
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSignalEvent (
+    const VOS_SOCK_EVENT_T *pEvent)
+{
+#ifdef __linux
+    UINT64 count = 1u;
+#else
+    UINT8 count = 1u;
+#endif
+
+    if ((pEvent == NULL) || (pEvent->wrSock == VOS_INVALID_SOCKET))
+    {
+        return VOS_PARAM_ERR;
+    }
+    /* A full pipe or counter is signalled anyway */
+    (void) write(pEvent->wrSock, &count, sizeof(count));
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Reset a wake-up event to non-signalled.
+ *
+ *  @param[in]      pEvent          pointer to the event
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_sockClearEvent (
+    const VOS_SOCK_EVENT_T *pEvent)
+{
+    UINT8 buffer[64];
+
+    if ((pEvent == NULL) || (pEvent->rdSock == VOS_INVALID_SOCKET))
+    {
+        return VOS_PARAM_ERR;
+    }
+    /* eventfd: one read resets the counter, pipe: drain it */
+    while (read(pEvent->rdSock, buffer, sizeof(buffer)) > 0)
+    {
+        ;
+    }
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Create a deadline timer.
+ *  Linux uses a timerfd on CLOCK_MONOTONIC, the clock of vos_getTime(). Not supported by other targets.
+ *
+ *  @param[out]     pTimer          pointer to the timer to initialise, disarmed
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    timers are not supported by the target or no descriptor available
+ */
+
+EXT_DECL VOS_ERR_T vos_sockOpenTimer (
+    VOS_SOCK_TIMER_T *pTimer)
+{
+    if (pTimer == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+#if defined(__linux) && defined(CLOCK_MONOTONIC)
+    pTimer->sock = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (pTimer->sock == VOS_INVALID_SOCKET)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "timerfd_create() failed (Err: %s)\n", buff);
+        return VOS_SOCK_ERR;
+    }
+    return VOS_NO_ERR;
+#else
+    pTimer->sock = VOS_INVALID_SOCKET;
+    return VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Release a deadline timer.
+ *
+ *  @param[in,out]  pTimer          pointer to the timer, its descriptor is invalid afterwards
+ */
+
+EXT_DECL void vos_sockCloseTimer (
+    VOS_SOCK_TIMER_T *pTimer)
+{
+    if ((pTimer == NULL) || (pTimer->sock == VOS_INVALID_SOCKET))
+    {
+        return;
+    }
+    (void) close(pTimer->sock);
+    pTimer->sock = VOS_INVALID_SOCKET;
+}
+
+/**********************************************************************************************************************/
+/** Arm a deadline timer.
+ *  A deadline which has already passed makes the timer readable at once.
+ *
+ *  @param[in]      pTimer          pointer to the timer
+ *  @param[in]      pDeadline       absolute time (vos_getTime() clock), NULL or zero to disarm the timer
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    timer could not be set
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetTimer (
+    const VOS_SOCK_TIMER_T  *pTimer,
+    const VOS_TIMEVAL_T     *pDeadline)
+{
+#if defined(__linux) && defined(CLOCK_MONOTONIC)
+    struct itimerspec spec;
+
+    if ((pTimer == NULL) || (pTimer->sock == VOS_INVALID_SOCKET))
+    {
+        return VOS_PARAM_ERR;
+    }
+    memset(&spec, 0, sizeof(spec));
+    if ((pDeadline != NULL) && timerisset(pDeadline))
+    {
+        spec.it_value.tv_sec    = pDeadline->tv_sec;
+        spec.it_value.tv_nsec   = (long) pDeadline->tv_usec * 1000;
+    }
+    /* a new deadline replaces an expiry not yet cleared */
+    if (timerfd_settime(pTimer->sock, TFD_TIMER_ABSTIME, &spec, NULL) == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "timerfd_settime() failed (Err: %s)\n", buff);
+        return VOS_SOCK_ERR;
+    }
+    return VOS_NO_ERR;
+#else
+    (void) pDeadline;
+    return (pTimer == NULL) ? VOS_PARAM_ERR : VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Reset an expired deadline timer to non-readable.
+ *
+ *  @param[in]      pTimer          pointer to the timer
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_sockClearTimer (
+    const VOS_SOCK_TIMER_T *pTimer)
+{
+    UINT64 expirations;
+
+    if ((pTimer == NULL) || (pTimer->sock == VOS_INVALID_SOCKET))
+    {
+        return VOS_PARAM_ERR;
+    }
+    /* one read resets the expiration count */
+    (void) read(pTimer->sock, &expirations, sizeof(expirations));
+    return VOS_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Set Using Multicast I/F
  *
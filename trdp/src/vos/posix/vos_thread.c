@@ -19,6 +19,9 @@
  *
  * $Id$
  *
+ *      AG 2026-10-18: vos_atomicCompareExchange32()/vos_atomicFence()
+ *      AG 2026-10-18: Cyclic threads sleep until absolute release times, overrun policy and timing statistics
+ *      AG 2026-10-18: vos_atomicLoad32()/vos_atomicStore32()
  *     AHW 2023-01-10: Ticket #405 Problem with GLIBC > 2.34
  *     CEW 2023-01-09: Ticket #408: thread-safe localtime - but be aware of static pTimeString
  *      CK 2023-01-03: Ticket #403: Mutexes now honour PTHREAD_PRIO_INHERIT protocol
@@ -267,21 +270,171 @@ static int clock_nanosleep (
 #define MSECS_PER_SEC   1000u
 #define NSECS_PER_SEC   1000000000ull
 
-/* This define holds the max amount os seconds to get stored in 32bit holding micro seconds        */
-/* It is the result when using the common time struct with tv_sec and tv_usec as on a 32 bit value */
-/* so far 0..999999 gets used for the tv_usec field as per definition, then 0xFFF0BDC0 usec        */
-/* are remaining to represent the seconds, which in turn give 0x10C5 seconds or in decimal 4293    */
-#define MAXSEC_FOR_USECPRESENTATION  4293
+/** Maximum number of missed releases a thread with VOS_THREAD_OVERRUN_CATCHUP policy makes up for */
+#ifndef VOS_THREAD_MAX_CATCHUP
+#define VOS_THREAD_MAX_CATCHUP  8u
+#endif
 
 typedef struct VOS_THREAD_CYC
 {
-    const CHAR8         *pName;
-    VOS_TIMEVAL_T       startTime;
-    UINT32              interval;
-    VOS_THREAD_FUNC_T   pFunction;
-    void                *pArguments;
+    struct VOS_THREAD_CYC   *pNext;
+    pthread_t               thread;
+    CHAR8                   name[16];
+    VOS_TIMEVAL_T           startTime;
+    UINT32                  interval;
+    VOS_THREAD_FUNC_T       pFunction;
+    void                    *pArguments;
+    VOS_THREAD_OVERRUN_T    policy;
+    VOS_THREAD_CYC_STATS_T  stats;
 } VOS_THREAD_CYC_T;
 
+/* The parameters of the cyclic threads stay allocated while the thread runs, they hold its statistics.
+   The list and the statistics are guarded by one mutex, it is locked once per cycle for a few instructions.  */
+static VOS_THREAD_CYC_T *sCyclicThreads     = NULL;
+static pthread_mutex_t  sCyclicMutex;
+static BOOL8            sCyclicMutexInit    = FALSE;
+
+/**********************************************************************************************************************/
+/** Return the current time of the monotonic clock in ns.
+ *
+ *  @retval         time in ns
+ */
+static UINT64 vos_monotonicNs (void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (UINT64) now.tv_sec * NSECS_PER_SEC + (UINT64) now.tv_nsec;
+}
+
+/**********************************************************************************************************************/
+/** Enter a time into a histogram of the cyclic thread statistics.
+ *
+ *  @param[in,out]  pHist           Histogram with VOS_THREAD_HIST_BUCKETS buckets
+ *  @param[in]      timeUs          Time in us
+ */
+static void vos_cyclicHistAdd (
+    UINT32  *pHist,
+    UINT32  timeUs)
+{
+    UINT32 bucket = 0u;
+
+    while ((timeUs != 0u) && (bucket < (VOS_THREAD_HIST_BUCKETS - 1u)))
+    {
+        timeUs >>= 1u;
+        bucket++;
+    }
+    pHist[bucket]++;
+}
+
+/**********************************************************************************************************************/
+/** Clear the statistics of a cyclic thread, the mutex must be held.
+ *
+ *  @param[in,out]  pCyc            Parameters of the cyclic thread
+ */
+static void vos_cyclicStatsClear (
+    VOS_THREAD_CYC_T *pCyc)
+{
+    memset(&pCyc->stats, 0, sizeof(pCyc->stats));
+    pCyc->stats.interval    = pCyc->interval;
+    pCyc->stats.latencyMin  = UINT32_MAX;
+    pCyc->stats.execMin     = UINT32_MAX;
+}
+
+/**********************************************************************************************************************/
+/** Account one call of a cyclic thread function.
+ *
+ *  @param[in,out]  pCyc            Parameters of the cyclic thread
+ *  @param[in]      latencyNs       Delay between release time and call
+ *  @param[in]      execNs          Execution time of the function
+ *  @param[in]      missed          Number of releases passed during the call
+ *  @param[out]     pPolicy         Overrun policy to apply
+ */
+static void vos_cyclicStatsUpdate (
+    VOS_THREAD_CYC_T        *pCyc,
+    UINT64                  latencyNs,
+    UINT64                  execNs,
+    UINT32                  missed,
+    VOS_THREAD_OVERRUN_T    *pPolicy)
+{
+    UINT32  latency = (latencyNs / NSECS_PER_USEC > UINT32_MAX) ? UINT32_MAX : (UINT32) (latencyNs / NSECS_PER_USEC);
+    UINT32  exec    = (execNs / NSECS_PER_USEC > UINT32_MAX) ? UINT32_MAX : (UINT32) (execNs / NSECS_PER_USEC);
+
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    pCyc->stats.cycles++;
+    if (missed > 0u)
+    {
+        pCyc->stats.overruns++;
+    }
+    if (latency < pCyc->stats.latencyMin)
+    {
+        pCyc->stats.latencyMin = latency;
+    }
+    if (latency > pCyc->stats.latencyMax)
+    {
+        pCyc->stats.latencyMax = latency;
+    }
+    if (exec < pCyc->stats.execMin)
+    {
+        pCyc->stats.execMin = exec;
+    }
+    if (exec > pCyc->stats.execMax)
+    {
+        pCyc->stats.execMax = exec;
+    }
+    vos_cyclicHistAdd(pCyc->stats.latencyHist, latency);
+    vos_cyclicHistAdd(pCyc->stats.execHist, exec);
+    *pPolicy = pCyc->policy;
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+}
+
+/**********************************************************************************************************************/
+/** Unlink and free the parameters of a cyclic thread, called when the thread is cancelled.
+ *
+ *  @param[in]      pArg            Parameters of the cyclic thread
+ */
+static void vos_cyclicThreadCleanup (
+    void *pArg)
+{
+    VOS_THREAD_CYC_T    *pCyc = (VOS_THREAD_CYC_T *) pArg;
+    VOS_THREAD_CYC_T    **ppIter;
+
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    for (ppIter = &sCyclicThreads; *ppIter != NULL; ppIter = &(*ppIter)->pNext)
+    {
+        if (*ppIter == pCyc)
+        {
+            *ppIter = pCyc->pNext;
+            break;
+        }
+    }
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+    vos_printLog(VOS_LOG_DBG, "thread parameters freed: %p\n", (void *) pCyc);
+    vos_memFree(pCyc);
+}
+
+/**********************************************************************************************************************/
+/** Find the parameters of a cyclic thread, the mutex must be held.
+ *
+ *  @param[in]      thread          Thread handle
+ *
+ *  @retval         pointer to the parameters or NULL
+ */
+static VOS_THREAD_CYC_T *vos_cyclicFind (
+    VOS_THREAD_T thread)
+{
+    VOS_THREAD_CYC_T *pCyc;
+
+    for (pCyc = sCyclicThreads; pCyc != NULL; pCyc = pCyc->pNext)
+    {
+        if (pthread_equal(pCyc->thread, (pthread_t) thread))
+        {
+            break;
+        }
+    }
+    return pCyc;
+}
+
 /**********************************************************************************************************************/
 /** Execute a cyclic thread function.
  *  This function blocks by cyclically executing the provided user function. If supported by the OS,
@@ -296,22 +449,18 @@ typedef struct VOS_THREAD_CYC
 static void *vos_runCyclicThread_EDF (
     void *pParameters)
 {
-    struct timespec     wakeup, starttime;
-    struct timespec     now;
-    UINT64              interval    = ((VOS_THREAD_CYC_T *)pParameters)->interval * NSECS_PER_USEC;
-    VOS_THREAD_FUNC_T   pFunction   = ((VOS_THREAD_CYC_T *)pParameters)->pFunction;
-    void *              pArguments  = ((VOS_THREAD_CYC_T *)pParameters)->pArguments;
-    VOS_TIMEVAL_T       wakeup_us   = ((VOS_THREAD_CYC_T *)pParameters)->startTime;
-    CHAR8               name[16];
+    VOS_THREAD_CYC_T    *pCyc       = (VOS_THREAD_CYC_T *)pParameters;
+    struct timespec     wakeup;
+    UINT64              interval    = (UINT64) pCyc->interval * NSECS_PER_USEC;
+    VOS_THREAD_FUNC_T   pFunction   = pCyc->pFunction;
+    void *              pArguments  = pCyc->pArguments;
+    VOS_TIMEVAL_T       wakeup_us   = pCyc->startTime;
+    const CHAR8         *name       = pCyc->name;
+    UINT64              starttime;
     UINT64              runtime;
-#ifdef DEBUG
-    UINT64              max = 0, min = interval;
-#endif
+    VOS_THREAD_OVERRUN_T policy;
 
-    vos_strncpy(name, ((VOS_THREAD_CYC_T *)pParameters)->pName, 16);      /* for logging */
-
-    vos_printLog(VOS_LOG_DBG, "thread parameters freed: %p\n", pParameters);
-    vos_memFree(pParameters);
+    pthread_cleanup_push(vos_cyclicThreadCleanup, pCyc);
 
     /* Cyclic tasks are real-time tasks (RTLinux only) */
     {
@@ -335,7 +484,7 @@ static void *vos_runCyclicThread_EDF (
                          name,
                          (int)rt_attribs.sched_policy,
                          buff);
-            return (void *)VOS_THREAD_ERR;
+            pthread_exit((void *)VOS_THREAD_ERR);
         }
     }
 
@@ -354,114 +503,129 @@ static void *vos_runCyclicThread_EDF (
         }
     }
 
+    /* The kernel releases the thread, only the execution times are recorded, the latency stays 0 */
     for (;; )
     {
-        clock_gettime(CLOCK_MONOTONIC, &starttime);
+        starttime = vos_monotonicNs();
 
         pFunction(pArguments);
 
-        clock_gettime(CLOCK_MONOTONIC, &now);
-        runtime = (now.tv_sec - starttime.tv_sec) * NSECS_PER_SEC + (now.tv_nsec - starttime.tv_nsec);
+        runtime = vos_monotonicNs() - starttime;
+        vos_cyclicStatsUpdate(pCyc, 0u, runtime, (runtime > interval) ? 1u : 0u, &policy);
         if (runtime > interval) {
             vos_printLog(VOS_LOG_WARNING,
                          "[t:%s] intv=%llu ms --> ~%llu ns.\n",
                          name, interval/1000000ull, (unsigned long long)runtime);
         }
-#ifdef DEBUG
-        /* help seeking WCET */
-        if (runtime < min) min = runtime;
-        if (runtime > max) max = runtime;
-        if ((now.tv_nsec-wakeup.tv_nsec) >= 0 
-            && ((now.tv_nsec-wakeup.tv_nsec) < interval) 
-            && ((now.tv_sec-wakeup.tv_sec) % 10) == 0) {
-            vos_printLog(VOS_LOG_INFO,
-                         "[t:%s] intv=%llu ms needed %llu..%llu ns.\n",
-                         name, interval/1000000ull, min, max);
-            min = interval;
-            max = 0;
-        }
-#endif
         pthread_testcancel();
         sched_yield(); /* let the schduler handle the timing */
     }
+    pthread_cleanup_pop(1);
     return NULL;
 }
 #endif
 
+/**********************************************************************************************************************/
+/** Execute a cyclic thread function.
+ *  The function is called on a fixed grid of release times, startTime + n * interval, on the monotonic clock. The
+ *  thread sleeps until the absolute release time, so neither the execution time nor a late wakeup shift the grid.
+ *  Releases which pass while the function is still running are handled according to the overrun policy.
+ *
+ *  @param[in]      data            Pointer to the thread parameters
+ *
+ *  @retval         none
+ */
 static void *vos_runCyclicThread (
     void *data)
 {
-    VOS_THREAD_CYC_T   *pParameters = (VOS_THREAD_CYC_T *)data;
-    VOS_TIMEVAL_T       now;
-    VOS_TIMEVAL_T       priorCall;
-    VOS_TIMEVAL_T       afterCall;
-    UINT32              execTime;
-    UINT32              waitingTime;
-    UINT32              interval    = pParameters->interval;
-    VOS_THREAD_FUNC_T   pFunction   = pParameters->pFunction;
-    void *              pArguments  = pParameters->pArguments;
-    VOS_TIMEVAL_T       startTime   = pParameters->startTime;
-    CHAR8               name[16];
-
-    vos_strncpy(name, pParameters->pName, 16);      /* for logging */
-
-    vos_printLog(VOS_LOG_DBG, "thread parameters freed: %p\n", (void *) pParameters);
-    vos_memFree(pParameters);
+    VOS_THREAD_CYC_T    *pCyc       = (VOS_THREAD_CYC_T *)data;
+    UINT64              interval    = (UINT64) pCyc->interval * NSECS_PER_USEC;
+    UINT64              start       = (UINT64) pCyc->startTime.tv_sec * NSECS_PER_SEC +
+                                      (UINT64) pCyc->startTime.tv_usec * NSECS_PER_USEC;
+    VOS_THREAD_FUNC_T   pFunction   = pCyc->pFunction;
+    void *              pArguments  = pCyc->pArguments;
+    UINT64              release;
+    UINT64              priorCall;
+    UINT64              afterCall;
+    UINT64              latency;
+    UINT32              missed;
+    UINT32              dropped;
+    BOOL8               late        = FALSE;
+    VOS_THREAD_OVERRUN_T policy;
+    struct timespec     wakeup;
+
+    pthread_cleanup_push(vos_cyclicThreadCleanup, pCyc);
+
+    /* The first release is the next multiple of interval after start (start 0 aligns all threads of an interval) */
+    release = vos_monotonicNs();
+    if (release <= start)
+    {
+        release = start;
+    }
+    else
+    {
+        release = start + ((release - start) / interval + 1u) * interval;
+    }
 
     for (;; )
     {
-        /* Synchronize with starttime */
-        vos_getTime(&now);                      /* get initial time */
-        vos_subTime(&now, &startTime);
-
-        /* Wait for multiples of interval */
-
-        execTime    = ((UINT32)now.tv_usec % interval);
-        waitingTime = interval - execTime;
-        if (waitingTime > interval)
+        /* Idle until the release time, clock_nanosleep is a cancellation point */
+        wakeup.tv_sec   = (time_t) (release / NSECS_PER_SEC);
+        wakeup.tv_nsec  = (long) (release % NSECS_PER_SEC);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeup, NULL) == EINTR)
         {
-            vos_printLog(VOS_LOG_ERROR,
-                         "waiting time > interval:  %u > %u usec!\n",
-                         (unsigned int) waitingTime, (unsigned int) interval);
+            ;
         }
 
-        /* Idle for the difference */
-        (void) vos_threadDelay(waitingTime);
+        priorCall = vos_monotonicNs();
+        pFunction(pArguments);      /* perform thread function */
+        afterCall = vos_monotonicNs();
+        latency   = (priorCall > release) ? (priorCall - release) : 0u;
 
-        vos_getTime(&priorCall);  /* get initial time */
-        pFunction(pArguments);    /* perform thread function */
-        vos_getTime(&afterCall);  /* get time after function ghas returned */
+        /* Releases passed during the call (including the one at the very end) */
+        release += interval;
+        missed  = (afterCall < release) ? 0u : (UINT32) ((afterCall - release) / interval + 1u);
 
-        /* subtract in the pattern after - prior to get the runtime of function() */
-        vos_subTime(&afterCall, &priorCall);
+        vos_cyclicStatsUpdate(pCyc, latency, afterCall - priorCall, missed, &policy);
 
-        /* afterCall holds now the time difference within a structure not compatible with interval */
-        /* check if UINT32 fits to hold the waiting time value */
-        if (afterCall.tv_sec <= MAXSEC_FOR_USECPRESENTATION)
+        if (missed > 0u)
         {
-            /*           sec to usec conversion value normalized from 0 .. 999999*/
-            execTime =
-                ((UINT32) ((UINT32)afterCall.tv_sec * MSECS_PER_SEC * USECS_PER_MSEC) + (UINT32)afterCall.tv_usec);
-            if (execTime > interval)
+            if (policy == VOS_THREAD_OVERRUN_CATCHUP)
+            {
+                /* The pending releases follow without sleeping, only the oldest beyond the limit are dropped */
+                dropped = (missed > VOS_THREAD_MAX_CATCHUP) ? (missed - VOS_THREAD_MAX_CATCHUP) : 0u;
+                release += (UINT64) dropped * interval;
+            }
+            else if (policy == VOS_THREAD_OVERRUN_RESYNC)
+            {
+                dropped = missed;
+                release = afterCall + interval;
+            }
+            else
+            {
+                dropped = missed;
+                release += (UINT64) missed * interval;
+            }
+            if (dropped > 0u)
+            {
+                (void) pthread_mutex_lock(&sCyclicMutex);
+                pCyc->stats.skipped += dropped;
+                (void) pthread_mutex_unlock(&sCyclicMutex);
+            }
+            if (late == FALSE)
             {
-                /*  Log the runtime violation */
+                /*  Log the violation once, not for every call catching up */
                 vos_printLog(VOS_LOG_WARNING,
-                             "cyclic thread with interval %u usec was running  %u usec\n",
-                             (unsigned int)interval, (unsigned int)execTime);
+                             "cyclic thread %s (%u usec) missed %u release(s): called %llu usec late, running %llu usec\n",
+                             pCyc->name, (unsigned int) pCyc->interval, (unsigned int) missed,
+                             (unsigned long long) (latency / NSECS_PER_USEC),
+                             (unsigned long long) ((afterCall - priorCall) / NSECS_PER_USEC));
             }
         }
-        else
-        {
-            /* seems a very critical overflow has happened - or simply a misconfiguration */
-            /* as a rough first guess use zero waiting time here */
-            /* waitingTime = 0U; */
-            /* Have this value range violation logged */
-            vos_printLog(VOS_LOG_ERROR,
-                         "cyclic thread with interval %u usec exceeded time out by running %ld sec\n",
-                         (unsigned int)interval, (long)afterCall.tv_sec);
-        }
+        late = (missed > 0u) && (policy == VOS_THREAD_OVERRUN_CATCHUP);
         pthread_testcancel();
     }
+    pthread_cleanup_pop(1);
     return NULL;
 }
 
@@ -480,6 +644,20 @@ static void *vos_runCyclicThread (
 EXT_DECL VOS_ERR_T vos_threadInit (
     void)
 {
+    if (sCyclicMutexInit == FALSE)
+    {
+        pthread_mutexattr_t attr;
+
+        /* Cyclic threads of high priority lock it, honour the priority inheritance as vos_mutexCreate() does */
+        if ((pthread_mutexattr_init(&attr) != 0) ||
+            (pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT) != 0) ||
+            (pthread_mutex_init(&sCyclicMutex, &attr) != 0))
+        {
+            return VOS_INIT_ERR;
+        }
+        (void) pthread_mutexattr_destroy(&attr);
+        sCyclicMutexInit = TRUE;
+    }
     vosThreadInitialised = TRUE;
 
     return VOS_NO_ERR;
@@ -645,22 +823,30 @@ EXT_DECL VOS_ERR_T vos_threadCreateSync (
     }
     if (interval > 0u)
     {
-        /* malloc freed in vos_runCyclicThread */
+        /* freed by the cyclic thread when it is cancelled */
         VOS_THREAD_CYC_T *p_params = (VOS_THREAD_CYC_T *) vos_memAlloc(sizeof(VOS_THREAD_CYC_T));
 
-        p_params->pName = pName;
+        if (p_params == NULL)
+        {
+            (void) pthread_attr_destroy(&threadAttrib);
+            return VOS_MEM_ERR;
+        }
+        vos_strncpy(p_params->name, pName, sizeof(p_params->name) - 1u);      /* for logging */
         p_params->startTime.tv_sec  = 0;
         p_params->startTime.tv_usec = 0;
         p_params->interval      = interval;
         p_params->pFunction     = pFunction;
         p_params->pArguments    = pArguments;
+        p_params->policy        = VOS_THREAD_OVERRUN_SKIP;
+        vos_cyclicStatsClear(p_params);
         vos_printLog(VOS_LOG_DBG, "thread parameters alloc: %p\n", (void *) p_params);
 
         if (pStartTime != NULL)
         {
             p_params->startTime = *pStartTime;
         }
-        /* Create a cyclic thread */
+        /* Create a cyclic thread, it is entered into the list before it can run into its cleanup handler */
+        (void) pthread_mutex_lock(&sCyclicMutex);
         retCode = pthread_create(&hThread, &threadAttrib, 
 #if defined(SCHED_DEADLINE) && defined (RT_THREADS)
             vos_runCyclicThread_EDF,
@@ -668,7 +854,17 @@ EXT_DECL VOS_ERR_T vos_threadCreateSync (
             vos_runCyclicThread,
 #endif
             p_params);
-        (void) vos_threadDelay(10000u);
+        if (retCode == 0)
+        {
+            p_params->thread    = hThread;
+            p_params->pNext     = sCyclicThreads;
+            sCyclicThreads      = p_params;
+        }
+        (void) pthread_mutex_unlock(&sCyclicMutex);
+        if (retCode != 0)
+        {
+            vos_memFree(p_params);
+        }
     }
     else
     {
@@ -788,6 +984,105 @@ EXT_DECL VOS_ERR_T vos_threadIsActive (
     return (retValue == 0 ? VOS_NO_ERR : VOS_PARAM_ERR);
 }
 
+/**********************************************************************************************************************/
+/** Set the overrun policy of a cyclic thread.
+ *  The policy decides what happens to the releases a thread missed because its function ran longer than the
+ *  interval. It takes effect with the next overrun.
+ *
+ *  @param[in]      thread          Handle of a thread created with an interval
+ *  @param[in]      policy          Skip, catch up or resynchronise
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    module not initialised
+ *  @retval         VOS_NOINIT_ERR  not a cyclic thread
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetOverrunPolicy (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_OVERRUN_T    policy)
+{
+    VOS_THREAD_CYC_T    *pCyc;
+    VOS_ERR_T           err = VOS_NO_ERR;
+
+    if (!vosThreadInitialised)
+    {
+        return VOS_INIT_ERR;
+    }
+    if ((thread == NULL) || (policy > VOS_THREAD_OVERRUN_RESYNC))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    pCyc = vos_cyclicFind(thread);
+    if (pCyc == NULL)
+    {
+        err = VOS_NOINIT_ERR;
+    }
+    else
+    {
+        pCyc->policy = policy;
+    }
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread.
+ *  The wakeup latency is the delay between the release time and the call of the thread function, it includes the
+ *  time a thread catching up after an overrun is behind its grid.
+ *
+ *  @param[in]      thread          Handle of a thread created with an interval
+ *  @param[out]     pStats          Pointer to the statistics to fill
+ *  @param[in]      reset           Clear the statistics after reading them
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    module not initialised
+ *  @retval         VOS_NOINIT_ERR  not a cyclic thread
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetCyclicStats (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_CYC_STATS_T  *pStats,
+    BOOL8                   reset)
+{
+    VOS_THREAD_CYC_T    *pCyc;
+    VOS_ERR_T           err = VOS_NO_ERR;
+
+    if (!vosThreadInitialised)
+    {
+        return VOS_INIT_ERR;
+    }
+    if ((thread == NULL) || (pStats == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    pCyc = vos_cyclicFind(thread);
+    if (pCyc == NULL)
+    {
+        err = VOS_NOINIT_ERR;
+    }
+    else
+    {
+        *pStats = pCyc->stats;
+        if (reset == TRUE)
+        {
+            vos_cyclicStatsClear(pCyc);
+        }
+    }
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+
+    if ((err == VOS_NO_ERR) && (pStats->cycles == 0u))
+    {
+        /* no call yet, report the minima as 0 */
+        pStats->latencyMin  = 0u;
+        pStats->execMin     = 0u;
+    }
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Return thread handle of calling task
  *
@@ -1775,3 +2070,66 @@ EXT_DECL void vos_semaGive (
     return;
 }
 
+
+/**********************************************************************************************************************/
+/** Read a value shared between threads.
+ *  The read has acquire semantics: all writes of the thread, which stored the value with vos_atomicStore32(), are
+ *  visible after the call.
+ *
+ *  @param[in]      pValue          pointer to the shared value
+ *
+ *  @retval         the value read
+ */
+
+EXT_DECL UINT32 vos_atomicLoad32 (
+    const volatile UINT32 *pValue)
+{
+    return __atomic_load_n(pValue, __ATOMIC_ACQUIRE);
+}
+
+/**********************************************************************************************************************/
+/** Write a value shared between threads.
+ *  The write has release semantics: all preceding writes of the calling thread become visible to a thread reading
+ *  the value with vos_atomicLoad32().
+ *
+ *  @param[in]      pValue          pointer to the shared value
+ *  @param[in]      value           the value to write
+ */
+
+EXT_DECL void vos_atomicStore32 (
+    volatile UINT32 *pValue,
+    UINT32          value)
+{
+    __atomic_store_n(pValue, value, __ATOMIC_RELEASE);
+}
+
+/**********************************************************************************************************************/
+/** Compare and exchange a value shared between threads.
+ *  Writes desired to the value if it still holds expected. A successful exchange has acquire and release semantics.
+ *
+ *  @param[in,out]  pValue          pointer to the shared value
+ *  @param[in]      expected        the value expected
+ *  @param[in]      desired         the value to write
+ *
+ *  @retval         TRUE            value was exchanged
+ *  @retval         FALSE           value did not hold expected, nothing written
+ */
+
+EXT_DECL BOOL8 vos_atomicCompareExchange32 (
+    volatile UINT32 *pValue,
+    UINT32          expected,
+    UINT32          desired)
+{
+    return (__atomic_compare_exchange_n(pValue, &expected, desired, FALSE, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE) ? TRUE : FALSE);
+}
+
+/**********************************************************************************************************************/
+/** Full memory barrier.
+ *  No read or write of the calling thread is reordered across the call.
+ */
+
+EXT_DECL void vos_atomicFence (void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
@@ -17,6 +17,8 @@
  /*
  * $Id$
  *
+ *      AG 2026-10-18: vos_sockOpenTimer() etc. (not supported)
+ *      AG 2026-10-18: vos_sockOpenEvent() etc. (not supported)
  *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
  *      MM 2022-05-30: Ticket #326: fixed handling of destination (own) address on UDP receive
  *     AHW 2021-05-06: Ticket #322 Subscriber multicast message routing in multi-home device
@@ -1591,6 +1593,221 @@ EXT_DECL VOS_ERR_T vos_sockReceiveTCP (
     }
 }
 
+/**********************************************************************************************************************/
+/** Send TCP data from several buffers (gather write).
+ *  This target has no native gather write, the buffers are sent one after the other.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pIov            array of buffer descriptors
+ *  @param[in]      iovCnt          number of buffer descriptors (max. VOS_MAX_IOVEC_CNT)
+ *  @param[in,out]  pSize           In: ignored, Out: no of bytes sent
+ *  @param[in,out]  pZeroCopyId     not supported, left unchanged
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    VOS_SOCK_T          sock,
+    const VOS_IOVEC_T   *pIov,
+    UINT32              iovCnt,
+    UINT32              *pSize,
+    UINT32              *pZeroCopyId)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      i;
+
+    (void) pZeroCopyId;
+
+    if ((pIov == NULL) || (pSize == NULL) || (iovCnt == 0u) || (iovCnt > VOS_MAX_IOVEC_CNT))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pSize = 0u;
+
+    for (i = 0u; (i < iovCnt) && (err == VOS_NO_ERR); i++)
+    {
+        UINT32 size = pIov[i].size;
+
+        if (size > 0u)
+        {
+            err     = vos_sockSendTCP(sock, pIov[i].pBuffer, &size);
+            *pSize += size;
+        }
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Enable zero-copy transmission on a TCP socket.
+ *
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_SOCK_ERR    zero-copy is not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetZeroCopy (
+    VOS_SOCK_T sock)
+{
+    (void) sock;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Collect zero-copy completions of a TCP socket.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pFirstId        left unchanged
+ *  @param[out]     pLastId         left unchanged
+ *
+ *  @retval         VOS_SOCK_ERR    zero-copy is not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockZeroCopyDone (
+    VOS_SOCK_T  sock,
+    UINT32      *pFirstId,
+    UINT32      *pLastId)
+{
+    (void) sock;
+    (void) pFirstId;
+    (void) pLastId;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Create a wake-up event.
+ *  Not supported by this target, completions must be polled.
+ *
+ *  @param[out]     pEvent          pointer to the event, set to invalid descriptors
+ *
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    events are not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockOpenEvent (
+    VOS_SOCK_EVENT_T *pEvent)
+{
+    if (pEvent == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    pEvent->rdSock  = VOS_INVALID_SOCKET;
+    pEvent->wrSock  = VOS_INVALID_SOCKET;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Release a wake-up event.
+ *
+ *  @param[in,out]  pEvent          pointer to the event
+ */
+
+EXT_DECL void vos_sockCloseEvent (
+    VOS_SOCK_EVENT_T *pEvent)
+{
+    (void) pEvent;
+}
+
+/**********************************************************************************************************************/
+/** Signal a wake-up event.
+ *
+ *  @param[in]      pEvent          pointer to the event
+ *
+ *  @retval         VOS_SOCK_ERR    events are not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSignalEvent (
+    const VOS_SOCK_EVENT_T *pEvent)
+{
+    (void) pEvent;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Reset a wake-up event to non-signalled.
+ *
+ *  @param[in]      pEvent          pointer to the event
+ *
+ *  @retval         VOS_SOCK_ERR    events are not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockClearEvent (
+    const VOS_SOCK_EVENT_T *pEvent)
+{
+    (void) pEvent;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Create a deadline timer.
+ *  Not supported by this target, the session must be processed cyclically.
+ *
+ *  @param[out]     pTimer          pointer to the timer, set to an invalid descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    timers are not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockOpenTimer (
+    VOS_SOCK_TIMER_T *pTimer)
+{
+    if (pTimer == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    pTimer->sock = VOS_INVALID_SOCKET;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Release a deadline timer.
+ *
+ *  @param[in,out]  pTimer          pointer to the timer
+ */
+
+EXT_DECL void vos_sockCloseTimer (
+    VOS_SOCK_TIMER_T *pTimer)
+{
+    (void) pTimer;
+}
+
+/**********************************************************************************************************************/
+/** Arm a deadline timer.
+ *
+ *  @param[in]      pTimer          pointer to the timer
+ *  @param[in]      pDeadline       absolute time, NULL or zero to disarm the timer
+ *
+ *  @retval         VOS_SOCK_ERR    timers are not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetTimer (
+    const VOS_SOCK_TIMER_T  *pTimer,
+    const VOS_TIMEVAL_T     *pDeadline)
+{
+    (void) pTimer;
+    (void) pDeadline;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Reset an expired deadline timer to non-readable.
+ *
+ *  @param[in]      pTimer          pointer to the timer
+ *
+ *  @retval         VOS_SOCK_ERR    timers are not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sockClearTimer (
+    const VOS_SOCK_TIMER_T *pTimer)
+{
+    (void) pTimer;
+    return VOS_SOCK_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Set Using Multicast I/F
  *
@@ -17,6 +17,9 @@
  /*
  * $Id$*
  *
+ *      AG 2026-10-18: vos_atomicCompareExchange32()/vos_atomicFence()
+ *      AG 2026-10-18: vos_threadSetOverrunPolicy()/vos_threadGetCyclicStats() stubs
+ *      AG 2026-10-18: vos_atomicLoad32()/vos_atomicStore32()
  *     CEW 2023-01-09: Ticket #408: thread-safe localtime - but be aware of static pTimeString
  *      MM 2022-05-30: Ticket #326: Implementation of missing thread functionality
  *      MM 2021-03-05: Ticket #360: Adaption for VxWorks7
@@ -39,6 +42,9 @@
 #include <taskLib.h>
 #include <string.h>
 #include <time.h>
+#ifndef __GNUC__
+#include <vxAtomicLib.h>
+#endif
 
 #include "vos_thread.h"
 #include "vos_sock.h"
@@ -401,6 +407,45 @@ EXT_DECL VOS_ERR_T vos_threadIsActive (
     return (errVal == OK ? VOS_NO_ERR : VOS_PARAM_ERR);
 }
 
+/**********************************************************************************************************************/
+/** Set the overrun policy of a cyclic thread.
+ *  Not supported by this target, cyclic threads always continue with the next release.
+ *
+ *  @param[in]      thread          Thread handle
+ *  @param[in]      policy          Skip, catch up or resynchronise
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetOverrunPolicy (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_OVERRUN_T    policy)
+{
+    (void) thread;
+    (void) policy;
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread.
+ *  Not supported by this target.
+ *
+ *  @param[in]      thread          Thread handle
+ *  @param[out]     pStats          Pointer to the statistics to fill
+ *  @param[in]      reset           Clear the statistics after reading them
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetCyclicStats (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_CYC_STATS_T  *pStats,
+    BOOL8                   reset)
+{
+    (void) thread;
+    (void) pStats;
+    (void) reset;
+    return VOS_UNKNOWN_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Return thread handle of calling task
  *
@@ -1217,3 +1262,82 @@ EXT_DECL void vos_semaGive (
     }
     return;
 }
+
+/**********************************************************************************************************************/
+/** Read a value shared between threads.
+ *  The read has acquire semantics: all writes of the thread, which stored the value with vos_atomicStore32(), are
+ *  visible after the call.
+ *
+ *  @param[in]      pValue          pointer to the shared value
+ *
+ *  @retval         the value read
+ */
+
+EXT_DECL UINT32 vos_atomicLoad32 (
+    const volatile UINT32 *pValue)
+{
+#if defined(__GNUC__)
+    return __atomic_load_n(pValue, __ATOMIC_ACQUIRE);
+#else
+    return (UINT32) vxAtomic32Get((atomic32_t *) pValue);
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Write a value shared between threads.
+ *  The write has release semantics: all preceding writes of the calling thread become visible to a thread reading
+ *  the value with vos_atomicLoad32().
+ *
+ *  @param[in]      pValue          pointer to the shared value
+ *  @param[in]      value           the value to write
+ */
+
+EXT_DECL void vos_atomicStore32 (
+    volatile UINT32 *pValue,
+    UINT32          value)
+{
+#if defined(__GNUC__)
+    __atomic_store_n(pValue, value, __ATOMIC_RELEASE);
+#else
+    (void) vxAtomic32Set((atomic32_t *) pValue, (atomic32Val_t) value);
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Compare and exchange a value shared between threads.
+ *  Writes desired to the value if it still holds expected. A successful exchange has acquire and release semantics.
+ *
+ *  @param[in,out]  pValue          pointer to the shared value
+ *  @param[in]      expected        the value expected
+ *  @param[in]      desired         the value to write
+ *
+ *  @retval         TRUE            value was exchanged
+ *  @retval         FALSE           value did not hold expected, nothing written
+ */
+
+EXT_DECL BOOL8 vos_atomicCompareExchange32 (
+    volatile UINT32 *pValue,
+    UINT32          expected,
+    UINT32          desired)
+{
+#if defined(__GNUC__)
+    return (__atomic_compare_exchange_n(pValue, &expected, desired, FALSE, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE) ? TRUE : FALSE);
+#else
+    return (vxAtomic32Cas((atomic32_t *) pValue, (atomic32Val_t) expected, (atomic32Val_t) desired) ? TRUE : FALSE);
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Full memory barrier.
+ *  No read or write of the calling thread is reordered across the call.
+ */
+
+EXT_DECL void vos_atomicFence (void)
+{
+#if defined(__GNUC__)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#else
+    VX_MEM_BARRIER_RW();
+#endif
+}
@@ -18,6 +18,9 @@
 /*
 * $Id$
 *
+*      AG 2026-10-18: vos_atomicCompareExchange32()/vos_atomicFence()
+*      AG 2026-10-18: vos_threadSetOverrunPolicy()/vos_threadGetCyclicStats() stubs
+*      AG 2026-10-18: vos_atomicLoad32()/vos_atomicStore32()
 *     CWE 2023-02-14: Ticket #419 PDTestFastBase2 failed - improved warning message
 *      BL 2019-12-06: Ticket #303: UUID creation does not always conform to standard
 *      SB 2019-08-30: Added vos_getRealTime and vos_getNanoTime
@@ -424,6 +427,45 @@ EXT_DECL VOS_ERR_T vos_threadIsActive (VOS_THREAD_T thread)
     return VOS_PARAM_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Set the overrun policy of a cyclic thread.
+ *  Not supported by this target, cyclic threads always continue with the next release.
+ *
+ *  @param[in]      thread          Thread handle
+ *  @param[in]      policy          Skip, catch up or resynchronise
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetOverrunPolicy (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_OVERRUN_T    policy)
+{
+    (void) thread;
+    (void) policy;
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread.
+ *  Not supported by this target.
+ *
+ *  @param[in]      thread          Thread handle
+ *  @param[out]     pStats          Pointer to the statistics to fill
+ *  @param[in]      reset           Clear the statistics after reading them
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetCyclicStats (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_CYC_STATS_T  *pStats,
+    BOOL8                   reset)
+{
+    (void) thread;
+    (void) pStats;
+    (void) reset;
+    return VOS_UNKNOWN_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Return thread handle of calling task
 *
@@ -1216,3 +1258,67 @@ EXT_DECL void vos_semaGive (
     }
     return;
 }
+
+/**********************************************************************************************************************/
+/** Read a value shared between threads.
+ *  The read has acquire semantics: all writes of the thread, which stored the value with vos_atomicStore32(), are
+ *  visible after the call.
+ *
+ *  @param[in]      pValue          pointer to the shared value
+ *
+ *  @retval         the value read
+ */
+
+EXT_DECL UINT32 vos_atomicLoad32 (
+    const volatile UINT32 *pValue)
+{
+    /* Interlocked functions imply a full memory barrier */
+    return (UINT32) InterlockedCompareExchange((volatile LONG *) pValue, 0, 0);
+}
+
+/**********************************************************************************************************************/
+/** Write a value shared between threads.
+ *  The write has release semantics: all preceding writes of the calling thread become visible to a thread reading
+ *  the value with vos_atomicLoad32().
+ *
+ *  @param[in]      pValue          pointer to the shared value
+ *  @param[in]      value           the value to write
+ */
+
+EXT_DECL void vos_atomicStore32 (
+    volatile UINT32 *pValue,
+    UINT32          value)
+{
+    (void) InterlockedExchange((volatile LONG *) pValue, (LONG) value);
+}
+
+/**********************************************************************************************************************/
+/** Compare and exchange a value shared between threads.
+ *  Writes desired to the value if it still holds expected. A successful exchange has acquire and release semantics.
+ *
+ *  @param[in,out]  pValue          pointer to the shared value
+ *  @param[in]      expected        the value expected
+ *  @param[in]      desired         the value to write
+ *
+ *  @retval         TRUE            value was exchanged
+ *  @retval         FALSE           value did not hold expected, nothing written
+ */
+
+EXT_DECL BOOL8 vos_atomicCompareExchange32 (
+    volatile UINT32 *pValue,
+    UINT32          expected,
+    UINT32          desired)
+{
+    return (InterlockedCompareExchange((volatile LONG *) pValue, (LONG) desired, (LONG) expected) == (LONG) expected)
+           ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Full memory barrier.
+ *  No read or write of the calling thread is reordered across the call.
+ */
+
+EXT_DECL void vos_atomicFence (void)
+{
+    MemoryBarrier();
+}
@@ -14,6 +14,7 @@
  *
  * $Id$
  *
+ *      AG 2026-10-18: Cyclic thread timing statistics and overrun handling
  *      SB 2021-08-09: Compiler warnings
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
  */
@@ -337,6 +338,69 @@ int testInterfaces()
     return 0; /* all time tests succeeded */
 }
 
+static volatile UINT32 sCyclicCalls = 0u;
+
+void *cyclicFunction (void *pArg)
+{
+    UINT32 calls = vos_atomicLoad32(&sCyclicCalls) + 1u;
+
+    vos_atomicStore32(&sCyclicCalls, calls);
+    /* overrun once by more than two intervals */
+    if (calls == 20u)
+    {
+        (void) vos_threadDelay(5000u);
+    }
+    return pArg;
+}
+
+int testCyclicThread()
+{
+    VOS_THREAD_T            thread;
+    VOS_THREAD_T            self;
+    VOS_THREAD_CYC_STATS_T  stats;
+    UINT32                  i, latencies = 0u, execs = 0u;
+
+    if (vos_threadCreate(&thread, "cyclicTest", VOS_THREAD_POLICY_OTHER, 0u, 2000u, 0u,
+                         cyclicFunction, NULL) != VOS_NO_ERR)
+    {
+        return 1;
+    }
+    (void) vos_threadDelay(200000u);
+    if (vos_threadGetCyclicStats(thread, &stats, FALSE) != VOS_NO_ERR)
+    {
+        (void) vos_threadTerminate(thread);
+        return 1;
+    }
+    (void) vos_threadTerminate(thread);
+
+    for (i = 0u; i < VOS_THREAD_HIST_BUCKETS; i++)
+    {
+        latencies += stats.latencyHist[i];
+        execs     += stats.execHist[i];
+    }
+    printf("cyclic thread\t%u calls, %u overruns, %u skipped, latency %u..%u us, execution %u..%u us\n",
+           stats.cycles, stats.overruns, stats.skipped, stats.latencyMin, stats.latencyMax,
+           stats.execMin, stats.execMax);
+
+    /* 100 releases in 200ms, the long call must have been accounted and its releases dropped */
+    if ((stats.interval != 2000u) || (latencies != stats.cycles) || (execs != stats.cycles) ||
+        (stats.cycles > vos_atomicLoad32(&sCyclicCalls)) || (stats.cycles + stats.skipped < 80u) ||
+        (stats.cycles + stats.skipped > 101u) || (stats.overruns == 0u) || (stats.skipped < 2u) ||
+        (stats.execMax < 5000u))
+    {
+        return 1;
+    }
+
+    /* only threads with an interval have statistics */
+    (void) vos_threadSelf(&self);
+    if ((vos_threadGetCyclicStats(self, &stats, FALSE) != VOS_NOINIT_ERR) ||
+        (vos_threadSetOverrunPolicy(self, VOS_THREAD_OVERRUN_CATCHUP) != VOS_NOINIT_ERR))
+    {
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     /*    Init the library  */
@@ -385,6 +449,12 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    if (testCyclicThread())
+    {
+        printf("Cyclic thread test failed\n");
+        return 1;
+    }
+
     printf("All tests successfully finished.\n");
     return 0;
 }
@@ -0,0 +1,433 @@
+/**********************************************************************************************************************/
+/**
+ * @file            mdTcpLoadTest.c
+ *
+ * @brief           Load test for MD over TCP: many concurrent callers against one replier on the loopback interface
+ *
+ * @details         One replier session listens on the replier address, each caller session is bound to its own
+ *                  loopback address (127.0.0.2, 127.0.0.3, ...) and keeps one request outstanding at any time.
+ *                  The replier echoes the request payload. All sessions are driven from one thread, so the figures
+ *                  reflect the stack's processing cost rather than scheduling effects.
+ *                  With -z the replier hands over its payload by tlm_replyNoCopy(), the released buffers are
+ *                  overwritten: a payload handed back too early shows up as a corrupted reply.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "trdp_if_light.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+#define APP_VERSION     "1.0"
+
+#define MAX_CALLERS     16u                 /* limited by the MD sockets of the replier session */
+#define DATA_MAX        65000u
+#define COM_ID          2000u
+#define REPLY_TIMEOUT   5000000u            /* in us */
+
+typedef struct
+{
+    TRDP_APP_SESSION_T  appHandle;
+    UINT32              ifaceIP;
+    BOOL8               busy;               /* request outstanding */
+    UINT32              sent;
+    UINT32              received;
+    UINT32              failed;
+    VOS_TIMEVAL_T       sendTime;
+    VOS_TIMEVAL_T       latencySum;
+} TEST_CALLER_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+static TEST_CALLER_T        sCaller[MAX_CALLERS];
+static TRDP_APP_SESSION_T   sReplier    = NULL;
+static UINT8                sData[DATA_MAX];
+static UINT32               sDataSize   = 4096u;
+static BOOL8                sIdle       = TRUE;
+static BOOL8                sNoCopy     = FALSE;
+static UINT32               sRepliesOut = 0u;       /* payloads handed to tlm_replyNoCopy() */
+static UINT32               sReleased   = 0u;       /* payloads handed back */
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void dbgOut (void *, TRDP_LOG_T, const CHAR8 *, const CHAR8 *, UINT16, const CHAR8 *);
+void usage (const char *);
+
+/**********************************************************************************************************************/
+/** callback routine for TRDP logging/error output
+ *
+ *  @param[in]      pRefCon         user supplied context pointer
+ *  @param[in]      category        Log category (Error, Warning, Info etc.)
+ *  @param[in]      pTime           pointer to NULL-terminated string of time stamp
+ *  @param[in]      pFile           pointer to NULL-terminated string of source module
+ *  @param[in]      LineNumber      line
+ *  @param[in]      pMsgStr         pointer to NULL-terminated string
+ *  @retval         none
+ */
+void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    const char *catStr[] = {"**Error:", "Warning:", "   Info:", "  Debug:", "   User:"};
+
+    if (category == VOS_LOG_ERROR)
+    {
+        printf("%s %s %s:%d %s",
+               strrchr(pTime, '-') + 1,
+               catStr[category],
+               pFile,
+               LineNumber,
+               pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Measures MD request/reply throughput over TCP with many concurrent callers (loopback only).\n"
+           "Arguments are:\n"
+           "-o <replier IP>     replier address (default 127.0.0.1)\n"
+           "-i <caller IP>      address of the first caller, the others follow (default 127.0.0.2)\n"
+           "-n <callers>        number of concurrent callers (1..%u, default 8)\n"
+           "-s <size>           payload size in bytes (default 4096, max %u)\n"
+           "-c <count>          requests per caller (default 1000)\n"
+           "-z                  reply by tlm_replyNoCopy() (zero-copy above the threshold)\n"
+           "-v                  print version and quit\n",
+           MAX_CALLERS, DATA_MAX);
+}
+
+/**********************************************************************************************************************/
+/** Replier: a reply payload is handed back, spoil it before freeing
+ */
+static void replyRelease (
+    void        *pRefCon,
+    const UINT8 *pData,
+    UINT32      dataSize)
+{
+    memset((UINT8 *) pData, 0xEE, dataSize);
+    free((UINT8 *) pData);
+    sReleased++;
+}
+
+/**********************************************************************************************************************/
+/** Replier: echo the request
+ */
+static void replierCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MR) && (sNoCopy == TRUE))
+    {
+        UINT8 *pCopy = (UINT8 *) malloc(dataSize);
+
+        if (pCopy == NULL)
+        {
+            printf("out of memory\n");
+            return;
+        }
+        memcpy(pCopy, pData, dataSize);
+        sRepliesOut++;
+        if (tlm_replyNoCopy(appHandle, &pMsg->sessionId, pMsg->comId, 0u, NULL, pCopy, dataSize, NULL,
+                            replyRelease, NULL) != TRDP_NO_ERR)
+        {
+            printf("tlm_replyNoCopy failed\n");
+        }
+    }
+    else if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MR))
+    {
+        if (tlm_reply(appHandle, &pMsg->sessionId, pMsg->comId, 0u, NULL, pData, dataSize, NULL) != TRDP_NO_ERR)
+        {
+            printf("tlm_reply failed\n");
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Caller: account for the reply
+ */
+static void callerCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TEST_CALLER_T *pCaller = (TEST_CALLER_T *) pMsg->pUserRef;
+
+    if (pCaller == NULL)
+    {
+        return;
+    }
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MP))
+    {
+        VOS_TIMEVAL_T now;
+
+        vos_getTime(&now);
+        vos_subTime(&now, &pCaller->sendTime);
+        vos_addTime(&pCaller->latencySum, &now);
+        if ((dataSize != sDataSize) || (memcmp(pData, sData, dataSize) != 0))
+        {
+            pCaller->failed++;
+        }
+        pCaller->received++;
+        pCaller->busy = FALSE;
+    }
+    else if ((pMsg->resultCode != TRDP_NO_ERR) && (pCaller->busy == TRUE))
+    {
+        pCaller->failed++;
+        pCaller->busy = FALSE;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Run all sessions once
+ */
+static void processAll (
+    UINT32 noOfCallers)
+{
+    TRDP_FDS_T      rfds;
+    TRDP_SOCK_T     noDesc  = VOS_INVALID_SOCKET;
+    TRDP_TIME_T     tv      = {0, 0};
+    TRDP_TIME_T     sessTv;
+    INT32           rv;
+    UINT32          i;
+
+    FD_ZERO(&rfds);
+    for (i = 0u; i <= noOfCallers; i++)
+    {
+        TRDP_APP_SESSION_T  appHandle   = (i == 0u) ? sReplier : sCaller[i - 1u].appHandle;
+        TRDP_SOCK_T         sessDesc    = VOS_INVALID_SOCKET;
+
+        (void) tlc_getInterval(appHandle, &sessTv, &rfds, &sessDesc);
+        if ((sessDesc != VOS_INVALID_SOCKET) &&
+            ((noDesc == VOS_INVALID_SOCKET) || (vos_sockCmp(sessDesc, noDesc) == 1)))
+        {
+            noDesc = sessDesc;
+        }
+    }
+
+    /* Replies are queued while receiving and sent on the next cycle, do not sleep as long as there is traffic */
+    if (sIdle == TRUE)
+    {
+        tv.tv_usec = 1000;
+    }
+    rv = vos_select(noDesc, &rfds, NULL, NULL, &tv);
+    sIdle = (rv > 0) ? FALSE : TRUE;
+
+    for (i = 0u; i <= noOfCallers; i++)
+    {
+        TRDP_APP_SESSION_T appHandle = (i == 0u) ? sReplier : sCaller[i - 1u].appHandle;
+        (void) tlc_process(appHandle, &rfds, &rv);
+    }
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    TRDP_MD_CONFIG_T    mdConfig    = {NULL, NULL, TRDP_MD_DEFAULT_SEND_PARAM, TRDP_FLAGS_TCP,
+                                       TRDP_MD_DEFAULT_REPLY_TIMEOUT, TRDP_MD_DEFAULT_CONFIRM_TIMEOUT,
+                                       TRDP_MD_DEFAULT_CONNECTION_TIMEOUT, TRDP_MD_DEFAULT_SENDING_TIMEOUT,
+                                       TRDP_MD_UDP_PORT, TRDP_MD_TCP_PORT, TRDP_MD_MAX_NUM_SESSIONS};
+    TRDP_PROCESS_CONFIG_T processConfig = {"mdTcpLoad", "", "", 0u, 0u, TRDP_OPTION_NONE};
+    TRDP_LIS_T          listenHandle;
+    TRDP_IP_ADDR_T      replierIP   = vos_dottedIP("127.0.0.1");
+    TRDP_IP_ADDR_T      callerIP    = vos_dottedIP("127.0.0.2");
+    UINT32              noOfCallers = 8u;
+    UINT32              count       = 1000u;
+    UINT32              i;
+    UINT32              done;
+    UINT32              received    = 0u;
+    UINT32              failed      = 0u;
+    VOS_TIMEVAL_T       startTime;
+    VOS_TIMEVAL_T       endTime;
+    VOS_TIMEVAL_T       latencySum  = {0, 0};
+    double              elapsed;
+    int                 ch;
+
+    while ((ch = getopt(argc, argv, "o:i:n:s:c:zh?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 'o':
+               replierIP = vos_dottedIP(optarg);
+               break;
+           case 'i':
+               callerIP = vos_dottedIP(optarg);
+               break;
+           case 'n':
+               noOfCallers = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 's':
+               sDataSize = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'c':
+               count = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'z':
+               sNoCopy = TRUE;
+               break;
+           case 'v':
+               printf("%s: Version %s\t(%s - %s)\n", argv[0], APP_VERSION, __DATE__, __TIME__);
+               return 0;
+           case 'h':
+           case '?':
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+    if ((noOfCallers == 0u) || (noOfCallers > MAX_CALLERS) || (sDataSize == 0u) || (sDataSize > DATA_MAX))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    for (i = 0u; i < sDataSize; i++)
+    {
+        sData[i] = (UINT8) (i * 7u);
+    }
+
+    if (tlc_init(dbgOut, NULL, NULL) != TRDP_NO_ERR)
+    {
+        printf("tlc_init failed\n");
+        return 1;
+    }
+
+    mdConfig.pfCbFunction = replierCallback;
+    if ((tlc_openSession(&sReplier, replierIP, 0u, NULL, NULL, &mdConfig, &processConfig) != TRDP_NO_ERR) ||
+        (tlm_addListener(sReplier, &listenHandle, NULL, replierCallback, TRUE, COM_ID, 0u, 0u,
+                         VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY,
+                         TRDP_FLAGS_TCP | TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR))
+    {
+        printf("Replier setup failed\n");
+        tlc_terminate();
+        return 1;
+    }
+
+    mdConfig.pfCbFunction = callerCallback;
+    for (i = 0u; i < noOfCallers; i++)
+    {
+        memset(&sCaller[i], 0, sizeof(TEST_CALLER_T));
+        sCaller[i].ifaceIP = callerIP + i;
+        if (tlc_openSession(&sCaller[i].appHandle, sCaller[i].ifaceIP, 0u, NULL, NULL, &mdConfig,
+                            &processConfig) != TRDP_NO_ERR)
+        {
+            printf("Caller %u setup failed (%s)\n", i, vos_ipDotted(sCaller[i].ifaceIP));
+            tlc_terminate();
+            return 1;
+        }
+    }
+
+    printf("%u callers, %u requests each, %u bytes payload\n", noOfCallers, count, sDataSize);
+
+    vos_getTime(&startTime);
+    do
+    {
+        done = 0u;
+        for (i = 0u; i < noOfCallers; i++)
+        {
+            TEST_CALLER_T *pCaller = &sCaller[i];
+
+            if ((pCaller->busy == FALSE) && (pCaller->sent < count))
+            {
+                TRDP_UUID_T sessionId;
+
+                vos_getTime(&pCaller->sendTime);
+                if (tlm_request(pCaller->appHandle, pCaller, callerCallback, &sessionId, COM_ID, 0u, 0u,
+                                pCaller->ifaceIP, replierIP, TRDP_FLAGS_TCP | TRDP_FLAGS_CALLBACK, 1u,
+                                REPLY_TIMEOUT, NULL, sData, sDataSize, NULL, NULL) == TRDP_NO_ERR)
+                {
+                    pCaller->busy = TRUE;
+                }
+                else
+                {
+                    pCaller->failed++;
+                }
+                pCaller->sent++;
+            }
+            if ((pCaller->busy == FALSE) && (pCaller->sent >= count))
+            {
+                done++;
+            }
+        }
+        processAll(noOfCallers);
+    }
+    while (done < noOfCallers);
+    vos_getTime(&endTime);
+
+    vos_subTime(&endTime, &startTime);
+    elapsed = (double) endTime.tv_sec + (double) endTime.tv_usec / 1000000.0;
+
+    for (i = 0u; i < noOfCallers; i++)
+    {
+        received    += sCaller[i].received;
+        failed      += sCaller[i].failed;
+        vos_addTime(&latencySum, &sCaller[i].latencySum);
+    }
+
+    printf("elapsed:      %.3f s\n", elapsed);
+    printf("replies:      %u (%u failed)\n", received, failed);
+    printf("throughput:   %.0f req/s, %.2f MB/s (request + reply payload)\n",
+           (double) received / elapsed,
+           (double) received * 2.0 * (double) sDataSize / elapsed / 1000000.0);
+    if (received > 0u)
+    {
+        printf("avg. latency: %.1f us\n",
+               ((double) latencySum.tv_sec * 1000000.0 + (double) latencySum.tv_usec) / (double) received);
+    }
+
+    for (i = 0u; i < noOfCallers; i++)
+    {
+        (void) tlc_closeSession(sCaller[i].appHandle);
+    }
+    (void) tlm_delListener(sReplier, listenHandle);
+    (void) tlc_closeSession(sReplier);
+    (void) tlc_terminate();
+
+    if (sNoCopy == TRUE)
+    {
+        printf("released:     %u of %u reply payloads\n", sReleased, sRepliesOut);
+        if (sReleased != sRepliesOut)
+        {
+            failed++;
+        }
+    }
+
+    return (failed == 0u) ? 0 : 1;
+}
@@ -0,0 +1,373 @@
+/**********************************************************************************************************************/
+/**
+ * @file            bench_ladderstore.c
+ *
+ * @brief           Contention benchmark of the ladder Traffic Store
+ *
+ * @details         Writer threads, standing for the subscriber callbacks of both subnets, write datasets into the
+ *                  Traffic Store while 1, 2, 4... application threads read them. Every run is done once with a single
+ *                  global mutex around each copy, as the Traffic Store was guarded before, and once with
+ *                  tau_writeTrafficStore()/tau_readTrafficStore(). Every dataset written is filled with one byte
+ *                  value, a copy holding different bytes is a torn read the reader did not detect and fails the
+ *                  benchmark. Reported are reads and writes per second and the retries of the sequence locks.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+ /*
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "trdp_if_light.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+#include "tau_ladder.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define BENCH_MAX_THREADS       64u
+#define BENCH_MAX_RUNS          8u
+#define BENCH_MAX_SIZE          1432u       /* largest PD dataset                               */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Counters of one thread, padded to keep the threads off each other's cache line */
+typedef struct
+{
+    UINT32  count;                      /**< datasets read or written                               */
+    UINT32  torn;                       /**< copies with mixed contents                             */
+    UINT8   pad[56];
+} BENCH_COUNT_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static BENCH_COUNT_T    sReader[BENCH_MAX_THREADS];
+static BENCH_COUNT_T    sWriter[BENCH_MAX_THREADS];
+static VOS_MUTEX_T      sGlobalMutex;
+static VOS_SEMA_T       sDone;
+static volatile UINT32  sStop;
+static BOOL8            sUseSeqLock;
+static UINT32           sNoOfDatasets   = 64u;
+static UINT32           sDataSize       = 256u;
+static UINT32           sStride;
+static UINT32           sWriteDelay     = 0u;
+static UINT32           sNoOfWriters    = 2u;
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** callback function for debug output
+ */
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      lineNumber,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    (void) pTime;
+    (void) pFile;
+    (void) lineNumber;
+    if (category <= VOS_LOG_WARNING)
+    {
+        printf("%s", pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Microseconds between two times
+ */
+static UINT32 diffUs (
+    const VOS_TIMEVAL_T *pTo,
+    const VOS_TIMEVAL_T *pFrom)
+{
+    VOS_TIMEVAL_T diff = *pTo;
+
+    vos_subTime(&diff, pFrom);
+    return (UINT32) diff.tv_sec * 1000000u + (UINT32) diff.tv_usec;
+}
+
+/**********************************************************************************************************************/
+/** Application thread: read the datasets round robin and check each copy
+ */
+static void *readerThread (void *pArg)
+{
+    BENCH_COUNT_T   *pCount = (BENCH_COUNT_T *) pArg;
+    UINT8           buffer[BENCH_MAX_SIZE];
+    UINT32          dataset = (UINT32) (pCount - sReader) % sNoOfDatasets;
+    UINT32          idx;
+
+    while (vos_atomicLoad32(&sStop) == 0u)
+    {
+        UINT16 offset = (UINT16) (dataset * sStride);
+
+        if (sUseSeqLock == TRUE)
+        {
+            (void) tau_readTrafficStore(offset, buffer, sDataSize);
+        }
+        else
+        {
+            (void) vos_mutexLock(sGlobalMutex);
+            memcpy(buffer, pTrafficStoreAddr + offset, sDataSize);
+            vos_mutexUnlock(sGlobalMutex);
+        }
+        for (idx = 1u; idx < sDataSize; idx++)
+        {
+            if (buffer[idx] != buffer[0])
+            {
+                pCount->torn++;
+                break;
+            }
+        }
+        pCount->count++;
+        dataset = (dataset + 1u) % sNoOfDatasets;
+    }
+    vos_semaGive(sDone);
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Subscriber thread: write the datasets round robin, each filled with one byte value
+ */
+static void *writerThread (void *pArg)
+{
+    BENCH_COUNT_T   *pCount = (BENCH_COUNT_T *) pArg;
+    UINT8           buffer[BENCH_MAX_SIZE];
+    UINT32          dataset = (UINT32) (pCount - sWriter) * sNoOfDatasets / sNoOfWriters;
+    UINT8           value   = (UINT8) (pCount - sWriter);
+
+    while (vos_atomicLoad32(&sStop) == 0u)
+    {
+        UINT16 offset = (UINT16) (dataset * sStride);
+
+        memset(buffer, value++, sDataSize);
+        if (sUseSeqLock == TRUE)
+        {
+            (void) tau_writeTrafficStore(offset, buffer, sDataSize);
+        }
+        else
+        {
+            (void) vos_mutexLock(sGlobalMutex);
+            memcpy(pTrafficStoreAddr + offset, buffer, sDataSize);
+            vos_mutexUnlock(sGlobalMutex);
+        }
+        pCount->count++;
+        dataset = (dataset + 1u) % sNoOfDatasets;
+        if (sWriteDelay != 0u)
+        {
+            (void) vos_threadDelay(sWriteDelay);
+        }
+    }
+    vos_semaGive(sDone);
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** One run: start the threads, let them work for the duration and print the rates
+ */
+static int run (
+    UINT32  noOfReaders,
+    UINT32  duration)
+{
+    VOS_THREAD_T                    thread;
+    VOS_TIMEVAL_T                   start, now;
+    TAU_TRAFFIC_STORE_STATISTICS_T  before, after;
+    UINT32                          idx, reads = 0u, writes = 0u, torn = 0u, elapsed;
+    UINT32                          noOfWriters = sNoOfWriters;
+
+    memset(sReader, 0, sizeof(sReader));
+    memset(sWriter, 0, sizeof(sWriter));
+    (void) tau_writeTrafficStore(0u, NULL, sNoOfDatasets * sStride);
+    (void) tau_getTrafficStoreStatistics(&before);
+    vos_atomicStore32(&sStop, 0u);
+
+    vos_getTime(&start);
+    for (idx = 0u; idx < noOfWriters + noOfReaders; idx++)
+    {
+        BOOL8 isWriter = (idx < noOfWriters) ? TRUE : FALSE;
+
+        if (vos_threadCreate(&thread, isWriter ? "benchWriter" : "benchReader", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u,
+                             isWriter ? writerThread : readerThread,
+                             isWriter ? (void *) &sWriter[idx] : (void *) &sReader[idx - noOfWriters])
+            != VOS_NO_ERR)
+        {
+            printf("Thread %u could not be created\n", idx);
+            vos_atomicStore32(&sStop, 1u);
+            while (idx-- > 0u)
+            {
+                (void) vos_semaTake(sDone, VOS_SEMA_WAIT_FOREVER);
+            }
+            return 1;
+        }
+    }
+    (void) vos_threadDelay(duration);
+    vos_atomicStore32(&sStop, 1u);
+    vos_getTime(&now);
+    for (idx = 0u; idx < noOfWriters + noOfReaders; idx++)
+    {
+        (void) vos_semaTake(sDone, VOS_SEMA_WAIT_FOREVER);
+    }
+    elapsed = diffUs(&now, &start) / 1000u;
+    (void) tau_getTrafficStoreStatistics(&after);
+
+    for (idx = 0u; idx < noOfReaders; idx++)
+    {
+        reads   += sReader[idx].count;
+        torn    += sReader[idx].torn;
+    }
+    for (idx = 0u; idx < noOfWriters; idx++)
+    {
+        writes += sWriter[idx].count;
+    }
+    printf("%-8s %7u %12llu %12llu %10u %10u %10u %6u\n",
+           (sUseSeqLock == TRUE) ? "seqlock" : "mutex",
+           noOfReaders,
+           (unsigned long long) reads * 1000u / ((elapsed != 0u) ? elapsed : 1u),
+           (unsigned long long) writes * 1000u / ((elapsed != 0u) ? elapsed : 1u),
+           after.readRetries - before.readRetries,
+           after.tornReads - before.tornReads,
+           after.writeWaits - before.writeWaits,
+           torn);
+    return (torn == 0u) ? 0 : 1;
+}
+
+/**********************************************************************************************************************/
+/**    Print usage
+ */
+static void usage (
+    const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Reads and writes Traffic Store datasets from many threads, with a global mutex and with sequence locks.\n"
+           "Arguments are:\n"
+           "-n <datasets>           number of datasets (default 64)\n"
+           "-s <size>               dataset size in bytes (default 256, max. %u)\n"
+           "-w <writers>            writer threads (default 2)\n"
+           "-p <pause>              pause of a writer after each write in us (default 0)\n"
+           "-d <seconds>            duration of a run (default 2)\n"
+           "-k <list>               application threads per run (default 1,2,4,8,16, max. %u)\n"
+           "-h                      print usage\n", BENCH_MAX_SIZE, BENCH_MAX_THREADS);
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+int main (
+    int     argc,
+    char    *argv[])
+{
+    UINT32  duration    = 2u;
+    UINT32  readers[BENCH_MAX_RUNS] = {1u, 2u, 4u, 8u, 16u};
+    UINT32  noOfRuns    = 5u;
+    UINT32  idx;
+    int     ch, result = 0;
+
+    while ((ch = getopt(argc, argv, "n:s:w:p:d:k:h")) != -1)
+    {
+        switch (ch)
+        {
+           case 'n':
+               sNoOfDatasets = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 's':
+               sDataSize = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'w':
+               sNoOfWriters = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'p':
+               sWriteDelay = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'd':
+               duration = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'k':
+           {
+               char *pNext = optarg;
+
+               for (noOfRuns = 0u; (noOfRuns < BENCH_MAX_RUNS) && (*pNext != '\0'); noOfRuns++)
+               {
+                   readers[noOfRuns] = (UINT32) strtoul(pNext, &pNext, 10);
+                   if (*pNext == ',')
+                   {
+                       pNext++;
+                   }
+               }
+               break;
+           }
+           case 'h':
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+    /* Datasets start on a sequence block, so datasets never share a lock */
+    sStride = (sDataSize + TRAFFIC_STORE_SEQ_BLOCK - 1u) / TRAFFIC_STORE_SEQ_BLOCK * TRAFFIC_STORE_SEQ_BLOCK;
+    if ((sNoOfDatasets == 0u) || (sDataSize == 0u) || (sDataSize > BENCH_MAX_SIZE) || (duration == 0u) ||
+        (sNoOfWriters == 0u) || (sNoOfWriters > BENCH_MAX_THREADS) ||
+        (sNoOfDatasets * sStride > TRAFFIC_STORE_MUTEX_VALUE_AREA))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    for (idx = 0u; idx < noOfRuns; idx++)
+    {
+        if ((readers[idx] == 0u) || (readers[idx] > BENCH_MAX_THREADS))
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if ((tlc_init(dbgOut, NULL, NULL) != TRDP_NO_ERR) ||
+        (tau_ladder_init() != TRDP_NO_ERR) ||
+        (vos_mutexCreate(&sGlobalMutex) != VOS_NO_ERR) ||
+        (vos_semaCreate(&sDone, VOS_SEMA_EMPTY) != VOS_NO_ERR))
+    {
+        printf("Traffic Store could not be set up\n");
+        return 1;
+    }
+
+    printf("%u datasets of %u bytes, %u writers%s, %u s per run\n",
+           sNoOfDatasets, sDataSize, sNoOfWriters, (sWriteDelay != 0u) ? " pausing" : "", duration);
+    printf("%-8s %7s %12s %12s %10s %10s %10s %6s\n",
+           "lock", "readers", "reads/s", "writes/s", "retries", "tornRetry", "writeWaits", "torn");
+    for (idx = 0u; (idx < noOfRuns) && (result == 0); idx++)
+    {
+        sUseSeqLock = FALSE;
+        result      = run(readers[idx], duration * 1000000u);
+        if (result == 0)
+        {
+            sUseSeqLock = TRUE;
+            result      = run(readers[idx], duration * 1000000u);
+        }
+    }
+
+    vos_semaDelete(sDone);
+    vos_mutexDelete(sGlobalMutex);
+    (void) tau_ladder_terminate();
+    (void) tlc_terminate();
+    return result;
+}
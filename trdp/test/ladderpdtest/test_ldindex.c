@@ -0,0 +1,342 @@
+/**********************************************************************************************************************/
+/**
+ * @file            test_ldindex.c
+ *
+ * @brief           Model based test of the TAUL telegram list index
+ *
+ * @details         Random appends, deletes and searches are done on a tau_ldIndex and on a plain list in append
+ *                  order, which is searched the way searchPublish/Subscribe/PdRequestTelegramList() did before the
+ *                  index: the first telegram of the comId whose source and destination address are 0 or match, and
+ *                  for PD Requests whose reply comId and reply address are 0 or match, too. Every search must return
+ *                  the same telegram from both. Few comIds and addresses, which differ in the subnet or the host part
+ *                  only, make many telegrams share a key and the wildcard keys; the index grows and shrinks several
+ *                  times. Options: -n <operations> -s <seed>
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+ /*
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "trdp_if_light.h"
+#include "vos_mem.h"
+#include "tau_ldIndex.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TEST_MAX_TELEGRAMS      1000u       /* telegrams in the list at most                    */
+#define TEST_NO_OF_COMIDS       6u
+#define TEST_NO_OF_ADDRESSES    5u
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Telegram of the model, the fields searchPdRequestTelegramList() looks at */
+typedef struct
+{
+    UINT32          comId;
+    TRDP_IP_ADDR_T  srcIpAddr;
+    TRDP_IP_ADDR_T  dstIpAddr;
+    UINT32          replyComId;
+    TRDP_IP_ADDR_T  replyIpAddr;
+} TEST_TELEGRAM_T;
+
+/** Reply searched for */
+typedef struct
+{
+    UINT32          replyComId;
+    TRDP_IP_ADDR_T  replyIpAddr;
+} TEST_REPLY_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static TEST_TELEGRAM_T  *sList[TEST_MAX_TELEGRAMS];    /* the model: telegrams in append order */
+static UINT32           sNoOfTelegrams;
+static UINT32           sSeed = 1u;
+
+/* comId 0 is not indexed */
+static const UINT32         sComId[TEST_NO_OF_COMIDS] = {0u, 1000u, 1001u, 2000u, 65536u + 1000u, 0xFFFFFFFFu};
+/* 0 is the wildcard, the others differ in the subnet (0x2000) or the host part */
+static const TRDP_IP_ADDR_T sAddress[TEST_NO_OF_ADDRESSES] =
+{
+    0u, 0x0A000001u, 0x0A002001u, 0x0A000002u, 0xEFFF0101u
+};
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Random number, reproducible
+ */
+static UINT32 random32 (
+    UINT32 range)
+{
+    sSeed = sSeed * 1103515245u + 12345u;
+    return ((sSeed >> 8) & 0xFFFFFFu) % range;
+}
+
+/**********************************************************************************************************************/
+/** Random address, 0 for every third one
+ */
+static TRDP_IP_ADDR_T randomAddress (void)
+{
+    return sAddress[(random32(3u) == 0u) ? 0u : 1u + random32(TEST_NO_OF_ADDRESSES - 1u)];
+}
+
+/**********************************************************************************************************************/
+/** Reply check of searchPdRequestTelegramList()
+ */
+static BOOL8 matchReply (
+    const void  *pTelegram,
+    const void  *pArg)
+{
+    const TEST_TELEGRAM_T   *pTelegramT = (const TEST_TELEGRAM_T *) pTelegram;
+    const TEST_REPLY_T      *pReply     = (const TEST_REPLY_T *) pArg;
+
+    return (pTelegramT->replyComId == 0u || pTelegramT->replyComId == pReply->replyComId)
+           && (pTelegramT->replyIpAddr == 0u || pTelegramT->replyIpAddr == pReply->replyIpAddr);
+}
+
+/**********************************************************************************************************************/
+/** Search of the model: the telegram list loop
+ */
+static TEST_TELEGRAM_T *searchList (
+    UINT32              comId,
+    TRDP_IP_ADDR_T      srcIpAddr,
+    TRDP_IP_ADDR_T      dstIpAddr,
+    const TEST_REPLY_T  *pReply)
+{
+    UINT32 i;
+
+    for (i = 0u; i < sNoOfTelegrams; i++)
+    {
+        if ((sList[i]->comId == comId)
+            && (sList[i]->srcIpAddr == 0u || sList[i]->srcIpAddr == srcIpAddr)
+            && (sList[i]->dstIpAddr == 0u || sList[i]->dstIpAddr == dstIpAddr)
+            && ((pReply == NULL) || matchReply(sList[i], pReply)))
+        {
+            return sList[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Expected result of a search, comId 0 is never found
+ */
+static TEST_TELEGRAM_T *expected (
+    UINT32              comId,
+    TRDP_IP_ADDR_T      srcIpAddr,
+    TRDP_IP_ADDR_T      dstIpAddr,
+    const TEST_REPLY_T  *pReply)
+{
+    return (comId == 0u) ? NULL : searchList(comId, srcIpAddr, dstIpAddr, pReply);
+}
+
+/**********************************************************************************************************************/
+/** Compare the searches of all keys with the model
+ *
+ *  @retval         number of differences
+ */
+static UINT32 checkAll (
+    const TAU_LD_INDEX_T *pIndex)
+{
+    UINT32          c, s, d, failed = 0u;
+    TEST_REPLY_T    reply;
+    void            *pFound;
+
+    for (c = 0u; c < TEST_NO_OF_COMIDS; c++)
+    {
+        for (s = 0u; s < TEST_NO_OF_ADDRESSES; s++)
+        {
+            for (d = 0u; d < TEST_NO_OF_ADDRESSES; d++)
+            {
+                pFound = tau_ldIndexSearch(pIndex, sComId[c], sAddress[s], sAddress[d], NULL, NULL);
+                if (pFound != expected(sComId[c], sAddress[s], sAddress[d], NULL))
+                {
+                    printf("### comId %u src %08x dst %08x: index and list differ\n", sComId[c], sAddress[s],
+                           sAddress[d]);
+                    failed++;
+                }
+                reply.replyComId    = sComId[(c + s) % TEST_NO_OF_COMIDS];
+                reply.replyIpAddr   = sAddress[(s + d) % TEST_NO_OF_ADDRESSES];
+                pFound = tau_ldIndexSearch(pIndex, sComId[c], sAddress[s], sAddress[d], matchReply, &reply);
+                if (pFound != expected(sComId[c], sAddress[s], sAddress[d], &reply))
+                {
+                    printf("### comId %u src %08x dst %08x reply %u %08x: index and list differ\n", sComId[c],
+                           sAddress[s], sAddress[d], reply.replyComId, reply.replyIpAddr);
+                    failed++;
+                }
+            }
+        }
+    }
+    return failed;
+}
+
+/**********************************************************************************************************************/
+/** Append a random telegram to the list and the index
+ */
+static TRDP_ERR_T appendTelegram (
+    TAU_LD_INDEX_T *pIndex)
+{
+    TEST_TELEGRAM_T *pTelegram = (TEST_TELEGRAM_T *) malloc(sizeof(TEST_TELEGRAM_T));
+    TRDP_ERR_T      err;
+
+    if (pTelegram == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    /* comId 0 is not indexed, it must not be found either */
+    pTelegram->comId        = sComId[random32(TEST_NO_OF_COMIDS)];
+    pTelegram->srcIpAddr    = randomAddress();
+    pTelegram->dstIpAddr    = randomAddress();
+    pTelegram->replyComId   = (random32(2u) == 0u) ? 0u : sComId[random32(TEST_NO_OF_COMIDS)];
+    pTelegram->replyIpAddr  = randomAddress();
+    err = tau_ldIndexInsert(pIndex, pTelegram->comId, pTelegram->srcIpAddr, pTelegram->dstIpAddr, pTelegram);
+    if (err != TRDP_NO_ERR)
+    {
+        free(pTelegram);
+        return err;
+    }
+    sList[sNoOfTelegrams++] = pTelegram;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Delete a random telegram from the list and the index
+ */
+static void deleteTelegram (
+    TAU_LD_INDEX_T *pIndex)
+{
+    UINT32          i = random32(sNoOfTelegrams);
+    TEST_TELEGRAM_T *pTelegram = sList[i];
+
+    tau_ldIndexRemove(pIndex, pTelegram->comId, pTelegram->srcIpAddr, pTelegram->dstIpAddr, pTelegram);
+    memmove(&sList[i], &sList[i + 1u], (sNoOfTelegrams - i - 1u) * sizeof(sList[0]));
+    sNoOfTelegrams--;
+    free(pTelegram);
+}
+
+/**********************************************************************************************************************/
+/** Number of indexed telegrams of the model
+ */
+static UINT32 indexedTelegrams (void)
+{
+    UINT32 i, count = 0u;
+
+    for (i = 0u; i < sNoOfTelegrams; i++)
+    {
+        count += (sList[i]->comId != 0u);
+    }
+    return count;
+}
+
+/**********************************************************************************************************************/
+int main (
+    int     argc,
+    char    *argv[])
+{
+    TAU_LD_INDEX_T  index;
+    UINT32          operations  = 20000u;
+    UINT32          op, target  = 0u, failed = 0u, peak = 0u;
+    int             ch;
+
+    while ((ch = getopt(argc, argv, "n:s:h")) != -1)
+    {
+        switch (ch)
+        {
+           case 'n':
+               operations = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 's':
+               sSeed = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           default:
+               printf("usage: %s [-n <operations>] [-s <seed>]\n", argv[0]);
+               return 1;
+        }
+    }
+
+    if (vos_memInit(NULL, 0u, NULL) != VOS_NO_ERR)
+    {
+        printf("### vos_memInit() failed\n");
+        return 1;
+    }
+    memset(&index, 0, sizeof(index));
+
+    for (op = 0u; (op < operations) && (failed == 0u); op++)
+    {
+        /* Every 2000 operations the list heads for another size, to grow and shrink the index */
+        if ((op % 2000u) == 0u)
+        {
+            target = random32(TEST_MAX_TELEGRAMS);
+        }
+        if ((sNoOfTelegrams < TEST_MAX_TELEGRAMS)
+            && ((sNoOfTelegrams == 0u) || (random32(4u) < ((sNoOfTelegrams < target) ? 3u : 1u))))
+        {
+            if (appendTelegram(&index) != TRDP_NO_ERR)
+            {
+                printf("### tau_ldIndexInsert() failed\n");
+                return 1;
+            }
+        }
+        else
+        {
+            deleteTelegram(&index);
+        }
+        if (index.count != indexedTelegrams())
+        {
+            printf("### operation %u: %u telegrams indexed, %u in the list\n", op, index.count,
+                   indexedTelegrams());
+            failed++;
+        }
+        if (sNoOfTelegrams > peak)
+        {
+            peak = sNoOfTelegrams;
+        }
+        /* A full check costs some hundred searches, do it on every 16th operation */
+        if ((op % 16u) == 0u)
+        {
+            failed += checkAll(&index);
+        }
+    }
+    failed += checkAll(&index);
+
+    while (sNoOfTelegrams > 0u)
+    {
+        deleteTelegram(&index);
+    }
+    if ((index.count != 0u) || (index.anySrc != 0u) || (index.anyDst != 0u) || (index.anyBoth != 0u))
+    {
+        printf("### index not empty after deleting all telegrams\n");
+        failed++;
+    }
+    tau_ldIndexClear(&index);
+    vos_memDelete(NULL);
+
+    if (failed != 0u)
+    {
+        printf("### %u differences between index and list\n", failed);
+        return 1;
+    }
+    printf("%u operations, up to %u telegrams: index and list agree\n", op, peak);
+    return 0;
+}
@@ -18,6 +18,12 @@
  *
  * $Id$
  *
+ *      AG 2026-10-18: test19 stops its loop threads and checks tlc_closeSession()
+ *      AG 2026-10-18: test23: session reactor, the loop thread can hand its session to tlc_run()
+ *      AG 2026-10-18: test21: MD worker thread
+ *      AG 2026-10-18: test20: duplicate replies from one source dropped, Mq replies confirmed per source
+ *      AG 2026-10-18: test20: aggregated multicast MD request
+ *      AG 2026-10-18: test19: asynchronous MD requests
  *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
  *      BL 2019-08-27: Interval timing in test 9 changed
  *      BL 2018-03-06: Ticket #101 Optional callback function on PD send
@@ -65,11 +71,14 @@ typedef struct
     TRDP_IP_ADDR_T      ifaceIP;
     int                 threadRun;
     VOS_THREAD_T        threadId;
+    const TRDP_RUN_CONFIG_T *volatile pRunConfig;  /* != NULL: the loop hands the session to tlc_run() */
+    volatile int        threadDone;                 /* set by the loop after it closed the session */
+    TRDP_ERR_T          closeErr;                   /* result of that tlc_closeSession() */
 
 } TRDP_THREAD_SESSION_T;
 
-TRDP_THREAD_SESSION_T   gSession1 = {NULL, 0x0A000364u, 0, 0};
-TRDP_THREAD_SESSION_T   gSession2 = {NULL, 0x0A000365u, 0, 0};
+TRDP_THREAD_SESSION_T   gSession1 = {NULL, 0x0A000364u, 0, 0, NULL, 0, TRDP_NO_ERR};
+TRDP_THREAD_SESSION_T   gSession2 = {NULL, 0x0A000365u, 0, 0, NULL, 0, TRDP_NO_ERR};
 
 /* Data buffers to play with (Content is borrowed from Douglas Adams, "The Hitchhiker's Guide to the Galaxy") */
 static uint8_t          dataBuffer1[64 * 1024] =
@@ -449,7 +458,7 @@ static void *trdp_loop (void *pArg)
     /*
         Enter the main processing loop.
      */
-    while (pSession->threadId)
+    while (pSession->threadRun)
     {
         TRDP_FDS_T  rfds;
         INT32       noDesc;
@@ -458,6 +467,13 @@ static void *trdp_loop (void *pArg)
         TRDP_TIME_T max_tv  = {0u, 20000};
         TRDP_TIME_T min_tv  = {0u, 5000};
 
+        if (pSession->pRunConfig != NULL)
+        {
+            /* processed by the reactor until tlc_stopRun() */
+            (void) tlc_run(pSession->appHandle, pSession->pRunConfig);
+            continue;
+        }
+
         /*
          Prepare the file descriptor set for the select call.
          Additional descriptors can be added here.
@@ -509,8 +525,9 @@ static void *trdp_loop (void *pArg)
      *    We always clean up behind us!
      */
 
-    (void)tlc_closeSession(pSession->appHandle);
+    pSession->closeErr  = tlc_closeSession(pSession->appHandle);
     pSession->appHandle = NULL;
+    pSession->threadDone = 1;
     return NULL;
 }
 
@@ -560,12 +577,38 @@ static TRDP_APP_SESSION_T test_init (
 
     if (err == TRDP_NO_ERR)
     {
+        /* threadId is not yet set when the thread starts running */
+        pSession->threadRun     = 1;
+        pSession->pRunConfig    = NULL;
+        pSession->threadDone    = 0;
+        pSession->closeErr      = TRDP_NO_ERR;
         (void) vos_threadCreate(&pSession->threadId, name, VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u,
                                 trdp_loop, pSession);
     }
     return pSession->appHandle;
 }
 
+/**********************************************************************************************************************/
+/** Let the loop thread of a session leave and close its session
+ *  Cancelling the thread may hit it inside tlc_process() while it holds the session mutex (any socket I/O is a
+ *  cancellation point), the session could not be closed afterwards. Tests which check the close use this instead.
+ *
+ *  @param[in]      pSession        pointer to session
+ *  @retval         result of tlc_closeSession() or TRDP_TIMEOUT_ERR
+ */
+static TRDP_ERR_T test_stop (
+    TRDP_THREAD_SESSION_T *pSession)
+{
+    int wait;
+
+    pSession->threadRun = 0;
+    for (wait = 0; (wait < 200) && (pSession->threadDone == 0); wait++)
+    {
+        (void) vos_threadDelay(10000u);
+    }
+    return (pSession->threadDone != 0) ? pSession->closeErr : TRDP_TIMEOUT_ERR;
+}
+
 /**********************************************************************************************************************/
 /** common initialisation
  *
@@ -576,13 +619,13 @@ static void test_deinit (
     TRDP_THREAD_SESSION_T   *pSession1,
     TRDP_THREAD_SESSION_T   *pSession2)
 {
-    if (pSession1)
+    if (pSession1 && (pSession1->threadDone == 0))
     {
         //pSession1->threadRun = 0;
         vos_threadTerminate(pSession1->threadId);
         vos_threadDelay(100000);
     }
-    if (pSession2)
+    if (pSession2 && (pSession2->threadDone == 0))
     {
         //pSession2->threadRun = 0;
         vos_threadTerminate(pSession2->threadId);
@@ -2265,6 +2308,862 @@ static int test18 ()
     CLEANUP;
 }
 
+/**********************************************************************************************************************/
+/** test19 - asynchronous MD requests
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST19_COMID        1019u
+#define TEST19_NUM_REQ      64u
+
+static void  test19CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TRDP_ERR_T err;
+
+    (void) pRefCon;
+
+    /* echo every request */
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MR))
+    {
+        err = tlm_reply(appHandle, &pMsg->sessionId, pMsg->comId, 0u, NULL, pData, dataSize, NULL);
+        if (err != TRDP_NO_ERR)
+        {
+            fprintf(gFp, "#### tlm_reply failed (err = %d)\n", err);
+            gFailed = 1;
+        }
+    }
+}
+
+static int test19 ()
+{
+    PREPARE("Asynchronous MD requests, completion queue", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_FLAGS_T            flags[2]    = {TRDP_FLAGS_NONE, TRDP_FLAGS_TCP};
+        TRDP_MD_HANDLE_T        handles[TEST19_NUM_REQ];
+        UINT32                  userRef[TEST19_NUM_REQ];
+        BOOL8                   done[TEST19_NUM_REQ];
+        CHAR8                   request[TEST19_NUM_REQ][16];
+        TRDP_LIS_T              listenHandle;
+        TRDP_SOCK_T             desc;
+        TRDP_MD_COMPLETION_T    completion;
+        UINT32                  i, j, pass, numDone;
+
+        err = tlm_getCompletionDesc(appHandle1, &desc);
+        IF_ERROR("tlm_getCompletionDesc");
+
+        for (pass = 0u; pass < 2u; pass++)
+        {
+            err = tlm_addListener(appHandle2, &listenHandle, NULL, test19CBFunction, TRUE,
+                                  TEST19_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY,
+                                  flags[pass], NULL, NULL);
+            IF_ERROR("tlm_addListener");
+
+            /* all requests outstanding at the same time */
+            for (i = 0u; i < TEST19_NUM_REQ; i++)
+            {
+                userRef[i]  = i;
+                done[i]     = FALSE;
+                (void) snprintf(request[i], sizeof(request[i]), "async %03u", (unsigned int) i);
+
+                err = tlm_requestAsync(appHandle1, &userRef[i], NULL, TEST19_COMID, 0u, 0u,
+                                       0u, gSession2.ifaceIP, flags[pass], 1u, 2000000u, NULL,
+                                       (UINT8 *) request[i], sizeof(request[i]), NULL, NULL, &handles[i]);
+                IF_ERROR("tlm_requestAsync");
+            }
+            fprintf(gFp, "->> %u %s requests sent\n", (unsigned int) TEST19_NUM_REQ, (pass == 0u) ? "UDP" : "TCP");
+
+            numDone = 0u;
+            while (numDone < TEST19_NUM_REQ)
+            {
+                VOS_FDS_T       rfds;
+                VOS_TIMEVAL_T   tv = {3, 0};
+
+                VOS_FD_ZERO(&rfds);
+                VOS_FD_SET(desc, &rfds);
+                if (vos_select(desc, &rfds, NULL, NULL, &tv) <= 0)
+                {
+                    fprintf(gFp, "#### completion missing, %u of %u done\n",
+                            (unsigned int) numDone, (unsigned int) TEST19_NUM_REQ);
+                    gFailed = 1;
+                    goto end;
+                }
+                while (tlm_getCompletion(appHandle1, &completion) == TRDP_NO_ERR)
+                {
+                    for (j = 0u; (j < TEST19_NUM_REQ) && (handles[j] != completion.handle); j++)
+                    {
+                        ;
+                    }
+                    if ((j == TEST19_NUM_REQ)
+                        || (done[j] == TRUE)
+                        || (completion.final == FALSE)
+                        || (completion.info.resultCode != TRDP_NO_ERR)
+                        || (completion.info.pUserRef != &userRef[j])
+                        || (completion.dataSize != sizeof(request[j]))
+                        || (memcmp(completion.pData, request[j], sizeof(request[j])) != 0))
+                    {
+                        fprintf(gFp, "#### unexpected completion (handle = %u, result = %d)\n",
+                                (unsigned int) completion.handle, completion.info.resultCode);
+                        gFailed = 1;
+                    }
+                    else
+                    {
+                        done[j] = TRUE;
+                        numDone++;
+                    }
+                    (void) tlm_releaseCompletion(appHandle1, &completion);
+                }
+                if (gFailed)
+                {
+                    goto end;
+                }
+            }
+            fprintf(gFp, "<<- all replies completed\n");
+
+            err = tlm_delListener(appHandle2, listenHandle);
+            IF_ERROR("tlm_delListener");
+        }
+
+        /* nothing left */
+        if (tlm_getCompletion(appHandle1, &completion) != TRDP_NODATA_ERR)
+        {
+            gFailed = 1;
+        }
+
+        /* both sessions must close cleanly */
+        err = test_stop(&gSession1);
+        IF_ERROR("tlc_closeSession (session 1)");
+        err = test_stop(&gSession2);
+        IF_ERROR("tlc_closeSession (session 2)");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** test20 - aggregated multicast request
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST20_COMID        1020u
+
+static TRDP_MD_REPLY_SET_T  gTest20Set;
+static TRDP_IP_ADDR_T       gTest20Src[3];
+static UINT32               gTest20Ok;
+static volatile int         gTest20Done;
+static BOOL8                gTest20Confirm;     /* confirm Mq replies from within the callback */
+static TRDP_ERR_T           gTest20ConfirmErr;
+static volatile int         gTest20Confirmed;   /* confirmations received by the replier */
+static volatile int         gTest20ConfirmTo;   /* confirmation timeouts of the replier */
+
+static void  test20CBFunction (
+    void                        *pRefCon,
+    TRDP_APP_SESSION_T          appHandle,
+    const TRDP_MD_REPLY_SET_T   *pReplySet)
+{
+    UINT32 i;
+
+    (void) pRefCon;
+    (void) appHandle;
+
+    gTest20Set  = *pReplySet;
+    gTest20Ok   = 0u;
+    for (i = 0u; i < pReplySet->numReplies; i++)
+    {
+        fprintf(gFp, "<<- reply from %s after %u us\n", vos_ipDotted(pReplySet->pReplies[i].srcIpAddr),
+                (unsigned int) pReplySet->pReplies[i].latency);
+        if (i < 3u)
+        {
+            gTest20Src[i] = pReplySet->pReplies[i].srcIpAddr;
+        }
+        if ((pReplySet->pReplies[i].dataSize == 16u)
+            && (memcmp(pReplySet->pReplies[i].pData, "aggregated query", 16u) == 0))
+        {
+            gTest20Ok++;
+        }
+        /* each reply query gets a confirmation of its own */
+        if ((gTest20Confirm == TRUE) && (pReplySet->pReplies[i].msgType == TRDP_MSG_MQ))
+        {
+            gTest20ConfirmErr = tlm_confirmReply(appHandle, &pReplySet->sessionId,
+                                                 pReplySet->pReplies[i].srcIpAddr, 0u, NULL);
+        }
+    }
+    gTest20Done = 1;
+}
+
+/* replier asking for confirmation */
+static void  test20MqCBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MR))
+    {
+        if (tlm_replyQuery(appHandle, &pMsg->sessionId, pMsg->comId, 0u, 1000000u, NULL, pData, dataSize,
+                           NULL) != TRDP_NO_ERR)
+        {
+            fprintf(gFp, "#### tlm_replyQuery failed\n");
+            gFailed = 1;
+        }
+    }
+    else if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MC))
+    {
+        gTest20Confirmed++;
+    }
+    else if (pMsg->resultCode == TRDP_CONFIRMTO_ERR)
+    {
+        gTest20ConfirmTo++;
+    }
+}
+
+/* send one aggregated request and wait for its result set */
+static void test20Request (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              expected)
+{
+    UINT32 i;
+
+    gTest20Done = 0;
+    gTest20Set.resultCode = TRDP_UNKNOWN_ERR;
+    if (tlm_requestAggregate(appHandle, NULL, test20CBFunction, NULL, TEST20_COMID, 0u, 0u,
+                             0u, gDestMC, TRDP_FLAGS_NONE, expected, 1000000u, NULL,
+                             (UINT8 *) "aggregated query", 16u, NULL, NULL) != TRDP_NO_ERR)
+    {
+        return;
+    }
+    fprintf(gFp, "->> Aggregated request sent, %u replies expected\n", (unsigned int) expected);
+
+    for (i = 0u; (i < 300u) && (gTest20Done == 0); i++)
+    {
+        vos_threadDelay(10000u);
+    }
+}
+
+static int test20 ()
+{
+    PREPARE("Aggregated multicast MD request", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_LIS_T  listenHandle1, listenHandle2;
+        UINT32      expected[2]     = {1u, 0u};
+        TRDP_ERR_T  expResult[2]    = {TRDP_NO_ERR, TRDP_REPLYTO_ERR};
+        UINT32      pass, i;
+
+        err = tlm_addListener(appHandle1, &listenHandle1, NULL, test19CBFunction, TRUE,
+                              TEST20_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, gDestMC,
+                              TRDP_FLAGS_NONE, NULL, NULL);
+        IF_ERROR("tlm_addListener1");
+        err = tlm_addListener(appHandle2, &listenHandle2, NULL, test19CBFunction, TRUE,
+                              TEST20_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, gDestMC,
+                              TRDP_FLAGS_NONE, NULL, NULL);
+        IF_ERROR("tlm_addListener2");
+
+        /* One replier expected: early completion; unknown number: completed by timeout.
+           Replies to a multicast request leave with the primary address of the host, on a single machine
+           both repliers may therefore share one source and the second one counts as duplicate. */
+        for (pass = 0u; pass < 2u; pass++)
+        {
+            gTest20Done = 0;
+            err = tlm_requestAggregate(appHandle1, NULL, test20CBFunction, NULL, TEST20_COMID, 0u, 0u,
+                                       0u, gDestMC, TRDP_FLAGS_NONE, expected[pass], 1000000u, NULL,
+                                       (UINT8 *) "aggregated query", 16u, NULL, NULL);
+            IF_ERROR("tlm_requestAggregate");
+            fprintf(gFp, "->> Aggregated request sent, %u replies expected\n", (unsigned int) expected[pass]);
+
+            for (i = 0u; (i < 300u) && (gTest20Done == 0); i++)
+            {
+                vos_threadDelay(10000u);
+            }
+            if ((gTest20Done == 0)
+                || (gTest20Set.resultCode != expResult[pass])
+                || (gTest20Set.numReplies == 0u)
+                || (gTest20Ok != gTest20Set.numReplies)
+                || ((pass == 0u) && (gTest20Set.numReplies != 1u))
+                || ((pass == 1u) && (gTest20Set.numReplies + gTest20Set.numDuplicates != 2u))
+                || ((gTest20Set.numReplies == 2u) && (gTest20Src[0] == gTest20Src[1])))
+            {
+                fprintf(gFp, "#### result set wrong (done = %d, result = %d, replies = %u, duplicates = %u)\n",
+                        gTest20Done, gTest20Set.resultCode, (unsigned int) gTest20Set.numReplies,
+                        (unsigned int) gTest20Set.numDuplicates);
+                gFailed = 1;
+                goto end;
+            }
+            /* early completion must not wait for the timeout */
+            if ((pass == 0u) && (i >= 90u))
+            {
+                fprintf(gFp, "#### result set not delivered early\n");
+                gFailed = 1;
+                goto end;
+            }
+        }
+
+        /* A third replier on the address of the second one: its reply has the same source and is dropped */
+        {
+            TRDP_THREAD_SESSION_T   session3;
+            TRDP_LIS_T              listenHandle3;
+            TRDP_APP_SESSION_T      appHandle3;
+
+            memset(&session3, 0, sizeof(session3));
+            session3.ifaceIP    = gSession2.ifaceIP;
+            appHandle3          = test_init(NULL, &session3, "test");
+            if ((appHandle3 == NULL)
+                || (tlm_addListener(appHandle3, &listenHandle3, NULL, test19CBFunction, TRUE,
+                                    TEST20_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, gDestMC,
+                                    TRDP_FLAGS_NONE, NULL, NULL) != TRDP_NO_ERR))
+            {
+                fprintf(gFp, "#### third replier not set up\n");
+                gFailed = 1;
+            }
+            else
+            {
+                test20Request(appHandle1, 0u);
+                (void) tlm_delListener(appHandle3, listenHandle3);
+            }
+            if ((test_stop(&session3) != TRDP_NO_ERR) && (appHandle3 != NULL))
+            {
+                fprintf(gFp, "#### tlc_closeSession (session 3) failed\n");
+                gFailed = 1;
+            }
+            if (gFailed)
+            {
+                goto end;
+            }
+            if ((gTest20Done == 0)
+                || (gTest20Set.numReplies + gTest20Set.numDuplicates != 3u)
+                || (gTest20Set.numDuplicates == 0u)
+                || (gTest20Ok != gTest20Set.numReplies)
+                || ((gTest20Set.numReplies == 2u) && (gTest20Src[0] == gTest20Src[1])))
+            {
+                fprintf(gFp, "#### duplicate not dropped (done = %d, replies = %u, duplicates = %u)\n",
+                        gTest20Done, (unsigned int) gTest20Set.numReplies, (unsigned int) gTest20Set.numDuplicates);
+                gFailed = 1;
+                goto end;
+            }
+            fprintf(gFp, "<<- %u duplicate(s) dropped\n", (unsigned int) gTest20Set.numDuplicates);
+        }
+
+        err = tlm_delListener(appHandle1, listenHandle1);
+        IF_ERROR("tlm_delListener1");
+        err = tlm_delListener(appHandle2, listenHandle2);
+        IF_ERROR("tlm_delListener2");
+
+        /* A replier asking for confirmation: confirmed by the source recorded in the result set */
+        err = tlm_addListener(appHandle2, &listenHandle2, NULL, test20MqCBFunction, TRUE,
+                              TEST20_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, gDestMC,
+                              TRDP_FLAGS_NONE, NULL, NULL);
+        IF_ERROR("tlm_addListener2 (Mq)");
+
+        gTest20Confirm      = TRUE;
+        gTest20ConfirmErr   = TRDP_UNKNOWN_ERR;
+        gTest20Confirmed    = 0;
+        gTest20ConfirmTo    = 0;
+        test20Request(appHandle1, 1u);
+        gTest20Confirm      = FALSE;
+
+        for (i = 0u; (i < 150u) && (gTest20Confirmed == 0) && (gTest20ConfirmTo == 0); i++)
+        {
+            vos_threadDelay(10000u);
+        }
+        if ((gTest20Done == 0)
+            || (gTest20Set.resultCode != TRDP_NO_ERR)
+            || (gTest20Set.numReplies != 1u)
+            || (gTest20Set.pReplies == NULL)
+            || (gTest20ConfirmErr != TRDP_NO_ERR)
+            || (gTest20Confirmed != 1)
+            || (gTest20ConfirmTo != 0))
+        {
+            fprintf(gFp, "#### Mq reply not confirmed (done = %d, confirm = %d, confirmed = %d, timeouts = %d)\n",
+                    gTest20Done, gTest20ConfirmErr, gTest20Confirmed, gTest20ConfirmTo);
+            gFailed = 1;
+            goto end;
+        }
+        fprintf(gFp, "<<- Mq reply confirmed\n");
+
+        err = tlm_delListener(appHandle2, listenHandle2);
+        IF_ERROR("tlm_delListener2 (Mq)");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** test21 - MD worker thread
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST21_COMID        1021u
+#define TEST21_NUM_REQ      50u
+
+static int test21 ()
+{
+    PREPARE("MD worker thread, immediate sending", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_FLAGS_T            flags[2]    = {TRDP_FLAGS_NONE, TRDP_FLAGS_TCP};
+        TRDP_MD_HANDLE_T        handle;
+        TRDP_LIS_T              listenHandle;
+        TRDP_SOCK_T             desc;
+        TRDP_MD_COMPLETION_T    completion;
+        VOS_TIMEVAL_T           start, now;
+        UINT32                  i, pass, usecs;
+
+        err = tlm_startWorker(appHandle1, 0u);
+        IF_ERROR("tlm_startWorker1");
+        err = tlm_startWorker(appHandle2, 0u);
+        IF_ERROR("tlm_startWorker2");
+        if (tlm_startWorker(appHandle1, 0u) != TRDP_STATE_ERR)
+        {
+            fprintf(gFp, "#### second worker accepted\n");
+            gFailed = 1;
+            goto end;
+        }
+        err = tlm_getCompletionDesc(appHandle1, &desc);
+        IF_ERROR("tlm_getCompletionDesc");
+
+        /* pass 2: the replier is back to the application loop */
+        for (pass = 0u; pass < 3u; pass++)
+        {
+            if (pass == 2u)
+            {
+                err = tlm_stopWorker(appHandle2);
+                IF_ERROR("tlm_stopWorker");
+            }
+            err = tlm_addListener(appHandle2, &listenHandle, NULL, test19CBFunction, TRUE,
+                                  TEST21_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY,
+                                  flags[pass & 1u], NULL, NULL);
+            IF_ERROR("tlm_addListener");
+
+            /* one request after the other, each one waits for its reply */
+            vos_getTime(&start);
+            for (i = 0u; i < TEST21_NUM_REQ; i++)
+            {
+                VOS_FDS_T       rfds;
+                VOS_TIMEVAL_T   tv = {2, 0};
+                TRDP_ERR_T      got = TRDP_NODATA_ERR;
+
+                err = tlm_requestAsync(appHandle1, NULL, NULL, TEST21_COMID, 0u, 0u,
+                                       0u, gSession2.ifaceIP, flags[pass & 1u], 1u, 1000000u, NULL,
+                                       (UINT8 *) "worker", 6u, NULL, NULL, &handle);
+                IF_ERROR("tlm_requestAsync");
+
+                /* the event may still be set from the previous completion */
+                while (got != TRDP_NO_ERR)
+                {
+                    VOS_FD_ZERO(&rfds);
+                    VOS_FD_SET(desc, &rfds);
+                    if (vos_select(desc, &rfds, NULL, NULL, &tv) <= 0)
+                    {
+                        break;
+                    }
+                    got = tlm_getCompletion(appHandle1, &completion);
+                }
+                if (got != TRDP_NO_ERR)
+                {
+                    fprintf(gFp, "#### reply %u missing\n", (unsigned int) i);
+                    gFailed = 1;
+                    goto end;
+                }
+                if ((completion.handle != handle)
+                    || (completion.info.resultCode != TRDP_NO_ERR)
+                    || (completion.dataSize != 6u))
+                {
+                    fprintf(gFp, "#### unexpected completion (result = %d)\n", completion.info.resultCode);
+                    gFailed = 1;
+                }
+                (void) tlm_releaseCompletion(appHandle1, &completion);
+                if (gFailed)
+                {
+                    goto end;
+                }
+            }
+            vos_getTime(&now);
+            vos_subTime(&now, &start);
+            usecs = (UINT32)(now.tv_sec * 1000000 + now.tv_usec) / TEST21_NUM_REQ;
+            fprintf(gFp, "<<- %s round trip %u us\n", (pass & 1u) ? "TCP" : "UDP", (unsigned int) usecs);
+
+            /* with both workers, nothing waits for the 20ms cycle of the application loop */
+            if ((pass < 2u) && (usecs > 5000u))
+            {
+                fprintf(gFp, "#### round trip too slow\n");
+                gFailed = 1;
+                goto end;
+            }
+
+            err = tlm_delListener(appHandle2, listenHandle);
+            IF_ERROR("tlm_delListener");
+        }
+
+        /* the worker of appHandle1 is stopped by tlc_closeSession() */
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test22
+ *
+ *  Next deadline of a session, waiting with a deadline timer
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST22_COMID        1022u
+#define TEST22_INTERVAL     100000u
+#define TEST22_TIMEOUT      (3u * TEST22_INTERVAL)
+#define TEST22_TIMER        30000u
+
+static int test22 ()
+{
+    PREPARE("Next deadline, timer wake-up", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_TIME_T         now, deadline, limit;
+        const TRDP_TIME_T   slack = {0, 50000};
+        VOS_SOCK_TIMER_T    timer   = {VOS_INVALID_SOCKET};
+        VOS_FDS_T           rfds;
+        VOS_TIMEVAL_T       tv;
+        UINT32              usecs;
+        INT32               rv;
+
+        err = tlc_getNextDeadline(appHandle1, &deadline);
+        IF_ERROR("tlc_getNextDeadline");
+        if (timerisset(&deadline))
+        {
+            FAILED("deadline without telegrams");
+        }
+
+        err = tlp_publish(appHandle1, &pubHandle, NULL, NULL, 0u, TEST22_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST22_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) "deadline", 8u);
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(appHandle2, &subHandle, NULL, NULL, 0u, TEST22_COMID, 0u, 0u,
+                            0u, 0u, 0u, TRDP_FLAGS_DEFAULT, NULL, TEST22_TIMEOUT, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        vos_threadDelay(2u * TEST22_INTERVAL + TEST22_INTERVAL / 2u);
+
+        /* the publisher is due within one interval */
+        err = tlc_getNextDeadline(appHandle1, &deadline);
+        IF_ERROR("tlc_getNextDeadline");
+        vos_getTime(&now);
+        limit.tv_sec    = 0;
+        limit.tv_usec   = TEST22_INTERVAL;
+        vos_addTime(&limit, &now);
+        vos_addTime(&limit, &slack);
+        fprintf(gFp, "<<- publisher due in %d us\n",
+                (int)((deadline.tv_sec - now.tv_sec) * 1000000 + (deadline.tv_usec - now.tv_usec)));
+        if (!timerisset(&deadline) || (vos_cmpTime(&deadline, &limit) > 0))
+        {
+            FAILED("publisher deadline wrong");
+        }
+
+        /* the subscriber times out one timeout after the last reception (or the subscription) */
+        err = tlc_getNextDeadline(appHandle2, &deadline);
+        IF_ERROR("tlc_getNextDeadline");
+        vos_getTime(&now);
+        limit.tv_sec    = 0;
+        limit.tv_usec   = TEST22_TIMEOUT;
+        vos_addTime(&limit, &now);
+        vos_addTime(&limit, &slack);
+        fprintf(gFp, "<<- subscriber times out in %d us\n",
+                (int)((deadline.tv_sec - now.tv_sec) * 1000000 + (deadline.tv_usec - now.tv_usec)));
+        if (!timerisset(&deadline) || (vos_cmpTime(&deadline, &limit) > 0) || (vos_cmpTime(&deadline, &now) < 0))
+        {
+            FAILED("subscriber deadline wrong");
+        }
+
+        /* wait for a deadline with a timer */
+        if (vos_sockOpenTimer(&timer) != VOS_NO_ERR)
+        {
+            fprintf(gFp, "<<- deadline timers not supported\n");
+        }
+        else
+        {
+            vos_getTime(&now);
+            deadline.tv_sec     = 0;
+            deadline.tv_usec    = TEST22_TIMER;
+            vos_addTime(&deadline, &now);
+            if (vos_sockSetTimer(&timer, &deadline) != VOS_NO_ERR)
+            {
+                FAILED("vos_sockSetTimer");
+            }
+            VOS_FD_ZERO(&rfds);
+            VOS_FD_SET(timer.sock, &rfds);
+            tv.tv_sec   = 1;
+            tv.tv_usec  = 0;
+            rv = vos_select(timer.sock, &rfds, NULL, NULL, &tv);
+            vos_getTime(&deadline);
+            vos_subTime(&deadline, &now);
+            usecs = (UINT32)(deadline.tv_sec * 1000000 + deadline.tv_usec);
+            fprintf(gFp, "<<- timer fired after %u us\n", (unsigned int) usecs);
+            if ((rv != 1) || (usecs < TEST22_TIMER) || (usecs > TEST22_TIMER + (UINT32) slack.tv_usec))
+            {
+                FAILED("timer did not fire in time");
+            }
+
+            /* cleared, the timer is quiet again */
+            (void) vos_sockClearTimer(&timer);
+            VOS_FD_ZERO(&rfds);
+            VOS_FD_SET(timer.sock, &rfds);
+            vos_clearTime(&tv);
+            if (vos_select(timer.sock, &rfds, NULL, NULL, &tv) != 0)
+            {
+                FAILED("timer still readable");
+            }
+
+            /* a passed deadline fires at once */
+            if (vos_sockSetTimer(&timer, &now) != VOS_NO_ERR)
+            {
+                FAILED("vos_sockSetTimer");
+            }
+            VOS_FD_ZERO(&rfds);
+            VOS_FD_SET(timer.sock, &rfds);
+            vos_clearTime(&tv);
+            if (vos_select(timer.sock, &rfds, NULL, NULL, &tv) != 1)
+            {
+                FAILED("passed deadline did not fire");
+            }
+
+            /* disarming cancels it */
+            if (vos_sockSetTimer(&timer, NULL) != VOS_NO_ERR)
+            {
+                FAILED("vos_sockSetTimer");
+            }
+            VOS_FD_ZERO(&rfds);
+            VOS_FD_SET(timer.sock, &rfds);
+            tv.tv_sec   = 0;
+            tv.tv_usec  = TEST22_TIMER;
+            if (vos_select(timer.sock, &rfds, NULL, NULL, &tv) != 0)
+            {
+                FAILED("disarmed timer fired");
+            }
+        }
+        vos_sockCloseTimer(&timer);
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test23
+ *
+ *  Session reactor: the session of the first loop thread is processed by tlc_run(), MD yields after every packet
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST23_COMID        1023u
+#define TEST23_INTERVAL     20000u
+#define TEST23_RUN_TIME     500000u
+#define TEST23_NUM_MSG      50u
+
+static volatile UINT32  gTest23Received;
+
+static void  test23CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pData;
+    (void) dataSize;
+
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MN))
+    {
+        gTest23Received++;
+    }
+}
+
+static int test23 ()
+{
+    PREPARE("Session reactor", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_RUN_CONFIG_T       config;
+        TRDP_RUN_STATISTICS_T   stats;
+        TRDP_PUB_T              pubHandle;
+        TRDP_LIS_T              listenHandle1, listenHandle2;
+        TRDP_MD_HANDLE_T        handle;
+        TRDP_MD_COMPLETION_T    completion;
+        TRDP_SOCK_T             desc;
+        VOS_FDS_T               rfds;
+        VOS_TIMEVAL_T           tv;
+        TRDP_ERR_T              got = TRDP_NODATA_ERR;
+        UINT32                  i;
+        const char              *name[TRDP_RUN_CLASSES] = {"PD send", "PD receive", "MD"};
+
+        memset(&config, 0, sizeof(config));
+        config.budget[TRDP_RUN_PD_RECEIVE]  = 2000u;
+        config.budget[TRDP_RUN_MD]          = 1u;       /* MD yields after every packet */
+        config.maxWait                      = 100000u;
+
+        err = tlp_publish(appHandle1, &pubHandle, NULL, NULL, 0u, TEST23_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST23_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) "reactor", 7u);
+        IF_ERROR("tlp_publish");
+
+        /* the first loop thread hands its session to the reactor */
+        gSession1.pRunConfig = &config;
+        for (i = 0u; i < 100u; i++)
+        {
+            err = tlc_getRunStatistics(appHandle1, &stats);
+            IF_ERROR("tlc_getRunStatistics");
+            if (stats.cycles > 0u)
+            {
+                break;
+            }
+            vos_threadDelay(10000u);
+        }
+        if (stats.cycles == 0u)
+        {
+            FAILED("reactor did not start");
+        }
+        if (tlc_run(appHandle1, &config) != TRDP_STATE_ERR)
+        {
+            FAILED("second reactor accepted");
+        }
+
+        /* a burst of notifications from the reactor, it is woken up by each one */
+        gTest23Received = 0u;
+        err = tlm_addListener(appHandle2, &listenHandle2, NULL, test23CBFunction, TRUE,
+                              TEST23_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+        for (i = 0u; i < TEST23_NUM_MSG; i++)
+        {
+            err = tlm_notify(appHandle1, NULL, NULL, TEST23_COMID, 0u, 0u, 0u,
+                             gSession2.ifaceIP, TRDP_FLAGS_NONE, NULL, (UINT8 *) "reactor", 7u, NULL, NULL);
+            IF_ERROR("tlm_notify");
+        }
+
+        /* a request answered by the reactor */
+        err = tlm_addListener(appHandle1, &listenHandle1, NULL, test19CBFunction, TRUE,
+                              TEST23_COMID + 1u, 0u, 0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_NONE, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+        err = tlm_getCompletionDesc(appHandle2, &desc);
+        IF_ERROR("tlm_getCompletionDesc");
+        err = tlm_requestAsync(appHandle2, NULL, NULL, TEST23_COMID + 1u, 0u, 0u,
+                               0u, gSession1.ifaceIP, TRDP_FLAGS_NONE, 1u, 1000000u, NULL,
+                               (UINT8 *) "reactor", 7u, NULL, NULL, &handle);
+        IF_ERROR("tlm_requestAsync");
+        tv.tv_sec   = 2;
+        tv.tv_usec  = 0;
+        while (got != TRDP_NO_ERR)
+        {
+            VOS_FD_ZERO(&rfds);
+            VOS_FD_SET(desc, &rfds);
+            if (vos_select(desc, &rfds, NULL, NULL, &tv) <= 0)
+            {
+                break;
+            }
+            got = tlm_getCompletion(appHandle2, &completion);
+        }
+        if (got != TRDP_NO_ERR)
+        {
+            FAILED("reply missing");
+        }
+        if ((completion.handle != handle) || (completion.info.resultCode != TRDP_NO_ERR))
+        {
+            fprintf(gFp, "#### unexpected completion (result = %d)\n", completion.info.resultCode);
+            gFailed = 1;
+        }
+        (void) tlm_releaseCompletion(appHandle2, &completion);
+        if (gFailed)
+        {
+            goto end;
+        }
+
+        vos_threadDelay(TEST23_RUN_TIME);
+
+        err = tlc_getRunStatistics(appHandle1, &stats);
+        IF_ERROR("tlc_getRunStatistics");
+
+        /* back to the loop thread */
+        gSession1.pRunConfig = NULL;
+        err = tlc_stopRun(appHandle1);
+        IF_ERROR("tlc_stopRun");
+        vos_threadDelay(100000u);
+
+        fprintf(gFp, "<<- %u cycles, PD sent up to %u us late\n",
+                (unsigned int) stats.cycles, (unsigned int) stats.maxSendLatency);
+        for (i = 0u; i < TRDP_RUN_CLASSES; i++)
+        {
+            fprintf(gFp, "<<- %-10s: %u runs, max. %u us, %u over budget, %u preempted\n", name[i],
+                    (unsigned int) stats.cls[i].runs, (unsigned int) stats.cls[i].maxTime,
+                    (unsigned int) stats.cls[i].overBudget, (unsigned int) stats.cls[i].preempted);
+        }
+
+        /* the notifications left at a preemption point were sent in later cycles */
+        fprintf(gFp, "<<- %u of %u notifications received\n", (unsigned int) gTest23Received, TEST23_NUM_MSG);
+        if (gTest23Received != TEST23_NUM_MSG)
+        {
+            FAILED("notifications lost");
+        }
+        if (stats.cls[TRDP_RUN_PD_SEND].runs < TEST23_RUN_TIME / TEST23_INTERVAL)
+        {
+            FAILED("PD not sent in every interval");
+        }
+        if ((stats.cls[TRDP_RUN_MD].runs == 0u) || (stats.cls[TRDP_RUN_MD].preempted == 0u))
+        {
+            FAILED("MD did not yield");
+        }
+
+        err = tlm_delListener(appHandle1, listenHandle1);
+        IF_ERROR("tlm_delListener");
+        err = tlm_delListener(appHandle2, listenHandle2);
+        IF_ERROR("tlm_delListener");
+        err = tlp_unpublish(appHandle1, pubHandle);
+        IF_ERROR("tlp_unpublish");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
 
 
 
@@ -2292,6 +3191,11 @@ test_func_t *testArray[] =
     test16,     /* MD Request - Reply / UDP */
     test17,     /* CRC */
     test18,     /* XML stream */
+    test19,     /* Asynchronous MD requests, completion queue */
+    test20,     /* Aggregated multicast MD request */
+    test21,     /* MD worker thread */
+    test22,     /* Next deadline, timer wake-up */
+    test23,     /* Session reactor */
     NULL
 };
 
@@ -18,6 +18,7 @@
  *
  * $Id$
  *
+ *      AG 2026-10-18: test22: publish/unpublish after tlc_updateSession keeps the send interval of the other telegrams
  *     CWE 2023-02-02: Analyzed parameters of main() echoed to screen output
  *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
  *      SB 2021-08-09: Compiler warnings
@@ -3493,6 +3494,147 @@ static int test21 ()
     CLEANUP;
 }
 
+/**********************************************************************************************************************/
+/** Incremental index updates (High Performance): publishers added and removed after tlc_updateSession must not
+ *  change the send timing of the other telegrams. The publisher callback is called for every sent telegram.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST22_CYCLE_TIME           10000u          /* 10ms */
+#define TEST22_COMID_BASE           2200u
+#define TEST22_NO_OF_BASE           8u              /* published before tlc_updateSession */
+#define TEST22_NO_OF_MORE           8u              /* published and partly unpublished afterwards */
+#define TEST22_NO_OF_TELEGRAMS      (TEST22_NO_OF_BASE + TEST22_NO_OF_MORE)
+#ifdef HIGH_PERF_INDEXED
+#define TEST22_MAX_DEVIATION        (TEST22_CYCLE_TIME / 2u)    /* a telegram keeps its slot */
+#else
+#define TEST22_MAX_DEVIATION        (TEST22_CYCLE_TIME * 3u / 2u)   /* the next send is due one interval after the last */
+#endif
+
+static struct
+{
+    UINT32          interval;
+    UINT32          count;                  /* sent while measuring */
+    UINT32          maxDeviation;           /* of the time between two sends from the interval, in us */
+    VOS_TIMEVAL_T   last;
+} gTest22Tx[TEST22_NO_OF_TELEGRAMS];
+
+static volatile BOOL8 gTest22Measure = FALSE;
+
+static void  test22CBPubFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    UINT32          idx = pMsg->comId - TEST22_COMID_BASE;
+    VOS_TIMEVAL_T   now;
+
+    if ((idx >= TEST22_NO_OF_TELEGRAMS) || !gTest22Measure)
+    {
+        return;
+    }
+    vos_getTime(&now);
+    if (gTest22Tx[idx].count > 0u)
+    {
+        VOS_TIMEVAL_T   delta   = now;
+        UINT32          deviation;
+
+        vos_subTime(&delta, &gTest22Tx[idx].last);
+        deviation = (UINT32) delta.tv_sec * 1000000u + (UINT32) delta.tv_usec;
+        deviation = (deviation > gTest22Tx[idx].interval) ? deviation - gTest22Tx[idx].interval
+                                                          : gTest22Tx[idx].interval - deviation;
+        if (deviation > gTest22Tx[idx].maxDeviation)
+        {
+            gTest22Tx[idx].maxDeviation = deviation;
+        }
+    }
+    gTest22Tx[idx].last = now;
+    gTest22Tx[idx].count++;
+}
+
+static int test22 ()
+{
+    PREPARE2("Publish and unpublish after tlc_updateSession, other telegrams keep their interval", "test",
+             TEST22_CYCLE_TIME);
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        /* 20, 50, 100 and 200ms, several telegrams in each slot table */
+        static const UINT32 intervals[] = {20000u, 50000u, 100000u, 200000u};
+
+        TRDP_PUB_T  pubHandle[TEST22_NO_OF_TELEGRAMS];
+        BOOL8       removed[TEST22_NO_OF_TELEGRAMS];
+        UINT8       data[64] = "Hello World!";
+        UINT32      i;
+
+        memset(gTest22Tx, 0, sizeof(gTest22Tx));
+        memset(removed, 0, sizeof(removed));
+        gTest22Measure = FALSE;
+
+        for (i = 0; i < TEST22_NO_OF_TELEGRAMS; i++)
+        {
+            gTest22Tx[i].interval = intervals[i % 4u];
+            if (i == TEST22_NO_OF_BASE)
+            {
+                err = tlc_updateSession(gSession1.appHandle);
+                IF_ERROR("tlc_updateSession");
+
+                /* the base telegrams run for a while, then the others are added while they keep running */
+                gTest22Measure = TRUE;
+                vos_threadDelay(1000000u);
+            }
+            err = tlp_publish(gSession1.appHandle, &pubHandle[i], NULL, test22CBPubFunction, 0u,
+                              TEST22_COMID_BASE + i, 0u, 0u,
+                              0u, gSession2.ifaceIP,
+                              gTest22Tx[i].interval,
+                              0u, TRDP_FLAGS_CALLBACK, NULL, data, sizeof(data));
+            IF_ERROR("tlp_publish");
+        }
+        vos_threadDelay(1000000u);
+
+        /* remove the first base telegram and every other added one, the gaps in their slots must be closed */
+        for (i = 0; i < TEST22_NO_OF_TELEGRAMS; i += 2u)
+        {
+            if ((i > 0u) && (i < TEST22_NO_OF_BASE))
+            {
+                continue;
+            }
+            err = tlp_unpublish(gSession1.appHandle, pubHandle[i]);
+            IF_ERROR("tlp_unpublish");
+            removed[i] = TRUE;
+        }
+        vos_threadDelay(2000000u);
+        gTest22Measure = FALSE;
+
+        for (i = 0; i < TEST22_NO_OF_TELEGRAMS; i++)
+        {
+            /* the base telegrams were measured for 4s, the added ones for 3s */
+            UINT32 minCount = ((i < TEST22_NO_OF_BASE) ? 4000000u : 3000000u) / gTest22Tx[i].interval - 2u;
+
+            fprintf(gFp, "ComId %u: interval %u us, sent %u times, max. deviation %u us%s\n",
+                    TEST22_COMID_BASE + i, gTest22Tx[i].interval, gTest22Tx[i].count, gTest22Tx[i].maxDeviation,
+                    removed[i] ? " (removed)" : "");
+            if (!removed[i] &&
+                ((gTest22Tx[i].count < minCount) || (gTest22Tx[i].maxDeviation > TEST22_MAX_DEVIATION)))
+            {
+                gFailed = 1;
+            }
+        }
+        if (gFailed)
+        {
+            FAILED("telegrams lost or shifted by publish / unpublish");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
 
 /**********************************************************************************************************************/
 /* This array holds pointers to the m-th test (m = 1 will execute test1...)                                           */
@@ -3522,6 +3664,7 @@ test_func_t *testArray[] =
     test19,  /* Basic test of PD send performance enhancement */
     test20,  /* Basic test of PD receive performance enhancement */
     test21,  /* Basic test of PD send/receive performance enhancement, unpublish/unsubscribe while operating */
+    test22,  /* Publish/unpublish after tlc_updateSession keeps the send interval of the other telegrams */
     NULL
 };
 
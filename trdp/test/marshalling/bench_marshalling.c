@@ -0,0 +1,568 @@
+/**********************************************************************************************************************/
+/**
+ * @file            bench_marshalling.c
+ *
+ * @brief           Throughput benchmark of the marshalling functions
+ *
+ * @details         Measures marshall, unmarshall and size calculation of tau_marshall.c and tau_xmarshall.c
+ *                  for some typical dataset shapes: flat scalars, large arrays, nested datasets, variable sized
+ *                  arrays and strings. Every shape is checked for a lossless round trip and for both marshallers
+ *                  producing the same wire data before it is timed.
+ *                  The results are printed as a table, with -o additionally written as CSV for tracking.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+ /*
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "tau_marshall.h"
+#include "tau_xmarshall.h"
+#include "tau_xmarshall_map.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define BENCH_BYTES_PER_RUN     (64u * 1024u * 1024u)   /* default work per measurement, in wire bytes  */
+#define BENCH_MIN_LOOPS         1000u
+#define BENCH_MAX_LOOPS         2000000u
+#define BENCH_BUF_SIZE          16384u
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/*  Host structures of the shapes, laid out as the default marshalling expects them  */
+
+typedef struct
+{
+    BOOL8       a;
+    CHAR8       b;
+    INT16       c;
+    INT32       d;
+    INT64       e;
+    UINT8       f;
+    UINT16      g;
+    UINT32      h;
+    UINT64      i;
+    REAL32      j;
+    REAL64      k;
+    TIMEDATE32  l;
+    TIMEDATE64  m;
+} BENCH_FLAT_T;
+
+typedef struct
+{
+    UINT32  u32[1024];
+    INT16   i16[512];
+    REAL64  r64[128];
+} BENCH_ARRAY_T;
+
+typedef struct
+{
+    UINT16  a;
+    UINT32  b[4];
+    REAL32  c;
+} BENCH_LEAF_T;
+
+typedef struct
+{
+    BENCH_LEAF_T    leaf[4];
+    UINT8           x;
+} BENCH_MID_T;
+
+typedef struct
+{
+    UINT32      id;
+    BENCH_MID_T mid[4];
+    UINT64      z;
+} BENCH_NESTED_T;
+
+typedef struct
+{
+    UINT16  n;
+    UINT32  a[256];
+    UINT8   m;
+    INT16   b[64];
+} BENCH_VAR_T;
+
+typedef struct
+{
+    CHAR8   name[256];
+    UTF16   text[128];
+    CHAR8   tag[16];
+} BENCH_STRING_T;
+
+/** One dataset shape to measure */
+typedef struct
+{
+    const CHAR8 *name;          /**< shape name used in the report      */
+    UINT32      comId;          /**< ComId, mapped to the dataset       */
+    UINT8       *pHost;         /**< filled host structure              */
+    UINT32      hostSize;       /**< its size                           */
+} BENCH_SHAPE_T;
+
+/** Function set of one marshaller */
+typedef struct
+{
+    const CHAR8         *name;
+    TRDP_MARSHALL_T     marshall;
+    TRDP_UNMARSHALL_T   unmarshall;
+    TRDP_ERR_T          (*calcSize)(void *, UINT32, UINT8 *, UINT32, UINT32 *, TRDP_DATASET_T * *);
+} BENCH_MARSHALLER_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+/*  Datasets  */
+
+static TRDP_DATASET_T   sDsFlat =
+{
+    3001, 0, 13, {'\0'},
+    {
+        {TRDP_BOOL8, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_CHAR8, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_INT16, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_INT32, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_INT64, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_UINT8, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_UINT16, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_UINT32, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_UINT64, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_REAL32, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_REAL64, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_TIMEDATE32, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_TIMEDATE64, 1, NULL, NULL, 0, 0, NULL}
+    }
+};
+
+static TRDP_DATASET_T   sDsArray =
+{
+    3002, 0, 3, {'\0'},
+    {
+        {TRDP_UINT32, 1024, NULL, NULL, 0, 0, NULL},
+        {TRDP_INT16, 512, NULL, NULL, 0, 0, NULL},
+        {TRDP_REAL64, 128, NULL, NULL, 0, 0, NULL}
+    }
+};
+
+static TRDP_DATASET_T   sDsNested =
+{
+    3003, 0, 3, {'\0'},
+    {
+        {TRDP_UINT32, 1, NULL, NULL, 0, 0, NULL},
+        {3004, 4, NULL, NULL, 0, 0, NULL},
+        {TRDP_UINT64, 1, NULL, NULL, 0, 0, NULL}
+    }
+};
+
+static TRDP_DATASET_T   sDsMid =
+{
+    3004, 0, 2, {'\0'},
+    {
+        {3005, 4, NULL, NULL, 0, 0, NULL},
+        {TRDP_UINT8, 1, NULL, NULL, 0, 0, NULL}
+    }
+};
+
+static TRDP_DATASET_T   sDsLeaf =
+{
+    3005, 0, 3, {'\0'},
+    {
+        {TRDP_UINT16, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_UINT32, 4, NULL, NULL, 0, 0, NULL},
+        {TRDP_REAL32, 1, NULL, NULL, 0, 0, NULL}
+    }
+};
+
+static TRDP_DATASET_T   sDsVar =
+{
+    3006, 0, 4, {'\0'},
+    {
+        {TRDP_UINT16, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_UINT32, TRDP_VAR_SIZE, NULL, NULL, 0, 0, NULL},
+        {TRDP_UINT8, 1, NULL, NULL, 0, 0, NULL},
+        {TRDP_INT16, TRDP_VAR_SIZE, NULL, NULL, 0, 0, NULL}
+    }
+};
+
+static TRDP_DATASET_T   sDsString =
+{
+    3007, 0, 3, {'\0'},
+    {
+        {TRDP_CHAR8, 256, NULL, NULL, 0, 0, NULL},
+        {TRDP_UTF16, 128, NULL, NULL, 0, 0, NULL},
+        {TRDP_CHAR8, 16, NULL, NULL, 0, 0, NULL}
+    }
+};
+
+static TRDP_DATASET_T   *sDataSets[] =
+{
+    &sDsFlat, &sDsArray, &sDsNested, &sDsMid, &sDsLeaf, &sDsVar, &sDsString
+};
+
+static TRDP_COMID_DSID_MAP_T sComIdMap[] =
+{
+    {3001, 3001}, {3002, 3002}, {3003, 3003}, {3006, 3006}, {3007, 3007}
+};
+
+/*  Type map making xmarshall lay out the host structures like the default marshalling  */
+DEFINE_TAU_XMARSHALL_MAP(sXTypeMap, UINT8, CHAR8, UTF16, INT8, INT16, INT32, INT64, UINT8, UINT16, UINT32, UINT64,
+                         REAL32, REAL64, UINT32, UINT16, INT32);
+
+/*  Host data  */
+static BENCH_FLAT_T     sFlat;
+static BENCH_ARRAY_T    sArray;
+static BENCH_NESTED_T   sNested;
+static BENCH_VAR_T      sVar;
+static BENCH_STRING_T   sString;
+
+static BENCH_SHAPE_T    sShapes[] =
+{
+    {"flat",    3001, (UINT8 *) &sFlat,     sizeof(sFlat)},
+    {"array",   3002, (UINT8 *) &sArray,    sizeof(sArray)},
+    {"nested",  3003, (UINT8 *) &sNested,   sizeof(sNested)},
+    {"var",     3006, (UINT8 *) &sVar,      sizeof(sVar)},
+    {"string",  3007, (UINT8 *) &sString,   sizeof(sString)}
+};
+
+static const BENCH_MARSHALLER_T sMarshallers[] =
+{
+    {"tau_marshall",  tau_marshall,  tau_unmarshall,  tau_calcDatasetSizeByComId},
+    {"tau_xmarshall", tau_xmarshall, tau_xunmarshall, tau_xcalcDatasetSizeByComId}
+};
+
+static void             *sRefCon[2];    /* marshalling context per marshaller */
+
+/*  Buffers, aligned for any host structure  */
+static UINT64           sWire[BENCH_BUF_SIZE / sizeof(UINT64)];
+static UINT64           sHost[BENCH_BUF_SIZE / sizeof(UINT64)];
+static UINT64           sRefWire[BENCH_BUF_SIZE / sizeof(UINT64)];
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Fill the host structures with values that survive a round trip.
+ */
+static void fillShapes (void)
+{
+    UINT32 i, j, k;
+
+    memset(&sFlat, 0, sizeof(sFlat));
+    sFlat.a         = 1;
+    sFlat.b         = 'x';
+    sFlat.c         = -1234;
+    sFlat.d         = -12345678;
+    sFlat.e         = -1234567890123ll;
+    sFlat.f         = 0xA5;
+    sFlat.g         = 0xBEEF;
+    sFlat.h         = 0xDEADBEEFu;
+    sFlat.i         = 0x0123456789ABCDEFull;
+    sFlat.j         = 3.25f;
+    sFlat.k         = -2.5e100;
+    sFlat.l         = 1700000000u;
+    sFlat.m.tv_sec  = 1700000001u;
+    sFlat.m.tv_usec = 999999;
+
+    for (i = 0u; i < 1024u; i++)
+    {
+        sArray.u32[i] = i * 2654435761u;
+    }
+    for (i = 0u; i < 512u; i++)
+    {
+        sArray.i16[i] = (INT16) (i * 31u);
+    }
+    for (i = 0u; i < 128u; i++)
+    {
+        sArray.r64[i] = i * 0.125;
+    }
+
+    memset(&sNested, 0, sizeof(sNested));
+    sNested.id  = 42u;
+    sNested.z   = 0xFEDCBA9876543210ull;
+    for (i = 0u; i < 4u; i++)
+    {
+        sNested.mid[i].x = (UINT8) i;
+        for (j = 0u; j < 4u; j++)
+        {
+            sNested.mid[i].leaf[j].a = (UINT16) (i * 4u + j);
+            sNested.mid[i].leaf[j].c = (REAL32) j / 3.0f;
+            for (k = 0u; k < 4u; k++)
+            {
+                sNested.mid[i].leaf[j].b[k] = i << 16u | j << 8u | k;
+            }
+        }
+    }
+
+    memset(&sVar, 0, sizeof(sVar));
+    sVar.n = 256u;
+    sVar.m = 64u;
+    for (i = 0u; i < 256u; i++)
+    {
+        sVar.a[i] = ~i;
+    }
+    for (i = 0u; i < 64u; i++)
+    {
+        sVar.b[i] = (INT16) -i;
+    }
+
+    memset(&sString, 0, sizeof(sString));
+    for (i = 0u; i < sizeof(sString.name) - 1u; i++)
+    {
+        sString.name[i] = (CHAR8) ('a' + i % 26u);
+    }
+    for (i = 0u; i < 127u; i++)
+    {
+        sString.text[i] = (UTF16) (0x0410u + i % 32u);
+    }
+    strcpy(sString.tag, "bench");
+}
+
+/**********************************************************************************************************************/
+/**    Return microseconds elapsed since start.
+ */
+static UINT64 elapsedUs (
+    const VOS_TIMEVAL_T *pStart)
+{
+    VOS_TIMEVAL_T now;
+
+    vos_getTime(&now);
+    vos_subTime(&now, pStart);
+    return (UINT64) now.tv_sec * 1000000u + (UINT64) now.tv_usec;
+}
+
+/**********************************************************************************************************************/
+/**    Check a shape: lossless round trip, size calculation, wire data equal to the reference in sRefWire.
+ *
+ *  @retval         0 if ok
+ */
+static int checkShape (
+    UINT32              m,
+    const BENCH_SHAPE_T *pShape,
+    UINT32              refSize)
+{
+    const BENCH_MARSHALLER_T    *pM         = &sMarshallers[m];
+    TRDP_DATASET_T              *pCached    = NULL;
+    UINT32                      wireSize    = sizeof(sWire);
+    UINT32                      hostSize    = sizeof(sHost);
+    UINT32                      calcSize    = 0u;
+    TRDP_ERR_T                  err;
+
+    err = pM->marshall(sRefCon[m], pShape->comId, pShape->pHost, pShape->hostSize, (UINT8 *) sWire, &wireSize,
+                       &pCached);
+    if (err != TRDP_NO_ERR)
+    {
+        printf("%s %s: marshall returns %d\n", pM->name, pShape->name, err);
+        return 1;
+    }
+    memset(sHost, 0, sizeof(sHost));
+    err = pM->unmarshall(sRefCon[m], pShape->comId, (UINT8 *) sWire, wireSize, (UINT8 *) sHost, &hostSize, &pCached);
+    /* xunmarshall does not count the trailing padding of the structure */
+    if ((err != TRDP_NO_ERR) || (hostSize > pShape->hostSize) ||
+        (memcmp(sHost, pShape->pHost, pShape->hostSize) != 0))
+    {
+        printf("%s %s: round trip differs (%d, %u/%u bytes)\n", pM->name, pShape->name, err, hostSize,
+               pShape->hostSize);
+        return 1;
+    }
+    err = pM->calcSize(sRefCon[m], pShape->comId, (UINT8 *) sWire, wireSize, &calcSize, &pCached);
+    if ((err != TRDP_NO_ERR) || (calcSize != pShape->hostSize))
+    {
+        printf("%s %s: size calculation wrong (%d, %u/%u bytes)\n", pM->name, pShape->name, err, calcSize,
+               pShape->hostSize);
+        return 1;
+    }
+    if ((wireSize != refSize) || (memcmp(sRefWire, sWire, wireSize) != 0))
+    {
+        printf("%s %s: wire data differs from %s\n", pM->name, pShape->name, sMarshallers[0].name);
+        return 1;
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/**    Time one operation of one marshaller on one shape.
+ *
+ *  @retval         elapsed microseconds
+ */
+static UINT64 timeOp (
+    UINT32              m,
+    const BENCH_SHAPE_T *pShape,
+    UINT32              wireSize,
+    int                 op,
+    UINT32              loops)
+{
+    const BENCH_MARSHALLER_T    *pM         = &sMarshallers[m];
+    TRDP_DATASET_T              *pCached    = NULL;
+    VOS_TIMEVAL_T               start;
+    UINT32                      size;
+    UINT32                      i;
+
+    vos_getTime(&start);
+    switch (op)
+    {
+       case 0:
+           for (i = 0u; i < loops; i++)
+           {
+               size = sizeof(sWire);
+               (void) pM->marshall(sRefCon[m], pShape->comId, pShape->pHost, pShape->hostSize, (UINT8 *) sWire,
+                                   &size, &pCached);
+           }
+           break;
+       case 1:
+           for (i = 0u; i < loops; i++)
+           {
+               size = sizeof(sHost);
+               (void) pM->unmarshall(sRefCon[m], pShape->comId, (UINT8 *) sRefWire, wireSize, (UINT8 *) sHost,
+                                     &size, &pCached);
+           }
+           break;
+       default:
+           for (i = 0u; i < loops; i++)
+           {
+               (void) pM->calcSize(sRefCon[m], pShape->comId, (UINT8 *) sRefWire, wireSize, &size, &pCached);
+           }
+           break;
+    }
+    return elapsedUs(&start);
+}
+
+/**********************************************************************************************************************/
+/**    Print usage
+ */
+static void usage (
+    const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Measures the throughput of tau_marshall and tau_xmarshall for typical dataset shapes.\n"
+           "Arguments are:\n"
+           "-n <loops>     fixed number of loops per measurement (default: %u MB of wire data)\n"
+           "-o <file>      write the results as CSV to file, '-' for stdout\n"
+           "-h             print usage\n", BENCH_BYTES_PER_RUN / (1024u * 1024u));
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+int main (
+    int     argc,
+    char    *argv[])
+{
+    static const CHAR8  *cOpNames[] = {"marshall", "unmarshall", "size"};
+    UINT32              fixedLoops  = 0u;
+    const char          *pCsvName   = NULL;
+    FILE                *pCsv       = NULL;
+    UINT32              wireSize[sizeof(sShapes) / sizeof(sShapes[0])];
+    UINT32              m, s;
+    int                 op, ch;
+
+    while ((ch = getopt(argc, argv, "n:o:h")) != -1)
+    {
+        switch (ch)
+        {
+           case 'n':
+               fixedLoops = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'o':
+               pCsvName = optarg;
+               break;
+           case 'h':
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+
+    if ((tau_initMarshall(&sRefCon[0], sizeof(sComIdMap) / sizeof(sComIdMap[0]), sComIdMap,
+                          sizeof(sDataSets) / sizeof(sDataSets[0]), sDataSets) != TRDP_NO_ERR) ||
+        (tau_xinitMarshall(&sRefCon[1], sizeof(sComIdMap) / sizeof(sComIdMap[0]), sComIdMap,
+                           sizeof(sDataSets) / sizeof(sDataSets[0]), sDataSets, sXTypeMap) != TRDP_NO_ERR))
+    {
+        printf("Marshalling initialisation failed\n");
+        return 1;
+    }
+    sRefCon[1] = NULL;      /* xmarshall has no context of its own */
+
+    fillShapes();
+
+    if (pCsvName != NULL)
+    {
+        pCsv = (strcmp(pCsvName, "-") == 0) ? stdout : fopen(pCsvName, "w");
+        if (pCsv == NULL)
+        {
+            printf("Cannot open %s\n", pCsvName);
+            return 1;
+        }
+        fprintf(pCsv, "marshaller,shape,operation,wire_bytes,host_bytes,loops,ns_per_telegram,mb_per_s\n");
+    }
+
+    printf("%-14s %-8s %-10s %7s %7s %9s %12s %10s\n",
+           "marshaller", "shape", "operation", "wire", "host", "loops", "ns/telegram", "MB/s");
+
+    for (m = 0u; m < sizeof(sMarshallers) / sizeof(sMarshallers[0]); m++)
+    {
+        for (s = 0u; s < sizeof(sShapes) / sizeof(sShapes[0]); s++)
+        {
+            const BENCH_SHAPE_T *pShape = &sShapes[s];
+            UINT32              loops;
+
+            /* the default marshalling is the reference for the wire data */
+            wireSize[s] = sizeof(sRefWire);
+            if ((tau_marshall(sRefCon[0], pShape->comId, pShape->pHost, pShape->hostSize, (UINT8 *) sRefWire,
+                              &wireSize[s], NULL) != TRDP_NO_ERR) ||
+                (checkShape(m, pShape, wireSize[s]) != 0))
+            {
+                printf("%s %s: check failed\n", sMarshallers[m].name, pShape->name);
+                return 1;
+            }
+
+            loops = fixedLoops;
+            if (loops == 0u)
+            {
+                loops = BENCH_BYTES_PER_RUN / wireSize[s];
+                loops = (loops < BENCH_MIN_LOOPS) ? BENCH_MIN_LOOPS : ((loops > BENCH_MAX_LOOPS) ? BENCH_MAX_LOOPS : loops);
+            }
+
+            for (op = 0; op < 3; op++)
+            {
+                UINT64  us = timeOp(m, pShape, wireSize[s], op, loops);
+                double  ns = (double) us * 1000.0 / loops;
+                double  mbs = (us > 0u) ? ((double) wireSize[s] * loops) / (double) us : 0.0;
+
+                printf("%-14s %-8s %-10s %7u %7u %9u %12.1f %10.1f\n",
+                       sMarshallers[m].name, pShape->name, cOpNames[op], wireSize[s], pShape->hostSize, loops, ns, mbs);
+                if (pCsv != NULL)
+                {
+                    fprintf(pCsv, "%s,%s,%s,%u,%u,%u,%.1f,%.1f\n",
+                            sMarshallers[m].name, pShape->name, cOpNames[op], wireSize[s], pShape->hostSize, loops,
+                            ns, mbs);
+                }
+            }
+        }
+    }
+
+    if ((pCsv != NULL) && (pCsv != stdout))
+    {
+        fclose(pCsv);
+    }
+    (void) tau_deInitMarshall(sRefCon[0]);
+    return 0;
+}
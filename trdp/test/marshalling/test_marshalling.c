@@ -16,6 +16,10 @@
  *
  * $Id$
  *
+ *      AG 2026-10-18: Memoized dataset sizes checked against the interpreted unmarshalling
+ *      AG 2026-10-18: Second marshalling context with its own ComId mapping
+ *      AG 2026-10-18: Byte swap kernels checked against each other, timing of large arrays
+ *      AG 2026-10-18: Compiled plans checked against the interpreter, timing of both
  *      IB 2021-08-09: Ticket #374 'init added for TRDP_EXTRA_LABEL_T name' in datasets using TRDP_DATASET_T
  *      SB 2019-05-24: Ticket #252 Bug in unmarshalling/marshalling of TIMEDATE48 and TIMEDATE64
  *      BL 2018-09-05: Ticket #211 XML handling: Dataset Name should be stored in TRDP_DATASET_ELEMENT_T
@@ -25,6 +29,10 @@
 #include <stdio.h>
 #include <string.h>
 #include "tau_marshall.h"
+#include "tau_bswap.h"
+#include "vos_thread.h"
+
+#define TEST_LOOPS  100000u
 
 /*    Test data sets    */
 TRDP_DATASET_T  gDataSet1990 =
@@ -1061,6 +1069,247 @@ static int __unused test2()
     return 0;
 }
 
+/***********************************************************************************************************************
+    Compare compiled plans with the interpreter and time both
+***********************************************************************************************************************/
+static UINT32 timeMarshalling (UINT32 comId, UINT8 *pData, UINT32 dataSize, UINT8 *pCopy)
+{
+    VOS_TIMEVAL_T   start, end;
+    UINT32          i;
+    UINT32          bufSize, bufSize2;
+
+    vos_getTime(&start);
+    for (i = 0; i < TEST_LOOPS; i++)
+    {
+        bufSize = sizeof(gDstDataBuffer);
+        (void) tau_marshall(gpRefCon, comId, pData, dataSize, gDstDataBuffer, &bufSize, NULL);
+        bufSize2 = dataSize;
+        (void) tau_unmarshall(gpRefCon, comId, gDstDataBuffer, bufSize, pCopy, &bufSize2, NULL);
+    }
+    vos_getTime(&end);
+    vos_subTime(&end, &start);
+    return (UINT32) end.tv_sec * 1000000u + (UINT32) end.tv_usec;
+}
+
+static int compareWithInterpreter (UINT32 comId, UINT8 *pData, UINT32 dataSize)
+{
+    static UINT64   wireBuf[2][1504 / sizeof(UINT64)];     /* size calculation aligns like the host structure */
+    static UINT64   hostBuf[2][1504 / sizeof(UINT64)];
+    UINT32          wireSize[2], hostSize[2], calcSize[2];
+    int             pass;
+    TRDP_ERR_T      err;
+
+    /*  Pass 0 interprets the dataset, pass 1 runs the compiled plan  */
+    for (pass = 0; pass < 2; pass++)
+    {
+        tau_enableMarshallPlans(gpRefCon, pass == 1);
+
+        wireSize[pass] = sizeof(wireBuf[pass]);
+        err = tau_marshall(gpRefCon, comId, pData, dataSize, (UINT8 *) wireBuf[pass], &wireSize[pass], NULL);
+        if (err != TRDP_NO_ERR)
+        {
+            printf("tau_marshall returns error %d\n", err);
+            return 1;
+        }
+        hostSize[pass] = sizeof(hostBuf[pass]);
+        memset(hostBuf[pass], 0, sizeof(hostBuf[pass]));
+        err = tau_unmarshall(gpRefCon, comId, (UINT8 *) wireBuf[pass], wireSize[pass], (UINT8 *) hostBuf[pass],
+                             &hostSize[pass], NULL);
+        if (err != TRDP_NO_ERR)
+        {
+            printf("tau_unmarshall returns error %d\n", err);
+            return 1;
+        }
+        err = tau_calcDatasetSizeByComId(gpRefCon, comId, (UINT8 *) wireBuf[pass], wireSize[pass], &calcSize[pass],
+                                         NULL);
+        if (err != TRDP_NO_ERR)
+        {
+            printf("tau_calcDatasetSizeByComId returns error %d\n", err);
+            return 1;
+        }
+    }
+
+    if ((wireSize[0] != wireSize[1]) || (memcmp(wireBuf[0], wireBuf[1], wireSize[0]) != 0) ||
+        (hostSize[0] != hostSize[1]) || (memcmp(hostBuf[0], hostBuf[1], sizeof(hostBuf[0])) != 0) ||
+        (calcSize[0] != calcSize[1]) || (calcSize[1] != hostSize[0]))
+    {
+        printf("ComId %u: compiled plan and interpreter differ!\n", comId);
+        return 1;
+    }
+    printf("ComId %u: compiled plan and interpreter matched (wire %u, host %u bytes)\n",
+           comId, wireSize[1], hostSize[1]);
+    return 0;
+}
+
+static void timeWithInterpreter (UINT32 comId, UINT8 *pData, UINT32 dataSize, UINT8 *pCopy)
+{
+    UINT32 usec[2];
+
+    tau_enableMarshallPlans(gpRefCon, FALSE);
+    usec[0] = timeMarshalling(comId, pData, dataSize, pCopy);
+    tau_enableMarshallPlans(gpRefCon, TRUE);
+    usec[1] = timeMarshalling(comId, pData, dataSize, pCopy);
+    printf("ComId %u, %u x marshall + unmarshall: interpreted %u us, compiled %u us\n",
+           comId, TEST_LOOPS, usec[0], usec[1]);
+}
+
+static int test3()
+{
+    gMyDataSet2003.c = gMyDataSet2002;
+
+    if ((compareWithInterpreter(1000, (UINT8 *) &gMyDataSet1000, sizeof(gMyDataSet1000)) != 0) ||
+        (compareWithInterpreter(1001, (UINT8 *) &gMyDataSet1001, sizeof(gMyDataSet1001)) != 0) ||
+        (compareWithInterpreter(2003, (UINT8 *) &gMyDataSet2003, sizeof(gMyDataSet2003)) != 0))
+    {
+        return 1;
+    }
+
+    timeWithInterpreter(1000, (UINT8 *) &gMyDataSet1000, sizeof(gMyDataSet1000), (UINT8 *) &gMyDataSet1000Copy);
+    timeWithInterpreter(1001, (UINT8 *) &gMyDataSet1001, sizeof(gMyDataSet1001), (UINT8 *) &gMyDataSet1001Copy);
+    timeWithInterpreter(2003, (UINT8 *) &gMyDataSet2003, sizeof(gMyDataSet2003), (UINT8 *) &gMyDataSet2003Copy);
+
+    if (memcmp(&gMyDataSet2003, &gMyDataSet2003Copy, sizeof(gMyDataSet2003)) != 0)
+    {
+        printf("Something's wrong in the state of Marshalling!\n");
+        return 1;
+    }
+    return 0;
+}
+
+/***********************************************************************************************************************
+    Check the byte swap kernels against a plain byte reversal and time them on a large array
+***********************************************************************************************************************/
+static int test4()
+{
+    static UINT8        src[4096 * 8 + 1];
+    static UINT8        dst[4096 * 8 + 1];
+    TAU_BSWAP_KERNEL_T  kernel;
+    UINT32              itemSize, noOfItems, i, j;
+    VOS_TIMEVAL_T       start, end;
+
+    for (i = 0; i < sizeof(src); i++)
+    {
+        src[i] = (UINT8) (i * 7u + 3u);
+    }
+
+    for (kernel = TAU_BSWAP_SCALAR; kernel <= TAU_BSWAP_NEON; kernel++)
+    {
+        if (tau_bswapSelect(kernel) != TRDP_NO_ERR)
+        {
+            continue;
+        }
+
+        /*  all sizes around the vector widths, from an odd address  */
+        for (itemSize = 2; itemSize <= 8; itemSize *= 2)
+        {
+            for (noOfItems = 0; noOfItems < 80; noOfItems++)
+            {
+                memset(dst, 0, noOfItems * itemSize + 1);
+                switch (itemSize)
+                {
+                   case 2:  tau_netCopy16(dst, src + 1, noOfItems); break;
+                   case 4:  tau_netCopy32(dst, src + 1, noOfItems); break;
+                   default: tau_netCopy64(dst, src + 1, noOfItems); break;
+                }
+                for (i = 0; i < noOfItems; i++)
+                {
+                    for (j = 0; j < itemSize; j++)
+                    {
+#ifdef B_ENDIAN
+                        if (dst[i * itemSize + j] != src[1 + i * itemSize + j])
+#else
+                        if (dst[i * itemSize + j] != src[1 + i * itemSize + itemSize - 1 - j])
+#endif
+                        {
+                            printf("Kernel %s wrong for %u items of %u bytes\n", tau_bswapKernelName(), noOfItems, itemSize);
+                            return 1;
+                        }
+                    }
+                }
+                if (dst[noOfItems * itemSize] != 0)
+                {
+                    printf("Kernel %s writes beyond %u items of %u bytes\n", tau_bswapKernelName(), noOfItems, itemSize);
+                    return 1;
+                }
+            }
+        }
+
+        vos_getTime(&start);
+        for (i = 0; i < TEST_LOOPS / 10; i++)
+        {
+            tau_netCopy32(dst, src, 4096);
+        }
+        vos_getTime(&end);
+        vos_subTime(&end, &start);
+        printf("Kernel %-6s: %u x 4096 UINT32 in %u us\n", tau_bswapKernelName(), TEST_LOOPS / 10,
+               (UINT32) end.tv_sec * 1000000u + (UINT32) end.tv_usec);
+    }
+
+    (void) tau_bswapSelect(TAU_BSWAP_AUTO);
+    return 0;
+}
+
+/***********************************************************************************************************************
+    A second context maps ComId 1000 to dataset 1001, the first one must not be affected
+***********************************************************************************************************************/
+static int test5()
+{
+    static TRDP_COMID_DSID_MAP_T    comIdMap2[] = {{1000, 1001}};
+    static TRDP_DATASET_T           *dataSets2[] = {&gDataSet1001};
+    static UINT8                    wire2[1500];
+    void        *pRefCon2 = NULL;
+    void        *pOldRefCon;
+    UINT32      bufSize, bufSize2;
+    TRDP_ERR_T  err;
+
+    err = tau_initMarshall(&pRefCon2, 1, comIdMap2, 1, dataSets2);
+    if (err != TRDP_NO_ERR)
+    {
+        printf("tau_initMarshall for the second context returns error %d\n", err);
+        return 1;
+    }
+
+    bufSize = sizeof(gDstDataBuffer);
+    err = tau_marshall(gpRefCon, 1001, (UINT8 *) &gMyDataSet1001, sizeof(gMyDataSet1001), gDstDataBuffer, &bufSize, NULL);
+    bufSize2 = sizeof(wire2);
+    err |= tau_marshall(pRefCon2, 1000, (UINT8 *) &gMyDataSet1001, sizeof(gMyDataSet1001), wire2, &bufSize2, NULL);
+    if ((err != TRDP_NO_ERR) || (bufSize != bufSize2) || (memcmp(gDstDataBuffer, wire2, bufSize) != 0))
+    {
+        printf("Second context marshalls differently (%d, %u/%u bytes)\n", err, bufSize, bufSize2);
+        return 1;
+    }
+
+    bufSize2 = sizeof(wire2);
+    if (tau_marshall(pRefCon2, 1001, (UINT8 *) &gMyDataSet1001, sizeof(gMyDataSet1001), wire2, &bufSize2, NULL)
+        != TRDP_COMID_ERR)
+    {
+        printf("Second context knows a ComId it was not given\n");
+        return 1;
+    }
+
+    /*  Initialising into the same variable again releases the context it holds  */
+    pOldRefCon = pRefCon2;
+    err = tau_initMarshall(&pRefCon2, 1, comIdMap2, 1, dataSets2);
+    if ((err != TRDP_NO_ERR) || (pRefCon2 == pOldRefCon) || (tau_deInitMarshall(pOldRefCon) != TRDP_PARAM_ERR))
+    {
+        printf("Re-initialising the second context does not release the previous one (%d)\n", err);
+        return 1;
+    }
+
+    (void) tau_deInitMarshall(pRefCon2);
+
+    /*  The first context still works  */
+    bufSize = sizeof(gDstDataBuffer);
+    err = tau_marshall(gpRefCon, 1000, (UINT8 *) &gMyDataSet1000, sizeof(gMyDataSet1000), gDstDataBuffer, &bufSize, NULL);
+    if (err != TRDP_NO_ERR)
+    {
+        printf("First context fails after releasing the second one (%d)\n", err);
+        return 1;
+    }
+    printf("Second marshalling context ok\n");
+    return 0;
+}
+
 /******/
 int main ()
 {
@@ -1070,8 +1319,16 @@ int main ()
 
     if (err == TRDP_NO_ERR)
     {
-        return test1();
+        if (test1() != 0)
+        {
+            return 1;
+        }
         //return test2();
+        if ((test3() != 0) || (test4() != 0))
+        {
+            return 1;
+        }
+        return test5();
     }
     return 1;
 }
@@ -0,0 +1,433 @@
+/**********************************************************************************************************************/
+/**
+ * @file            bench_pdshard.c
+ *
+ * @brief           Throughput benchmark of sharded PD sending
+ *
+ * @details         Publishes a load of cyclic telegrams over the loopback interface, like trdp-pd-test-fast does,
+ *                  and sends it once by tlp_processSend() in the application loop and then by 1, 2, 4... sender
+ *                  threads (tlp_startSenders()). A plain UDP socket receives the telegrams and supervises the
+ *                  interval of every ComId: an arrival later than 1.5 intervals after the previous one counts as
+ *                  late. Reported are the packets per second achieved against the expected rate, lost and late
+ *                  telegrams and the longest gap seen.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+ /*
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+#include "vos_sock.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define BENCH_COMID_BASE        20000u      /* ComId of the first publisher                     */
+#define BENCH_MAX_PUBS          4096u
+#define BENCH_MAX_RUNS          8u
+#define BENCH_WARMUP            300000u     /* us before counting starts                        */
+#define BENCH_PD_PORT           17224u
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Receive state of one ComId */
+typedef struct
+{
+    VOS_TIMEVAL_T   last;               /**< arrival of the previous telegram, 0 before the first   */
+    UINT32          received;           /**< telegrams counted                                      */
+    UINT32          late;               /**< arrivals later than 1.5 intervals                      */
+    UINT32          maxGap;             /**< longest gap between two arrivals (us)                  */
+} BENCH_SINK_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static BENCH_SINK_T     sSink[BENCH_MAX_PUBS];
+static TRDP_PUB_T       sPub[BENCH_MAX_PUBS];
+static UINT8            sData[TRDP_MAX_PD_DATA_SIZE];
+static UINT64           sRxBuffer[(TRDP_MAX_PD_PACKET_SIZE + 7u) / 8u];
+static volatile UINT32  sStop;
+static volatile UINT32  sCounting;
+static VOS_SEMA_T       sRxDone;
+static VOS_SOCK_T       sRxSock = VOS_INVALID_SOCKET;
+static UINT32           sNoOfPubs   = 200u;
+static UINT32           sInterval   = 10000u;
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Print warnings and errors of the stack, only.
+ */
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      lineNumber,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    (void) pTime;
+    (void) pFile;
+    (void) lineNumber;
+    if (category <= VOS_LOG_WARNING)
+    {
+        printf("%s", pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Return microseconds from pFrom to pTo.
+ */
+static UINT32 diffUs (
+    const VOS_TIMEVAL_T *pTo,
+    const VOS_TIMEVAL_T *pFrom)
+{
+    VOS_TIMEVAL_T diff = *pTo;
+
+    vos_subTime(&diff, pFrom);
+    return (UINT32) diff.tv_sec * 1000000u + (UINT32) diff.tv_usec;
+}
+
+/**********************************************************************************************************************/
+/**    Receive the telegrams and supervise the intervals until sStop is set.
+ */
+static void *receiverThread (void *pArg)
+{
+    (void) pArg;
+
+    while (vos_atomicLoad32(&sStop) == 0u)
+    {
+        VOS_FDS_T       rfds;
+        VOS_TIMEVAL_T   timeOut = {0, 10000};
+
+        VOS_FD_ZERO(&rfds);
+        VOS_FD_SET(sRxSock, &rfds);
+        if (vos_select(sRxSock, &rfds, NULL, NULL, &timeOut) <= 0)
+        {
+            continue;
+        }
+
+        for (;;)
+        {
+            UINT32          size = sizeof(sRxBuffer);
+            UINT32          comId;
+            PD_HEADER_T     header;
+            VOS_TIMEVAL_T   now;
+            BENCH_SINK_T    *pSink;
+
+            if (vos_sockReceiveUDP(sRxSock, (UINT8 *) sRxBuffer, &size, NULL, NULL, NULL, NULL, FALSE) != VOS_NO_ERR)
+            {
+                break;
+            }
+            if (size < sizeof(PD_HEADER_T))
+            {
+                continue;
+            }
+            memcpy(&header, sRxBuffer, sizeof(header));
+            comId = vos_ntohl(header.comId) - BENCH_COMID_BASE;
+            if (comId >= sNoOfPubs)
+            {
+                continue;
+            }
+            vos_getTime(&now);
+            pSink = &sSink[comId];
+            if (vos_atomicLoad32(&sCounting) != 0u)
+            {
+                if (timerisset(&pSink->last))
+                {
+                    UINT32 gap = diffUs(&now, &pSink->last);
+
+                    if (gap > pSink->maxGap)
+                    {
+                        pSink->maxGap = gap;
+                    }
+                    if (gap > sInterval + sInterval / 2u)
+                    {
+                        pSink->late++;
+                    }
+                }
+                pSink->received++;
+            }
+            pSink->last = now;
+        }
+    }
+    vos_semaGive(sRxDone);
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/**    Send and measure the load with noOfSenders threads, 0 for tlp_processSend().
+ *
+ *  @retval         0 if ok
+ */
+static int run (
+    TRDP_IP_ADDR_T  ownIp,
+    TRDP_IP_ADDR_T  destIp,
+    UINT32          dataSize,
+    UINT32          cycle,
+    UINT32          duration,
+    UINT32          noOfSenders)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_PROCESS_CONFIG_T   processConfig;
+    TRDP_STATISTICS_T       stats;
+    VOS_TIMEVAL_T           start, deadline, now, cycleTime = {0, 0};
+    UINT32                  idx, received = 0u, late = 0u, maxGap = 0u, elapsed, sendUs = 0u, cycles = 0u;
+    UINT64                  expected;
+    int                     counting = 0;
+
+    memset(&processConfig, 0, sizeof(processConfig));
+    strcpy(processConfig.hostName, "bench");
+    processConfig.cycleTime = cycle;
+    processConfig.options   = TRDP_OPTION_NONE;
+
+    if (tlc_openSession(&appHandle, ownIp, 0u, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR)
+    {
+        printf("tlc_openSession() failed\n");
+        return 1;
+    }
+    for (idx = 0u; idx < sNoOfPubs; idx++)
+    {
+        if (tlp_publish(appHandle, &sPub[idx], NULL, NULL, 0u, BENCH_COMID_BASE + idx, 0u, 0u, ownIp, destIp,
+                        sInterval, 0u, TRDP_FLAGS_NONE, NULL, sData, dataSize) != TRDP_NO_ERR)
+        {
+            printf("tlp_publish() failed\n");
+            (void) tlc_closeSession(appHandle);
+            return 1;
+        }
+    }
+    (void) tlc_updateSession(appHandle);
+    if ((noOfSenders > 0u) && (tlp_startSenders(appHandle, noOfSenders, 0u) != TRDP_NO_ERR))
+    {
+        printf("tlp_startSenders() failed\n");
+        (void) tlc_closeSession(appHandle);
+        return 1;
+    }
+
+    memset(sSink, 0, sizeof(sSink));
+    cycleTime.tv_usec = (long) cycle;
+    vos_getTime(&start);
+    deadline = start;
+
+    /* The application loop: sends the load itself, or idles while the sender threads do */
+    for (;;)
+    {
+        vos_getTime(&now);
+        elapsed = diffUs(&now, &start);
+        if (!counting && (elapsed >= BENCH_WARMUP))
+        {
+            (void) tlc_resetStatistics(appHandle);
+            vos_atomicStore32(&sCounting, 1u);
+            counting    = 1;
+            start       = now;
+            elapsed     = 0u;
+            sendUs      = 0u;
+            cycles      = 0u;
+        }
+        if (counting && (elapsed >= duration))
+        {
+            break;
+        }
+        if (noOfSenders == 0u)
+        {
+            VOS_TIMEVAL_T sent;
+
+            (void) tlp_processSend(appHandle);
+            vos_getTime(&sent);
+            sendUs += diffUs(&sent, &now);
+            cycles++;
+        }
+        vos_addTime(&deadline, &cycleTime);
+        vos_getTime(&now);
+        if (vos_cmpTime(&deadline, &now) > 0)
+        {
+            (void) vos_threadDelay(diffUs(&deadline, &now));
+        }
+        else
+        {
+            deadline = now;
+        }
+    }
+    vos_getTime(&now);
+    elapsed = diffUs(&now, &start);
+    vos_atomicStore32(&sCounting, 0u);
+    (void) tlc_getStatistics(appHandle, &stats);
+
+    (void) tlp_stopSenders(appHandle);
+    (void) tlc_closeSession(appHandle);
+
+    for (idx = 0u; idx < sNoOfPubs; idx++)
+    {
+        received    += sSink[idx].received;
+        late        += sSink[idx].late;
+        maxGap      = (sSink[idx].maxGap > maxGap) ? sSink[idx].maxGap : maxGap;
+    }
+    expected = (UINT64) sNoOfPubs * elapsed / sInterval;
+
+    printf("%7u %10.0f %10.0f %10.0f %7.2f%% %8u %10u %10u",
+           noOfSenders,
+           (double) expected * 1000000.0 / elapsed,
+           (double) stats.pd.numSend * 1000000.0 / elapsed,
+           (double) received * 1000000.0 / elapsed,
+           (expected > received) ? 100.0 * (double) (expected - received) / (double) expected : 0.0,
+           late,
+           maxGap,
+           stats.pd.numSend);
+    if (noOfSenders == 0u)
+    {
+        printf("   send %.1f us/cycle", (cycles > 0u) ? (double) sendUs / cycles : 0.0);
+    }
+    printf("\n");
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/**    Print usage
+ */
+static void usage (
+    const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Sends cyclic PD over loopback by tlp_processSend() and by sender threads and measures the rate.\n"
+           "Arguments are:\n"
+           "-o <own IP address>     default 127.0.0.1\n"
+           "-i <dest IP address>    default 127.0.0.2, must differ from the own address: the session's own\n"
+           "                        PD listener would share the port with the receiver of the benchmark\n"
+           "-n <publishers>         number of telegrams (default 200, max. %u)\n"
+           "-s <size>               dataset size in bytes (default 1024)\n"
+           "-t <interval>           interval of each telegram in us (default 10000)\n"
+           "-c <cycle>              process cycle in us (default 1000)\n"
+           "-d <seconds>            duration of a run (default 3)\n"
+           "-k <list>               sender threads per run, 0 = tlp_processSend() (default 0,1,2,4)\n"
+           "-h                      print usage\n", BENCH_MAX_PUBS);
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+int main (
+    int     argc,
+    char    *argv[])
+{
+    TRDP_IP_ADDR_T  ownIp       = vos_dottedIP("127.0.0.1");
+    TRDP_IP_ADDR_T  destIp      = vos_dottedIP("127.0.0.2");
+    UINT32          dataSize    = 1024u;
+    UINT32          cycle       = 1000u;
+    UINT32          duration    = 3u;
+    UINT32          senders[BENCH_MAX_RUNS] = {0u, 1u, 2u, 4u};
+    UINT32          noOfRuns    = 4u;
+    UINT32          idx;
+    VOS_THREAD_T    rxThread;
+    VOS_SOCK_OPT_T  sockOptions;
+    int             ch, result = 0;
+
+    while ((ch = getopt(argc, argv, "o:i:n:s:t:c:d:k:h")) != -1)
+    {
+        switch (ch)
+        {
+           case 'o':
+               ownIp = vos_dottedIP(optarg);
+               break;
+           case 'i':
+               destIp = vos_dottedIP(optarg);
+               break;
+           case 'n':
+               sNoOfPubs = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 's':
+               dataSize = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 't':
+               sInterval = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'c':
+               cycle = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'd':
+               duration = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'k':
+           {
+               char *pNext = optarg;
+
+               for (noOfRuns = 0u; (noOfRuns < BENCH_MAX_RUNS) && (*pNext != '\0'); noOfRuns++)
+               {
+                   senders[noOfRuns] = (UINT32) strtoul(pNext, &pNext, 10);
+                   if (*pNext == ',')
+                   {
+                       pNext++;
+                   }
+               }
+               break;
+           }
+           case 'h':
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+    if ((sNoOfPubs == 0u) || (sNoOfPubs > BENCH_MAX_PUBS) || (dataSize > TRDP_MAX_PD_DATA_SIZE) ||
+        (sInterval == 0u) || (cycle == 0u) || (cycle >= 1000000u) || (duration == 0u))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (tlc_init(dbgOut, NULL, NULL) != TRDP_NO_ERR)
+    {
+        printf("tlc_init() failed\n");
+        return 1;
+    }
+
+    memset(&sockOptions, 0, sizeof(sockOptions));
+    sockOptions.reuseAddrPort   = TRUE;
+    sockOptions.nonBlocking     = TRUE;
+    if ((vos_sockOpenUDP(&sRxSock, &sockOptions) != VOS_NO_ERR) ||
+        (vos_sockBind(sRxSock, destIp, BENCH_PD_PORT) != VOS_NO_ERR) ||
+        (vos_semaCreate(&sRxDone, VOS_SEMA_EMPTY) != VOS_NO_ERR) ||
+        (vos_threadCreate(&rxThread, "benchReceiver", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u, receiverThread, NULL)
+         != VOS_NO_ERR))
+    {
+        printf("Receiver could not be set up\n");
+        return 1;
+    }
+
+    printf("%u telegrams of %u bytes every %u us, process cycle %u us, %u s per run\n",
+           sNoOfPubs, dataSize, sInterval, cycle, duration);
+    printf("%7s %10s %10s %10s %8s %8s %10s %10s\n",
+           "senders", "expected/s", "sent/s", "recv/s", "lost", "late", "maxGap us", "numSend");
+    for (idx = 0u; (idx < noOfRuns) && (result == 0); idx++)
+    {
+        result = run(ownIp, destIp, dataSize, cycle, duration * 1000000u, senders[idx]);
+    }
+
+    vos_atomicStore32(&sStop, 1u);
+    (void) vos_semaTake(sRxDone, 1000000u);
+    (void) vos_sockClose(sRxSock);
+    (void) tlc_terminate();
+    return result;
+}
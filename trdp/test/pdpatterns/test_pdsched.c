@@ -0,0 +1,406 @@
+/**********************************************************************************************************************/
+/**
+ * @file            test_pdsched.c
+ *
+ * @brief           Load and interval test of the PD send schedule
+ *
+ * @details         Publishes 120 cyclic telegrams (10 to 1000 ms, 64 to 1363 bytes) over the loopback interface with a
+ *                  process cycle of 1 ms, once without traffic shaping, once with TRDP_OPTION_TRAFFIC_SHAPING and once
+ *                  with TRDP_OPTION_PD_SCHEDULE, and checks
+ *                  - the largest number of bytes planned for one process cycle over the 24 s hyperperiod. The send
+ *                    times are counted in whole cycles before the latest one. Without shaping they follow from the
+ *                    time of publishing, so publishing is repeated until all telegrams were published within one
+ *                    cycle; the check is skipped if that does not succeed,
+ *                  - for the hyperperiod schedule, that the load profile of the scheduler agrees,
+ *                  - per telegram, while tlp_processSend() runs for TEST_CYCLES cycles after all telegrams were
+ *                    sent once, that each send time follows the previous one by whole intervals (without the
+ *                    schedule a telegram delayed by more than one interval restarts from the time of sending), that
+ *                    each telegram is sent by the first tlp_processSend() call after its send time and that the
+ *                    number of sends matches the interval.
+ *
+ *                  With HIGH_PERF_INDEXED the publisher index tables replace the send times of the first two modes,
+ *                  only the hyperperiod schedule is tested then.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ */
+ /*
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+#include "trdp_pdsched.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TEST_NO_OF_PUBS         120u
+#define TEST_COMID_BASE         1000u       /* ComId of the first publisher                                 */
+#define TEST_CYCLE              1000u       /* process cycle (us)                                           */
+#define TEST_HYPERPERIOD        24000u      /* LCM of all intervals (cycles)                                */
+#define TEST_CYCLES             3000u       /* process cycles supervised per mode                           */
+#define TEST_PUBLISH_TRIES      10u         /* attempts to publish all telegrams within one cycle           */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Send state of one telegram */
+typedef struct
+{
+    TRDP_TIME_T     planned;            /**< send time of the previous telegram, 0 before the first             */
+    UINT32          sent;               /**< telegrams sent while supervised                                    */
+    UINT32          slips;              /**< send times off the phase of the previous one                       */
+    UINT32          late;               /**< telegrams that were already due at the previous tlp_processSend()  */
+    BOOL8           overdue;            /**< previous telegram was sent more than one interval late             */
+} TEST_PUB_T;
+
+/** One run */
+typedef struct
+{
+    const char      *pName;
+    TRDP_OPTION_T   option;
+    UINT32          expectedPeak;       /**< largest bytes per cycle of the planned send times                  */
+} TEST_MODE_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static const UINT32 cIntervals[10] = {10u, 20u, 30u, 50u, 100u, 40u, 200u, 64u, 500u, 1000u};   /* ms */
+
+static const TEST_MODE_T cModes[] =
+{
+#ifndef HIGH_PERF_INDEXED
+    {"no shaping", 0u, 90340u},
+    {"traffic shaping", TRDP_OPTION_TRAFFIC_SHAPING, 11020u},
+#endif
+    {"hyperperiod schedule", TRDP_OPTION_PD_SCHEDULE, 3052u}
+};
+
+static TRDP_PUB_T   sPub[TEST_NO_OF_PUBS];
+static TEST_PUB_T   sState[TEST_NO_OF_PUBS];
+static UINT32       sLoad[TEST_HYPERPERIOD];
+static UINT8        sData[TRDP_MAX_PD_DATA_SIZE];
+static TRDP_TIME_T  sLatest;                /* latest send time after tlc_updateSession()                   */
+static TRDP_TIME_T  sPrevCycle;             /* start of the previous tlp_processSend() call                 */
+static BOOL8        sSupervising;
+static BOOL8        sScheduled;             /* TRDP_OPTION_PD_SCHEDULE is set                               */
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Print warnings and errors of the stack, only.
+ */
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      lineNumber,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    (void) pTime;
+    (void) pFile;
+    (void) lineNumber;
+    if (category <= VOS_LOG_WARNING)
+    {
+        printf("%s", pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Interval of publisher idx in us
+ */
+static UINT32 interval (
+    UINT32 idx)
+{
+    return cIntervals[idx % 10u] * 1000u;
+}
+
+/**********************************************************************************************************************/
+/**    Signed microseconds from pFrom to pTo
+ */
+static INT64 diffUs (
+    const TRDP_TIME_T   *pTo,
+    const TRDP_TIME_T   *pFrom)
+{
+    return ((INT64) pTo->tv_sec - (INT64) pFrom->tv_sec) * 1000000 + ((INT64) pTo->tv_usec - (INT64) pFrom->tv_usec);
+}
+
+/**********************************************************************************************************************/
+/**    Called before each telegram is sent, the send time of the publisher has not been advanced yet.
+ */
+static void pubCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    UINT32      idx = (UINT32) (size_t) pMsg->pUserRef;
+    TEST_PUB_T  *pState;
+    TRDP_TIME_T now;
+    INT64       delta;
+
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pData;
+    (void) dataSize;
+
+    if ((idx >= TEST_NO_OF_PUBS) || !sSupervising)
+    {
+        return;
+    }
+    pState = &sState[idx];
+    if (vos_cmpTime(&sPub[idx]->timeToGo, &sPrevCycle) <= 0)
+    {
+        pState->late++;
+    }
+    /*  The next send time is a whole number of intervals later. After a delay of more than one interval the stack
+        restarts the telegram from the time of sending, the schedule keeps the phase.   */
+    if (timerisset(&pState->planned))
+    {
+        delta = diffUs(&sPub[idx]->timeToGo, &pState->planned);
+        if ((delta < (INT64) interval(idx)) ||
+            (((delta % (INT64) interval(idx)) != 0) && (sScheduled || !pState->overdue)))
+        {
+            pState->slips++;
+        }
+    }
+    vos_getTime(&now);
+    pState->overdue = (diffUs(&now, &sPub[idx]->timeToGo) >= (INT64) interval(idx));
+    pState->planned = sPub[idx]->timeToGo;
+    pState->sent++;
+}
+
+/**********************************************************************************************************************/
+/**    Publish all telegrams
+ *
+ *  @retval         duration of publishing (us), -1 on error
+ */
+static INT64 publishAll (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_IP_ADDR_T      destIp)
+{
+    TRDP_TIME_T begin, end;
+    UINT32      idx;
+
+    vos_getTime(&begin);
+    for (idx = 0u; idx < TEST_NO_OF_PUBS; idx++)
+    {
+        if (tlp_publish(appHandle, &sPub[idx], (void *) (size_t) idx, pubCallback, 0u, TEST_COMID_BASE + idx,
+                        0u, 0u, 0u, destIp, interval(idx), 0u, TRDP_FLAGS_NONE, NULL, sData,
+                        64u + (idx * 97u) % 1300u) != TRDP_NO_ERR)
+        {
+            printf("### tlp_publish() of %u failed\n", TEST_COMID_BASE + idx);
+            return -1;
+        }
+    }
+    vos_getTime(&end);
+    return diffUs(&end, &begin);
+}
+
+/**********************************************************************************************************************/
+/**    Largest bytes per process cycle of the planned send times over the hyperperiod, sets sLatest
+ */
+static UINT32 plannedPeak (
+    void)
+{
+    UINT32  idx, slot, peak = 0u;
+    INT64   phase, t;
+
+    sLatest = sPub[0]->timeToGo;
+    for (idx = 1u; idx < TEST_NO_OF_PUBS; idx++)
+    {
+        if (vos_cmpTime(&sPub[idx]->timeToGo, &sLatest) > 0)
+        {
+            sLatest = sPub[idx]->timeToGo;
+        }
+    }
+    memset(sLoad, 0, sizeof(sLoad));
+    for (idx = 0u; idx < TEST_NO_OF_PUBS; idx++)
+    {
+        /* whole cycles before the latest send time, reduced to the interval */
+        phase = diffUs(&sLatest, &sPub[idx]->timeToGo) / TEST_CYCLE * TEST_CYCLE;
+        phase = ((INT64) interval(idx) - phase % (INT64) interval(idx)) % (INT64) interval(idx);
+        for (t = phase; t < (INT64) TEST_HYPERPERIOD * TEST_CYCLE; t += (INT64) interval(idx))
+        {
+            sLoad[t / TEST_CYCLE] += sPub[idx]->grossSize;
+        }
+    }
+    for (slot = 0u; slot < TEST_HYPERPERIOD; slot++)
+    {
+        if (sLoad[slot] > peak)
+        {
+            peak = sLoad[slot];
+        }
+    }
+    return peak;
+}
+
+/**********************************************************************************************************************/
+/**    Publish, check the planned load, send until TEST_CYCLES cycles were supervised and check the intervals.
+ *
+ *  @retval         number of failed checks
+ */
+static int run (
+    const TEST_MODE_T *pMode)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_PROCESS_CONFIG_T   processConfig = {"test_pdsched", "", "", TEST_CYCLE, 0, 0u};
+    TRDP_IP_ADDR_T          ownIp = vos_dottedIP("127.0.0.1");
+    TRDP_TIME_T             from = {0, 0}, to = {0, 0}, next, now;
+    UINT32                  idx, tries, cycles, peak, minSent, maxSent, slips = 0u, late = 0u, badCounts = 0u;
+    INT64                   duration = 0;
+    int                     failed = 0;
+
+    printf("%s:\n", pMode->pName);
+    processConfig.options = pMode->option;
+    memset(sState, 0, sizeof(sState));
+    sSupervising = FALSE;
+    sScheduled   = ((pMode->option & TRDP_OPTION_PD_SCHEDULE) != 0u);
+
+    if (tlc_openSession(&appHandle, ownIp, 0u, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR)
+    {
+        printf("### tlc_openSession() failed\n");
+        return 1;
+    }
+    for (tries = 1u; ; tries++)
+    {
+        duration = publishAll(appHandle, ownIp);
+        if (duration < 0)
+        {
+            (void) tlc_closeSession(appHandle);
+            return 1;
+        }
+        /* shaped send times do not depend on the time of publishing */
+        if ((pMode->option != 0u) || (duration < (INT64) TEST_CYCLE) || (tries == TEST_PUBLISH_TRIES))
+        {
+            break;
+        }
+        for (idx = 0u; idx < TEST_NO_OF_PUBS; idx++)
+        {
+            (void) tlp_unpublish(appHandle, sPub[idx]);
+        }
+    }
+    (void) tlc_updateSession(appHandle);
+
+    peak = plannedPeak();
+    if ((pMode->option == 0u) && (duration >= (INT64) TEST_CYCLE))
+    {
+        printf("    publishing took %lld us, planned peak %u bytes per cycle not checked\n", (long long) duration, peak);
+    }
+    else
+    {
+        printf("    planned peak %u bytes per cycle, expected %u\n", peak, pMode->expectedPeak);
+        failed += (peak != pMode->expectedPeak);
+    }
+    if (sScheduled)
+    {
+        UINT32 schedPeak = trdp_pdSchedulePeak((TRDP_SESSION_PT) appHandle);
+
+        printf("    scheduler profile peak %u bytes per cycle\n", schedPeak);
+        failed += (schedPeak != peak);
+    }
+
+    /* supervise from the cycle after the latest send time, when every telegram has been sent once */
+    vos_getTime(&next);
+    sPrevCycle = next;
+    for (cycles = 0u; cycles < TEST_CYCLES; )
+    {
+        TRDP_TIME_T cycleTime = {0, TEST_CYCLE};
+
+        vos_getTime(&now);
+        if (!sSupervising && (vos_cmpTime(&now, &sLatest) > 0))
+        {
+            sSupervising = TRUE;
+            from = sPrevCycle;
+        }
+        (void) tlp_processSend(appHandle);
+        to = now;
+        sPrevCycle = now;
+        cycles += (sSupervising != FALSE);
+
+        vos_addTime(&next, &cycleTime);
+        vos_getTime(&now);
+        if (vos_cmpTime(&next, &now) > 0)
+        {
+            (void) vos_threadDelay((UINT32) diffUs(&next, &now));
+        }
+    }
+    /* the supervised calls send what was due after the previous call */
+    duration = diffUs(&to, &from);
+
+    for (idx = 0u; idx < TEST_NO_OF_PUBS; idx++)
+    {
+        minSent = (UINT32) (duration / interval(idx));
+        maxSent = minSent + 1u;
+        if ((sState[idx].sent < minSent) || (sState[idx].sent > maxSent))
+        {
+            printf("    ComId %u: %u sent in %lld us, expected %u..%u\n", TEST_COMID_BASE + idx, sState[idx].sent,
+                   (long long) duration, minSent, maxSent);
+            badCounts++;
+        }
+        slips   += sState[idx].slips;
+        late    += sState[idx].late;
+    }
+    printf("    %u send times off the interval, %u late sends, %u telegrams with a wrong number of sends\n",
+           slips, late, badCounts);
+    failed += (slips != 0u) + (late != 0u) + (badCounts != 0u);
+
+    for (idx = 0u; idx < TEST_NO_OF_PUBS; idx++)
+    {
+        (void) tlp_unpublish(appHandle, sPub[idx]);
+    }
+    (void) tlc_closeSession(appHandle);
+    return failed;
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+int main (
+    void)
+{
+    UINT32  mode;
+    int     failed = 0;
+
+    if (tlc_init(dbgOut, NULL, NULL) != TRDP_NO_ERR)
+    {
+        printf("tlc_init() failed\n");
+        return 1;
+    }
+    printf("%u telegrams, process cycle %u us\n", TEST_NO_OF_PUBS, TEST_CYCLE);
+    for (mode = 0u; mode < sizeof(cModes) / sizeof(cModes[0]); mode++)
+    {
+        failed += run(&cModes[mode]);
+    }
+    (void) tlc_terminate();
+
+    if (failed != 0)
+    {
+        printf("### %d check(s) FAILED\n", failed);
+        return 1;
+    }
+    printf("All schedule tests passed\n");
+    return 0;
+}
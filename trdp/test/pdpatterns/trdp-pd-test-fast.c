@@ -16,6 +16,7 @@
  *
  * $Id$
  *
+ *      AG 2026-10-18: Report the index table occupation (tlc_getIndexStatistics)
  *     CWE 2023-02-14: Ticket #419 PDTestFastBase2 failed - use even cycle factors depending on the index table base + write timestamps to log
  *      AM 2022-12-01: Ticket #399 Abstract socket type (VOS_SOCK_T, TRDP_SOCK_T) introduced, vos_select function is not anymore called with '+1'
  *      IB 2019-08-15: separate sender and receiver thread added
@@ -983,6 +984,18 @@ int main(int argc, char * argv[])
 
     tlc_updateSession(apph);
 
+    {   /* report the occupation of the index tables */
+        TRDP_IDX_STATISTICS_T idxStats;
+
+        if (tlc_getIndexStatistics(apph, &idxStats) == TRDP_NO_ERR)
+        {
+            printf("- index tables: depth %u/%u/%u (needed %u/%u/%u), busiest cycle %u bytes\n",
+                   idxStats.lowCat.depth, idxStats.midCat.depth, idxStats.highCat.depth,
+                   idxStats.lowCat.requiredDepth, idxStats.midCat.requiredDepth, idxStats.highCat.requiredDepth,
+                   idxStats.maxCycleBytes);
+        }
+    }
+
     while (1)
     {   /* drive TRDP communications */
 //        tlc_process(apph, NULL, NULL);
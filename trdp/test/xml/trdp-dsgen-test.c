@@ -0,0 +1,209 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-dsgen-test.c
+ *
+ * @brief           Round trip test of the code generated by trdp-dsgen
+ *
+ * @details         Compiled against the header trdp-dsgen wrote for an XML configuration (make dsgen does this for
+ *                  every sample in test/xml) and run with the same XML file. For every ComId with generated code
+ *                  random wire images are
+ *                  - sized by trdp_ds_calcSize() and tau_calcDatasetSizeByComId(),
+ *                  - unmarshalled by trdp_ds_unmarshall() and tau_unmarshall(),
+ *                  - marshalled again by trdp_ds_marshall() and tau_marshall(),
+ *                  and the sizes, the host images and the wire images must be equal, the latter to the original, too.
+ *                  Trailing arrays get small random counts, so the image fits the buffers.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *  Usage: trdp-dsgen-test <xml file the header was generated from>
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "tau_xml.h"
+#include "tau_marshall.h"
+
+/* ComIds without generated code are reported instead of being passed on to tau_marshall */
+#define TRDP_DS_NO_FALLBACK
+#include "trdp_ds.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define ROUNDS          200u        /* random wire images per ComId */
+#define WIRE_BUF_SIZE   65536u
+#define HOST_BUF_SIZE   (4u * WIRE_BUF_SIZE)
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static UINT64   sWire[WIRE_BUF_SIZE / 8u];
+static UINT64   sWireGen[WIRE_BUF_SIZE / 8u];
+static UINT64   sWireTau[WIRE_BUF_SIZE / 8u];
+static UINT64   sHostGen[HOST_BUF_SIZE / 8u];
+static UINT64   sHostTau[HOST_BUF_SIZE / 8u];
+static UINT32   sSeed = 1u;
+
+/**********************************************************************************************************************/
+/**    Random byte, reproducible
+ */
+static UINT8 random8 (void)
+{
+    sSeed = sSeed * 1103515245u + 12345u;
+    return (UINT8) (sSeed >> 16);
+}
+
+/**********************************************************************************************************************/
+/**    Fill the wire buffer with a random image tau_calcDatasetSizeByComId() accepts
+ *
+ *  @retval         TRUE if found
+ */
+static BOOL8 randomWire (void *pRefCon, UINT32 comId)
+{
+    UINT8   *pWire = (UINT8 *) sWire;
+    UINT8   mask;
+    UINT32  i, hostSize;
+
+    /* random bytes first, then bytes of 0 or 1 for small array counts, then zeros */
+    for (mask = 0xFFu; ; mask = (mask == 0xFFu) ? 0x01u : 0x00u)
+    {
+        for (i = 0u; i < WIRE_BUF_SIZE; i++)
+        {
+            pWire[i] = random8() & mask;
+        }
+        hostSize = 0u;
+        if ((tau_calcDatasetSizeByComId(pRefCon, comId, pWire, WIRE_BUF_SIZE, &hostSize, NULL) == TRDP_NO_ERR) &&
+            (hostSize <= HOST_BUF_SIZE))
+        {
+            return TRUE;
+        }
+        if (mask == 0x00u)
+        {
+            return FALSE;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Round trips of one ComId
+ *
+ *  @retval         number of failed rounds
+ */
+static UINT32 roundTrip (void *pRefCon, UINT32 comId)
+{
+    UINT32      round, failed = 0u;
+    UINT32      sizeGen, sizeTau, hostGen, hostTau, wireGen, wireTau;
+    TRDP_ERR_T  errGen, errTau;
+
+    for (round = 0u; round < ROUNDS; round++)
+    {
+        if (randomWire(pRefCon, comId) == FALSE)
+        {
+            printf("### ComId %u: no wire image accepted by tau_calcDatasetSizeByComId()\n", comId);
+            return ROUNDS;
+        }
+
+        sizeGen = sizeTau = 0u;
+        errGen  = trdp_ds_calcSize(pRefCon, comId, (UINT8 *) sWire, WIRE_BUF_SIZE, &sizeGen, NULL);
+        errTau  = tau_calcDatasetSizeByComId(pRefCon, comId, (UINT8 *) sWire, WIRE_BUF_SIZE, &sizeTau, NULL);
+        if ((errGen != errTau) || (sizeGen != sizeTau))
+        {
+            printf("### ComId %u round %u: size %u (%d), tau_calcDatasetSizeByComId %u (%d)\n",
+                   comId, round, sizeGen, errGen, sizeTau, errTau);
+            failed++;
+            continue;
+        }
+
+        memset(sHostGen, 0, sizeof(sHostGen));
+        memset(sHostTau, 0, sizeof(sHostTau));
+        hostGen = hostTau = HOST_BUF_SIZE;
+        errGen  = trdp_ds_unmarshall(pRefCon, comId, (UINT8 *) sWire, WIRE_BUF_SIZE, (UINT8 *) sHostGen, &hostGen,
+                                     NULL);
+        errTau  = tau_unmarshall(pRefCon, comId, (UINT8 *) sWire, WIRE_BUF_SIZE, (UINT8 *) sHostTau, &hostTau, NULL);
+        if ((errGen != TRDP_NO_ERR) || (errTau != TRDP_NO_ERR) || (hostGen != hostTau) || (hostGen != sizeTau) ||
+            (memcmp(sHostGen, sHostTau, hostGen) != 0))
+        {
+            printf("### ComId %u round %u: unmarshalled %u bytes (%d), tau_unmarshall %u bytes (%d), %s\n",
+                   comId, round, hostGen, errGen, hostTau, errTau,
+                   (memcmp(sHostGen, sHostTau, hostGen) != 0) ? "different" : "equal");
+            failed++;
+            continue;
+        }
+
+        wireGen = wireTau = WIRE_BUF_SIZE;
+        errGen  = trdp_ds_marshall(pRefCon, comId, (UINT8 *) sHostGen, hostGen, (UINT8 *) sWireGen, &wireGen, NULL);
+        errTau  = tau_marshall(pRefCon, comId, (UINT8 *) sHostTau, hostTau, (UINT8 *) sWireTau, &wireTau, NULL);
+        if ((errGen != TRDP_NO_ERR) || (errTau != TRDP_NO_ERR) || (wireGen != wireTau) ||
+            (memcmp(sWireGen, sWireTau, wireGen) != 0) || (memcmp(sWireGen, sWire, wireGen) != 0))
+        {
+            printf("### ComId %u round %u: marshalled %u bytes (%d), tau_marshall %u bytes (%d), %s\n",
+                   comId, round, wireGen, errGen, wireTau, errTau,
+                   (memcmp(sWireGen, sWire, wireGen) != 0) ? "not the original" : "different");
+            failed++;
+        }
+    }
+    return failed;
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    TRDP_XML_DOC_HANDLE_T   docHandle;
+    UINT32                  numComId    = 0u;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap = NULL;
+    UINT32                  numDataset  = 0u;
+    apTRDP_DATASET_T        apDataset   = NULL;
+    void                    *pRefCon    = NULL;
+    UINT32                  i, size, generated = 0u, failed = 0u;
+
+    if (argc != 2)
+    {
+        printf("usage: %s <xml file>\n", argv[0]);
+        return 1;
+    }
+    if ((tau_prepareXmlDoc(argv[1], &docHandle) != TRDP_NO_ERR) ||
+        (tau_readXmlDatasetConfig(&docHandle, &numComId, &pComIdDsIdMap, &numDataset, &apDataset) != TRDP_NO_ERR) ||
+        (tau_initMarshall(&pRefCon, numComId, pComIdDsIdMap, numDataset, apDataset) != TRDP_NO_ERR))
+    {
+        printf("### Reading the datasets of %s failed\n", argv[1]);
+        return 1;
+    }
+
+    for (i = 0u; i < numComId; i++)
+    {
+        /* without generated code the dispatcher does not know the ComId */
+        if (trdp_ds_calcSize(pRefCon, pComIdDsIdMap[i].comId, (UINT8 *) sWire, WIRE_BUF_SIZE, &size, NULL)
+            == TRDP_COMID_ERR)
+        {
+            printf("    ComId %u: left to tau_marshall\n", pComIdDsIdMap[i].comId);
+            continue;
+        }
+        generated++;
+        size = roundTrip(pRefCon, pComIdDsIdMap[i].comId);
+        printf("%s ComId %u (dataset %u): %u of %u round trips equal to tau_marshall\n", (size == 0u) ? "   " : "###",
+               pComIdDsIdMap[i].comId, pComIdDsIdMap[i].datasetId, ROUNDS - size, ROUNDS);
+        failed += (size != 0u);
+    }
+
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+    tau_freeXmlDoc(&docHandle);
+
+    if (failed != 0u)
+    {
+        printf("### %s: %u of %u generated ComIds FAILED\n", argv[1], failed, generated);
+        return 1;
+    }
+    printf("%s: %u generated ComIds pass\n", argv[1], generated);
+    return 0;
+}
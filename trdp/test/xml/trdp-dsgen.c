@@ -0,0 +1,955 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-dsgen.c
+ *
+ * @brief           Dataset code generator
+ *
+ * @details         Reads the dataset definitions of a TRDP XML configuration file with tau_readXmlDatasetConfig and
+ *                  writes a C header with, for every dataset,
+ *                  - the host structure and the packed wire structure
+ *                  - straight-line marshalling, unmarshalling and size functions
+ *                  and, for all ComIds, dispatch functions to be used in TRDP_MARSHALL_CONFIG_T.
+ *                  Datasets with variable sized elements other than a trailing array sized by the element before it
+ *                  are left to tau_marshall(), so are ComIds without a usable dataset.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <unistd.h>
+
+#include "tau_xml.h"
+#include "tau_marshall.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define DSGEN_MAX_NAME      64u         /**< max. length of generated identifiers                  */
+#define DSGEN_MAX_LEVEL     TAU_MAX_DS_LEVEL
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Generator state of one dataset */
+typedef struct
+{
+    TRDP_DATASET_T  *pDataset;      /**< the dataset                                            */
+    UINT32          state;          /**< 0 not visited, 1 being analysed, 2 done                */
+    BOOL8           usable;         /**< code can be generated                                  */
+    BOOL8           trailingVar;    /**< last element is a variable sized array                 */
+    UINT32          wireSize;       /**< wire size, fixed part                                  */
+    UINT32          align;          /**< alignment of the host structure                        */
+} DSGEN_DS_T;
+
+/** Base type description, indexed by TRDP_DATA_TYPE_T */
+typedef struct
+{
+    const CHAR8 *pCType;            /**< host type                                              */
+    UINT32      wireSize;           /**< size on the wire                                       */
+    const CHAR8 *pAccess;           /**< suffix of the put/get helpers, NULL for single bytes   */
+    const CHAR8 *pWireType;         /**< unsigned type the helpers take                         */
+} DSGEN_TYPE_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static const DSGEN_TYPE_T cTypes[TRDP_TIMEDATE64 + 1] =
+{
+    {NULL,          0u, NULL,   NULL},          /* TRDP_INVALID     */
+    {"BOOL8",       1u, NULL,   "UINT8"},       /* TRDP_BITSET8     */
+    {"CHAR8",       1u, NULL,   "UINT8"},       /* TRDP_CHAR8       */
+    {"UTF16",       2u, "16",   "UINT16"},      /* TRDP_UTF16       */
+    {"INT8",        1u, NULL,   "UINT8"},       /* TRDP_INT8        */
+    {"INT16",       2u, "16",   "UINT16"},      /* TRDP_INT16       */
+    {"INT32",       4u, "32",   "UINT32"},      /* TRDP_INT32       */
+    {"INT64",       8u, "64",   "UINT64"},      /* TRDP_INT64       */
+    {"UINT8",       1u, NULL,   "UINT8"},       /* TRDP_UINT8       */
+    {"UINT16",      2u, "16",   "UINT16"},      /* TRDP_UINT16      */
+    {"UINT32",      4u, "32",   "UINT32"},      /* TRDP_UINT32      */
+    {"UINT64",      8u, "64",   "UINT64"},      /* TRDP_UINT64      */
+    {"REAL32",      4u, "R32",  NULL},          /* TRDP_REAL32      */
+    {"REAL64",      8u, "R64",  NULL},          /* TRDP_REAL64      */
+    {"TIMEDATE32",  4u, "32",   "UINT32"},      /* TRDP_TIMEDATE32  */
+    {"TIMEDATE48",  6u, NULL,   NULL},          /* TRDP_TIMEDATE48  */
+    {"TIMEDATE64",  8u, NULL,   NULL}           /* TRDP_TIMEDATE64  */
+};
+
+static const CHAR8  *cKeywords[] =
+{
+    "auto", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum", "extern",
+    "float", "for", "goto", "if", "inline", "int", "long", "register", "restrict", "return", "short", "signed",
+    "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void", "volatile", "while",
+    "class", "delete", "new", "private", "protected", "public", "template", "this", "virtual"
+};
+
+static FILE         *sOut;
+static DSGEN_DS_T   *sDs;
+static UINT32       sNumDs;
+static CHAR8        sPrefix[DSGEN_MAX_NAME];        /* function prefix, lower case  */
+static CHAR8        sPrefixUC[DSGEN_MAX_NAME];      /* type/macro prefix, upper case */
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Find the generator state of a dataset
+ *
+ *  @param[in]      id              dataset ID
+ *
+ *  @retval         NULL if unknown
+ */
+static DSGEN_DS_T *findDs (UINT32 id)
+{
+    UINT32 i;
+
+    for (i = 0u; i < sNumDs; i++)
+    {
+        if (sDs[i].pDataset->id == id)
+        {
+            return &sDs[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/**    Return TRUE if the type is a base type the generator knows
+ */
+static BOOL8 isBaseType (UINT32 type)
+{
+    return ((type > TRDP_INVALID) && (type <= TRDP_TIMEDATE64)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/**    Return TRUE if the type can hold the size of a following variable array
+ */
+static BOOL8 isSizeType (UINT32 type)
+{
+    switch (type)
+    {
+       case TRDP_INT8:
+       case TRDP_INT16:
+       case TRDP_INT32:
+       case TRDP_UINT8:
+       case TRDP_UINT16:
+       case TRDP_UINT32:
+           return TRUE;
+       default:
+           return FALSE;
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Check whether code can be generated for a dataset and compute its wire size.
+ *    Nested datasets must have a fixed size, the top level may end with a variable array of a base type
+ *    whose size is held by the element before it.
+ *
+ *  @param[in,out]  pGen            dataset
+ *  @param[in]      level           nesting level, 1 for top level
+ *
+ *  @retval         TRUE if usable
+ */
+static BOOL8 analyse (DSGEN_DS_T *pGen, UINT32 level)
+{
+    const TRDP_DATASET_T    *pDataset = pGen->pDataset;
+    UINT32                  lIndex;
+
+    if (pGen->state == 2u)
+    {
+        return pGen->usable;
+    }
+    if ((pGen->state == 1u) || (level > DSGEN_MAX_LEVEL))
+    {
+        return FALSE;                           /* contains itself or nested too deep */
+    }
+    pGen->state     = 1u;
+    pGen->usable    = TRUE;
+    pGen->wireSize  = 0u;
+    pGen->align     = 1u;
+
+    for (lIndex = 0u; (lIndex < pDataset->numElement) && (pGen->usable == TRUE); lIndex++)
+    {
+        UINT32  type    = pDataset->pElement[lIndex].type;
+        UINT32  size    = pDataset->pElement[lIndex].size;
+
+        if (isBaseType(type) == TRUE)
+        {
+            UINT32 align = (type >= TRDP_TIMEDATE48) ? 4u : cTypes[type].wireSize;
+
+            pGen->align = (align > pGen->align) ? align : pGen->align;
+            if (size == TRDP_VAR_SIZE)
+            {
+                if ((lIndex + 1u == pDataset->numElement) && (lIndex > 0u) &&
+                    (isSizeType(pDataset->pElement[lIndex - 1u].type) == TRUE) &&
+                    (pDataset->pElement[lIndex - 1u].size == 1u))
+                {
+                    pGen->trailingVar = TRUE;
+                }
+                else
+                {
+                    pGen->usable = FALSE;
+                }
+            }
+            else
+            {
+                pGen->wireSize += size * cTypes[type].wireSize;
+            }
+        }
+        else if (type > TRDP_TYPE_MAX)
+        {
+            DSGEN_DS_T *pNested = findDs(type);
+
+            if ((pNested == NULL) || (size == TRDP_VAR_SIZE) ||
+                (analyse(pNested, level + 1u) == FALSE) || (pNested->trailingVar == TRUE))
+            {
+                pGen->usable = FALSE;
+            }
+            else
+            {
+                pGen->wireSize  += size * pNested->wireSize;
+                pGen->align     = (pNested->align > pGen->align) ? pNested->align : pGen->align;
+            }
+        }
+        else
+        {
+            pGen->usable = FALSE;
+        }
+    }
+
+    pGen->state = 2u;
+    return pGen->usable;
+}
+
+/**********************************************************************************************************************/
+/**    Make a C identifier of an element name, unique within its dataset.
+ *
+ *  @param[in]      pDataset        dataset
+ *  @param[in]      idx             element index
+ *  @param[out]     pName           buffer of DSGEN_MAX_NAME characters
+ */
+static void memberName (const TRDP_DATASET_T *pDataset, UINT32 idx, CHAR8 *pName)
+{
+    const CHAR8 *pSrc = pDataset->pElement[idx].name;
+    UINT32      len = 0u;
+    UINT32      i, j;
+
+    if ((pSrc != NULL) && (*pSrc != '\0'))
+    {
+        if (isdigit((unsigned char) *pSrc))
+        {
+            pName[len++] = 'e';
+        }
+        for (; (*pSrc != '\0') && (len < DSGEN_MAX_NAME - 8u); pSrc++)
+        {
+            pName[len++] = (isalnum((unsigned char) *pSrc)) ? *pSrc : '_';
+        }
+    }
+    pName[len] = '\0';
+
+    if (len == 0u)
+    {
+        (void) snprintf(pName, DSGEN_MAX_NAME, "e%u", idx);
+        return;
+    }
+    for (i = 0u; i < sizeof(cKeywords) / sizeof(cKeywords[0]); i++)
+    {
+        if (strcmp(pName, cKeywords[i]) == 0)
+        {
+            pName[len++]    = '_';
+            pName[len]      = '\0';
+            break;
+        }
+    }
+
+    /* Earlier elements of the same name keep it */
+    for (j = 0u; j < idx; j++)
+    {
+        CHAR8 other[DSGEN_MAX_NAME];
+
+        memberName(pDataset, j, other);
+        if (strcmp(pName, other) == 0)
+        {
+            (void) snprintf(pName + len, DSGEN_MAX_NAME - len, "_%u", idx);
+            return;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Print the helpers converting single items to and from network byte order
+ */
+static void printHelpers (void)
+{
+    const CHAR8 *p = sPrefix;
+
+    fprintf(sOut, "/* Conversion of single items to and from network byte order */\n");
+    fprintf(sOut, "%s_FN void %s_put16 (UINT8 *pW, UINT16 v)\n{\n", sPrefixUC, p);
+    fprintf(sOut, "    pW[0] = (UINT8) (v >> 8);\n    pW[1] = (UINT8) v;\n}\n\n");
+    fprintf(sOut, "%s_FN void %s_put32 (UINT8 *pW, UINT32 v)\n{\n", sPrefixUC, p);
+    fprintf(sOut, "    pW[0] = (UINT8) (v >> 24);\n    pW[1] = (UINT8) (v >> 16);\n");
+    fprintf(sOut, "    pW[2] = (UINT8) (v >> 8);\n    pW[3] = (UINT8) v;\n}\n\n");
+    fprintf(sOut, "%s_FN void %s_put64 (UINT8 *pW, UINT64 v)\n{\n", sPrefixUC, p);
+    fprintf(sOut, "    %s_put32(pW, (UINT32) (v >> 32));\n    %s_put32(pW + 4, (UINT32) v);\n}\n\n", p, p);
+    fprintf(sOut, "%s_FN void %s_putR32 (UINT8 *pW, REAL32 v)\n{\n", sPrefixUC, p);
+    fprintf(sOut, "    UINT32 u;\n\n    memcpy(&u, &v, 4);\n    %s_put32(pW, u);\n}\n\n", p);
+    fprintf(sOut, "%s_FN void %s_putR64 (UINT8 *pW, REAL64 v)\n{\n", sPrefixUC, p);
+    fprintf(sOut, "    UINT64 u;\n\n    memcpy(&u, &v, 8);\n    %s_put64(pW, u);\n}\n\n", p);
+    fprintf(sOut, "%s_FN UINT16 %s_get16 (const UINT8 *pW)\n{\n", sPrefixUC, p);
+    fprintf(sOut, "    return (UINT16) (((UINT16) pW[0] << 8) | pW[1]);\n}\n\n");
+    fprintf(sOut, "%s_FN UINT32 %s_get32 (const UINT8 *pW)\n{\n", sPrefixUC, p);
+    fprintf(sOut, "    return ((UINT32) pW[0] << 24) | ((UINT32) pW[1] << 16) | ((UINT32) pW[2] << 8) | pW[3];\n}\n\n");
+    fprintf(sOut, "%s_FN UINT64 %s_get64 (const UINT8 *pW)\n{\n", sPrefixUC, p);
+    fprintf(sOut, "    return ((UINT64) %s_get32(pW) << 32) | %s_get32(pW + 4);\n}\n\n", p, p);
+    fprintf(sOut, "%s_FN REAL32 %s_getR32 (const UINT8 *pW)\n{\n", sPrefixUC, p);
+    fprintf(sOut, "    UINT32 u = %s_get32(pW);\n    REAL32 v;\n\n    memcpy(&v, &u, 4);\n    return v;\n}\n\n", p);
+    fprintf(sOut, "%s_FN REAL64 %s_getR64 (const UINT8 *pW)\n{\n", sPrefixUC, p);
+    fprintf(sOut, "    UINT64 u = %s_get64(pW);\n    REAL64 v;\n\n    memcpy(&v, &u, 8);\n    return v;\n}\n\n", p);
+}
+
+/**********************************************************************************************************************/
+/**    Print the host and the wire structure of a dataset
+ */
+static void printStructs (const DSGEN_DS_T *pGen)
+{
+    const TRDP_DATASET_T    *pDataset = pGen->pDataset;
+    CHAR8                   name[DSGEN_MAX_NAME];
+    UINT32                  i;
+
+    fprintf(sOut, "/* Dataset %u %s */\n", pDataset->id, pDataset->name);
+    fprintf(sOut, "typedef struct\n{\n");
+    for (i = 0u; i < pDataset->numElement; i++)
+    {
+        UINT32 type = pDataset->pElement[i].type;
+        UINT32 size = pDataset->pElement[i].size;
+
+        memberName(pDataset, i, name);
+        if (type > TRDP_TYPE_MAX)
+        {
+            fprintf(sOut, "    %s_DS%u_T %s", sPrefixUC, type, name);
+        }
+        else
+        {
+            fprintf(sOut, "    %-10s %s", cTypes[type].pCType, name);
+        }
+        if (size == TRDP_VAR_SIZE)
+        {
+            fprintf(sOut, "[];");
+        }
+        else if (size > 1u)
+        {
+            fprintf(sOut, "[%u];", size);
+        }
+        else
+        {
+            fprintf(sOut, ";");
+        }
+        if ((pDataset->pElement[i].unit != NULL) && (pDataset->pElement[i].unit[0] != '\0'))
+        {
+            fprintf(sOut, "  /* [%s] */", pDataset->pElement[i].unit);
+        }
+        fprintf(sOut, "\n");
+    }
+    fprintf(sOut, "} %s_DS%u_T;\n\n", sPrefixUC, pDataset->id);
+
+    fprintf(sOut, "typedef struct\n{\n");
+    for (i = 0u; i < pDataset->numElement; i++)
+    {
+        UINT32 type = pDataset->pElement[i].type;
+        UINT32 size = pDataset->pElement[i].size;
+
+        memberName(pDataset, i, name);
+        if (type > TRDP_TYPE_MAX)
+        {
+            fprintf(sOut, "    %s_DS%u_WIRE_T %s", sPrefixUC, type, name);
+            fprintf(sOut, (size > 1u) ? "[%u];\n" : ";\n", size);
+        }
+        else if (size == TRDP_VAR_SIZE)
+        {
+            fprintf(sOut, (cTypes[type].wireSize > 1u) ? "    UINT8 %s[][%u];\n" : "    UINT8 %s[];\n",
+                    name, cTypes[type].wireSize);
+        }
+        else
+        {
+            fprintf(sOut, "    UINT8 %s[%u];\n", name, size * cTypes[type].wireSize);
+        }
+    }
+    fprintf(sOut, "} GNU_PACKED %s_DS%u_WIRE_T;\n\n", sPrefixUC, pDataset->id);
+    fprintf(sOut, "#define %s_DS%u_WIRE_SIZE  %uu\n\n", sPrefixUC, pDataset->id, pGen->wireSize);
+}
+
+/**********************************************************************************************************************/
+/**    Print the conversion of one base type item
+ *
+ *  @param[in]      type            base type
+ *  @param[in]      toWire          TRUE for marshalling
+ *  @param[in]      pHost           host item expression
+ *  @param[in]      pWire           wire address expression
+ *  @param[in]      pIndent         indentation
+ */
+static void printItem (UINT32 type, BOOL8 toWire, const CHAR8 *pHost, const CHAR8 *pWire, const CHAR8 *pIndent)
+{
+    const DSGEN_TYPE_T *pType = &cTypes[type];
+
+    if (type == TRDP_TIMEDATE48)
+    {
+        if (toWire == TRUE)
+        {
+            fprintf(sOut, "%s%s_put32(%s, %s.sec);\n", pIndent, sPrefix, pWire, pHost);
+            fprintf(sOut, "%s%s_put16(%s + 4, %s.ticks);\n", pIndent, sPrefix, pWire, pHost);
+        }
+        else
+        {
+            fprintf(sOut, "%s%s.sec = %s_get32(%s);\n", pIndent, pHost, sPrefix, pWire);
+            fprintf(sOut, "%s%s.ticks = %s_get16(%s + 4);\n", pIndent, pHost, sPrefix, pWire);
+        }
+    }
+    else if (type == TRDP_TIMEDATE64)
+    {
+        if (toWire == TRUE)
+        {
+            fprintf(sOut, "%s%s_put32(%s, %s.tv_sec);\n", pIndent, sPrefix, pWire, pHost);
+            fprintf(sOut, "%s%s_put32(%s + 4, (UINT32) %s.tv_usec);\n", pIndent, sPrefix, pWire, pHost);
+        }
+        else
+        {
+            fprintf(sOut, "%s%s.tv_sec = %s_get32(%s);\n", pIndent, pHost, sPrefix, pWire);
+            fprintf(sOut, "%s%s.tv_usec = (INT32) %s_get32(%s + 4);\n", pIndent, pHost, sPrefix, pWire);
+        }
+    }
+    else if (pType->pAccess == NULL)
+    {
+        if (toWire == TRUE)
+        {
+            fprintf(sOut, "%s*(%s) = (UINT8) %s;\n", pIndent, pWire, pHost);
+        }
+        else
+        {
+            fprintf(sOut, "%s%s = (%s) *(%s);\n", pIndent, pHost, pType->pCType, pWire);
+        }
+    }
+    else if (pType->pWireType == NULL)
+    {
+        if (toWire == TRUE)
+        {
+            fprintf(sOut, "%s%s_put%s(%s, %s);\n", pIndent, sPrefix, pType->pAccess, pWire, pHost);
+        }
+        else
+        {
+            fprintf(sOut, "%s%s = %s_get%s(%s);\n", pIndent, pHost, sPrefix, pType->pAccess, pWire);
+        }
+    }
+    else
+    {
+        if (toWire == TRUE)
+        {
+            fprintf(sOut, "%s%s_put%s(%s, (%s) %s);\n", pIndent, sPrefix, pType->pAccess, pWire, pType->pWireType,
+                    pHost);
+        }
+        else
+        {
+            fprintf(sOut, "%s%s = (%s) %s_get%s(%s);\n", pIndent, pHost, pType->pCType, sPrefix, pType->pAccess,
+                    pWire);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Print the put (toWire) or get function converting the fixed part of a dataset
+ */
+static void printConvert (const DSGEN_DS_T *pGen, BOOL8 toWire)
+{
+    const TRDP_DATASET_T    *pDataset = pGen->pDataset;
+    CHAR8                   name[DSGEN_MAX_NAME];
+    CHAR8                   host[DSGEN_MAX_NAME * 2u];
+    CHAR8                   wire[DSGEN_MAX_NAME * 2u];
+    UINT32                  wireOff = 0u;
+    BOOL8                   loops   = FALSE;
+    UINT32                  i;
+
+    for (i = 0u; i < pDataset->numElement; i++)
+    {
+        UINT32 type = pDataset->pElement[i].type;
+        UINT32 size = pDataset->pElement[i].size;
+
+        if ((size > 1u) && (size != TRDP_VAR_SIZE) &&
+            ((type > TRDP_TYPE_MAX) || (cTypes[type].pAccess != NULL) || (cTypes[type].pWireType == NULL)))
+        {
+            loops = TRUE;
+        }
+    }
+
+    if (toWire == TRUE)
+    {
+        fprintf(sOut, "%s_FN void %s_ds%u_put (const %s_DS%u_T *pH, UINT8 *pW)\n{\n",
+                sPrefixUC, sPrefix, pDataset->id, sPrefixUC, pDataset->id);
+    }
+    else
+    {
+        fprintf(sOut, "%s_FN void %s_ds%u_get (const UINT8 *pW, %s_DS%u_T *pH)\n{\n",
+                sPrefixUC, sPrefix, pDataset->id, sPrefixUC, pDataset->id);
+    }
+    if (loops == TRUE)
+    {
+        fprintf(sOut, "    UINT32 i;\n\n");
+    }
+
+    for (i = 0u; i < pDataset->numElement; i++)
+    {
+        UINT32 type = pDataset->pElement[i].type;
+        UINT32 size = pDataset->pElement[i].size;
+
+        if (size == TRDP_VAR_SIZE)
+        {
+            break;                              /* trailing array, done by the caller */
+        }
+        memberName(pDataset, i, name);
+
+        if (type > TRDP_TYPE_MAX)
+        {
+            UINT32 nestedSize = findDs(type)->wireSize;
+
+            if (size == 1u)
+            {
+                if (toWire == TRUE)
+                {
+                    fprintf(sOut, "    %s_ds%u_put(&pH->%s, pW + %u);\n", sPrefix, type, name, wireOff);
+                }
+                else
+                {
+                    fprintf(sOut, "    %s_ds%u_get(pW + %u, &pH->%s);\n", sPrefix, type, wireOff, name);
+                }
+            }
+            else
+            {
+                fprintf(sOut, "    for (i = 0u; i < %uu; i++)\n    {\n", size);
+                if (toWire == TRUE)
+                {
+                    fprintf(sOut, "        %s_ds%u_put(&pH->%s[i], pW + %u + %u * i);\n",
+                            sPrefix, type, name, wireOff, nestedSize);
+                }
+                else
+                {
+                    fprintf(sOut, "        %s_ds%u_get(pW + %u + %u * i, &pH->%s[i]);\n",
+                            sPrefix, type, wireOff, nestedSize, name);
+                }
+                fprintf(sOut, "    }\n");
+            }
+            wireOff += size * nestedSize;
+        }
+        else if (size == 1u)
+        {
+            (void) snprintf(host, sizeof(host), "pH->%s", name);
+            (void) snprintf(wire, sizeof(wire), "pW + %u", wireOff);
+            printItem(type, toWire, host, wire, "    ");
+            wireOff += cTypes[type].wireSize;
+        }
+        else if ((cTypes[type].pAccess == NULL) && (cTypes[type].pWireType != NULL))
+        {
+            /* byte arrays are copied */
+            if (toWire == TRUE)
+            {
+                fprintf(sOut, "    memcpy(pW + %u, pH->%s, %uu);\n", wireOff, name, size);
+            }
+            else
+            {
+                fprintf(sOut, "    memcpy(pH->%s, pW + %u, %uu);\n", name, wireOff, size);
+            }
+            wireOff += size;
+        }
+        else
+        {
+            (void) snprintf(host, sizeof(host), "pH->%s[i]", name);
+            (void) snprintf(wire, sizeof(wire), "pW + %u + %u * i", wireOff, cTypes[type].wireSize);
+            fprintf(sOut, "    for (i = 0u; i < %uu; i++)\n    {\n", size);
+            printItem(type, toWire, host, wire, "        ");
+            fprintf(sOut, "    }\n");
+            wireOff += size * cTypes[type].wireSize;
+        }
+    }
+    fprintf(sOut, "}\n\n");
+}
+/**********************************************************************************************************************/
+/**    Print the conversion of the trailing variable array
+ *
+ *  @param[in]      pGen            dataset
+ *  @param[in]      toWire          TRUE for marshalling
+ */
+static void printTrailing (const DSGEN_DS_T *pGen, BOOL8 toWire)
+{
+    const TRDP_DATASET_T    *pDataset   = pGen->pDataset;
+    UINT32                  type        = pDataset->pElement[pDataset->numElement - 1u].type;
+    CHAR8                   name[DSGEN_MAX_NAME];
+    CHAR8                   host[DSGEN_MAX_NAME * 2u];
+    CHAR8                   wire[DSGEN_MAX_NAME * 2u];
+
+    memberName(pDataset, pDataset->numElement - 1u, name);
+    if ((cTypes[type].pAccess == NULL) && (cTypes[type].pWireType != NULL))
+    {
+        if (toWire == TRUE)
+        {
+            fprintf(sOut, "    memcpy(pDst + %uu, pH->%s, n);\n", pGen->wireSize, name);
+        }
+        else
+        {
+            fprintf(sOut, "    memcpy(pH->%s, pSrc + %uu, n);\n", name, pGen->wireSize);
+        }
+        return;
+    }
+    (void) snprintf(host, sizeof(host), "pH->%s[i]", name);
+    (void) snprintf(wire, sizeof(wire), "%s + %u + %u * i", (toWire == TRUE) ? "pDst" : "pSrc",
+                    pGen->wireSize, cTypes[type].wireSize);
+    fprintf(sOut, "    for (i = 0u; i < n; i++)\n    {\n");
+    printItem(type, toWire, host, wire, "        ");
+    fprintf(sOut, "    }\n");
+}
+
+/**********************************************************************************************************************/
+/**    Print the marshalling, unmarshalling and size function of a dataset
+ */
+static void printFunctions (const DSGEN_DS_T *pGen)
+{
+    const TRDP_DATASET_T    *pDataset   = pGen->pDataset;
+    UINT32                  id          = pDataset->id;
+    const CHAR8             *p          = sPrefix;
+    const CHAR8             *P          = sPrefixUC;
+    CHAR8                   count[DSGEN_MAX_NAME];
+    CHAR8                   name[DSGEN_MAX_NAME];
+    UINT32                  itemWire    = 0u;
+    UINT32                  countType   = 0u;
+
+    if (pGen->trailingVar == TRUE)
+    {
+        memberName(pDataset, pDataset->numElement - 2u, count);
+        memberName(pDataset, pDataset->numElement - 1u, name);
+        countType   = pDataset->pElement[pDataset->numElement - 2u].type;
+        itemWire    = cTypes[pDataset->pElement[pDataset->numElement - 1u].type].wireSize;
+    }
+
+    /*  Marshalling  */
+    fprintf(sOut, "/** Marshall dataset %u, pSrc must be aligned for %s_DS%u_T */\n", id, P, id);
+    fprintf(sOut, "%s_FN TRDP_ERR_T %s_ds%u_marshall (const UINT8 *pSrc, UINT32 srcSize, UINT8 *pDst, "
+            "UINT32 *pDstSize)\n{\n", P, p, id);
+    fprintf(sOut, "    const %s_DS%u_T *pH = (const %s_DS%u_T *) (const void *) pSrc;\n", P, id, P, id);
+    if (pGen->trailingVar == TRUE)
+    {
+        fprintf(sOut, "    UINT32 n, i;\n\n");
+        fprintf(sOut, "    if ((srcSize < offsetof(%s_DS%u_T, %s)) || (*pDstSize < %s_DS%u_WIRE_SIZE))\n",
+                P, id, name, P, id);
+        fprintf(sOut, "    {\n        return TRDP_PARAM_ERR;\n    }\n");
+        fprintf(sOut, "    n = (UINT32) pH->%s;\n", count);
+        fprintf(sOut, "    if ((n > (srcSize - offsetof(%s_DS%u_T, %s)) / sizeof(pH->%s[0])) ||\n", P, id, name, name);
+        fprintf(sOut, "        (n > (*pDstSize - %s_DS%u_WIRE_SIZE) / %uu))\n", P, id, itemWire);
+        fprintf(sOut, "    {\n        return TRDP_PARAM_ERR;\n    }\n");
+        fprintf(sOut, "    %s_ds%u_put(pH, pDst);\n", p, id);
+        printTrailing(pGen, TRUE);
+        fprintf(sOut, "    (void) i;\n");
+        fprintf(sOut, "    *pDstSize = %s_DS%u_WIRE_SIZE + n * %uu;\n", P, id, itemWire);
+    }
+    else
+    {
+        fprintf(sOut, "\n    if ((srcSize < sizeof(%s_DS%u_T)) || (*pDstSize < %s_DS%u_WIRE_SIZE))\n", P, id, P, id);
+        fprintf(sOut, "    {\n        return TRDP_PARAM_ERR;\n    }\n");
+        fprintf(sOut, "    %s_ds%u_put(pH, pDst);\n", p, id);
+        fprintf(sOut, "    *pDstSize = %s_DS%u_WIRE_SIZE;\n", P, id);
+    }
+    fprintf(sOut, "    return TRDP_NO_ERR;\n}\n\n");
+
+    /*  Unmarshalling  */
+    fprintf(sOut, "/** Unmarshall dataset %u, pDst must be aligned for %s_DS%u_T */\n", id, P, id);
+    fprintf(sOut, "%s_FN TRDP_ERR_T %s_ds%u_unmarshall (const UINT8 *pSrc, UINT32 srcSize, UINT8 *pDst, "
+            "UINT32 *pDstSize)\n{\n", P, p, id);
+    fprintf(sOut, "    %s_DS%u_T *pH = (%s_DS%u_T *) (void *) pDst;\n", P, id, P, id);
+    if (pGen->trailingVar == TRUE)
+    {
+        fprintf(sOut, "    UINT32 n, i, size;\n\n");
+        fprintf(sOut, "    if ((srcSize < %s_DS%u_WIRE_SIZE) || (*pDstSize < sizeof(%s_DS%u_T)))\n", P, id, P, id);
+        fprintf(sOut, "    {\n        return TRDP_PARAM_ERR;\n    }\n");
+        fprintf(sOut, "    %s_ds%u_get(pSrc, pH);\n", p, id);
+        fprintf(sOut, "    n = (UINT32) pH->%s;\n", count);
+        fprintf(sOut, "    if ((n > (srcSize - %s_DS%u_WIRE_SIZE) / %uu) ||\n", P, id, itemWire);
+        fprintf(sOut, "        (n > (*pDstSize - offsetof(%s_DS%u_T, %s)) / sizeof(pH->%s[0])))\n", P, id, name, name);
+        fprintf(sOut, "    {\n        return TRDP_PARAM_ERR;\n    }\n");
+        /* like tau_unmarshall: the array follows the fixed elements without the tail padding of the struct */
+        fprintf(sOut, "    size = (UINT32) ((offsetof(%s_DS%u_T, %s) + n * sizeof(pH->%s[0]) + %uu) & ~%uu);\n",
+                P, id, name, name, pGen->align - 1u, pGen->align - 1u);
+        fprintf(sOut, "    if (size > *pDstSize)\n    {\n        return TRDP_PARAM_ERR;\n    }\n");
+        printTrailing(pGen, FALSE);
+        fprintf(sOut, "    (void) i;\n");
+        fprintf(sOut, "    *pDstSize = size;\n");
+    }
+    else
+    {
+        fprintf(sOut, "\n    if ((srcSize < %s_DS%u_WIRE_SIZE) || (*pDstSize < sizeof(%s_DS%u_T)))\n", P, id, P, id);
+        fprintf(sOut, "    {\n        return TRDP_PARAM_ERR;\n    }\n");
+        fprintf(sOut, "    %s_ds%u_get(pSrc, pH);\n", p, id);
+        fprintf(sOut, "    *pDstSize = sizeof(%s_DS%u_T);\n", P, id);
+    }
+    fprintf(sOut, "    return TRDP_NO_ERR;\n}\n\n");
+
+    /*  Size of the unmarshalled dataset  */
+    fprintf(sOut, "/** Host size of dataset %u as received */\n", id);
+    fprintf(sOut, "%s_FN TRDP_ERR_T %s_ds%u_size (const UINT8 *pSrc, UINT32 srcSize, UINT32 *pHostSize)\n{\n",
+            P, p, id);
+    if (pGen->trailingVar == TRUE)
+    {
+        CHAR8 host[DSGEN_MAX_NAME * 2u];
+        CHAR8 wire[DSGEN_MAX_NAME * 2u];
+
+        fprintf(sOut, "    %-10s n;\n\n", cTypes[countType].pCType);
+        fprintf(sOut, "    if (srcSize < %s_DS%u_WIRE_SIZE)\n", P, id);
+        fprintf(sOut, "    {\n        return TRDP_PARAM_ERR;\n    }\n");
+        (void) snprintf(host, sizeof(host), "n");
+        (void) snprintf(wire, sizeof(wire), "pSrc + %u", pGen->wireSize - cTypes[countType].wireSize);
+        printItem(countType, FALSE, host, wire, "    ");
+        fprintf(sOut, "    *pHostSize = (UINT32) ((offsetof(%s_DS%u_T, %s) + (UINT32) n * sizeof(((%s_DS%u_T *) 0)->%s[0])"
+                " + %uu) & ~%uu);\n", P, id, name, P, id, name, pGen->align - 1u, pGen->align - 1u);
+    }
+    else
+    {
+        fprintf(sOut, "    (void) pSrc;\n\n");
+        fprintf(sOut, "    if (srcSize < %s_DS%u_WIRE_SIZE)\n", P, id);
+        fprintf(sOut, "    {\n        return TRDP_PARAM_ERR;\n    }\n");
+        fprintf(sOut, "    *pHostSize = sizeof(%s_DS%u_T);\n", P, id);
+    }
+    fprintf(sOut, "    return TRDP_NO_ERR;\n}\n\n");
+}
+
+/**********************************************************************************************************************/
+/**    Print a usable dataset after the datasets nested in it
+ */
+static void printDataset (DSGEN_DS_T *pGen, BOOL8 topLevel)
+{
+    const TRDP_DATASET_T    *pDataset = pGen->pDataset;
+    UINT32                  i;
+
+    if (pGen->state == 3u)
+    {
+        return;                                 /* printed already */
+    }
+    pGen->state = 3u;
+
+    for (i = 0u; i < pDataset->numElement; i++)
+    {
+        if (pDataset->pElement[i].type > TRDP_TYPE_MAX)
+        {
+            printDataset(findDs(pDataset->pElement[i].type), FALSE);
+        }
+    }
+    printStructs(pGen);
+    printConvert(pGen, TRUE);
+    printConvert(pGen, FALSE);
+    if ((topLevel == TRUE) || (pGen->trailingVar == FALSE))
+    {
+        printFunctions(pGen);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Print one of the dispatch functions of all ComIds
+ *
+ *  @param[in]      numComId        number of ComIds
+ *  @param[in]      pComIdDsIdMap   ComId to dataset relation
+ *  @param[in]      pKind           "marshall", "unmarshall" or "size"
+ */
+static void printDispatch (UINT32 numComId, const TRDP_COMID_DSID_MAP_T *pComIdDsIdMap, const CHAR8 *pKind)
+{
+    BOOL8   isSize = (strcmp(pKind, "size") == 0) ? TRUE : FALSE;
+    UINT32  i;
+
+    if (isSize == TRUE)
+    {
+        fprintf(sOut, "/** Size callback like tau_calcDatasetSizeByComId(), other ComIds are passed to it */\n");
+        fprintf(sOut, "%s_FN TRDP_ERR_T %s_calcSize (void *pRefCon, UINT32 comId, UINT8 *pSrc, UINT32 srcSize,\n",
+                sPrefixUC, sPrefix);
+        fprintf(sOut, "    UINT32 *pDestSize, TRDP_DATASET_T **ppCachedDS)\n{\n");
+    }
+    else
+    {
+        fprintf(sOut, "/** %s callback for TRDP_MARSHALL_CONFIG_T, other ComIds are passed to tau_%s() */\n",
+                (pKind[0] == 'm') ? "Marshalling" : "Unmarshalling", pKind);
+        fprintf(sOut, "%s_FN TRDP_ERR_T %s_%s (void *pRefCon, UINT32 comId, %sUINT8 *pSrc, UINT32 srcSize,\n",
+                sPrefixUC, sPrefix, pKind, (pKind[0] == 'm') ? "const " : "");
+        fprintf(sOut, "    UINT8 *pDst, UINT32 *pDstSize, TRDP_DATASET_T **ppCachedDS)\n{\n");
+    }
+    fprintf(sOut, "    switch (comId)\n    {\n");
+    for (i = 0u; i < numComId; i++)
+    {
+        DSGEN_DS_T *pGen = findDs(pComIdDsIdMap[i].datasetId);
+
+        if ((pGen != NULL) && (pGen->usable == TRUE))
+        {
+            fprintf(sOut, "       case %uu:\n", pComIdDsIdMap[i].comId);
+            if (isSize == TRUE)
+            {
+                fprintf(sOut, "           return %s_ds%u_size(pSrc, srcSize, pDestSize);\n",
+                        sPrefix, pComIdDsIdMap[i].datasetId);
+            }
+            else
+            {
+                fprintf(sOut, "           return %s_ds%u_%s(pSrc, srcSize, pDst, pDstSize);\n",
+                        sPrefix, pComIdDsIdMap[i].datasetId, pKind);
+            }
+        }
+    }
+    fprintf(sOut, "       default:\n           break;\n    }\n");
+    fprintf(sOut, "#ifdef %s_NO_FALLBACK\n", sPrefixUC);
+    fprintf(sOut, "    (void) pRefCon;\n    (void) ppCachedDS;\n    return TRDP_COMID_ERR;\n#else\n");
+    if (isSize == TRUE)
+    {
+        fprintf(sOut, "    return tau_calcDatasetSizeByComId(pRefCon, comId, pSrc, srcSize, pDestSize, ppCachedDS);\n");
+    }
+    else
+    {
+        fprintf(sOut, "    return tau_%s(pRefCon, comId, pSrc, srcSize, pDst, pDstSize, ppCachedDS);\n", pKind);
+    }
+    fprintf(sOut, "#endif\n}\n\n");
+}
+
+/**********************************************************************************************************************/
+/**    Print usage
+ */
+static void usage (const char *pName)
+{
+    printf("usage: %s [-p prefix] [-o header] <xml file>\n", pName);
+    printf("  -p prefix   prefix of the generated names, default 'trdp_ds'\n");
+    printf("  -o header   file to write, default stdout\n");
+}
+
+/***********************************************************************************************************************
+ * MAIN
+ */
+
+int main (int argc, char *argv[])
+{
+    TRDP_XML_DOC_HANDLE_T   docHandle;
+    TRDP_ERR_T              result;
+    UINT32                  numComId        = 0u;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap  = NULL;
+    UINT32                  numDataset      = 0u;
+    apTRDP_DATASET_T        apDataset       = NULL;
+    const char              *pFileName      = NULL;
+    const char              *pOutName       = NULL;
+    const char              *pPrefix        = "trdp_ds";
+    UINT32                  numUsable       = 0u;
+    UINT32                  i;
+    int                     ch;
+
+    while ((ch = getopt(argc, argv, "p:o:h")) != -1)
+    {
+        switch (ch)
+        {
+           case 'p':
+               pPrefix = optarg;
+               break;
+           case 'o':
+               pOutName = optarg;
+               break;
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+    if ((optind + 1 != argc) || (strlen(pPrefix) >= DSGEN_MAX_NAME - 1u))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    pFileName = argv[optind];
+
+    for (i = 0u; pPrefix[i] != '\0'; i++)
+    {
+        sPrefix[i]      = (CHAR8) (isalnum((unsigned char) pPrefix[i]) ? pPrefix[i] : '_');
+        sPrefixUC[i]    = (CHAR8) toupper((unsigned char) sPrefix[i]);
+    }
+
+    /*  Read the datasets    */
+    result = tau_prepareXmlDoc(pFileName, &docHandle);
+    if (result != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Failed to parse XML document %s\n", pFileName);
+        return 1;
+    }
+    result = tau_readXmlDatasetConfig(&docHandle, &numComId, &pComIdDsIdMap, &numDataset, &apDataset);
+    if (result != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Failed to read dataset configuration: %d\n", result);
+        tau_freeXmlDoc(&docHandle);
+        return 1;
+    }
+
+    sNumDs  = numDataset;
+    sDs     = (DSGEN_DS_T *) calloc((numDataset > 0u) ? numDataset : 1u, sizeof(DSGEN_DS_T));
+    sOut    = (pOutName != NULL) ? fopen(pOutName, "w") : stdout;
+    if ((sDs == NULL) || (sOut == NULL))
+    {
+        fprintf(stderr, "Cannot write %s\n", (pOutName != NULL) ? pOutName : "output");
+        tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+        tau_freeXmlDoc(&docHandle);
+        return 1;
+    }
+    for (i = 0u; i < numDataset; i++)
+    {
+        sDs[i].pDataset = apDataset[i];
+    }
+    for (i = 0u; i < numDataset; i++)
+    {
+        if (analyse(&sDs[i], 1u) == TRUE)
+        {
+            numUsable++;
+        }
+        else
+        {
+            fprintf(stderr, "Dataset %u left to tau_marshall()\n", apDataset[i]->id);
+        }
+    }
+
+    /*  Write the header    */
+    fprintf(sOut, "/* Generated by trdp-dsgen from %s - do not edit */\n\n", pFileName);
+    fprintf(sOut, "#ifndef %s_DATASETS_H\n#define %s_DATASETS_H\n\n", sPrefixUC, sPrefixUC);
+    fprintf(sOut, "#include <stddef.h>\n#include <string.h>\n\n#include \"trdp_types.h\"\n#include \"tau_marshall.h\"\n\n");
+    fprintf(sOut, "#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n");
+    fprintf(sOut, "#if defined(__GNUC__)\n#define %s_FN  static INLINE __attribute__((unused))\n", sPrefixUC);
+    fprintf(sOut, "#else\n#define %s_FN  static INLINE\n#endif\n\n", sPrefixUC);
+    printHelpers();
+
+    for (i = 0u; i < numDataset; i++)
+    {
+        if (sDs[i].usable == TRUE)
+        {
+            printDataset(&sDs[i], TRUE);
+        }
+    }
+
+    printDispatch(numComId, pComIdDsIdMap, "marshall");
+    printDispatch(numComId, pComIdDsIdMap, "unmarshall");
+    printDispatch(numComId, pComIdDsIdMap, "size");
+
+    fprintf(sOut, "#ifdef __cplusplus\n}\n#endif\n\n#endif /* %s_DATASETS_H */\n", sPrefixUC);
+
+    if (sOut != stdout)
+    {
+        (void) fclose(sOut);
+    }
+    fprintf(stderr, "%u of %u datasets generated\n", numUsable, numDataset);
+
+    free(sDs);
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+    tau_freeXmlDoc(&docHandle);
+    return 0;
+}
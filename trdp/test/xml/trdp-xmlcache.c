@@ -0,0 +1,385 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-xmlcache.c
+ *
+ * @brief           Configuration cache tool
+ *
+ * @details         Writes the binary configuration cache of a TRDP XML configuration file with tau_writeXmlCache,
+ *                  checks whether a cache is usable for an XML file, compares the configuration read through the cache
+ *                  with the one read from the XML file and times both ways of reading it.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "vos_utils.h"
+#include "vos_thread.h"
+#include "tau_xml.h"
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Configuration as read by the tau_readXml* functions */
+typedef struct
+{
+    TRDP_MEM_CONFIG_T       memConfig;
+    TRDP_DBG_CONFIG_T       dbgConfig;
+    UINT32                  numComPar;
+    TRDP_COM_PAR_T          *pComPar;
+    UINT32                  numIfConfig;
+    TRDP_IF_CONFIG_T        *pIfConfig;
+    TRDP_PROCESS_CONFIG_T   *pProcessConfig;    /**< per interface                  */
+    TRDP_PD_CONFIG_T        *pPdConfig;         /**< per interface                  */
+    TRDP_MD_CONFIG_T        *pMdConfig;         /**< per interface                  */
+    UINT32                  *pNumExchgPar;      /**< per interface                  */
+    TRDP_EXCHG_PAR_T        * *ppExchgPar;      /**< per interface                  */
+    UINT32                  numComId;
+    TRDP_COMID_DSID_MAP_T   *pComIdMap;
+    UINT32                  numDataset;
+    apTRDP_DATASET_T        apDataset;
+} CONFIG_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static void usage (const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Write the binary configuration cache of a TRDP XML configuration.\n"
+           "Arguments are:\n"
+           "[-c] only check whether the cache is usable for the XML file, exit code 2 if not\n"
+           "[-v] compare the configuration read through the cache with the XML file\n"
+           "[-t loops] time reading the configuration from the XML file and from the cache\n"
+           "<xml file> <cache file>\n");
+}
+
+/* Read the complete configuration, the interfaces as listed in the device configuration */
+static TRDP_ERR_T readConfig (const TRDP_XML_DOC_HANDLE_T *pDocHnd, CONFIG_T *pCfg)
+{
+    TRDP_ERR_T  err;
+    UINT32      i;
+
+    memset(pCfg, 0, sizeof(CONFIG_T));
+    err = tau_readXmlDeviceConfig(pDocHnd, &pCfg->memConfig, &pCfg->dbgConfig, &pCfg->numComPar, &pCfg->pComPar,
+                                  &pCfg->numIfConfig, &pCfg->pIfConfig);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    if (pCfg->numIfConfig > 0u)
+    {
+        pCfg->pProcessConfig    = (TRDP_PROCESS_CONFIG_T *) calloc(pCfg->numIfConfig, sizeof(TRDP_PROCESS_CONFIG_T));
+        pCfg->pPdConfig         = (TRDP_PD_CONFIG_T *) calloc(pCfg->numIfConfig, sizeof(TRDP_PD_CONFIG_T));
+        pCfg->pMdConfig         = (TRDP_MD_CONFIG_T *) calloc(pCfg->numIfConfig, sizeof(TRDP_MD_CONFIG_T));
+        pCfg->pNumExchgPar      = (UINT32 *) calloc(pCfg->numIfConfig, sizeof(UINT32));
+        pCfg->ppExchgPar        = (TRDP_EXCHG_PAR_T * *) calloc(pCfg->numIfConfig, sizeof(TRDP_EXCHG_PAR_T *));
+        if ((pCfg->pProcessConfig == NULL) || (pCfg->pPdConfig == NULL) || (pCfg->pMdConfig == NULL) ||
+            (pCfg->pNumExchgPar == NULL) || (pCfg->ppExchgPar == NULL))
+        {
+            return TRDP_MEM_ERR;
+        }
+    }
+    for (i = 0u; (i < pCfg->numIfConfig) && (err == TRDP_NO_ERR); i++)
+    {
+        err = tau_readXmlInterfaceConfig(pDocHnd, pCfg->pIfConfig[i].ifName, &pCfg->pProcessConfig[i],
+                                         &pCfg->pPdConfig[i], &pCfg->pMdConfig[i],
+                                         &pCfg->pNumExchgPar[i], &pCfg->ppExchgPar[i]);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        err = tau_readXmlDatasetConfig(pDocHnd, &pCfg->numComId, &pCfg->pComIdMap, &pCfg->numDataset,
+                                       &pCfg->apDataset);
+    }
+    return err;
+}
+
+static void freeConfig (CONFIG_T *pCfg)
+{
+    UINT32 i;
+
+    for (i = 0u; (pCfg->pNumExchgPar != NULL) && (i < pCfg->numIfConfig); i++)
+    {
+        tau_freeTelegrams(pCfg->pNumExchgPar[i], pCfg->ppExchgPar[i]);
+    }
+    tau_freeXmlDatasetConfig(pCfg->numComId, pCfg->pComIdMap, pCfg->numDataset, pCfg->apDataset);
+    if (pCfg->pComPar != NULL)
+    {
+        vos_memFree(pCfg->pComPar);
+    }
+    if (pCfg->pIfConfig != NULL)
+    {
+        vos_memFree(pCfg->pIfConfig);
+    }
+    free(pCfg->pProcessConfig);
+    free(pCfg->pPdConfig);
+    free(pCfg->pMdConfig);
+    free(pCfg->pNumExchgPar);
+    free(pCfg->ppExchgPar);
+    memset(pCfg, 0, sizeof(CONFIG_T));
+}
+
+/* Compare two optional records or strings */
+static int sameRec (const void *pA, const void *pB, size_t size)
+{
+    if ((pA == NULL) || (pB == NULL))
+    {
+        return pA == pB;
+    }
+    return memcmp(pA, pB, size) == 0;
+}
+
+static int sameStr (const void *pA, const void *pB)
+{
+    if ((pA == NULL) || (pB == NULL))
+    {
+        return pA == pB;
+    }
+    return strcmp((const char *) pA, (const char *) pB) == 0;
+}
+
+static int sameTelegram (const TRDP_EXCHG_PAR_T *pA, const TRDP_EXCHG_PAR_T *pB)
+{
+    UINT32 i;
+
+    if ((pA->comId != pB->comId) || (pA->datasetId != pB->datasetId) || (pA->comParId != pB->comParId) ||
+        (pA->destCnt != pB->destCnt) || (pA->srcCnt != pB->srcCnt) || (pA->type != pB->type) ||
+        (pA->create != pB->create) || (pA->serviceId != pB->serviceId) ||
+        !sameRec(pA->pMdPar, pB->pMdPar, sizeof(TRDP_MD_PAR_T)) ||
+        !sameRec(pA->pPdPar, pB->pPdPar, sizeof(TRDP_PD_PAR_T)))
+    {
+        return 0;
+    }
+    for (i = 0u; i < pA->destCnt; i++)
+    {
+        if ((pA->pDest[i].id != pB->pDest[i].id) ||
+            !sameRec(pA->pDest[i].pSdtPar, pB->pDest[i].pSdtPar, sizeof(TRDP_SDT_PAR_T)) ||
+            !sameStr(pA->pDest[i].pUriUser, pB->pDest[i].pUriUser) ||
+            !sameStr(pA->pDest[i].pUriHost, pB->pDest[i].pUriHost))
+        {
+            return 0;
+        }
+    }
+    for (i = 0u; i < pA->srcCnt; i++)
+    {
+        if ((pA->pSrc[i].id != pB->pSrc[i].id) ||
+            !sameRec(pA->pSrc[i].pSdtPar, pB->pSrc[i].pSdtPar, sizeof(TRDP_SDT_PAR_T)) ||
+            !sameStr(pA->pSrc[i].pUriUser, pB->pSrc[i].pUriUser) ||
+            !sameStr(pA->pSrc[i].pUriHost1, pB->pSrc[i].pUriHost1) ||
+            !sameStr(pA->pSrc[i].pUriHost2, pB->pSrc[i].pUriHost2))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Compare two configurations, print the first difference */
+static int sameConfig (const CONFIG_T *pA, const CONFIG_T *pB)
+{
+    UINT32 i, j;
+
+    if (!sameRec(&pA->memConfig, &pB->memConfig, sizeof(TRDP_MEM_CONFIG_T)) ||
+        !sameRec(&pA->dbgConfig, &pB->dbgConfig, sizeof(TRDP_DBG_CONFIG_T)) ||
+        (pA->numComPar != pB->numComPar) ||
+        !sameRec(pA->pComPar, pB->pComPar, pA->numComPar * sizeof(TRDP_COM_PAR_T)) ||
+        (pA->numIfConfig != pB->numIfConfig) ||
+        !sameRec(pA->pIfConfig, pB->pIfConfig, pA->numIfConfig * sizeof(TRDP_IF_CONFIG_T)))
+    {
+        printf("device configuration differs\n");
+        return 0;
+    }
+    for (i = 0u; i < pA->numIfConfig; i++)
+    {
+        if (!sameRec(&pA->pProcessConfig[i], &pB->pProcessConfig[i], sizeof(TRDP_PROCESS_CONFIG_T)) ||
+            !sameRec(&pA->pPdConfig[i], &pB->pPdConfig[i], sizeof(TRDP_PD_CONFIG_T)) ||
+            !sameRec(&pA->pMdConfig[i], &pB->pMdConfig[i], sizeof(TRDP_MD_CONFIG_T)) ||
+            (pA->pNumExchgPar[i] != pB->pNumExchgPar[i]))
+        {
+            printf("configuration of interface %s differs\n", pA->pIfConfig[i].ifName);
+            return 0;
+        }
+        for (j = 0u; j < pA->pNumExchgPar[i]; j++)
+        {
+            if (!sameTelegram(&pA->ppExchgPar[i][j], &pB->ppExchgPar[i][j]))
+            {
+                printf("telegram %u of interface %s differs\n", j, pA->pIfConfig[i].ifName);
+                return 0;
+            }
+        }
+    }
+    if ((pA->numComId != pB->numComId) ||
+        !sameRec(pA->pComIdMap, pB->pComIdMap, pA->numComId * sizeof(TRDP_COMID_DSID_MAP_T)) ||
+        (pA->numDataset != pB->numDataset))
+    {
+        printf("dataset configuration differs\n");
+        return 0;
+    }
+    for (i = 0u; i < pA->numDataset; i++)
+    {
+        const TRDP_DATASET_T *pDa = pA->apDataset[i], *pDb = pB->apDataset[i];
+
+        if ((pDa->id != pDb->id) || (pDa->numElement != pDb->numElement) || strcmp(pDa->name, pDb->name))
+        {
+            printf("dataset %u differs\n", pDa->id);
+            return 0;
+        }
+        for (j = 0u; j < pDa->numElement; j++)
+        {
+            if ((pDa->pElement[j].type != pDb->pElement[j].type) ||
+                (pDa->pElement[j].size != pDb->pElement[j].size) ||
+                (pDa->pElement[j].scale != pDb->pElement[j].scale) ||
+                (pDa->pElement[j].offset != pDb->pElement[j].offset) ||
+                !sameStr(pDa->pElement[j].name, pDb->pElement[j].name) ||
+                !sameStr(pDa->pElement[j].unit, pDb->pElement[j].unit))
+            {
+                printf("element %u of dataset %u differs\n", j, pDa->id);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/* Time opening the document and reading the configuration, in us per loop */
+static UINT32 timeRead (const char *pXmlFile, const char *pCacheFile, UINT32 loops)
+{
+    VOS_TIMEVAL_T   start, now;
+    UINT32          i;
+
+    vos_getTime(&start);
+    for (i = 0u; i < loops; i++)
+    {
+        TRDP_XML_DOC_HANDLE_T   docHnd;
+        CONFIG_T                cfg;
+
+        if (tau_prepareXmlCache(pXmlFile, pCacheFile, &docHnd) == TRDP_NO_ERR)
+        {
+            (void) readConfig(&docHnd, &cfg);
+            freeConfig(&cfg);
+        }
+        tau_freeXmlDoc(&docHnd);
+    }
+    vos_getTime(&now);
+    vos_subTime(&now, &start);
+    return (UINT32) ((now.tv_sec * 1000000u + now.tv_usec) / loops);
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+int main (int argc, char *argv[])
+{
+    TRDP_XML_DOC_HANDLE_T   xmlHnd;
+    TRDP_XML_DOC_HANDLE_T   cacheHnd;
+    CONFIG_T                xmlCfg;
+    CONFIG_T                cacheCfg;
+    const char              *pXmlFile;
+    const char              *pCacheFile;
+    BOOL8                   checkOnly   = FALSE;
+    BOOL8                   verify      = FALSE;
+    UINT32                  loops       = 0u;
+    TRDP_ERR_T              err;
+    int                     ch;
+    int                     rc = 0;
+
+    while ((ch = getopt(argc, argv, "cvt:h")) != -1)
+    {
+        switch (ch)
+        {
+           case 'c':
+               checkOnly = TRUE;
+               break;
+           case 'v':
+               verify = TRUE;
+               break;
+           case 't':
+               loops = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+    if (optind + 2 != argc)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    pXmlFile    = argv[optind];
+    pCacheFile  = argv[optind + 1];
+    memset(&xmlCfg, 0, sizeof(xmlCfg));
+    memset(&cacheCfg, 0, sizeof(cacheCfg));
+
+    if (checkOnly == FALSE)
+    {
+        err = tau_writeXmlCache(pXmlFile, pCacheFile);
+        if (err != TRDP_NO_ERR)
+        {
+            fprintf(stderr, "Failed to write cache %s of %s: %d\n", pCacheFile, pXmlFile, err);
+            return 1;
+        }
+    }
+
+    err = tau_prepareXmlCache(pXmlFile, pCacheFile, &cacheHnd);
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Failed to open %s: %d\n", pXmlFile, err);
+        return 1;
+    }
+    if (cacheHnd.pCache == NULL)
+    {
+        printf("%s is stale or damaged\n", pCacheFile);
+        rc = 2;
+    }
+    else
+    {
+        printf("%s is up to date\n", pCacheFile);
+    }
+
+    if ((verify == TRUE) && (rc == 0))
+    {
+        err = tau_prepareXmlDoc(pXmlFile, &xmlHnd);
+        if ((err != TRDP_NO_ERR) || (readConfig(&xmlHnd, &xmlCfg) != TRDP_NO_ERR) ||
+            (readConfig(&cacheHnd, &cacheCfg) != TRDP_NO_ERR))
+        {
+            fprintf(stderr, "Failed to read configuration\n");
+            rc = 1;
+        }
+        else if (!sameConfig(&xmlCfg, &cacheCfg))
+        {
+            rc = 1;
+        }
+        else
+        {
+            printf("%u interfaces, %u datasets, %u ComIds identical\n",
+                   xmlCfg.numIfConfig, xmlCfg.numDataset, xmlCfg.numComId);
+        }
+        freeConfig(&xmlCfg);
+        freeConfig(&cacheCfg);
+        tau_freeXmlDoc(&xmlHnd);
+    }
+    tau_freeXmlDoc(&cacheHnd);
+
+    if ((loops > 0u) && (rc == 0))
+    {
+        printf("XML   : %u us\n", timeRead(pXmlFile, NULL, loops));
+        printf("cache : %u us\n", timeRead(pXmlFile, pCacheFile, loops));
+    }
+    return rc;
+}
@@ -0,0 +1,941 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-xmlload.c
+ *
+ * @brief           Offline schedule and load analyzer
+ *
+ * @details         Reads a device configuration with the tau_readXml* functions and sets up the publishers and
+ *                  subscribers each bus interface session would have, without opening any PD or MD socket. The
+ *                  send times are assigned by the stack itself: traffic shaping, the hyperperiod schedule or, in
+ *                  HIGH_PERF_INDEXED builds, the index tables. A simulated clock then steps through the process
+ *                  cycles and records the packets and bytes sent in each of them.
+ *                  Reported are the send load per process cycle with its peaks, the expected receive and timeout
+ *                  supervision load, and the vos_mem blocks the configuration needs.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "trdp_if_light.h"
+#include "tau_xml.h"
+#include "vos_utils.h"
+#include "vos_mem.h"
+#include "trdp_private.h"
+#include "trdp_utils.h"
+#include "trdp_pdcom.h"
+#include "trdp_pdsched.h"
+#ifdef HIGH_PERF_INDEXED
+#include "trdp_pdindex.h"
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define ANALYSIS_POOL_SIZE  (64u * 1024u * 1024u)   /**< vos_mem pool used if none or a smaller one is configured  */
+#define DEFAULT_DURATION    10000u                  /**< simulated time (ms), after the warm-up                     */
+#define DEFAULT_LINK_SPEED  100u                    /**< Mbit/s                                                     */
+#define UDP_IP_ETH_SIZE     46u                     /**< UDP (8), IPv4 (20), Ethernet header and FCS (18)           */
+#define ETH_MIN_FRAME       64u                     /**< minimum Ethernet frame                                     */
+#define ETH_GAP_SIZE        20u                     /**< preamble, start of frame delimiter and inter frame gap     */
+#define MAX_DS_NESTING      16u                     /**< nesting depth of datasets                                  */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Configuration as read by the tau_readXml* functions */
+typedef struct
+{
+    TRDP_MEM_CONFIG_T       memConfig;
+    TRDP_DBG_CONFIG_T       dbgConfig;
+    UINT32                  numComPar;
+    TRDP_COM_PAR_T          *pComPar;
+    UINT32                  numIfConfig;
+    TRDP_IF_CONFIG_T        *pIfConfig;
+    TRDP_PROCESS_CONFIG_T   *pProcessConfig;    /**< per interface                  */
+    TRDP_PD_CONFIG_T        *pPdConfig;         /**< per interface                  */
+    TRDP_MD_CONFIG_T        *pMdConfig;         /**< per interface                  */
+    UINT32                  *pNumExchgPar;      /**< per interface                  */
+    TRDP_EXCHG_PAR_T        * *ppExchgPar;      /**< per interface                  */
+    UINT32                  numComId;
+    TRDP_COMID_DSID_MAP_T   *pComIdMap;
+    UINT32                  numDataset;
+    apTRDP_DATASET_T        apDataset;
+} CONFIG_T;
+
+/** Receive side of an interface, as far as known from the configuration */
+typedef struct
+{
+    UINT32  noOfSubs;               /**< subscriptions                                          */
+    UINT32  noOfUnknown;            /**< subscriptions without a cycle to expect                */
+    UINT32  worstPerCycle;          /**< packets in one process cycle if all sources are in phase */
+    REAL64  packetsPerSec;          /**< expected packets per second                            */
+    REAL64  bytesPerSec;            /**< expected bytes per second                              */
+} RX_LOAD_T;
+
+/** Send load of the simulated process cycles */
+typedef struct
+{
+    UINT32  cycle;                  /**< process cycle (us)                                     */
+    UINT32  noOfCycles;             /**< simulated cycles                                       */
+    UINT32  *pPackets;              /**< packets sent per cycle                                 */
+    UINT32  *pBytes;                /**< TRDP bytes (header, data, padding) sent per cycle      */
+    UINT32  *pLineBytes;            /**< bytes on the line incl. UDP/IP/Ethernet and gaps       */
+} TX_LOAD_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static UINT32   sLinkSpeed  = DEFAULT_LINK_SPEED;
+static REAL64   sUsPerPacket;
+
+static void usage (const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Compute the network and CPU load a TRDP XML configuration will cause, without any communication.\n"
+           "Arguments are:\n"
+           "[-d ms] simulated time after the warm-up (default %u)\n"
+           "[-l Mbit/s] link speed (default %u)\n"
+           "[-u us] CPU time per packet sent or received, e.g. measured with bench_pdshard (default: not reported)\n"
+           "[-p n] print the load of the first n simulated process cycles\n"
+           "<xml file>\n", DEFAULT_DURATION, DEFAULT_LINK_SPEED);
+}
+
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      line,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    (void) pTime;
+    if (category <= VOS_LOG_WARNING)
+    {
+        printf("%s:%u %s", (strrchr(pFile, '/') != NULL) ? strrchr(pFile, '/') + 1 : pFile, line, pMsgStr);
+    }
+}
+
+/* Read the configuration of the interfaces and the datasets, the device configuration was read before */
+static TRDP_ERR_T readInterfaces (const TRDP_XML_DOC_HANDLE_T *pDocHnd, CONFIG_T *pCfg)
+{
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      i;
+
+    if (pCfg->numIfConfig > 0u)
+    {
+        pCfg->pProcessConfig    = (TRDP_PROCESS_CONFIG_T *) calloc(pCfg->numIfConfig, sizeof(TRDP_PROCESS_CONFIG_T));
+        pCfg->pPdConfig         = (TRDP_PD_CONFIG_T *) calloc(pCfg->numIfConfig, sizeof(TRDP_PD_CONFIG_T));
+        pCfg->pMdConfig         = (TRDP_MD_CONFIG_T *) calloc(pCfg->numIfConfig, sizeof(TRDP_MD_CONFIG_T));
+        pCfg->pNumExchgPar      = (UINT32 *) calloc(pCfg->numIfConfig, sizeof(UINT32));
+        pCfg->ppExchgPar        = (TRDP_EXCHG_PAR_T * *) calloc(pCfg->numIfConfig, sizeof(TRDP_EXCHG_PAR_T *));
+        if ((pCfg->pProcessConfig == NULL) || (pCfg->pPdConfig == NULL) || (pCfg->pMdConfig == NULL) ||
+            (pCfg->pNumExchgPar == NULL) || (pCfg->ppExchgPar == NULL))
+        {
+            return TRDP_MEM_ERR;
+        }
+    }
+    for (i = 0u; (i < pCfg->numIfConfig) && (err == TRDP_NO_ERR); i++)
+    {
+        err = tau_readXmlInterfaceConfig(pDocHnd, pCfg->pIfConfig[i].ifName, &pCfg->pProcessConfig[i],
+                                         &pCfg->pPdConfig[i], &pCfg->pMdConfig[i],
+                                         &pCfg->pNumExchgPar[i], &pCfg->ppExchgPar[i]);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        err = tau_readXmlDatasetConfig(pDocHnd, &pCfg->numComId, &pCfg->pComIdMap, &pCfg->numDataset,
+                                       &pCfg->apDataset);
+    }
+    return err;
+}
+
+/* Size of a dataset on the wire; arrays of variable size are counted without elements */
+static UINT32 datasetSize (const CONFIG_T *pCfg, UINT32 datasetId, UINT32 depth, BOOL8 *pVarSize)
+{
+    static const UINT32 typeSize[TRDP_TIMEDATE64 + 1] = {0u, 1u, 1u, 2u, 1u, 2u, 4u, 8u, 1u, 2u, 4u, 8u, 4u, 8u, 4u,
+                                                         6u, 8u};
+    const TRDP_DATASET_T    *pDataset = NULL;
+    UINT32                  size = 0u;
+    UINT32                  i;
+
+    for (i = 0u; (i < pCfg->numDataset) && (pDataset == NULL); i++)
+    {
+        if (pCfg->apDataset[i]->id == datasetId)
+        {
+            pDataset = pCfg->apDataset[i];
+        }
+    }
+    if ((pDataset == NULL) || (depth > MAX_DS_NESTING))
+    {
+        printf("Dataset %u unknown or nested too deeply, counted with size 0\n", datasetId);
+        return 0u;
+    }
+    for (i = 0u; i < pDataset->numElement; i++)
+    {
+        const TRDP_DATASET_ELEMENT_T *pElement = &pDataset->pElement[i];
+
+        if (pElement->size == TRDP_VAR_SIZE)
+        {
+            *pVarSize = TRUE;
+        }
+        else if (pElement->type <= TRDP_TIMEDATE64)
+        {
+            size += typeSize[pElement->type] * pElement->size;
+        }
+        else
+        {
+            size += datasetSize(pCfg, pElement->type, depth + 1u, pVarSize) * pElement->size;
+        }
+    }
+    return size;
+}
+
+/* Enter a publisher the way tlp_publish() does */
+static PD_ELE_T *addPub (TRDP_SESSION_PT pSession, UINT32 comId, UINT32 interval, UINT32 dataSize)
+{
+    PD_ELE_T *pElement = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
+
+    if (pElement == NULL)
+    {
+        return NULL;
+    }
+    pElement->dataSize  = dataSize;
+    pElement->grossSize = trdp_packetSizePD(dataSize);
+    pElement->pFrame    = (PD_PACKET_T *) vos_memAlloc(pElement->grossSize);
+    if (pElement->pFrame == NULL)
+    {
+        vos_memFree(pElement);
+        return NULL;
+    }
+    pElement->addr.comId    = comId;
+    pElement->magic         = TRDP_MAGIC_PUB_HNDL_VALUE;
+    if (interval != 0u)
+    {
+        pElement->interval.tv_sec   = interval / 1000000u;
+        pElement->interval.tv_usec  = interval % 1000000u;
+        vos_getTime(&pElement->timeToGo);
+        vos_addTime(&pElement->timeToGo, &pElement->interval);
+    }
+#ifdef HIGH_PERF_INDEXED
+    trdp_queueInsThroughputAccending(&pSession->pSndQueue, pElement);
+#else
+    trdp_queueInsFirst(&pSession->pSndQueue, pElement);
+    if (!(pSession->option & TRDP_OPTION_PD_SCHEDULE) && (pSession->option & TRDP_OPTION_TRAFFIC_SHAPING))
+    {
+        (void) trdp_pdDistribute(pSession->pSndQueue);
+    }
+#endif
+    return pElement;
+}
+
+/* Enter a subscriber the way tlp_subscribe() does */
+static PD_ELE_T *addSub (TRDP_SESSION_PT pSession, UINT32 comId, UINT32 timeout)
+{
+    PD_ELE_T *pElement = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
+
+    if (pElement == NULL)
+    {
+        return NULL;
+    }
+    pElement->pFrame = (PD_PACKET_T *) vos_memAlloc(TRDP_MAX_PD_PACKET_SIZE);
+    if (pElement->pFrame == NULL)
+    {
+        vos_memFree(pElement);
+        return NULL;
+    }
+    pElement->addr.comId    = comId;
+    pElement->grossSize     = TRDP_MAX_PD_PACKET_SIZE;
+    pElement->magic         = TRDP_MAGIC_SUB_HNDL_VALUE;
+    if (timeout != TRDP_INFINITE_TIMEOUT)
+    {
+        pElement->interval.tv_sec   = timeout / 1000000u;
+        pElement->interval.tv_usec  = timeout % 1000000u;
+        vos_getTime(&pElement->timeToGo);
+        vos_addTime(&pElement->timeToGo, &pElement->interval);
+    }
+    trdp_queueAppLast(&pSession->pRcvQueue, pElement);
+    return pElement;
+}
+
+/* Set up a session like tlc_openSession(), without sockets */
+static TRDP_SESSION_PT openSession (const CONFIG_T *pCfg, UINT32 ifIdx)
+{
+    TRDP_SESSION_PT pSession = (TRDP_SESSION_PT) vos_memAlloc(sizeof(TRDP_SESSION_T));
+
+    if (pSession == NULL)
+    {
+        return NULL;
+    }
+#ifdef HIGH_PERF_INDEXED
+    if (trdp_indexInit(pSession) != TRDP_NO_ERR)
+    {
+        vos_memFree(pSession);
+        return NULL;
+    }
+#endif
+    pSession->pdDefault.flags           = TRDP_FLAGS_NONE;
+    pSession->pdDefault.timeout         = TRDP_PD_DEFAULT_TIMEOUT;
+    pSession->pdDefault.toBehavior      = TRDP_TO_SET_TO_ZERO;
+    pSession->pdDefault.port            = TRDP_PD_UDP_PORT;
+    pSession->pdDefault.sendParam.qos   = TRDP_PD_DEFAULT_QOS;
+    pSession->pdDefault.sendParam.ttl   = TRDP_PD_DEFAULT_TTL;
+    (void) tlc_configSession(pSession, NULL, &pCfg->pPdConfig[ifIdx], NULL, &pCfg->pProcessConfig[ifIdx]);
+
+    (void) vos_mutexCreate(&pSession->mutex);
+    (void) vos_mutexCreate(&pSession->mutexTxPD);
+    (void) vos_mutexCreate(&pSession->mutexRxPD);
+#if MD_SUPPORT
+    (void) vos_mutexCreate(&pSession->mutexMD);
+#endif
+    pSession->pNewFrame = (PD_PACKET_T *) vos_memAlloc(TRDP_MAX_PD_PACKET_SIZE);
+
+    /* The statistics telegrams */
+    if (!(pSession->option & TRDP_OPTION_NO_PD_STATS))
+    {
+        (void) addPub(pSession, TRDP_GLOBAL_STATS_REPLY_COMID, 0u, sizeof(TRDP_STATISTICS_T));
+        (void) addSub(pSession, TRDP_STATISTICS_PULL_COMID, TRDP_INFINITE_TIMEOUT);
+    }
+    return pSession;
+}
+
+static void closeSession (TRDP_SESSION_PT pSession)
+{
+    PD_ELE_T *pElement;
+
+    while (pSession->pSndQueue != NULL)
+    {
+        pElement = pSession->pSndQueue;
+        pSession->pSndQueue = pElement->pNext;
+        vos_memFree(pElement->pFrame);
+        vos_memFree(pElement);
+    }
+    while (pSession->pRcvQueue != NULL)
+    {
+        pElement = pSession->pRcvQueue;
+        pSession->pRcvQueue = pElement->pNext;
+        vos_memFree(pElement->pFrame);
+        vos_memFree(pElement);
+    }
+    trdp_pdScheduleDeInit(pSession);
+#ifdef HIGH_PERF_INDEXED
+    trdp_indexDeInit(pSession);
+#endif
+    vos_mutexDelete(pSession->mutex);
+    vos_mutexDelete(pSession->mutexTxPD);
+    vos_mutexDelete(pSession->mutexRxPD);
+#if MD_SUPPORT
+    vos_mutexDelete(pSession->mutexMD);
+#endif
+    if (pSession->pNewFrame != NULL)
+    {
+        vos_memFree(pSession->pNewFrame);
+    }
+    vos_memFree(pSession);
+}
+
+/* Enter the telegrams of an interface, as the XML test applications do: one publisher per destination, one
+   subscriber per source */
+static TRDP_ERR_T addTelegrams (const CONFIG_T *pCfg, UINT32 ifIdx, TRDP_SESSION_PT pSession, RX_LOAD_T *pRx)
+{
+    UINT32 i, j;
+
+    for (i = 0u; i < pCfg->pNumExchgPar[ifIdx]; i++)
+    {
+        const TRDP_EXCHG_PAR_T  *pExchgPar  = &pCfg->ppExchgPar[ifIdx][i];
+        BOOL8                   varSize     = FALSE;
+        UINT32                  dataSize;
+        UINT32                  cycle;
+        UINT32                  timeout;
+
+        if ((pExchgPar->pPdPar == NULL) && (pExchgPar->pMdPar != NULL))
+        {
+            continue;   /* message data */
+        }
+        dataSize    = datasetSize(pCfg, pExchgPar->datasetId, 0u, &varSize);
+        cycle       = (pExchgPar->pPdPar != NULL) ? pExchgPar->pPdPar->cycle : 0u;
+        timeout     = ((pExchgPar->pPdPar != NULL) && (pExchgPar->pPdPar->timeout != 0u)) ?
+            pExchgPar->pPdPar->timeout : pSession->pdDefault.timeout;
+        if (varSize == TRUE)
+        {
+            printf("ComId %u: variable sized arrays counted without elements\n", pExchgPar->comId);
+        }
+        if (dataSize > TRDP_MAX_PD_DATA_SIZE)
+        {
+            printf("ComId %u: %u bytes exceed the maximum of %u, skipped\n", pExchgPar->comId, dataSize,
+                   TRDP_MAX_PD_DATA_SIZE);
+            continue;
+        }
+
+        if (pExchgPar->type != TRDP_EXCHG_SINK)
+        {
+            for (j = 0u; j < pExchgPar->destCnt; j++)
+            {
+                if (addPub(pSession, pExchgPar->comId, cycle, dataSize) == NULL)
+                {
+                    return TRDP_MEM_ERR;
+                }
+            }
+        }
+        if ((pExchgPar->srcCnt != 0u) || (pExchgPar->type == TRDP_EXCHG_SINK) ||
+            (pExchgPar->type == TRDP_EXCHG_SOURCESINK))
+        {
+            UINT32 noOfSubs = (pExchgPar->srcCnt != 0u) ? pExchgPar->srcCnt : 1u;
+
+            for (j = 0u; j < noOfSubs; j++)
+            {
+                if (addSub(pSession, pExchgPar->comId, timeout) == NULL)
+                {
+                    return TRDP_MEM_ERR;
+                }
+                pRx->noOfSubs++;
+                if (cycle == 0u)
+                {
+                    pRx->noOfUnknown++;
+                }
+                else
+                {
+                    pRx->packetsPerSec  += 1000000.0 / cycle;
+                    pRx->bytesPerSec    += 1000000.0 * trdp_packetSizePD(dataSize) / cycle;
+                }
+            }
+        }
+    }
+    return TRDP_NO_ERR;
+}
+
+/* Account a telegram sent in a simulated cycle */
+static void countSend (TX_LOAD_T *pTx, UINT32 cycleIdx, const PD_ELE_T *pElement)
+{
+    UINT32 frameSize = pElement->grossSize + UDP_IP_ETH_SIZE;
+
+    if (frameSize < ETH_MIN_FRAME)
+    {
+        frameSize = ETH_MIN_FRAME;
+    }
+    pTx->pPackets[cycleIdx]++;
+    pTx->pBytes[cycleIdx]       += pElement->grossSize;
+    pTx->pLineBytes[cycleIdx]   += frameSize + ETH_GAP_SIZE;
+}
+
+/* Step through the cycles as tlp_processSend() does with the send queue */
+static void simulateQueued (TRDP_SESSION_PT pSession, TX_LOAD_T *pTx, UINT32 warmUp)
+{
+    TRDP_TIME_T cycle   = {(time_t) (pTx->cycle / 1000000u), (suseconds_t) (pTx->cycle % 1000000u)};
+    TRDP_TIME_T now;
+    PD_ELE_T    *iterPD;
+    UINT32      idx;
+
+    vos_getTime(&now);
+    for (idx = 0u; idx < warmUp + pTx->noOfCycles; idx++)
+    {
+        for (iterPD = pSession->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+        {
+            if (timerisset(&iterPD->interval) && !timercmp(&iterPD->timeToGo, &now, >))
+            {
+                if (idx >= warmUp)
+                {
+                    countSend(pTx, idx - warmUp, iterPD);
+                }
+                vos_addTime(&iterPD->timeToGo, &iterPD->interval);
+                if (vos_cmpTime(&iterPD->timeToGo, &now) <= 0)
+                {
+                    trdp_pdScheduleNext(pSession, iterPD, &now);
+                }
+            }
+        }
+        vos_addTime(&now, &cycle);
+    }
+}
+
+#ifdef HIGH_PERF_INDEXED
+static void countSlot (TX_LOAD_T *pTx, UINT32 cycleIdx, const TRDP_HP_CAT_SLOT_T *pCat, UINT32 slot)
+{
+    UINT32 depth;
+
+    for (depth = 0u; depth < pCat->depthOfTxEntries; depth++)
+    {
+        const PD_ELE_T *pElement = pCat->ppIdxCat[slot * pCat->depthOfTxEntries + depth];
+
+        if (pElement == NULL)
+        {
+            break;
+        }
+        countSend(pTx, cycleIdx, pElement);
+    }
+}
+
+/* Step through the index tables as trdp_pdSendIndexed() does */
+static void simulateIndexed (TRDP_SESSION_PT pSession, TX_LOAD_T *pTx, UINT32 warmUp)
+{
+    TRDP_HP_SLOTS_T *pSlot  = pSession->pSlot;
+    TRDP_TIME_T     step    = {0, TRDP_MIN_CYCLE};
+    TRDP_TIME_T     now;
+    UINT32          cycleN  = 0u;
+    UINT32          idx, i, depth;
+
+    vos_getTime(&now);
+    for (idx = 0u; idx < warmUp + pTx->noOfCycles; idx++)
+    {
+        BOOL8   count       = (idx >= warmUp) ? TRUE : FALSE;
+        UINT32  cycleIdx    = (count == TRUE) ? idx - warmUp : 0u;
+
+        for (i = 0u; i < pSlot->processCycle; i += TRDP_MIN_CYCLE)
+        {
+            UINT32 idxLow = (cycleN / pSlot->lowCat.slotCycle) % pSlot->lowCat.noOfTxEntries;
+
+            if (count == TRUE)
+            {
+                countSlot(pTx, cycleIdx, &pSlot->lowCat, idxLow);
+                if ((idxLow % (TRDP_MID_CYCLE / TRDP_LOW_CYCLE)) == (TRDP_MID_CYCLE / TRDP_LOW_CYCLE / 2))
+                {
+                    countSlot(pTx, cycleIdx, &pSlot->midCat,
+                              (cycleN / pSlot->midCat.slotCycle) % pSlot->midCat.noOfTxEntries);
+                }
+                if (idxLow == 0u)
+                {
+                    countSlot(pTx, cycleIdx, &pSlot->highCat,
+                              (cycleN / pSlot->highCat.slotCycle) % pSlot->highCat.noOfTxEntries);
+                }
+            }
+            for (depth = 0u; (idxLow == 0u) && (depth < pSlot->noOfExtTxEntries); depth++)
+            {
+                PD_ELE_T *pElement = pSlot->pExtTxTable[depth];
+
+                if (!timercmp(&pElement->timeToGo, &now, >))
+                {
+                    vos_addTime(&pElement->timeToGo, &pElement->interval);
+                    if (count == TRUE)
+                    {
+                        countSend(pTx, cycleIdx, pElement);
+                    }
+                }
+            }
+            cycleN += TRDP_MIN_CYCLE;
+            if (cycleN >= pSlot->highCat.noOfTxEntries * pSlot->highCat.slotCycle)
+            {
+                cycleN = 0u;
+            }
+            vos_addTime(&now, &step);
+        }
+    }
+}
+#endif
+
+static int compareUINT32 (const void *pArg1, const void *pArg2)
+{
+    UINT32  v1  = *(const UINT32 *) pArg1;
+    UINT32  v2  = *(const UINT32 *) pArg2;
+
+    return (v1 > v2) - (v1 < v2);
+}
+
+/* Average, 99th percentile and maximum of the values of all cycles */
+static void printRow (const char *pLabel, const UINT32 *pValues, UINT32 count, REAL64 scale)
+{
+    UINT32  *pSorted = (UINT32 *) malloc(count * sizeof(UINT32));
+    REAL64  sum     = 0.0;
+    UINT32  maxIdx  = 0u;
+    UINT32  i;
+
+    if (pSorted == NULL)
+    {
+        return;
+    }
+    for (i = 0u; i < count; i++)
+    {
+        sum += pValues[i];
+        if (pValues[i] > pValues[maxIdx])
+        {
+            maxIdx = i;
+        }
+    }
+    memcpy(pSorted, pValues, count * sizeof(UINT32));
+    qsort(pSorted, count, sizeof(UINT32), compareUINT32);
+    printf("  %-28s %10.1f %10.1f %10.1f %10u\n", pLabel, sum * scale / count, pSorted[(count * 99u) / 100u] * scale,
+           pValues[maxIdx] * scale, maxIdx);
+    free(pSorted);
+}
+
+static const char *sendMode (const TRDP_SESSION_T *pSession)
+{
+    if (pSession->option & TRDP_OPTION_PD_SCHEDULE)
+    {
+        return "hyperperiod schedule";
+    }
+#ifdef HIGH_PERF_INDEXED
+    return "index tables";
+#else
+    return (pSession->option & TRDP_OPTION_TRAFFIC_SHAPING) ? "traffic shaping" : "no traffic shaping";
+#endif
+}
+
+/* Set up the session of an interface, simulate its sending and print the results. The session is kept for the
+   memory statistics. */
+static TRDP_ERR_T analyzeInterface (
+    const CONFIG_T  *pCfg,
+    UINT32          ifIdx,
+    UINT32          duration,
+    UINT32          profile,
+    TRDP_SESSION_PT *ppSession)
+{
+    TRDP_SESSION_PT pSession;
+    RX_LOAD_T       rx;
+    TX_LOAD_T       tx;
+    PD_ELE_T        *iterPD;
+    UINT32          noOfPubs    = 0u;
+    UINT32          noOfCyclic  = 0u;
+    UINT32          noOfSubs    = 0u;
+    UINT32          maxInterval = 0u;
+    UINT32          warmUp;
+    UINT32          checksPerCycle = 0u;
+    char            label[32];
+    UINT32          i;
+    TRDP_ERR_T      err;
+
+    memset(&rx, 0, sizeof(rx));
+    memset(&tx, 0, sizeof(tx));
+    pSession = openSession(pCfg, ifIdx);
+    if (pSession == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    *ppSession = pSession;
+    err = addTelegrams(pCfg, ifIdx, pSession, &rx);
+
+    /* What tlc_updateSession() does */
+    if ((err == TRDP_NO_ERR) && (pSession->option & TRDP_OPTION_PD_SCHEDULE))
+    {
+        err = trdp_pdScheduleAll(pSession);
+    }
+#ifdef HIGH_PERF_INDEXED
+    if ((err == TRDP_NO_ERR) && !(pSession->option & TRDP_OPTION_PD_SCHEDULE))
+    {
+        err = trdp_indexCreatePubTables(pSession);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        err = trdp_indexCreateSubTables(pSession);
+    }
+    tx.cycle = ((pSession->pSlot->processCycle != 0u) && !(pSession->option & TRDP_OPTION_PD_SCHEDULE)) ?
+        pSession->pSlot->processCycle : pSession->stats.processCycle;
+#else
+    tx.cycle = pSession->stats.processCycle;
+#endif
+    if (tx.cycle == 0u)
+    {
+        tx.cycle = TRDP_SCHED_DEFAULT_TICK;
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        printf("Interface %s: set-up failed (%d)\n", pCfg->pIfConfig[ifIdx].ifName, err);
+        return err;
+    }
+
+    for (iterPD = pSession->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        UINT32 interval = (UINT32) (iterPD->interval.tv_sec * 1000000u + iterPD->interval.tv_usec);
+
+        noOfPubs++;
+        if (interval != 0u)
+        {
+            noOfCyclic++;
+        }
+        if (interval > maxInterval)
+        {
+            maxInterval = interval;
+        }
+    }
+    for (iterPD = pSession->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        noOfSubs++;
+    }
+    tx.noOfCycles   = (duration * 1000u + tx.cycle - 1u) / tx.cycle;
+    warmUp          = (maxInterval + tx.cycle - 1u) / tx.cycle;
+    if (warmUp > tx.noOfCycles)
+    {
+        warmUp = tx.noOfCycles;
+    }
+    tx.pPackets     = (UINT32 *) calloc(tx.noOfCycles, sizeof(UINT32));
+    tx.pBytes       = (UINT32 *) calloc(tx.noOfCycles, sizeof(UINT32));
+    tx.pLineBytes   = (UINT32 *) calloc(tx.noOfCycles, sizeof(UINT32));
+    if ((tx.pPackets == NULL) || (tx.pBytes == NULL) || (tx.pLineBytes == NULL))
+    {
+        err = TRDP_MEM_ERR;
+    }
+#ifdef HIGH_PERF_INDEXED
+    else if (!(pSession->option & TRDP_OPTION_PD_SCHEDULE))
+    {
+        simulateIndexed(pSession, &tx, warmUp);
+    }
+#endif
+    else
+    {
+        simulateQueued(pSession, &tx, warmUp);
+    }
+
+    if (err == TRDP_NO_ERR)
+    {
+        printf("\nInterface %s: %u publishers (%u cyclic), %u subscriptions, process cycle %u us, %s\n",
+               pCfg->pIfConfig[ifIdx].ifName, noOfPubs, noOfCyclic, noOfSubs, tx.cycle, sendMode(pSession));
+        printf("Send load of %u process cycles (%u ms simulated after %u ms warm-up):\n",
+               tx.noOfCycles, duration, warmUp * tx.cycle / 1000u);
+        printf("  %-28s %10s %10s %10s %10s\n", "per process cycle", "avg", "99%", "max", "at cycle");
+        printRow("packets", tx.pPackets, tx.noOfCycles, 1.0);
+        printRow("bytes (TRDP)", tx.pBytes, tx.noOfCycles, 1.0);
+        printRow("bytes on the line", tx.pLineBytes, tx.noOfCycles, 1.0);
+        (void) snprintf(label, sizeof(label), "burst at %u Mbit/s (us)", sLinkSpeed);
+        printRow(label, tx.pLineBytes, tx.noOfCycles, 8.0 / sLinkSpeed);
+        if (sUsPerPacket > 0.0)
+        {
+            (void) snprintf(label, sizeof(label), "CPU at %.1f us/packet (us)", sUsPerPacket);
+            printRow(label, tx.pPackets, tx.noOfCycles, sUsPerPacket);
+        }
+
+        for (i = 0u; i < profile && i < tx.noOfCycles; i++)
+        {
+            if (i == 0u)
+            {
+                printf("  %10s %10s %10s %10s\n", "cycle", "packets", "bytes", "line us");
+            }
+            printf("  %10u %10u %10u %10.1f\n", i, tx.pPackets[i], tx.pBytes[i],
+                   tx.pLineBytes[i] * 8.0 / sLinkSpeed);
+        }
+
+        /* Timeout supervision: trdp_pdCheckPending() looks at every subscription in each cycle, the indexed
+           variant at those with short timeouts and at all others every TRDP_TO_CHECK_CYCLE */
+        for (iterPD = pSession->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+        {
+#ifdef HIGH_PERF_INDEXED
+            if ((UINT32) (iterPD->interval.tv_sec * 1000000u + iterPD->interval.tv_usec) >= tx.cycle)
+            {
+                continue;
+            }
+#endif
+            checksPerCycle++;
+        }
+        for (i = 0u; i < pCfg->pNumExchgPar[ifIdx]; i++)
+        {
+            const TRDP_EXCHG_PAR_T *pExchgPar = &pCfg->ppExchgPar[ifIdx][i];
+
+            if ((pExchgPar->pPdPar != NULL) && (pExchgPar->pPdPar->cycle != 0u) &&
+                ((pExchgPar->srcCnt != 0u) || (pExchgPar->type == TRDP_EXCHG_SINK) ||
+                 (pExchgPar->type == TRDP_EXCHG_SOURCESINK)))
+            {
+                rx.worstPerCycle += ((tx.cycle + pExchgPar->pPdPar->cycle - 1u) / pExchgPar->pPdPar->cycle) *
+                    ((pExchgPar->srcCnt != 0u) ? pExchgPar->srcCnt : 1u);
+            }
+        }
+        printf("Receive load:\n");
+        printf("  expected packets/s         %10.1f   (%u subscriptions without a cycle not counted)\n",
+               rx.packetsPerSec, rx.noOfUnknown);
+        printf("  expected bytes/s           %10.1f\n", rx.bytesPerSec);
+        printf("  packets per process cycle  %10.1f avg %10u if all sources are in phase\n",
+               rx.packetsPerSec * tx.cycle / 1000000.0, rx.worstPerCycle);
+#ifdef HIGH_PERF_INDEXED
+        printf("  timeout checks per cycle   %10.1f   (%u each cycle, all %u every %u ms)\n",
+               checksPerCycle + (REAL64) (noOfSubs - checksPerCycle) * tx.cycle / TRDP_TO_CHECK_CYCLE,
+               checksPerCycle, noOfSubs, TRDP_TO_CHECK_CYCLE / 1000u);
+#else
+        printf("  timeout checks per cycle   %10u\n", checksPerCycle);
+#endif
+        if (sUsPerPacket > 0.0)
+        {
+            printf("  CPU at %.1f us/packet (us) %10.1f avg %10.1f if all sources are in phase\n", sUsPerPacket,
+                   rx.packetsPerSec * tx.cycle / 1000000.0 * sUsPerPacket, rx.worstPerCycle * sUsPerPacket);
+        }
+    }
+    free(tx.pPackets);
+    free(tx.pBytes);
+    free(tx.pLineBytes);
+    return err;
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+int main (int argc, char *argv[])
+{
+    TRDP_XML_DOC_HANDLE_T   docHnd;
+    CONFIG_T                cfg;
+    TRDP_MEM_CONFIG_T       memConfig;
+    VOS_MEM_STATISTICS_T    memStart, memConfigRead, memEnd;
+    TRDP_SESSION_PT         *pSessions;
+    UINT32                  poolUsed = 0u;
+    UINT32                  preAlloc[VOS_MEM_NBLOCKSIZES] = VOS_MEM_PREALLOCATE;
+    UINT32                  duration    = DEFAULT_DURATION;
+    UINT32                  profile     = 0u;
+    UINT32                  i;
+    BOOL8                   defaultPreAlloc = TRUE;
+    TRDP_ERR_T              err;
+    int                     ch;
+    int                     rc = 0;
+
+    while ((ch = getopt(argc, argv, "d:l:u:p:h")) != -1)
+    {
+        switch (ch)
+        {
+           case 'd':
+               duration = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'l':
+               sLinkSpeed = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'u':
+               sUsPerPacket = strtod(optarg, NULL);
+               break;
+           case 'p':
+               profile = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+    if ((optind + 1 != argc) || (duration == 0u) || (sLinkSpeed == 0u))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    memset(&cfg, 0, sizeof(cfg));
+
+    /* As an application would: the device configuration first, it holds the memory configuration */
+    err = tau_prepareXmlDoc(argv[optind], &docHnd);
+    if (err == TRDP_NO_ERR)
+    {
+        err = tau_readXmlDeviceConfig(&docHnd, &cfg.memConfig, &cfg.dbgConfig, &cfg.numComPar, &cfg.pComPar,
+                                      &cfg.numIfConfig, &cfg.pIfConfig);
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Failed to read the device configuration of %s: %d\n", argv[optind], err);
+        return 1;
+    }
+
+    /* The pool must be large enough to measure what is needed, a heap configuration is measured in a pool as well */
+    memConfig       = cfg.memConfig;
+    memConfig.p     = NULL;
+    if (memConfig.size < ANALYSIS_POOL_SIZE)
+    {
+        memConfig.size = ANALYSIS_POOL_SIZE;
+    }
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        if (cfg.memConfig.prealloc[i] != 0u)
+        {
+            defaultPreAlloc = FALSE;
+        }
+    }
+    if (defaultPreAlloc == FALSE)
+    {
+        memcpy(preAlloc, cfg.memConfig.prealloc, sizeof(preAlloc));
+    }
+    if (tlc_init(dbgOut, NULL, &memConfig) != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "tlc_init failed\n");
+        return 1;
+    }
+    (void) vos_memCount(&memStart);
+
+    err = readInterfaces(&docHnd, &cfg);
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Failed to read the configuration of %s: %d\n", argv[optind], err);
+        (void) tlc_terminate();
+        return 1;
+    }
+    (void) vos_memCount(&memConfigRead);
+
+    pSessions = (TRDP_SESSION_PT *) calloc(cfg.numIfConfig + 1u, sizeof(TRDP_SESSION_PT));
+    if (pSessions == NULL)
+    {
+        (void) tlc_terminate();
+        return 1;
+    }
+    for (i = 0u; i < cfg.numIfConfig; i++)
+    {
+        if (analyzeInterface(&cfg, i, duration, profile, &pSessions[i]) != TRDP_NO_ERR)
+        {
+            rc = 1;
+        }
+    }
+    (void) vos_memCount(&memEnd);
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        poolUsed += memEnd.usedBlockSize[i] * memEnd.blockSize[i];
+    }
+
+    /* Blocks once taken from the pool area stay with their size, the area must hold all of them */
+    printf("\nMemory (vos_mem, measured in a pool of %u bytes):\n", memConfig.size);
+    printf("  configuration read, in use       %10u bytes\n", memStart.free - memConfigRead.free);
+    printf("  sessions and telegrams, in use   %10u bytes\n", memConfigRead.free - memEnd.free);
+    printf("  blocks taken from the pool       %10u bytes plus block headers, configured: ", poolUsed);
+    if (cfg.memConfig.size == 0u)
+    {
+        printf("heap\n");
+    }
+    else
+    {
+        printf("%u bytes, %s\n", cfg.memConfig.size, (cfg.memConfig.size > poolUsed) ? "sufficient" : "TOO SMALL");
+    }
+    printf("  %-10s %10s %10s\n", "block size", "blocks", "prealloc");
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        if ((memEnd.usedBlockSize[i] != 0u) || (preAlloc[i] != 0u))
+        {
+            printf("  %10u %10u %10u%s\n", memEnd.blockSize[i], memEnd.usedBlockSize[i], preAlloc[i],
+                   (memEnd.usedBlockSize[i] > preAlloc[i]) ? "  more blocks than preallocated" : "");
+        }
+    }
+    printf("  (blocks incl. the preallocated ones; %s preallocation)\n",
+           (defaultPreAlloc == TRUE) ? "default" : "configured");
+    poolUsed = 0u;
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        poolUsed += preAlloc[i] * memEnd.blockSize[i];
+    }
+    if ((defaultPreAlloc == FALSE) && (cfg.memConfig.size != 0u) && (poolUsed > cfg.memConfig.size / 2u))
+    {
+        printf("  Note: the preallocation (%u bytes) exceeds half of the configured size, vos_memInit will skip it\n",
+               poolUsed);
+    }
+
+    for (i = 0u; i < cfg.numIfConfig; i++)
+    {
+        if (pSessions[i] != NULL)
+        {
+            closeSession(pSessions[i]);
+        }
+    }
+    free(pSessions);
+
+    /* The device configuration and the document were allocated before tlc_init, they are lost with the pool */
+    for (i = 0u; i < cfg.numIfConfig; i++)
+    {
+        tau_freeTelegrams(cfg.pNumExchgPar[i], cfg.ppExchgPar[i]);
+    }
+    tau_freeXmlDatasetConfig(cfg.numComId, cfg.pComIdMap, cfg.numDataset, cfg.apDataset);
+    (void) tlc_terminate();
+    free(cfg.pProcessConfig);
+    free(cfg.pPdConfig);
+    free(cfg.pMdConfig);
+    free(cfg.pNumExchgPar);
+    free(cfg.ppExchgPar);
+    return rc;
+}
@@ -41,15 +41,15 @@
 ***********************************************************************************************************************/
 static void printProcessConfig(TRDP_PROCESS_CONFIG_T  * pProcessConfig)
 {
-    UINT32  procOptions[2] = {TRDP_OPTION_BLOCK, TRDP_OPTION_TRAFFIC_SHAPING};
-    const char * strProcOptions[2] = {"TRDP_OPTION_BLOCK", "TRDP_OPTION_TRAFFIC_SHAPING"};
+    UINT32  procOptions[3] = {TRDP_OPTION_BLOCK, TRDP_OPTION_TRAFFIC_SHAPING, TRDP_OPTION_PD_SCHEDULE};
+    const char * strProcOptions[3] = {"TRDP_OPTION_BLOCK", "TRDP_OPTION_TRAFFIC_SHAPING", "TRDP_OPTION_PD_SCHEDULE"};
     UINT32  i;
     printf("  Process (session) configuration\n");
     printf("    Host: %s, Leader: %s Type: %s\n", pProcessConfig->hostName, pProcessConfig->leaderName, pProcessConfig->type);
     printf("    Priority: %u, CycleTime: %u\n",
         pProcessConfig->priority, pProcessConfig->cycleTime);
     printf("    Options:");
-    for (i=0; i < 2; i++)
+    for (i=0; i < 3; i++)
         if (pProcessConfig->options & procOptions[i])
             printf(" %s", strProcOptions[i]);
     printf("\n");
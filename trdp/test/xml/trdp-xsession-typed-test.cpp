@@ -0,0 +1,261 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-xsession-typed-test.cpp
+ *
+ * @brief           Test of the typed C++17 dataset layer of tau_xsession.hpp
+ *
+ * @details         Describes the dataset of xsession-test.xml as a struct with tau_ds::Layout and checks
+ *                  - the wire offsets and sizes computed at compile time,
+ *                  - tau_ds::Layout::toWire()/fromWire() against tau_marshallDs()/tau_unmarshallDs(),
+ *                  - Layout::check() against the loaded configuration, also for descriptions that do not match,
+ *                  - typed publish/setCom/subscribe/getCom over the loop back interface, for a telegram marshalled
+ *                    by the stack and one that is not.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *  Usage: trdp-xsession-typed-test [xsession-test.xml]
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "tau_xsession.hpp"
+#include "tau_marshall.h"
+
+#ifndef TAU_XSESSION_TYPED
+#error "the typed dataset layer needs C++17"
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define COMID_MARSHALLED    2001u   /* marshalled by the stack */
+#define COMID_RAW           2011u   /* same dataset, not marshalled by the stack */
+#define MAX_CYCLES          100     /* 1 s with a process cycle of 10 ms */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+struct Sub
+{
+	UINT16      a;
+	UINT32      b[2];
+};
+
+struct Status
+{
+	BOOL8       flag;
+	CHAR8       text[8];
+	INT16       i16[3];
+	UINT32      counter;
+	INT64       big;
+	REAL32      r32;
+	REAL64      r64;
+	TIMEDATE32  td32;
+	TIMEDATE48  td48;
+	TIMEDATE64  td64;
+	Sub         sub[2];
+};
+
+/* Status with the wrong type for counter */
+struct BadStatus
+{
+	BOOL8       flag;
+	CHAR8       text[8];
+	INT16       i16[3];
+	REAL32      counter;
+	INT64       big;
+	REAL32      r32;
+	REAL64      r64;
+	TIMEDATE32  td32;
+	TIMEDATE48  td48;
+	TIMEDATE64  td64;
+	Sub         sub[2];
+};
+
+template <> struct tau_ds::Dataset<Sub> : tau_ds::Layout<Sub, 2002,
+		tau_ds::Field<&Sub::a>, tau_ds::Field<&Sub::b> > {};
+
+template <> struct tau_ds::Dataset<Status> : tau_ds::Layout<Status, 2001,
+		tau_ds::Field<&Status::flag, TRDP_BOOL8>, tau_ds::Field<&Status::text>, tau_ds::Field<&Status::i16>,
+		tau_ds::Field<&Status::counter>, tau_ds::Field<&Status::big>, tau_ds::Field<&Status::r32>,
+		tau_ds::Field<&Status::r64>, tau_ds::Field<&Status::td32, TRDP_TIMEDATE32>, tau_ds::Field<&Status::td48>,
+		tau_ds::Field<&Status::td64>, tau_ds::Field<&Status::sub> > {};
+
+template <> struct tau_ds::Dataset<BadStatus> : tau_ds::Layout<BadStatus, 2001,
+		tau_ds::Field<&BadStatus::flag, TRDP_BOOL8>, tau_ds::Field<&BadStatus::text>, tau_ds::Field<&BadStatus::i16>,
+		tau_ds::Field<&BadStatus::counter>, tau_ds::Field<&BadStatus::big>, tau_ds::Field<&BadStatus::r32>,
+		tau_ds::Field<&BadStatus::r64>, tau_ds::Field<&BadStatus::td32, TRDP_TIMEDATE32>,
+		tau_ds::Field<&BadStatus::td48>, tau_ds::Field<&BadStatus::td64>, tau_ds::Field<&BadStatus::sub> > {};
+
+/*  Compile-time layout, see the element sizes in xsession-test.xml  */
+static_assert(tau_ds::Dataset<Sub>::wireSize == 10u, "Sub wire size");
+static_assert(tau_ds::Dataset<Status>::wireSize == 77u, "Status wire size");
+static_assert(tau_ds::Dataset<Status>::wireOffsets[3] == 15u, "counter follows flag, text and i16");
+static_assert(tau_ds::Dataset<Status>::wireOffsets[8] == 43u, "td48 wire offset");
+static_assert(tau_ds::Dataset<Status>::wireOffsets[10] == 57u, "sub wire offset");
+static_assert(tau_ds::Dataset<Status>::hostOffsets[10] == offsetof(Status, sub), "sub host offset");
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static int sFailed = 0;
+
+#define CHECK(cond, ...)                                                \
+	do {                                                                \
+		if (!(cond)) { printf("### FAILED: " __VA_ARGS__); printf("\n"); sFailed++; } \
+		else         { printf("    ok: "     __VA_ARGS__); printf("\n"); }             \
+	} while (0)
+
+static void print(const char *lead, const char *msg, int putNL)
+{
+	printf("%s%s%s", lead, msg, putNL ? "\n" : "");
+}
+
+static void fill(Status &s, UINT32 seed)
+{
+	std::memset( &s, 0, sizeof(s) );    /* padding too, the structs are compared with memcmp */
+	s.flag      = 1;
+	std::strncpy( s.text, "typed", sizeof(s.text) );
+	s.i16[0]    = (INT16)-1;
+	s.i16[1]    = 0x1234;
+	s.i16[2]    = (INT16)seed;
+	s.counter   = 0x89ABCDEFu + seed;
+	s.big       = -0x0123456789ABCDEFll;
+	s.r32       = 1.5f;
+	s.r64       = -2.25;
+	s.td32      = 0x5A5A0000u + seed;
+	s.td48.sec  = 0x12345678u;
+	s.td48.ticks = 0x9ABC;
+	s.td64.tv_sec  = 0x0F0E0D0Cu;
+	s.td64.tv_usec = 999999;
+	s.sub[0].a  = 0xA1A2;
+	s.sub[0].b[0] = 0xB1B2B3B4u;
+	s.sub[0].b[1] = seed;
+	s.sub[1].a  = 0xC1C2;
+	s.sub[1].b[0] = 0xD1D2D3D4u;
+	s.sub[1].b[1] = ~seed;
+}
+
+/***********************************************************************************************************************
+    Layout against tau_marshall
+***********************************************************************************************************************/
+static void testLayout()
+{
+	Status  tx, rx, rx2;
+	UINT8   wire[tau_ds::Dataset<Status>::wireSize];
+	UINT8   wire2[256];
+	UINT32  size2 = sizeof(wire2);
+
+	printf("Layout against tau_marshallDs()\n");
+	fill( tx, 7u );
+	tau_ds::Dataset<Status>::toWire( tx, wire );
+	CHECK( tau_marshallDs( NULL, 2001u, (UINT8 *)&tx, sizeof(tx), wire2, &size2, NULL ) == TRDP_NO_ERR,
+			"tau_marshallDs" );
+	CHECK( (size2 == sizeof(wire)) && (std::memcmp( wire, wire2, sizeof(wire) ) == 0),
+			"toWire() equals tau_marshallDs(), %u bytes", size2 );
+
+	std::memset( &rx, 0, sizeof(rx) );
+	std::memset( &rx2, 0, sizeof(rx2) );
+	tau_ds::Dataset<Status>::fromWire( wire, rx );
+	size2 = sizeof(rx2);
+	CHECK( tau_unmarshallDs( NULL, 2001u, wire, sizeof(wire), (UINT8 *)&rx2, &size2, NULL ) == TRDP_NO_ERR,
+			"tau_unmarshallDs" );
+	CHECK( std::memcmp( &rx, &tx, sizeof(tx) ) == 0, "fromWire() round trip" );
+	CHECK( (size2 == sizeof(rx2)) && (std::memcmp( &rx, &rx2, sizeof(rx) ) == 0),
+			"fromWire() equals tau_unmarshallDs()" );
+
+	CHECK( tau_ds::Dataset<Status>::check() == TRDP_NO_ERR, "Layout::check() accepts the description" );
+	CHECK( tau_ds::Dataset<BadStatus>::check() == TRDP_PARAM_ERR, "Layout::check() rejects a wrong element type" );
+}
+
+/***********************************************************************************************************************
+    Typed publish and subscribe over loop back
+***********************************************************************************************************************/
+static void testPubSub(TAU_XSession &s)
+{
+	INT32   pub[2], sub[2];
+	Status  tx[2], rx[2];
+	bool    got[2] = {false, false};
+	TRDP_ERR_T err;
+	int     cycle;
+
+	printf("Typed publish/subscribe\n");
+	fill( tx[0], 1u );
+	fill( tx[1], 2u );
+
+	CHECK( s.subscribe<Sub>( COMID_MARSHALLED, sub, 1 ) == TRDP_PARAM_ERR, "subscribe<> rejects another dataset" );
+	CHECK( s.publish<BadStatus>( COMID_RAW, pub, 1, BadStatus() ) == TRDP_PARAM_ERR,
+			"publish<> rejects a wrong description" );
+
+	CHECK( s.publish<Status>( COMID_MARSHALLED, &pub[0], 1, tx[0] ) == TRDP_NO_ERR, "publish<Status> %u", COMID_MARSHALLED );
+	CHECK( s.publish<Status>( COMID_RAW, &pub[1], 1, tx[1] ) == TRDP_NO_ERR, "publish<Status> %u", COMID_RAW );
+	CHECK( s.subscribe<Status>( COMID_MARSHALLED, &sub[0], 1 ) == TRDP_NO_ERR, "subscribe<Status> %u", COMID_MARSHALLED );
+	CHECK( s.subscribe<Status>( COMID_RAW, &sub[1], 1 ) == TRDP_NO_ERR, "subscribe<Status> %u", COMID_RAW );
+	if (sFailed) return;
+
+	/* the values set by publish<> are replaced before the first cycle */
+	tx[0].counter++;
+	tx[1].counter++;
+	CHECK( s.setCom( pub[0], tx[0] ) == TRDP_NO_ERR, "setCom<Status> %u", COMID_MARSHALLED );
+	CHECK( s.setCom( pub[1], tx[1] ) == TRDP_NO_ERR, "setCom<Status> %u", COMID_RAW );
+
+	for (cycle = 0; (cycle < MAX_CYCLES) && !(got[0] && got[1]); cycle++) {
+		(void) s.cycle_block();
+		for (int i = 0; i < 2; i++) {
+			if (got[i]) continue;
+			std::memset( &rx[i], 0, sizeof(rx[i]) );
+			err = s.getCom( sub[i], rx[i] );
+			got[i] = (err == TRDP_NO_ERR);
+			if ((err != TRDP_NO_ERR) && (err != TRDP_NODATA_ERR)) {
+				printf("getCom<Status> returns %s\n", TAU_XSession::getResultString( err ));
+			}
+		}
+	}
+	CHECK( got[0] && (std::memcmp( &rx[0], &tx[0], sizeof(Status) ) == 0), "received %u after %d cycles",
+			COMID_MARSHALLED, cycle );
+	CHECK( got[1] && (std::memcmp( &rx[1], &tx[1], sizeof(Status) ) == 0), "received %u after %d cycles",
+			COMID_RAW, cycle );
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+	const char *xml = (argc > 1) ? argv[1] : "test/xml/xsession-test.xml";
+	TRDP_ERR_T  err;
+
+	err = TAU_XSession::load( xml, 0, print, NULL );
+	if (err != TRDP_NO_ERR) {
+		printf("### Loading %s failed: %s\n", xml, TAU_XSession::getResultString( err ));
+		return 1;
+	}
+	{
+		TAU_XSession s;
+
+		err = s.init( "lo" );
+		if ((err != TRDP_NO_ERR) || !s.up()) {
+			printf("### Session init failed: %s\n", TAU_XSession::getResultString( err ));
+			return 1;
+		}
+		testLayout();
+		testPubSub( s );
+	}   /* deleting the last session undoes load */
+
+	if (sFailed) {
+		printf("### %d check(s) FAILED\n", sFailed);
+		return 1;
+	}
+	printf("All typed dataset tests passed\n");
+	return 0;
+}
@@ -0,0 +1,359 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-xsession-var-test.c
+ *
+ * @brief           Test of the element index and the field-level access of tau_xsession
+ *
+ * @details         Loads xsession-test.xml and checks
+ *                  - tau_xsession_lookup_offset() and tau_xsession_lookup_variable() by name and by index, for
+ *                    names shared by several datasets, for unknown names and indices and for elements at or after
+ *                    a variable sized one (TRDP_MARSHALLING_ERR),
+ *                  - tau_xsession_getVariable() for all element types incl. TIMEDATE48/64 and a nested dataset
+ *                    array, for a telegram marshalled by the stack and one carrying the application's wire image,
+ *                  - tlp_getDecoded() handing the received wire image to the decoder and passing its errors on.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *  Usage: trdp-xsession-var-test [xsession-test.xml]
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tau_xsession.h"
+#include "tau_marshall.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define DSID_STATUS         2001u
+#define DSID_SUB            2002u
+#define DSID_VAR            2003u
+#define COMID_MARSHALLED    2001u   /* marshalled by the stack */
+#define COMID_RAW           2011u   /* same dataset, the application passes the wire image */
+#define WIRE_SIZE           77u
+#define MAX_CYCLES          100     /* 1 s with a process cycle of 10 ms */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/* host layout of datasets 2002 and 2001 */
+typedef struct
+{
+    UINT16      a;
+    UINT32      b[2];
+} SUB_T;
+
+typedef struct
+{
+    BOOL8       flag;
+    CHAR8       text[8];
+    INT16       i16[3];
+    UINT32      counter;
+    INT64       big;
+    REAL32      r32;
+    REAL64      r64;
+    TIMEDATE32  td32;
+    TIMEDATE48  td48;
+    TIMEDATE64  td64;
+    SUB_T       sub[2];
+} STATUS_T;
+
+/* expected location of every element of dataset 2001 */
+typedef struct
+{
+    const CHAR8 *name;
+    UINT32      wireOffset;
+    UINT32      wireSize;
+    size_t      hostOffset;
+    UINT32      hostSize;
+} ELEMENT_T;
+
+/* received wire image, see decodeRaw() */
+typedef struct
+{
+    UINT32      calls;
+    UINT32      comId;
+    TRDP_ERR_T  result;
+} DECODE_REF_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static const ELEMENT_T sStatus[] =
+{
+    {"flag",     0u,  1u, offsetof(STATUS_T, flag),    sizeof(BOOL8)},
+    {"text",     1u,  8u, offsetof(STATUS_T, text),    8u * sizeof(CHAR8)},
+    {"i16",      9u,  6u, offsetof(STATUS_T, i16),     3u * sizeof(INT16)},
+    {"counter", 15u,  4u, offsetof(STATUS_T, counter), sizeof(UINT32)},
+    {"big",     19u,  8u, offsetof(STATUS_T, big),     sizeof(INT64)},
+    {"r32",     27u,  4u, offsetof(STATUS_T, r32),     sizeof(REAL32)},
+    {"r64",     31u,  8u, offsetof(STATUS_T, r64),     sizeof(REAL64)},
+    {"td32",    39u,  4u, offsetof(STATUS_T, td32),    sizeof(TIMEDATE32)},
+    {"td48",    43u,  6u, offsetof(STATUS_T, td48),    sizeof(TIMEDATE48)},
+    {"td64",    49u,  8u, offsetof(STATUS_T, td64),    sizeof(TIMEDATE64)},
+    {"sub",     57u, 20u, offsetof(STATUS_T, sub),     2u * sizeof(SUB_T)}
+};
+
+#define NUM_ELEMENTS    (sizeof(sStatus) / sizeof(sStatus[0]))
+
+static int sFailed = 0;
+
+#define CHECK(cond, ...)                                                                    \
+    do {                                                                                    \
+        if (!(cond)) { printf("### FAILED: " __VA_ARGS__); printf("\n"); sFailed++; }     \
+        else         { printf("    ok: "     __VA_ARGS__); printf("\n"); }                \
+    } while (0)
+
+static void print (const char *lead, const char *msg, int putNL)
+{
+    printf("%s%s%s", lead, msg, putNL ? "\n" : "");
+}
+
+static void fill (STATUS_T *pS, UINT32 seed)
+{
+    memset(pS, 0, sizeof(*pS));
+    pS->flag            = 1;
+    strncpy(pS->text, "fields", sizeof(pS->text));
+    pS->i16[0]          = -1;
+    pS->i16[1]          = 0x1234;
+    pS->i16[2]          = (INT16) seed;
+    pS->counter         = 0x89ABCDEFu + seed;
+    pS->big             = -0x0123456789ABCDEFll;
+    pS->r32             = 1.5f;
+    pS->r64             = -2.25;
+    pS->td32            = 0x5A5A0000u + seed;
+    pS->td48.sec        = 0x12345678u;
+    pS->td48.ticks      = 0x9ABC;
+    pS->td64.tv_sec     = 0x0F0E0D0Cu;
+    pS->td64.tv_usec    = 999999;
+    pS->sub[0].a        = 0xA1A2;
+    pS->sub[0].b[0]     = 0xB1B2B3B4u;
+    pS->sub[0].b[1]     = seed;
+    pS->sub[1].a        = 0xC1C2;
+    pS->sub[1].b[0]     = 0xD1D2D3D4u;
+    pS->sub[1].b[1]     = ~seed;
+}
+
+/**********************************************************************************************************************/
+/** TRDP_UNMARSHALL_T copying the received wire image as is
+ */
+static TRDP_ERR_T decodeRaw (void *pRefCon, UINT32 comId, UINT8 *pSrc, UINT32 srcSize, UINT8 *pDst,
+                             UINT32 *pDstSize, TRDP_DATASET_T **ppCachedDS)
+{
+    DECODE_REF_T *pRef = (DECODE_REF_T *) pRefCon;
+
+    (void) ppCachedDS;
+    pRef->calls++;
+    pRef->comId = comId;
+    if (pRef->result != TRDP_NO_ERR)
+    {
+        return pRef->result;
+    }
+    if (*pDstSize < srcSize)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    memcpy(pDst, pSrc, srcSize);
+    *pDstSize = srcSize;
+    return TRDP_NO_ERR;
+}
+
+/***********************************************************************************************************************
+    Element index
+***********************************************************************************************************************/
+static void testLookup (void)
+{
+    TAU_XSESSION_VAR_T      var, byIndex;
+    TRDP_DATASET_ELEMENT_T  *pEl = NULL;
+    UINT32 i;
+
+    printf("Element index\n");
+    for (i = 0u; i < NUM_ELEMENTS; i++)
+    {
+        memset(&var, 0, sizeof(var));
+        memset(&byIndex, 0, sizeof(byIndex));
+        CHECK((tau_xsession_lookup_offset(DSID_STATUS, sStatus[i].name, 0u, &var) == TRDP_NO_ERR)
+              && (var.datasetId == DSID_STATUS)
+              && (var.wireOffset == sStatus[i].wireOffset) && (var.wireSize == sStatus[i].wireSize),
+              "%s at wire offset %u, %u bytes", sStatus[i].name, var.wireOffset, var.wireSize);
+        CHECK((tau_xsession_lookup_offset(DSID_STATUS, NULL, i + 1u, &byIndex) == TRDP_NO_ERR)
+              && (memcmp(&var, &byIndex, sizeof(var)) == 0),
+              "element %u by index is %s", i + 1u, sStatus[i].name);
+    }
+
+    CHECK((tau_xsession_lookup_variable(DSID_STATUS, "COUNTER", 0u, &pEl) == TRDP_NO_ERR)
+          && (tau_xsession_lookup_offset(DSID_STATUS, "counter", 0u, &var) == TRDP_NO_ERR)
+          && (pEl == var.pElement), "names are case insensitive");
+    /* "counter" also is the first element of dataset 2003, the hash must tell them apart */
+    CHECK((tau_xsession_lookup_offset(DSID_VAR, "counter", 0u, &var) == TRDP_NO_ERR)
+          && (var.datasetId == DSID_VAR) && (var.wireOffset == 0u) && (var.wireSize == 2u),
+          "same name in another dataset");
+    CHECK((tau_xsession_lookup_offset(DSID_SUB, "b", 0u, &var) == TRDP_NO_ERR)
+          && (var.wireOffset == 2u) && (var.wireSize == 8u), "nested dataset looked up on its own");
+
+    memset(&var, 0x5A, sizeof(var));
+    byIndex = var;
+    CHECK(tau_xsession_lookup_offset(DSID_STATUS, "nosuch", 0u, &var) == TRDP_PARAM_ERR, "unknown name");
+    CHECK(tau_xsession_lookup_offset(DSID_STATUS, NULL, NUM_ELEMENTS + 1u, &var) == TRDP_PARAM_ERR,
+          "index past the last element");
+    CHECK(tau_xsession_lookup_offset(DSID_STATUS, NULL, 0u, &var) == TRDP_PARAM_ERR, "neither name nor index");
+    CHECK(tau_xsession_lookup_offset(DSID_STATUS, "flag", 1u, &var) == TRDP_PARAM_ERR, "both name and index");
+    CHECK(tau_xsession_lookup_offset(4711u, NULL, 1u, &var) == TRDP_PARAM_ERR, "unknown dataset");
+    CHECK(tau_xsession_lookup_offset(DSID_VAR, "data", 0u, &var) == TRDP_MARSHALLING_ERR,
+          "variable sized element");
+    CHECK(tau_xsession_lookup_offset(DSID_VAR, "tail", 0u, &var) == TRDP_MARSHALLING_ERR,
+          "element after a variable sized one");
+    CHECK(tau_xsession_lookup_offset(DSID_VAR, NULL, 3u, &var) == TRDP_MARSHALLING_ERR,
+          "element after a variable sized one by index");
+    CHECK(memcmp(&var, &byIndex, sizeof(var)) == 0, "location untouched on errors");
+}
+
+/***********************************************************************************************************************
+    Field-level access to received telegrams
+***********************************************************************************************************************/
+static void testGetVariable (TAU_XSESSION_T *pSession)
+{
+    INT32           pub[2], sub[2];
+    STATUS_T        tx[2], rx;
+    UINT8           wire[WIRE_SIZE], got[256];
+    UINT32          size, length, i, t;
+    int             cycle;
+    TRDP_ERR_T      err = TRDP_NODATA_ERR;
+    TAU_XSESSION_VAR_T  var;
+    DECODE_REF_T    ref;
+    TRDP_PD_INFO_T  info;
+
+    printf("Field-level access\n");
+    fill(&tx[0], 1u);
+    fill(&tx[1], 2u);
+    size = sizeof(wire);
+    CHECK((tau_marshallDs(NULL, DSID_STATUS, (UINT8 *) &tx[1], sizeof(tx[1]), wire, &size, NULL) == TRDP_NO_ERR)
+          && (size == WIRE_SIZE), "marshall the wire image of %u", COMID_RAW);
+
+    CHECK(tau_xsession_publish(pSession, COMID_MARSHALLED, &pub[0], 1u, (UINT8 *) &tx[0], sizeof(tx[0]), NULL)
+          == TRDP_NO_ERR, "publish %u", COMID_MARSHALLED);
+    CHECK(tau_xsession_publish(pSession, COMID_RAW, &pub[1], 1u, wire, sizeof(wire), NULL) == TRDP_NO_ERR,
+          "publish %u", COMID_RAW);
+    CHECK(tau_xsession_subscribe(pSession, COMID_MARSHALLED, &sub[0], 1u, NULL) == TRDP_NO_ERR,
+          "subscribe %u", COMID_MARSHALLED);
+    CHECK(tau_xsession_subscribe(pSession, COMID_RAW, &sub[1], 1u, NULL) == TRDP_NO_ERR, "subscribe %u", COMID_RAW);
+    if (sFailed)
+    {
+        return;
+    }
+
+    for (cycle = 0; (cycle < MAX_CYCLES) && (err != TRDP_NO_ERR); cycle++)
+    {
+        (void) tau_xsession_cycle_all();
+        size = sizeof(got);
+        err = tau_xsession_getCom(pSession, sub[0], got, sizeof(got), &size, NULL);
+        if (err == TRDP_NO_ERR)
+        {
+            size = sizeof(got);
+            err = tau_xsession_getCom(pSession, sub[1], got, sizeof(got), &size, NULL);
+        }
+    }
+    CHECK(err == TRDP_NO_ERR, "received both telegrams after %d cycles", cycle);
+    if (err != TRDP_NO_ERR)
+    {
+        return;
+    }
+
+    for (t = 0u; t < 2u; t++)
+    {
+        for (i = 0u; i < NUM_ELEMENTS; i++)
+        {
+            (void) tau_xsession_lookup_offset(DSID_STATUS, sStatus[i].name, 0u, &var);
+            memset(got, 0, sizeof(got));
+            err = tau_xsession_getVariable(pSession, sub[t], &var, got, sizeof(got), &length, NULL);
+            CHECK((err == TRDP_NO_ERR) && (length == sStatus[i].hostSize)
+                  && (memcmp(got, (const UINT8 *) &tx[t] + sStatus[i].hostOffset, length) == 0),
+                  "%u %s, %u bytes", t ? COMID_RAW : COMID_MARSHALLED, sStatus[i].name, length);
+        }
+    }
+
+    (void) tau_xsession_lookup_offset(DSID_STATUS, "td48", 0u, &var);
+    CHECK(tau_xsession_getVariable(pSession, sub[0], &var, got, sizeof(TIMEDATE48) - 1u, &length, NULL)
+          == TRDP_PARAM_ERR, "getVariable() checks the buffer size");
+    (void) tau_xsession_lookup_offset(DSID_SUB, "a", 0u, &var);
+    CHECK(tau_xsession_getVariable(pSession, sub[0], &var, got, sizeof(got), &length, NULL) == TRDP_PARAM_ERR,
+          "getVariable() rejects elements of another dataset");
+
+    /* the decoder sees the received wire image, whether the subscription marshalls or not */
+    for (t = 0u; t < 2u; t++)
+    {
+        TRDP_SUB_T  subHandle = pSession->aTelegrams[sub[t]].handle;
+        UINT8       expected[WIRE_SIZE];
+
+        size = sizeof(expected);
+        (void) tau_marshallDs(NULL, DSID_STATUS, (UINT8 *) &tx[t], sizeof(tx[t]), expected, &size, NULL);
+        memset(&ref, 0, sizeof(ref));
+        size = sizeof(got);
+        err = tlp_getDecoded(pSession->sessionhandle, subHandle, &info, decodeRaw, &ref, got, &size);
+        CHECK((err == TRDP_NO_ERR) && (ref.calls == 1u) && (ref.comId == (t ? COMID_RAW : COMID_MARSHALLED))
+              && (info.comId == ref.comId) && (size == WIRE_SIZE) && (memcmp(got, expected, WIRE_SIZE) == 0),
+              "tlp_getDecoded() on %u hands over the wire image", ref.comId);
+        ref.result = TRDP_MARSHALLING_ERR;
+        size = sizeof(got);
+        CHECK(tlp_getDecoded(pSession->sessionhandle, subHandle, NULL, decodeRaw, &ref, got, &size)
+              == TRDP_MARSHALLING_ERR, "tlp_getDecoded() returns the decoder's error");
+    }
+    size = sizeof(got);
+    CHECK(tlp_getDecoded(pSession->sessionhandle, pSession->aTelegrams[sub[0]].handle, NULL, NULL, NULL, got, &size)
+          == TRDP_PARAM_ERR, "tlp_getDecoded() needs a decoder");
+
+    /* the marshalled telegram also unmarshalls completely */
+    size = sizeof(rx);
+    memset(&rx, 0, sizeof(rx));
+    CHECK((tau_xsession_getCom(pSession, sub[0], (UINT8 *) &rx, sizeof(rx), &size, NULL) == TRDP_NO_ERR)
+          && (memcmp(&rx, &tx[0], sizeof(rx)) == 0), "getCom() of %u", COMID_MARSHALLED);
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    const char      *pXml = (argc > 1) ? argv[1] : "test/xml/xsession-test.xml";
+    TAU_XSESSION_T  *pSession = NULL;
+    TRDP_ERR_T      err;
+
+    err = tau_xsession_load(pXml, 0u, print, NULL);
+    if (err != TRDP_NO_ERR)
+    {
+        printf("### Loading %s failed: %s\n", pXml, tau_getResultString(err));
+        return 1;
+    }
+    testLookup();
+
+    err = tau_xsession_init(&pSession, "lo", -1, -1, NULL);
+    if ((err != TRDP_NO_ERR) || !tau_xsession_up(pSession))
+    {
+        printf("### Session init failed: %s\n", tau_getResultString(err));
+        sFailed++;
+    }
+    else
+    {
+        testGetVariable(pSession);
+    }
+    (void) tau_xsession_delete(pSession);
+
+    if (sFailed)
+    {
+        printf("### %d check(s) FAILED\n", sFailed);
+        return 1;
+    }
+    printf("All field-level access tests passed\n");
+    return 0;
+}